@@ -22,7 +22,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface NSDate (OCDateParser)
 
-+ (instancetype)dateParsedFromString:(NSString *)dateString error:(NSError * _Nullable *)error;
++ (instancetype)dateParsedFromString:(NSString *)dateString error:(NSError * _Nullable *)error; //!< Parses HTTP-dates ("Fri, 23 Feb 2018 11:52:05 GMT") and ISO 8601 dates ("2018-02-23T11:52:05Z")
++ (nullable instancetype)dateParsedFromBytes:(const char *)bytes length:(NSUInteger)length; //!< Parses HTTP-dates, ISO 8601 and OCS ("2018-02-23 11:52:05", UTC) dates directly from (ASCII/UTF-8) bytes, without allocations. Falls back to NSDateFormatter for anything else.
 - (nullable NSString *)davDateString;
 
 + (instancetype)dateParsedFromCompactUTCString:(NSString *)dateString error:(NSError * _Nullable *)error;
@@ -18,6 +18,281 @@
 
 #import "NSDate+OCDateParser.h"
 
+#pragma mark - Byte-level parsing
+/*
+	Hand-written parsing of the fixed date formats used by WebDAV and OCS. Works directly on bytes, doesn't allocate,
+	doesn't depend on locale settings and computes the time interval arithmetically. Supported:
+	- HTTP-date / RFC 1123: "Fri, 23 Feb 2018 11:52:05 GMT" (weekday optional, zones GMT, UTC, Z, +hhmm, -hhmm)
+	- ISO 8601: "2018-02-23T11:52:05Z", "2018-02-23T11:52:05.123+01:00", "2018-02-23"
+	- OCS: "2018-02-23 11:52:05" (UTC)
+*/
+
+static inline BOOL OCDateIsDigit(char c)
+{
+	return ((c >= '0') && (c <= '9'));
+}
+
+static inline BOOL OCDateParseNumber(const char **p, const char *end, NSUInteger minDigits, NSUInteger maxDigits, NSInteger *outValue)
+{
+	NSInteger value = 0;
+	NSUInteger digits = 0;
+
+	while ((*p < end) && (digits < maxDigits) && OCDateIsDigit(**p))
+	{
+		value = (value * 10) + (**p - '0');
+		(*p)++;
+		digits++;
+	}
+
+	*outValue = value;
+
+	return (digits >= minDigits);
+}
+
+static inline BOOL OCDateExpect(const char **p, const char *end, char c)
+{
+	if ((*p < end) && (**p == c))
+	{
+		(*p)++;
+		return (YES);
+	}
+
+	return (NO);
+}
+
+static inline void OCDateSkipSpaces(const char **p, const char *end)
+{
+	while ((*p < end) && (**p == ' ')) { (*p)++; }
+}
+
+static int64_t OCDateDaysFromCivil(int64_t year, NSInteger month, NSInteger day)
+{
+	// Days since 1970-01-01 in the proleptic Gregorian calendar (see http://howardhinnant.github.io/date_algorithms.html#days_from_civil)
+	year -= (month <= 2) ? 1 : 0;
+
+	int64_t era = ((year >= 0) ? year : (year - 399)) / 400;
+	int64_t yearOfEra = year - (era * 400);
+	int64_t dayOfYear = ((153 * (month + ((month > 2) ? -3 : 9)) + 2) / 5) + day - 1;
+	int64_t dayOfEra = (yearOfEra * 365) + (yearOfEra / 4) - (yearOfEra / 100) + dayOfYear;
+
+	return ((era * 146097) + dayOfEra - 719468);
+}
+
+static BOOL OCDateComponentsValid(NSInteger year, NSInteger month, NSInteger day, NSInteger hour, NSInteger minute, NSInteger second)
+{
+	static const NSInteger daysInMonth[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+	if ((month < 1) || (month > 12)) { return (NO); }
+	if ((day < 1) || (day > daysInMonth[month-1])) { return (NO); }
+	if ((month == 2) && (day == 29) && !(((year % 4) == 0) && (((year % 100) != 0) || ((year % 400) == 0)))) { return (NO); }
+	if ((hour > 23) || (minute > 59) || (second > 60)) { return (NO); }
+
+	return (YES);
+}
+
+static BOOL OCDateParseZone(const char **p, const char *end, NSInteger *outOffsetSeconds)
+{
+	const char *z = *p;
+	NSUInteger remaining = end - z;
+
+	*outOffsetSeconds = 0;
+
+	if (remaining == 0) { return (YES); } // no zone => UTC
+
+	if ((remaining >= 3) && ((strncmp(z, "GMT", 3) == 0) || (strncmp(z, "UTC", 3) == 0)))
+	{
+		*p += 3;
+		return (YES);
+	}
+
+	if ((*z == 'Z') || (*z == 'z'))
+	{
+		*p += 1;
+		return (YES);
+	}
+
+	if ((*z == '+') || (*z == '-'))
+	{
+		NSInteger sign = (*z == '-') ? -1 : 1, hours, minutes = 0;
+
+		(*p)++;
+
+		if (!OCDateParseNumber(p, end, 2, 2, &hours)) { return (NO); }
+
+		if (*p < end)
+		{
+			OCDateExpect(p, end, ':');
+
+			if (!OCDateParseNumber(p, end, 2, 2, &minutes)) { return (NO); }
+		}
+
+		if ((hours > 23) || (minutes > 59)) { return (NO); }
+
+		*outOffsetSeconds = sign * ((hours * 3600) + (minutes * 60));
+
+		return (YES);
+	}
+
+	return (NO);
+}
+
+static BOOL OCDateParseMonthName(const char **p, const char *end, NSInteger *outMonth)
+{
+	static const char *monthNames = "janfebmaraprmayjunjulaugsepoctnovdec";
+
+	if ((end - *p) < 3) { return (NO); }
+
+	char name[3] = { (char)((*p)[0] | 0x20), (char)((*p)[1] | 0x20), (char)((*p)[2] | 0x20) };
+
+	for (NSInteger month=0; month<12; month++)
+	{
+		if (memcmp(&monthNames[month*3], name, 3) == 0)
+		{
+			*outMonth = month + 1;
+			*p += 3;
+
+			return (YES);
+		}
+	}
+
+	return (NO);
+}
+
+static BOOL OCDateParseTimeOfDay(const char **p, const char *end, BOOL secondsRequired, NSInteger *outHour, NSInteger *outMinute, NSInteger *outSecond, double *outFraction)
+{
+	*outSecond = 0;
+	*outFraction = 0;
+
+	if (!OCDateParseNumber(p, end, 2, 2, outHour) || !OCDateExpect(p, end, ':') || !OCDateParseNumber(p, end, 2, 2, outMinute))
+	{
+		return (NO);
+	}
+
+	if (OCDateExpect(p, end, ':'))
+	{
+		if (!OCDateParseNumber(p, end, 2, 2, outSecond)) { return (NO); }
+
+		// Fraction of seconds
+		if (OCDateExpect(p, end, '.') || OCDateExpect(p, end, ','))
+		{
+			double scale = 0.1;
+
+			if ((*p >= end) || !OCDateIsDigit(**p)) { return (NO); }
+
+			while ((*p < end) && OCDateIsDigit(**p))
+			{
+				*outFraction += (**p - '0') * scale;
+				scale /= 10.0;
+				(*p)++;
+			}
+		}
+	}
+	else if (secondsRequired)
+	{
+		return (NO);
+	}
+
+	return (YES);
+}
+
+static BOOL OCDateParseTimeIntervalSince1970(const char *bytes, NSUInteger length, NSTimeInterval *outTimeInterval)
+{
+	const char *p = bytes, *end = bytes + length;
+	NSInteger year, month, day, hour = 0, minute = 0, second = 0, offsetSeconds = 0;
+	double fraction = 0;
+
+	// Trim whitespace
+	while ((p < end) && ((*p == ' ') || (*p == '\t') || (*p == '\n') || (*p == '\r'))) { p++; }
+	while ((end > p) && ((end[-1] == ' ') || (end[-1] == '\t') || (end[-1] == '\n') || (end[-1] == '\r'))) { end--; }
+
+	if ((end - p) < 10) { return (NO); }
+
+	if (OCDateIsDigit(p[0]) && OCDateIsDigit(p[1]) && OCDateIsDigit(p[2]) && OCDateIsDigit(p[3]) && (p[4] == '-'))
+	{
+		// ISO 8601 / OCS: yyyy-MM-dd[(T| )HH:mm[:ss[.SSS]][zone]]
+		if (!OCDateParseNumber(&p, end, 4, 4, &year) || !OCDateExpect(&p, end, '-') ||
+		    !OCDateParseNumber(&p, end, 2, 2, &month) || !OCDateExpect(&p, end, '-') ||
+		    !OCDateParseNumber(&p, end, 2, 2, &day))
+		{
+			return (NO);
+		}
+
+		if (p < end)
+		{
+			if ((*p != 'T') && (*p != 't') && (*p != ' ')) { return (NO); }
+			p++;
+
+			if (!OCDateParseTimeOfDay(&p, end, NO, &hour, &minute, &second, &fraction)) { return (NO); }
+
+			if (!OCDateParseZone(&p, end, &offsetSeconds)) { return (NO); }
+		}
+	}
+	else
+	{
+		// HTTP-date / RFC 1123: [Www, ]dd MMM yyyy HH:mm:ss zone
+		if (!OCDateIsDigit(*p))
+		{
+			// Skip weekday
+			while ((p < end) && (*p != ',')) { p++; }
+			if (!OCDateExpect(&p, end, ',')) { return (NO); }
+			OCDateSkipSpaces(&p, end);
+		}
+
+		if (!OCDateParseNumber(&p, end, 1, 2, &day)) { return (NO); }
+		OCDateSkipSpaces(&p, end);
+
+		if (!OCDateParseMonthName(&p, end, &month)) { return (NO); }
+		OCDateSkipSpaces(&p, end);
+
+		if (!OCDateParseNumber(&p, end, 4, 4, &year)) { return (NO); }
+		OCDateSkipSpaces(&p, end);
+
+		if (!OCDateParseTimeOfDay(&p, end, YES, &hour, &minute, &second, &fraction)) { return (NO); }
+		OCDateSkipSpaces(&p, end);
+
+		if (!OCDateParseZone(&p, end, &offsetSeconds)) { return (NO); }
+	}
+
+	if ((p != end) || !OCDateComponentsValid(year, month, day, hour, minute, second))
+	{
+		return (NO);
+	}
+
+	*outTimeInterval = (NSTimeInterval)((OCDateDaysFromCivil(year, month, day) * 86400) + (hour * 3600) + (minute * 60) + second - offsetSeconds) + fraction;
+
+	return (YES);
+}
+
+static BOOL OCDateParseStringTimeIntervalSince1970(NSString *dateString, NSTimeInterval *outTimeInterval)
+{
+	const char *bytes;
+	char buffer[64];
+	NSUInteger length;
+
+	if (dateString == nil) { return (NO); }
+
+	// Use the string's ASCII storage directly if available, copy to the stack otherwise
+	if ((bytes = CFStringGetCStringPtr((__bridge CFStringRef)dateString, kCFStringEncodingASCII)) != NULL)
+	{
+		length = strlen(bytes);
+	}
+	else
+	{
+		NSUInteger stringLength = dateString.length;
+
+		if ((stringLength > sizeof(buffer)) ||
+		    ![dateString getBytes:buffer maxLength:sizeof(buffer) usedLength:&length encoding:NSASCIIStringEncoding options:0 range:NSMakeRange(0, stringLength) remainingRange:NULL] ||
+		    (length != stringLength))
+		{
+			return (NO);
+		}
+
+		bytes = buffer;
+	}
+
+	return (OCDateParseTimeIntervalSince1970(bytes, length, outTimeInterval));
+}
+
 @implementation NSDate (OCDateParser)
 
 + (NSDateFormatter *)_ocDateFormatter
@@ -71,9 +346,53 @@
 	return (dateFormatter);
 }
 
++ (NSISO8601DateFormatter *)_ocDateFormatterISO8601
+{
+	static NSISO8601DateFormatter *dateFormatter;
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		dateFormatter = [NSISO8601DateFormatter new];
+	});
+
+	return (dateFormatter);
+}
+
 + (instancetype)dateParsedFromString:(NSString *)dateString error:(NSError **)error
 {
-	return ([[self _ocDateFormatter] dateFromString:dateString]);
+	NSTimeInterval timeInterval;
+	NSDate *date;
+
+	if (OCDateParseStringTimeIntervalSince1970(dateString, &timeInterval))
+	{
+		return ([self dateWithTimeIntervalSince1970:timeInterval]);
+	}
+
+	// Fall back to formatters for anything unusual
+	if ((date = [[self _ocDateFormatter] dateFromString:dateString]) == nil)
+	{
+		date = [[self _ocDateFormatterISO8601] dateFromString:dateString];
+	}
+
+	return (date);
+}
+
++ (instancetype)dateParsedFromBytes:(const char *)bytes length:(NSUInteger)length
+{
+	NSTimeInterval timeInterval;
+	NSString *dateString;
+
+	if (OCDateParseTimeIntervalSince1970(bytes, length, &timeInterval))
+	{
+		return ([self dateWithTimeIntervalSince1970:timeInterval]);
+	}
+
+	if ((dateString = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding]) != nil)
+	{
+		return ([self dateParsedFromString:dateString error:NULL]);
+	}
+
+	return (nil);
 }
 
 - (NSString *)davDateString
@@ -83,6 +402,13 @@
 
 + (instancetype)dateParsedFromCompactUTCString:(NSString *)dateString error:(NSError **)error
 {
+	NSTimeInterval timeInterval;
+
+	if (OCDateParseStringTimeIntervalSince1970(dateString, &timeInterval))
+	{
+		return ([self dateWithTimeIntervalSince1970:timeInterval]);
+	}
+
 	return ([[self _ocDateFormatterCompactUTC] dateFromString:dateString]);
 }
 
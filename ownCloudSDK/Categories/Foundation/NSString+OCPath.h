@@ -23,6 +23,7 @@
 @interface NSString (OCPath)
 
 @property(readonly,strong,nonatomic) OCPath parentPath;
+- (OCPath)parentPathSharedWith:(OCPath)siblingParentPath; //!< Returns siblingParentPath if it is also the parent path of the receiver - so siblings can share one instance instead of allocating their own. Returns -parentPath otherwise.
 @property(readonly,nonatomic) BOOL isRootPath;
 
 @property(readonly,strong,nonatomic) OCPath normalizedDirectoryPath;
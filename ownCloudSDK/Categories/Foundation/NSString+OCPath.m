@@ -25,6 +25,24 @@
 	return ([[self stringByDeletingLastPathComponent] normalizedDirectoryPath]);
 }
 
+- (OCPath)parentPathSharedWith:(OCPath)siblingParentPath
+{
+	NSUInteger parentLength = siblingParentPath.length, length = self.length;
+
+	if ((siblingParentPath != nil) && (length > parentLength) && [siblingParentPath hasSuffix:@"/"] && [self hasPrefix:siblingParentPath])
+	{
+		// Direct child if there's no other "/" after the parent path (except for a trailing one)
+		NSUInteger remainderLength = length - parentLength - (([self characterAtIndex:length-1] == '/') ? 1 : 0);
+
+		if ((remainderLength > 0) && ([self rangeOfString:@"/" options:NSLiteralSearch range:NSMakeRange(parentLength, remainderLength)].location == NSNotFound))
+		{
+			return (siblingParentPath);
+		}
+	}
+
+	return (self.parentPath);
+}
+
 - (BOOL)isRootPath
 {
 	return ([self isEqualToString:@"/"]);
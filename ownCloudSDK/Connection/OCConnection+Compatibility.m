@@ -20,11 +20,17 @@
 #import "NSString+OCVersionCompare.h"
 #import "NSError+OCError.h"
 #import "OCMacros.h"
+#import "OCLogger.h"
 
 @implementation OCConnection (Compatibility)
 
 #pragma mark - Retrieve capabilities
 - (NSProgress *)retrieveCapabilitiesWithCompletionHandler:(void(^)(NSError * _Nullable error, OCCapabilities * _Nullable capabilities))completionHandler
+{
+	return ([self _retrieveCapabilitiesConditionally:YES completionHandler:completionHandler]);
+}
+
+- (NSProgress *)_retrieveCapabilitiesConditionally:(BOOL)conditional completionHandler:(void(^)(NSError * _Nullable error, OCCapabilities * _Nullable capabilities))completionHandler
 {
 	OCHTTPRequest *request;
 	NSProgress *progress = nil;
@@ -34,11 +40,28 @@
 		request.requiredSignals = [NSSet setWithObject:OCConnectionSignalIDAuthenticationAvailable];
 		[request setValue:@"json" forParameter:@"format"];
 
+		OCCapabilities *existingCapabilities = self.capabilities;
+		request.conditional = conditional && (existingCapabilities != nil); // Re-use the existing capabilities if they haven't changed
+
 		progress = [self sendRequest:request ephermalCompletionHandler:^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
 			NSData *responseBody = response.bodyData;
 			OCCapabilities *capabilities = nil;
 
-			if ((error == nil) && response.status.isSuccess && (responseBody!=nil))
+			if ((error == nil) && response.notModified && (existingCapabilities != nil))
+			{
+				// Capabilities unchanged since last retrieval => skip parsing
+				capabilities = existingCapabilities;
+			}
+			else if ((error == nil) && (response.status.code == OCHTTPStatusCodeNOT_MODIFIED) && request.conditional)
+			{
+				// 304 Not Modified, but the stored response was evicted from the validator cache in the meantime => no body to
+				// fall back to, so retrieve the capabilities again without If-None-Match
+				OCLogDebug(@"Capabilities not modified, but no stored response available - retrieving unconditionally");
+
+				[self _retrieveCapabilitiesConditionally:NO completionHandler:completionHandler];
+				return;
+			}
+			else if ((error == nil) && response.status.isSuccess && (responseBody!=nil))
 			{
 				NSDictionary<NSString *, id> *rawJSON;
 
@@ -78,6 +101,9 @@
 							if ((capabilities = [[OCCapabilities alloc] initWithRawJSON:rawJSON]) != nil)
 							{
 								self.capabilities = capabilities;
+
+								// Properties requested via PROPFIND may depend on capabilities
+								[self invalidatePropFindRequestBodies];
 							}
 						}
 					}
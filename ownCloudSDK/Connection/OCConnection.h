@@ -46,6 +46,7 @@ typedef NSString* OCConnectionSetupOptionKey NS_TYPED_ENUM;
 typedef NSString* OCConnectionEndpointURLOption NS_TYPED_ENUM;
 typedef NSString* OCConnectionValidatorFlag NS_TYPED_ENUM;
 typedef NSDictionary<OCItemPropertyName,OCHTTPStatus*>* OCConnectionPropertyUpdateResult;
+typedef void(^OCConnectionSyncCollectionCompletionHandler)(NSError * _Nullable error, NSArray <OCItem *> * _Nullable changedItems, NSArray <OCItem *> * _Nullable removedItems, OCDAVSyncToken _Nullable syncToken, BOOL moreChangesAvailable);
 
 typedef NS_ENUM(NSUInteger, OCConnectionState)
 {
@@ -122,6 +123,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 	NSMutableDictionary<NSString *, OCUser *> *_usersByUserID;
 
+	NSMutableDictionary<NSNumber *, NSData *> *_propFindRequestBodiesByKey;
+
 	NSMutableSet<OCConnectionSignalID> *_signals;
 	NSSet<OCConnectionSignalID> *_actionSignals;
 	NSSet<OCConnectionSignalID> *_propFindSignals;
@@ -197,6 +200,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (nullable NSProgress *)retrieveItemListAtPath:(OCPath)path depth:(NSUInteger)depth options:(nullable NSDictionary<OCConnectionOptionKey,id> *)options resultTarget:(OCEventTarget *)eventTarget; //!< Retrieves the items at the specified path, with options to schedule on the background queue and with a "not before" date.
 
+- (void)invalidatePropFindRequestBodies; //!< Drops the cached, serialized PROPFIND request bodies, so they are rebuilt on next use. Needs to be called whenever the set of requested properties may change.
+
 #pragma mark - Actions
 - (nullable OCProgress *)createFolder:(NSString *)folderName inside:(OCItem *)parentItem options:(nullable NSDictionary<OCConnectionOptionKey,id> *)options resultTarget:(OCEventTarget *)eventTarget;
 
@@ -217,6 +222,10 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Report API
 - (nullable OCProgress *)filterFilesWithRules:(nullable NSDictionary<OCItemPropertyName, id> *)filterRules properties:(nullable NSArray<OCXMLNode *> *)properties resultTarget:(OCEventTarget *)eventTarget;
 
+#pragma mark - Sync collection (RFC 6578)
+- (nullable NSProgress *)retrieveSyncTokenAtPath:(OCPath)path completionHandler:(void(^)(NSError * _Nullable error, OCDAVSyncToken _Nullable syncToken))completionHandler; //!< Retrieves the current DAV:sync-token of the collection at path. Returns an OCErrorFeatureNotSupportedByServer error if the server doesn't provide one.
+- (nullable NSProgress *)retrieveChangesAtPath:(OCPath)path sinceSyncToken:(nullable OCDAVSyncToken)syncToken limit:(NSUInteger)limit completionHandler:(OCConnectionSyncCollectionCompletionHandler)completionHandler; //!< Retrieves up to limit changed (and removed) items below path since syncToken via sync-collection REPORT. moreChangesAvailable is YES if the server returned only part of the changes - in which case the remaining changes can be requested with the returned syncToken.
+
 #pragma mark - Transfer pipeline
 - (OCHTTPPipeline *)transferPipelineForRequest:(OCHTTPRequest *)request withExpectedResponseLength:(NSUInteger)expectedResponseLength;
 
@@ -424,6 +433,9 @@ extern OCConnectionOptionKey OCConnectionOptionTemporarySegmentFolderURLKey; //!
 extern OCConnectionOptionKey OCConnectionOptionForceReplaceKey; //!< If YES, force replace existing items.
 extern OCConnectionOptionKey OCConnectionOptionResponseDestinationURL; //!< NSURL of where to store a (raw) response
 extern OCConnectionOptionKey OCConnectionOptionResponseStreamHandler; //!< Response stream handler (OCHTTPRequestEphermalStreamHandler) to receive the response body stream
+extern OCConnectionOptionKey OCConnectionOptionPriorityClassKey; //!< NSNumber with the OCHTTPRequestPriorityClass to use for the requests
+extern OCConnectionOptionKey OCConnectionOptionIfNoneMatchKey; //!< ETag (NSString) of the cached version of the item - if it still matches, the retrieval of the item list fails with an OCHTTPStatusCodeNOT_MODIFIED error instead of returning the items
+extern OCConnectionOptionKey OCConnectionOptionMaximumResponseSizeKey; //!< NSNumber with the maximum size (in bytes) of an item list response - larger responses aren't parsed and fail with an OCErrorResponseTooLarge error instead
 
 extern OCConnectionSetupOptionKey OCConnectionSetupOptionUserName; //!< User name to feed to OCConnectionServerLocator to determine server.
 
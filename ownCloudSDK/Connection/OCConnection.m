@@ -450,6 +450,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		_authSignals = [NSSet set];
 
 		_usersByUserID = [NSMutableDictionary new];
+		_propFindRequestBodiesByKey = [NSMutableDictionary new];
 
 		[NSNotificationCenter.defaultCenter addObserver:self selector:@selector(_connectionCertificateUserApproved) name:self.bookmark.certificateUserApprovalUpdateNotificationName object:nil];
 
@@ -680,6 +681,12 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		[request addHeaderFields:_staticHeaderFields];
 	}
 
+	// OCS responses (shares, sharees, capabilities, ..) are JSON or XML and compress well
+	if ([request.url.path containsString:@"/ocs/v"])
+	{
+		request.acceptsCompressedResponse = YES;
+	}
+
 	return (request);
 }
 
@@ -1729,8 +1736,28 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		url = [url URLByAppendingPathComponent:path];
 	}
 
-	if ((davRequest = [OCHTTPDAVRequest propfindRequestWithURL:url depth:depth]) != nil)
+	if ((davRequest = [OCHTTPDAVRequest propfindRequestWithURL:url depth:depth bodyData:[self _propfindRequestBodyForDepth:depth]]) != nil)
 	{
+		davRequest.requiredSignals = self.propFindSignals;
+	}
+
+	return (davRequest);
+}
+
+- (NSData *)_propfindRequestBodyForDepth:(NSUInteger)depth
+{
+	BOOL includePrivateLink = [[self classSettingForOCClassSettingsKey:OCConnectionAlwaysRequestPrivateLink] boolValue];
+	NSNumber *bodyKey = @(((depth == 0) ? 1 : 0) | (includePrivateLink ? 2 : 0)); // Everything the property set depends on
+	NSData *bodyData;
+
+	@synchronized(_propFindRequestBodiesByKey)
+	{
+		bodyData = _propFindRequestBodiesByKey[bodyKey];
+	}
+
+	if (bodyData == nil)
+	{
+		// Serialize the body for this property set once - and reuse it for all following requests
 		NSMutableArray <OCXMLNode *> *ocPropAttributes = [self _davItemAttributes];
 
 		if (depth == 0)
@@ -1740,17 +1767,28 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 			[ocPropAttributes addObject:[OCXMLNode elementWithName:@"oc:checksums"]];
 		}
 
-		if ([[self classSettingForOCClassSettingsKey:OCConnectionAlwaysRequestPrivateLink] boolValue])
+		if (includePrivateLink)
 		{
 			[ocPropAttributes addObject:[OCXMLNode elementWithName:@"oc:privatelink"]];
 		}
 
-		[davRequest.xmlRequestPropAttribute addChildren:ocPropAttributes];
+		bodyData = [OCHTTPDAVRequest propfindRequestBodyWithProperties:ocPropAttributes];
 
-		davRequest.requiredSignals = self.propFindSignals;
+		@synchronized(_propFindRequestBodiesByKey)
+		{
+			_propFindRequestBodiesByKey[bodyKey] = bodyData;
+		}
 	}
 
-	return (davRequest);
+	return (bodyData);
+}
+
+- (void)invalidatePropFindRequestBodies
+{
+	@synchronized(_propFindRequestBodiesByKey)
+	{
+		[_propFindRequestBodiesByKey removeAllObjects];
+	}
 }
 
 - (NSProgress *)retrieveItemListAtPath:(OCPath)path depth:(NSUInteger)depth completionHandler:(void(^)(NSError *error, NSArray <OCItem *> *items))completionHandler
@@ -1824,11 +1862,32 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 				davRequest.groupID = options[OCConnectionOptionGroupIDKey];
 			}
 
+			// Priority class: listings the user is looking at are interactive (as requested by the caller), background updates aren't
+			if (options[OCConnectionOptionPriorityClassKey] != nil)
+			{
+				davRequest.priorityClass = ((NSNumber *)options[OCConnectionOptionPriorityClassKey]).integerValue;
+			}
+			else if ((options[@"alternativeEventType"] != nil) || [options[@"longLived"] boolValue])
+			{
+				davRequest.priorityClass = OCHTTPRequestPriorityClassBackground;
+			}
+			else
+			{
+				// Callers driving the UI ask for interactive listings explicitly - everything else is regular work
+				davRequest.priorityClass = OCHTTPRequestPriorityClassUtility;
+			}
+
 			if (options[OCConnectionOptionRequiredSignalsKey] != nil)
 			{
 				davRequest.requiredSignals = options[OCConnectionOptionRequiredSignalsKey];
 			}
 
+			if (options[OCConnectionOptionIfNoneMatchKey] != nil)
+			{
+				// Let the server skip sending the listing if the ETag still matches (servers not supporting this just respond as usual)
+				[davRequest setValue:options[OCConnectionOptionIfNoneMatchKey] forHeaderField:OCHTTPHeaderFieldNameIfNoneMatch];
+			}
+
 			if (options[OCConnectionOptionResponseDestinationURL] != nil)
 			{
 				davRequest.downloadedFileURL = options[OCConnectionOptionResponseDestinationURL];
@@ -1839,6 +1898,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 				davRequest.ephermalStreamHandler = ephermalStreamHandler;
 				davRequest.downloadRequest = NO;
 			}
+			else if (davRequest.requestObserver == nil)
+			{
+				// Folder listings requested repeatedly (f.ex. by several queries for the same path) can share a single PROPFIND
+				davRequest.coalescable = YES;
+			}
 
 			// Attach to pipelines
 			[self attachToPipelines];
@@ -1906,7 +1970,18 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 
 		if (!request.httpResponse.status.isSuccess && (event.error == nil))
 		{
-			event.error = request.httpResponse.status.error;
+			if ((options[OCConnectionOptionIfNoneMatchKey] != nil) &&
+			    ((request.httpResponse.status.code == OCHTTPStatusCodeNOT_MODIFIED) || (request.httpResponse.status.code == OCHTTPStatusCodePRECONDITION_FAILED)))
+			{
+				// ETag still matches (RFC 7232 requires servers to respond to non-GET/HEAD requests with a matching If-None-Match with 412 rather than 304)
+				event.error = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeNOT_MODIFIED].error;
+				event.path = request.userInfo[@"path"];
+				event.depth = [(NSNumber *)request.userInfo[@"depth"] unsignedIntegerValue];
+			}
+			else
+			{
+				event.error = request.httpResponse.status.error;
+			}
 		}
 
 		if ((event.error == nil) && (responseDestinationURL != nil))
@@ -1926,6 +2001,27 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 			}
 		}
 
+		if ((event.error == nil) && (options[OCConnectionOptionMaximumResponseSizeKey] != nil))
+		{
+			NSNumber *responseSize = nil;
+
+			if (request.httpResponse.bodyURL != nil)
+			{
+				[request.httpResponse.bodyURL getResourceValue:&responseSize forKey:NSURLFileSizeKey error:NULL];
+			}
+			else
+			{
+				responseSize = @(request.httpResponse.bodyData.length);
+			}
+
+			// Response exceeds the size the caller is prepared to handle => don't parse it (parsing materializes all items at once)
+			if (responseSize.unsignedLongLongValue > ((NSNumber *)options[OCConnectionOptionMaximumResponseSizeKey]).unsignedLongLongValue)
+			{
+				OCLogWarning(@"Item list response for %@ exceeds maximum size (%@ > %@ bytes) - not parsing it", OCLogPrivate(request.userInfo[@"path"]), responseSize, options[OCConnectionOptionMaximumResponseSizeKey]);
+				event.error = OCError(OCErrorResponseTooLarge);
+			}
+		}
+
 		if ((event.error == nil) && (responseDestinationURL == nil))
 		{
 			NSArray <NSError *> *errors = nil;
@@ -2108,6 +2204,11 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 			request.requestObserver = options[OCConnectionOptionRequestObserverKey];
 		}
 
+		if (options[OCConnectionOptionPriorityClassKey] != nil)
+		{
+			request.priorityClass = ((NSNumber *)options[OCConnectionOptionPriorityClassKey]).integerValue;
+		}
+
 		// Attach to pipelines
 		[self attachToPipelines];
 
@@ -2961,8 +3062,14 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 			request.downloadRequest = YES;
 			request.downloadedFileURL = localThumbnailURL;
 		}
+		else
+		{
+			request.conditional = YES; // Thumbnail returned in memory => let the pipeline revalidate a previously retrieved copy
+		}
 
 		request.forceCertificateDecisionDelegation = YES;
+		request.coalescable = YES; // Identical thumbnail requests (same item version and size) can share a single download
+		request.priorityClass = OCHTTPRequestPriorityClassUserInitiated; // Thumbnails are requested for items visible to the user
 
 		// Attach to pipelines
 		[self attachToPipelines];
@@ -2997,7 +3104,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 		}
 		else
 		{
-			if (request.httpResponse.status.isSuccess)
+			if (request.httpResponse.status.isSuccess || request.httpResponse.notModified)
 			{
 				OCItemThumbnail *thumbnail = [OCItemThumbnail new];
 				OCItemVersionIdentifier *itemVersionIdentifier = request.userInfo[OCEventUserInfoKeyItemVersionIdentifier];
@@ -3142,6 +3249,136 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCConnection)
 	}
 }
 
+#pragma mark - Sync collection (RFC 6578)
+- (nullable NSProgress *)retrieveSyncTokenAtPath:(OCPath)path completionHandler:(void(^)(NSError * _Nullable error, OCDAVSyncToken _Nullable syncToken))completionHandler
+{
+	NSURL *endpointURL = [self URLForEndpoint:OCConnectionEndpointIDWebDAVRoot options:nil];
+	OCHTTPDAVRequest *davRequest;
+
+	if (endpointURL == nil)
+	{
+		// WebDAV root could not be generated (likely due to lack of username)
+		completionHandler(OCError(OCErrorInternal), nil);
+		return (nil);
+	}
+
+	davRequest = [OCHTTPDAVRequest propfindRequestWithURL:[endpointURL URLByAppendingPathComponent:path] depth:0];
+	davRequest.requiredSignals = self.propFindSignals;
+	davRequest.priorityClass = OCHTTPRequestPriorityClassUtility;
+
+	[davRequest.xmlRequestPropAttribute addChildren:@[
+		[OCXMLNode elementWithName:@"D:sync-token"]
+	]];
+
+	return ([self sendRequest:davRequest ephermalCompletionHandler:^(OCHTTPRequest * _Nonnull request, OCHTTPResponse * _Nullable response, NSError * _Nullable error) {
+		OCDAVSyncToken syncToken = nil;
+
+		if ((error == nil) && !response.status.isSuccess)
+		{
+			error = response.status.error;
+		}
+
+		if (error == nil)
+		{
+			OCHTTPDAVMultistatusResponse *multistatusResponse = [((OCHTTPDAVRequest *)request) multistatusResponsesForBasePath:endpointURL.path].allValues.firstObject;
+
+			for (OCHTTPStatus *status in multistatusResponse.valueForPropByStatusCode)
+			{
+				if (status.isSuccess)
+				{
+					syncToken = OCTypedCast(multistatusResponse.valueForPropByStatusCode[status][@"d:sync-token"], NSString);
+				}
+			}
+
+			if (syncToken.length == 0)
+			{
+				// Property not supported for this collection (typically 404 in the propstat)
+				syncToken = nil;
+				error = OCError(OCErrorFeatureNotSupportedByServer);
+			}
+		}
+
+		completionHandler(error, syncToken);
+	}]);
+}
+
+- (nullable NSProgress *)retrieveChangesAtPath:(OCPath)path sinceSyncToken:(nullable OCDAVSyncToken)syncToken limit:(NSUInteger)limit completionHandler:(OCConnectionSyncCollectionCompletionHandler)completionHandler
+{
+	NSURL *endpointURL = [self URLForEndpoint:OCConnectionEndpointIDWebDAVRoot options:nil];
+	OCHTTPDAVRequest *davRequest;
+
+	if (endpointURL == nil)
+	{
+		// WebDAV root could not be generated (likely due to lack of username)
+		completionHandler(OCError(OCErrorInternal), nil, nil, nil, NO);
+		return (nil);
+	}
+
+	davRequest = [OCHTTPDAVRequest syncCollectionRequestWithURL:[endpointURL URLByAppendingPathComponent:path] syncToken:syncToken limit:limit properties:[self _davItemAttributes]];
+	davRequest.requiredSignals = self.propFindSignals;
+	davRequest.priorityClass = OCHTTPRequestPriorityClassUtility;
+
+	return ([self sendRequest:davRequest ephermalCompletionHandler:^(OCHTTPRequest * _Nonnull request, OCHTTPResponse * _Nullable response, NSError * _Nullable error) {
+		NSMutableArray<OCItem *> *changedItems = nil, *removedItems = nil;
+		OCDAVSyncToken newSyncToken = nil;
+		BOOL truncated = NO;
+
+		if ((error == nil) && !response.status.isSuccess)
+		{
+			NSError *davError = response.bodyParsedAsDAVError;
+
+			if (davError.davError == OCDAVErrorInvalidSyncToken)
+			{
+				// DAV:valid-sync-token precondition failed => token no longer valid
+				error = davError;
+			}
+			else if ((davError.davError == OCDAVErrorReportNotSupported) ||
+				 (response.status.code == OCHTTPStatusCodeMETHOD_NOT_ALLOWED) || (response.status.code == OCHTTPStatusCodeNOT_IMPLEMENTED) ||
+				 (response.status.code == OCHTTPStatusCodeFORBIDDEN))
+			{
+				// DAV:supported-report precondition failed, 405/501 or 403 without DAV:valid-sync-token precondition (as returned by Sabre for unsupported REPORTs) => REPORT not supported
+				error = OCError(OCErrorFeatureNotSupportedByServer);
+			}
+			else
+			{
+				error = response.status.error;
+			}
+		}
+
+		if (error == nil)
+		{
+			NSArray <NSError *> *errors = nil;
+			NSArray <OCItem *> *items;
+
+			items = [((OCHTTPDAVRequest *)request) syncCollectionResponseItemsForBasePath:endpointURL.path reuseUsersByID:self->_usersByUserID syncToken:&newSyncToken truncated:&truncated withErrors:&errors];
+
+			if ((items == nil) || (newSyncToken == nil))
+			{
+				error = (errors.firstObject != nil) ? errors.firstObject : OCError(OCErrorResponseUnknownFormat);
+			}
+			else
+			{
+				changedItems = [NSMutableArray new];
+				removedItems = [NSMutableArray new];
+
+				for (OCItem *item in items)
+				{
+					if (item.removed)
+					{
+						[removedItems addObject:item];
+					}
+					else if (item.fileID != nil)
+					{
+						[changedItems addObject:item];
+					}
+				}
+			}
+		}
+
+		completionHandler(error, changedItems, removedItems, newSyncToken, truncated);
+	}]);
+}
+
 #pragma mark - Sending requests
 - (NSProgress *)sendRequest:(OCHTTPRequest *)request ephermalCompletionHandler:(OCHTTPRequestEphermalResultHandler)ephermalResultHandler
 {
@@ -3230,6 +3467,9 @@ OCConnectionOptionKey OCConnectionOptionTemporarySegmentFolderURLKey = @"tempora
 OCConnectionOptionKey OCConnectionOptionForceReplaceKey = @"force-replace";
 OCConnectionOptionKey OCConnectionOptionResponseDestinationURL = @"response-destination-url";
 OCConnectionOptionKey OCConnectionOptionResponseStreamHandler = @"response-stream-handler";
+OCConnectionOptionKey OCConnectionOptionPriorityClassKey = @"priority-class";
+OCConnectionOptionKey OCConnectionOptionIfNoneMatchKey = @"if-none-match";
+OCConnectionOptionKey OCConnectionOptionMaximumResponseSizeKey = @"maximum-response-size";
 
 OCConnectionSetupOptionKey OCConnectionSetupOptionUserName = @"user-name";
 
@@ -75,7 +75,7 @@
 				{
 					OCLogDebug(@"Existing favorites: %@", items);
 
-					currentlyFavoritedItemList = [OCCoreItemList itemListWithItems:items];
+					currentlyFavoritedItemList = [OCCoreItemList itemListWithItems:items indexes:OCCoreItemListIndexFileID];
 				}
 			}];
 
@@ -111,7 +111,7 @@
 			OCLogDebug(@"New favorites (local): %@", newFavoritedItems);
 
 			// Build item list from new favorited items
-			newFavoritedItemsList = [OCCoreItemList itemListWithItems:newFavoritedItems];
+			newFavoritedItemsList = [OCCoreItemList itemListWithItems:newFavoritedItems indexes:OCCoreItemListIndexFileID];
 
 			if (currentlyFavoritedItemList.itemFileIDsSet.count > 0)
 			{
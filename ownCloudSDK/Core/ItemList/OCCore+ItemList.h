@@ -49,6 +49,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface OCCore (ItemListInternal)
 - (void)scheduleNextItemListTask;
+- (void)recordItemListRequestCompletionWithError:(nullable NSError *)error latency:(NSTimeInterval)latency; //!< Adjusts the number of concurrent item list tasks based on the outcome and latency of an item list PROPFIND
+- (void)retrievePrefetchedItemListForPath:(OCPath)path completionHandler:(void(^)(NSArray<OCItem *> * _Nullable items))completionHandler; //!< Provides the listing of the folder at path from a depth infinity PROPFIND coalescing scans of sibling folders - or nil if the folder needs to be retrieved individually
+- (nullable NSString *)listingETagForPath:(OCPath)path; //!< ETag of the folder at path when its contents were last fully merged into the cache during this session
+- (void)_finishedUpdateScanWithError:(nullable NSError *)error foundChanges:(BOOL)foundChanges;
+- (void)coordinatedScanForChangesDidFinish;
+- (void)updateRootQuotaFromItem:(OCItem *)rootItem; //!< Updates the .rootQuota* properties from the quota properties of the root item
 @end
 
 extern OCActivityIdentifier OCActivityIdentifierPendingServerScanJobsSummary; //!< The activity reporting the progress of background checks for updates
@@ -37,26 +37,67 @@
 #import "OCCoreUpdateScheduleRecord.h"
 #import "OCLockManager.h"
 #import "OCLockRequest.h"
+#import "OCCore+SyncCollection.h"
+#import "OCCoreItemListPrefetch.h"
+#import "OCHTTPPipelineConcurrencyController.h"
+#import "NSError+OCHTTPStatus.h"
 #import <objc/runtime.h>
 
 static OCHTTPRequestGroupID OCCoreItemListTaskGroupQueryTasks = @"queryItemListTasks";
 static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroundItemListTasks";
 
+#define OCCoreItemListTasksMaximumConcurrency 8	//!< Upper bound for the number of concurrent item list tasks
+#define OCCoreItemListPrefetchMaximumItemCount 2000	//!< Maximum number of cached items below a folder for scans of its subfolders to be coalesced into a depth infinity PROPFIND
+#define OCCoreItemListPrefetchMaximumUnknownSize (16 * 1024 * 1024)	//!< Maximum number of bytes the server reports below a folder (oc:size) beyond those of the files known in the cache for scans of its subfolders to be coalesced
+#define OCCoreItemListPrefetchMaximumResponseSize (4 * 1024 * 1024)	//!< Maximum size of a depth infinity PROPFIND response to parse - larger subtrees fall back to depth 1 scans
+
 @implementation OCCore (ItemList)
 
-- (NSUInteger)parallelItemListTaskCount
+- (OCHTTPPipelineConcurrencyController *)itemListTasksConcurrencyController
 {
-	switch (self.memoryConfiguration)
+	@synchronized(_queuedItemListTaskUpdateJobs)
 	{
-		case OCCoreMemoryConfigurationMinimum:
-			return (1);
-		break;
+		if (_itemListTasksConcurrencyController == nil)
+		{
+			NSUInteger initialLimit, maximumLimit;
 
-		case OCCoreMemoryConfigurationDefault:
-		default:
-			return (2);
-		break;
+			switch (self.memoryConfiguration)
+			{
+				case OCCoreMemoryConfigurationMinimum:
+					initialLimit = 1;
+					maximumLimit = 2;
+				break;
+
+				case OCCoreMemoryConfigurationDefault:
+				default:
+					initialLimit = 2;
+					maximumLimit = OCCoreItemListTasksMaximumConcurrency;
+				break;
+			}
+
+			_itemListTasksConcurrencyController = [[OCHTTPPipelineConcurrencyController alloc] initWithHostname:self.bookmark.url.host initialLimit:initialLimit minimumLimit:1 maximumLimit:maximumLimit];
+		}
+
+		return (_itemListTasksConcurrencyController);
+	}
+}
+
+- (NSUInteger)parallelItemListTaskCount
+{
+	// Starts at 1 or 2 and then follows the server: grows while responses come back as fast as before, shrinks on rising latency, timeouts and 429/503 responses
+	return (self.itemListTasksConcurrencyController.limit);
+}
+
+- (void)recordItemListRequestCompletionWithError:(NSError *)error latency:(NSTimeInterval)latency
+{
+	NSUInteger inFlight;
+
+	@synchronized(_queuedItemListTaskUpdateJobs)
+	{
+		inFlight = _scheduledItemListTasks.count;
 	}
+
+	[self.itemListTasksConcurrencyController recordResponseWithStatus:error.HTTPStatus error:error latency:((error == nil) ? @(latency) : nil) inFlight:inFlight];
 }
 
 #pragma mark - Item List Tasks
@@ -97,7 +138,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 			if (putInQueue)
 			{
-				[_queuedItemListTaskUpdateJobs addObject:directoryUpdateJob];
+				[self _enqueueItemListTaskUpdateJob:directoryUpdateJob];
 
 				if (existingQueryTask != nil)
 				{
@@ -135,14 +176,127 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 	}
 }
 
+- (void)_enqueueItemListTaskUpdateJob:(OCCoreDirectoryUpdateJob *)updateJob
+{
+	// Must be called with _queuedItemListTaskUpdateJobs locked
+	OCCoreDirectoryUpdateJob *queuedUpdateJob;
+
+	if ((queuedUpdateJob = _queuedItemListTaskUpdateJobsByPath[updateJob.path]) != nil)
+	{
+		// Coalesce with the job already queued for the same path
+		if (updateJob.isForQuery && !queuedUpdateJob.isForQuery)
+		{
+			// Query jobs take precedence and take over the jobs represented by the queued background job
+			for (OCCoreDirectoryUpdateJobID jobID in queuedUpdateJob.representedJobIDs)
+			{
+				[updateJob addRepresentedJobID:jobID];
+			}
+
+			[_queuedItemListTaskUpdateJobs replaceObjectAtIndex:[_queuedItemListTaskUpdateJobs indexOfObjectIdenticalTo:queuedUpdateJob] withObject:updateJob];
+			_queuedItemListTaskUpdateJobsByPath[updateJob.path] = updateJob;
+		}
+		else
+		{
+			// Add to represented jobs, so the database can be cleaned up properly
+			for (OCCoreDirectoryUpdateJobID jobID in updateJob.representedJobIDs)
+			{
+				[queuedUpdateJob addRepresentedJobID:jobID];
+			}
+		}
+	}
+	else
+	{
+		[_queuedItemListTaskUpdateJobs addObject:updateJob];
+		_queuedItemListTaskUpdateJobsByPath[updateJob.path] = updateJob;
+	}
+}
+
+- (OCCoreDirectoryUpdateJob *)_nextQueuedItemListTaskUpdateJobWithViewedPaths:(NSSet<OCPath> *)viewedPaths trackedPaths:(NSSet<OCPath> *)trackedPaths
+{
+	// Must be called with _queuedItemListTaskUpdateJobs locked
+	OCCoreDirectoryUpdateJob *viewedPathJob = nil, *trackedPathJob = nil;
+
+	for (OCCoreDirectoryUpdateJob *updateJob in _queuedItemListTaskUpdateJobs)
+	{
+		// Query item list update jobs have the highest priority
+		if (updateJob.isForQuery)
+		{
+			return (updateJob);
+		}
+
+		// Followed by background scans of folders the user is looking at …
+		if (viewedPathJob == nil)
+		{
+			if ([viewedPaths containsObject:updateJob.path])
+			{
+				viewedPathJob = updateJob;
+			}
+			else if (trackedPathJob == nil)
+			{
+				// … and of folders kept available offline
+				for (OCPath trackedPath in trackedPaths)
+				{
+					if ([updateJob.path hasPrefix:trackedPath])
+					{
+						trackedPathJob = updateJob;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	if (viewedPathJob != nil)
+	{
+		return (viewedPathJob);
+	}
+
+	if (trackedPathJob != nil)
+	{
+		return (trackedPathJob);
+	}
+
+	// Proceed with top of the list
+	return (_queuedItemListTaskUpdateJobs.firstObject);
+}
+
 - (void)scheduleNextItemListTask
 {
-	OCCoreDirectoryUpdateJob *nextUpdateJob = nil;
+	NSMutableSet<OCPath> *viewedPaths = [NSMutableSet new];
+	NSSet<OCPath> *trackedPaths = nil;
+	NSArray<OCQuery *> *queries;
+
+	// Snapshot the paths of running queries and available offline folders, whose scans are prioritized (only using the cached
+	// available offline paths, as this may be called on the database thread)
+	@synchronized(_queries)
+	{
+		queries = [_queries copy];
+	}
+
+	for (OCQuery *query in queries)
+	{
+		OCPath viewedPath;
+
+		if ((viewedPath = ((query.queryPath != nil) ? query.queryPath : query.queryItem.path.parentPath)) != nil)
+		{
+			[viewedPaths addObject:viewedPath];
+		}
+	}
+
+	@synchronized(_availableOfflineFolderPaths)
+	{
+		if (_availableOfflineCacheValid)
+		{
+			trackedPaths = [_availableOfflineFolderPaths copy];
+		}
+	}
 
 	@synchronized(_queuedItemListTaskUpdateJobs)
 	{
 		if ((self.state != OCCoreStateStopping) && (self.state != OCCoreStateStopped))
 		{
+			NSUInteger parallelItemListTaskCount = self.parallelItemListTaskCount;
+
 			// Check for tasks waiting to be (re)started
 			if (_scheduledItemListTasks.count != 0)
 			{
@@ -152,60 +306,210 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 				}
 			}
 
-			// Check for free capacities and try to fill them
-			if (_scheduledItemListTasks.count < self.parallelItemListTaskCount)
+			// Allow as many PROPFINDs in flight as item list tasks
+			_itemListTasksRequestQueue.maximumConcurrentJobs = parallelItemListTaskCount;
+
+			// Check for free capacities and fill them
+			while ((_scheduledItemListTasks.count < parallelItemListTaskCount) && (_queuedItemListTaskUpdateJobs.count > 0))
 			{
-				// Check for high-priority query item list update jobs
-				for (OCCoreDirectoryUpdateJob *updateJob in _queuedItemListTaskUpdateJobs)
+				OCCoreDirectoryUpdateJob *nextUpdateJob;
+				OCCoreItemListTask *task;
+
+				if ((nextUpdateJob = [self _nextQueuedItemListTaskUpdateJobWithViewedPaths:viewedPaths trackedPaths:trackedPaths]) == nil)
 				{
-					if (updateJob.isForQuery)
-					{
-						nextUpdateJob = updateJob;
-						break;
-					}
+					break;
 				}
 
-				if (nextUpdateJob == nil)
+				// Jobs targeting the same path have already been coalesced into the queued job when they were added
+				[_queuedItemListTaskUpdateJobs removeObjectIdenticalTo:nextUpdateJob];
+				[_queuedItemListTaskUpdateJobsByPath removeObjectForKey:nextUpdateJob.path];
+
+				if (!nextUpdateJob.isForQuery)
 				{
-					// If no high-priority query item list update job has been found => proceed with top of the list
-					nextUpdateJob = _queuedItemListTaskUpdateJobs.firstObject;
+					[self _coalesceSiblingScansOfUpdateJob:nextUpdateJob];
 				}
 
-				if (nextUpdateJob != nil)
+				if ((task = [self _scheduleItemListTaskForDirectoryUpdateJob:nextUpdateJob]) != nil)
 				{
-					// Remove the update job and any targeting the same path (effectively coalescating the tasks)
-					NSMutableIndexSet *removeIndexes = [NSMutableIndexSet new];
+					[_scheduledItemListTasks addObject:task];
+				}
+			}
+		}
+	}
+}
 
-					[_queuedItemListTaskUpdateJobs enumerateObjectsUsingBlock:^(OCCoreDirectoryUpdateJob * _Nonnull updateJob, NSUInteger idx, BOOL * _Nonnull stop) {
-						if (nextUpdateJob == updateJob)
-						{
-							[removeIndexes addIndex:idx];
-						}
-						else
-						{
-							if ([updateJob.path isEqual:nextUpdateJob.path])
-							{
-								// Add to represented array, so the database can be cleaned up properly
-								[nextUpdateJob addRepresentedJobID:updateJob.identifier];
-								[removeIndexes addIndex:idx];
-							}
-						}
-					}];
+#pragma mark - Coalescing of sibling scans
+- (OCCoreItemListPrefetch *)_itemListPrefetchCoveringPath:(OCPath)path
+{
+	@synchronized(_itemListPrefetchesByRootPath)
+	{
+		OCPath rootPath = path;
 
-					[_queuedItemListTaskUpdateJobs removeObjectsAtIndexes:removeIndexes];
+		while (rootPath != nil)
+		{
+			OCCoreItemListPrefetch *prefetch;
+
+			if ((prefetch = _itemListPrefetchesByRootPath[rootPath]) != nil)
+			{
+				if (!prefetch.expired)
+				{
+					return (prefetch);
 				}
 
-				if (nextUpdateJob != nil)
+				[_itemListPrefetchesByRootPath removeObjectForKey:rootPath];
+			}
+
+			rootPath = rootPath.isRootPath ? nil : rootPath.parentPath;
+		}
+	}
+
+	return (nil);
+}
+
+- (void)_coalesceSiblingScansOfUpdateJob:(OCCoreDirectoryUpdateJob *)updateJob
+{
+	// Must be called with _queuedItemListTaskUpdateJobs locked
+	OCPath path = updateJob.path, parentPath;
+	BOOL hasQueuedSiblings = NO;
+	OCCoreItemListPrefetch *prefetch;
+
+	if (_itemListPrefetchUnsupported || path.isRootPath || ((self.connection.capabilities.davPropfindSupportsDepthInfinity != nil) && !self.connection.capabilities.davPropfindSupportsDepthInfinity.boolValue))
+	{
+		return;
+	}
+
+	if (self.memoryConfiguration == OCCoreMemoryConfigurationMinimum)
+	{
+		// Depth 1 scans keep the memory needed for a listing bounded by the size of a single folder
+		return;
+	}
+
+	if ([self _itemListPrefetchCoveringPath:path] != nil)
+	{
+		// Already covered by a prefetch
+		return;
+	}
+
+	parentPath = path.parentPath;
+
+	for (OCCoreDirectoryUpdateJob *queuedUpdateJob in _queuedItemListTaskUpdateJobs)
+	{
+		if (!queuedUpdateJob.isForQuery && [[queuedUpdateJob.path parentPathSharedWith:parentPath] isEqual:parentPath])
+		{
+			hasQueuedSiblings = YES;
+			break;
+		}
+	}
+
+	if (!hasQueuedSiblings)
+	{
+		return;
+	}
+
+	// Scans of sibling folders are pending => retrieve the listings of the entire subtree of their parent with a single depth infinity PROPFIND
+	// if the subtree is small: few items in the cache - and the server doesn't report (much) more content below the parent than the cache knows of,
+	// so that folders that were never listed (or have grown a lot) don't slip through
+	prefetch = [[OCCoreItemListPrefetch alloc] initWithRootPath:parentPath];
+
+	@synchronized(_itemListPrefetchesByRootPath)
+	{
+		_itemListPrefetchesByRootPath[parentPath] = prefetch;
+	}
+
+	[self.database numberOfCacheItemsBelowPath:parentPath upToLimit:(OCCoreItemListPrefetchMaximumItemCount + 1) completionHandler:^(OCDatabase *db, NSError *error, NSNumber *count) {
+		if ((error != nil) || (count == nil) || (count.unsignedIntegerValue > OCCoreItemListPrefetchMaximumItemCount))
+		{
+			[prefetch completeWithItems:nil];
+			return;
+		}
+
+		[self.database retrieveCacheItemsRecursivelyBelowPath:parentPath includingPathItself:YES includingRemoved:NO completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *cachedItems) {
+			OCItem *parentItem = nil;
+			unsigned long long knownSize = 0;
+
+			for (OCItem *item in cachedItems)
+			{
+				if ([item.path isEqual:parentPath])
+				{
+					parentItem = item;
+				}
+				else if ((item.type == OCItemTypeFile) && (item.size > 0))
 				{
-					OCCoreItemListTask *task;
+					knownSize += (unsigned long long)item.size;
+				}
+			}
+
+			// The parent's oc:size was just updated by the listing that queued the sibling scans
+			if ((error != nil) || (parentItem == nil) || ((parentItem.size > 0) && ((unsigned long long)parentItem.size > (knownSize + OCCoreItemListPrefetchMaximumUnknownSize))))
+			{
+				OCLogDebug(@"Not coalescing scans below %@: server reports %ld bytes, cache knows %llu bytes (error=%@)", OCLogPrivate(parentPath), (long)parentItem.size, knownSize, error);
+				[prefetch completeWithItems:nil];
+				return;
+			}
+
+			OCLogDebug(@"Coalescing scans below %@ (%@ cached items) into a depth infinity PROPFIND", OCLogPrivate(parentPath), count);
 
-					if ((task = [self _scheduleItemListTaskForDirectoryUpdateJob:nextUpdateJob]) != nil)
+			[self.connection retrieveItemListAtPath:parentPath depth:OCPropfindDepthInfinity options:@{
+				OCConnectionOptionRequiredSignalsKey : self.connection.actionSignals,
+				OCConnectionOptionGroupIDKey : OCCoreItemListTaskGroupBackgroundTasks,
+				OCConnectionOptionPriorityClassKey : @(OCHTTPRequestPriorityClassBackground),
+				OCConnectionOptionMaximumResponseSizeKey : @(OCCoreItemListPrefetchMaximumResponseSize)
+			} completionHandler:^(NSError *error, NSArray<OCItem *> *items) {
+				if (error != nil)
+				{
+					if (IsHTTPErrorWithStatus(error, OCHTTPStatusCodeFORBIDDEN) || IsHTTPErrorWithStatus(error, OCHTTPStatusCodeBAD_REQUEST) || IsHTTPErrorWithStatus(error, OCHTTPStatusCodeNOT_IMPLEMENTED))
+					{
+						// Server doesn't allow depth infinity PROPFINDs => don't try again in this session
+						OCLogDebug(@"Depth infinity PROPFIND rejected with error=%@ - no longer coalescing scans", error);
+						self->_itemListPrefetchUnsupported = YES;
+					}
+					else if ([error isOCErrorWithCode:OCErrorResponseTooLarge])
 					{
-						[_scheduledItemListTasks addObject:task];
+						// Subtree larger than it looked => the pending scans go ahead as depth 1 PROPFINDs
+						OCLogDebug(@"Depth infinity PROPFIND response for %@ too large - falling back to depth 1 scans", OCLogPrivate(parentPath));
 					}
+
+					items = nil;
 				}
-			}
-		}
+
+				[prefetch completeWithItems:items];
+			}];
+		}];
+	}];
+}
+
+- (void)retrievePrefetchedItemListForPath:(OCPath)path completionHandler:(void(^)(NSArray<OCItem *> * _Nullable items))completionHandler
+{
+	OCCoreItemListPrefetch *prefetch;
+
+	if ((prefetch = [self _itemListPrefetchCoveringPath:path]) != nil)
+	{
+		[prefetch retrieveListingForPath:path handler:^(NSArray<OCItem *> * _Nullable items) {
+			// Continue on the core's queue
+			[self queueBlock:^{
+				completionHandler(items);
+			}];
+		}];
+	}
+	else
+	{
+		completionHandler(nil);
+	}
+}
+
+- (void)_removeItemListPrefetches
+{
+	@synchronized(_itemListPrefetchesByRootPath)
+	{
+		[_itemListPrefetchesByRootPath removeAllObjects];
+	}
+}
+
+- (NSString *)listingETagForPath:(OCPath)path
+{
+	@synchronized(_listingETagsByPath)
+	{
+		return (_listingETagsByPath[path]);
 	}
 }
 
@@ -363,7 +667,13 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 	switch (task.cachedSet.state)
 	{
 		case OCCoreItemListStateSuccess:
-			if (task.retrievedSet.state == OCCoreItemListStateSuccess)
+			if ((task.retrievedSet.state == OCCoreItemListStateSuccess) && task.retrievedSet.notModified)
+			{
+				// Server confirmed the cached items are current => nothing to merge
+				queryState = OCQueryStateIdle;
+				removeTask = YES;
+			}
+			else if (task.retrievedSet.state == OCCoreItemListStateSuccess)
 			{
 				// Merge item sets to final result and update cache
 				queryState = OCQueryStateIdle;
@@ -461,10 +771,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 		// Perform merge
 		OCCoreItemList *cacheSet = task.cachedSet;
 		OCCoreItemList *retrievedSet = task.retrievedSet;
-		NSMutableDictionary <OCFileID, OCItem *> *cacheItemsByFileID = cacheSet.itemsByFileID;
-		NSMutableDictionary <OCFileID, OCItem *> *retrievedItemsByFileID = retrievedSet.itemsByFileID;
-		NSMutableDictionary <OCPath, OCItem *> *cacheItemsByPath = cacheSet.itemsByPath;
-		NSMutableDictionary <OCPath, OCItem *> *retrievedItemsByPath = retrievedSet.itemsByPath;
+		NSMutableDictionary <OCFileID, OCItem *> *pairedCacheCollectionsByFileID = [NSMutableDictionary new];
 
 		NSMutableArray <OCItem *> *changedCacheItems = [NSMutableArray new];
 		NSMutableArray <OCItem *> *deletedCacheItems = [NSMutableArray new];
@@ -520,24 +827,42 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 								=> remove
 			*/
 
-			// Iterate retrieved set
-			[retrievedItemsByFileID enumerateKeysAndObjectsUsingBlock:^(OCFileID  _Nonnull retrievedFileID, OCItem * _Nonnull retrievedItem, BOOL * _Nonnull stop) {
-				OCItem *cacheItem;
+			// Pair cached and retrieved items in a single pass
+			[cacheSet mergeWithRetrievedItemList:retrievedSet usingHandler:^(OCItem *cacheItem, OCItem *retrievedItem) {
+				BOOL preserveCacheItem = (cacheItem != nil) &&
+							 ((cacheItem.locallyModified && (cacheItem.localRelativePath!=nil)) || // Reason 1: existing local version that's been modified
+							  (cacheItem.activeSyncRecordIDs.count > 0));				// Reason 2: item has active sync records
 
-				// Item for this fileID already in the cache?
-				if ((cacheItem = cacheItemsByFileID[retrievedFileID]) == nil)
+				if (cacheItem == nil)
 				{
-					// Alternatively: is there an item with the same path (but a different fileID)?
-					cacheItem = cacheItemsByPath[retrievedItem.path];
+					// New item!
+					[queryResults addObject:retrievedItem];
+					[newItems addObject:retrievedItem];
 				}
-
-				// Found a corresponding cache item?
-				if (cacheItem != nil)
+				else if (retrievedItem == nil)
+				{
+					// Cache item no longer on the server
+					if (preserveCacheItem)
+					{
+						// Preserve locally modified items
+						[queryResults addObject:cacheItem];
+					}
+					else
+					{
+						// Remove item
+						[deletedCacheItems addObject:cacheItem];
+					}
+				}
+				else
 				{
+					// Remember cached version of collections for the refresh and move detection below
+					if (((cacheItem.type == OCItemTypeCollection) || (retrievedItem.type == OCItemTypeCollection)) && (cacheItem.fileID != nil))
+					{
+						pairedCacheCollectionsByFileID[cacheItem.fileID] = cacheItem;
+					}
+
 					// Overriding local item?
-					if ((cacheItem.locallyModified && (cacheItem.localRelativePath!=nil)) || // Reason 1: existing local version that's been modified
-  				            (cacheItem.activeSyncRecordIDs.count > 0)				 // Reason 2: item has active sync records
-					   )
+					if (preserveCacheItem)
 					{
 						// Preserve local item, but merge in info on latest server version
 						retrievedItem.localID = cacheItem.localID;
@@ -600,40 +925,6 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 						[queryResults addObject:retrievedItem];
 					}
 				}
-				else
-				{
-					// New item!
-					[queryResults addObject:retrievedItem];
-					[newItems addObject:retrievedItem];
-				}
-			}];
-
-			// Iterate cache set
-			[cacheItemsByFileID enumerateKeysAndObjectsUsingBlock:^(OCFileID  _Nonnull cacheFileID, OCItem * _Nonnull cacheItem, BOOL * _Nonnull stop) {
-				OCItem *retrievedItem;
-
-				// Item for this cached fileID or path on the server?
-				if ((retrievedItem = retrievedItemsByFileID[cacheFileID]) == nil)
-				{
-					retrievedItem = retrievedItemsByPath[cacheItem.path];
-				}
-
-				if (retrievedItem == nil)
-				{
-					// Cache item no longer on the server
-					if ((cacheItem.locallyModified && (cacheItem.localRelativePath!=nil)) || // Reason 1: existing local version that's been modified
-  				            (cacheItem.activeSyncRecordIDs.count > 0)				 // Reason 2: item has active sync records
-					   )
-					{
-						// Preserve locally modified items
-						[queryResults addObject:cacheItem];
-					}
-					else
-					{
-						// Remove item
-						[deletedCacheItems addObject:cacheItem];
-					}
-				}
 			}];
 
 			// Delete items located in deleted folders
@@ -666,7 +957,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 			// Preserve localID for remotely moved, known items / preserve .removed status for locally removed items while deletion is in progress
 			{
-				NSMutableIndexSet *removeItemsFromDeletedItemsIndexes = nil;
+				NSMutableSet <OCDatabaseID> *knownDatabaseIDs = nil;
 				NSMutableIndexSet *removeItemsFromNewItemsIndexes = nil;
 
 				NSUInteger newItemIndex = 0;
@@ -684,8 +975,6 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 					if (knownItem != nil)
 					{
-						NSUInteger index = 0;
-
 						// Move over metaData
 						OCLocalID parentLocalID = newItem.parentLocalID;
 
@@ -713,22 +1002,15 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 							}
 						}
 
-						// Remove from deletedCacheItems
-						for (OCItem *deletedItem in deletedCacheItems)
+						// Remove from deletedCacheItems (below, in one pass)
+						if (newItem.databaseID != nil)
 						{
-							if ([deletedItem.databaseID isEqual:newItem.databaseID])
+							if (knownDatabaseIDs == nil)
 							{
-								if (removeItemsFromDeletedItemsIndexes == nil)
-								{
-									removeItemsFromDeletedItemsIndexes = [[NSMutableIndexSet alloc] initWithIndex:index];
-								}
-								else
-								{
-									[removeItemsFromDeletedItemsIndexes addIndex:index];
-								}
+								knownDatabaseIDs = [NSMutableSet new];
 							}
 
-							index++;
+							[knownDatabaseIDs addObject:newItem.databaseID];
 						}
 
 						// Remove from newItems
@@ -749,9 +1031,11 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 				}
 
 				// Commit changes
-				if (removeItemsFromDeletedItemsIndexes != nil)
+				if (knownDatabaseIDs != nil)
 				{
-					[deletedCacheItems removeObjectsAtIndexes:removeItemsFromDeletedItemsIndexes];
+					[deletedCacheItems removeObjectsAtIndexes:[deletedCacheItems indexesOfObjectsPassingTest:^BOOL(OCItem * _Nonnull deletedItem, NSUInteger idx, BOOL * _Nonnull stop) {
+						return ((deletedItem.databaseID != nil) && [knownDatabaseIDs containsObject:deletedItem.databaseID]);
+					}]];
 				}
 
 				if (removeItemsFromNewItemsIndexes != nil)
@@ -797,7 +1081,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 				{
 					if ((item.type == OCItemTypeCollection) && (item.path != nil) && (item.fileID!=nil) && (item.eTag!=nil) && ![item.path isEqual:task.path])
 					{
-						__block OCItem *cacheItem = cacheItemsByFileID[item.fileID];
+						__block OCItem *cacheItem = pairedCacheCollectionsByFileID[item.fileID];
 
 						if (cacheItem == nil)
 						{
@@ -930,6 +1214,15 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 			return;
 		}
+
+		// Remember the ETag of the merged folder, so the next retrieval of its contents can be made conditional
+		if ((queryState == OCQueryStateIdle) && (taskPath != nil))
+		{
+			@synchronized(_listingETagsByPath)
+			{
+				_listingETagsByPath[taskPath] = targetRemoved ? nil : task.retrievedSet.itemsByPath[taskPath].eTag;
+			}
+		}
 	}
 	else
 	{
@@ -968,7 +1261,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 		}
 	}
 
-	if (queryState != OCQueryStateIdle)
+	if ((queryState != OCQueryStateIdle) || (!performMerge && task.retrievedSet.notModified))
 	{
 		[self beginActivity:@"item list task - update queries"];
 
@@ -1004,7 +1297,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 - (void)_finalizeQueryUpdatesWithQueryResults:(NSMutableArray<OCItem *> *)queryResults queryResultsChangedItems:(NSMutableArray<OCItem *> *)queryResultsChangedItems queryState:(OCQueryState)queryState querySyncAnchor:(OCSyncAnchor)querySyncAnchor task:(OCCoreItemListTask * _Nonnull)task taskPath:(NSString *)taskPath targetRemoved:(BOOL)targetRemoved
 {
-	NSMutableDictionary <OCPath, OCItem *> *queryResultItemsByPath = nil;
+	NSDictionary <OCPath, OCItem *> *queryResultItemsByPath = nil;
 	NSMutableArray <OCItem *> *queryResultWithoutRootItem = nil;
 	OCItem *taskRootItem = nil;
 
@@ -1090,7 +1383,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 						if (queryResultItemsByPath == nil)
 						{
-							queryResultItemsByPath = [OCCoreItemList itemListWithItems:queryResults].itemsByPath;
+							queryResultItemsByPath = [OCCoreItemList itemListWithItems:queryResults indexes:OCCoreItemListIndexPath].itemsByPath;
 						}
 
 						if ((queryPathSubpath = [taskPath stringByAppendingPathComponent:queryPathSubfolder]) != nil)
@@ -1127,7 +1420,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 					if (queryResultItemsByPath == nil)
 					{
-						queryResultItemsByPath = [OCCoreItemList itemListWithItems:queryResults].itemsByPath;
+						queryResultItemsByPath = [OCCoreItemList itemListWithItems:queryResults indexes:OCCoreItemListIndexPath].itemsByPath;
 					}
 
 					if ((itemAtPath = queryResultItemsByPath[queryItemPath]) != nil)
@@ -1283,25 +1576,50 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 		{
 			if (strongSelf.state == OCCoreStateRunning)
 			{
-				OCEventTarget *eventTarget;
-
-				eventTarget = [OCEventTarget eventTargetWithEventHandlerIdentifier:strongSelf.eventHandlerIdentifier userInfo:nil ephermalUserInfo:nil];
-
-				NSDictionary<OCConnectionOptionKey,id> *options = nil;
-
-				if (nonCritical)
+				if (strongSelf.usesSyncCollection)
 				{
-					options = @{
-						OCConnectionOptionIsNonCriticalKey : @(YES),
-					};
+					// Retrieve changes since last check directly, fall back to ETag walk where necessary
+					[strongSelf checkForUpdatesUsingSyncCollectionWithFallbackHandler:^{
+						[weakSelf _checkRootItemForChangesNonCritical:nonCritical];
+					}];
+				}
+				else
+				{
+					[strongSelf _checkRootItemForChangesNonCritical:nonCritical];
 				}
-
-				[strongSelf.connection retrieveItemListAtPath:@"/" depth:0 options:options resultTarget:eventTarget];
 			}
 		}
 	} inBackground:inBackground];
 }
 
+- (void)_checkRootItemForChangesNonCritical:(BOOL)nonCritical
+{
+	OCEventTarget *eventTarget;
+
+	if (self.state != OCCoreStateRunning)
+	{
+		return;
+	}
+
+	eventTarget = [OCEventTarget eventTargetWithEventHandlerIdentifier:self.eventHandlerIdentifier userInfo:nil ephermalUserInfo:nil];
+
+	NSMutableDictionary<OCConnectionOptionKey,id> *options = [NSMutableDictionary new];
+	OCItem *cachedRootItem;
+
+	if (nonCritical)
+	{
+		options[OCConnectionOptionIsNonCriticalKey] = @(YES);
+	}
+
+	// Only transfer the root item if its ETag changed
+	if (((cachedRootItem = [self.database retrieveCacheItemsSyncAtPath:@"/" itemOnly:YES error:NULL syncAnchor:NULL].firstObject) != nil) && (cachedRootItem.eTag != nil))
+	{
+		options[OCConnectionOptionIfNoneMatchKey] = cachedRootItem.eTag;
+	}
+
+	[self.connection retrieveItemListAtPath:@"/" depth:0 options:options resultTarget:eventTarget];
+}
+
 - (void)_handleRetrieveItemListEvent:(OCEvent *)event sender:(id)sender
 {
 	OCLogDebug(@"Handling background retrieved items: error=%@, path=%@, depth=%lu, items=%@", OCLogPrivate(event.error), OCLogPrivate(event.path), event.depth, OCLogPrivate(event.result));
@@ -1317,38 +1635,10 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 			OCItem *cacheItem = nil;
 			OCItem *remoteItem = items.firstObject;
 			NSArray<OCItem*> *cacheItems = nil;
-			BOOL updateQuotaTotal = NO;
 
 			if ([remoteItem.path isEqual:@"/"])
 			{
-				// Update root quota properties
-
-				if (((_rootQuotaBytesRemaining != nil) != (remoteItem.quotaBytesRemaining != nil)) || (_rootQuotaBytesRemaining.integerValue != remoteItem.quotaBytesRemaining.integerValue))
-				{
-					[self willChangeValueForKey:@"rootQuotaBytesRemaining"];
-					_rootQuotaBytesRemaining = remoteItem.quotaBytesRemaining;
-					[self didChangeValueForKey:@"rootQuotaBytesRemaining"];
-
-					updateQuotaTotal = YES;
-				}
-
-				if (((_rootQuotaBytesUsed != nil) != (remoteItem.quotaBytesUsed != nil)) || (_rootQuotaBytesUsed.integerValue != remoteItem.quotaBytesUsed.integerValue))
-				{
-					[self willChangeValueForKey:@"rootQuotaBytesUsed"];
-					_rootQuotaBytesUsed = remoteItem.quotaBytesUsed;
-					[self didChangeValueForKey:@"rootQuotaBytesUsed"];
-
-					updateQuotaTotal = YES;
-				}
-
-				if (updateQuotaTotal)
-				{
-					[self willChangeValueForKey:@"rootQuotaBytesTotal"];
-					_rootQuotaBytesTotal = (_rootQuotaBytesRemaining != nil) ?
-							@(_rootQuotaBytesUsed.integerValue + _rootQuotaBytesRemaining.integerValue) :
-							nil;
-					[self didChangeValueForKey:@"rootQuotaBytesTotal"];
-				}
+				[self updateRootQuotaFromItem:remoteItem];
 			}
 
 			if ((cacheItems = [self.database retrieveCacheItemsSyncAtPath:event.path itemOnly:YES error:&error syncAnchor:NULL]) != nil)
@@ -1393,6 +1683,20 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 			}
 		}
 	}
+	else if (IsHTTPErrorWithStatus(event.error, OCHTTPStatusCodeNOT_MODIFIED))
+	{
+		// ETag of the cached item still matches => no changes. We're done.
+		if (event.path.isRootPath && (self.state == OCCoreStateRunning))
+		{
+			@synchronized(_scheduledDirectoryUpdateJobIDs)
+			{
+				if (_scheduledDirectoryUpdateJobActivity == nil)
+				{
+					[self _finishedUpdateScanWithError:nil foundChanges:NO];
+				}
+			}
+		}
+	}
 	else
 	{
 		// Handle certificate errors while connected
@@ -1430,6 +1734,38 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 	}
 }
 
+- (void)updateRootQuotaFromItem:(OCItem *)rootItem
+{
+	BOOL updateQuotaTotal = NO;
+
+	if (((_rootQuotaBytesRemaining != nil) != (rootItem.quotaBytesRemaining != nil)) || (_rootQuotaBytesRemaining.integerValue != rootItem.quotaBytesRemaining.integerValue))
+	{
+		[self willChangeValueForKey:@"rootQuotaBytesRemaining"];
+		_rootQuotaBytesRemaining = rootItem.quotaBytesRemaining;
+		[self didChangeValueForKey:@"rootQuotaBytesRemaining"];
+
+		updateQuotaTotal = YES;
+	}
+
+	if (((_rootQuotaBytesUsed != nil) != (rootItem.quotaBytesUsed != nil)) || (_rootQuotaBytesUsed.integerValue != rootItem.quotaBytesUsed.integerValue))
+	{
+		[self willChangeValueForKey:@"rootQuotaBytesUsed"];
+		_rootQuotaBytesUsed = rootItem.quotaBytesUsed;
+		[self didChangeValueForKey:@"rootQuotaBytesUsed"];
+
+		updateQuotaTotal = YES;
+	}
+
+	if (updateQuotaTotal)
+	{
+		[self willChangeValueForKey:@"rootQuotaBytesTotal"];
+		_rootQuotaBytesTotal = (_rootQuotaBytesRemaining != nil) ?
+				@(_rootQuotaBytesUsed.integerValue + _rootQuotaBytesRemaining.integerValue) :
+				nil;
+		[self didChangeValueForKey:@"rootQuotaBytesTotal"];
+	}
+}
+
 - (NSTimeInterval)effectivePollForChangesInterval
 {
 	if (_effectivePollForChangesInterval == 0)
@@ -1512,6 +1848,15 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 		[_fetchUpdatesCompletionHandlers removeAllObjects];
 	}
 
+	if (error == nil)
+	{
+		// Cache is now up-to-date with (at least) the state of a sync token retrieved before this scan
+		[self commitPendingSyncCollectionToken];
+	}
+
+	// Listings prefetched for this scan must not be used by later scans
+	[self _removeItemListPrefetches];
+
 	if (foundChanges || !_itemPoliciesAppliedInitially)
 	{
 		_itemPoliciesAppliedInitially = YES;
@@ -1525,7 +1870,7 @@ static OCHTTPRequestGroupID OCCoreItemListTaskGroupBackgroundTasks = @"backgroun
 
 	if (_directoryUpdateStartTime != 0)
 	{
-		OCTLog(@[@"ScanChanges"], @"Finished update scan in %.1f sec", NSDate.timeIntervalSinceReferenceDate - _directoryUpdateStartTime);
+		OCTLog(@[@"ScanChanges"], @"Finished update scan in %.1f sec (item list task concurrency: %@)", NSDate.timeIntervalSinceReferenceDate - _directoryUpdateStartTime, self.itemListTasksConcurrencyController);
 		_directoryUpdateStartTime = 0;
 	}
 
@@ -0,0 +1,55 @@
+//
+//  OCCore+SyncCollection.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCCore.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Change detection via sync-collection REPORT (RFC 6578):
+	- the server returns all items changed or removed since a sync token, so scattered changes deep in the tree don't require walking all folders with a changed ETag
+	- the returned changes are merged into the cache and queries through -performUpdatesForAddedItems:..
+	- the sync token is stored in the vault's key-value store. Without a token, the current token is retrieved before a regular ETag walk and stored once that walk completed.
+	- new items whose parent folder isn't in the cache are skipped. If the missing parent is a direct child of a cached folder, that folder is
+	  rescanned and the sync token not advanced, so that the changes are retrieved and placed again with the next check
+	- falls back to the ETag walk if the server doesn't support sync-collection or rejects the token. Only a failed DAV:valid-sync-token precondition
+	  counts as a rejected token - any other rejection of the REPORT marks sync-collection as unsupported by the server (remembered in the vault)
+	- off by default (OCCoreSyncCollectionEnabled)
+*/
+
+@interface OCCore (SyncCollection)
+
+@property(readonly,nonatomic) BOOL usesSyncCollection; //!< YES if checks for updates use sync-collection REPORT rather than an ETag walk of the tree
+
+- (void)invalidateSyncCollectionToken; //!< Removes the stored sync token, so that the next check for updates walks the tree and starts over with a fresh token
+
+@end
+
+@interface OCCore (SyncCollectionInternal)
+
+- (void)checkForUpdatesUsingSyncCollectionWithFallbackHandler:(dispatch_block_t)fallbackHandler; //!< Retrieves and applies all changes since the stored sync token. Calls fallbackHandler if an ETag walk needs to be performed instead.
+- (void)commitPendingSyncCollectionToken; //!< Stores the sync token retrieved before an ETag walk. Called when the walk completed successfully.
+
+- (void)applySyncCollectionChangedItems:(NSArray<OCItem *> *)changedItems removedItems:(NSArray<OCItem *> *)removedItems completionHandler:(void(^)(NSError * _Nullable error, BOOL foundChanges, BOOL skippedItems))completionHandler; //!< Merges changed and removed items returned by a sync-collection REPORT into the cache. skippedItems is YES if new items couldn't be placed because their parent folder is missing from the cache - in which case rescans of the folders that should contain the missing parents have been scheduled.
+
+@end
+
+extern OCKeyValueStoreKey OCKeyValueStoreKeyCoreSyncCollectionToken;
+extern OCKeyValueStoreKey OCKeyValueStoreKeyCoreSyncCollectionUnsupportedDate;
+
+NS_ASSUME_NONNULL_END
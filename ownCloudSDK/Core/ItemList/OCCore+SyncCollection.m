@@ -0,0 +1,471 @@
+//
+//  OCCore+SyncCollection.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCCore+SyncCollection.h"
+#import "OCCore+ItemList.h"
+#import "OCCore+ItemUpdates.h"
+#import "OCCore+SyncEngine.h"
+#import "OCCore+Internal.h"
+#import "OCConnection.h"
+#import "OCLogger.h"
+#import "OCMacros.h"
+#import "NSError+OCError.h"
+#import "NSString+OCPath.h"
+#import "OCHTTPStatus.h"
+#import "NSError+OCDAVError.h"
+
+#define OCCoreSyncCollectionPageSize 500 //!< Maximum number of changes requested per sync-collection REPORT
+#define OCCoreSyncCollectionUnsupportedRecheckInterval (7 * 24 * 60 * 60) //!< Time after which a server found to not support sync-collection is probed again (f.ex. after a server upgrade)
+
+@implementation OCCore (SyncCollection)
+
+#pragma mark - Availability
+- (BOOL)usesSyncCollection
+{
+	NSDate *unsupportedDate;
+
+	if (_syncCollectionUnsupported || !((NSNumber *)[self classSettingForOCClassSettingsKey:OCCoreSyncCollectionEnabled]).boolValue)
+	{
+		return (NO);
+	}
+
+	// Servers found to not support sync-collection are remembered across sessions, so the REPORT isn't retried with every launch
+	if (((unsupportedDate = OCTypedCast([self.vault.keyValueStore readObjectForKey:OCKeyValueStoreKeyCoreSyncCollectionUnsupportedDate], NSDate)) != nil) &&
+	    (-unsupportedDate.timeIntervalSinceNow < OCCoreSyncCollectionUnsupportedRecheckInterval))
+	{
+		_syncCollectionUnsupported = YES;
+		return (NO);
+	}
+
+	return (YES);
+}
+
+- (void)_latchSyncCollectionUnsupported
+{
+	_syncCollectionUnsupported = YES;
+
+	[self.vault.keyValueStore storeObject:[NSDate new] forKey:OCKeyValueStoreKeyCoreSyncCollectionUnsupportedDate];
+	[self invalidateSyncCollectionToken];
+}
+
+- (void)invalidateSyncCollectionToken
+{
+	@synchronized(self)
+	{
+		_pendingSyncCollectionToken = nil;
+		_heldBackSyncCollectionToken = nil;
+	}
+
+	[self.vault.keyValueStore storeObject:nil forKey:OCKeyValueStoreKeyCoreSyncCollectionToken];
+}
+
+#pragma mark - Check for updates
+- (void)checkForUpdatesUsingSyncCollectionWithFallbackHandler:(dispatch_block_t)fallbackHandler
+{
+	OCDAVSyncToken syncToken = OCTypedCast([self.vault.keyValueStore readObjectForKey:OCKeyValueStoreKeyCoreSyncCollectionToken], NSString);
+
+	if (syncToken == nil)
+	{
+		// No token yet: retrieve the current token first, then perform a regular ETag walk. Once the walk completed, the cache reflects (at least) the state
+		// identified by the token - and any changes made in between will be returned (again) by the first sync-collection REPORT.
+		[self.connection retrieveSyncTokenAtPath:@"/" completionHandler:^(NSError * _Nullable error, OCDAVSyncToken  _Nullable syncToken) {
+			if (syncToken != nil)
+			{
+				@synchronized(self)
+				{
+					self->_pendingSyncCollectionToken = syncToken;
+				}
+			}
+			else if ([self _isSyncCollectionUnsupportedError:error])
+			{
+				OCLogDebug(@"Server doesn't provide a sync token (%@) - using ETag walk", error);
+				[self _latchSyncCollectionUnsupported];
+			}
+
+			fallbackHandler();
+		}];
+
+		return;
+	}
+
+	[self _retrieveSyncCollectionChangesSince:syncToken foundChanges:NO fallbackHandler:fallbackHandler];
+}
+
+- (void)_retrieveSyncCollectionChangesSince:(OCDAVSyncToken)syncToken foundChanges:(BOOL)previouslyFoundChanges fallbackHandler:(dispatch_block_t)fallbackHandler
+{
+	[self.connection retrieveChangesAtPath:@"/" sinceSyncToken:syncToken limit:OCCoreSyncCollectionPageSize completionHandler:^(NSError * _Nullable error, NSArray<OCItem *> * _Nullable changedItems, NSArray<OCItem *> * _Nullable removedItems, OCDAVSyncToken _Nullable newSyncToken, BOOL moreChangesAvailable) {
+		if (error != nil)
+		{
+			if (error.davError == OCDAVErrorInvalidSyncToken)
+			{
+				// DAV:valid-sync-token precondition failed => start over with a fresh token
+				OCLogDebug(@"Sync token rejected by server (%@) - using ETag walk", error);
+				[self invalidateSyncCollectionToken];
+			}
+			else if ([self _isSyncCollectionUnsupportedError:error])
+			{
+				// Any other rejection of the REPORT itself (f.ex. the 403 returned by Sabre for unsupported REPORTs) => stop using it, so it isn't retried with every check
+				OCLogDebug(@"sync-collection REPORT not supported (%@) - using ETag walk", error);
+				[self _latchSyncCollectionUnsupported];
+			}
+
+			fallbackHandler();
+			return;
+		}
+
+		OCLogDebug(@"Retrieved changes since sync token: %lu changed, %lu removed, more: %d", (unsigned long)changedItems.count, (unsigned long)removedItems.count, moreChangesAvailable);
+
+		for (OCItem *changedItem in changedItems)
+		{
+			if (changedItem.path.isRootPath)
+			{
+				// Quota properties aren't part of the REPORT => retrieve them along with the root item
+				[self.connection retrieveItemListAtPath:@"/" depth:0 options:@{ OCConnectionOptionIsNonCriticalKey : @(YES) } completionHandler:^(NSError * _Nullable error, NSArray<OCItem *> * _Nullable items) {
+					OCItem *rootItem;
+
+					if (((rootItem = items.firstObject) != nil) && rootItem.path.isRootPath)
+					{
+						[self queueBlock:^{
+							[self updateRootQuotaFromItem:rootItem];
+						}];
+					}
+				}];
+				break;
+			}
+		}
+
+		[self applySyncCollectionChangedItems:changedItems removedItems:removedItems completionHandler:^(NSError * _Nullable error, BOOL foundChanges, BOOL skippedItems) {
+			BOOL holdBackToken = NO;
+
+			if (error != nil)
+			{
+				OCLogError(@"Error applying changes from sync-collection REPORT: %@ - using ETag walk", error);
+				fallbackHandler();
+				return;
+			}
+
+			@synchronized(self)
+			{
+				if (skippedItems && ![self->_heldBackSyncCollectionToken isEqual:syncToken])
+				{
+					// Items were skipped because their parent is missing from the cache, and the folders that should contain the parents are being rescanned
+					// => don't advance the token, so that the skipped items are retrieved and placed again with the next check. Only do this once per
+					// token, so that a parent that can't be found doesn't keep the token from advancing forever.
+					self->_heldBackSyncCollectionToken = syncToken;
+					holdBackToken = YES;
+				}
+				else
+				{
+					self->_heldBackSyncCollectionToken = nil;
+				}
+			}
+
+			if (holdBackToken)
+			{
+				OCLogDebug(@"Skipped items with missing parents - not advancing sync token until the missing parents have been retrieved");
+			}
+			else
+			{
+				[self.vault.keyValueStore storeObject:newSyncToken forKey:OCKeyValueStoreKeyCoreSyncCollectionToken];
+			}
+
+			if (moreChangesAvailable && !holdBackToken && ![newSyncToken isEqual:syncToken])
+			{
+				// Fetch next page of changes
+				[self _retrieveSyncCollectionChangesSince:newSyncToken foundChanges:(previouslyFoundChanges || foundChanges) fallbackHandler:fallbackHandler];
+				return;
+			}
+
+			[self queueBlock:^{
+				@synchronized(self->_scheduledDirectoryUpdateJobIDs)
+				{
+					// Moved folders are rescanned as update jobs - which finish the scan when done
+					if ((self->_scheduledDirectoryUpdateJobActivity == nil) && (self->_pendingScheduledDirectoryUpdateJobs == 0))
+					{
+						[self _finishedUpdateScanWithError:nil foundChanges:(previouslyFoundChanges || foundChanges)];
+					}
+				}
+
+				[self coordinatedScanForChangesDidFinish];
+			}];
+		}];
+	}];
+}
+
+- (BOOL)_isSyncCollectionUnsupportedError:(NSError *)error
+{
+	return ([error isOCErrorWithCode:OCErrorFeatureNotSupportedByServer] ||
+		IsHTTPErrorWithStatus(error, OCHTTPStatusCodeBAD_REQUEST) ||
+		IsHTTPErrorWithStatus(error, OCHTTPStatusCodeFORBIDDEN) ||
+		IsHTTPErrorWithStatus(error, OCHTTPStatusCodeNOT_FOUND) ||
+		IsHTTPErrorWithStatus(error, OCHTTPStatusCodeMETHOD_NOT_ALLOWED) ||
+		IsHTTPErrorWithStatus(error, OCHTTPStatusCodeNOT_IMPLEMENTED));
+}
+
+- (void)commitPendingSyncCollectionToken
+{
+	OCDAVSyncToken pendingSyncToken = nil;
+
+	@synchronized(self)
+	{
+		pendingSyncToken = _pendingSyncCollectionToken;
+		_pendingSyncCollectionToken = nil;
+	}
+
+	if (pendingSyncToken != nil)
+	{
+		OCLogDebug(@"ETag walk completed - using sync-collection REPORT from now on");
+		[self.vault.keyValueStore storeObject:pendingSyncToken forKey:OCKeyValueStoreKeyCoreSyncCollectionToken];
+	}
+}
+
+#pragma mark - Merge
+- (BOOL)_preservesLocalVersionOfItem:(OCItem *)cacheItem
+{
+	return ((cacheItem.locallyModified && (cacheItem.localRelativePath != nil)) || // Reason 1: existing local version that's been modified
+		(cacheItem.activeSyncRecordIDs.count > 0)); // Reason 2: item has active sync records
+}
+
+- (void)applySyncCollectionChangedItems:(NSArray<OCItem *> *)changedItems removedItems:(NSArray<OCItem *> *)removedItems completionHandler:(void(^)(NSError * _Nullable error, BOOL foundChanges, BOOL skippedItems))completionHandler
+{
+	__block BOOL calledCompletionHandler = NO;
+
+	if ((changedItems.count == 0) && (removedItems.count == 0))
+	{
+		completionHandler(nil, NO, NO);
+		return;
+	}
+
+	[self incrementSyncAnchorWithProtectedBlock:^NSError * _Nullable(OCSyncAnchor previousSyncAnchor, OCSyncAnchor newSyncAnchor) {
+		NSMutableArray<OCItem *> *addedItems = [NSMutableArray new];
+		NSMutableArray<OCItem *> *updatedItems = [NSMutableArray new];
+		NSMutableArray<OCItem *> *deletedItems = [NSMutableArray new];
+		NSMutableArray<OCPath> *refreshPaths = [NSMutableArray new];
+		NSMutableDictionary<OCPath, OCItem *> *folderItemsByPath = [NSMutableDictionary new];
+		NSMutableSet<OCFileID> *changedFileIDs = [NSMutableSet new];
+		NSMutableSet<OCLocalID> *deletedLocalIDs = [NSMutableSet new];
+		BOOL foundChanges, skippedItems = NO;
+
+		OCItem *(^ParentItemForPath)(OCPath path) = ^(OCPath path) {
+			OCPath parentPath = path.parentPath;
+			OCItem *parentItem;
+
+			if ((parentItem = folderItemsByPath[parentPath]) == nil)
+			{
+				if ((parentItem = [self.database retrieveCacheItemsSyncAtPath:parentPath itemOnly:YES error:NULL syncAnchor:NULL].firstObject) != nil)
+				{
+					folderItemsByPath[parentPath] = parentItem;
+				}
+			}
+
+			return (parentItem);
+		};
+
+		for (OCItem *changedItem in changedItems)
+		{
+			[changedFileIDs addObject:changedItem.fileID];
+		}
+
+		// Changed items - parents before their contents, so that new folders can be used as parent for new items
+		for (OCItem *retrievedItem in [changedItems sortedArrayUsingComparator:^NSComparisonResult(OCItem *item1, OCItem *item2) {
+			return ((item1.path.length < item2.path.length) ? NSOrderedAscending : ((item1.path.length > item2.path.length) ? NSOrderedDescending : NSOrderedSame));
+		}])
+		{
+			__block OCItem *cacheItem = nil;
+			OCItem *mergedItem = retrievedItem;
+
+			[self.database retrieveCacheItemForFileID:retrievedItem.fileID includingRemoved:YES completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, OCItem *item) {
+				cacheItem = item;
+			}];
+
+			if (cacheItem != nil)
+			{
+				if ([self _preservesLocalVersionOfItem:cacheItem])
+				{
+					// Preserve local item, but merge in info on latest server version
+					retrievedItem.localID = cacheItem.localID;
+					cacheItem.remoteItem = retrievedItem;
+
+					[updatedItems addObject:cacheItem];
+					mergedItem = cacheItem;
+				}
+				else
+				{
+					BOOL removedWhileDeleting = cacheItem.removed && (cacheItem.syncActivity & OCItemSyncActivityDeleting);
+
+					[retrievedItem prepareToReplace:cacheItem];
+
+					retrievedItem.locallyModified = cacheItem.locallyModified;
+					retrievedItem.localRelativePath = cacheItem.localRelativePath;
+					retrievedItem.localCopyVersionIdentifier = cacheItem.localCopyVersionIdentifier;
+					retrievedItem.downloadTriggerIdentifier = cacheItem.downloadTriggerIdentifier;
+
+					if (![cacheItem.path isEqual:retrievedItem.path])
+					{
+						// Moved remotely
+						OCItem *parentItem;
+
+						retrievedItem.previousPath = cacheItem.path;
+
+						if ((parentItem = ParentItemForPath(retrievedItem.path)) != nil)
+						{
+							retrievedItem.parentFileID = parentItem.fileID;
+							retrievedItem.parentLocalID = parentItem.localID;
+						}
+
+						if (retrievedItem.type == OCItemTypeCollection)
+						{
+							// Rescan moved folders to move their contents along
+							[refreshPaths addObject:retrievedItem.path];
+						}
+
+						[updatedItems addObject:retrievedItem];
+					}
+					else if (removedWhileDeleting)
+					{
+						// Prevent files in process of deletion from re-appearing
+						retrievedItem.removed = YES;
+						[updatedItems addObject:retrievedItem];
+					}
+					else if (cacheItem.removed ||
+						 ![retrievedItem.itemVersionIdentifier isEqual:cacheItem.itemVersionIdentifier] || 	// ETag or FileID mismatch
+						 (retrievedItem.shareTypesMask != cacheItem.shareTypesMask) ||				// Share types mismatch
+						 (retrievedItem.permissions != cacheItem.permissions) ||				// Permissions mismatch
+						 (retrievedItem.isFavorite != cacheItem.isFavorite))					// Favorite mismatch
+					{
+						[updatedItems addObject:retrievedItem];
+					}
+				}
+			}
+			else
+			{
+				// New item
+				OCItem *parentItem;
+
+				if ((parentItem = ParentItemForPath(retrievedItem.path)) == nil)
+				{
+					OCItem *grandParentItem;
+
+					if (((grandParentItem = ParentItemForPath(retrievedItem.path.parentPath)) != nil) && (grandParentItem.type == OCItemTypeCollection))
+					{
+						// Parent is missing from a folder in the cache (f.ex. because the server reports it in a later page) - rescan that folder to retrieve it
+						OCLogDebug(@"Skipping %@ from sync-collection as its parent isn't known - rescanning %@", OCLogPrivate(retrievedItem.path), OCLogPrivate(grandParentItem.path));
+
+						if (![refreshPaths containsObject:grandParentItem.path])
+						{
+							[refreshPaths addObject:grandParentItem.path];
+						}
+
+						skippedItems = YES;
+					}
+					else
+					{
+						// Parent is located in a part of the tree that's not in the cache - the item will be picked up when that part is retrieved
+						OCLogDebug(@"Skipping %@ from sync-collection as its parent isn't known", OCLogPrivate(retrievedItem.path));
+					}
+
+					continue;
+				}
+
+				retrievedItem.parentFileID = parentItem.fileID;
+				retrievedItem.parentLocalID = parentItem.localID;
+
+				[addedItems addObject:retrievedItem];
+			}
+
+			if (mergedItem.type == OCItemTypeCollection)
+			{
+				folderItemsByPath[retrievedItem.path] = mergedItem;
+			}
+		}
+
+		// Removed items
+		for (OCItem *removedItem in removedItems)
+		{
+			OCItem *cacheItem;
+
+			if ((cacheItem = [self.database retrieveCacheItemsSyncAtPath:removedItem.path itemOnly:YES error:NULL syncAnchor:NULL].firstObject) == nil)
+			{
+				// Servers may omit the trailing slash for removed folders
+				cacheItem = [self.database retrieveCacheItemsSyncAtPath:removedItem.path.normalizedDirectoryPath itemOnly:YES error:NULL syncAnchor:NULL].firstObject;
+			}
+
+			if ((cacheItem == nil) || cacheItem.removed || (cacheItem.localID == nil) || [deletedLocalIDs containsObject:cacheItem.localID])
+			{
+				continue;
+			}
+
+			if ([changedFileIDs containsObject:cacheItem.fileID] || [self _preservesLocalVersionOfItem:cacheItem])
+			{
+				// Moved (the item is also reported at its new path) or preserved
+				continue;
+			}
+
+			[deletedItems addObject:cacheItem];
+			[deletedLocalIDs addObject:cacheItem.localID];
+
+			// Delete items located in deleted folders
+			if (cacheItem.type == OCItemTypeCollection)
+			{
+				[self.database retrieveCacheItemsRecursivelyBelowPath:cacheItem.path includingPathItself:NO includingRemoved:NO completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+					for (OCItem *containedItem in items)
+					{
+						if ((containedItem.localID != nil) && ![deletedLocalIDs containsObject:containedItem.localID] &&
+						    ![changedFileIDs containsObject:containedItem.fileID] && ![self _preservesLocalVersionOfItem:containedItem])
+						{
+							[deletedItems addObject:containedItem];
+							[deletedLocalIDs addObject:containedItem.localID];
+						}
+					}
+				}];
+			}
+		}
+
+		foundChanges = (addedItems.count > 0) || (updatedItems.count > 0) || (deletedItems.count > 0);
+
+		OCLogDebug(@"Applying sync-collection changes: added=%lu, updated=%lu, removed=%lu, refreshPaths=%@", (unsigned long)addedItems.count, (unsigned long)updatedItems.count, (unsigned long)deletedItems.count, OCLogPrivate(refreshPaths));
+
+		[self performUpdatesForAddedItems:addedItems
+				     removedItems:deletedItems
+				     updatedItems:updatedItems
+				     refreshPaths:((refreshPaths.count > 0) ? refreshPaths : nil)
+				    newSyncAnchor:newSyncAnchor
+			       beforeQueryUpdates:nil
+				afterQueryUpdates:^(dispatch_block_t  _Nonnull updateCompletionHandler) {
+					calledCompletionHandler = YES;
+					completionHandler(nil, foundChanges, skippedItems);
+
+					updateCompletionHandler();
+				}
+			       queryPostProcessor:nil
+				     skipDatabase:NO];
+
+		return (nil);
+	} completionHandler:^(NSError * _Nullable error, OCSyncAnchor  _Nullable previousSyncAnchor, OCSyncAnchor  _Nullable newSyncAnchor) {
+		if ((error != nil) && !calledCompletionHandler)
+		{
+			calledCompletionHandler = YES;
+			completionHandler(error, NO, NO);
+		}
+	}];
+}
+
+@end
+
+OCKeyValueStoreKey OCKeyValueStoreKeyCoreSyncCollectionToken = @"syncCollectionToken";
+OCKeyValueStoreKey OCKeyValueStoreKeyCoreSyncCollectionUnsupportedDate = @"syncCollectionUnsupportedDate";
@@ -27,21 +27,36 @@ typedef NS_ENUM(NSUInteger, OCCoreItemListState)
 	OCCoreItemListStateFailed
 };
 
+typedef NS_OPTIONS(NSUInteger, OCCoreItemListIndexes)
+{
+	OCCoreItemListIndexPath = (1 << 0),		//!< .itemsByPath, .itemPathsSet
+	OCCoreItemListIndexFileID = (1 << 1),		//!< .itemsByFileID, .itemFileIDsSet
+	OCCoreItemListIndexLocalID = (1 << 2),		//!< .itemsByLocalID, .itemLocalIDsSet
+	OCCoreItemListIndexParentPath = (1 << 3),	//!< .itemsByParentPaths, .itemParentPaths
+
+	OCCoreItemListIndexAll = (OCCoreItemListIndexPath | OCCoreItemListIndexFileID | OCCoreItemListIndexLocalID | OCCoreItemListIndexParentPath)
+};
+
+typedef void(^OCCoreItemListMergeHandler)(OCItem *cacheItem, OCItem *retrievedItem); //!< cacheItem is nil for items new on the server, retrievedItem is nil for items no longer on the server
+
 @interface OCCoreItemList : NSObject
 {
 	OCCoreItemListState _state;
 
 	NSArray <OCItem *> *_items;
-	NSMutableDictionary <OCPath, OCItem *> *_itemsByPath;
+	OCCoreItemListIndexes _indexes;
+	OCCoreItemListIndexes _builtIndexes;
+
+	NSDictionary <OCPath, OCItem *> *_itemsByPath;
 	NSSet <OCPath> *_itemPathsSet;
 
-	NSMutableDictionary <OCFileID, OCItem *> *_itemsByFileID;
+	NSDictionary <OCFileID, OCItem *> *_itemsByFileID;
 	NSSet <OCFileID> *_itemFileIDsSet;
 
-	NSMutableDictionary <OCLocalID, OCItem *> *_itemsByLocalID;
+	NSDictionary <OCLocalID, OCItem *> *_itemsByLocalID;
 	NSSet <OCLocalID> *_itemLocalIDsSet;
 
-	NSMutableDictionary <OCPath, NSMutableArray<OCItem *> *> *_itemsByParentPaths;
+	NSDictionary <OCPath, NSMutableArray<OCItem *> *> *_itemsByParentPaths;
 	NSSet <OCPath> *_itemParentPaths;
 
 	NSError *_error;
@@ -51,22 +66,29 @@ typedef NS_ENUM(NSUInteger, OCCoreItemListState)
 
 @property(strong,nonatomic) NSArray <OCItem *> *items;
 
-@property(readonly,strong,nonatomic) NSMutableDictionary <OCPath, OCItem *> *itemsByPath;
+@property(assign) OCCoreItemListIndexes indexes; //!< The indexes the caller is going to use. All of them are built together, in a single pass over .items, on first access to any of them. Indexes not declared here are built separately when accessed. Defaults to OCCoreItemListIndexAll.
+
+@property(readonly,strong,nonatomic) NSDictionary <OCPath, OCItem *> *itemsByPath;
 @property(readonly,strong,nonatomic) NSSet <OCPath> *itemPathsSet;
 
-@property(readonly,strong,nonatomic) NSMutableDictionary <OCFileID, OCItem *> *itemsByFileID;
+@property(readonly,strong,nonatomic) NSDictionary <OCFileID, OCItem *> *itemsByFileID;
 @property(readonly,strong,nonatomic) NSSet <OCFileID> *itemFileIDsSet;
 
-@property(readonly,strong,nonatomic) NSMutableDictionary <OCLocalID, OCItem *> *itemsByLocalID;
+@property(readonly,strong,nonatomic) NSDictionary <OCLocalID, OCItem *> *itemsByLocalID;
 @property(readonly,strong,nonatomic) NSSet <OCLocalID> *itemLocalIDsSet;
 
-@property(readonly,strong,nonatomic) NSMutableDictionary <OCPath, NSMutableArray<OCItem *> *> *itemsByParentPaths;
+@property(readonly,strong,nonatomic) NSDictionary <OCPath, NSMutableArray<OCItem *> *> *itemsByParentPaths;
 @property(readonly,strong,nonatomic) NSSet <OCPath> *itemParentPaths;
 
 @property(strong) NSError *error;
 
+@property(assign) BOOL notModified; //!< YES if the server indicated the items haven't changed since they were last retrieved (the items are then those from the cache)
+
 + (instancetype)itemListWithItems:(NSArray <OCItem *> *)items;
++ (instancetype)itemListWithItems:(NSArray <OCItem *> *)items indexes:(OCCoreItemListIndexes)indexes;
 
 - (void)updateWithError:(NSError *)error items:(NSArray <OCItem *> *)items;
 
+- (void)mergeWithRetrievedItemList:(OCCoreItemList *)retrievedList usingHandler:(OCCoreItemListMergeHandler)mergeHandler; //!< Pairs the (cached) items of the receiver with the items of retrievedList - by fileID first, then by path for items without fileID counterpart - and calls mergeHandler once per pair or unpaired item. Uses a single, pre-sized fileID index and doesn't build any of the lazy lookup tables. Items without fileID are skipped.
+
 @end
@@ -17,6 +17,7 @@
  */
 
 #import "OCCoreItemList.h"
+#import "OCCoreItemListLookupTable.h"
 #import "NSString+OCPath.h"
 
 @implementation OCCoreItemList
@@ -24,6 +25,7 @@
 @synthesize state = _state;
 
 @synthesize items = _items;
+@synthesize indexes = _indexes;
 @synthesize itemsByPath = _itemsByPath;
 @synthesize itemPathsSet = _itemPathsSet;
 
@@ -45,9 +47,31 @@
 	return (itemList);
 }
 
++ (instancetype)itemListWithItems:(NSArray <OCItem *> *)items indexes:(OCCoreItemListIndexes)indexes
+{
+	OCCoreItemList *itemList;
+
+	itemList = [self new];
+	itemList.indexes = indexes;
+	itemList.items = items;
+
+	return (itemList);
+}
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_indexes = OCCoreItemListIndexAll;
+	}
+
+	return (self);
+}
+
 - (void)updateWithError:(NSError *)error items:(NSArray <OCItem *> *)items
 {
 	self.error = error;
+	self.notModified = NO;
 
 	if (error != nil)
 	{
@@ -60,28 +84,216 @@
 	}
 }
 
+- (void)mergeWithRetrievedItemList:(OCCoreItemList *)retrievedList usingHandler:(OCCoreItemListMergeHandler)mergeHandler
+{
+	NSArray <OCItem *> *cacheItems = self.items;
+	NSArray <OCItem *> *retrievedItems = retrievedList.items;
+	NSMutableDictionary <OCFileID, OCItem *> *unpairedCacheItemsByFileID = [[NSMutableDictionary alloc] initWithCapacity:cacheItems.count];
+	NSMutableArray <OCItem *> *unpairedRetrievedItems = nil;
+	NSMutableDictionary <OCPath, OCItem *> *unpairedRetrievedItemsByPath = nil;
+
+	// Index cache items by fileID
+	for (OCItem *cacheItem in cacheItems)
+	{
+		OCFileID fileID;
+
+		if ((fileID = cacheItem.fileID) != nil)
+		{
+			unpairedCacheItemsByFileID[fileID] = cacheItem;
+		}
+	}
+
+	// Pair retrieved items by fileID - removing paired cache items from the index as we go, so only the (typically few) unpaired ones remain
+	for (OCItem *retrievedItem in retrievedItems)
+	{
+		OCFileID fileID;
+		OCItem *cacheItem;
+
+		if ((fileID = retrievedItem.fileID) == nil)
+		{
+			continue;
+		}
+
+		if ((cacheItem = unpairedCacheItemsByFileID[fileID]) != nil)
+		{
+			[unpairedCacheItemsByFileID removeObjectForKey:fileID];
+
+			mergeHandler(cacheItem, retrievedItem);
+		}
+		else
+		{
+			if (unpairedRetrievedItems == nil)
+			{
+				unpairedRetrievedItems = [NSMutableArray new];
+				unpairedRetrievedItemsByPath = [NSMutableDictionary new];
+			}
+
+			[unpairedRetrievedItems addObject:retrievedItem];
+
+			if (retrievedItem.path != nil)
+			{
+				unpairedRetrievedItemsByPath[retrievedItem.path] = retrievedItem;
+			}
+		}
+	}
+
+	// Pair remaining cache items by path (same path, different fileID) - or report them as no longer on the server
+	for (OCItem *cacheItem in unpairedCacheItemsByFileID.objectEnumerator)
+	{
+		OCItem *retrievedItem = nil;
+		OCPath path;
+
+		if (((path = cacheItem.path) != nil) && ((retrievedItem = unpairedRetrievedItemsByPath[path]) != nil))
+		{
+			[unpairedRetrievedItemsByPath removeObjectForKey:path];
+		}
+
+		mergeHandler(cacheItem, retrievedItem);
+	}
+
+	// Report remaining retrieved items as new, in server order
+	for (OCItem *retrievedItem in unpairedRetrievedItems)
+	{
+		OCPath path = retrievedItem.path;
+
+		if ((path == nil) || (unpairedRetrievedItemsByPath[path] == retrievedItem))
+		{
+			mergeHandler(nil, retrievedItem);
+		}
+	}
+}
+
 - (void)setItems:(NSArray<OCItem *> *)items
 {
+	_builtIndexes = 0;
+
 	_itemsByPath = nil;
 	_itemPathsSet = nil;
+
+	_itemsByFileID = nil;
+	_itemFileIDsSet = nil;
+
+	_itemsByLocalID = nil;
+	_itemLocalIDsSet = nil;
+
+	_itemsByParentPaths = nil;
+	_itemParentPaths = nil;
+
 	_items = items;
 }
 
-- (NSMutableDictionary<OCPath,OCItem *> *)itemsByPath
+#pragma mark - Indexes
+- (void)_buildIndexesIncluding:(OCCoreItemListIndexes)requiredIndex
 {
-	if (_itemsByPath == nil)
+	OCCoreItemListIndexes buildIndexes = (_indexes | requiredIndex) & ~_builtIndexes;
+	NSArray <OCItem *> *items = _items;
+	NSUInteger itemCount = items.count;
+
+	OCCoreItemListLookupTable <OCPath, OCItem *> *itemsByPath = nil;
+	OCCoreItemListLookupTable <OCFileID, OCItem *> *itemsByFileID = nil;
+	OCCoreItemListLookupTable <OCLocalID, OCItem *> *itemsByLocalID = nil;
+	OCCoreItemListLookupTable <OCPath, NSMutableArray<OCItem *> *> *itemsByParentPaths = nil;
+
+	OCPath lastParentPath = nil;
+	NSMutableArray <OCItem *> *lastParentPathItems = nil;
+
+	if ((buildIndexes & requiredIndex) == 0)
 	{
-		_itemsByPath = [NSMutableDictionary new];
+		return;
+	}
+
+	if ((buildIndexes & OCCoreItemListIndexPath) != 0) { itemsByPath = [[OCCoreItemListLookupTable alloc] initWithCapacity:itemCount]; }
+	if ((buildIndexes & OCCoreItemListIndexFileID) != 0) { itemsByFileID = [[OCCoreItemListLookupTable alloc] initWithCapacity:itemCount]; }
+	if ((buildIndexes & OCCoreItemListIndexLocalID) != 0) { itemsByLocalID = [[OCCoreItemListLookupTable alloc] initWithCapacity:itemCount]; }
+	if ((buildIndexes & OCCoreItemListIndexParentPath) != 0) { itemsByParentPaths = [[OCCoreItemListLookupTable alloc] initWithCapacity:0]; } // Number of parent paths isn't known upfront - and typically small
 
-		for (OCItem *item in self.items)
+	// Build all indexes in a single pass
+	for (OCItem *item in items)
+	{
+		OCPath path = item.path;
+
+		if (path != nil)
 		{
-			if (item.path != nil)
+			if (itemsByPath != nil)
 			{
-				_itemsByPath[item.path] = item;
+				[itemsByPath setObject:item forTableKey:path];
+			}
+
+			if (itemsByParentPaths != nil)
+			{
+				OCPath parentPath;
+
+				// Siblings typically follow each other => share the parent path instance and skip the lookup
+				if ((parentPath = [path parentPathSharedWith:lastParentPath]) != nil)
+				{
+					NSMutableArray <OCItem *> *parentPathItems;
+
+					if (parentPath == lastParentPath)
+					{
+						parentPathItems = lastParentPathItems;
+					}
+					else if ((parentPathItems = itemsByParentPaths[parentPath]) == nil)
+					{
+						parentPathItems = [NSMutableArray new];
+						[itemsByParentPaths setObject:parentPathItems forTableKey:parentPath];
+					}
+
+					[parentPathItems addObject:item];
+
+					lastParentPath = parentPath;
+					lastParentPathItems = parentPathItems;
+				}
+			}
+		}
+
+		if (itemsByFileID != nil)
+		{
+			OCFileID fileID;
+
+			if ((fileID = item.fileID) != nil)
+			{
+				[itemsByFileID setObject:item forTableKey:fileID];
+			}
+		}
+
+		if (itemsByLocalID != nil)
+		{
+			OCLocalID localID;
+
+			if ((localID = item.localID) != nil)
+			{
+				[itemsByLocalID setObject:item forTableKey:localID];
 			}
 		}
 	}
 
+	if (itemsByPath != nil) { _itemsByPath = itemsByPath; }
+	if (itemsByFileID != nil) { _itemsByFileID = itemsByFileID; }
+	if (itemsByLocalID != nil) { _itemsByLocalID = itemsByLocalID; }
+	if (itemsByParentPaths != nil) { _itemsByParentPaths = itemsByParentPaths; }
+
+	_builtIndexes |= buildIndexes;
+}
+
+- (NSSet *)_keySetForIndex:(NSDictionary *)index
+{
+	NSArray *keys;
+
+	if ((keys = index.allKeys) != nil)
+	{
+		return ([[NSSet alloc] initWithArray:keys]);
+	}
+
+	return ([NSSet new]);
+}
+
+- (NSDictionary<OCPath,OCItem *> *)itemsByPath
+{
+	if (_itemsByPath == nil)
+	{
+		[self _buildIndexesIncluding:OCCoreItemListIndexPath];
+	}
+
 	return (_itemsByPath);
 }
 
@@ -89,34 +301,17 @@
 {
 	if (_itemPathsSet == nil)
 	{
-		NSArray<OCPath> *itemPaths;
-
-		if ((itemPaths = [self.itemsByPath allKeys]) != nil)
-		{
-			_itemPathsSet = [[NSSet alloc] initWithArray:itemPaths];
-		}
-		else
-		{
-			_itemPathsSet = [NSSet new];
-		}
+		_itemPathsSet = [self _keySetForIndex:self.itemsByPath];
 	}
 
 	return (_itemPathsSet);
 }
 
-- (NSMutableDictionary<OCFileID,OCItem *> *)itemsByFileID
+- (NSDictionary<OCFileID,OCItem *> *)itemsByFileID
 {
 	if (_itemsByFileID == nil)
 	{
-		_itemsByFileID = [NSMutableDictionary new];
-
-		for (OCItem *item in self.items)
-		{
-			if (item.fileID != nil)
-			{
-				_itemsByFileID[item.fileID] = item;
-			}
-		}
+		[self _buildIndexesIncluding:OCCoreItemListIndexFileID];
 	}
 
 	return (_itemsByFileID);
@@ -126,34 +321,17 @@
 {
 	if (_itemFileIDsSet == nil)
 	{
-		NSArray<OCPath> *itemFileIDs;
-
-		if ((itemFileIDs = [self.itemsByFileID allKeys]) != nil)
-		{
-			_itemFileIDsSet = [[NSSet alloc] initWithArray:itemFileIDs];
-		}
-		else
-		{
-			_itemFileIDsSet = [NSSet new];
-		}
+		_itemFileIDsSet = [self _keySetForIndex:self.itemsByFileID];
 	}
 
 	return (_itemFileIDsSet);
 }
 
-- (NSMutableDictionary<OCLocalID,OCItem *> *)itemsByLocalID
+- (NSDictionary<OCLocalID,OCItem *> *)itemsByLocalID
 {
 	if (_itemsByLocalID == nil)
 	{
-		_itemsByLocalID = [NSMutableDictionary new];
-
-		for (OCItem *item in self.items)
-		{
-			if (item.localID != nil)
-			{
-				_itemsByLocalID[item.localID] = item;
-			}
-		}
+		[self _buildIndexesIncluding:OCCoreItemListIndexLocalID];
 	}
 
 	return (_itemsByLocalID);
@@ -163,43 +341,17 @@
 {
 	if (_itemLocalIDsSet == nil)
 	{
-		NSArray<OCPath> *itemLocalIDs;
-
-		if ((itemLocalIDs = [self.itemsByLocalID allKeys]) != nil)
-		{
-			_itemLocalIDsSet = [[NSSet alloc] initWithArray:itemLocalIDs];
-		}
-		else
-		{
-			_itemLocalIDsSet = [NSSet new];
-		}
+		_itemLocalIDsSet = [self _keySetForIndex:self.itemsByLocalID];
 	}
 
 	return (_itemLocalIDsSet);
 }
 
-- (NSMutableDictionary<OCPath,NSMutableArray<OCItem *> *> *)itemsByParentPaths
+- (NSDictionary<OCPath,NSMutableArray<OCItem *> *> *)itemsByParentPaths
 {
 	if (_itemsByParentPaths == nil)
 	{
-		_itemsByParentPaths = [NSMutableDictionary new];
-
-		for (OCItem *item in self.items)
-		{
-			OCPath parentPath;
-
-			if ((parentPath = [item.path parentPath]) != nil)
-			{
-				NSMutableArray <OCItem *> *items;
-
-				if ((items = _itemsByParentPaths[parentPath]) == nil)
-				{
-					_itemsByParentPaths[parentPath] = items = [NSMutableArray new];
-				}
-
-				[items addObject:item];
-			}
-		}
+		[self _buildIndexesIncluding:OCCoreItemListIndexParentPath];
 	}
 
 	return (_itemsByParentPaths);
@@ -209,16 +361,7 @@
 {
 	if (_itemParentPaths == nil)
 	{
-		NSArray<OCPath> *itemParentPaths;
-
-		if ((itemParentPaths = [self.itemsByParentPaths allKeys]) != nil)
-		{
-			_itemParentPaths = [[NSSet alloc] initWithArray:itemParentPaths];
-		}
-		else
-		{
-			_itemParentPaths = [NSSet new];
-		}
+		_itemParentPaths = [self _keySetForIndex:self.itemsByParentPaths];
 	}
 
 	return (_itemParentPaths);
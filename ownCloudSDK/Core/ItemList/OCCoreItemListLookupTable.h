@@ -0,0 +1,37 @@
+//
+//  OCCoreItemListLookupTable.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Immutable (once built) dictionary backed by a single open-addressing (linear probing) table:
+	- keys, objects and key hashes live in three flat arrays, pre-sized for the expected number of keys
+	- lookups compare key pointers first, so interned/shared keys (f.ex. parent paths) skip -isEqual:
+*/
+
+@interface OCCoreItemListLookupTable<KeyType, ObjectType> : NSDictionary<KeyType, ObjectType>
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity; //!< Pre-sizes the table for capacity keys. The table grows if more keys are added.
+
+- (void)setObject:(ObjectType)object forTableKey:(KeyType)key; //!< Adds or replaces the object for key. Only to be used while building the table, before it is handed out.
+
+@end
+
+NS_ASSUME_NONNULL_END
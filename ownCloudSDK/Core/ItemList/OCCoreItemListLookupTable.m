@@ -0,0 +1,291 @@
+//
+//  OCCoreItemListLookupTable.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCCoreItemListLookupTable.h"
+
+static inline NSUInteger OCCoreItemListLookupTableSlot(NSUInteger hash, NSUInteger mask)
+{
+	// Fibonacci hashing spreads the often similar hashes of paths and IDs across the table
+	return ((NSUInteger)(((uint64_t)hash * 11400714819323198485ull) >> 32) & mask);
+}
+
+@interface OCCoreItemListLookupTable ()
+{
+	__strong id *_keys;
+	__strong id *_objects;
+	NSUInteger *_hashes;
+
+	NSUInteger _capacity;
+	NSUInteger _mask;
+	NSUInteger _count;
+}
+@end
+
+@implementation OCCoreItemListLookupTable
+
+#pragma mark - Init & Dealloc
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+	if ((self = [super init]) != nil)
+	{
+		NSUInteger tableCapacity = 8;
+
+		// Keep the load factor at or below 50%
+		while (tableCapacity < (capacity * 2))
+		{
+			tableCapacity <<= 1;
+		}
+
+		[self _allocateCapacity:tableCapacity];
+	}
+
+	return (self);
+}
+
+- (instancetype)init
+{
+	return ([self initWithCapacity:0]);
+}
+
+- (instancetype)initWithObjects:(id _Nonnull const [])objects forKeys:(id<NSCopying> _Nonnull const [])keys count:(NSUInteger)count
+{
+	if ((self = [self initWithCapacity:count]) != nil)
+	{
+		for (NSUInteger idx=0; idx<count; idx++)
+		{
+			[self setObject:objects[idx] forTableKey:keys[idx]];
+		}
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	[self _releaseStorage];
+}
+
+#pragma mark - Storage
+- (void)_allocateCapacity:(NSUInteger)capacity
+{
+	_keys = (__strong id *)calloc(capacity, sizeof(id));
+	_objects = (__strong id *)calloc(capacity, sizeof(id));
+	_hashes = (NSUInteger *)calloc(capacity, sizeof(NSUInteger));
+
+	_capacity = capacity;
+	_mask = capacity - 1;
+	_count = 0;
+}
+
+- (void)_releaseStorage
+{
+	if (_keys != NULL)
+	{
+		for (NSUInteger slot=0; slot<_capacity; slot++)
+		{
+			_keys[slot] = nil;
+			_objects[slot] = nil;
+		}
+
+		free(_keys);
+		free(_objects);
+		free(_hashes);
+
+		_keys = NULL;
+		_objects = NULL;
+		_hashes = NULL;
+	}
+}
+
+- (void)_grow
+{
+	__strong id *oldKeys = _keys;
+	__strong id *oldObjects = _objects;
+	NSUInteger *oldHashes = _hashes;
+	NSUInteger oldCapacity = _capacity;
+
+	[self _allocateCapacity:(oldCapacity << 1)];
+
+	for (NSUInteger oldSlot=0; oldSlot<oldCapacity; oldSlot++)
+	{
+		if (oldKeys[oldSlot] != nil)
+		{
+			NSUInteger slot = OCCoreItemListLookupTableSlot(oldHashes[oldSlot], _mask);
+
+			while (_keys[slot] != nil)
+			{
+				slot = (slot + 1) & _mask;
+			}
+
+			_keys[slot] = oldKeys[oldSlot];
+			_objects[slot] = oldObjects[oldSlot];
+			_hashes[slot] = oldHashes[oldSlot];
+			_count++;
+
+			oldKeys[oldSlot] = nil;
+			oldObjects[oldSlot] = nil;
+		}
+	}
+
+	free(oldKeys);
+	free(oldObjects);
+	free(oldHashes);
+}
+
+#pragma mark - Building
+- (void)setObject:(id)object forTableKey:(id)key
+{
+	NSUInteger hash = [key hash], slot;
+	id slotKey;
+
+	if (((_count + 1) * 2) > _capacity)
+	{
+		[self _grow];
+	}
+
+	slot = OCCoreItemListLookupTableSlot(hash, _mask);
+
+	while ((slotKey = _keys[slot]) != nil)
+	{
+		if ((slotKey == key) || ((_hashes[slot] == hash) && [slotKey isEqual:key]))
+		{
+			// Replace object for existing key
+			_objects[slot] = object;
+			return;
+		}
+
+		slot = (slot + 1) & _mask;
+	}
+
+	_keys[slot] = key;
+	_objects[slot] = object;
+	_hashes[slot] = hash;
+	_count++;
+}
+
+#pragma mark - NSDictionary primitives
+- (NSUInteger)count
+{
+	return (_count);
+}
+
+- (id)objectForKey:(id)key
+{
+	NSUInteger hash, slot;
+	id slotKey;
+
+	if ((key == nil) || (_count == 0))
+	{
+		return (nil);
+	}
+
+	hash = [key hash];
+	slot = OCCoreItemListLookupTableSlot(hash, _mask);
+
+	while ((slotKey = _keys[slot]) != nil)
+	{
+		if ((slotKey == key) || ((_hashes[slot] == hash) && [slotKey isEqual:key]))
+		{
+			return (_objects[slot]);
+		}
+
+		slot = (slot + 1) & _mask;
+	}
+
+	return (nil);
+}
+
+- (NSEnumerator *)keyEnumerator
+{
+	return (self.allKeys.objectEnumerator);
+}
+
+#pragma mark - Faster enumeration
+- (NSArray *)allKeys
+{
+	NSMutableArray *keys = [[NSMutableArray alloc] initWithCapacity:_count];
+
+	for (NSUInteger slot=0; slot<_capacity; slot++)
+	{
+		if (_keys[slot] != nil)
+		{
+			[keys addObject:_keys[slot]];
+		}
+	}
+
+	return (keys);
+}
+
+- (NSArray *)allValues
+{
+	NSMutableArray *objects = [[NSMutableArray alloc] initWithCapacity:_count];
+
+	for (NSUInteger slot=0; slot<_capacity; slot++)
+	{
+		if (_keys[slot] != nil)
+		{
+			[objects addObject:_objects[slot]];
+		}
+	}
+
+	return (objects);
+}
+
+- (void)enumerateKeysAndObjectsUsingBlock:(void (NS_NOESCAPE ^)(id _Nonnull, id _Nonnull, BOOL * _Nonnull))block
+{
+	BOOL stop = NO;
+
+	for (NSUInteger slot=0; (slot<_capacity) && !stop; slot++)
+	{
+		if (_keys[slot] != nil)
+		{
+			block(_keys[slot], _objects[slot], &stop);
+		}
+	}
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained _Nullable [])buffer count:(NSUInteger)len
+{
+	NSUInteger slot = state->state, count = 0;
+
+	state->mutationsPtr = &state->extra[0]; // not mutated once built
+	state->itemsPtr = buffer;
+
+	while ((slot < _capacity) && (count < len))
+	{
+		if (_keys[slot] != nil)
+		{
+			buffer[count++] = _keys[slot];
+		}
+
+		slot++;
+	}
+
+	state->state = slot;
+
+	return (count);
+}
+
+#pragma mark - NSCopying
+- (id)copyWithZone:(NSZone *)zone
+{
+	// Immutable once built
+	return (self);
+}
+
+@end
@@ -0,0 +1,53 @@
+//
+//  OCCoreItemListPrefetch.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCTypes.h"
+#import "OCItem.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSUInteger, OCCoreItemListPrefetchState)
+{
+	OCCoreItemListPrefetchStatePending,	//!< The listings are not yet available
+	OCCoreItemListPrefetchStateCompleted,	//!< The listings are available
+	OCCoreItemListPrefetchStateDeclined	//!< No listings are available (subtree too large, request failed, …) - folders need to be retrieved individually
+};
+
+typedef void(^OCCoreItemListPrefetchListingHandler)(NSArray<OCItem *> * _Nullable items);
+
+/*
+	Listings of all folders below .rootPath, retrieved via a single depth infinity PROPFIND and handed out to the item list tasks
+	scanning these folders in place of a depth 1 PROPFIND each.
+*/
+
+@interface OCCoreItemListPrefetch : NSObject
+
+@property(strong,readonly) OCPath rootPath; //!< Path of the folder whose subtree is prefetched
+@property(readonly) OCCoreItemListPrefetchState state; //!< State of the prefetch
+@property(readonly,nonatomic) BOOL expired; //!< YES if the prefetch was declined or its listings are too old to be used
+
+- (instancetype)initWithRootPath:(OCPath)rootPath;
+
+- (void)retrieveListingForPath:(OCPath)path handler:(OCCoreItemListPrefetchListingHandler)handler; //!< Calls handler with the listing for the folder at path (the folder item, followed by its contents) once available - or with nil if none is available. Every listing is handed out only once.
+
+- (void)completeWithItems:(nullable NSArray<OCItem *> *)items; //!< Splits items (the response to a depth infinity PROPFIND of .rootPath) into listings and passes them to waiting handlers. Pass nil if no items could be retrieved.
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,160 @@
+//
+//  OCCoreItemListPrefetch.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCCoreItemListPrefetch.h"
+#import "NSString+OCPath.h"
+
+#define OCCoreItemListPrefetchMaximumAge 60.0 //!< Listings older than this (in seconds) are no longer handed out
+
+@interface OCCoreItemListPrefetch ()
+{
+	OCCoreItemListPrefetchState _state;
+	NSTimeInterval _completionTime;
+
+	NSMutableDictionary<OCPath, NSMutableArray<OCItem *> *> *_listingsByPath;
+	NSMutableDictionary<OCPath, NSMutableArray<OCCoreItemListPrefetchListingHandler> *> *_waitingHandlersByPath;
+}
+@end
+
+@implementation OCCoreItemListPrefetch
+
+@synthesize state = _state;
+
+- (instancetype)initWithRootPath:(OCPath)rootPath
+{
+	if ((self = [super init]) != nil)
+	{
+		_rootPath = rootPath;
+		_state = OCCoreItemListPrefetchStatePending;
+
+		_waitingHandlersByPath = [NSMutableDictionary new];
+	}
+
+	return (self);
+}
+
+- (BOOL)expired
+{
+	@synchronized(self)
+	{
+		return ((_state == OCCoreItemListPrefetchStateDeclined) ||
+			((_state == OCCoreItemListPrefetchStateCompleted) && ((NSDate.timeIntervalSinceReferenceDate - _completionTime) > OCCoreItemListPrefetchMaximumAge)));
+	}
+}
+
+- (NSArray<OCItem *> *)_consumeListingForPath:(OCPath)path
+{
+	NSMutableArray<OCItem *> *listing;
+
+	if ((listing = _listingsByPath[path]) != nil)
+	{
+		[_listingsByPath removeObjectForKey:path];
+
+		// Hand out copies, so that changes made while merging one listing don't leak into others sharing the same items
+		return ([[NSArray alloc] initWithArray:listing copyItems:YES]);
+	}
+
+	return (nil);
+}
+
+- (void)retrieveListingForPath:(OCPath)path handler:(OCCoreItemListPrefetchListingHandler)handler
+{
+	NSArray<OCItem *> *listing = nil;
+
+	@synchronized(self)
+	{
+		if (_state == OCCoreItemListPrefetchStatePending)
+		{
+			NSMutableArray<OCCoreItemListPrefetchListingHandler> *waitingHandlers;
+
+			if ((waitingHandlers = _waitingHandlersByPath[path]) == nil)
+			{
+				_waitingHandlersByPath[path] = waitingHandlers = [NSMutableArray new];
+			}
+
+			[waitingHandlers addObject:[handler copy]];
+
+			return;
+		}
+
+		if (!self.expired)
+		{
+			listing = [self _consumeListingForPath:path];
+		}
+	}
+
+	handler(listing);
+}
+
+- (void)completeWithItems:(NSArray<OCItem *> *)items
+{
+	NSMutableDictionary<OCPath, NSMutableArray<OCItem *> *> *listingsByPath = nil;
+	NSMutableArray<dispatch_block_t> *handlerCalls = [NSMutableArray new];
+
+	if (items != nil)
+	{
+		listingsByPath = [NSMutableDictionary new];
+
+		// Every folder's listing starts with the folder itself …
+		for (OCItem *item in items)
+		{
+			if ((item.type == OCItemTypeCollection) && (item.path != nil))
+			{
+				listingsByPath[item.path] = [NSMutableArray arrayWithObject:item];
+			}
+		}
+
+		// … followed by its contents
+		for (OCItem *item in items)
+		{
+			OCPath path;
+
+			if (((path = item.path) != nil) && ![path isEqual:_rootPath])
+			{
+				[listingsByPath[path.parentPath] addObject:item];
+			}
+		}
+	}
+
+	@synchronized(self)
+	{
+		_listingsByPath = listingsByPath;
+		_state = (listingsByPath != nil) ? OCCoreItemListPrefetchStateCompleted : OCCoreItemListPrefetchStateDeclined;
+		_completionTime = NSDate.timeIntervalSinceReferenceDate;
+
+		[_waitingHandlersByPath enumerateKeysAndObjectsUsingBlock:^(OCPath path, NSMutableArray<OCCoreItemListPrefetchListingHandler> *handlers, BOOL * _Nonnull stop) {
+			for (OCCoreItemListPrefetchListingHandler handler in handlers)
+			{
+				NSArray<OCItem *> *listing = [self _consumeListingForPath:path];
+
+				[handlerCalls addObject:^{
+					handler(listing);
+				}];
+			}
+		}];
+
+		[_waitingHandlersByPath removeAllObjects];
+	}
+
+	for (dispatch_block_t handlerCall in handlerCalls)
+	{
+		handlerCall();
+	}
+}
+
+@end
@@ -32,6 +32,8 @@
 @interface OCCoreItemListTask ()
 {
 	OCActivityIdentifier _activityIdentifier;
+
+	BOOL _unconditionalRetrieval;
 }
 
 @end
@@ -44,7 +46,10 @@
 	if ((self = [super init]) != nil)
 	{
 		_cachedSet = [OCCoreItemList new];
+		_cachedSet.indexes = OCCoreItemListIndexPath | OCCoreItemListIndexFileID;
+
 		_retrievedSet = [OCCoreItemList new];
+		_retrievedSet.indexes = OCCoreItemListIndexPath | OCCoreItemListIndexFileID;
 	}
 
 	return(self);
@@ -163,21 +168,11 @@
 
 			[self->_core queueConnectivityBlock:^{
 				[self->_core queueRequestJob:^(dispatch_block_t completionHandler) {
-					NSProgress *retrievalProgress;
+					__block NSString *ifNoneMatchETag = nil;
 
 					OCMeasureEventEnd(self, @"core.queue", propFindEvenRef, @"Beginning PROPFIND");
 
-					OCMeasureEventBegin(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Starting PROPFIND for %@", self.path]));
-
-					retrievalProgress = [self->_core.connection retrieveItemListAtPath:self.path depth:1 options:[NSDictionary dictionaryWithObjectsAndKeys:
-						// For background scan jobs, wait with scheduling until there is connectivity
-						((self.updateJob.isForQuery) ? self.core.connection.propFindSignals : self.core.connection.actionSignals), 	OCConnectionOptionRequiredSignalsKey,
-
-						// Schedule in a particular group
-						((self.groupID != nil) ? self.groupID : nil), 									OCConnectionOptionGroupIDKey,
-					nil] completionHandler:^(NSError *error, NSArray<OCItem *> *items) {
-						OCMeasureEventEnd(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Completed PROPFIND for %@", self.path]));
-
+					void (^HandleRetrievedItems)(NSError *error, NSArray<OCItem *> *items) = ^(NSError *error, NSArray<OCItem *> *items) {
 						if (self.core.state != OCCoreStateRunning)
 						{
 							// Skip processing the response if the core is not starting or running
@@ -221,6 +216,32 @@
 								}
 							}
 
+							// Not modified since the contents were last merged
+							if ((ifNoneMatchETag != nil) && IsHTTPErrorWithStatus(error, OCHTTPStatusCodeNOT_MODIFIED))
+							{
+								if ((self->_cachedSet.state == OCCoreItemListStateSuccess) && [self->_cachedSet.itemsByPath[self.path].eTag isEqual:ifNoneMatchETag])
+								{
+									// Use cached items
+									[self->_retrievedSet updateWithError:nil items:self->_cachedSet.items];
+									self->_retrievedSet.notModified = YES;
+
+									self.changeHandler(self->_core, self);
+								}
+								else
+								{
+									// Cache changed in the meantime => retrieve full contents
+									self->_unconditionalRetrieval = YES;
+									[self _updateRetrievedSet];
+								}
+
+								[self->_core endActivity:@"update retrieved set"];
+
+								OCMeasureEventEnd(self, @"itemlist.update-from-propfind", propFindRef, ([NSString stringWithFormat:@"Done updating retrieved set for %@", self.path]));
+
+								completionHandler();
+								return;
+							}
+
 							// Update
 							[self->_retrievedSet updateWithError:error items:items];
 
@@ -290,11 +311,80 @@
 
 							completionHandler();
 						}];
-					}];
+					};
+
+					void (^RetrieveItemsFromServer)(void) = ^{
+						NSProgress *retrievalProgress;
+						NSTimeInterval requestStartTime;
+
+						// Make the request conditional if the cached contents are known to match the folder's current ETag
+						if (!self->_unconditionalRetrieval)
+						{
+							NSString *listingETag;
+
+							if ((listingETag = [self->_core listingETagForPath:self.path]) != nil)
+							{
+								OCItem *cachedFolderItem = [self->_core.vault.database retrieveCacheItemsSyncAtPath:self.path itemOnly:YES error:NULL syncAnchor:NULL].firstObject;
+
+								if ([cachedFolderItem.eTag isEqual:listingETag])
+								{
+									ifNoneMatchETag = listingETag;
+								}
+							}
+						}
+
+						OCMeasureEventBegin(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Starting PROPFIND for %@", self.path]));
+
+						NSMutableDictionary<OCConnectionOptionKey,id> *options = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+							// For background scan jobs, wait with scheduling until there is connectivity
+							((self.updateJob.isForQuery) ? self.core.connection.propFindSignals : self.core.connection.actionSignals), 	OCConnectionOptionRequiredSignalsKey,
+
+							// Listings backing a query are what the user is looking at, background update scans are not
+							@((self.updateJob.isForQuery) ? OCHTTPRequestPriorityClassInteractive : OCHTTPRequestPriorityClassBackground), OCConnectionOptionPriorityClassKey,
+
+							// Schedule in a particular group
+							((self.groupID != nil) ? self.groupID : nil), 									OCConnectionOptionGroupIDKey,
+						nil];
+
+						if (ifNoneMatchETag != nil)
+						{
+							options[OCConnectionOptionIfNoneMatchKey] = ifNoneMatchETag;
+						}
+
+						requestStartTime = NSDate.timeIntervalSinceReferenceDate;
+
+						retrievalProgress = [self->_core.connection retrieveItemListAtPath:self.path depth:1 options:options completionHandler:^(NSError *error, NSArray<OCItem *> *items) {
+							OCMeasureEventEnd(self, @"network.propfind", propFindEvenRef, ([NSString stringWithFormat:@"Completed PROPFIND for %@", self.path]));
+
+							// Feed the outcome into the adaptive concurrency limit for item list tasks (a 304 Not Modified is a regular response, too)
+							[self.core recordItemListRequestCompletionWithError:(IsHTTPErrorWithStatus(error, OCHTTPStatusCodeNOT_MODIFIED) ? nil : error) latency:(NSDate.timeIntervalSinceReferenceDate - requestStartTime)];
+
+							HandleRetrievedItems(error, items);
+						}];
+
+						if (retrievalProgress != nil)
+						{
+							[self.core.activityManager update:[[OCActivityUpdate updatingActivityFor:self] withProgress:retrievalProgress]];
+						}
+					};
 
-					if (retrievalProgress != nil)
+					if (!self.updateJob.isForQuery)
+					{
+						// Background scans may find their listing in the response to a depth infinity PROPFIND that coalesced the scans of sibling folders
+						[self->_core retrievePrefetchedItemListForPath:self.path completionHandler:^(NSArray<OCItem *> *prefetchedItems) {
+							if (prefetchedItems != nil)
+							{
+								HandleRetrievedItems(nil, prefetchedItems);
+							}
+							else
+							{
+								RetrieveItemsFromServer();
+							}
+						}];
+					}
+					else
 					{
-						[self.core.activityManager update:[[OCActivityUpdate updatingActivityFor:self] withProgress:retrievalProgress]];
+						RetrieveItemsFromServer();
 					}
 				}];
 			}];
@@ -62,7 +62,7 @@
 {
 	if (newUpdatedAndRemovedItems != nil)
 	{
-		OCCoreItemList *itemList = [OCCoreItemList itemListWithItems:newUpdatedAndRemovedItems];
+		OCCoreItemList *itemList = [OCCoreItemList itemListWithItems:newUpdatedAndRemovedItems indexes:OCCoreItemListIndexLocalID];
 
 		NSArray<OCItemPolicy *> *policies = [self.policies copy];
 
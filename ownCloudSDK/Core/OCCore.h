@@ -43,7 +43,11 @@
 @class OCCore;
 @class OCItem;
 @class OCCoreItemListTask;
+@class OCCoreItemListPrefetch;
+@class OCHTTPPipelineConcurrencyController;
 @class OCSyncAction;
+@class OCSyncReadyQueue;
+@class OCSyncTransferScheduler;
 @class OCIPNotificationCenter;
 @class OCRecipientSearchController;
 @class OCCoreQuery;
@@ -179,6 +183,7 @@ typedef id<NSObject> OCCoreItemTracking;
 	NSMutableSet<OCIssueSignature> *_rejectedIssueSignatures;
 
 	NSDate *_nextSchedulingDate;
+	dispatch_source_t _waitConditionTimerSource;
 
 	NSTimeInterval _effectivePollForChangesInterval;
 
@@ -189,25 +194,35 @@ typedef id<NSObject> OCCoreItemTracking;
 	OCEventHandlerIdentifier _eventHandlerIdentifier;
 
 	BOOL _needsToProcessSyncRecords;
+	OCSyncReadyQueue *_syncReadyQueue;
+	OCSyncTransferScheduler *_syncTransferScheduler;
 
 	OCSyncAnchor _latestSyncAnchor;
 
 	OCRateLimiter *_syncResetRateLimiter;
 
 	NSMutableDictionary <OCPath, OCCoreItemListTask *> *_itemListTasksByPath;
+	NSMutableDictionary <OCPath, NSString *> *_listingETagsByPath;
 	NSMutableArray <OCCoreDirectoryUpdateJob *> *_queuedItemListTaskUpdateJobs;
+	NSMutableDictionary <OCPath, OCCoreDirectoryUpdateJob *> *_queuedItemListTaskUpdateJobsByPath;
 	NSMutableArray <OCCoreItemListTask *> *_scheduledItemListTasks;
 	NSMutableSet <OCCoreDirectoryUpdateJobID> *_scheduledDirectoryUpdateJobIDs;
 	OCScanJobActivity *_scheduledDirectoryUpdateJobActivity;
 	NSUInteger _totalScheduledDirectoryUpdateJobs;
 	NSUInteger _pendingScheduledDirectoryUpdateJobs;
 	OCAsyncSequentialQueue *_itemListTasksRequestQueue;
+	OCHTTPPipelineConcurrencyController *_itemListTasksConcurrencyController;
+	NSMutableDictionary <OCPath, OCCoreItemListPrefetch *> *_itemListPrefetchesByRootPath;
+	BOOL _itemListPrefetchUnsupported;
 	BOOL _itemListTaskRunning;
 	NSTimeInterval _directoryUpdateStartTime;
 	NSMutableArray<OCCoreItemListFetchUpdatesCompletionHandler> *_fetchUpdatesCompletionHandlers;
 	OCLock *_scanForChangesLock;
 	OCLockRequest *_scanForChangesLockRequest;
 	NSTimeInterval _nextCoordinatedScanRetryTime;
+	OCDAVSyncToken _pendingSyncCollectionToken;
+	OCDAVSyncToken _heldBackSyncCollectionToken;
+	BOOL _syncCollectionUnsupported;
 
 	NSMutableArray <OCItemPolicy *> *_itemPolicies;
 	NSMutableArray <OCItemPolicyProcessor *> *_itemPolicyProcessors;
@@ -441,8 +456,13 @@ extern OCClassSettingsKey OCCoreThumbnailAvailableForMIMETypePrefixes;
 extern OCClassSettingsKey OCCoreOverrideReachabilitySignal;
 extern OCClassSettingsKey OCCoreOverrideAvailabilitySignal;
 extern OCClassSettingsKey OCCoreActionConcurrencyBudgets;
+extern OCClassSettingsKey OCCoreTransferSchedulingPolicy;
+extern OCClassSettingsKey OCCoreTransferSchedulingAgingInterval;
+extern OCClassSettingsKey OCCoreTransferSchedulingLargeTransferThreshold;
+extern OCClassSettingsKey OCCoreTransferSchedulingReservedLargeTransferSlots;
 extern OCClassSettingsKey OCCoreCookieSupportEnabled;
 extern OCClassSettingsKey OCCoreScanForChangesInterval;
+extern OCClassSettingsKey OCCoreSyncCollectionEnabled;
 
 extern OCDatabaseCounterIdentifier OCCoreSyncAnchorCounter;
 extern OCDatabaseCounterIdentifier OCCoreSyncJournalCounter;
@@ -47,6 +47,7 @@
 #import "OCRateLimiter.h"
 #import "OCSyncActionDownload.h"
 #import "OCSyncActionUpload.h"
+#import "OCSyncTransferScheduler.h"
 #import "OCBookmark+IPNotificationNames.h"
 #import "OCDeallocAction.h"
 #import "OCCore+ItemPolicies.h"
@@ -149,7 +150,12 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 						OCSyncActionCategoryDownloadWifiOnly   	    : @(2), // Limit number of concurrent downloads by WiFi-only transfers to 2 (leaving at least one spot empty for cellular)
 						OCSyncActionCategoryDownloadWifiAndCellular : @(3) // Limit number of concurrent downloads by WiFi and Cellular transfers to 3
 		},
-		OCCoreCookieSupportEnabled : @(YES)
+		OCCoreTransferSchedulingPolicy : OCSyncTransferSchedulingPolicyShortestFirst, // Let small transfers start before large ones
+		OCCoreTransferSchedulingAgingInterval : @(300), // Halve the effective size of waiting transfers every 5 minutes
+		OCCoreTransferSchedulingLargeTransferThreshold : @(100 * 1024 * 1024), // Consider transfers of 100 MB and more large
+		OCCoreTransferSchedulingReservedLargeTransferSlots : @(1), // Start large transfers first while none is running
+		OCCoreCookieSupportEnabled : @(YES),
+		OCCoreSyncCollectionEnabled : @(NO)
 	});
 }
 
@@ -191,6 +197,38 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 			OCClassSettingsMetadataKeyCategory	: @"Connection"
 		},
 
+		OCCoreTransferSchedulingPolicy : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeString,
+			OCClassSettingsMetadataKeyDescription 	: @"Order in which transfers that are ready to start get to use the transfer concurrency budgets.",
+			OCClassSettingsMetadataKeyPossibleValues : @{
+				OCSyncTransferSchedulingPolicyLaneOrder		: @"Start transfers in the order they were scheduled.",
+				OCSyncTransferSchedulingPolicyShortestFirst	: @"Start the smallest transfers first, taking into account how long transfers have been waiting."
+			},
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCCoreTransferSchedulingAgingInterval : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Number of seconds after which the size of a waiting transfer is considered to be half its size when ordering transfers by size. A value of 0 turns off aging.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCCoreTransferSchedulingLargeTransferThreshold : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Size in bytes from which on a transfer is considered large. Large transfers are also part of the `transfer-large` action category.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
+		OCCoreTransferSchedulingReservedLargeTransferSlots : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Number of large transfers that start before smaller transfers while fewer large transfers are running, so that large transfers keep progressing.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection"
+		},
+
 		OCCoreScanForChangesInterval : @{
 			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
 			OCClassSettingsMetadataKeyDescription 	: @"Minimum number of milliseconds until the next scan for changes, measured from the completion of the previous scan. If no value is provided, uses the poll interval provided in the server's capabilities (in milliseconds) if it is greater or equal 5 seconds. Defaults to 10 seconds otherwise.",
@@ -198,6 +236,13 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 			OCClassSettingsMetadataKeyCategory	: @"Connection",
 		},
 
+		OCCoreSyncCollectionEnabled : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeBoolean,
+			OCClassSettingsMetadataKeyDescription 	: @"Use sync-collection REPORT (RFC 6578) to retrieve changes since the last scan where supported by the server, instead of walking all folders with a changed ETag. Off by default.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection",
+		},
+
 		// Privacy
 		OCCoreAddAcceptLanguageHeader : @{
 			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeBoolean,
@@ -253,9 +298,12 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 		_shareQueries = [NSMutableArray new];
 
 		_itemListTasksByPath = [NSMutableDictionary new];
+		_listingETagsByPath = [NSMutableDictionary new];
 		_queuedItemListTaskUpdateJobs = [NSMutableArray new];
+		_queuedItemListTaskUpdateJobsByPath = [NSMutableDictionary new];
 		_scheduledItemListTasks = [NSMutableArray new];
 		_scheduledDirectoryUpdateJobIDs = [NSMutableSet new];
+		_itemListPrefetchesByRootPath = [NSMutableDictionary new];
 		_itemListTasksRequestQueue = [OCAsyncSequentialQueue new];
 		_itemListTasksRequestQueue.executor = ^(OCAsyncSequentialQueueJob  _Nonnull job, dispatch_block_t  _Nonnull completionHandler) {
 			OCCore *strongSelf;
@@ -1101,7 +1149,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 
 		if ((addedOrUpdatedItems.count > 0) || (removedItems.count > 0))
 		{
-			OCCoreItemList *addedOrUpdatedItemsList = [OCCoreItemList itemListWithItems:addedOrUpdatedItems];
+			OCCoreItemList *addedOrUpdatedItemsList = [OCCoreItemList itemListWithItems:addedOrUpdatedItems indexes:OCCoreItemListIndexFileID];
 
 			[self performUpdatesForAddedItems:nil
 			   	removedItems:removedItems
@@ -1121,7 +1169,7 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCCore)
 					{
 						OCCoreItemList *queryItemList;
 
-						if ((queryItemList = [OCCoreItemList itemListWithItems:query.fullQueryResults]) != nil)
+						if ((queryItemList = [OCCoreItemList itemListWithItems:query.fullQueryResults indexes:OCCoreItemListIndexFileID]) != nil)
 						{
 							NSMutableSet <OCFileID> *sharedFileIDs = [[NSMutableSet alloc] initWithSet:addedOrUpdatedItemsList.itemFileIDsSet];
 							[sharedFileIDs intersectSet:queryItemList.itemFileIDsSet];
@@ -2182,8 +2230,13 @@ OCClassSettingsKey OCCoreThumbnailAvailableForMIMETypePrefixes = @"thumbnail-ava
 OCClassSettingsKey OCCoreOverrideReachabilitySignal = @"override-reachability-signal";
 OCClassSettingsKey OCCoreOverrideAvailabilitySignal = @"override-availability-signal";
 OCClassSettingsKey OCCoreActionConcurrencyBudgets = @"action-concurrency-budgets";
+OCClassSettingsKey OCCoreTransferSchedulingPolicy = @"transfer-scheduling-policy";
+OCClassSettingsKey OCCoreTransferSchedulingAgingInterval = @"transfer-scheduling-aging-interval";
+OCClassSettingsKey OCCoreTransferSchedulingLargeTransferThreshold = @"transfer-scheduling-large-transfer-threshold";
+OCClassSettingsKey OCCoreTransferSchedulingReservedLargeTransferSlots = @"transfer-scheduling-reserved-large-transfer-slots";
 OCClassSettingsKey OCCoreCookieSupportEnabled = @"cookie-support-enabled";
 OCClassSettingsKey OCCoreScanForChangesInterval = @"scan-for-changes-interval";
+OCClassSettingsKey OCCoreSyncCollectionEnabled = @"sync-collection-enabled";
 
 OCDatabaseCounterIdentifier OCCoreSyncAnchorCounter = @"syncAnchor";
 OCDatabaseCounterIdentifier OCCoreSyncJournalCounter = @"syncJournal";
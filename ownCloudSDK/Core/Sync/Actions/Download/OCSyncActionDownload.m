@@ -337,6 +337,16 @@ OCSYNCACTION_REGISTER_ISSUETEMPLATES
 
 			mutableOptions[OCConnectionOptionRequiredCellularSwitchKey] = cellularSwitchID;
 
+			// Determine priority class
+			if ([options[OCCoreOptionDownloadTriggerID] isEqual:OCItemDownloadTriggerIDUser])
+			{
+				mutableOptions[OCConnectionOptionPriorityClassKey] = @(OCHTTPRequestPriorityClassUserInitiated);
+			}
+			else if ([options[OCCoreOptionDownloadTriggerID] isEqual:OCItemDownloadTriggerIDAvailableOffline])
+			{
+				mutableOptions[OCConnectionOptionPriorityClassKey] = @(OCHTTPRequestPriorityClassBackground);
+			}
+
 			options = mutableOptions;
 		}
 
@@ -49,7 +49,9 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)performProtectedSyncBlock:(NSError * _Nullable (^)(void))protectedBlock completionHandler:(void(^ _Nullable)(NSError * _Nullable))completionHandler;
 
 #pragma mark - Sync Record Scheduling
-- (void)setNeedsToProcessSyncRecords;
+- (void)setNeedsToProcessSyncRecords; //!< Processes all sync lanes. Use for changes that may not be covered by the targeted triggers below (f.ex. changes made by other processes).
+- (void)setNeedsToProcessSyncRecordsOnLaneID:(nullable OCSyncLaneID)laneID; //!< Processes the sync lane with the provided ID (and other lanes that became ready in the meantime). Falls back to -setNeedsToProcessSyncRecords if laneID is nil.
+- (void)setNeedsToProcessSyncRecordWithID:(OCSyncRecordID)recordID; //!< Processes the sync lane of the sync record with the provided ID (and other lanes that became ready in the meantime).
 
 - (void)submitSyncRecord:(OCSyncRecord *)record withPreflightResultHandler:(nullable OCCoreCompletionHandler)preflightResultHandler;
 - (void)rescheduleSyncRecord:(OCSyncRecord *)syncRecord withUpdates:(NSError * _Nullable (^ _Nullable)(OCSyncRecord *record))applyUpdates;
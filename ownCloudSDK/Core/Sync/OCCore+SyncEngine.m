@@ -39,6 +39,8 @@
 #import "OCEventQueue.h"
 #import "OCSQLiteTransaction.h"
 #import "OCBackgroundManager.h"
+#import "OCSyncReadyQueue.h"
+#import "OCSyncTransferScheduler.h"
 
 OCIPCNotificationName OCIPCNotificationNameProcessSyncRecordsBase = @"org.owncloud.process-sync-records";
 OCIPCNotificationName OCIPCNotificationNameUpdateSyncRecordsBase = @"org.owncloud.update-sync-records";
@@ -74,6 +76,14 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 	_syncResetRateLimiter = [[OCRateLimiter alloc] initWithMinimumTime:2.0];
 
+	_syncReadyQueue = [OCSyncReadyQueue new];
+
+	_syncTransferScheduler = [OCSyncTransferScheduler new];
+	_syncTransferScheduler.policy = [self classSettingForOCClassSettingsKey:OCCoreTransferSchedulingPolicy];
+	_syncTransferScheduler.agingInterval = [[self classSettingForOCClassSettingsKey:OCCoreTransferSchedulingAgingInterval] doubleValue];
+	_syncTransferScheduler.largeTransferThreshold = [[self classSettingForOCClassSettingsKey:OCCoreTransferSchedulingLargeTransferThreshold] unsignedLongLongValue];
+	_syncTransferScheduler.reservedLargeTransferSlots = [[self classSettingForOCClassSettingsKey:OCCoreTransferSchedulingReservedLargeTransferSlots] unsignedIntegerValue];
+
 	[self renewActiveProcessCoreRegistration];
 
 	[OCIPNotificationCenter.sharedNotificationCenter addObserver:self forName:processRecordsNotificationName withHandler:^(OCIPNotificationCenter * _Nonnull notificationCenter, OCCore * _Nonnull core, OCIPCNotificationName  _Nonnull notificationName) {
@@ -116,6 +126,13 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 	}
 
 	[_remoteSyncEngineTriggerAcknowledgements removeAllObjects];
+
+	if (_waitConditionTimerSource != NULL)
+	{
+		dispatch_source_cancel(_waitConditionTimerSource);
+		_waitConditionTimerSource = NULL;
+		_nextSchedulingDate = nil;
+	}
 }
 
 #pragma mark - Sync Anchor
@@ -260,9 +277,10 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 	lane = [self.database laneForTags:tags updatedLanes:&updatedLanes readOnly:readOnly];
 
-	if (updatedLanes)
+	if (updatedLanes && (lane != nil))
 	{
-		[self setNeedsToProcessSyncRecords];
+		[_syncReadyQueue addLane:lane];
+		[self setNeedsToProcessSyncRecordsOnLaneID:lane.identifier];
 	}
 
 	return (lane);
@@ -287,6 +305,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 		{
 			__weak OCCore *weakSelf = self;
 			__weak OCProgress *weakSyncProgress;
+			__weak OCSyncRecord *weakSyncRecord = syncRecord;
 			OCProgress *syncProgress;
 
 			progress = [NSProgress indeterminateProgress];
@@ -296,7 +315,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 			progress.cancellationHandler = ^{
 				[weakSyncProgress cancel];
-				[weakSelf setNeedsToProcessSyncRecords];
+				[weakSelf setNeedsToProcessSyncRecordsOnLaneID:weakSyncRecord.laneID];
 			};
 
 			syncRecord.progress = syncProgress;
@@ -444,7 +463,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 			});
 		}
 
-		[self setNeedsToProcessSyncRecords];
+		[self setNeedsToProcessSyncRecordsOnLaneID:record.laneID];
 	}];
 }
 
@@ -467,7 +486,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 			error = updateError;
 		}];
 
-		[self setNeedsToProcessSyncRecords];
+		[self setNeedsToProcessSyncRecordsOnLaneID:syncRecord.laneID];
 	}
 
 	return (error);
@@ -538,7 +557,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 	[syncRecord completeWithError:completionError core:self item:syncRecord.action.localItem parameter:parameter];
 
-	[self setNeedsToProcessSyncRecords];
+	[self setNeedsToProcessSyncRecordsOnLaneID:syncRecord.laneID];
 
 	return (error);
 }
@@ -562,6 +581,37 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 {
 	OCLogDebug(@"setNeedsToProcessSyncRecords");
 
+	[_syncReadyQueue setNeedsFullScan];
+
+	[self _setNeedsToProcessReadySyncLanes];
+}
+
+- (void)setNeedsToProcessSyncRecordsOnLaneID:(OCSyncLaneID)laneID
+{
+	if (laneID == nil)
+	{
+		[self setNeedsToProcessSyncRecords];
+		return;
+	}
+
+	OCLogDebug(@"setNeedsToProcessSyncRecordsOnLaneID:%@", laneID);
+
+	[_syncReadyQueue markLaneIDReady:laneID];
+
+	[self _setNeedsToProcessReadySyncLanes];
+}
+
+- (void)setNeedsToProcessSyncRecordWithID:(OCSyncRecordID)recordID
+{
+	OCLogDebug(@"setNeedsToProcessSyncRecordWithID:%@", recordID);
+
+	[_syncReadyQueue markRecordIDReady:recordID];
+
+	[self _setNeedsToProcessReadySyncLanes];
+}
+
+- (void)_setNeedsToProcessReadySyncLanes
+{
 	@synchronized(self)
 	{
 		_needsToProcessSyncRecords = YES;
@@ -634,6 +684,12 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 		for (OCEventRecord *eventRecord in eventQueue.records)
 		{
+			// The lane of the sync record targeted by the event needs to be processed
+			if (eventRecord.syncRecordID != nil)
+			{
+				[self->_syncReadyQueue markRecordIDReady:eventRecord.syncRecordID];
+			}
+
 			// Avoid double-transfer
 			if (![self.database queueContainsEvent:eventRecord.event])
 			{
@@ -669,23 +725,17 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 	[self dumpSyncJournalWithTags:@[@"BeforeProc"]];
 
 	[self performProtectedSyncBlock:^NSError *{
-		__block NSArray <OCSyncLane *> *lanes = nil;
-		NSMutableSet<OCSyncLaneID> *activeLaneIDs = [NSMutableSet new];
-		NSUInteger activeLanes = 0;
+		OCSyncReadyQueue *readyQueue = self->_syncReadyQueue;
+		NSMutableArray <OCSyncLane *> *lanes = [NSMutableArray new];
+		NSUInteger maximumSyncLanes = self.maximumSyncLanes;
 		NSDictionary<OCSyncActionCategory, NSNumber *> *actionBudgetsByCategory = [self classSettingForOCClassSettingsKey:OCCoreActionConcurrencyBudgets];
-		NSMutableDictionary<OCSyncActionCategory, NSNumber *> *runningActionsByCategory = [NSMutableDictionary new];
-		void (^UpdateRunningActionCategories)(NSArray <OCSyncActionCategory> *categories, NSInteger change) = ^(NSArray <OCSyncActionCategory> *categories, NSInteger change) {
-			for (OCSyncActionCategory category in categories)
-			{
-				runningActionsByCategory[category] = @(runningActionsByCategory[category].integerValue + change);
-			}
-		};
+		OCSyncTransferScheduler *transferScheduler = self->_syncTransferScheduler;
 		BOOL (^ShouldRunInActionCategories)(NSArray <OCSyncActionCategory> *categories) = ^(NSArray <OCSyncActionCategory> *categories){
 			for (OCSyncActionCategory category in categories)
 			{
 				NSUInteger totalBudget = actionBudgetsByCategory[category].integerValue;
 
-				if ((totalBudget > 0) && (runningActionsByCategory[category].integerValue >= totalBudget))
+				if ((totalBudget > 0) && ([readyQueue numberOfRunningActionsInCategory:category] >= totalBudget))
 				{
 					OCLogDebug(@"Budget limit of %lu reached for action category: %@", totalBudget, category);
 					return (NO);
@@ -695,208 +745,321 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 			return (YES);
 		};
 
-		[self.database retrieveSyncLanesWithCompletionHandler:^(OCDatabase *db, NSError *error, NSArray<OCSyncLane *> *syncLanes) {
-			if (error != nil)
-			{
-				OCLogError(@"Error retrieving sync lanes: %@", error);
-			}
-			else
-			{
-				lanes = syncLanes;
-			}
-		}];
-
-		for (OCSyncLane *lane in lanes)
+		if (readyQueue.needsFullScan)
 		{
-			[activeLaneIDs addObject:lane.identifier];
+			// Full scan: process all lanes and rebuild the ready queue
+			[self.database retrieveSyncLanesWithCompletionHandler:^(OCDatabase *db, NSError *error, NSArray<OCSyncLane *> *syncLanes) {
+				if (error != nil)
+				{
+					OCLogError(@"Error retrieving sync lanes: %@", error);
+				}
+				else
+				{
+					[readyQueue resetWithLanes:syncLanes];
+					[lanes addObjectsFromArray:syncLanes];
+				}
+			}];
 		}
-
-		for (OCSyncLane *lane in lanes)
+		else
 		{
-			__block BOOL stopProcessing = NO;
-			__block OCSyncRecordID lastSyncRecordID = nil;
-			__block NSUInteger recordsOnLane = 0;
-			__block NSError *error = nil;
+			// Targeted run: only process lanes that became ready since the last run
+			NSMutableSet<OCSyncLaneID> *readyLaneIDs;
+			BOOL hasUnknownLanes = NO;
+
+			// Determine lanes of records that were triggered before their lane was known
+			for (OCSyncRecordID recordID in [readyQueue dequeueUnresolvedRecordIDs])
+			{
+				[self.database retrieveSyncRecordForID:recordID completionHandler:^(OCDatabase *db, NSError *error, OCSyncRecord *syncRecord) {
+					if (syncRecord.laneID != nil)
+					{
+						[readyQueue setLaneID:syncRecord.laneID forRecordID:recordID];
+						[readyQueue markLaneIDReady:syncRecord.laneID];
+					}
+				}];
+			}
 
-			OCLogDebug(@"processing sync records on lane %@", lane);
+			readyLaneIDs = [NSMutableSet setWithArray:[readyQueue dequeueReadyLaneIDs]];
 
-			if (lane.afterLanes.count > 0)
+			for (OCSyncLaneID laneID in readyLaneIDs)
 			{
-				// Check if all preceding lanes this lane depends on have finished
-				if ([activeLaneIDs intersectsSet:lane.afterLanes])
+				if ([readyQueue laneForID:laneID] == nil)
 				{
-					// Preceding lanes still active => skip
-					if ([OCLogger logsForLevel:OCLogLevelDebug])
-					{
-						NSMutableSet *blockingLaneIDs = [NSMutableSet setWithSet:activeLaneIDs];
-						[blockingLaneIDs intersectSet:lane.afterLanes];
+					hasUnknownLanes = YES;
+					break;
+				}
+			}
 
-						OCLogDebug(@"skipping lane %@ because lanes it is waiting for are still active: %@", lane, blockingLaneIDs);
+			if (hasUnknownLanes)
+			{
+				// Lanes were added outside of -laneForTags:readOnly: (f.ex. by another process) => refresh lanes
+				[self.database retrieveSyncLanesWithCompletionHandler:^(OCDatabase *db, NSError *error, NSArray<OCSyncLane *> *syncLanes) {
+					if (error != nil)
+					{
+						OCLogError(@"Error retrieving sync lanes: %@", error);
 					}
+					else
+					{
+						[readyQueue updateLanes:syncLanes];
+					}
+				}];
 
-					continue;
+				[readyLaneIDs addObjectsFromArray:[readyQueue dequeueReadyLaneIDs]];
+			}
+
+			for (OCSyncLaneID laneID in [readyLaneIDs.allObjects sortedArrayUsingSelector:@selector(compare:)])
+			{
+				OCSyncLane *lane;
+
+				if ((lane = [readyQueue laneForID:laneID]) != nil)
+				{
+					[lanes addObject:lane];
 				}
 			}
 
-			while (!stopProcessing)
+			OCLogDebug(@"processing %lu of %lu sync lanes", lanes.count, readyQueue.numberOfLanes);
+		}
+
+		// Process lanes. If the transfer scheduling policy requires it, transfers that are ready to start are collected in a first pass
+		// and their lanes processed again in the order determined by the policy in a second pass
+		NSArray<OCSyncLane *> *lanesToProcess = lanes;
+		NSMutableArray<OCSyncTransferCandidate *> *transferCandidates = [NSMutableArray new];
+		BOOL deferTransfers = transferScheduler.defersTransfers;
+
+		while (lanesToProcess.count > 0)
+		{
+			for (OCSyncLane *lane in lanesToProcess)
 			{
-				// Fetch next sync record
-				[self.database retrieveSyncRecordAfterID:lastSyncRecordID onLaneID:lane.identifier completionHandler:^(OCDatabase *db, NSError *dbError, OCSyncRecord *syncRecord) {
-					OCCoreSyncInstruction nextInstruction;
+				__block BOOL stopProcessing = NO;
+				__block OCSyncRecordID lastSyncRecordID = nil;
+				__block NSUInteger recordsOnLane = 0;
+				__block NSError *error = nil;
 
-					if (syncRecord == nil)
-					{
-						// There's no next sync record => we're done
-						stopProcessing = YES;
-						return;
-					}
+				OCSyncLaneID laneID = lane.identifier;
 
-					if (dbError != nil)
+				OCLogDebug(@"processing sync records on lane %@", lane);
+
+				if (lane.afterLanes.count > 0)
+				{
+					// Check if all preceding lanes this lane depends on have finished
+					if ([readyQueue isLaneWaitingForPredecessors:lane])
 					{
-						error = dbError;
-						stopProcessing = YES;
-						return;
+						// Preceding lanes still active => skip (lane becomes ready again when they are removed)
+						OCLogDebug(@"skipping lane %@ because lanes it is waiting for are still active: %@", lane, lane.afterLanes);
+
+						continue;
 					}
+				}
 
-					recordsOnLane++;
+				// Enforce active lane limit
+				if (![readyQueue canProcessLaneID:laneID maximumActiveLanes:maximumSyncLanes])
+				{
+					OCLogDebug(@"skipping lane %@ because the maximum number of active lanes (%lu) has been reached", lane, maximumSyncLanes);
 
-					// Check available action category budget
-					NSArray <OCSyncActionCategory> *actionCategories = syncRecord.action.categories;
+					continue;
+				}
 
-					if (syncRecord.state == OCSyncRecordStateReady)
-					{
-						if (!ShouldRunInActionCategories(actionCategories))
+				[readyQueue beginProcessingLaneID:laneID];
+
+				while (!stopProcessing)
+				{
+					// Fetch next sync record
+					[self.database retrieveSyncRecordAfterID:lastSyncRecordID onLaneID:lane.identifier completionHandler:^(OCDatabase *db, NSError *dbError, OCSyncRecord *syncRecord) {
+						OCCoreSyncInstruction nextInstruction;
+
+						if (syncRecord == nil)
 						{
-							OCLogDebug(@"Skipping processing sync record %@ due to lack of available budget in %@", syncRecord.recordID, actionCategories);
+							// There's no next sync record => we're done
 							stopProcessing = YES;
 							return;
 						}
-					}
 
-					// Update budget usage
-					UpdateRunningActionCategories(actionCategories, 1);
+						if (dbError != nil)
+						{
+							error = dbError;
+							stopProcessing = YES;
+							return;
+						}
 
-					// Process sync record
-					nextInstruction = [self processSyncRecord:syncRecord error:&error];
+						recordsOnLane++;
 
-					OCLogDebug(@"Processing of sync record finished with nextInstruction=%lu", nextInstruction);
+						[readyQueue setLaneID:laneID forRecordID:syncRecord.recordID];
 
-					[self dumpSyncJournalWithTags:@[@"PostProc"]];
+						// Check available action category budget
+						NSArray <OCSyncActionCategory> *actionCategories = syncRecord.action.categories;
+						BOOL isTransfer = [actionCategories containsObject:OCSyncActionCategoryTransfer];
+						unsigned long long transferSize = isTransfer ? (unsigned long long)MAX(syncRecord.action.localItem.size, 0) : 0;
 
-					// Perform sync record result instruction
-					switch (nextInstruction)
-					{
-						case OCCoreSyncInstructionNone:
-							// Invalid instruction here
-							OCLogError(@"Invalid instruction \"none\" after processing syncRecord=%@", syncRecord);
+						if (isTransfer && [transferScheduler isLargeTransferSize:transferSize])
+						{
+							actionCategories = [actionCategories arrayByAddingObject:OCSyncActionCategoryTransferLarge];
+						}
 
-							stopProcessing = YES;
-							return;
-						break;
+						if (syncRecord.state == OCSyncRecordStateReady)
+						{
+							if (isTransfer && deferTransfers)
+							{
+								// Collect transfer - and process it in the order determined by the transfer scheduler
+								OCLogDebug(@"Deferring sync record %@ (transfer of %llu bytes) for transfer scheduling", syncRecord.recordID, transferSize);
+								[transferCandidates addObject:[transferScheduler candidateForLaneID:laneID recordID:syncRecord.recordID size:transferSize date:[NSDate new]]];
+								stopProcessing = YES;
+								return;
+							}
 
-						case OCCoreSyncInstructionStop:
-							// Stop processing
-							stopProcessing = YES;
-							return;
-						break;
+							if (!ShouldRunInActionCategories(actionCategories))
+							{
+								OCLogDebug(@"Skipping processing sync record %@ due to lack of available budget in %@", syncRecord.recordID, actionCategories);
+								[readyQueue markLaneIDBudgetBlocked:laneID];
+								stopProcessing = YES;
+								return;
+							}
 
-						case OCCoreSyncInstructionStopAndSideline:
-							// Stop processing
-							stopProcessing = YES;
+							if (isTransfer)
+							{
+								[transferScheduler removeRecordID:syncRecord.recordID];
+							}
+						}
 
-							// Update budget usage to allow execution of actions on other lanes in the meantime
-							UpdateRunningActionCategories(actionCategories, -1);
+						// Update budget usage
+						[readyQueue updateBudgetUsageOfLaneID:laneID categories:actionCategories change:1];
 
-							return;
-						break;
+						// Process sync record
+						nextInstruction = [self processSyncRecord:syncRecord error:&error];
 
-						case OCCoreSyncInstructionRepeatLast:
-							// Repeat processing of record
-							return;
-						break;
+						OCLogDebug(@"Processing of sync record finished with nextInstruction=%lu", nextInstruction);
+
+						[self dumpSyncJournalWithTags:@[@"PostProc"]];
 
-						case OCCoreSyncInstructionDeleteLast:
-							// Delete record
-							[self removeSyncRecords:@[ syncRecord ] completionHandler:^(OCDatabase *db, NSError *dbError) {
-								if (dbError != nil)
+						// Perform sync record result instruction
+						switch (nextInstruction)
+						{
+							case OCCoreSyncInstructionNone:
+								// Invalid instruction here
+								OCLogError(@"Invalid instruction \"none\" after processing syncRecord=%@", syncRecord);
+
+								stopProcessing = YES;
+								return;
+							break;
+
+							case OCCoreSyncInstructionStop:
+								// Stop processing
+								stopProcessing = YES;
+								return;
+							break;
+
+							case OCCoreSyncInstructionStopAndSideline:
+								// Stop processing
+								stopProcessing = YES;
+
+								// Update budget usage to allow execution of actions on other lanes in the meantime
+								[readyQueue updateBudgetUsageOfLaneID:laneID categories:actionCategories change:-1];
+
+								return;
+							break;
+
+							case OCCoreSyncInstructionRepeatLast:
+								// Repeat processing of record
+								return;
+							break;
+
+							case OCCoreSyncInstructionDeleteLast:
+								// Delete record
+								[self removeSyncRecords:@[ syncRecord ] completionHandler:^(OCDatabase *db, NSError *dbError) {
+									if (dbError != nil)
+									{
+										error = dbError;
+										stopProcessing = YES;
+									}
+								}];
+
+								if (error == nil)
 								{
-									error = dbError;
-									stopProcessing = YES;
+									recordsOnLane--;
 								}
-							}];
 
-							if (error == nil)
-							{
-								recordsOnLane--;
-							}
+								// Update budget usage
+								[readyQueue updateBudgetUsageOfLaneID:laneID categories:actionCategories change:-1];
 
-							// Update budget usage
-							UpdateRunningActionCategories(actionCategories, -1);
+								// Process next
+								lastSyncRecordID = syncRecord.recordID;
+							break;
 
-							// Process next
-							lastSyncRecordID = syncRecord.recordID;
-						break;
+							case OCCoreSyncInstructionProcessNext:
+								// Process next
+								lastSyncRecordID = syncRecord.recordID;
+							break;
+						}
 
-						case OCCoreSyncInstructionProcessNext:
-							// Process next
-							lastSyncRecordID = syncRecord.recordID;
-						break;
-					}
+						// Log error
+						if (error != nil)
+						{
+							OCLogError(@"Error processing sync records: %@", error);
+						}
+					}];
+				};
 
-					// Log error
-					if (error != nil)
-					{
-						OCLogError(@"Error processing sync records: %@", error);
-					}
-				}];
-			};
+				OCLogDebug(@"done processing sync records on lane %@", lane);
 
-			OCLogDebug(@"done processing sync records on lane %@", lane);
+				[readyQueue endProcessingLaneID:laneID active:((recordsOnLane > 0) || (error != nil))];
 
-			if ((recordsOnLane > 0) || (error != nil))
-			{
-				activeLanes++;
+				if (error != nil)
+				{
+					// Make sure not to proceed to removing seemingly empty lane on errors
+					continue;
+				}
 
-				if ((activeLanes > self.maximumSyncLanes) && (self.maximumSyncLanes != 0))
+				if (recordsOnLane == 0)
 				{
-					// Enforce active lane limit
-					break;
+					__block BOOL laneIsEmpty = NO;
+
+					// Double-verify there are no records left on lane
+					[self.database numberOfSyncRecordsOnSyncLaneID:lane.identifier completionHandler:^(OCDatabase *db, NSError *error, NSNumber *count) {
+						laneIsEmpty = ((count.integerValue == 0) && (error == nil));
+					}];
+
+					// Remove lane if empty
+					if (laneIsEmpty)
+					{
+						OCLogDebug(@"Removing empty lane %@", lane);
+
+						[self.database removeSyncLane:lane completionHandler:^(OCDatabase *db, NSError *error) {
+							if (error != nil)
+							{
+								OCLogError(@"Error removing lane %@: %@", lane, error);
+							}
+						}];
+
+						// Lanes waiting for this lane become ready
+						[readyQueue removeLaneID:laneID];
+					}
 				}
 			}
 
-			if (error != nil)
-			{
-				// Make sure not to proceed to removing seemingly empty lane on errors
-				continue;
-			}
+			// Order collected transfers and process their lanes in that order
+			lanesToProcess = nil;
 
-			if (recordsOnLane == 0)
+			if (deferTransfers && (transferCandidates.count > 0))
 			{
-				__block BOOL laneIsEmpty = NO;
-
-				// Double-verify there are no records left on lane
-				[self.database numberOfSyncRecordsOnSyncLaneID:lane.identifier completionHandler:^(OCDatabase *db, NSError *error, NSNumber *count) {
-					laneIsEmpty = ((count.integerValue == 0) && (error == nil));
-				}];
+				NSMutableArray<OCSyncLane *> *orderedLanes = [NSMutableArray new];
 
-				// Remove lane if empty
-				if (laneIsEmpty)
+				for (OCSyncTransferCandidate *candidate in [transferScheduler orderCandidates:transferCandidates runningLargeTransfers:[readyQueue numberOfRunningActionsInCategory:OCSyncActionCategoryTransferLarge] date:[NSDate new]])
 				{
-					OCLogDebug(@"Removing empty lane %@", lane);
+					OCSyncLane *lane;
 
-					[activeLaneIDs removeObject:lane.identifier];
-
-					[self.database removeSyncLane:lane completionHandler:^(OCDatabase *db, NSError *error) {
-						if (error != nil)
-						{
-							OCLogError(@"Error removing lane %@: %@", lane, error);
-						}
-					}];
+					if ((lane = [readyQueue laneForID:candidate.laneID]) != nil)
+					{
+						[orderedLanes addObject:lane];
+					}
 				}
+
+				OCLogDebug(@"processing %lu lanes with transfers in scheduling order", orderedLanes.count);
+
+				lanesToProcess = orderedLanes;
 			}
+
+			deferTransfers = NO;
 		}
 
-		if (activeLaneIDs.count == 0)
+		if ((readyQueue.numberOfLanes == 0) && !readyQueue.needsFullScan)
 		{
 			__weak OCCore *weakSelf = self;
 
@@ -926,6 +1089,12 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 	OCWaitForCompletion(processSyncRecords);
 
 	[self dumpSyncJournalWithTags:@[@"AfterProc"]];
+
+	// Process lanes that became ready during processing (f.ex. because a lane they were waiting for was removed)
+	if (_syncReadyQueue.hasReadyLanes)
+	{
+		[self _setNeedsToProcessReadySyncLanes];
+	}
 }
 
 - (BOOL)processWaitConditionsOfSyncRecord:(OCSyncRecord *)syncRecord error:(NSError **)outError
@@ -1238,7 +1407,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 				if (syncRecord.waitConditions.count > 0) // Sync Record contains wait conditions
 				{
 					// Make sure updates are saved and wait conditions are then processed at least once
-					[self setNeedsToProcessSyncRecords];
+					[self setNeedsToProcessSyncRecordsOnLaneID:syncRecord.laneID];
 				}
 
 				OCLogDebug(@"record %@ scheduled with scheduleInstruction=%lu, error=%@", OCLogPrivate(syncRecord), scheduleInstruction, OCLogPrivate(scheduleError));
@@ -1411,7 +1580,14 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 				}];
 
 				// Make sure sync engine will enter processing
-				[self setNeedsToProcessSyncRecords];
+				if (syncRecordID != nil)
+				{
+					[self setNeedsToProcessSyncRecordWithID:syncRecordID];
+				}
+				else
+				{
+					[self setNeedsToProcessSyncRecords];
+				}
 			}
 		}
 
@@ -1449,43 +1625,82 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 - (void)_scheduleNextWaitConditionRunForRecord:(OCSyncRecord *)syncRecord
 {
-	if (syncRecord.waitConditions.count > 0)
+	if ((syncRecord.waitConditions.count > 0) && (syncRecord.recordID != nil))
 	{
+		NSDate *nextDeadline = nil;
+
 		// Find next retry date (if any) of existing and new wait conditions for this sync record
 		for (OCWaitCondition *waitCondition in syncRecord.waitConditions)
 		{
 			NSDate *nextRetryDate;
 
-			if ((nextRetryDate = waitCondition.nextRetryDate) != nil)
+			if (((nextRetryDate = waitCondition.nextRetryDate) != nil) && (nextRetryDate.timeIntervalSinceNow > 0))
 			{
-				NSTimeInterval retryInterval = nextRetryDate.timeIntervalSinceNow;
+				if ((nextDeadline == nil) || ([nextRetryDate compare:nextDeadline] == NSOrderedAscending))
+				{
+					nextDeadline = nextRetryDate;
+				}
+			}
+		}
 
-				// NSLog(@"Retry:next(se)=%@;interval=%f;nextScheduled=%@", nextRetryDate,retryInterval,_nextSchedulingDate);
+		if (nextDeadline != nil)
+		{
+			[_syncReadyQueue setLaneID:syncRecord.laneID forRecordID:syncRecord.recordID];
+			[_syncReadyQueue setWaitConditionDeadline:nextDeadline forRecordID:syncRecord.recordID];
 
-				if (retryInterval > 0)
-				{
-					if ((_nextSchedulingDate == nil) || (_nextSchedulingDate.timeIntervalSinceNow < 0) || ((_nextSchedulingDate != nil) && (_nextSchedulingDate.timeIntervalSinceReferenceDate > nextRetryDate.timeIntervalSinceReferenceDate)))
-					{
-						__weak OCCore *weakSelf = self;
+			[self _rescheduleWaitConditionTimer];
+		}
+	}
+}
 
-						_nextSchedulingDate = nextRetryDate;
+- (void)_rescheduleWaitConditionTimer
+{
+	NSDate *nextDeadline = _syncReadyQueue.nextWaitConditionDeadline;
 
-						dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(retryInterval * NSEC_PER_SEC)), _queue, ^{
-							OCCore *strongCore = weakSelf;
+	if ((nextDeadline == nil) || [nextDeadline isEqual:_nextSchedulingDate])
+	{
+		// No deadlines - or timer already set for the earliest deadline
+		return;
+	}
 
-							// NSLog(@"Retry:doing(se)=%@, %@", nextRetryDate, strongCore);
+	if (_waitConditionTimerSource == NULL)
+	{
+		__weak OCCore *weakSelf = self;
 
-							if (strongCore != nil)
-							{
-								strongCore->_nextSchedulingDate = nil;
-								[strongCore setNeedsToProcessSyncRecords];
-							}
-						});
-					}
-				}
-			}
-		}
+		_waitConditionTimerSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, _queue);
+
+		dispatch_source_set_event_handler(_waitConditionTimerSource, ^{
+			[weakSelf _waitConditionTimerFired];
+		});
+
+		dispatch_resume(_waitConditionTimerSource);
+	}
+
+	OCLogDebug(@"Scheduling wait condition timer for %@ (previously scheduled for %@)", nextDeadline, _nextSchedulingDate);
+
+	_nextSchedulingDate = nextDeadline;
+
+	// A single timer - re-armed for the earliest deadline - with a leeway of one second, so the system can coalesce the wakeup with others
+	dispatch_source_set_timer(_waitConditionTimerSource, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(MAX(nextDeadline.timeIntervalSinceNow, 0) * NSEC_PER_SEC)), DISPATCH_TIME_FOREVER, 1ull * NSEC_PER_SEC);
+}
+
+- (void)_waitConditionTimerFired
+{
+	NSUInteger dueRecords;
+
+	OCLogDebug(@"Wait condition timer scheduled for %@ fired", _nextSchedulingDate);
+
+	_nextSchedulingDate = nil;
+
+	// Only process the lanes of records whose wait conditions are due
+	if ((dueRecords = [_syncReadyQueue markRecordsReadyWithWaitConditionDeadlinesUpTo:[NSDate new]]) > 0)
+	{
+		OCLogDebug(@"Wait conditions of %lu sync records are due", dueRecords);
+
+		[self _setNeedsToProcessReadySyncLanes];
 	}
+
+	[self _rescheduleWaitConditionTimer];
 }
 
 #pragma mark - Sync event queueing
@@ -1577,7 +1792,7 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 			return (eventQueue);
 		}];
 
-		[self setNeedsToProcessSyncRecords];
+		[self setNeedsToProcessSyncRecordWithID:recordID];
 
 		[self endActivity:@"Queuing sync event"];
 	}
@@ -1711,6 +1926,14 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 
 	[self.database updateSyncRecords:syncRecords completionHandler:completionHandler];
 
+	for (OCSyncRecord *syncRecord in syncRecords)
+	{
+		if ((syncRecord.recordID != nil) && (syncRecord.laneID != nil))
+		{
+			[_syncReadyQueue setLaneID:syncRecord.laneID forRecordID:syncRecord.recordID];
+		}
+	}
+
 	[self setNeedsToBroadcastSyncRecordActivityUpdate];
 }
 
@@ -1719,6 +1942,13 @@ static OCKeyValueStoreKey OCKeyValueStoreKeyActiveProcessCores = @"activeProcess
 	for (OCSyncRecord *syncRecord in syncRecords)
 	{
  		[self.activityManager update:[OCActivityUpdate unpublishActivityFor:syncRecord]];
+
+		// Removal of a record may unblock the following record on its lane
+		if (syncRecord.recordID != nil)
+		{
+			[_syncReadyQueue removeRecordID:syncRecord.recordID];
+			[_syncTransferScheduler removeRecordID:syncRecord.recordID];
+		}
 	}
 
 	[self.database removeSyncRecords:syncRecords completionHandler:completionHandler];
@@ -0,0 +1,89 @@
+//
+//  OCSyncReadyQueue.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "OCTypes.h"
+#import "OCSyncLane.h"
+
+/*
+	In-memory state of the sync engine between processing runs:
+	- lanes that need to be processed ("ready") - they become ready through explicit triggers:
+		- an event arrived for one of its records
+		- a wait condition of one of its records reached its retry date
+		- a lane it depends on (.afterLanes) was removed
+		- action budget or an active lane slot (OCCore.maximumSyncLanes) it was waiting for became available
+		- one of its records was added, rescheduled or removed
+	- the lane dependency graph (lane -> lanes waiting for it)
+	- the lane each known sync record is on
+	- the action budget used by the records on each lane, as of the last time the lane was processed
+
+	A full scan of all lanes is only needed initially and if changes may have happened that aren't covered by the triggers (f.ex. in another process).
+*/
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCSyncReadyQueue : NSObject
+
+#pragma mark - Full scan
+@property(readonly,nonatomic) BOOL needsFullScan; //!< YES if all lanes need to be processed (initially YES)
+- (void)setNeedsFullScan;
+
+- (void)resetWithLanes:(NSArray<OCSyncLane *> *)lanes; //!< Starts a full scan: replaces the known lanes with lanes, clears ready lanes, budget usage and active lanes and resets .needsFullScan
+
+#pragma mark - Lanes
+@property(readonly,nonatomic) NSUInteger numberOfLanes; //!< Number of known lanes
+
+- (nullable OCSyncLane *)laneForID:(OCSyncLaneID)laneID;
+- (void)addLane:(OCSyncLane *)lane; //!< Adds a new lane to the dependency graph and marks it as ready
+- (void)updateLanes:(NSArray<OCSyncLane *> *)lanes; //!< Replaces the known lanes with lanes, f.ex. after lanes were added by another process. Lanes no longer contained are treated as removed.
+- (void)removeLaneID:(OCSyncLaneID)laneID; //!< Removes a lane. Lanes waiting for it and for an active lane slot become ready.
+
+- (BOOL)isLaneWaitingForPredecessors:(OCSyncLane *)lane; //!< YES if any of the lanes in lane.afterLanes still exist
+
+#pragma mark - Records
+- (nullable OCSyncLaneID)laneIDForRecordID:(OCSyncRecordID)recordID;
+- (void)setLaneID:(OCSyncLaneID)laneID forRecordID:(OCSyncRecordID)recordID;
+- (void)removeRecordID:(OCSyncRecordID)recordID; //!< Forgets the record and marks its lane as ready
+
+#pragma mark - Triggers
+- (void)markLaneIDReady:(OCSyncLaneID)laneID;
+- (void)markRecordIDReady:(OCSyncRecordID)recordID; //!< Marks the lane of the record as ready. If the lane isn't known, the record is kept until -dequeueUnresolvedRecordIDs.
+
+@property(readonly,nonatomic) BOOL hasReadyLanes; //!< YES if lanes or records are ready to be processed (independent of .needsFullScan)
+
+- (NSArray<OCSyncLaneID> *)dequeueReadyLaneIDs; //!< Returns the ready lanes in processing order and clears them
+- (NSArray<OCSyncRecordID> *)dequeueUnresolvedRecordIDs; //!< Returns records that were marked ready, but whose lane isn't known, and clears them
+
+#pragma mark - Wait condition deadlines
+- (void)setWaitConditionDeadline:(nullable NSDate *)deadline forRecordID:(OCSyncRecordID)recordID; //!< Sets (or clears, if deadline is nil) the next date at which the record's wait conditions should be checked. Deadlines are tracked in a timer wheel with a resolution of one second, so deadlines within the same second are handled together.
+@property(readonly,nonatomic,nullable) NSDate *nextWaitConditionDeadline; //!< The earliest wait condition deadline (rounded up to the next full second)
+- (NSUInteger)markRecordsReadyWithWaitConditionDeadlinesUpTo:(NSDate *)date; //!< Marks the records whose deadline is on or before date as ready, removes their deadlines and returns their number
+
+#pragma mark - Action budgets
+- (NSUInteger)numberOfRunningActionsInCategory:(OCSyncActionCategory)category; //!< Budget used in the category across all lanes
+
+- (BOOL)canProcessLaneID:(OCSyncLaneID)laneID maximumActiveLanes:(NSUInteger)maximumActiveLanes; //!< Returns NO - and remembers the lane to become ready when a slot frees up - if processing the lane would exceed maximumActiveLanes (0 = no limit)
+- (void)beginProcessingLaneID:(OCSyncLaneID)laneID; //!< Removes the lane from the ready lanes and releases the budget used by it, as it is recomputed while processing the lane
+- (void)updateBudgetUsageOfLaneID:(OCSyncLaneID)laneID categories:(NSArray<OCSyncActionCategory> *)categories change:(NSInteger)change;
+- (void)markLaneIDBudgetBlocked:(OCSyncLaneID)laneID; //!< Remembers the lane to become ready when budget is released
+- (void)endProcessingLaneID:(OCSyncLaneID)laneID active:(BOOL)active; //!< Marks budget-blocked lanes ready if the lane now uses less budget than before. Marks lanes waiting for a slot ready if the lane is no longer active.
+
+@end
+
+NS_ASSUME_NONNULL_END
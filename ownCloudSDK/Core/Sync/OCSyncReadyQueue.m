@@ -0,0 +1,536 @@
+//
+//  OCSyncReadyQueue.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCSyncReadyQueue.h"
+#import "OCTimerWheel.h"
+
+@interface OCSyncReadyQueue ()
+{
+	NSMutableDictionary<OCSyncLaneID, OCSyncLane *> *_lanesByID;
+	NSMutableDictionary<OCSyncLaneID, NSMutableSet<OCSyncLaneID> *> *_dependentLaneIDsByLaneID;
+
+	NSMutableDictionary<OCSyncRecordID, OCSyncLaneID> *_laneIDsByRecordID;
+
+	NSMutableSet<OCSyncLaneID> *_readyLaneIDs;
+	NSMutableSet<OCSyncRecordID> *_unresolvedRecordIDs;
+
+	OCTimerWheel<OCSyncRecordID> *_waitConditionDeadlines;
+
+	NSMutableDictionary<OCSyncLaneID, NSCountedSet<OCSyncActionCategory> *> *_budgetUsageByLaneID;
+	NSCountedSet<OCSyncActionCategory> *_budgetUsage;
+	NSCountedSet<OCSyncActionCategory> *_previousBudgetUsageOfProcessedLane;
+	OCSyncLaneID _processedLaneID;
+
+	NSMutableSet<OCSyncLaneID> *_budgetBlockedLaneIDs;
+	NSMutableSet<OCSyncLaneID> *_activeLaneIDs;
+	NSMutableSet<OCSyncLaneID> *_slotBlockedLaneIDs;
+}
+@end
+
+@implementation OCSyncReadyQueue
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_needsFullScan = YES;
+
+		_lanesByID = [NSMutableDictionary new];
+		_dependentLaneIDsByLaneID = [NSMutableDictionary new];
+
+		_laneIDsByRecordID = [NSMutableDictionary new];
+
+		_readyLaneIDs = [NSMutableSet new];
+		_unresolvedRecordIDs = [NSMutableSet new];
+
+		_waitConditionDeadlines = [[OCTimerWheel alloc] initWithResolution:1.0];
+
+		_budgetUsageByLaneID = [NSMutableDictionary new];
+		_budgetUsage = [NSCountedSet new];
+
+		_budgetBlockedLaneIDs = [NSMutableSet new];
+		_activeLaneIDs = [NSMutableSet new];
+		_slotBlockedLaneIDs = [NSMutableSet new];
+	}
+
+	return (self);
+}
+
+#pragma mark - Full scan
+- (void)setNeedsFullScan
+{
+	@synchronized(self)
+	{
+		_needsFullScan = YES;
+	}
+}
+
+- (void)resetWithLanes:(NSArray<OCSyncLane *> *)lanes
+{
+	@synchronized(self)
+	{
+		[_lanesByID removeAllObjects];
+		[_dependentLaneIDsByLaneID removeAllObjects];
+
+		for (OCSyncLane *lane in lanes)
+		{
+			[self _addLane:lane];
+		}
+
+		[_readyLaneIDs removeAllObjects];
+		[_unresolvedRecordIDs removeAllObjects];
+
+		[_budgetUsageByLaneID removeAllObjects];
+		[_budgetUsage removeAllObjects];
+
+		[_budgetBlockedLaneIDs removeAllObjects];
+		[_activeLaneIDs removeAllObjects];
+		[_slotBlockedLaneIDs removeAllObjects];
+
+		_needsFullScan = NO;
+	}
+}
+
+#pragma mark - Lanes
+- (NSUInteger)numberOfLanes
+{
+	@synchronized(self)
+	{
+		return (_lanesByID.count);
+	}
+}
+
+- (OCSyncLane *)laneForID:(OCSyncLaneID)laneID
+{
+	@synchronized(self)
+	{
+		return (_lanesByID[laneID]);
+	}
+}
+
+- (void)_addLane:(OCSyncLane *)lane
+{
+	OCSyncLaneID laneID;
+
+	if ((laneID = lane.identifier) == nil)
+	{
+		return;
+	}
+
+	_lanesByID[laneID] = lane;
+
+	for (OCSyncLaneID afterLaneID in lane.afterLanes)
+	{
+		NSMutableSet<OCSyncLaneID> *dependentLaneIDs;
+
+		if ((dependentLaneIDs = _dependentLaneIDsByLaneID[afterLaneID]) == nil)
+		{
+			_dependentLaneIDsByLaneID[afterLaneID] = dependentLaneIDs = [NSMutableSet new];
+		}
+
+		[dependentLaneIDs addObject:laneID];
+	}
+}
+
+- (void)addLane:(OCSyncLane *)lane
+{
+	@synchronized(self)
+	{
+		[self _addLane:lane];
+
+		if (lane.identifier != nil)
+		{
+			[_readyLaneIDs addObject:lane.identifier];
+		}
+	}
+}
+
+- (void)updateLanes:(NSArray<OCSyncLane *> *)lanes
+{
+	@synchronized(self)
+	{
+		NSMutableSet<OCSyncLaneID> *removedLaneIDs = [NSMutableSet setWithArray:_lanesByID.allKeys];
+
+		for (OCSyncLane *lane in lanes)
+		{
+			if (lane.identifier == nil) { continue; }
+
+			[removedLaneIDs removeObject:lane.identifier];
+
+			if (_lanesByID[lane.identifier] == nil)
+			{
+				[self _addLane:lane];
+				[_readyLaneIDs addObject:lane.identifier];
+			}
+			else
+			{
+				// Tags may have been extended
+				_lanesByID[lane.identifier] = lane;
+			}
+		}
+
+		for (OCSyncLaneID laneID in removedLaneIDs)
+		{
+			[self _removeLaneID:laneID];
+		}
+	}
+}
+
+- (void)_removeLaneID:(OCSyncLaneID)laneID
+{
+	OCSyncLane *lane;
+	NSCountedSet<OCSyncActionCategory> *budgetUsage;
+
+	if ((lane = _lanesByID[laneID]) != nil)
+	{
+		for (OCSyncLaneID afterLaneID in lane.afterLanes)
+		{
+			[_dependentLaneIDsByLaneID[afterLaneID] removeObject:laneID];
+		}
+
+		[_lanesByID removeObjectForKey:laneID];
+	}
+
+	// Lanes waiting for this lane may now be able to start
+	NSMutableSet<OCSyncLaneID> *dependentLaneIDs;
+
+	if ((dependentLaneIDs = _dependentLaneIDsByLaneID[laneID]) != nil)
+	{
+		[_readyLaneIDs unionSet:dependentLaneIDs];
+		[_dependentLaneIDsByLaneID removeObjectForKey:laneID];
+	}
+
+	// Release budget
+	if ((budgetUsage = _budgetUsageByLaneID[laneID]) != nil)
+	{
+		if (budgetUsage.count > 0)
+		{
+			for (OCSyncActionCategory category in budgetUsage)
+			{
+				for (NSUInteger i=0; i<[budgetUsage countForObject:category]; i++)
+				{
+					[_budgetUsage removeObject:category];
+				}
+			}
+
+			[self _releaseBudgetBlockedLanes];
+		}
+
+		[_budgetUsageByLaneID removeObjectForKey:laneID];
+	}
+
+	// Release lane slot
+	if ([_activeLaneIDs containsObject:laneID])
+	{
+		[_activeLaneIDs removeObject:laneID];
+		[self _releaseSlotBlockedLanes];
+	}
+
+	[_readyLaneIDs removeObject:laneID];
+	[_budgetBlockedLaneIDs removeObject:laneID];
+	[_slotBlockedLaneIDs removeObject:laneID];
+}
+
+- (void)removeLaneID:(OCSyncLaneID)laneID
+{
+	@synchronized(self)
+	{
+		[self _removeLaneID:laneID];
+	}
+}
+
+- (BOOL)isLaneWaitingForPredecessors:(OCSyncLane *)lane
+{
+	@synchronized(self)
+	{
+		for (OCSyncLaneID afterLaneID in lane.afterLanes)
+		{
+			if (_lanesByID[afterLaneID] != nil)
+			{
+				return (YES);
+			}
+		}
+
+		return (NO);
+	}
+}
+
+#pragma mark - Records
+- (OCSyncLaneID)laneIDForRecordID:(OCSyncRecordID)recordID
+{
+	@synchronized(self)
+	{
+		return (_laneIDsByRecordID[recordID]);
+	}
+}
+
+- (void)setLaneID:(OCSyncLaneID)laneID forRecordID:(OCSyncRecordID)recordID
+{
+	@synchronized(self)
+	{
+		_laneIDsByRecordID[recordID] = laneID;
+	}
+}
+
+- (void)removeRecordID:(OCSyncRecordID)recordID
+{
+	@synchronized(self)
+	{
+		OCSyncLaneID laneID;
+
+		if ((laneID = _laneIDsByRecordID[recordID]) != nil)
+		{
+			// Removals from the lane that is currently processed are picked up by its processing
+			if (![laneID isEqual:_processedLaneID])
+			{
+				[_readyLaneIDs addObject:laneID];
+			}
+
+			[_laneIDsByRecordID removeObjectForKey:recordID];
+		}
+
+		[_waitConditionDeadlines removeKey:recordID];
+		[_unresolvedRecordIDs removeObject:recordID];
+	}
+}
+
+#pragma mark - Triggers
+- (void)markLaneIDReady:(OCSyncLaneID)laneID
+{
+	@synchronized(self)
+	{
+		[_readyLaneIDs addObject:laneID];
+	}
+}
+
+- (void)markRecordIDReady:(OCSyncRecordID)recordID
+{
+	@synchronized(self)
+	{
+		OCSyncLaneID laneID;
+
+		if ((laneID = _laneIDsByRecordID[recordID]) != nil)
+		{
+			[_readyLaneIDs addObject:laneID];
+		}
+		else
+		{
+			[_unresolvedRecordIDs addObject:recordID];
+		}
+	}
+}
+
+- (BOOL)hasReadyLanes
+{
+	@synchronized(self)
+	{
+		return ((_readyLaneIDs.count > 0) || (_unresolvedRecordIDs.count > 0));
+	}
+}
+
+- (NSArray<OCSyncLaneID> *)dequeueReadyLaneIDs
+{
+	@synchronized(self)
+	{
+		NSArray<OCSyncLaneID> *readyLaneIDs = [_readyLaneIDs.allObjects sortedArrayUsingSelector:@selector(compare:)];
+
+		[_readyLaneIDs removeAllObjects];
+
+		return (readyLaneIDs);
+	}
+}
+
+- (NSArray<OCSyncRecordID> *)dequeueUnresolvedRecordIDs
+{
+	@synchronized(self)
+	{
+		NSArray<OCSyncRecordID> *unresolvedRecordIDs = _unresolvedRecordIDs.allObjects;
+
+		[_unresolvedRecordIDs removeAllObjects];
+
+		return (unresolvedRecordIDs);
+	}
+}
+
+#pragma mark - Wait condition deadlines
+- (void)setWaitConditionDeadline:(NSDate *)deadline forRecordID:(OCSyncRecordID)recordID
+{
+	@synchronized(self)
+	{
+		[_waitConditionDeadlines setDeadline:deadline forKey:recordID];
+	}
+}
+
+- (NSDate *)nextWaitConditionDeadline
+{
+	@synchronized(self)
+	{
+		return (_waitConditionDeadlines.nextDeadline);
+	}
+}
+
+- (NSUInteger)markRecordsReadyWithWaitConditionDeadlinesUpTo:(NSDate *)date
+{
+	@synchronized(self)
+	{
+		NSArray<OCSyncRecordID> *expiredRecordIDs = [_waitConditionDeadlines advanceToDate:date];
+
+		for (OCSyncRecordID recordID in expiredRecordIDs)
+		{
+			[self markRecordIDReady:recordID];
+		}
+
+		return (expiredRecordIDs.count);
+	}
+}
+
+#pragma mark - Action budgets
+- (NSUInteger)numberOfRunningActionsInCategory:(OCSyncActionCategory)category
+{
+	@synchronized(self)
+	{
+		return ([_budgetUsage countForObject:category]);
+	}
+}
+
+- (BOOL)canProcessLaneID:(OCSyncLaneID)laneID maximumActiveLanes:(NSUInteger)maximumActiveLanes
+{
+	@synchronized(self)
+	{
+		if ((maximumActiveLanes == 0) || [_activeLaneIDs containsObject:laneID] || (_activeLaneIDs.count < maximumActiveLanes))
+		{
+			return (YES);
+		}
+
+		[_slotBlockedLaneIDs addObject:laneID];
+
+		return (NO);
+	}
+}
+
+- (void)beginProcessingLaneID:(OCSyncLaneID)laneID
+{
+	@synchronized(self)
+	{
+		NSCountedSet<OCSyncActionCategory> *budgetUsage = _budgetUsageByLaneID[laneID];
+
+		for (OCSyncActionCategory category in budgetUsage)
+		{
+			for (NSUInteger i=0; i<[budgetUsage countForObject:category]; i++)
+			{
+				[_budgetUsage removeObject:category];
+			}
+		}
+
+		_previousBudgetUsageOfProcessedLane = (budgetUsage != nil) ? budgetUsage : [NSCountedSet new];
+		_budgetUsageByLaneID[laneID] = [NSCountedSet new];
+
+		_processedLaneID = laneID;
+
+		[_readyLaneIDs removeObject:laneID];
+		[_budgetBlockedLaneIDs removeObject:laneID];
+		[_slotBlockedLaneIDs removeObject:laneID];
+	}
+}
+
+- (void)updateBudgetUsageOfLaneID:(OCSyncLaneID)laneID categories:(NSArray<OCSyncActionCategory> *)categories change:(NSInteger)change
+{
+	@synchronized(self)
+	{
+		NSCountedSet<OCSyncActionCategory> *budgetUsage;
+
+		if ((budgetUsage = _budgetUsageByLaneID[laneID]) == nil)
+		{
+			_budgetUsageByLaneID[laneID] = budgetUsage = [NSCountedSet new];
+		}
+
+		for (OCSyncActionCategory category in categories)
+		{
+			if (change > 0)
+			{
+				[budgetUsage addObject:category];
+				[_budgetUsage addObject:category];
+			}
+			else if ([budgetUsage countForObject:category] > 0)
+			{
+				[budgetUsage removeObject:category];
+				[_budgetUsage removeObject:category];
+			}
+		}
+	}
+}
+
+- (void)markLaneIDBudgetBlocked:(OCSyncLaneID)laneID
+{
+	@synchronized(self)
+	{
+		[_budgetBlockedLaneIDs addObject:laneID];
+	}
+}
+
+- (void)endProcessingLaneID:(OCSyncLaneID)laneID active:(BOOL)active
+{
+	@synchronized(self)
+	{
+		NSCountedSet<OCSyncActionCategory> *budgetUsage = _budgetUsageByLaneID[laneID];
+
+		// Budget released by the lane => lanes waiting for budget may now be able to proceed
+		for (OCSyncActionCategory category in _previousBudgetUsageOfProcessedLane)
+		{
+			if ([budgetUsage countForObject:category] < [_previousBudgetUsageOfProcessedLane countForObject:category])
+			{
+				[self _releaseBudgetBlockedLanes];
+				break;
+			}
+		}
+
+		if (budgetUsage.count == 0)
+		{
+			[_budgetUsageByLaneID removeObjectForKey:laneID];
+		}
+
+		// Lane slot released => lanes waiting for a slot may now be able to start
+		if (active)
+		{
+			[_activeLaneIDs addObject:laneID];
+		}
+		else if ([_activeLaneIDs containsObject:laneID])
+		{
+			[_activeLaneIDs removeObject:laneID];
+			[self _releaseSlotBlockedLanes];
+		}
+
+		_previousBudgetUsageOfProcessedLane = nil;
+		_processedLaneID = nil;
+	}
+}
+
+- (void)_releaseBudgetBlockedLanes
+{
+	[_readyLaneIDs unionSet:_budgetBlockedLaneIDs];
+	[_budgetBlockedLaneIDs removeAllObjects];
+}
+
+- (void)_releaseSlotBlockedLanes
+{
+	[_readyLaneIDs unionSet:_slotBlockedLaneIDs];
+	[_slotBlockedLaneIDs removeAllObjects];
+}
+
+@end
@@ -0,0 +1,67 @@
+//
+//  OCSyncTransferScheduler.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "OCTypes.h"
+
+/*
+	Determines the order in which sync records waiting to start a transfer get to use the action concurrency budgets:
+	- OCSyncTransferSchedulingPolicyLaneOrder: in the order of their lanes (first come, first served)
+	- OCSyncTransferSchedulingPolicyShortestFirst: smallest transfers first, so that small transfers don't have to wait for large ones. To avoid starvation,
+	  - the effective size of a waiting transfer halves with every .agingInterval it has been waiting
+	  - .reservedLargeTransferSlots large transfers (.largeTransferThreshold and above) are moved to the front while fewer are running
+*/
+
+typedef NSString* OCSyncTransferSchedulingPolicy NS_TYPED_ENUM;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCSyncTransferCandidate : NSObject
+
+@property(strong,readonly) OCSyncLaneID laneID;
+@property(strong,readonly) OCSyncRecordID recordID;
+@property(assign,readonly) unsigned long long size; //!< Size of the transfer in bytes
+@property(strong,readonly) NSDate *waitingSince; //!< Date at which the record was first found waiting to start its transfer
+
+@end
+
+@interface OCSyncTransferScheduler : NSObject
+
+@property(strong,nonatomic) OCSyncTransferSchedulingPolicy policy; //!< The scheduling policy (default: OCSyncTransferSchedulingPolicyShortestFirst)
+@property(assign) NSTimeInterval agingInterval; //!< Waiting time after which the effective size of a transfer halves (default: 5 minutes, 0 = no aging)
+@property(assign) unsigned long long largeTransferThreshold; //!< Size from which on a transfer is considered large (default: 100 MB)
+@property(assign) NSUInteger reservedLargeTransferSlots; //!< Number of concurrent transfers reserved for large transfers (default: 1)
+
+@property(readonly,nonatomic) BOOL defersTransfers; //!< YES if the policy requires transfers to be collected and ordered before they can start
+
+- (BOOL)isLargeTransferSize:(unsigned long long)size;
+
+- (OCSyncTransferCandidate *)candidateForLaneID:(OCSyncLaneID)laneID recordID:(OCSyncRecordID)recordID size:(unsigned long long)size date:(NSDate *)date; //!< Returns a candidate for the record. If the record hasn't been seen waiting before, date is remembered as the date it started waiting.
+- (void)removeRecordID:(OCSyncRecordID)recordID; //!< Forgets the waiting date of the record after its transfer started or it was removed
+
+- (NSArray<OCSyncTransferCandidate *> *)orderCandidates:(NSArray<OCSyncTransferCandidate *> *)candidates runningLargeTransfers:(NSUInteger)runningLargeTransfers date:(NSDate *)date; //!< Returns the candidates in the order in which they should get to start their transfers
+
+@end
+
+extern OCSyncTransferSchedulingPolicy OCSyncTransferSchedulingPolicyLaneOrder;
+extern OCSyncTransferSchedulingPolicy OCSyncTransferSchedulingPolicyShortestFirst;
+
+extern OCSyncActionCategory OCSyncActionCategoryTransferLarge; //!< Category the sync engine adds to transfers of .largeTransferThreshold and above. Can be used in OCCoreActionConcurrencyBudgets to limit the number of concurrent large transfers.
+
+NS_ASSUME_NONNULL_END
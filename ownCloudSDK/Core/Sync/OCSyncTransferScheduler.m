@@ -0,0 +1,170 @@
+//
+//  OCSyncTransferScheduler.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCSyncTransferScheduler.h"
+
+@interface OCSyncTransferCandidate ()
+{
+	double _effectiveSize;
+}
+@end
+
+@implementation OCSyncTransferCandidate
+
+- (instancetype)initWithLaneID:(OCSyncLaneID)laneID recordID:(OCSyncRecordID)recordID size:(unsigned long long)size waitingSince:(NSDate *)waitingSince
+{
+	if ((self = [super init]) != nil)
+	{
+		_laneID = laneID;
+		_recordID = recordID;
+		_size = size;
+		_waitingSince = waitingSince;
+	}
+
+	return (self);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, laneID: %@, recordID: %@, size: %llu, waitingSince: %@>", NSStringFromClass(self.class), self, _laneID, _recordID, _size, _waitingSince]);
+}
+
+@end
+
+@interface OCSyncTransferScheduler ()
+{
+	NSMutableDictionary<OCSyncRecordID, NSDate *> *_waitingSinceByRecordID;
+}
+@end
+
+@implementation OCSyncTransferScheduler
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_policy = OCSyncTransferSchedulingPolicyShortestFirst;
+		_agingInterval = 5 * 60;
+		_largeTransferThreshold = 100 * 1024 * 1024;
+		_reservedLargeTransferSlots = 1;
+
+		_waitingSinceByRecordID = [NSMutableDictionary new];
+	}
+
+	return (self);
+}
+
+- (BOOL)defersTransfers
+{
+	return ([_policy isEqual:OCSyncTransferSchedulingPolicyShortestFirst]);
+}
+
+- (BOOL)isLargeTransferSize:(unsigned long long)size
+{
+	return ((_largeTransferThreshold > 0) && (size >= _largeTransferThreshold));
+}
+
+#pragma mark - Candidates
+- (OCSyncTransferCandidate *)candidateForLaneID:(OCSyncLaneID)laneID recordID:(OCSyncRecordID)recordID size:(unsigned long long)size date:(NSDate *)date
+{
+	NSDate *waitingSince;
+
+	@synchronized(self)
+	{
+		if ((waitingSince = _waitingSinceByRecordID[recordID]) == nil)
+		{
+			_waitingSinceByRecordID[recordID] = waitingSince = date;
+		}
+	}
+
+	return ([[OCSyncTransferCandidate alloc] initWithLaneID:laneID recordID:recordID size:size waitingSince:waitingSince]);
+}
+
+- (void)removeRecordID:(OCSyncRecordID)recordID
+{
+	@synchronized(self)
+	{
+		[_waitingSinceByRecordID removeObjectForKey:recordID];
+	}
+}
+
+#pragma mark - Ordering
+- (NSArray<OCSyncTransferCandidate *> *)orderCandidates:(NSArray<OCSyncTransferCandidate *> *)candidates runningLargeTransfers:(NSUInteger)runningLargeTransfers date:(NSDate *)date
+{
+	NSMutableArray<OCSyncTransferCandidate *> *orderedCandidates;
+
+	if (!self.defersTransfers)
+	{
+		return ([candidates sortedArrayUsingComparator:^NSComparisonResult(OCSyncTransferCandidate *candidate1, OCSyncTransferCandidate *candidate2) {
+			return ([candidate1.laneID compare:candidate2.laneID]);
+		}]);
+	}
+
+	// Shortest first, with the effective size halving with every aging interval spent waiting
+	for (OCSyncTransferCandidate *candidate in candidates)
+	{
+		NSTimeInterval waitingTime = MAX([date timeIntervalSinceDate:candidate.waitingSince], 0);
+
+		candidate->_effectiveSize = (_agingInterval > 0) ? ((double)candidate.size / pow(2.0, waitingTime / _agingInterval)) : (double)candidate.size;
+	}
+
+	orderedCandidates = [[candidates sortedArrayUsingComparator:^NSComparisonResult(OCSyncTransferCandidate *candidate1, OCSyncTransferCandidate *candidate2) {
+		if (candidate1->_effectiveSize != candidate2->_effectiveSize)
+		{
+			return ((candidate1->_effectiveSize < candidate2->_effectiveSize) ? NSOrderedAscending : NSOrderedDescending);
+		}
+
+		return ([candidate1.laneID compare:candidate2.laneID]);
+	}] mutableCopy];
+
+	// Move large transfers to the front while fewer than the reserved number are running
+	if (runningLargeTransfers < _reservedLargeTransferSlots)
+	{
+		NSUInteger reservedSlots = _reservedLargeTransferSlots - runningLargeTransfers;
+		NSMutableArray<OCSyncTransferCandidate *> *largeCandidates = [NSMutableArray new];
+
+		for (OCSyncTransferCandidate *candidate in orderedCandidates)
+		{
+			if ([self isLargeTransferSize:candidate.size])
+			{
+				[largeCandidates addObject:candidate];
+
+				if (largeCandidates.count == reservedSlots)
+				{
+					break;
+				}
+			}
+		}
+
+		if (largeCandidates.count > 0)
+		{
+			[orderedCandidates removeObjectsInArray:largeCandidates];
+			[orderedCandidates insertObjects:largeCandidates atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, largeCandidates.count)]];
+		}
+	}
+
+	return (orderedCandidates);
+}
+
+@end
+
+OCSyncTransferSchedulingPolicy OCSyncTransferSchedulingPolicyLaneOrder = @"lane-order";
+OCSyncTransferSchedulingPolicy OCSyncTransferSchedulingPolicyShortestFirst = @"shortest-first";
+
+OCSyncActionCategory OCSyncActionCategoryTransferLarge = @"transfer-large";
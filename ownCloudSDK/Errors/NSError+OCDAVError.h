@@ -34,7 +34,11 @@ typedef NS_ENUM(NSInteger, OCDAVError)
 	OCDAVErrorServiceUnavailable,	//!< ownCloud server is in maintenance mode
 
 	// Headers
-	OCDAVErrorItemDoesNotExist
+	OCDAVErrorItemDoesNotExist,
+
+	// Preconditions
+	OCDAVErrorInvalidSyncToken,	//!< DAV:valid-sync-token precondition failed: the sync token passed to a sync-collection REPORT is no longer (or was never) valid (RFC 6578)
+	OCDAVErrorReportNotSupported	//!< DAV:supported-report precondition failed: the REPORT isn't supported for the resource (RFC 3253)
 };
 
 @interface NSError (OCDAVError) <OCXMLObjectCreation>
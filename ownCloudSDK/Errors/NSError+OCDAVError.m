@@ -40,9 +40,19 @@ static NSErrorUserInfoKey OCDAVErrorHeaderMessageKey = @"OCDavErrorHeaderMessage
 	NSString *sabreException;
 	NSString *sabreHeader;
 	NSString *sabreMessage;
+	__block OCDAVError preconditionErrorCode = OCDAVErrorNone;
 
 	sabreMessage = errorNode.keyValues[@"s:message"];
 
+	// Failed preconditions are identified by an empty element (RFC 4918, section 16), independent of server implementation
+	[errorNode enumerateChildNodesWithName:@"d:valid-sync-token" usingBlock:^(OCXMLParserNode *childNode) {
+		preconditionErrorCode = OCDAVErrorInvalidSyncToken;
+	}];
+
+	[errorNode enumerateChildNodesWithName:@"d:supported-report" usingBlock:^(OCXMLParserNode *childNode) {
+		preconditionErrorCode = OCDAVErrorReportNotSupported;
+	}];
+
 	if ((sabreException = errorNode.keyValues[@"s:exception"]) != nil)
 	{
 		OCDAVError errorCode = OCDAVErrorUnknown;
@@ -58,6 +68,21 @@ static NSErrorUserInfoKey OCDAVErrorHeaderMessageKey = @"OCDavErrorHeaderMessage
 			errorCode = OCDAVErrorNotFound;
 		}
 
+		if ([sabreException isEqual:@"Sabre\\DAV\\Exception\\InvalidSyncToken"])
+		{
+			errorCode = OCDAVErrorInvalidSyncToken;
+		}
+
+		if ([sabreException isEqual:@"Sabre\\DAV\\Exception\\ReportNotSupported"])
+		{
+			errorCode = OCDAVErrorReportNotSupported;
+		}
+
+		if ((errorCode == OCDAVErrorUnknown) && (preconditionErrorCode != OCDAVErrorNone))
+		{
+			errorCode = preconditionErrorCode;
+		}
+
 		davError = [NSError 	errorWithDomain:OCDAVErrorDomain
 				 	code:errorCode
 				 	userInfo:[NSDictionary dictionaryWithObjectsAndKeys:
@@ -90,6 +115,11 @@ static NSErrorUserInfoKey OCDAVErrorHeaderMessageKey = @"OCDavErrorHeaderMessage
 			   ];
 	}
 
+	if ((davError == nil) && (preconditionErrorCode != OCDAVErrorNone))
+	{
+		davError = [NSError errorWithDomain:OCDAVErrorDomain code:preconditionErrorCode userInfo:nil];
+	}
+
 	return (davError);
 }
 
@@ -148,6 +178,14 @@ static NSErrorUserInfoKey OCDAVErrorHeaderMessageKey = @"OCDavErrorHeaderMessage
 			case OCDAVErrorItemDoesNotExist:
 				unlocalizedString = @"Item not found.";
 			break;
+
+			case OCDAVErrorInvalidSyncToken:
+				unlocalizedString = @"Invalid sync token.";
+			break;
+
+			case OCDAVErrorReportNotSupported:
+				unlocalizedString = @"Report not supported.";
+			break;
 		}
 	}
 
@@ -118,7 +118,9 @@ typedef NS_ENUM(NSUInteger, OCError)
 	OCErrorWebFingerLacksServerInstanceRelation, //!< Web finger response lacks server instance relation.
 	OCErrorUnknownUser, //!< Unknown user
 
-	OCErrorRequestTimeout //!< Request timed out
+	OCErrorRequestTimeout, //!< Request timed out
+
+	OCErrorResponseTooLarge //!< Response too large
 };
 
 @class OCIssue;
@@ -356,6 +356,10 @@ static NSString *OCErrorIssueKey = @"OCErrorIssue";
 				case OCErrorRequestTimeout:
 					unlocalizedString = @"Request timed out";
 				break;
+
+				case OCErrorResponseTooLarge:
+					unlocalizedString = @"Response too large";
+				break;
 			}
 		}
 	}
@@ -19,6 +19,7 @@
 #import "OCChecksum.h"
 #import "OCChecksumAlgorithm.h"
 #import "NSError+OCError.h"
+#import "OCStringInternPool.h"
 
 @implementation OCChecksum
 
@@ -40,7 +41,7 @@
 		{
 			if (components.count == 2)
 			{
-				_algorithmIdentifier = components.firstObject;
+				_algorithmIdentifier = [OCStringInternPool.sharedPool internString:components.firstObject];
 				_checksum = components.lastObject;
 				_headerString = headerString;
 			}
@@ -146,7 +147,7 @@
 {
 	if ((self = [super init]) != nil)
 	{
-		_algorithmIdentifier = [decoder decodeObjectOfClass:[NSString class] forKey:@"algorithmIdentifier"];
+		_algorithmIdentifier = [OCStringInternPool.sharedPool internString:[decoder decodeObjectOfClass:[NSString class] forKey:@"algorithmIdentifier"]];
 		_checksum = [decoder decodeObjectOfClass:[NSString class] forKey:@"checksum"];
 	}
 
@@ -31,6 +31,7 @@ typedef NSMutableDictionary<NSString*,NSString*>* OCHTTPRequestParameters;
 typedef float OCHTTPRequestPriority;
 typedef NSString* OCHTTPRequestID;
 typedef NSString* OCHTTPRequestGroupID;
+typedef NSString* OCHTTPRequestCoalescingKey;
 
 typedef NSString* OCHTTPPipelineID;
 typedef NSString* OCHTTPPipelinePartitionID;
@@ -43,6 +44,14 @@ typedef NS_ENUM(NSUInteger, OCHTTPPipelineTaskState)
 	OCHTTPPipelineTaskStateCompleted //!< The task was returned by the NSURLSession as completed
 };
 
+typedef NS_ENUM(NSInteger, OCHTTPRequestPriorityClass)
+{
+	OCHTTPRequestPriorityClassBackground,	//!< Work nobody is waiting for (f.ex. available offline downloads)
+	OCHTTPRequestPriorityClassUtility,	//!< Regular work (default)
+	OCHTTPRequestPriorityClassUserInitiated,//!< Work the user started and is waiting for (f.ex. opening a file)
+	OCHTTPRequestPriorityClassInteractive	//!< Work needed for the UI to be responsive (f.ex. the folder listing the user is looking at)
+};
+
 typedef NS_ENUM(NSUInteger, OCHTTPRequestInstruction)
 {
 	OCHTTPRequestInstructionDeliver,	//!< Deliver the request as usual
@@ -18,6 +18,7 @@
 
 #import "OCHTTPPipeline+Diagnostic.h"
 #import "OCHTTPPipelineTask+Diagnostic.h"
+#import "OCHTTPPipelineLatencyStatistics.h"
 #import "OCMacros.h"
 
 @implementation OCHTTPPipeline (Diagnostic)
@@ -31,6 +32,13 @@
 		[weakSelf setPipelineNeedsScheduling];
 	}]];
 
+	OCDiagnosticNode *latencyNode;
+
+	if ((latencyNode = [OCDiagnosticNode withLabel:@"Latency" children:[self _latencyDiagnosticNodes]]) != nil)
+	{
+		[diagnosticNodes addObject:latencyNode];
+	}
+
 	OCSyncExec(pipelineRun, {
 		[self queueBlock:^{
 			[self.backend enumerateTasksForPipeline:self enumerator:^(OCHTTPPipelineTask *task, BOOL *stop) {
@@ -54,4 +62,50 @@
 	return (diagnosticNodes);
 }
 
+- (NSArray<OCDiagnosticNode *> *)_latencyDiagnosticNodes
+{
+	NSMutableArray<OCDiagnosticNode *> *categoryNodes = [NSMutableArray new];
+	OCHTTPPipelineLatencyStatistics *latencyStatistics = self.latencyStatistics;
+	NSArray<OCHTTPRequestPhase> *phases = @[
+		OCHTTPRequestPhaseQueueWait,
+		OCHTTPRequestPhaseSchedulingDelay,
+		OCHTTPRequestPhaseDNS,
+		OCHTTPRequestPhaseConnect,
+		OCHTTPRequestPhaseTLS,
+		OCHTTPRequestPhaseTimeToFirstByte,
+		OCHTTPRequestPhaseTransfer,
+		OCHTTPRequestPhasePostProcessing,
+		OCHTTPRequestPhaseTotal
+	];
+
+	for (OCHTTPRequestCategory category in latencyStatistics.categories)
+	{
+		NSMutableArray<OCDiagnosticNode *> *phaseNodes = [NSMutableArray new];
+
+		for (OCHTTPRequestPhase phase in phases)
+		{
+			OCHTTPPipelineLatencyHistogram *histogram;
+
+			if ((histogram = [latencyStatistics histogramForCategory:category phase:phase]) != nil)
+			{
+				[phaseNodes addObject:[OCDiagnosticNode withLabel:phase content:[NSString stringWithFormat:@"n=%lu, p50=%.03fs, p90=%.03fs, p99=%.03fs, max=%.03fs", (unsigned long)histogram.count, [histogram valueAtPercentile:50], [histogram valueAtPercentile:90], [histogram valueAtPercentile:99], histogram.maximum]]];
+			}
+		}
+
+		[categoryNodes addObject:[OCDiagnosticNode withLabel:category children:phaseNodes]];
+	}
+
+	if (categoryNodes.count > 0)
+	{
+		NSData *jsonData;
+
+		if ((jsonData = latencyStatistics.JSONData) != nil)
+		{
+			[categoryNodes addObject:[OCDiagnosticNode withLabel:@"JSON" content:[[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding]]];
+		}
+	}
+
+	return (categoryNodes);
+}
+
 @end
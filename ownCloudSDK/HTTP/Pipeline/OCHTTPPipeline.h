@@ -26,6 +26,9 @@
 #import "OCLogTag.h"
 
 @class OCHTTPPipeline;
+@class OCHTTPPipelineConcurrencyController;
+@class OCHTTPPipelineLatencyStatistics;
+@class OCHTTPPipelineValidatorCache;
 
 typedef NS_ENUM(NSInteger, OCHTTPPipelineState)
 {
@@ -73,6 +76,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 @end
 
+@protocol OCHTTPPipelineTrafficRecorder <NSObject>
+
+- (void)pipeline:(OCHTTPPipeline *)pipeline recordFinishedTask:(OCHTTPPipelineTask *)task withResponse:(OCHTTPResponse *)response; //!< Called for every finished task before its result is delivered. Called on the pipeline's internal queue, so implementations should return quickly.
+
+@end
+
 @interface OCHTTPPipeline : NSObject <OCProgressResolver, OCClassSettingsSupport, OCLogTagging, NSURLSessionDelegate, NSURLSessionTaskDelegate, NSURLSessionDataDelegate, NSURLSessionDownloadDelegate>
 {
 	// URL Session handling
@@ -89,6 +98,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 	// Delivery
 	BOOL _needsDelivery;
+	NSMutableArray<OCHTTPPipelineTask *> *_deferredTaskRemovals;
 
 	// Certificate caching
 	NSMutableDictionary <NSString *, OCCertificate *> *_cachedCertificatesByHostnameAndPort;
@@ -110,6 +120,9 @@ NS_ASSUME_NONNULL_BEGIN
 @property(strong,readonly) OCHTTPPipelineBackend *backend;
 
 @property(assign) NSUInteger maximumConcurrentRequests; //!< The maximum number of concurrently running requests. A value of 0 means no limit.
+@property(assign) NSTimeInterval priorityAgingInterval; //!< Waiting time after which a request has gained the equivalent of one scheduling slot on requests of other priority classes. Prevents starvation of lower priority classes. Defaults to 10 seconds.
+@property(strong,nullable) id<OCHTTPPipelineTrafficRecorder> trafficRecorder; //!< If set, receives all finished request/response pairs (f.ex. to record traffic for replay via OCHostSimulator)
+@property(assign) BOOL adaptiveConcurrency; //!< If YES, the number of concurrently running requests per host is additionally limited by a OCHTTPPipelineConcurrencyController, which adapts the limit to latency, timeouts and 429/503 responses. Defaults to the value of the OCHTTPPipelineSettingAdaptiveConcurrency class setting for pipelines not backed by a background NSURLSession, NO otherwise.
 
 @property(strong,nullable,readonly) NSString *urlSessionIdentifier;
 
@@ -127,6 +140,7 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)enqueueRequest:(OCHTTPRequest *)request forPartitionID:(OCHTTPPipelinePartitionID)partitionID isFinal:(BOOL)isFinal; //!< Enqueues a request
 - (void)cancelRequest:(nullable OCHTTPRequest *)request; //!< Cancels a request
 - (void)cancelRequestsForPartitionID:(OCHTTPPipelinePartitionID)partitionID queuedOnly:(BOOL)queuedOnly; //!< Cancels all requests for a partitionID (or only those in the queue if queuedOnly is YES)
+- (void)cancelRequestsForPartitionID:(OCHTTPPipelinePartitionID)partitionID groupID:(nullable OCHTTPRequestGroupID)groupID queuedOnly:(BOOL)queuedOnly; //!< Cancels all requests for a partitionID and groupID (or only those in the queue if queuedOnly is YES). The state transitions of all affected requests are stored in a single transaction.
 - (void)cancelNonCriticalRequestsForPartitionID:(nullable OCHTTPPipelinePartitionID)partitionID; //!< Cancels all non critical requests. If a partitionID is provided, cancels only non-critical requests for that partition.
 - (void)finishPendingRequestsForPartitionID:(OCHTTPPipelinePartitionID)partitionID withError:(NSError *)error filter:(BOOL(^)(OCHTTPPipeline *pipeline, OCHTTPPipelineTask *task))filter;
 
@@ -158,6 +172,13 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Metrics
 - (nullable NSNumber *)estimatedTimeForRequest:(OCHTTPRequest *)request withExpectedResponseLength:(NSUInteger)expectedResponseLength confidence:(double * _Nullable)outConfidence;//!< If a sufficient amount of metrics could be collected, returns the estimated number of seconds it'll take the request to be sent and a response of expectedResponseLength be received.
 
+- (OCHTTPPipelineConcurrencyController *)concurrencyControllerForHostname:(NSString *)hostname; //!< Returns the controller managing the concurrency limit for hostname (created as needed)
+
+@property(strong,readonly) OCHTTPPipelineLatencyStatistics *latencyStatistics; //!< Histograms of the durations of the phases of the requests delivered by this pipeline since launch, by request category
+
+#pragma mark - Conditional requests
+@property(strong,readonly) OCHTTPPipelineValidatorCache *validatorCache; //!< Validators and bodies of responses to conditional requests (OCHTTPRequest.conditional)
+
 #pragma mark - Internal job queue
 - (void)queueBlock:(dispatch_block_t)block withBusy:(BOOL)withBusy; //!< Add a block for execution on the internal job queue.
 
@@ -165,5 +186,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 extern OCClassSettingsIdentifier OCClassSettingsIdentifierHTTP;
 extern OCClassSettingsKey OCHTTPPipelineSettingUserAgent;
+extern OCClassSettingsKey OCHTTPPipelineSettingAdaptiveConcurrency;
+extern OCClassSettingsKey OCHTTPPipelineSettingAdaptiveConcurrencyMaximum;
 
 NS_ASSUME_NONNULL_END
@@ -21,6 +21,10 @@
 #import "OCHTTPResponse.h"
 #import "OCHTTPPipelineBackend.h"
 #import "OCHTTPPipelineManager.h"
+#import "OCHTTPPipelineConcurrencyController.h"
+#import "OCHTTPPipelineLatencyStatistics.h"
+#import "OCHTTPPipelineValidatorCache.h"
+#import "OCHTTPResponseBodyDecoder.h"
 #import "OCProcessManager.h"
 #import "OCLogger.h"
 #import "NSError+OCError.h"
@@ -37,6 +41,8 @@
 #import "OCHTTPRequest+Stream.h"
 #import "NSURLSessionTask+Debug.h"
 
+static const double OCHTTPPipelinePriorityClassWeights[OCHTTPRequestPriorityClassInteractive] = { 1.0, 2.0, 4.0 }; //!< Fair queuing weights of the background, utility and user-initiated priority classes
+
 @interface OCHTTPPipeline ()
 {
 	dispatch_block_t _invalidationCompletionHandler;
@@ -53,9 +59,21 @@
 	NSTimeInterval _metricsHistoryMaxAge;
 	NSTimeInterval _metricsMinimumTotalTransferDurationRelevancyThreshold;
 
+	NSMutableDictionary<NSString *, OCHTTPPipelineConcurrencyController *> *_concurrencyControllersByHostname;
+	NSMutableDictionary<NSString *, NSNumber *> *_runningRequestCountsByHostname;
+	NSMutableDictionary<OCHTTPPipelineTaskID, NSDate *> *_runningSinceDatesByTaskID;
+
 	dispatch_group_t _busyGroup;
 
 	BOOL _observingCellularSwitchChanges;
+
+	NSMutableDictionary<OCHTTPRequestCoalescingKey, OCHTTPPipelineTaskID> *_coalescingLeaderTaskIDsByKey;
+	NSMutableDictionary<OCHTTPPipelineTaskID, OCHTTPRequestCoalescingKey> *_coalescingKeysByLeaderTaskID;
+	NSMutableDictionary<OCHTTPPipelineTaskID, NSMutableArray<OCHTTPPipelineTask *> *> *_coalescedTasksByLeaderTaskID;
+	NSMutableDictionary<OCHTTPPipelineTaskID, OCHTTPPipelineTaskID> *_coalescingLeaderTaskIDsByFollowerTaskID;
+
+	double _priorityClassFinishTags[OCHTTPRequestPriorityClassInteractive+1];
+	double _priorityClassVirtualTime;
 }
 
 - (void)queueBlock:(dispatch_block_t)block;
@@ -136,8 +154,23 @@
 		_metricsHistoryMaxAge = 10 * 60; //!< Metrics records are used for computation for a maximum of 10 minutes
 		_metricsMinimumTotalTransferDurationRelevancyThreshold = 0.01; // Only metrics with a minimum total transfer duration of X secs should be considered relevant
 
+		_concurrencyControllersByHostname = [NSMutableDictionary new];
+		_runningRequestCountsByHostname = [NSMutableDictionary new];
+		_runningSinceDatesByTaskID = [NSMutableDictionary new];
+
+		_latencyStatistics = [OCHTTPPipelineLatencyStatistics new];
+
+		_validatorCache = [OCHTTPPipelineValidatorCache new];
+
 		_busyGroup = dispatch_group_create();
 
+		_priorityAgingInterval = 10;
+
+		_coalescingLeaderTaskIDsByKey = [NSMutableDictionary new];
+		_coalescingKeysByLeaderTaskID = [NSMutableDictionary new];
+		_coalescedTasksByLeaderTaskID = [NSMutableDictionary new];
+		_coalescingLeaderTaskIDsByFollowerTaskID = [NSMutableDictionary new];
+
 		// Set backend
 		if (backend == nil)
 		{
@@ -158,6 +191,9 @@
 		// Grab the session identifier for those sessions that have it
 		_urlSessionIdentifier = sessionConfiguration.identifier;
 
+		// Adapt concurrency only where the pipeline controls when requests are running (the system decides that for background sessions)
+		_adaptiveConcurrency = (_urlSessionIdentifier == nil) && [[self classSettingForOCClassSettingsKey:OCHTTPPipelineSettingAdaptiveConcurrency] boolValue];
+
 		// Prepare URL session creation
 		_sessionConfiguration = sessionConfiguration;
 	}
@@ -429,6 +465,11 @@
 		request.downloadRequest = YES;
 	}
 
+	if (request.enqueueDate == nil)
+	{
+		request.enqueueDate = [NSDate new];
+	}
+
 	if ((pipelineTask = [[OCHTTPPipelineTask alloc] initWithRequest:request pipeline:self partition:partitionID]) != nil)
 	{
 		pipelineTask.requestFinal = isFinal;
@@ -513,7 +554,72 @@
 	}
 }
 
+- (void)_cancelTasks:(NSArray<OCHTTPPipelineTask *> *)tasks
+{
+	NSMutableArray<OCHTTPPipelineTask *> *tasksToFinish = [NSMutableArray new];
+	NSMutableArray<OCHTTPPipelineTask *> *runningTasksToUpdate = [NSMutableArray new];
+	NSMutableArray<NSURLSessionTask *> *urlSessionTasksToCancel = [NSMutableArray new];
+
+	if (tasks.count == 0) { return; }
+
+	// Sort tasks by the transition they need - same logic as -_cancelTask:
+	for (OCHTTPPipelineTask *task in tasks)
+	{
+		switch (task.state)
+		{
+			case OCHTTPPipelineTaskStateRunning:
+				if (!task.request.cancelled)
+				{
+					task.request.cancelled = YES;
+					task.request.progress.cancelled = YES;
+
+					if (task.urlSessionTask != nil)
+					{
+						[urlSessionTasksToCancel addObject:task.urlSessionTask];
+						[runningTasksToUpdate addObject:task];
+						break;
+					}
+				}
+
+				// Insta-cancel otherwise
+
+			case OCHTTPPipelineTaskStatePending:
+				[tasksToFinish addObject:task];
+			break;
+
+			case OCHTTPPipelineTaskStateCompleted:
+			break;
+		}
+	}
+
+	OCLogDebug(@"Bulk-cancelling %lu tasks: %lu to finish, %lu running", (unsigned long)tasks.count, (unsigned long)tasksToFinish.count, (unsigned long)runningTasksToUpdate.count);
+
+	// Persist cancellation of running tasks, then cancel their URL session tasks
+	if (runningTasksToUpdate.count > 0)
+	{
+		NSError *backendError;
+
+		if ((backendError = [self.backend updatePipelineTasks:runningTasksToUpdate]) != nil)
+		{
+			OCLogError(@"Error updating cancelled tasks: %@", backendError);
+		}
+
+		for (NSURLSessionTask *urlSessionTask in urlSessionTasksToCancel)
+		{
+			[urlSessionTask cancel];
+		}
+	}
+
+	// Insta-cancel the rest
+	[self _finishTasks:tasksToFinish withError:OCError(OCErrorRequestCancelled)];
+}
+
 - (void)cancelRequestsForPartitionID:(OCHTTPPipelinePartitionID)partitionID queuedOnly:(BOOL)queuedOnly
+{
+	[self cancelRequestsForPartitionID:partitionID groupID:nil queuedOnly:queuedOnly];
+}
+
+- (void)cancelRequestsForPartitionID:(OCHTTPPipelinePartitionID)partitionID groupID:(nullable OCHTTPRequestGroupID)groupID queuedOnly:(BOOL)queuedOnly
 {
 	// Check pipeline state
 	@synchronized(self)
@@ -527,20 +633,19 @@
 
 	[self queueInline:^{
 		NSMutableArray <OCHTTPPipelineTask *> *tasksToCancel = [NSMutableArray new];
+		NSError *enumerationError;
 
-		[self.backend enumerateTasksForPipeline:self partition:partitionID enumerator:^(OCHTTPPipelineTask *task, BOOL *stop) {
-			if (queuedOnly && (task.state!=OCHTTPPipelineTaskStatePending))
-			{
-				return;
-			}
-
+		// Only fetch the tasks that can still be cancelled (uses the partition/group indexes)
+		enumerationError = [self.backend enumerateUnfinishedTasksForPipeline:self partition:partitionID group:groupID pendingOnly:queuedOnly enumerator:^(OCHTTPPipelineTask *task, BOOL *stop) {
 			[tasksToCancel addObject:task];
 		}];
 
-		for (OCHTTPPipelineTask *task in tasksToCancel)
+		if (enumerationError != nil)
 		{
-			[self _cancelTask:task];
+			OCLogError(@"Error enumerating requests: %@", enumerationError);
 		}
+
+		[self _cancelTasks:tasksToCancel];
 	}];
 }
 
@@ -573,7 +678,10 @@
 			- any number of requests can be running for the default group at the same time
 			- any spots remaining after fair scheduling are filled with requests from the default group
 			- requests with a higher priority are scheduled sooner
+		- interactive requests are scheduled before requests of any other priority class, remaining slots are shared between the other priority classes weighted by class and waiting time
 		- requests are only considered for scheduling if a partitionHandler is attached for them - or they have the .requestFinal flag set
+		- coalescable requests identical to an already scheduled request are not scheduled, but receive a copy of that request's response
+		- if .adaptiveConcurrency is enabled, the number of running requests per host doesn't exceed the limit of the host's concurrency controller
 	*/
 
 	@synchronized(self)
@@ -617,6 +725,9 @@
 	// Enumerate tasks in pipeline and pick ones for scheduling
 	__block NSMutableDictionary <OCHTTPRequestGroupID, NSMutableArray<OCHTTPPipelineTask *> *> *schedulableTasksByGroupID = [NSMutableDictionary new];
 	__block NSMutableSet <OCHTTPRequestGroupID> *blockedGroupIDs = [NSMutableSet new];
+	NSMutableSet <OCHTTPPipelineTaskID> *existingTaskIDs = [NSMutableSet new];
+	NSMutableDictionary <NSString *, NSNumber *> *runningRequestCountsByHostname = [NSMutableDictionary new];
+	BOOL adaptiveConcurrency = _adaptiveConcurrency;
 	const OCHTTPRequestGroupID defaultGroupID = @"_default_";
 	NSError *enumerationError;
 
@@ -625,6 +736,22 @@
 		OCHTTPPipelinePartitionID partitionID = nil;
 		id<OCHTTPPipelinePartitionHandler> partitionHandler = nil;
 
+		if (task.taskID != nil)
+		{
+			[existingTaskIDs addObject:task.taskID];
+		}
+
+		// Count running requests per host
+		if (adaptiveConcurrency && (task.state == OCHTTPPipelineTaskStateRunning))
+		{
+			NSString *hostname;
+
+			if ((hostname = task.request.url.host) != nil)
+			{
+				runningRequestCountsByHostname[hostname] = @(runningRequestCountsByHostname[hostname].unsignedIntegerValue + 1);
+			}
+		}
+
 		// Check if a partitionHandler is attached for this task - or if the task is deemed final and can be scheduled without
 		if ((partitionID = task.partitionID) == nil)
 		{
@@ -701,6 +828,12 @@
 						NSMutableArray <OCHTTPPipelineTask *> *schedulableTasks = nil;
 						BOOL schedule = YES;
 
+						// Skip tasks waiting for the response of an identical request
+						if ((task.taskID != nil) && (self->_coalescingLeaderTaskIDsByFollowerTaskID[task.taskID] != nil))
+						{
+							return;
+						}
+
 						// Check signal availability
 						{
 							NSError *failWithError = nil;
@@ -761,6 +894,12 @@
 
 						if (schedule)
 						{
+							if ([self _attachTaskToCoalescingLeader:task])
+							{
+								// Task will receive the response of an identical request
+								return;
+							}
+
 							if ((schedulableTasks = schedulableTasksByGroupID[taskGroupID]) == nil)
 							{
 								// First pending task with this taskGroupID
@@ -809,6 +948,13 @@
 	{
 		OCLogError(@"Error enumerating tasks during scheduling: enumerationError=%@", enumerationError);
 	}
+	else
+	{
+		// Release leaders and drop followers that are no longer around (f.ex. because their partition was destroyed)
+		[self _pruneCoalescingStateWithExistingTaskIDs:existingTaskIDs];
+	}
+
+	_runningRequestCountsByHostname = runningRequestCountsByHostname;
 
 	// OCLogVerbose(@"Scheduler state: schedulableTasksByGroupID=%@, blockedGroupIDs=%@, remainingSlots=%d, recentlyScheduledGroupIDs=%@", schedulableTasksByGroupID, blockedGroupIDs, remainingSlots, _recentlyScheduledGroupIDs);
 
@@ -885,6 +1031,34 @@
 
 		// OCLogVerbose(@"scheduleTasks=%@", scheduleTasks);
 
+		// Order by priority class (the fair queuing state is only advanced for tasks that actually get scheduled, below)
+		[self _orderTasksByPriorityClass:scheduleTasks];
+
+		// Drop tasks for hosts that have reached their concurrency limit
+		if (adaptiveConcurrency)
+		{
+			NSMutableDictionary <NSString *, NSNumber *> *inFlightCountsByHostname = [runningRequestCountsByHostname mutableCopy];
+
+			[scheduleTasks filterUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(OCHTTPPipelineTask *task, NSDictionary<NSString *,id> * _Nullable bindings) {
+				NSString *hostname;
+				NSUInteger inFlightCount;
+
+				if ((hostname = task.request.url.host) == nil)
+				{
+					return (YES);
+				}
+
+				if ((inFlightCount = inFlightCountsByHostname[hostname].unsignedIntegerValue) >= [self concurrencyControllerForHostname:hostname].limit)
+				{
+					return (NO);
+				}
+
+				inFlightCountsByHostname[hostname] = @(inFlightCount + 1);
+
+				return (YES);
+			}]];
+		}
+
 		// Reduce to maximum of remainingSlots
 		if (scheduleTasks.count > remainingSlots)
 		{
@@ -913,11 +1087,154 @@
 		// Schedule tasks
 		for (OCHTTPPipelineTask *task in scheduleTasks)
 		{
+			if (adaptiveConcurrency)
+			{
+				NSString *hostname;
+
+				if ((hostname = task.request.url.host) != nil)
+				{
+					runningRequestCountsByHostname[hostname] = @(runningRequestCountsByHostname[hostname].unsignedIntegerValue + 1);
+				}
+			}
+
+			[self _chargePriorityClassForScheduledTask:task];
+
 			[self _scheduleTask:task];
 		}
 	}
 }
 
+- (OCHTTPRequestPriorityClass)_priorityClassForTask:(OCHTTPPipelineTask *)task
+{
+	OCHTTPRequestPriorityClass priorityClass = task.request.priorityClass;
+
+	if ((priorityClass < OCHTTPRequestPriorityClassBackground) || (priorityClass > OCHTTPRequestPriorityClassInteractive))
+	{
+		priorityClass = OCHTTPRequestPriorityClassUtility;
+	}
+
+	// Coalescing leaders are scheduled with the highest class of the requests waiting for their response
+	if (task.taskID != nil)
+	{
+		for (OCHTTPPipelineTask *followerTask in _coalescedTasksByLeaderTaskID[task.taskID])
+		{
+			OCHTTPRequestPriorityClass followerPriorityClass = followerTask.request.priorityClass;
+
+			if ((followerPriorityClass > priorityClass) && (followerPriorityClass <= OCHTTPRequestPriorityClassInteractive))
+			{
+				priorityClass = followerPriorityClass;
+			}
+		}
+	}
+
+	return (priorityClass);
+}
+
+- (void)_chargePriorityClassForScheduledTask:(OCHTTPPipelineTask *)task
+{
+	OCHTTPRequestPriorityClass priorityClass = [self _priorityClassForTask:task];
+	double startTag;
+
+	if (priorityClass == OCHTTPRequestPriorityClassInteractive)
+	{
+		// Interactive requests are not part of fair queuing
+		return;
+	}
+
+	startTag = MAX(_priorityClassVirtualTime, _priorityClassFinishTags[priorityClass]);
+
+	_priorityClassVirtualTime = startTag;
+	_priorityClassFinishTags[priorityClass] = startTag + (1.0 / OCHTTPPipelinePriorityClassWeights[priorityClass]);
+}
+
+- (void)_orderTasksByPriorityClass:(NSMutableArray<OCHTTPPipelineTask *> *)tasks
+{
+	/*
+		- interactive requests go first
+		- slots for the remaining classes are handed out by start-time fair queuing: every class has a start tag, the class with
+		  the lowest start tag gets the next slot, after which its tag advances by 1/weight - so that user-initiated requests get
+		  four and utility requests two slots for every slot of background requests
+		- the waiting time of a class' next request lowers its start tag by one slot per .priorityAgingInterval, so that requests
+		  of lower classes can't starve
+		- the order of requests within a class (group fairness, request.priority) is preserved
+		- ordering works on a copy of the tags and has no side effects: not every ordered task gets scheduled (concurrency
+		  limits, remaining slots), so the tags are only advanced for scheduled tasks via -_chargePriorityClassForScheduledTask:
+	*/
+	NSMutableArray<OCHTTPPipelineTask *> *tasksByClass[OCHTTPRequestPriorityClassInteractive+1];
+	double finishTags[OCHTTPRequestPriorityClassInteractive+1];
+	double virtualTime = _priorityClassVirtualTime;
+	NSUInteger nonEmptyClassCount = 0;
+	NSDate *now = [NSDate new];
+
+	for (OCHTTPRequestPriorityClass priorityClass=OCHTTPRequestPriorityClassBackground; priorityClass<=OCHTTPRequestPriorityClassInteractive; priorityClass++)
+	{
+		tasksByClass[priorityClass] = [NSMutableArray new];
+		finishTags[priorityClass] = _priorityClassFinishTags[priorityClass];
+	}
+
+	for (OCHTTPPipelineTask *task in tasks)
+	{
+		OCHTTPRequestPriorityClass priorityClass = [self _priorityClassForTask:task];
+
+		if (tasksByClass[priorityClass].count == 0)
+		{
+			nonEmptyClassCount++;
+		}
+
+		[tasksByClass[priorityClass] addObject:task];
+	}
+
+	if (nonEmptyClassCount < 2)
+	{
+		// Nothing to reorder
+		return;
+	}
+
+	[tasks removeAllObjects];
+	[tasks addObjectsFromArray:tasksByClass[OCHTTPRequestPriorityClassInteractive]];
+
+	while (YES)
+	{
+		OCHTTPRequestPriorityClass pickClass = OCHTTPRequestPriorityClassInteractive;
+		double pickStartTag = 0, pickAgedStartTag = 0;
+
+		for (OCHTTPRequestPriorityClass priorityClass=OCHTTPRequestPriorityClassUserInitiated; priorityClass>=OCHTTPRequestPriorityClassBackground; priorityClass--)
+		{
+			OCHTTPPipelineTask *task;
+
+			if ((task = tasksByClass[priorityClass].firstObject) != nil)
+			{
+				double startTag = MAX(virtualTime, finishTags[priorityClass]);
+				double agedStartTag = startTag;
+
+				if ((task.request.enqueueDate != nil) && (_priorityAgingInterval > 0))
+				{
+					agedStartTag -= MAX([now timeIntervalSinceDate:task.request.enqueueDate], 0) / _priorityAgingInterval;
+				}
+
+				if ((pickClass == OCHTTPRequestPriorityClassInteractive) || (agedStartTag < pickAgedStartTag))
+				{
+					pickClass = priorityClass;
+					pickStartTag = startTag;
+					pickAgedStartTag = agedStartTag;
+				}
+			}
+		}
+
+		if (pickClass == OCHTTPRequestPriorityClassInteractive)
+		{
+			// All queues empty
+			break;
+		}
+
+		[tasks addObject:tasksByClass[pickClass].firstObject];
+		[tasksByClass[pickClass] removeObjectAtIndex:0];
+
+		virtualTime = pickStartTag;
+		finishTags[pickClass] = pickStartTag + (1.0 / OCHTTPPipelinePriorityClassWeights[pickClass]);
+	}
+}
+
 - (void)_scheduleTask:(OCHTTPPipelineTask *)task
 {
 	OCHTTPRequest *request = task.request;
@@ -988,10 +1305,31 @@
 				[request setValue:userAgent forHeaderField:OCHTTPHeaderFieldNameUserAgent];
 			}
 
+			// Negotiate compressed transfer
+			if (request.acceptsCompressedResponse && (request.headerFields[OCHTTPHeaderFieldNameAcceptEncoding] == nil))
+			{
+				[request setValue:OCHTTPResponseBodyDecoder.acceptEncodingHeaderValue forHeaderField:OCHTTPHeaderFieldNameAcceptEncoding];
+			}
+
+			// Add validators of a stored response to conditional requests
+			if (request.conditional)
+			{
+				NSString *validatorKey;
+
+				if ((validatorKey = [OCHTTPPipelineValidatorCache keyForRequest:request partitionID:partitionID]) != nil)
+				{
+					[_validatorCache addValidatorsToRequest:request forKey:validatorKey];
+				}
+			}
+
+			// Remember when the request left the queue
+			request.scheduleDate = [NSDate new];
+
 			// Invoke host simulation (if any)
 			if ((partitionHandler!=nil) && [partitionHandler respondsToSelector:@selector(pipeline:partitionID:simulateRequestHandling:completionHandler:)])
 			{
 				createTask = [partitionHandler pipeline:self partitionID:partitionID simulateRequestHandling:request completionHandler:^(OCHTTPResponse * _Nonnull response) {
+					[self _decodeBodyOfSimulatedResponse:response forTask:task];
 					[self finishedTask:task withResponse:response];
 				}];
 			}
@@ -1171,6 +1509,12 @@
 		}
 	}
 
+	// Remember start for latency measurements in case no metrics are provided
+	if (_adaptiveConcurrency && (task.state == OCHTTPPipelineTaskStateRunning) && (task.taskID != nil))
+	{
+		_runningSinceDatesByTaskID[task.taskID] = [NSDate new];
+	}
+
 	// Log request
 	if (OCLogToggleEnabled(OCLogOptionLogRequestsAndResponses) && OCLoggingEnabled())
 	{
@@ -1198,6 +1542,332 @@
 	}
 }
 
+#pragma mark - Request coalescing
+- (OCHTTPRequestCoalescingKey)_coalescingKeyForTask:(OCHTTPPipelineTask *)task
+{
+	OCHTTPRequest *request = task.request;
+	OCHTTPRequestCoalescingKey requestCoalescingKey;
+
+	if (!request.coalescable || (task.taskID == nil) || (task.partitionID == nil))
+	{
+		return (nil);
+	}
+
+	if ((requestCoalescingKey = request.coalescingKey) == nil)
+	{
+		return (nil);
+	}
+
+	// Only coalesce requests that are subject to the same scheduling constraints and whose responses are handled in the same way
+	return ([NSString stringWithFormat:@"%@|%@|%@|%@|%@|%d|%@", task.partitionID, task.bundleID, task.groupID, [[request.requiredSignals.allObjects sortedArrayUsingSelector:@selector(compare:)] componentsJoinedByString:@","], request.requiredCellularSwitch, request.downloadRequest, requestCoalescingKey]);
+}
+
+- (BOOL)_attachTaskToCoalescingLeader:(OCHTTPPipelineTask *)task
+{
+	OCHTTPRequestCoalescingKey coalescingKey;
+	OCHTTPPipelineTaskID leaderTaskID;
+	NSMutableArray<OCHTTPPipelineTask *> *followerTasks;
+
+	if ((task.taskID == nil) || (_coalescingKeysByLeaderTaskID[task.taskID] != nil))
+	{
+		// Task is already the leader for its key
+		return (NO);
+	}
+
+	if ((coalescingKey = [self _coalescingKeyForTask:task]) == nil)
+	{
+		// Task can't be coalesced
+		return (NO);
+	}
+
+	if ((leaderTaskID = _coalescingLeaderTaskIDsByKey[coalescingKey]) == nil)
+	{
+		// First task with this key => make it the leader
+		_coalescingLeaderTaskIDsByKey[coalescingKey] = task.taskID;
+		_coalescingKeysByLeaderTaskID[task.taskID] = coalescingKey;
+
+		return (NO);
+	}
+
+	// Identical request already scheduled => attach as follower
+	if ((followerTasks = _coalescedTasksByLeaderTaskID[leaderTaskID]) == nil)
+	{
+		followerTasks = [NSMutableArray new];
+		_coalescedTasksByLeaderTaskID[leaderTaskID] = followerTasks;
+	}
+
+	[followerTasks addObject:task];
+	_coalescingLeaderTaskIDsByFollowerTaskID[task.taskID] = leaderTaskID;
+
+	OCLogDebug(@"Coalescing taskID=%@, requestID=%@ with leader taskID=%@", task.taskID, task.requestID, leaderTaskID);
+
+	return (YES);
+}
+
+- (void)_detachCoalescedTaskID:(OCHTTPPipelineTaskID)taskID
+{
+	OCHTTPPipelineTaskID leaderTaskID;
+
+	if ((taskID != nil) && ((leaderTaskID = _coalescingLeaderTaskIDsByFollowerTaskID[taskID]) != nil))
+	{
+		NSMutableArray<OCHTTPPipelineTask *> *followerTasks = _coalescedTasksByLeaderTaskID[leaderTaskID];
+
+		[followerTasks removeObjectsAtIndexes:[followerTasks indexesOfObjectsPassingTest:^BOOL(OCHTTPPipelineTask *followerTask, NSUInteger idx, BOOL *stop) {
+			return ([followerTask.taskID isEqual:taskID]);
+		}]];
+
+		if (followerTasks.count == 0)
+		{
+			[_coalescedTasksByLeaderTaskID removeObjectForKey:leaderTaskID];
+		}
+
+		[_coalescingLeaderTaskIDsByFollowerTaskID removeObjectForKey:taskID];
+	}
+}
+
+- (NSArray<OCHTTPPipelineTask *> *)_releaseCoalescingLeaderTaskID:(OCHTTPPipelineTaskID)leaderTaskID
+{
+	OCHTTPRequestCoalescingKey coalescingKey;
+	NSArray<OCHTTPPipelineTask *> *followerTasks;
+
+	if ((coalescingKey = _coalescingKeysByLeaderTaskID[leaderTaskID]) != nil)
+	{
+		[_coalescingLeaderTaskIDsByKey removeObjectForKey:coalescingKey];
+		[_coalescingKeysByLeaderTaskID removeObjectForKey:leaderTaskID];
+	}
+
+	if ((followerTasks = _coalescedTasksByLeaderTaskID[leaderTaskID]) != nil)
+	{
+		[_coalescedTasksByLeaderTaskID removeObjectForKey:leaderTaskID];
+
+		for (OCHTTPPipelineTask *followerTask in followerTasks)
+		{
+			[_coalescingLeaderTaskIDsByFollowerTaskID removeObjectForKey:followerTask.taskID];
+		}
+	}
+
+	return (followerTasks);
+}
+
+- (void)_pruneCoalescingStateWithExistingTaskIDs:(NSSet<OCHTTPPipelineTaskID> *)existingTaskIDs
+{
+	BOOL needsScheduling = NO;
+
+	for (OCHTTPPipelineTaskID leaderTaskID in _coalescingKeysByLeaderTaskID.allKeys)
+	{
+		if (![existingTaskIDs containsObject:leaderTaskID])
+		{
+			// Leader is gone without delivering a result => followers need to be scheduled on their own
+			if ([self _releaseCoalescingLeaderTaskID:leaderTaskID].count > 0)
+			{
+				needsScheduling = YES;
+			}
+		}
+	}
+
+	for (OCHTTPPipelineTaskID followerTaskID in _coalescingLeaderTaskIDsByFollowerTaskID.allKeys)
+	{
+		if (![existingTaskIDs containsObject:followerTaskID])
+		{
+			[self _detachCoalescedTaskID:followerTaskID];
+		}
+	}
+
+	if (needsScheduling)
+	{
+		[self setPipelineNeedsScheduling];
+	}
+}
+
+#pragma mark - Content decoding
+- (void)_decodeBodyOfSimulatedResponse:(OCHTTPResponse *)response forTask:(OCHTTPPipelineTask *)task
+{
+	// NSURLSession decodes compressed responses transparently - simulated responses arrive with the body as sent by the "server"
+	OCHTTPRequest *request = task.request;
+	NSData *encodedBody = response.bodyData;
+	OCHTTPResponseBodyDecoder *decoder = nil;
+	NSMutableData *decodedBody = nil;
+	NSError *decodingError = nil;
+
+	if ((response.bodyURL != nil) || (encodedBody == nil))
+	{
+		return;
+	}
+
+	for (NSString *headerFieldName in response.headerFields)
+	{
+		if ([headerFieldName caseInsensitiveCompare:OCHTTPHeaderFieldNameContentEncoding] == NSOrderedSame)
+		{
+			decoder = [OCHTTPResponseBodyDecoder decoderForContentEncoding:response.headerFields[headerFieldName]];
+			break;
+		}
+	}
+
+	if (request.shouldStreamResponse)
+	{
+		// Feed the stream handler in chunks, like NSURLSession would
+		const NSUInteger chunkSize = 64 * 1024;
+
+		task.response = response;
+
+		for (NSUInteger offset = 0; offset < encodedBody.length; offset += chunkSize)
+		{
+			NSData *chunk = [encodedBody subdataWithRange:NSMakeRange(offset, MIN(chunkSize, encodedBody.length - offset))];
+
+			if ((decoder != nil) && ((chunk = [decoder decodeData:chunk error:&decodingError]) == nil))
+			{
+				break;
+			}
+
+			if (chunk.length > 0)
+			{
+				[request handleResponseStreamData:chunk forPipelineTask:task];
+			}
+		}
+
+		if ((decoder != nil) && (decodingError == nil))
+		{
+			NSData *chunk;
+
+			if (((chunk = [decoder finishWithError:&decodingError]) != nil) && (chunk.length > 0))
+			{
+				[request handleResponseStreamData:chunk forPipelineTask:task];
+			}
+		}
+	}
+	else if (decoder != nil)
+	{
+		NSData *decodedData;
+
+		if ((decodedData = [decoder decodeData:encodedBody error:&decodingError]) != nil)
+		{
+			decodedBody = [decodedData mutableCopy];
+
+			if ((decodedData = [decoder finishWithError:&decodingError]) != nil)
+			{
+				[decodedBody appendData:decodedData];
+				response.bodyData = decodedBody;
+			}
+		}
+	}
+
+	if (decodingError != nil)
+	{
+		OCLogError(@"Error decoding %@ response body for %@: %@", decoder.contentEncoding, task.requestID, decodingError);
+		response.httpError = decodingError;
+	}
+}
+
+- (OCHTTPResponse *)_coalescedResponseForTask:(OCHTTPPipelineTask *)task fromResponse:(OCHTTPResponse *)leaderResponse
+{
+	OCHTTPRequest *request = task.request;
+	OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:leaderResponse.httpError];
+
+	if (leaderResponse.httpURLResponse != nil)
+	{
+		response.httpURLResponse = leaderResponse.httpURLResponse;
+	}
+
+	response.date = leaderResponse.date;
+	response.status = leaderResponse.status;
+	response.headerFields = leaderResponse.headerFields;
+	response.error = leaderResponse.error;
+	response.notModified = leaderResponse.notModified;
+
+	response.certificate = leaderResponse.certificate;
+	response.certificateValidationResult = leaderResponse.certificateValidationResult;
+	response.certificateValidationError = leaderResponse.certificateValidationError;
+
+	if (leaderResponse.bodyURL != nil)
+	{
+		// Provide a copy of the downloaded file (cheap on APFS, where the copy is a clone)
+		NSURL *bodyURL = request.downloadedFileURL;
+		BOOL bodyURLIsTemporary = request.downloadedFileIsTemporary;
+		NSError *error = nil;
+
+		if (bodyURL == nil)
+		{
+			bodyURL = [self _URLForPartitionID:task.partitionID requestID:task.requestID];
+			bodyURLIsTemporary = YES;
+		}
+
+		if ([bodyURL.path isEqual:leaderResponse.bodyURL.path])
+		{
+			// Same download destination => nothing to copy, cleanup is left to the leader
+			response.bodyURL = bodyURL;
+			response.bodyURLIsTemporary = NO;
+		}
+		else if (bodyURL != nil)
+		{
+			NSURL *parentURL = bodyURL.URLByDeletingLastPathComponent;
+
+			if (![[NSFileManager defaultManager] fileExistsAtPath:parentURL.path])
+			{
+				[[NSFileManager defaultManager] createDirectoryAtURL:parentURL withIntermediateDirectories:YES attributes:@{ NSFileProtectionKey : NSFileProtectionCompleteUntilFirstUserAuthentication } error:NULL];
+			}
+
+			if ([[NSFileManager defaultManager] fileExistsAtPath:bodyURL.path])
+			{
+				[[NSFileManager defaultManager] removeItemAtURL:bodyURL error:NULL];
+			}
+
+			[[NSFileManager defaultManager] copyItemAtURL:leaderResponse.bodyURL toURL:bodyURL error:&error];
+
+			OCFileOpLog(@"cp", error, @"Copied coalesced response body %@ from %@ to %@", OCLogPrivate(request.url), leaderResponse.bodyURL.path, bodyURL.path);
+
+			if (error == nil)
+			{
+				response.bodyURL = bodyURL;
+				response.bodyURLIsTemporary = bodyURLIsTemporary;
+			}
+			else if (response.httpError == nil)
+			{
+				response.httpError = error;
+			}
+		}
+	}
+	else if (leaderResponse.bodyData != nil)
+	{
+		[response appendDataToResponseBody:leaderResponse.bodyData];
+	}
+
+	return (response);
+}
+
+- (void)_deliverResponseOfCoalescingLeader:(OCHTTPPipelineTask *)leaderTask
+{
+	NSArray<OCHTTPPipelineTask *> *followerTasks;
+
+	if ((leaderTask.taskID == nil) || (_coalescingKeysByLeaderTaskID[leaderTask.taskID] == nil))
+	{
+		return;
+	}
+
+	if ((followerTasks = [self _releaseCoalescingLeaderTaskID:leaderTask.taskID]).count == 0)
+	{
+		return;
+	}
+
+	if (leaderTask.request.cancelled)
+	{
+		// Only the leader was cancelled, not its followers => schedule them on their own
+		OCLogDebug(@"Coalescing leader taskID=%@ cancelled - rescheduling %lu followers", leaderTask.taskID, (unsigned long)followerTasks.count);
+
+		[self setPipelineNeedsScheduling];
+		return;
+	}
+
+	for (OCHTTPPipelineTask *followerTask in followerTasks)
+	{
+		OCLogDebug(@"Delivering response of coalescing leader taskID=%@ to taskID=%@, requestID=%@", leaderTask.taskID, followerTask.taskID, followerTask.requestID);
+
+		// Followers were never scheduled => generate .effectiveURL
+		[followerTask.request prepareForScheduling];
+
+		[self _finishedTask:followerTask withResponse:[self _coalescedResponseForTask:followerTask fromResponse:leaderTask.response]];
+	}
+}
+
 #pragma mark - Request result handling
 - (void)finishedTask:(OCHTTPPipelineTask *)task withResponse:(OCHTTPResponse *)response
 {
@@ -1208,11 +1878,99 @@
 }
 
 - (void)_finishedTask:(OCHTTPPipelineTask *)task withResponse:(OCHTTPResponse *)response
+{
+	if (![self _completeTask:task withResponse:response])
+	{
+		return;
+	}
+
+	// Update task in backend
+	[self.backend updatePipelineTask:task];
+
+	// Log response
+	[self _logResponseForTask:task];
+
+	// Attempt delivery
+	[self _deliverResultForTask:task];
+}
+
+- (void)_finishTasks:(NSArray<OCHTTPPipelineTask *> *)tasks withError:(NSError *)error
+{
+	NSMutableArray<OCHTTPPipelineTask *> *completedTasks = [[NSMutableArray alloc] initWithCapacity:tasks.count];
+	NSError *backendError;
+
+	if (tasks.count == 0) { return; }
+
+	for (OCHTTPPipelineTask *task in tasks)
+	{
+		if ([self _completeTask:task withResponse:[OCHTTPResponse responseWithRequest:task.request HTTPError:error]])
+		{
+			[completedTasks addObject:task];
+		}
+	}
+
+	// Persist all state transitions in a single transaction
+	if ((backendError = [self.backend updatePipelineTasks:completedTasks]) != nil)
+	{
+		OCLogError(@"Error updating %lu finished tasks: %@", (unsigned long)completedTasks.count, backendError);
+	}
+
+	// Deliver results - and commit the resulting removals from the backend all at once
+	[self queueBlock:^{
+		NSArray<OCHTTPPipelineTask *> *removedTasks;
+		NSError *removalError;
+
+		// Result and partition handlers run outside of any transaction - only the removals of the delivered tasks' rows are collected ..
+		self->_deferredTaskRemovals = [NSMutableArray new];
+
+		for (OCHTTPPipelineTask *task in completedTasks)
+		{
+			[self _logResponseForTask:task];
+			[self _deliverResultForTask:task];
+		}
+
+		removedTasks = self->_deferredTaskRemovals;
+		self->_deferredTaskRemovals = nil;
+
+		// .. and committed in a single transaction afterwards
+		if (removedTasks.count > 0)
+		{
+			if ((removalError = [self.backend performBatchUpdates:^NSError * _Nullable{
+				for (OCHTTPPipelineTask *task in removedTasks)
+				{
+					NSError *error;
+
+					if ((error = [self.backend removePipelineTask:task]) != nil)
+					{
+						return (error);
+					}
+				}
+
+				return (nil);
+			}]) != nil)
+			{
+				// Batch rolled back => results have already been delivered, so remove the rows one by one
+				OCLogError(@"Error removing %lu delivered tasks in batch, removing individually: %@", (unsigned long)removedTasks.count, removalError);
+
+				for (OCHTTPPipelineTask *task in removedTasks)
+				{
+					[self.backend removePipelineTask:task];
+				}
+			}
+
+			[self _triggerPartitionEmptyHandlers];
+		}
+
+		[self setPipelineNeedsScheduling];
+	}];
+}
+
+- (BOOL)_completeTask:(OCHTTPPipelineTask *)task withResponse:(OCHTTPResponse *)response
 {
 	OCHTTPRequest *request = task.request;
 
-	if (task==nil) { return; }
-	if (request==nil) { return; }
+	if (task==nil) { return (NO); }
+	if (request==nil) { return (NO); }
 
 	if (task.finished)
 	{
@@ -1221,6 +1979,9 @@
 
 	task.finished = YES;
 
+	// Finished on its own (f.ex. cancelled) => no longer wait for the response of an identical request
+	[self _detachCoalescedTaskID:task.taskID];
+
 	// Extract & store cookies from response
 	if (task.partitionID != nil)
 	{
@@ -1290,11 +2051,34 @@
 		OCLogWarning(@"Existing response for %@ overwritten: %@ replaces %@", task.requestID, [response responseDescriptionPrefixed:NO], [task.response responseDescriptionPrefixed:NO]);
 	}
 
+	// Let the host's concurrency controller learn from the outcome
+	if (task.state == OCHTTPPipelineTaskStateRunning)
+	{
+		[self _recordConcurrencyOutcomeForTask:task response:response];
+	}
+
+	// Record traffic
+	[_trafficRecorder pipeline:self recordFinishedTask:task withResponse:response];
+
+	// Store validators of / fill in the body of 304 responses to conditional requests
+	if (task.request.conditional)
+	{
+		NSString *validatorKey;
+
+		if ((validatorKey = [OCHTTPPipelineValidatorCache keyForRequest:task.request partitionID:task.partitionID]) != nil)
+		{
+			[_validatorCache updateWithResponse:response forKey:validatorKey];
+		}
+	}
+
 	task.response = response;
 	task.state = OCHTTPPipelineTaskStateCompleted;
-	[self.backend updatePipelineTask:task];
 
-	// Log response
+	return (YES);
+}
+
+- (void)_logResponseForTask:(OCHTTPPipelineTask *)task
+{
 	if (OCLogToggleEnabled(OCLogOptionLogRequestsAndResponses) && OCLoggingEnabled())
 	{
 		BOOL prefixedLogging = [[OCLogger classSettingForOCClassSettingsKey:OCClassSettingsKeyLogSingleLined] boolValue];
@@ -1305,9 +2089,6 @@
 		OCTLogDebug([extraTags arrayByAddingObject:@"HTSum"], @"<- %lu %@ (%@ %@)%@", (unsigned long)task.response.status.code, task.response.status.name, task.request.method, task.request.effectiveURL, ((task.response.redirectURL != nil) ? [NSString stringWithFormat:@" -> %@ ",task.response.redirectURL] : @""));
 		OCPFMLogDebug(OCLogOptionLogRequestsAndResponses, extraTags, @"Received response:\n%@# RESPONSE --------------------------------------------------------\n%@Method:      %@\n%@URL:         %@\n%@Request-ID:  %@%@\n%@Error:       %@\n%@Req Signals: %@\n%@- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -\n%@-----------------------------------------------------------------", infoPrefix, infoPrefix, task.request.method, infoPrefix, task.request.effectiveURL, infoPrefix, task.request.identifier, ((task.request.headerFields[OCHTTPHeaderFieldNameOriginalRequestID] != nil) ? (![task.request.headerFields[OCHTTPHeaderFieldNameOriginalRequestID] isEqual:task.request.identifier] ? [NSString stringWithFormat:@" (original: %@)", task.request.headerFields[OCHTTPHeaderFieldNameOriginalRequestID]] : @"") : @""), infoPrefix, errorDescription, infoPrefix, [task.request.requiredSignals.allObjects componentsJoinedByString:@", "], infoPrefix, [task.response responseDescriptionPrefixed:prefixedLogging]);
 	}
-
-	// Attempt delivery
-	[self _deliverResultForTask:task];
 }
 
 - (BOOL)_deliverResultForTask:(OCHTTPPipelineTask *)task
@@ -1444,6 +2225,10 @@
 		if (requestInstruction == OCHTTPRequestInstructionDeliver)
 		{
 			BOOL undeliverable = YES;
+			NSTimeInterval deliveryStartTime = NSDate.timeIntervalSinceReferenceDate;
+
+			// Deliver copies of the response to requests coalesced with this one (before the result handler gets a chance to move or remove the body file)
+			[self _deliverResponseOfCoalescingLeader:task];
 
 			// Deliver Finished Request
 			if (task.request.resultHandlerAction != NULL)
@@ -1478,6 +2263,10 @@
 				OCLogError(@"Response for requestID=%@ is undeliverable - removing undelivered", task.requestID);
 				removeTask = YES;
 			}
+			else
+			{
+				[self _recordLatencyForTask:task postProcessingDuration:(NSDate.timeIntervalSinceReferenceDate - deliveryStartTime)];
+			}
 		}
 
 		// Remove temporarily downloaded files
@@ -1533,8 +2322,16 @@
 				OCLogVerbose(@"Removing request %@ [%@] with taskIdentifier <%@>", OCLogPrivate(task.request.url), task.request.identifier, task.urlSessionTaskID);
 			}
 
-			[self.backend removePipelineTask:task];
-			[self _triggerPartitionEmptyHandlers];
+			if (_deferredTaskRemovals != nil)
+			{
+				// Removal is committed together with those of other tasks delivered in the same batch (see -_finishTasks:withError:)
+				[_deferredTaskRemovals addObject:task];
+			}
+			else
+			{
+				[self.backend removePipelineTask:task];
+				[self _triggerPartitionEmptyHandlers];
+			}
 		}
 
 		// Remove from tasks in delivery
@@ -1852,11 +2649,12 @@
 {
 	[self queueBlock:^{
 		// Find and cancel non-critical requests
+		NSMutableArray <OCHTTPPipelineTask *> *tasksToCancel = [NSMutableArray new];
 		NSError *enumerationError = [self.backend enumerateTasksForPipeline:self enumerator:^(OCHTTPPipelineTask *task, BOOL *stop) {
 			if (((partitionID==nil) || ((partitionID!=nil) && [task.partitionID isEqual:partitionID])) && task.request.isNonCritial)
 			{
 				OCLogVerbose(@"Cancelling non-critical task %@", task.taskID);
-				[self _cancelTask:task];
+				[tasksToCancel addObject:task];
 			}
 		}];
 
@@ -1864,16 +2662,19 @@
 		{
 			OCLogError(@"Error enumerating requests: %@", enumerationError);
 		}
+
+		[self _cancelTasks:tasksToCancel];
 	}];
 }
 
 - (void)finishPendingRequestsForPartitionID:(OCHTTPPipelinePartitionID)partitionID withError:(NSError *)error filter:(BOOL(^)(OCHTTPPipeline *pipeline, OCHTTPPipelineTask *task))filter
 {
 	[self queueInline:^{
+		NSMutableArray <OCHTTPPipelineTask *> *tasksToFinish = [NSMutableArray new];
 		NSError *enumerationError = [self.backend enumerateTasksForPipeline:self partition:partitionID enumerator:^(OCHTTPPipelineTask *task, BOOL *stop) {
 			if (filter(self, task))
 			{
-				[self finishedTask:task withResponse:[OCHTTPResponse responseWithRequest:task.request HTTPError:error]];
+				[tasksToFinish addObject:task];
 			}
 		}];
 
@@ -1881,6 +2682,8 @@
 		{
 			OCLogError(@"Error enumerating requests: %@", enumerationError);
 		}
+
+		[self _finishTasks:tasksToFinish withError:error];
 	}];
 }
 
@@ -2523,6 +3326,126 @@
 	return (nil);
 }
 
+#pragma mark - Concurrency control
+- (OCHTTPPipelineConcurrencyController *)concurrencyControllerForHostname:(NSString *)hostname
+{
+	OCHTTPPipelineConcurrencyController *concurrencyController;
+
+	@synchronized(_concurrencyControllersByHostname)
+	{
+		if ((concurrencyController = _concurrencyControllersByHostname[hostname]) == nil)
+		{
+			NSInteger initialLimit = _sessionConfiguration.HTTPMaximumConnectionsPerHost;
+			NSUInteger maximumLimit = [[self classSettingForOCClassSettingsKey:OCHTTPPipelineSettingAdaptiveConcurrencyMaximum] unsignedIntegerValue];
+
+			concurrencyController = [[OCHTTPPipelineConcurrencyController alloc] initWithHostname:hostname initialLimit:((initialLimit > 0) ? (NSUInteger)initialLimit : 4) minimumLimit:1 maximumLimit:((maximumLimit > 0) ? maximumLimit : 32)];
+
+			_concurrencyControllersByHostname[hostname] = concurrencyController;
+		}
+	}
+
+	return (concurrencyController);
+}
+
+- (void)_recordConcurrencyOutcomeForTask:(OCHTTPPipelineTask *)task response:(OCHTTPResponse *)response
+{
+	NSString *hostname = task.request.url.host;
+	NSNumber *latency = nil;
+	NSDate *runningSinceDate = nil;
+	NSUInteger inFlightCount;
+
+	if (task.taskID != nil)
+	{
+		runningSinceDate = _runningSinceDatesByTaskID[task.taskID];
+		[_runningSinceDatesByTaskID removeObjectForKey:task.taskID];
+	}
+
+	if (!_adaptiveConcurrency || (hostname == nil))
+	{
+		return;
+	}
+
+	// Update count of running requests until the next scheduling run
+	inFlightCount = _runningRequestCountsByHostname[hostname].unsignedIntegerValue;
+
+	if (inFlightCount > 0)
+	{
+		_runningRequestCountsByHostname[hostname] = @(inFlightCount - 1);
+	}
+
+	// Cancellations say nothing about the host
+	if (task.request.cancelled || ([response.httpError.domain isEqual:NSURLErrorDomain] && (response.httpError.code == NSURLErrorCancelled)))
+	{
+		return;
+	}
+
+	// Prefer the time to the first response byte (independent of transfer size) - and fall back to the total duration (f.ex. for simulated requests)
+	if (((latency = task.metrics.serverProcessingTimeInterval) == nil) && (runningSinceDate != nil))
+	{
+		latency = @(-runningSinceDate.timeIntervalSinceNow);
+	}
+
+	[[self concurrencyControllerForHostname:hostname] recordResponseWithStatus:response.status error:response.httpError latency:latency inFlight:inFlightCount category:[self _concurrencyCategoryForRequest:task.request]];
+}
+
+- (OCHTTPPipelineConcurrencyCategory)_concurrencyCategoryForRequest:(OCHTTPRequest *)request
+{
+	// Requests whose latency is comparable: PROPFINDs, small GETs (f.ex. thumbnails), downloads and uploads all have typical latencies of their own
+	if (request.downloadRequest)
+	{
+		return ([request.method stringByAppendingString:@"-download"]);
+	}
+
+	if (request.bodyURL != nil)
+	{
+		return ([request.method stringByAppendingString:@"-upload"]);
+	}
+
+	return (request.method);
+}
+
+#pragma mark - Latency statistics
+- (void)_recordLatencyForTask:(OCHTTPPipelineTask *)task postProcessingDuration:(NSTimeInterval)postProcessingDuration
+{
+	NSMutableDictionary<OCHTTPRequestPhase, NSNumber *> *durationsByPhase = [NSMutableDictionary new];
+	OCHTTPRequest *request = task.request;
+	OCHTTPPipelineTaskMetrics *metrics = task.metrics;
+	NSDate *enqueueDate = request.enqueueDate, *scheduleDate = request.scheduleDate;
+
+	if ((enqueueDate != nil) && (scheduleDate != nil))
+	{
+		durationsByPhase[OCHTTPRequestPhaseQueueWait] = @([scheduleDate timeIntervalSinceDate:enqueueDate]);
+	}
+
+	if ((scheduleDate != nil) && (metrics.date != nil))
+	{
+		durationsByPhase[OCHTTPRequestPhaseSchedulingDelay] = @([metrics.date timeIntervalSinceDate:scheduleDate]);
+	}
+
+	// Connection setup (only present for requests that didn't reuse a connection)
+	durationsByPhase[OCHTTPRequestPhaseDNS] = metrics.dnsTimeInterval;
+	durationsByPhase[OCHTTPRequestPhaseTLS] = metrics.secureConnectionTimeInterval;
+
+	if (metrics.connectTimeInterval != nil)
+	{
+		durationsByPhase[OCHTTPRequestPhaseConnect] = @(metrics.connectTimeInterval.doubleValue - metrics.secureConnectionTimeInterval.doubleValue);
+	}
+
+	// Server and transfer
+	durationsByPhase[OCHTTPRequestPhaseTimeToFirstByte] = metrics.timeToFirstByteInterval;
+	durationsByPhase[OCHTTPRequestPhaseTransfer] = metrics.responseReceiveTimeInterval;
+
+	// Pipeline and result handler
+	durationsByPhase[OCHTTPRequestPhasePostProcessing] = @(postProcessingDuration);
+
+	if (enqueueDate != nil)
+	{
+		durationsByPhase[OCHTTPRequestPhaseTotal] = @(-enqueueDate.timeIntervalSinceNow);
+	}
+
+	[_latencyStatistics recordPhaseDurations:durationsByPhase forCategory:[OCHTTPPipelineLatencyStatistics categoryForRequest:request]];
+}
+
 #pragma mark - Progress
 - (nullable NSProgress *)progressForRequestID:(OCHTTPRequestID)requestID
 {
@@ -2547,7 +3470,9 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCHTTPPipeline)
 + (NSDictionary<NSString *,id> *)defaultSettingsForIdentifier:(OCClassSettingsIdentifier)identifier
 {
 	return (@{
-		OCHTTPPipelineSettingUserAgent : @"ownCloudApp/{{app.version}} ({{app.part}}/{{app.build}}; {{os.name}}/{{os.version}}; {{device.model}})"
+		OCHTTPPipelineSettingUserAgent : @"ownCloudApp/{{app.version}} ({{app.part}}/{{app.build}}; {{os.name}}/{{os.version}}; {{device.model}})",
+		OCHTTPPipelineSettingAdaptiveConcurrency : @(YES),
+		OCHTTPPipelineSettingAdaptiveConcurrencyMaximum : @(32)
 	});
 }
 
@@ -2561,6 +3486,20 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCHTTPPipeline)
 			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusSupported,
 			OCClassSettingsMetadataKeyCategory	: @"Connection",
 		},
+
+		OCHTTPPipelineSettingAdaptiveConcurrency : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeBoolean,
+			OCClassSettingsMetadataKeyDescription 	: @"Adapt the number of concurrent requests per host to the observed latency, timeouts and 429/503 responses (foreground connections only).",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection",
+		},
+
+		OCHTTPPipelineSettingAdaptiveConcurrencyMaximum : @{
+			OCClassSettingsMetadataKeyType 		: OCClassSettingsMetadataTypeInteger,
+			OCClassSettingsMetadataKeyDescription 	: @"Maximum number of concurrent requests per host the adaptive concurrency control may allow.",
+			OCClassSettingsMetadataKeyStatus	: OCClassSettingsKeyStatusAdvanced,
+			OCClassSettingsMetadataKeyCategory	: @"Connection",
+		},
 	});
 }
 
@@ -2635,3 +3574,5 @@ INCLUDE_IN_CLASS_SETTINGS_SNAPSHOTS(OCHTTPPipeline)
 
 OCClassSettingsIdentifier OCClassSettingsIdentifierHTTP = @"http";
 OCClassSettingsKey OCHTTPPipelineSettingUserAgent = @"user-agent";
+OCClassSettingsKey OCHTTPPipelineSettingAdaptiveConcurrency = @"adaptive-concurrency";
+OCClassSettingsKey OCHTTPPipelineSettingAdaptiveConcurrencyMaximum = @"adaptive-concurrency-maximum";
@@ -51,6 +51,7 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - Task access
 - (NSError *)addPipelineTask:(OCHTTPPipelineTask *)task;
 - (NSError *)updatePipelineTask:(OCHTTPPipelineTask *)task;
+- (NSError *)updatePipelineTasks:(NSArray<OCHTTPPipelineTask *> *)tasks; //!< Updates several tasks in a single transaction
 - (NSError *)removePipelineTask:(OCHTTPPipelineTask *)task;
 
 - (NSError *)removeAllTasksForPipeline:(OCHTTPPipelineID)pipelineID partition:(OCHTTPPipelinePartitionID)partitionID;
@@ -60,6 +61,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSError *)enumerateTasksForPipeline:(OCHTTPPipeline *)pipeline enumerator:(void (^)(OCHTTPPipelineTask * _Nonnull, BOOL * _Nonnull))taskEnumerator;
 - (NSError *)enumerateTasksForPipeline:(OCHTTPPipeline *)pipeline partition:(OCHTTPPipelinePartitionID)partitionID enumerator:(void (^)(OCHTTPPipelineTask * _Nonnull, BOOL * _Nonnull))taskEnumerator;
+- (NSError *)enumerateUnfinishedTasksForPipeline:(OCHTTPPipeline *)pipeline partition:(OCHTTPPipelinePartitionID)partitionID group:(nullable OCHTTPRequestGroupID)groupID pendingOnly:(BOOL)pendingOnly enumerator:(void (^)(OCHTTPPipelineTask * _Nonnull, BOOL * _Nonnull))taskEnumerator; //!< Enumerates pending (and - unless pendingOnly is YES - running) tasks of a partition, optionally limited to a group
 - (NSError *)enumerateCompletedTasksForPipeline:(OCHTTPPipeline *)pipeline partition:(OCHTTPPipelinePartitionID)partitionID enumerator:(void (^)(OCHTTPPipelineTask * _Nonnull, BOOL * _Nonnull))taskEnumerator;
 
 - (NSError *)enumerateTasksWhere:(nullable NSDictionary<NSString *,id<NSObject>> *)whereConditions orderBy:(nullable NSString *)orderBy limit:(nullable NSString *)limit enumerator:(void (^)(OCHTTPPipelineTask * _Nonnull, BOOL * _Nonnull))taskEnumerator;
@@ -67,6 +69,8 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSNumber *)numberOfRequestsWithState:(OCHTTPPipelineTaskState)state inPipeline:(OCHTTPPipeline *)pipeline partition:(nullable OCHTTPPipelinePartitionID)partitionID error:(NSError * _Nullable *)outDBError;
 - (NSNumber *)numberOfRequestsInPipeline:(OCHTTPPipeline *)pipeline partition:(OCHTTPPipelinePartitionID)partitionID error:(NSError * _Nullable *)outDBError;
 
+- (NSError *)performBatchUpdates:(NSError * _Nullable(^)(void))updates; //!< Performs updates in a single transaction. Task access inside updates is committed all at once when updates returns nil - and rolled back otherwise.
+
 #pragma mark - Debugging
 - (void)dumpDBTable;
 
@@ -19,6 +19,7 @@
 #import "OCHTTPPipelineBackend.h"
 #import "OCSQLiteDB.h"
 #import "OCSQLiteTableSchema.h"
+#import "OCSQLiteTransaction.h"
 #import "OCSQLiteQueryCondition.h"
 #import "OCHTTPPipelineTask.h"
 #import "OCMacros.h"
@@ -238,6 +239,31 @@ static NSString *OCHTTPPipelineTasksTableName = @"httpPipelineTasks";
 		openStatements:nil
 		upgradeMigrator:nil]
 	];
+
+	// Version 2
+	[_sqlDB addTableSchema:[OCSQLiteTableSchema
+		schemaWithTableName:OCHTTPPipelineTasksTableName
+		version:2
+		creationQueries:@[
+			// Same table as in version 1
+			@"CREATE TABLE httpPipelineTasks (taskID INTEGER PRIMARY KEY AUTOINCREMENT, pipelineID TEXT NOT NULL, bundleID TEXT NOT NULL, urlSessionID TEXT, urlSessionTaskID INTEGER, partitionID TEXT NOT NULL, groupID TEXT, state INTEGER NOT NULL, requestID TEXT NOT NULL, requestData BLOB NOT NULL, requestFinal INTEGER NOT NULL, responseData BLOB)",
+
+			// Create indexes over partitionID + state, groupID and requestID, so that cancellation, teardown and lookups don't need to scan the whole table
+			@"CREATE INDEX idx_httpPipelineTasks_partition ON httpPipelineTasks (pipelineID, partitionID, state)",
+			@"CREATE INDEX idx_httpPipelineTasks_group ON httpPipelineTasks (pipelineID, partitionID, groupID)",
+			@"CREATE INDEX idx_httpPipelineTasks_requestID ON httpPipelineTasks (requestID)"
+		]
+		openStatements:nil
+		upgradeMigrator:^(OCSQLiteDB *db, OCSQLiteTableSchema *schema, void (^completionHandler)(NSError *error)) {
+			[db executeTransaction:[OCSQLiteTransaction transactionWithQueries:@[
+				[OCSQLiteQuery query:@"CREATE INDEX idx_httpPipelineTasks_partition ON httpPipelineTasks (pipelineID, partitionID, state)" resultHandler:nil],
+				[OCSQLiteQuery query:@"CREATE INDEX idx_httpPipelineTasks_group ON httpPipelineTasks (pipelineID, partitionID, groupID)" resultHandler:nil],
+				[OCSQLiteQuery query:@"CREATE INDEX idx_httpPipelineTasks_requestID ON httpPipelineTasks (requestID)" resultHandler:nil]
+			] type:OCSQLiteTransactionTypeDeferred completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+				completionHandler(error);
+			}]];
+		}]
+	];
 }
 
 #pragma mark - Task access
@@ -300,19 +326,7 @@ static NSString *OCHTTPPipelineTasksTableName = @"httpPipelineTasks";
 
 	return([_sqlDB executeOperationSync:^NSError * _Nullable(OCSQLiteDB * _Nonnull db) {
 		__block NSError *updateError = nil;
-		NSDictionary<NSString *,id<NSObject>> *rowValues = @{
-			@"bundleID" 		: task.bundleID,
-
-			@"urlSessionID" 	: OCSQLiteNullProtect(task.urlSessionID),
-			@"urlSessionTaskID"	: OCSQLiteNullProtect(task.urlSessionTaskID),
-
-			@"state"		: @(task.state),
-
-			@"requestID"		: task.requestID,
-			@"requestData"		: task.requestData,
-
-			@"responseData"		: OCSQLiteNullProtect(task.responseData),
-		};
+		NSDictionary<NSString *,id<NSObject>> *rowValues = [self _rowValuesForUpdatingTask:task];
 
 		OCTLogVerbose(@[@"values"], @"Updating tasks table for taskID=%@: %@", task.taskID, rowValues);
 
@@ -334,6 +348,81 @@ static NSString *OCHTTPPipelineTasksTableName = @"httpPipelineTasks";
 	}]);
 }
 
+- (NSError *)updatePipelineTasks:(NSArray<OCHTTPPipelineTask *> *)tasks
+{
+	OCTLogVerbose(@[@"enter"], @"updatePipelineTasks: %lu tasks", (unsigned long)tasks.count);
+
+	if (tasks.count == 0)
+	{
+		return (nil);
+	}
+
+	for (OCHTTPPipelineTask *task in tasks)
+	{
+		if (task.taskID == nil)
+		{
+			OCTLogError(@[@"leave"], @"updatePipelineTasks: attempt to update task without taskID: task=%@", TaskDescription(task));
+			return (OCError(OCErrorInsufficientParameters));
+		}
+	}
+
+	return([_sqlDB executeOperationSync:^NSError * _Nullable(OCSQLiteDB * _Nonnull db) {
+		__block NSError *updateError = nil;
+
+		// Update all rows in a single transaction, so they're written (and synced) only once
+		[db executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+			__block NSError *queryError = nil;
+
+			for (OCHTTPPipelineTask *task in tasks)
+			{
+				[db executeQuery:[OCSQLiteQuery queryUpdatingRowWithID:task.taskID inTable:OCHTTPPipelineTasksTableName withRowValues:[self _rowValuesForUpdatingTask:task] completionHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error) {
+					queryError = error;
+				}]];
+
+				if (queryError != nil)
+				{
+					OCLogError(@"Error updating task=%@: %@", task, queryError);
+					break;
+				}
+			}
+
+			return (queryError);
+		} type:OCSQLiteTransactionTypeImmediate completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+			updateError = error;
+		}]];
+
+		// Update cache
+		if (updateError == nil)
+		{
+			for (OCHTTPPipelineTask *task in tasks)
+			{
+				[self->_taskCache updateWithTask:task remove:NO];
+			}
+		}
+
+		OCTLogVerbose(@[@"leave"], @"updatePipelineTasks: %lu tasks, error=%@", (unsigned long)tasks.count, updateError);
+
+		return (updateError);
+	}]);
+}
+
+- (NSDictionary<NSString *,id<NSObject>> *)_rowValuesForUpdatingTask:(OCHTTPPipelineTask *)task
+{
+	return (@{
+		@"bundleID" 		: task.bundleID,
+
+		@"urlSessionID" 	: OCSQLiteNullProtect(task.urlSessionID),
+		@"urlSessionTaskID"	: OCSQLiteNullProtect(task.urlSessionTaskID),
+
+		@"state"		: @(task.state),
+
+		@"requestID"		: task.requestID,
+		@"requestData"		: task.requestData,
+
+		@"responseData"		: OCSQLiteNullProtect(task.responseData),
+	});
+}
+
 - (NSError *)removePipelineTask:(OCHTTPPipelineTask *)task
 {
 	OCTLogVerbose(@[@"enter"], @"removePipelineTask: task=%@", TaskDescription(task));
@@ -519,6 +608,23 @@ static NSString *OCHTTPPipelineTasksTableName = @"httpPipelineTasks";
 		} orderBy:@"taskID" limit:nil enumerator:taskEnumerator]);
 }
 
+- (NSError *)enumerateUnfinishedTasksForPipeline:(OCHTTPPipeline *)pipeline partition:(OCHTTPPipelinePartitionID)partitionID group:(nullable OCHTTPRequestGroupID)groupID pendingOnly:(BOOL)pendingOnly enumerator:(void (^)(OCHTTPPipelineTask * _Nonnull, BOOL * _Nonnull))taskEnumerator
+{
+	NSMutableDictionary<NSString *,id<NSObject>> *whereConditions = [NSMutableDictionary new];
+
+	// Conditions match the (pipelineID, partitionID, state) and (pipelineID, partitionID, groupID) indexes
+	whereConditions[@"pipelineID"] = pipeline.identifier;
+	whereConditions[@"partitionID"] = partitionID;
+	whereConditions[@"state"] = pendingOnly ? @(OCHTTPPipelineTaskStatePending) : [OCSQLiteQueryCondition queryConditionWithOperator:@"<" value:@(OCHTTPPipelineTaskStateCompleted) apply:YES];
+
+	if (groupID != nil)
+	{
+		whereConditions[@"groupID"] = groupID;
+	}
+
+	return ([self enumerateTasksWhere:whereConditions orderBy:@"taskID" limit:nil enumerator:taskEnumerator]);
+}
+
 - (NSError *)enumerateCompletedTasksForPipeline:(OCHTTPPipeline *)pipeline partition:(OCHTTPPipelinePartitionID)partitionID enumerator:(void (^)(OCHTTPPipelineTask * _Nonnull, BOOL * _Nonnull))taskEnumerator
 {
 	return ([self enumerateTasksWhere:@{
@@ -631,6 +737,22 @@ static NSString *OCHTTPPipelineTasksTableName = @"httpPipelineTasks";
 	return (numberOfRequests);
 }
 
+- (NSError *)performBatchUpdates:(NSError * _Nullable(^)(void))updates
+{
+	return([_sqlDB executeOperationSync:^NSError * _Nullable(OCSQLiteDB * _Nonnull db) {
+		__block NSError *batchError = nil;
+
+		// Task updates and removals performed inside updates() become part of this transaction (nested transactions are mapped to savepoints)
+		[db executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+			return (updates());
+		} type:OCSQLiteTransactionTypeImmediate completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+			batchError = error;
+		}]];
+
+		return (batchError);
+	}]);
+}
+
 - (BOOL)isOnQueueThread
 {
 	return _sqlDB.isOnSQLiteThread;
@@ -0,0 +1,61 @@
+//
+//  OCHTTPPipelineConcurrencyController.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCHTTPStatus.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Adaptive (AIMD) limit for the number of requests in flight for a host:
+	- additive increase: while the limit is fully used and latency stays close to the observed baseline, the limit grows by about one per round trip
+	- multiplicative decrease: rising latency, timeouts and 429/503 responses shrink the limit - at most once per round trip
+
+	Latency is tracked separately per request category (f.ex. PROPFINDs, thumbnails, downloads), as their typical latencies differ widely. Within a
+	category, a short-term average is compared against a long-term average (the baseline) - so the baseline follows lasting changes rather than
+	sticking to the fastest response ever seen.
+*/
+
+typedef NSString* OCHTTPPipelineConcurrencyCategory; //!< Category of requests with comparable latency
+
+@interface OCHTTPPipelineConcurrencyController : NSObject
+
+@property(strong,readonly) NSString *hostname; //!< The host this controller limits concurrency for
+
+@property(assign) NSUInteger minimumLimit; //!< Lower bound of the limit
+@property(assign) NSUInteger maximumLimit; //!< Upper bound of the limit
+
+@property(readonly,nonatomic) NSUInteger limit; //!< The number of requests currently allowed in flight for the host
+
+@property(strong,readonly,nullable) NSNumber *baselineLatency; //!< Long-term average latency of requests without category (in seconds)
+@property(strong,readonly,nullable) NSNumber *smoothedLatency; //!< Short-term average latency of requests without category (in seconds)
+
+@property(assign) double latencyTolerance; //!< Factor by which the short-term average latency of a category may exceed its baseline before the limit is decreased (default: 2.0)
+@property(assign) double backoffFactor; //!< Factor by which the limit is multiplied on timeouts and 429/503 responses (default: 0.5)
+
+- (instancetype)initWithHostname:(NSString *)hostname initialLimit:(NSUInteger)initialLimit minimumLimit:(NSUInteger)minimumLimit maximumLimit:(NSUInteger)maximumLimit;
+
+- (void)recordResponseWithStatus:(nullable OCHTTPStatus *)status error:(nullable NSError *)error latency:(nullable NSNumber *)latency inFlight:(NSUInteger)inFlight category:(nullable OCHTTPPipelineConcurrencyCategory)category; //!< Adjusts the limit based on the outcome of a request. latency is the time to the first response byte (in seconds), inFlight the number of requests in flight for the host when the request finished, category the category whose latency statistics the latency is compared against.
+- (void)recordResponseWithStatus:(nullable OCHTTPStatus *)status error:(nullable NSError *)error latency:(nullable NSNumber *)latency inFlight:(NSUInteger)inFlight; //!< Same as above, for requests without category
+
+- (nullable NSNumber *)baselineLatencyForCategory:(nullable OCHTTPPipelineConcurrencyCategory)category; //!< Long-term average latency of the category (in seconds)
+- (nullable NSNumber *)smoothedLatencyForCategory:(nullable OCHTTPPipelineConcurrencyCategory)category; //!< Short-term average latency of the category (in seconds)
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,208 @@
+//
+//  OCHTTPPipelineConcurrencyController.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCHTTPPipelineConcurrencyController.h"
+#import "OCLogger.h"
+
+typedef struct
+{
+	NSTimeInterval shortTermLatency; // EWMA over the last few responses
+	NSTimeInterval longTermLatency; // EWMA over the last ~50 responses, used as baseline
+	NSUInteger samples;
+} OCHTTPPipelineConcurrencyLatencyStatistics;
+
+#define OCHTTPPipelineConcurrencyCategoryNone @""
+
+@interface OCHTTPPipelineConcurrencyController ()
+{
+	double _limit;
+
+	NSMutableDictionary<OCHTTPPipelineConcurrencyCategory, NSValue *> *_latencyStatisticsByCategory;
+
+	NSTimeInterval _lastDecreaseTime;
+}
+@end
+
+@implementation OCHTTPPipelineConcurrencyController
+
+- (instancetype)initWithHostname:(NSString *)hostname initialLimit:(NSUInteger)initialLimit minimumLimit:(NSUInteger)minimumLimit maximumLimit:(NSUInteger)maximumLimit
+{
+	if ((self = [super init]) != nil)
+	{
+		_hostname = hostname;
+
+		_minimumLimit = MAX(minimumLimit, 1);
+		_maximumLimit = MAX(maximumLimit, _minimumLimit);
+		_limit = MIN(MAX(initialLimit, _minimumLimit), _maximumLimit);
+
+		_latencyStatisticsByCategory = [NSMutableDictionary new];
+
+		_latencyTolerance = 2.0;
+		_backoffFactor = 0.5;
+	}
+
+	return (self);
+}
+
+- (NSUInteger)limit
+{
+	@synchronized(self)
+	{
+		return (MIN(MAX((NSUInteger)_limit, _minimumLimit), _maximumLimit));
+	}
+}
+
+#pragma mark - Latency statistics
+- (OCHTTPPipelineConcurrencyLatencyStatistics)_latencyStatisticsForCategory:(OCHTTPPipelineConcurrencyCategory)category
+{
+	OCHTTPPipelineConcurrencyLatencyStatistics statistics = { 0, 0, 0 };
+
+	[_latencyStatisticsByCategory[(category != nil) ? category : OCHTTPPipelineConcurrencyCategoryNone] getValue:&statistics size:sizeof(statistics)];
+
+	return (statistics);
+}
+
+- (void)_setLatencyStatistics:(OCHTTPPipelineConcurrencyLatencyStatistics)statistics forCategory:(OCHTTPPipelineConcurrencyCategory)category
+{
+	_latencyStatisticsByCategory[(category != nil) ? category : OCHTTPPipelineConcurrencyCategoryNone] = [NSValue valueWithBytes:&statistics objCType:@encode(OCHTTPPipelineConcurrencyLatencyStatistics)];
+}
+
+- (NSNumber *)baselineLatencyForCategory:(OCHTTPPipelineConcurrencyCategory)category
+{
+	@synchronized(self)
+	{
+		OCHTTPPipelineConcurrencyLatencyStatistics statistics = [self _latencyStatisticsForCategory:category];
+
+		return ((statistics.samples > 0) ? @(statistics.longTermLatency) : nil);
+	}
+}
+
+- (NSNumber *)smoothedLatencyForCategory:(OCHTTPPipelineConcurrencyCategory)category
+{
+	@synchronized(self)
+	{
+		OCHTTPPipelineConcurrencyLatencyStatistics statistics = [self _latencyStatisticsForCategory:category];
+
+		return ((statistics.samples > 0) ? @(statistics.shortTermLatency) : nil);
+	}
+}
+
+- (NSNumber *)baselineLatency
+{
+	return ([self baselineLatencyForCategory:nil]);
+}
+
+- (NSNumber *)smoothedLatency
+{
+	return ([self smoothedLatencyForCategory:nil]);
+}
+
+#pragma mark - Limit
+- (void)recordResponseWithStatus:(OCHTTPStatus *)status error:(NSError *)error latency:(NSNumber *)latency inFlight:(NSUInteger)inFlight
+{
+	[self recordResponseWithStatus:status error:error latency:latency inFlight:inFlight category:nil];
+}
+
+- (void)recordResponseWithStatus:(OCHTTPStatus *)status error:(NSError *)error latency:(NSNumber *)latency inFlight:(NSUInteger)inFlight category:(OCHTTPPipelineConcurrencyCategory)category
+{
+	BOOL backoff = NO;
+
+	// Server overload and timeouts => back off
+	if ((status.code == OCHTTPStatusCodeTOO_MANY_REQUESTS) || (status.code == OCHTTPStatusCodeSERVICE_UNAVAILABLE))
+	{
+		backoff = YES;
+	}
+	else if ([error.domain isEqual:NSURLErrorDomain] && (error.code == NSURLErrorTimedOut))
+	{
+		backoff = YES;
+	}
+
+	@synchronized(self)
+	{
+		NSTimeInterval now = NSDate.timeIntervalSinceReferenceDate;
+		double previousLimit = _limit;
+		OCHTTPPipelineConcurrencyLatencyStatistics statistics = [self _latencyStatisticsForCategory:category];
+
+		// Track latency
+		if ((latency != nil) && !backoff)
+		{
+			NSTimeInterval sample = latency.doubleValue;
+
+			if (statistics.samples == 0)
+			{
+				statistics.shortTermLatency = sample;
+				statistics.longTermLatency = sample;
+			}
+			else
+			{
+				statistics.shortTermLatency = (statistics.shortTermLatency * 0.8) + (sample * 0.2);
+
+				// The baseline follows lasting changes (f.ex. a different network or server load), so it can't pin the limit down forever - and
+				// follows drops immediately, so it doesn't lag behind after a phase of congestion
+				statistics.longTermLatency = (statistics.longTermLatency * 0.98) + (sample * 0.02);
+
+				if (statistics.shortTermLatency < statistics.longTermLatency)
+				{
+					statistics.longTermLatency = statistics.shortTermLatency;
+				}
+			}
+
+			statistics.samples++;
+
+			[self _setLatencyStatistics:statistics forCategory:category];
+		}
+
+		// Latency of the category rising beyond tolerance => requests are queueing up somewhere
+		if (!backoff && (statistics.samples >= 5) && (statistics.shortTermLatency > (statistics.longTermLatency * _latencyTolerance)))
+		{
+			backoff = YES;
+		}
+
+		if (backoff)
+		{
+			// Multiplicative decrease - but only once per round trip, as responses to requests sent before the last decrease are still coming in
+			NSTimeInterval holdInterval = MAX(((statistics.samples > 0) ? statistics.shortTermLatency : 0), 0.1);
+
+			if ((now - _lastDecreaseTime) >= holdInterval)
+			{
+				_limit = MAX(_limit * _backoffFactor, (double)_minimumLimit);
+				_lastDecreaseTime = now;
+			}
+		}
+		else if ((error == nil) && (inFlight >= (NSUInteger)_limit))
+		{
+			// Additive increase - only while the limit is actually what restricts the number of requests in flight
+			_limit = MIN(_limit + (1.0 / _limit), (double)_maximumLimit);
+		}
+
+		if ((NSUInteger)previousLimit != (NSUInteger)_limit)
+		{
+			OCLogDebug(@"Concurrency limit for %@: %lu -> %lu (category=%@, latency: baseline=%.3f, smoothed=%.3f, status=%@, error=%@)", OCLogPrivate(_hostname), (unsigned long)previousLimit, (unsigned long)_limit, category, statistics.longTermLatency, statistics.shortTermLatency, status, error);
+		}
+	}
+}
+
+- (NSString *)description
+{
+	@synchronized(self)
+	{
+		return ([NSString stringWithFormat:@"<%@: %p, hostname: %@, limit: %lu, categories: %@>", NSStringFromClass(self.class), self, _hostname, (unsigned long)self.limit, _latencyStatisticsByCategory.allKeys]);
+	}
+}
+
+@end
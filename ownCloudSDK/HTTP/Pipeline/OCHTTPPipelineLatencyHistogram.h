@@ -0,0 +1,49 @@
+//
+//  OCHTTPPipelineLatencyHistogram.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Log-linear histogram of durations:
+	- every power of two (in microseconds) is split into 8 linear sub-buckets, so that the relative error of a bucket is at most 1/8 - independent of magnitude
+	- fixed memory (no per-value allocations), so recording is cheap enough to happen for every request
+	- not thread-safe, callers are expected to synchronize access
+*/
+
+@interface OCHTTPPipelineLatencyHistogram : NSObject <NSCopying>
+
+@property(readonly,nonatomic) NSUInteger count; //!< Number of recorded values
+
+@property(readonly,nonatomic) NSTimeInterval minimum; //!< Smallest recorded value (in seconds)
+@property(readonly,nonatomic) NSTimeInterval maximum; //!< Largest recorded value (in seconds)
+@property(readonly,nonatomic) NSTimeInterval mean; //!< Mean of all recorded values (in seconds)
+
+- (void)addValue:(NSTimeInterval)value; //!< Records a duration (in seconds). Negative values are ignored.
+- (void)addHistogram:(OCHTTPPipelineLatencyHistogram *)histogram; //!< Adds all values recorded in another histogram
+
+- (NSTimeInterval)valueAtPercentile:(double)percentile; //!< Returns an estimate of the value at the percentile (0-100), based on the midpoint of the bucket it falls into. Returns 0 if no values were recorded.
+
+- (void)reset; //!< Removes all recorded values
+
+- (NSDictionary<NSString *, id> *)jsonObject; //!< Returns a JSON-serializable summary (count, min, max, mean, percentiles and the non-empty buckets as [lower bound, upper bound, count] - all durations in seconds)
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,192 @@
+//
+//  OCHTTPPipelineLatencyHistogram.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCHTTPPipelineLatencyHistogram.h"
+
+#define OCHTTPLatencyHistogramSubBucketBits	3
+#define OCHTTPLatencyHistogramSubBucketCount	(1 << OCHTTPLatencyHistogramSubBucketBits)
+#define OCHTTPLatencyHistogramMaximumExponent	40 // 2^40 µs ~ 12.7 days
+#define OCHTTPLatencyHistogramBucketCount	(OCHTTPLatencyHistogramSubBucketCount + ((OCHTTPLatencyHistogramMaximumExponent - OCHTTPLatencyHistogramSubBucketBits) * OCHTTPLatencyHistogramSubBucketCount))
+
+static NSUInteger OCHTTPLatencyHistogramBucketIndexForMicroseconds(uint64_t microseconds)
+{
+	NSUInteger exponent;
+
+	if (microseconds < OCHTTPLatencyHistogramSubBucketCount)
+	{
+		// Linear range
+		return ((NSUInteger)microseconds);
+	}
+
+	if (microseconds >= ((uint64_t)1 << OCHTTPLatencyHistogramMaximumExponent))
+	{
+		return (OCHTTPLatencyHistogramBucketCount - 1);
+	}
+
+	exponent = 63 - __builtin_clzll(microseconds);
+
+	return (OCHTTPLatencyHistogramSubBucketCount + ((exponent - OCHTTPLatencyHistogramSubBucketBits) * OCHTTPLatencyHistogramSubBucketCount) + (NSUInteger)((microseconds >> (exponent - OCHTTPLatencyHistogramSubBucketBits)) - OCHTTPLatencyHistogramSubBucketCount));
+}
+
+static uint64_t OCHTTPLatencyHistogramLowerBoundForBucketIndex(NSUInteger index)
+{
+	NSUInteger exponent, subBucket;
+
+	if (index < OCHTTPLatencyHistogramSubBucketCount)
+	{
+		return (index);
+	}
+
+	exponent = ((index - OCHTTPLatencyHistogramSubBucketCount) / OCHTTPLatencyHistogramSubBucketCount) + OCHTTPLatencyHistogramSubBucketBits;
+	subBucket = (index - OCHTTPLatencyHistogramSubBucketCount) % OCHTTPLatencyHistogramSubBucketCount;
+
+	return (((uint64_t)(OCHTTPLatencyHistogramSubBucketCount + subBucket)) << (exponent - OCHTTPLatencyHistogramSubBucketBits));
+}
+
+@interface OCHTTPPipelineLatencyHistogram ()
+{
+	uint64_t _buckets[OCHTTPLatencyHistogramBucketCount];
+
+	NSTimeInterval _sum;
+}
+@end
+
+@implementation OCHTTPPipelineLatencyHistogram
+
+- (void)addValue:(NSTimeInterval)value
+{
+	if ((value < 0) || isnan(value))
+	{
+		return;
+	}
+
+	_buckets[OCHTTPLatencyHistogramBucketIndexForMicroseconds((uint64_t)(value * 1000000.0))]++;
+
+	if ((_count == 0) || (value < _minimum)) { _minimum = value; }
+	if ((_count == 0) || (value > _maximum)) { _maximum = value; }
+
+	_sum += value;
+	_count++;
+}
+
+- (void)addHistogram:(OCHTTPPipelineLatencyHistogram *)histogram
+{
+	if (histogram.count == 0)
+	{
+		return;
+	}
+
+	for (NSUInteger idx=0; idx < OCHTTPLatencyHistogramBucketCount; idx++)
+	{
+		_buckets[idx] += histogram->_buckets[idx];
+	}
+
+	if ((_count == 0) || (histogram.minimum < _minimum)) { _minimum = histogram.minimum; }
+	if ((_count == 0) || (histogram.maximum > _maximum)) { _maximum = histogram.maximum; }
+
+	_sum += histogram->_sum;
+	_count += histogram.count;
+}
+
+- (NSTimeInterval)mean
+{
+	return ((_count > 0) ? (_sum / (NSTimeInterval)_count) : 0);
+}
+
+- (NSTimeInterval)valueAtPercentile:(double)percentile
+{
+	uint64_t targetRank, rank = 0;
+
+	if (_count == 0)
+	{
+		return (0);
+	}
+
+	targetRank = (uint64_t)ceil((MIN(MAX(percentile, 0), 100) / 100.0) * (double)_count);
+	targetRank = MAX(targetRank, 1);
+
+	for (NSUInteger idx=0; idx < OCHTTPLatencyHistogramBucketCount; idx++)
+	{
+		rank += _buckets[idx];
+
+		if (rank >= targetRank)
+		{
+			NSTimeInterval lowerBound = (NSTimeInterval)OCHTTPLatencyHistogramLowerBoundForBucketIndex(idx) / 1000000.0;
+			NSTimeInterval upperBound = (NSTimeInterval)OCHTTPLatencyHistogramLowerBoundForBucketIndex(idx+1) / 1000000.0;
+
+			// Midpoint of the bucket - clamped to the actually observed range
+			return (MIN(MAX((lowerBound + upperBound) / 2.0, _minimum), _maximum));
+		}
+	}
+
+	return (_maximum);
+}
+
+- (void)reset
+{
+	memset(_buckets, 0, sizeof(_buckets));
+
+	_count = 0;
+	_sum = 0;
+	_minimum = 0;
+	_maximum = 0;
+}
+
+- (NSDictionary<NSString *,id> *)jsonObject
+{
+	NSMutableArray<NSArray<NSNumber *> *> *buckets = [NSMutableArray new];
+
+	for (NSUInteger idx=0; idx < OCHTTPLatencyHistogramBucketCount; idx++)
+	{
+		if (_buckets[idx] > 0)
+		{
+			[buckets addObject:@[
+				@((NSTimeInterval)OCHTTPLatencyHistogramLowerBoundForBucketIndex(idx) / 1000000.0),
+				@((NSTimeInterval)OCHTTPLatencyHistogramLowerBoundForBucketIndex(idx+1) / 1000000.0),
+				@(_buckets[idx])
+			]];
+		}
+	}
+
+	return (@{
+		@"count" 	: @(_count),
+		@"min"		: @(_minimum),
+		@"max"		: @(_maximum),
+		@"mean"		: @(self.mean),
+		@"p50"		: @([self valueAtPercentile:50]),
+		@"p90"		: @([self valueAtPercentile:90]),
+		@"p99"		: @([self valueAtPercentile:99]),
+		@"buckets"	: buckets
+	});
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+	OCHTTPPipelineLatencyHistogram *histogram = [OCHTTPPipelineLatencyHistogram new];
+
+	[histogram addHistogram:self];
+
+	return (histogram);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, count: %lu, min: %.03f, p50: %.03f, p90: %.03f, p99: %.03f, max: %.03f>", NSStringFromClass(self.class), self, (unsigned long)_count, _minimum, [self valueAtPercentile:50], [self valueAtPercentile:90], [self valueAtPercentile:99], _maximum]);
+}
+
+@end
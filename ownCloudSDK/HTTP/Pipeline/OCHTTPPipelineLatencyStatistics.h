@@ -0,0 +1,74 @@
+//
+//  OCHTTPPipelineLatencyStatistics.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCHTTPPipelineLatencyHistogram.h"
+
+@class OCHTTPRequest;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NSString* OCHTTPRequestCategory NS_TYPED_ENUM;
+typedef NSString* OCHTTPRequestPhase NS_TYPED_ENUM;
+
+/*
+	Per-category, per-phase latency histograms, so that regressions can be attributed to queueing in the pipeline, the network or the server:
+	- queue wait: enqueued -> scheduled by the pipeline
+	- scheduling delay: scheduled -> URL session starts fetching
+	- dns / connect / tls: from NSURLSessionTaskMetrics (connect excludes tls)
+	- time to first byte: request starts being sent -> response starts being received
+	- transfer: response starts being received -> response fully received
+	- post-processing: time spent delivering the result (incl. the result handler)
+	- total: enqueued -> result delivered
+*/
+
+@interface OCHTTPPipelineLatencyStatistics : NSObject
+
+@property(readonly,nonatomic) NSArray<OCHTTPRequestCategory> *categories; //!< Categories for which durations were recorded
+
++ (OCHTTPRequestCategory)categoryForRequest:(OCHTTPRequest *)request; //!< Determines the category of a request
+
+- (void)recordPhaseDurations:(NSDictionary<OCHTTPRequestPhase, NSNumber *> *)durationsByPhase forCategory:(OCHTTPRequestCategory)category; //!< Adds the durations (in seconds) of the phases of a request to the histograms for the category
+
+- (nullable OCHTTPPipelineLatencyHistogram *)histogramForCategory:(OCHTTPRequestCategory)category phase:(OCHTTPRequestPhase)phase; //!< Returns a copy of the histogram for the category and phase - or nil if no durations were recorded for it
+
+- (NSDictionary<OCHTTPRequestCategory, NSDictionary<OCHTTPRequestPhase, NSDictionary<NSString *, id> *> *> *)jsonObject; //!< Returns a JSON-serializable export of all histograms
+- (nullable NSData *)JSONData; //!< Returns .jsonObject serialized as JSON
+
+- (void)reset; //!< Removes all recorded durations
+
+@end
+
+extern OCHTTPRequestCategory OCHTTPRequestCategoryPROPFIND;
+extern OCHTTPRequestCategory OCHTTPRequestCategoryGET;
+extern OCHTTPRequestCategory OCHTTPRequestCategoryPUT;
+extern OCHTTPRequestCategory OCHTTPRequestCategoryTUSPatch;
+extern OCHTTPRequestCategory OCHTTPRequestCategoryOCS;
+extern OCHTTPRequestCategory OCHTTPRequestCategoryOther;
+
+extern OCHTTPRequestPhase OCHTTPRequestPhaseQueueWait;
+extern OCHTTPRequestPhase OCHTTPRequestPhaseSchedulingDelay;
+extern OCHTTPRequestPhase OCHTTPRequestPhaseDNS;
+extern OCHTTPRequestPhase OCHTTPRequestPhaseConnect;
+extern OCHTTPRequestPhase OCHTTPRequestPhaseTLS;
+extern OCHTTPRequestPhase OCHTTPRequestPhaseTimeToFirstByte;
+extern OCHTTPRequestPhase OCHTTPRequestPhaseTransfer;
+extern OCHTTPRequestPhase OCHTTPRequestPhasePostProcessing;
+extern OCHTTPRequestPhase OCHTTPRequestPhaseTotal;
+
+NS_ASSUME_NONNULL_END
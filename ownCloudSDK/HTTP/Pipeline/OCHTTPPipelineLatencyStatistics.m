@@ -0,0 +1,165 @@
+//
+//  OCHTTPPipelineLatencyStatistics.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCHTTPPipelineLatencyStatistics.h"
+#import "OCHTTPRequest.h"
+#import "OCTUSHeader.h"
+
+@interface OCHTTPPipelineLatencyStatistics ()
+{
+	NSMutableDictionary<OCHTTPRequestCategory, NSMutableDictionary<OCHTTPRequestPhase, OCHTTPPipelineLatencyHistogram *> *> *_histogramsByPhaseByCategory;
+}
+@end
+
+@implementation OCHTTPPipelineLatencyStatistics
+
++ (OCHTTPRequestCategory)categoryForRequest:(OCHTTPRequest *)request
+{
+	OCHTTPMethod method = request.method;
+
+	if ([method isEqual:OCHTTPMethodPROPFIND])
+	{
+		return (OCHTTPRequestCategoryPROPFIND);
+	}
+
+	if ([request.url.path containsString:@"/ocs/"])
+	{
+		return (OCHTTPRequestCategoryOCS);
+	}
+
+	if ([method isEqual:OCHTTPMethodPATCH] && (request.headerFields[OCTUSHeaderNameTusResumable] != nil))
+	{
+		return (OCHTTPRequestCategoryTUSPatch);
+	}
+
+	if ([method isEqual:OCHTTPMethodGET])
+	{
+		return (OCHTTPRequestCategoryGET);
+	}
+
+	if ([method isEqual:OCHTTPMethodPUT])
+	{
+		return (OCHTTPRequestCategoryPUT);
+	}
+
+	return (OCHTTPRequestCategoryOther);
+}
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_histogramsByPhaseByCategory = [NSMutableDictionary new];
+	}
+
+	return (self);
+}
+
+- (NSArray<OCHTTPRequestCategory> *)categories
+{
+	@synchronized(self)
+	{
+		return ([_histogramsByPhaseByCategory.allKeys sortedArrayUsingSelector:@selector(compare:)]);
+	}
+}
+
+- (void)recordPhaseDurations:(NSDictionary<OCHTTPRequestPhase,NSNumber *> *)durationsByPhase forCategory:(OCHTTPRequestCategory)category
+{
+	@synchronized(self)
+	{
+		NSMutableDictionary<OCHTTPRequestPhase, OCHTTPPipelineLatencyHistogram *> *histogramsByPhase;
+
+		if ((histogramsByPhase = _histogramsByPhaseByCategory[category]) == nil)
+		{
+			histogramsByPhase = [NSMutableDictionary new];
+			_histogramsByPhaseByCategory[category] = histogramsByPhase;
+		}
+
+		[durationsByPhase enumerateKeysAndObjectsUsingBlock:^(OCHTTPRequestPhase phase, NSNumber *duration, BOOL *stop) {
+			OCHTTPPipelineLatencyHistogram *histogram;
+
+			if ((histogram = histogramsByPhase[phase]) == nil)
+			{
+				histogram = [OCHTTPPipelineLatencyHistogram new];
+				histogramsByPhase[phase] = histogram;
+			}
+
+			[histogram addValue:duration.doubleValue];
+		}];
+	}
+}
+
+- (OCHTTPPipelineLatencyHistogram *)histogramForCategory:(OCHTTPRequestCategory)category phase:(OCHTTPRequestPhase)phase
+{
+	@synchronized(self)
+	{
+		return ([_histogramsByPhaseByCategory[category][phase] copy]);
+	}
+}
+
+- (NSDictionary<OCHTTPRequestCategory,NSDictionary<OCHTTPRequestPhase,NSDictionary<NSString *,id> *> *> *)jsonObject
+{
+	NSMutableDictionary<OCHTTPRequestCategory,NSDictionary<OCHTTPRequestPhase,NSDictionary<NSString *,id> *> *> *jsonObject = [NSMutableDictionary new];
+
+	@synchronized(self)
+	{
+		[_histogramsByPhaseByCategory enumerateKeysAndObjectsUsingBlock:^(OCHTTPRequestCategory category, NSMutableDictionary<OCHTTPRequestPhase,OCHTTPPipelineLatencyHistogram *> *histogramsByPhase, BOOL *stop) {
+			NSMutableDictionary<OCHTTPRequestPhase,NSDictionary<NSString *,id> *> *jsonByPhase = [NSMutableDictionary new];
+
+			[histogramsByPhase enumerateKeysAndObjectsUsingBlock:^(OCHTTPRequestPhase phase, OCHTTPPipelineLatencyHistogram *histogram, BOOL *stop) {
+				jsonByPhase[phase] = [histogram jsonObject];
+			}];
+
+			jsonObject[category] = jsonByPhase;
+		}];
+	}
+
+	return (jsonObject);
+}
+
+- (NSData *)JSONData
+{
+	return ([NSJSONSerialization dataWithJSONObject:[self jsonObject] options:NSJSONWritingPrettyPrinted|NSJSONWritingSortedKeys error:NULL]);
+}
+
+- (void)reset
+{
+	@synchronized(self)
+	{
+		[_histogramsByPhaseByCategory removeAllObjects];
+	}
+}
+
+@end
+
+OCHTTPRequestCategory OCHTTPRequestCategoryPROPFIND = @"propfind";
+OCHTTPRequestCategory OCHTTPRequestCategoryGET = @"get";
+OCHTTPRequestCategory OCHTTPRequestCategoryPUT = @"put";
+OCHTTPRequestCategory OCHTTPRequestCategoryTUSPatch = @"tus-patch";
+OCHTTPRequestCategory OCHTTPRequestCategoryOCS = @"ocs";
+OCHTTPRequestCategory OCHTTPRequestCategoryOther = @"other";
+
+OCHTTPRequestPhase OCHTTPRequestPhaseQueueWait = @"queue-wait";
+OCHTTPRequestPhase OCHTTPRequestPhaseSchedulingDelay = @"scheduling-delay";
+OCHTTPRequestPhase OCHTTPRequestPhaseDNS = @"dns";
+OCHTTPRequestPhase OCHTTPRequestPhaseConnect = @"connect";
+OCHTTPRequestPhase OCHTTPRequestPhaseTLS = @"tls";
+OCHTTPRequestPhase OCHTTPRequestPhaseTimeToFirstByte = @"ttfb";
+OCHTTPRequestPhase OCHTTPRequestPhaseTransfer = @"transfer";
+OCHTTPRequestPhase OCHTTPRequestPhasePostProcessing = @"post-processing";
+OCHTTPRequestPhase OCHTTPRequestPhaseTotal = @"total";
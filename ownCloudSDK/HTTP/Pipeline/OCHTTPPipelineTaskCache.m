@@ -82,7 +82,7 @@
 
 - (void)removeAllTasksForPipeline:(OCHTTPPipelineID)pipelineID partition:(OCHTTPPipelinePartitionID)partitionID
 {
-	@synchronized(self)
+	@synchronized(_taskByTaskID)
 	{
 		NSMutableArray <OCHTTPPipelineTaskID> *removeTaskIDs = [NSMutableArray new];
 
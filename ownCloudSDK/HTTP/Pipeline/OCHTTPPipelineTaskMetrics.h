@@ -28,10 +28,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property(nullable,strong) NSNumber *dnsTimeInterval; //!< Number of seconds it took to resolve the host name
 @property(nullable,strong) NSNumber *connectTimeInterval; //!< Number of seconds it took to open the connection
+@property(nullable,strong) NSNumber *secureConnectionTimeInterval; //!< Number of seconds it took to perform the TLS handshake (part of connectTimeInterval)
 
 @property(nullable,strong) NSNumber *requestSendTimeInterval; //!< Number of seconds it took to send the request
 @property(nullable,strong) NSNumber *serverProcessingTimeInterval; //!< Number of seconds it took between the request was fully sent and the response started to be received
 @property(nullable,strong) NSNumber *responseReceiveTimeInterval; //!< Number of seconds it took to transfer the response
+@property(nullable,strong) NSNumber *timeToFirstByteInterval; //!< Number of seconds between the request started to be sent and the response started to be received
 
 #pragma mark - Time stamps
 @property(nullable,strong) NSDate *responseStartDate; //!< Date the reponse started to be received
@@ -40,6 +42,9 @@ NS_ASSUME_NONNULL_BEGIN
 @property(nullable,strong) NSNumber *totalRequestSizeBytes; //!< Total number of bytes of the request
 @property(nullable,strong) NSNumber *totalResponseSizeBytes; //!< Total number of bytes of the response
 
+@property(nullable,strong) NSNumber *responseBodyBytesReceived; //!< Number of bytes of the response body as transferred over the network (before decoding)
+@property(nullable,strong) NSNumber *responseBodyBytesDecoded; //!< Number of bytes of the response body after decoding (differs from .responseBodyBytesReceived for compressed transfers)
+
 + (NSUInteger)lengthOfHeaderDictionary:(nullable NSDictionary<NSString *, NSString *> *)headerDict method:(nullable NSString *)method url:(nullable NSURL *)url;
 
 #pragma mark - Computed properties
@@ -79,6 +79,11 @@
 			_connectTimeInterval = @([endDate timeIntervalSinceDate:startDate]);
 		}
 
+		if (((startDate = transactionMetrics.secureConnectionStartDate) != nil) && ((endDate = transactionMetrics.secureConnectionEndDate) != nil))
+		{
+			_secureConnectionTimeInterval = @([endDate timeIntervalSinceDate:startDate]);
+		}
+
 		if (((startDate = transactionMetrics.requestStartDate) != nil) && ((endDate = transactionMetrics.requestEndDate) != nil))
 		{
 			_requestSendTimeInterval = @([endDate timeIntervalSinceDate:startDate]);
@@ -94,6 +99,17 @@
 		{
 			_responseReceiveTimeInterval = @([endDate timeIntervalSinceDate:startDate]);
 		}
+
+		if (((startDate = transactionMetrics.requestStartDate) != nil) && ((endDate = transactionMetrics.responseStartDate) != nil))
+		{
+			_timeToFirstByteInterval = @([endDate timeIntervalSinceDate:startDate]);
+		}
+
+		if (@available(iOS 13.0, macOS 10.15, *))
+		{
+			_responseBodyBytesReceived = @(transactionMetrics.countOfResponseBodyBytesReceived);
+			_responseBodyBytesDecoded = @(transactionMetrics.countOfResponseBodyBytesAfterDecoding);
+		}
 	}
 }
 
@@ -150,14 +166,19 @@
 
 	[coder encodeObject:_dnsTimeInterval forKey:@"dns"];
 	[coder encodeObject:_connectTimeInterval forKey:@"connect"];
+	[coder encodeObject:_secureConnectionTimeInterval forKey:@"tls"];
 	[coder encodeObject:_requestSendTimeInterval forKey:@"request"];
 	[coder encodeObject:_serverProcessingTimeInterval forKey:@"server"];
 	[coder encodeObject:_responseReceiveTimeInterval forKey:@"response"];
+	[coder encodeObject:_timeToFirstByteInterval forKey:@"ttfb"];
 
 	[coder encodeObject:_responseStartDate forKey:@"responseStartDate"];
 
 	[coder encodeObject:_totalRequestSizeBytes forKey:@"totalOut"];
 	[coder encodeObject:_totalResponseSizeBytes forKey:@"totalIn"];
+
+	[coder encodeObject:_responseBodyBytesReceived forKey:@"bodyIn"];
+	[coder encodeObject:_responseBodyBytesDecoded forKey:@"bodyDecoded"];
 }
 
 - (nullable instancetype)initWithCoder:(nonnull NSCoder *)decoder
@@ -169,14 +190,19 @@
 
 		_dnsTimeInterval = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"dns"];
 		_connectTimeInterval = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"connect"];
+		_secureConnectionTimeInterval = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"tls"];
 		_requestSendTimeInterval = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"request"];
 		_serverProcessingTimeInterval = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"server"];
 		_responseReceiveTimeInterval = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"response"];
+		_timeToFirstByteInterval = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"ttfb"];
 
 		_responseStartDate = [decoder decodeObjectOfClass:[NSDate class] forKey:@"responseStartDate"];
 
 		_totalRequestSizeBytes = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"totalOut"];
 		_totalResponseSizeBytes = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"totalIn"];
+
+		_responseBodyBytesReceived = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"bodyIn"];
+		_responseBodyBytesDecoded = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"bodyDecoded"];
 	}
 
 	return (self);
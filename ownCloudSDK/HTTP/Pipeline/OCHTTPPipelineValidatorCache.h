@@ -0,0 +1,50 @@
+//
+//  OCHTTPPipelineValidatorCache.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "OCHTTPTypes.h"
+
+@class OCHTTPRequest;
+@class OCHTTPResponse;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Validators (ETag, Last-Modified) and bodies of the last successful responses to conditional requests (OCHTTPRequest.conditional):
+	- before a conditional request is sent, the validators of a stored response to an identical request are added as If-None-Match / If-Modified-Since
+	- a 304 Not Modified response to such a request receives the stored body (and .notModified set), so it can be handled like a fresh response - or skipped entirely
+	Entries are kept in memory only and evicted under memory pressure.
+*/
+
+@interface OCHTTPPipelineValidatorCache : NSObject
+
+@property(assign,nonatomic) NSUInteger maximumBodySize; //!< Responses with larger bodies are not stored (default: 256 KB)
+@property(assign,nonatomic) NSUInteger totalBodySizeLimit; //!< Total size of the stored bodies before entries are evicted (default: 8 MB)
+
++ (nullable NSString *)keyForRequest:(OCHTTPRequest *)request partitionID:(nullable OCHTTPPipelinePartitionID)partitionID; //!< Key composed from partition, method, URL + parameters, Depth and body hash of the request. Returns nil for requests that can't be made conditional.
+
+- (void)addValidatorsToRequest:(OCHTTPRequest *)request forKey:(NSString *)key; //!< Adds If-None-Match / If-Modified-Since to the request if a stored response exists for key. Header fields already set on the request are left untouched.
+
+- (void)updateWithResponse:(OCHTTPResponse *)response forKey:(NSString *)key; //!< Stores validators and body of successful responses, fills in the body of 304 responses (setting .notModified) and removes the entry for all other responses.
+
+- (void)removeAllEntries;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,193 @@
+//
+//  OCHTTPPipelineValidatorCache.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCHTTPPipelineValidatorCache.h"
+#import "OCHTTPRequest.h"
+#import "OCHTTPResponse.h"
+#import "NSData+OCHash.h"
+#import "NSURL+OCURLQueryParameterExtensions.h"
+
+@interface OCHTTPPipelineValidatorCacheEntry : NSObject
+
+@property(strong,nullable) NSString *eTag;
+@property(strong,nullable) NSString *lastModified;
+@property(strong,nullable) OCHTTPStaticHeaderFields headerFields;
+@property(strong) NSData *bodyData;
+
+@end
+
+@implementation OCHTTPPipelineValidatorCacheEntry
+@end
+
+@interface OCHTTPPipelineValidatorCache ()
+{
+	NSCache<NSString *, OCHTTPPipelineValidatorCacheEntry *> *_entriesByKey;
+}
+@end
+
+@implementation OCHTTPPipelineValidatorCache
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_entriesByKey = [NSCache new];
+		_entriesByKey.name = @"OCHTTPPipelineValidatorCache";
+
+		self.maximumBodySize = 256 * 1024;
+		self.totalBodySizeLimit = 8 * 1024 * 1024;
+	}
+
+	return (self);
+}
+
+- (void)setTotalBodySizeLimit:(NSUInteger)totalBodySizeLimit
+{
+	_totalBodySizeLimit = totalBodySizeLimit;
+	_entriesByKey.totalCostLimit = totalBodySizeLimit;
+}
+
++ (NSString *)keyForRequest:(OCHTTPRequest *)request partitionID:(OCHTTPPipelinePartitionID)partitionID
+{
+	NSURL *url = request.url;
+	NSString *depth = request.headerFields[OCHTTPHeaderFieldNameDepth];
+
+	// Only requests whose response is fully defined by method, URL, Depth and body
+	if ((request.method == nil) || (url == nil) || (request.bodyURL != nil) || request.downloadRequest ||
+	    (![request.method isEqual:OCHTTPMethodGET] && ![request.method isEqual:OCHTTPMethodPROPFIND] && ![request.method isEqual:OCHTTPMethodREPORT]))
+	{
+		return (nil);
+	}
+
+	if (request.parameters.count > 0)
+	{
+		url = [url urlByAppendingQueryParameters:request.parameters replaceExisting:YES];
+	}
+
+	return ([NSString stringWithFormat:@"%@|%@ %@|%@|%@", ((partitionID != nil) ? partitionID : @""), request.method, url.absoluteString, ((depth != nil) ? depth : @""), ((request.bodyData.length > 0) ? [request.bodyData.sha256Hash asHexStringWithSeparator:nil lowercase:YES] : @"")]);
+}
+
++ (NSString *)_valueForHeaderField:(OCHTTPHeaderFieldName)headerFieldName inResponse:(OCHTTPResponse *)response
+{
+	NSString *value;
+
+	if ((value = response.headerFields[headerFieldName]) == nil)
+	{
+		// Header field names are case-insensitive (and canonicalized differently across OS versions)
+		for (NSString *fieldName in response.headerFields)
+		{
+			if ([fieldName caseInsensitiveCompare:headerFieldName] == NSOrderedSame)
+			{
+				value = response.headerFields[fieldName];
+				break;
+			}
+		}
+	}
+
+	return (value);
+}
+
+- (void)addValidatorsToRequest:(OCHTTPRequest *)request forKey:(NSString *)key
+{
+	OCHTTPPipelineValidatorCacheEntry *entry;
+
+	if ((entry = [_entriesByKey objectForKey:key]) != nil)
+	{
+		if ((entry.eTag != nil) && (request.headerFields[OCHTTPHeaderFieldNameIfNoneMatch] == nil))
+		{
+			[request setValue:entry.eTag forHeaderField:OCHTTPHeaderFieldNameIfNoneMatch];
+		}
+
+		if ((entry.lastModified != nil) && (request.headerFields[OCHTTPHeaderFieldNameIfModifiedSince] == nil))
+		{
+			[request setValue:entry.lastModified forHeaderField:OCHTTPHeaderFieldNameIfModifiedSince];
+		}
+	}
+}
+
+- (void)updateWithResponse:(OCHTTPResponse *)response forKey:(NSString *)key
+{
+	OCHTTPStatusCode statusCode = response.status.code;
+
+	if ((response.httpError != nil) || (response.status == nil))
+	{
+		// No response from the server - keep the entry for the next attempt
+		return;
+	}
+
+	if (statusCode == OCHTTPStatusCodeNOT_MODIFIED)
+	{
+		OCHTTPPipelineValidatorCacheEntry *entry;
+
+		if ((entry = [_entriesByKey objectForKey:key]) != nil)
+		{
+			if (response.bodyData.length == 0)
+			{
+				[response appendDataToResponseBody:entry.bodyData];
+			}
+
+			if (entry.headerFields != nil)
+			{
+				// Stored header fields (f.ex. Content-Type), updated with those sent along with the 304 response
+				NSMutableDictionary<NSString *, NSString *> *headerFields = [entry.headerFields mutableCopy];
+
+				if (response.headerFields != nil)
+				{
+					[headerFields addEntriesFromDictionary:response.headerFields];
+				}
+
+				response.headerFields = headerFields;
+			}
+
+			response.notModified = YES;
+		}
+
+		return;
+	}
+
+	if (response.status.isSuccess && (response.bodyURL == nil) && (response.bodyData != nil) && (response.bodyData.length <= _maximumBodySize))
+	{
+		NSString *eTag = [OCHTTPPipelineValidatorCache _valueForHeaderField:OCHTTPHeaderFieldNameETag inResponse:response];
+		NSString *lastModified = [OCHTTPPipelineValidatorCache _valueForHeaderField:OCHTTPHeaderFieldNameLastModified inResponse:response];
+
+		if ((eTag != nil) || (lastModified != nil))
+		{
+			OCHTTPPipelineValidatorCacheEntry *entry = [OCHTTPPipelineValidatorCacheEntry new];
+
+			entry.eTag = eTag;
+			entry.lastModified = lastModified;
+			entry.headerFields = response.headerFields;
+			entry.bodyData = [response.bodyData copy];
+
+			[_entriesByKey setObject:entry forKey:key cost:entry.bodyData.length];
+
+			return;
+		}
+	}
+
+	// Response without (usable) validators => don't send outdated ones with the next request
+	[_entriesByKey removeObjectForKey:key];
+}
+
+- (void)removeAllEntries
+{
+	[_entriesByKey removeAllObjects];
+}
+
+@end
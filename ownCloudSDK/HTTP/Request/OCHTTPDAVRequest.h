@@ -45,12 +45,18 @@ typedef NS_ENUM(NSInteger, OCPropfindDepth) {
 @property(strong) OCXMLNode *xmlRequest;
 
 + (instancetype)propfindRequestWithURL:(NSURL *)url depth:(OCPropfindDepth)depth;
++ (instancetype)propfindRequestWithURL:(NSURL *)url depth:(OCPropfindDepth)depth bodyData:(NSData *)bodyData; //!< Creates a PROPFIND request with an already serialized request body (see +propfindRequestBodyWithProperties:). The request has no .xmlRequest.
 + (instancetype)proppatchRequestWithURL:(NSURL *)url content:(NSArray <OCXMLNode *> *)contentNodes;
 + (instancetype)reportRequestWithURL:(NSURL *)url rootElementName:(NSString *)rootElementName content:(NSArray <OCXMLNode *> *)contentNodes;
++ (instancetype)syncCollectionRequestWithURL:(NSURL *)url syncToken:(OCDAVSyncToken)syncToken limit:(NSUInteger)limit properties:(NSArray <OCXMLNode *> *)properties; //!< Creates a sync-collection REPORT request (RFC 6578) for all changes below url since syncToken (pass nil for an initial sync). A limit of 0 requests all changes at once.
+
++ (NSData *)propfindRequestBodyWithProperties:(NSArray <OCXMLNode *> *)properties; //!< Returns the serialized body of a PROPFIND request for the provided properties
 
 - (OCXMLNode *)xmlRequestPropAttribute;
 
 - (NSArray <OCItem *> *)responseItemsForBasePath:(NSString *)basePath reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID withErrors:(NSArray <NSError *> **)errors;
 - (NSDictionary <OCPath, OCHTTPDAVMultistatusResponse *> *)multistatusResponsesForBasePath:(NSString *)basePath;
 
+- (NSArray <OCItem *> *)syncCollectionResponseItemsForBasePath:(NSString *)basePath reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID syncToken:(OCDAVSyncToken *)outSyncToken truncated:(BOOL *)outTruncated withErrors:(NSArray <NSError *> **)errors; //!< Parses the response to a sync-collection REPORT. Removed members are returned as items with .removed = YES. outSyncToken returns the new sync token, outTruncated whether the server returned only part of the changes.
+
 @end
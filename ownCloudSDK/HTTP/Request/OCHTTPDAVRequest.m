@@ -24,21 +24,59 @@
 
 @implementation OCHTTPDAVRequest
 
-+ (instancetype)propfindRequestWithURL:(NSURL *)url depth:(OCPropfindDepth)depth
+- (instancetype)init
 {
-	OCHTTPDAVRequest *request = [OCHTTPDAVRequest requestWithURL:url];
-	
-	request.method = OCHTTPMethodPROPFIND;
-	request.xmlRequest = [OCXMLNode documentWithRootElement:
+	if ((self = [super init]) != nil)
+	{
+		// Multistatus XML compresses very well
+		self.acceptsCompressedResponse = YES;
+	}
+
+	return (self);
+}
+
++ (OCXMLNode *)_propfindDocumentWithProperties:(NSArray <OCXMLNode *> *)properties
+{
+	return ([OCXMLNode documentWithRootElement:
 		[OCXMLNode elementWithName:@"D:propfind" attributes:@[
 			[OCXMLNode namespaceWithName:@"D" stringValue:@"DAV:"],
 			[OCXMLNode namespaceWithName:@"oc" stringValue:@"http://owncloud.org/ns"]
 		] children:@[
-			[OCXMLNode elementWithName:@"D:prop"]
+			[OCXMLNode elementWithName:@"D:prop" children:properties]
 		]]
-	];
+	]);
+}
+
++ (NSData *)propfindRequestBodyWithProperties:(NSArray <OCXMLNode *> *)properties
+{
+	return ([[self _propfindDocumentWithProperties:properties] XMLUTF8Data]);
+}
+
++ (instancetype)_propfindRequestWithURL:(NSURL *)url depth:(OCPropfindDepth)depth
+{
+	OCHTTPDAVRequest *request = [OCHTTPDAVRequest requestWithURL:url];
+
+	request.method = OCHTTPMethodPROPFIND;
 	[request setValue:@"application/xml" forHeaderField:OCHTTPHeaderFieldNameContentType];
-	[request setValue:((depth == OCPropfindDepthInfinity) ? @"infinity" : [NSString stringWithFormat:@"%lu", (unsigned long)depth]) forHeaderField:OCHTTPHeaderFieldNameDepth];
+	[request setValue:((depth == OCPropfindDepthInfinity) ? @"infinity" : ((depth == 0) ? @"0" : ((depth == 1) ? @"1" : [NSString stringWithFormat:@"%lu", (unsigned long)depth]))) forHeaderField:OCHTTPHeaderFieldNameDepth];
+
+	return (request);
+}
+
++ (instancetype)propfindRequestWithURL:(NSURL *)url depth:(OCPropfindDepth)depth
+{
+	OCHTTPDAVRequest *request = [self _propfindRequestWithURL:url depth:depth];
+
+	request.xmlRequest = [self _propfindDocumentWithProperties:nil];
+
+	return (request);
+}
+
++ (instancetype)propfindRequestWithURL:(NSURL *)url depth:(OCPropfindDepth)depth bodyData:(NSData *)bodyData
+{
+	OCHTTPDAVRequest *request = [self _propfindRequestWithURL:url depth:depth];
+
+	request.bodyData = bodyData;
 
 	return (request);
 }
@@ -75,6 +113,23 @@
 	return (request);
 }
 
++ (instancetype)syncCollectionRequestWithURL:(NSURL *)url syncToken:(OCDAVSyncToken)syncToken limit:(NSUInteger)limit properties:(NSArray <OCXMLNode *> *)properties
+{
+	OCHTTPDAVRequest *request;
+
+	request = [self reportRequestWithURL:url rootElementName:@"D:sync-collection" content:[[NSArray alloc] initWithObjects:
+		((syncToken != nil) ? [OCXMLNode elementWithName:@"D:sync-token" stringValue:syncToken] : [OCXMLNode elementWithName:@"D:sync-token"]),
+		[OCXMLNode elementWithName:@"D:sync-level" stringValue:@"infinite"],
+		[OCXMLNode elementWithName:@"D:prop" children:properties],
+		((limit > 0) ? [OCXMLNode elementWithName:@"D:limit" children:@[ [OCXMLNode elementWithName:@"D:nresults" stringValue:[NSString stringWithFormat:@"%lu", (unsigned long)limit]] ]] : nil),
+	nil]];
+
+	// RFC 6578 requires Depth: 0 - the scope is determined by D:sync-level
+	[request setValue:@"0" forHeaderField:OCHTTPHeaderFieldNameDepth];
+
+	return (request);
+}
+
 - (OCXMLNode *)xmlRequestPropAttribute
 {
 	return ([[_xmlRequest nodesForXPath:@"D:propfind/D:prop"] firstObject]);
@@ -143,6 +198,65 @@
 	return (responseItems);
 }
 
+- (NSArray <OCItem *> *)syncCollectionResponseItemsForBasePath:(NSString *)basePath reuseUsersByID:(NSMutableDictionary<NSString *,OCUser *> *)usersByUserID syncToken:(OCDAVSyncToken *)outSyncToken truncated:(BOOL *)outTruncated withErrors:(NSArray <NSError *> **)errors
+{
+	NSArray <OCItem *> *responseItems = nil;
+	NSData *responseData = self.httpResponse.bodyData;
+	OCXMLParser *parser;
+
+	if ((responseData != nil) && ((parser = [[OCXMLParser alloc] initWithData:responseData]) != nil))
+	{
+		__block OCDAVSyncToken syncToken = nil;
+
+		parser.options = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+			@(YES),		@"syncCollection",
+			basePath, 	@"basePath",
+			usersByUserID, 	@"usersByUserID",
+		nil];
+
+		[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+		// <d:sync-token> is a direct child of <d:multistatus> (RFC 6578). The <d:response> elements are consumed by the OCItemMultistatusDecoder,
+		// so only the top-level token reaches the converter - with its namespace prefix normalized and entities decoded by the SAX parser.
+		[parser setValueConverter:^NSError *(NSString *elementName, NSString *value, NSString *namespaceURI, NSDictionary<NSString *,NSString *> *attributes, id *convertedValue) {
+			syncToken = [value stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceAndNewlineCharacterSet];
+
+			if (convertedValue != NULL)
+			{
+				*convertedValue = value;
+			}
+
+			return ((NSError *)nil);
+		} forElementName:@"d:sync-token"];
+
+		if ([parser parse])
+		{
+			responseItems = parser.parsedObjects;
+		}
+
+		if (parser.errors.count > 0)
+		{
+			OCLogDebug(@"DAV Error(s): %@", parser.errors);
+			if (errors != NULL)
+			{
+				*errors = parser.errors;
+			}
+		}
+
+		if (outTruncated != NULL)
+		{
+			*outTruncated = ((NSNumber *)parser.userInfo[@"syncCollectionTruncated"]).boolValue;
+		}
+
+		if (outSyncToken != NULL)
+		{
+			*outSyncToken = (syncToken.length > 0) ? syncToken : nil;
+		}
+	}
+
+	return (responseItems);
+}
+
 - (NSDictionary <OCPath, OCHTTPDAVMultistatusResponse *> *)multistatusResponsesForBasePath:(NSString *)basePath
 {
 	NSMutableDictionary <OCPath, OCHTTPDAVMultistatusResponse *> *responsesByPath = nil;
@@ -109,6 +109,9 @@ typedef NSDictionary<OCHTTPRequestResumeInfoKey,id>* OCHTTPRequestResumeInfo;
 @property(strong) NSNumber *customTimeout; 		//!< Custom timeout in seconds for request.
 
 @property(assign) OCHTTPRequestPriority priority; //!< Priority of the request from 0.0 (lowest priority) to 1.0 (highest priority). Defaults to NSURLSessionTaskPriorityDefault (= 0.5).
+@property(assign) OCHTTPRequestPriorityClass priorityClass; //!< Priority class of the request. Interactive requests are scheduled ahead of all others, the remaining classes share available slots weighted by class and waiting time. Defaults to OCHTTPRequestPriorityClassUtility.
+@property(strong) NSDate *enqueueDate; //!< Date the request was enqueued in a pipeline (set by the pipeline).
+@property(strong) NSDate *scheduleDate; //!< Date the request was last scheduled for sending by a pipeline (set by the pipeline).
 @property(strong) OCHTTPRequestGroupID groupID; 	//!< ID of the Group the request belongs to (if any). Requests in the same group are executed serially, whereas requests that belong to no group are executed as soon as possible.
 
 @property(copy) OCHTTPRequestObserver requestObserver; //!< OCHTTPRequestObserver block called as the request encounters various events
@@ -121,6 +124,12 @@ typedef NSDictionary<OCHTTPRequestResumeInfoKey,id>* OCHTTPRequestResumeInfo;
 
 @property(assign) BOOL isNonCritial;			//!< Request that are marked non-critical are allowed to be cancelled to speed up shutting down the connection queue
 
+@property(assign) BOOL coalescable;			//!< If YES, the pipeline can attach this request to an identical request (same -coalescingKey) that's already queued or in flight, and deliver that request's response instead of sending this one. Only honored for idempotent methods. Defaults to NO.
+
+@property(assign) BOOL conditional;			//!< If YES, the pipeline keeps validators (ETag, Last-Modified) and body of successful responses and sends subsequent identical requests as conditional requests (If-None-Match / If-Modified-Since). 304 Not Modified responses are delivered with the kept body and .notModified set. Meant for small, repeatedly fetched resources. Defaults to NO.
+
+@property(assign) BOOL acceptsCompressedResponse;	//!< If YES, the pipeline explicitly negotiates a compressed transfer of the response (Accept-Encoding) and decodes bodies that arrive still encoded before they're delivered or streamed. Defaults to NO (YES for OCHTTPDAVRequest).
+
 @property(assign) BOOL cancelled;
 
 @property(strong,readonly,nonatomic) NSError *error;	//!< Convenience accessor for .httpResponse.error
@@ -135,6 +144,9 @@ typedef NSDictionary<OCHTTPRequestResumeInfoKey,id>* OCHTTPRequestResumeInfo;
 
 - (OCHTTPRequestID)recreateRequestID; //!< Creates and sets a new request ID on .identifier and the X-Request-ID header (for internal use only!)
 
+#pragma mark - Coalescing support
+- (OCHTTPRequestCoalescingKey)coalescingKey; //!< Key composed from method, URL + parameters, relevant header fields and a hash of the body. Returns nil if the request can't be coalesced.
+
 #pragma mark - Cancel support
 - (void)cancel;
 
@@ -191,6 +203,11 @@ extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameDestination;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOverwrite;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfMatch;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfNoneMatch;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfModifiedSince;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameETag;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameLastModified;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameAcceptEncoding;
+extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameContentEncoding;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameUserAgent;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameXOCMTime;
 extern OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOCChecksum;
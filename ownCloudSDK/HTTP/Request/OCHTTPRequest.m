@@ -22,6 +22,7 @@
 #import "NSProgress+OCExtensions.h"
 #import "OCMacros.h"
 #import "OCConnection.h"
+#import "NSData+OCHash.h"
 
 @implementation OCHTTPRequest
 
@@ -55,6 +56,7 @@
 		self.progress = [[OCProgress alloc] initWithPath:@[OCHTTPRequestGlobalPath, _identifier] progress:progress];
 
 		self.priority = NSURLSessionTaskPriorityDefault;
+		self.priorityClass = OCHTTPRequestPriorityClassUtility;
 	}
 	
 	return(self);
@@ -367,6 +369,57 @@
 	return (newID);
 }
 
+#pragma mark - Coalescing support
+- (OCHTTPRequestCoalescingKey)coalescingKey
+{
+	static NSSet<OCHTTPMethod> *idempotentMethods;
+	static NSArray<OCHTTPHeaderFieldName> *keyHeaderFieldNames;
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		idempotentMethods = [NSSet setWithObjects:OCHTTPMethodGET, OCHTTPMethodHEAD, OCHTTPMethodPROPFIND, OCHTTPMethodREPORT, OCHTTPMethodOPTIONS, nil];
+
+		// Header fields that can change the response and therefore need to be part of the key
+		keyHeaderFieldNames = @[
+			OCHTTPHeaderFieldNameDepth,
+			OCHTTPHeaderFieldNameContentType,
+			OCHTTPHeaderFieldNameIfNoneMatch,
+			OCHTTPHeaderFieldNameIfModifiedSince,
+			@"Range",
+			@"Accept",
+			OCHTTPHeaderFieldNameAcceptEncoding
+		];
+	});
+
+	// Only idempotent requests without side effects on the local side (upload from file, streaming, auto-resume) can be coalesced
+	if ((_method == nil) || (_url == nil) ||
+	    ![idempotentMethods containsObject:_method] ||
+	    (_bodyURL != nil) || _autoResume || (_ephermalStreamHandler != nil) ||
+	    self.cancelled)
+	{
+		return (nil);
+	}
+
+	NSMutableString *coalescingKey = [NSMutableString stringWithFormat:@"%@ %@", _method, ((_parameters.count > 0) ? [_url urlByAppendingQueryParameters:_parameters replaceExisting:YES] : _url).absoluteString];
+
+	for (OCHTTPHeaderFieldName headerFieldName in keyHeaderFieldNames)
+	{
+		NSString *value;
+
+		if ((value = _headerFields[headerFieldName]) != nil)
+		{
+			[coalescingKey appendFormat:@"\n%@: %@", headerFieldName, value];
+		}
+	}
+
+	if (_bodyData.length > 0)
+	{
+		[coalescingKey appendFormat:@"\nbody: %@", [_bodyData.sha256Hash asHexStringWithSeparator:nil lowercase:YES]];
+	}
+
+	return (coalescingKey);
+}
+
 #pragma mark - Cancel support
 - (void)cancel
 {
@@ -600,6 +653,10 @@
 		self.priority		= [decoder decodeFloatForKey:@"priority"];
 		self.groupID		= [decoder decodeObjectOfClass:[NSString class] forKey:@"groupID"];
 
+		self.priorityClass	= [decoder containsValueForKey:@"priorityClass"] ? [decoder decodeIntegerForKey:@"priorityClass"] : OCHTTPRequestPriorityClassUtility;
+		self.enqueueDate	= [decoder decodeObjectOfClass:[NSDate class] forKey:@"enqueueDate"];
+		self.scheduleDate	= [decoder decodeObjectOfClass:[NSDate class] forKey:@"scheduleDate"];
+
 		self.downloadRequest	= [decoder decodeBoolForKey:@"downloadRequest"];
 		self.downloadedFileURL	= [decoder decodeObjectOfClass:[NSURL class] forKey:@"downloadedFileURL"];
 		self.downloadedFileIsTemporary = [decoder decodeBoolForKey:@"downloadedFileIsTemporary"];
@@ -607,6 +664,9 @@
 		self.avoidCellular	= [decoder decodeBoolForKey:@"avoidCellular"];
 
 		self.isNonCritial 	= [decoder decodeBoolForKey:@"isNonCritial"];
+		self.coalescable	= [decoder decodeBoolForKey:@"coalescable"];
+		self.conditional	= [decoder decodeBoolForKey:@"conditional"];
+		self.acceptsCompressedResponse = [decoder decodeBoolForKey:@"acceptsCompressedResponse"];
 		self.cancelled		= [decoder decodeBoolForKey:@"cancelled"];
 
 		if ((resultHandlerActionString = [decoder decodeObjectOfClass:[NSString class] forKey:@"resultHandlerAction"]) != nil)
@@ -657,6 +717,10 @@
 	[coder encodeFloat:_priority 		forKey:@"priority"];
 	[coder encodeObject:_groupID 		forKey:@"groupID"];
 
+	[coder encodeInteger:_priorityClass	forKey:@"priorityClass"];
+	[coder encodeObject:_enqueueDate	forKey:@"enqueueDate"];
+	[coder encodeObject:_scheduleDate	forKey:@"scheduleDate"];
+
 	[coder encodeBool:_downloadRequest 	forKey:@"downloadRequest"];
 	[coder encodeObject:_downloadedFileURL 	forKey:@"downloadedFileURL"];
 	[coder encodeBool:_downloadedFileIsTemporary forKey:@"downloadedFileIsTemporary"];
@@ -664,6 +728,9 @@
 	[coder encodeBool:_avoidCellular 	forKey:@"avoidCellular"];
 
 	[coder encodeBool:_isNonCritial 	forKey:@"isNonCritial"];
+	[coder encodeBool:_coalescable		forKey:@"coalescable"];
+	[coder encodeBool:_conditional		forKey:@"conditional"];
+	[coder encodeBool:_acceptsCompressedResponse forKey:@"acceptsCompressedResponse"];
 	[coder encodeBool:_cancelled 		forKey:@"cancelled"];
 
 	[coder encodeObject:NSStringFromSelector(_resultHandlerAction) forKey:@"resultHandlerAction"];
@@ -698,6 +765,11 @@ OCHTTPHeaderFieldName OCHTTPHeaderFieldNameDestination = @"Destination";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOverwrite = @"Overwrite";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfMatch = @"If-Match";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfNoneMatch = @"If-None-Match";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameIfModifiedSince = @"If-Modified-Since";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameETag = @"ETag";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameLastModified = @"Last-Modified";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameAcceptEncoding = @"Accept-Encoding";
+OCHTTPHeaderFieldName OCHTTPHeaderFieldNameContentEncoding = @"Content-Encoding";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameUserAgent = @"User-Agent";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameXOCMTime = @"X-OC-MTime";
 OCHTTPHeaderFieldName OCHTTPHeaderFieldNameOCChecksum = @"OC-Checksum";
@@ -50,6 +50,8 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property(strong,nullable,nonatomic) NSData *bodyData;			//!< If non-nil, the received data of the body. If .bodyURL is provided, maps the file into memory via -[NSData initWithContentsOfFile:bodyURL options:NSDataReadingMappedIfSafe|NSDataReadingUncached]
 
+@property(assign) BOOL notModified;				//!< YES if the server responded with 304 Not Modified to a conditional request and .bodyData was filled in from the pipeline's validator cache
+
 @property(readonly,strong,nonatomic,nullable) NSURL *redirectURL; //!< Convenience accessor for the URL contained in the response's Location header field
 
 @property(strong,nullable) NSError *error;
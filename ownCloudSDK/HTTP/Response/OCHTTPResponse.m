@@ -240,6 +240,7 @@
 		_bodyURLIsTemporary		= [decoder decodeBoolForKey:@"bodyURLIsTemporary"];
 
 		_bodyData			= [decoder decodeObjectOfClass:[NSMutableData class] forKey:@"bodyData"];
+		_notModified			= [decoder decodeBoolForKey:@"notModified"];
 
 		_error				= [decoder decodeObjectOfClass:[NSError class] forKey:@"error"];
 		_httpError			= [decoder decodeObjectOfClass:[NSError class] forKey:@"httpError"];
@@ -269,6 +270,7 @@
 	[coder encodeBool:_bodyURLIsTemporary 			forKey:@"bodyURLIsTemporary"];
 
 	[coder encodeObject:_bodyData				forKey:@"bodyData"];
+	[coder encodeBool:_notModified				forKey:@"notModified"];
 
 	[coder encodeObject:_error				forKey:@"error"];
 	[coder encodeObject:_httpError				forKey:@"httpError"];
@@ -0,0 +1,49 @@
+//
+//  OCHTTPResponseBodyDecoder.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Incremental decoder for compressed response bodies (Content-Encoding: gzip, deflate and - where supported by the OS - br).
+	NSURLSession decodes responses transparently. The decoder is needed for bodies that didn't pass through NSURLSession (f.ex. from host simulation).
+	Data can be fed in chunks of any size as it arrives, so decoded data can be passed on to stream handlers right away.
+*/
+
+@interface OCHTTPResponseBodyDecoder : NSObject
+
+@property(class,readonly,strong,nonatomic) NSArray<NSString *> *supportedContentEncodings; //!< Content encodings that can be decoded, in order of preference
+@property(class,readonly,strong,nonatomic) NSString *acceptEncodingHeaderValue; //!< Value for the Accept-Encoding header field, composed from .supportedContentEncodings
+
+@property(readonly,strong) NSString *contentEncoding; //!< The content encoding decoded by this decoder
+
+@property(readonly) NSUInteger encodedByteCount; //!< Number of bytes passed to the decoder so far
+@property(readonly) NSUInteger decodedByteCount; //!< Number of decoded bytes returned by the decoder so far
+
++ (nullable instancetype)decoderForContentEncoding:(nullable NSString *)contentEncoding; //!< Returns a decoder for the content encoding - or nil if no decoding is needed ("identity") or possible (unsupported encoding).
+
+- (nullable NSData *)decodeData:(NSData *)data error:(NSError * _Nullable * _Nullable)outError; //!< Decodes the next chunk of the body. Returns the decoded data available so far (which can be empty) or nil on error.
+- (nullable NSData *)finishWithError:(NSError * _Nullable * _Nullable)outError; //!< Signals the end of the body. Returns any remaining decoded data or nil if the body was truncated or invalid.
+
++ (nullable NSData *)decodeData:(NSData *)data withContentEncoding:(NSString *)contentEncoding error:(NSError * _Nullable * _Nullable)outError; //!< Convenience method to decode a complete body in one go.
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,402 @@
+//
+//  OCHTTPResponseBodyDecoder.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <compression.h>
+#import "OCHTTPResponseBodyDecoder.h"
+#import "NSError+OCError.h"
+
+typedef NS_ENUM(NSInteger, OCHTTPResponseBodyDecoderPhase)
+{
+	OCHTTPResponseBodyDecoderPhaseHeader,	//!< Collecting the header (gzip header / zlib wrapper)
+	OCHTTPResponseBodyDecoderPhaseBody,	//!< Decoding the compressed data
+	OCHTTPResponseBodyDecoderPhaseEnd	//!< End of compressed data reached (remaining bytes, f.ex. the gzip trailer, are ignored)
+};
+
+typedef NS_ENUM(NSInteger, OCHTTPResponseBodyDecoderFormat)
+{
+	OCHTTPResponseBodyDecoderFormatGZIP,
+	OCHTTPResponseBodyDecoderFormatDeflate,
+	OCHTTPResponseBodyDecoderFormatBrotli
+};
+
+#define OCHTTPResponseBodyDecoderHeaderIncomplete	-1
+#define OCHTTPResponseBodyDecoderHeaderInvalid		-2
+
+@interface OCHTTPResponseBodyDecoder ()
+{
+	OCHTTPResponseBodyDecoderFormat _format;
+	OCHTTPResponseBodyDecoderPhase _phase;
+
+	NSMutableData *_headerBuffer;
+
+	compression_stream _stream;
+	BOOL _streamInitialized;
+
+	BOOL _failed;
+}
+@end
+
+@implementation OCHTTPResponseBodyDecoder
+
++ (NSArray<NSString *> *)supportedContentEncodings
+{
+	if (@available(iOS 15.0, macOS 12.0, *))
+	{
+		return (@[ @"gzip", @"deflate", @"br" ]);
+	}
+
+	return (@[ @"gzip", @"deflate" ]);
+}
+
++ (NSString *)acceptEncodingHeaderValue
+{
+	return ([self.supportedContentEncodings componentsJoinedByString:@", "]);
+}
+
++ (instancetype)decoderForContentEncoding:(NSString *)contentEncoding
+{
+	contentEncoding = [contentEncoding.lowercaseString stringByTrimmingCharactersInSet:NSCharacterSet.whitespaceCharacterSet];
+
+	if ((contentEncoding.length == 0) || [contentEncoding isEqual:@"identity"])
+	{
+		return (nil);
+	}
+
+	return ([[self alloc] initWithContentEncoding:contentEncoding]);
+}
+
+- (instancetype)initWithContentEncoding:(NSString *)contentEncoding
+{
+	OCHTTPResponseBodyDecoderFormat format;
+	compression_algorithm algorithm = COMPRESSION_ZLIB; // raw DEFLATE (RFC 1951)
+
+	if ([contentEncoding isEqual:@"gzip"] || [contentEncoding isEqual:@"x-gzip"])
+	{
+		format = OCHTTPResponseBodyDecoderFormatGZIP;
+	}
+	else if ([contentEncoding isEqual:@"deflate"])
+	{
+		format = OCHTTPResponseBodyDecoderFormatDeflate;
+	}
+	else if ([contentEncoding isEqual:@"br"])
+	{
+		if (@available(iOS 15.0, macOS 12.0, *))
+		{
+			format = OCHTTPResponseBodyDecoderFormatBrotli;
+			algorithm = COMPRESSION_BROTLI;
+		}
+		else
+		{
+			return (nil);
+		}
+	}
+	else
+	{
+		// Unsupported
+		return (nil);
+	}
+
+	if ((self = [super init]) != nil)
+	{
+		_contentEncoding = contentEncoding;
+		_format = format;
+		_phase = (format == OCHTTPResponseBodyDecoderFormatBrotli) ? OCHTTPResponseBodyDecoderPhaseBody : OCHTTPResponseBodyDecoderPhaseHeader; // Brotli has no header
+
+		if (compression_stream_init(&_stream, COMPRESSION_STREAM_DECODE, algorithm) != COMPRESSION_STATUS_OK)
+		{
+			return (nil);
+		}
+
+		_streamInitialized = YES;
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	if (_streamInitialized)
+	{
+		compression_stream_destroy(&_stream);
+		_streamInitialized = NO;
+	}
+}
+
+#pragma mark - Header
+- (NSInteger)_headerLength
+{
+	const uint8_t *bytes = (const uint8_t *)_headerBuffer.bytes;
+	NSUInteger length = _headerBuffer.length;
+
+	switch (_format)
+	{
+		case OCHTTPResponseBodyDecoderFormatGZIP: {
+			// RFC 1952: ID1 ID2 CM FLG MTIME(4) XFL OS [FEXTRA] [FNAME] [FCOMMENT] [FHCRC]
+			NSUInteger offset = 10;
+			uint8_t flags;
+
+			if (length < offset)
+			{
+				return (OCHTTPResponseBodyDecoderHeaderIncomplete);
+			}
+
+			if ((bytes[0] != 0x1f) || (bytes[1] != 0x8b) || (bytes[2] != 8))
+			{
+				return (OCHTTPResponseBodyDecoderHeaderInvalid);
+			}
+
+			flags = bytes[3];
+
+			if ((flags & 0x04) != 0) // FEXTRA
+			{
+				if (length < offset + 2)
+				{
+					return (OCHTTPResponseBodyDecoderHeaderIncomplete);
+				}
+
+				offset += 2 + (bytes[offset] | (bytes[offset+1] << 8));
+			}
+
+			for (uint8_t zeroTerminatedFlag=0x08; zeroTerminatedFlag <= 0x10; zeroTerminatedFlag <<= 1) // FNAME, FCOMMENT
+			{
+				if ((flags & zeroTerminatedFlag) != 0)
+				{
+					while ((offset < length) && (bytes[offset] != 0))
+					{
+						offset++;
+					}
+
+					offset++; // skip terminating zero
+				}
+			}
+
+			if ((flags & 0x02) != 0) // FHCRC
+			{
+				offset += 2;
+			}
+
+			if (length < offset)
+			{
+				return (OCHTTPResponseBodyDecoderHeaderIncomplete);
+			}
+
+			return (offset);
+		}
+		break;
+
+		case OCHTTPResponseBodyDecoderFormatDeflate:
+			// "deflate" is supposed to be zlib-wrapped (RFC 1950), but some servers send raw DEFLATE
+			if (length < 2)
+			{
+				return (OCHTTPResponseBodyDecoderHeaderIncomplete);
+			}
+
+			if (((bytes[0] & 0x0f) == 8) && ((((NSUInteger)bytes[0] << 8) | bytes[1]) % 31 == 0))
+			{
+				return (2);
+			}
+
+			return (0);
+		break;
+
+		case OCHTTPResponseBodyDecoderFormatBrotli:
+			return (0);
+		break;
+	}
+
+	return (OCHTTPResponseBodyDecoderHeaderInvalid);
+}
+
+#pragma mark - Decoding
+- (NSData *)_failWithError:(NSError **)outError
+{
+	_failed = YES;
+
+	if (outError != NULL)
+	{
+		*outError = OCError(OCErrorResponseUnknownFormat);
+	}
+
+	return (nil);
+}
+
+- (NSData *)_processBytes:(const uint8_t *)bytes length:(NSUInteger)length finalize:(BOOL)finalize error:(NSError **)outError
+{
+	NSMutableData *decodedData = [NSMutableData new];
+	uint8_t buffer[32768];
+
+	_stream.src_ptr = bytes;
+	_stream.src_size = length;
+
+	while (_phase == OCHTTPResponseBodyDecoderPhaseBody)
+	{
+		compression_status status;
+		size_t sourceSizeBefore = _stream.src_size, decodedLength;
+
+		_stream.dst_ptr = buffer;
+		_stream.dst_size = sizeof(buffer);
+
+		status = compression_stream_process(&_stream, (finalize ? COMPRESSION_STREAM_FINALIZE : 0));
+
+		if (status == COMPRESSION_STATUS_ERROR)
+		{
+			return ([self _failWithError:outError]);
+		}
+
+		decodedLength = sizeof(buffer) - _stream.dst_size;
+		[decodedData appendBytes:buffer length:decodedLength];
+
+		if (status == COMPRESSION_STATUS_END)
+		{
+			_phase = OCHTTPResponseBodyDecoderPhaseEnd;
+		}
+		else if ((_stream.dst_size > 0) && ((_stream.src_size == 0) || (_stream.src_size == sourceSizeBefore)))
+		{
+			// All input consumed (or no progress possible) and no more output pending
+			if (finalize)
+			{
+				// Finalizing without reaching the end => truncated
+				return ([self _failWithError:outError]);
+			}
+			break;
+		}
+		else if ((decodedLength == 0) && (_stream.src_size == sourceSizeBefore))
+		{
+			// No progress
+			return ([self _failWithError:outError]);
+		}
+	}
+
+	_decodedByteCount += decodedData.length;
+
+	return (decodedData);
+}
+
+- (NSData *)decodeData:(NSData *)data error:(NSError **)outError
+{
+	const uint8_t *bytes = (const uint8_t *)data.bytes;
+	NSUInteger length = data.length;
+
+	if (_failed)
+	{
+		return ([self _failWithError:outError]);
+	}
+
+	_encodedByteCount += data.length;
+
+	if (_phase == OCHTTPResponseBodyDecoderPhaseHeader)
+	{
+		NSInteger headerLength;
+
+		if (_headerBuffer == nil)
+		{
+			_headerBuffer = [NSMutableData new];
+		}
+
+		[_headerBuffer appendData:data];
+
+		if ((headerLength = [self _headerLength]) == OCHTTPResponseBodyDecoderHeaderIncomplete)
+		{
+			return ([NSData new]);
+		}
+
+		if (headerLength == OCHTTPResponseBodyDecoderHeaderInvalid)
+		{
+			return ([self _failWithError:outError]);
+		}
+
+		// Continue with the data following the header
+		data = [_headerBuffer subdataWithRange:NSMakeRange(headerLength, _headerBuffer.length - headerLength)];
+		bytes = (const uint8_t *)data.bytes;
+		length = data.length;
+
+		_headerBuffer = nil;
+		_phase = OCHTTPResponseBodyDecoderPhaseBody;
+	}
+
+	if (_phase == OCHTTPResponseBodyDecoderPhaseBody)
+	{
+		return ([self _processBytes:bytes length:length finalize:NO error:outError]);
+	}
+
+	return ([NSData new]);
+}
+
+- (NSData *)finishWithError:(NSError **)outError
+{
+	if (_failed)
+	{
+		return ([self _failWithError:outError]);
+	}
+
+	switch (_phase)
+	{
+		case OCHTTPResponseBodyDecoderPhaseHeader:
+			if (_encodedByteCount == 0)
+			{
+				// Empty body
+				return ([NSData new]);
+			}
+
+			return ([self _failWithError:outError]);
+		break;
+
+		case OCHTTPResponseBodyDecoderPhaseBody:
+			return ([self _processBytes:NULL length:0 finalize:YES error:outError]);
+		break;
+
+		case OCHTTPResponseBodyDecoderPhaseEnd:
+			return ([NSData new]);
+		break;
+	}
+
+	return (nil);
+}
+
++ (NSData *)decodeData:(NSData *)data withContentEncoding:(NSString *)contentEncoding error:(NSError **)outError
+{
+	OCHTTPResponseBodyDecoder *decoder;
+	NSMutableData *decodedData = nil;
+	NSData *decodedChunk;
+
+	if ((decoder = [self decoderForContentEncoding:contentEncoding]) == nil)
+	{
+		if (outError != NULL)
+		{
+			*outError = OCError(OCErrorResponseUnknownFormat);
+		}
+
+		return (nil);
+	}
+
+	if ((decodedChunk = [decoder decodeData:data error:outError]) != nil)
+	{
+		decodedData = [decodedChunk mutableCopy];
+
+		if ((decodedChunk = [decoder finishWithError:outError]) != nil)
+		{
+			[decodedData appendData:decodedChunk];
+			return (decodedData);
+		}
+	}
+
+	return (nil);
+}
+
+@end
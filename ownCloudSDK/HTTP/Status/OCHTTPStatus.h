@@ -30,6 +30,7 @@ typedef NS_ENUM(NSUInteger, OCHTTPStatusCode)
 	// Redirection (3xx)
 	OCHTTPStatusCodeMOVED_PERMANENTLY = 301,
 	OCHTTPStatusCodeMOVED_TEMPORARILY = 302,
+	OCHTTPStatusCodeNOT_MODIFIED = 304,
 	OCHTTPStatusCodeTEMPORARY_REDIRECT = 307,
 	OCHTTPStatusCodePERMANENT_REDIRECT = 308,
 
@@ -42,7 +43,9 @@ typedef NS_ENUM(NSUInteger, OCHTTPStatusCode)
 	OCHTTPStatusCodeCONFLICT = 409,
 	OCHTTPStatusCodePRECONDITION_FAILED = 412,
 	OCHTTPStatusCodePAYLOAD_TOO_LARGE = 413,
+	OCHTTPStatusCodeRANGE_NOT_SATISFIABLE = 416,
 	OCHTTPStatusCodeLOCKED = 423,
+	OCHTTPStatusCodeTOO_MANY_REQUESTS = 429,
 
 	// Server Error (5xx)
 	OCHTTPStatusCodeINTERNAL_SERVER_ERROR = 500,
@@ -84,6 +84,10 @@
 			return (@"MOVED TEMPORARILY");
 		break;
 
+		case OCHTTPStatusCodeNOT_MODIFIED:
+			return (@"NOT MODIFIED");
+		break;
+
 		case OCHTTPStatusCodeTEMPORARY_REDIRECT:
 			return (@"TEMPORARY REDIRECT");
 		break;
@@ -124,10 +128,18 @@
 			return (@"PAYLOAD TOO LARGE");
 		break;
 
+		case OCHTTPStatusCodeRANGE_NOT_SATISFIABLE:
+			return (@"RANGE NOT SATISFIABLE");
+		break;
+
 		case OCHTTPStatusCodeLOCKED:
 			return (@"LOCKED");
 		break;
 
+		case OCHTTPStatusCodeTOO_MANY_REQUESTS:
+			return (@"TOO MANY REQUESTS");
+		break;
+
 		case OCHTTPStatusCodeINTERNAL_SERVER_ERROR:
 			return (@"INTERNAL SERVER ERROR");
 		break;
@@ -0,0 +1,35 @@
+//
+//  OCHostSimulator+Replay.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCHostSimulator.h"
+#import "OCHostSimulatorRecorder.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCHostSimulator (Replay)
+
+/// Host Simulator replaying the responses of an archive recorded by OCHostSimulatorRecorder.
+/// Requests are matched by method, path, query, Depth header and request body. Requests matching several recorded entries receive the recorded responses in recording order, with the last one repeated once all others were served. Requests without a match receive a 404 response.
+/// @param archiveURL URL of the archive directory
+/// @param timeScale Factor applied to the recorded durations before a response is returned: 1.0 replays with recorded timing, 0.5 twice as fast, 0 without any delay.
+/// @param outError Error reading the archive (if any)
++ (nullable instancetype)replaySimulatorForArchiveAtURL:(NSURL *)archiveURL timeScale:(double)timeScale error:(NSError * _Nullable * _Nullable)outError;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,147 @@
+//
+//  OCHostSimulator+Replay.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCHostSimulator+Replay.h"
+#import "NSData+OCHash.h"
+#import "OCLogger.h"
+
+@implementation OCHostSimulator (Replay)
+
++ (NSString *)_replayKeyForMethod:(nullable NSString *)method path:(nullable NSString *)path query:(nullable NSString *)query depth:(nullable NSString *)depth bodyHash:(nullable NSString *)bodyHash
+{
+	return ([NSString stringWithFormat:@"%@ %@?%@ depth=%@ body=%@", method, path, ((query != nil) ? query : @""), ((depth != nil) ? depth : @""), ((bodyHash != nil) ? bodyHash : @"")]);
+}
+
++ (instancetype)replaySimulatorForArchiveAtURL:(NSURL *)archiveURL timeScale:(double)timeScale error:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSArray<OCHostSimulatorRecordingEntry> *entries;
+	NSMutableDictionary<NSString *, NSMutableArray<OCHostSimulatorRecordingEntry> *> *entriesByKey = [NSMutableDictionary new];
+	OCHostSimulator *hostSimulator;
+
+	if ((entries = [OCHostSimulatorRecorder entriesFromArchiveAtURL:archiveURL error:outError]) == nil)
+	{
+		return (nil);
+	}
+
+	for (OCHostSimulatorRecordingEntry entry in entries)
+	{
+		NSString *key = [self _replayKeyForMethod:entry[OCHostSimulatorRecordingKeyMethod] path:entry[OCHostSimulatorRecordingKeyPath] query:entry[OCHostSimulatorRecordingKeyQuery] depth:entry[OCHostSimulatorRecordingKeyRequestHeaders][OCHTTPHeaderFieldNameDepth] bodyHash:entry[OCHostSimulatorRecordingKeyRequestBodyHash]];
+		NSMutableArray<OCHostSimulatorRecordingEntry> *keyEntries;
+
+		if ((keyEntries = entriesByKey[key]) == nil)
+		{
+			keyEntries = [NSMutableArray new];
+			entriesByKey[key] = keyEntries;
+		}
+
+		[keyEntries addObject:entry];
+	}
+
+	hostSimulator = [OCHostSimulator new]; // Keep default handler for unroutable requests (404)
+
+	hostSimulator.requestHandler = ^BOOL(OCConnection *connection, OCHTTPRequest *request, OCHostSimulatorResponseHandler responseHandler) {
+		NSURL *url = (request.effectiveURL != nil) ? request.effectiveURL : request.url;
+		NSString *key = [OCHostSimulator _replayKeyForMethod:request.method path:url.path query:url.query depth:request.headerFields[OCHTTPHeaderFieldNameDepth] bodyHash:[request.bodyData.sha256Hash asHexStringWithSeparator:nil lowercase:YES]];
+		OCHostSimulatorRecordingEntry entry = nil;
+		OCHostSimulatorResponse *response = nil;
+		NSError *error = nil;
+		NSTimeInterval delay;
+
+		@synchronized(entriesByKey)
+		{
+			NSMutableArray<OCHostSimulatorRecordingEntry> *keyEntries = entriesByKey[key];
+
+			entry = keyEntries.firstObject;
+
+			if (keyEntries.count > 1)
+			{
+				[keyEntries removeObjectAtIndex:0];
+			}
+		}
+
+		if (entry == nil)
+		{
+			OCLogWarning(@"Replay: no recorded response for %@", OCLogPrivate(key));
+			return (NO);
+		}
+
+		if (entry[OCHostSimulatorRecordingKeyStatusCode] != nil)
+		{
+			NSString *bodyFile;
+
+			response = [OCHostSimulatorResponse new];
+			response.url = request.url;
+			response.statusCode = ((NSNumber *)entry[OCHostSimulatorRecordingKeyStatusCode]).integerValue;
+			response.httpHeaders = entry[OCHostSimulatorRecordingKeyResponseHeaders];
+
+			if ((bodyFile = entry[OCHostSimulatorRecordingKeyBodyFile]) != nil)
+			{
+				NSURL *bodyFileURL = [archiveURL URLByAppendingPathComponent:bodyFile isDirectory:NO];
+
+				if (request.downloadRequest)
+				{
+					// Hand out a copy, so the recording stays intact when the body file is moved or removed by the receiver. Like
+					// OCHTTPPipeline, place it at the requested location - or in a temporary file that's removed after delivery
+					NSURL *copyBodyURL = request.downloadedFileURL;
+					BOOL copyIsTemporary = request.downloadedFileIsTemporary;
+
+					if (copyBodyURL == nil)
+					{
+						copyBodyURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+						copyIsTemporary = YES;
+					}
+					else if ([NSFileManager.defaultManager fileExistsAtPath:copyBodyURL.path])
+					{
+						[NSFileManager.defaultManager removeItemAtURL:copyBodyURL error:NULL];
+					}
+
+					if ([NSFileManager.defaultManager copyItemAtURL:bodyFileURL toURL:copyBodyURL error:NULL])
+					{
+						response.bodyURL = copyBodyURL;
+						response.bodyURLIsTemporary = copyIsTemporary;
+					}
+				}
+				else
+				{
+					response.bodyURL = bodyFileURL;
+				}
+			}
+		}
+		else
+		{
+			error = [NSError errorWithDomain:entry[OCHostSimulatorRecordingKeyErrorDomain] code:((NSNumber *)entry[OCHostSimulatorRecordingKeyErrorCode]).integerValue userInfo:nil];
+		}
+
+		if ((delay = ((NSNumber *)entry[OCHostSimulatorRecordingKeyDuration]).doubleValue * timeScale) > 0)
+		{
+			dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+				responseHandler(error, response);
+			});
+		}
+		else
+		{
+			responseHandler(error, response);
+		}
+
+		return (YES);
+	};
+
+	return (hostSimulator);
+}
+
+@end
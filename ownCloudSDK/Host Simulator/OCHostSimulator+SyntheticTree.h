@@ -0,0 +1,39 @@
+//
+//  OCHostSimulator+SyntheticTree.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCHostSimulator.h"
+#import "OCHostSimulatorSyntheticTree.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCHostSimulator (SyntheticTree)
+
+/// Host Simulator serving a synthetic server backed by tree, including
+/// - status.php, OCS capabilities and user endpoints
+/// - WebDAV: PROPFIND (Depth 0, 1 and infinity), GET (incl. Range and If-Match), PUT, MKCOL and DELETE
+/// - sync-collection REPORT (RFC 6578) on the root folder, serving the tree's change log (incl. DAV:limit paging). The current sync token is returned for PROPFINDs of DAV:sync-token on the root folder.
+/// - TUS uploads (creation, creation-with-upload, PATCH and HEAD)
+/// Mutations received via WebDAV and TUS are applied to tree. Requests not covered receive a 404 response.
+/// @param tree The synthetic tree to serve
+/// @param userName The user name of the simulated user (defaults to "admin" if nil)
++ (instancetype)syntheticTreeSimulatorWithTree:(OCHostSimulatorSyntheticTree *)tree userName:(nullable NSString *)userName;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,695 @@
+//
+//  OCHostSimulator+SyntheticTree.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCHostSimulator+SyntheticTree.h"
+#import "NSDate+OCDateParser.h"
+#import "OCTUSHeader.h"
+#import "NSString+TUSMetadata.h"
+
+@implementation OCHostSimulator (SyntheticTree)
+
+#pragma mark - Helpers
++ (NSString *)_syntheticTreeXMLEscapedString:(NSString *)string
+{
+	string = [string stringByReplacingOccurrencesOfString:@"&" withString:@"&amp;"];
+	string = [string stringByReplacingOccurrencesOfString:@"<" withString:@"&lt;"];
+	string = [string stringByReplacingOccurrencesOfString:@">" withString:@"&gt;"];
+
+	return (string);
+}
+
++ (NSData *)_syntheticTreeBodyDataOfRequest:(OCHTTPRequest *)request
+{
+	if (request.bodyData != nil)
+	{
+		return (request.bodyData);
+	}
+
+	if (request.bodyURL != nil)
+	{
+		return ([NSData dataWithContentsOfURL:request.bodyURL]);
+	}
+
+	return ([NSData new]);
+}
+
++ (BOOL)_syntheticTreeWriteString:(NSString *)string toStream:(NSOutputStream *)stream
+{
+	NSData *data = [string dataUsingEncoding:NSUTF8StringEncoding];
+	const uint8_t *bytes = data.bytes;
+	NSUInteger offset = 0;
+
+	while (offset < data.length)
+	{
+		NSInteger written;
+
+		if ((written = [stream write:&bytes[offset] maxLength:(data.length - offset)]) <= 0)
+		{
+			return (NO);
+		}
+
+		offset += (NSUInteger)written;
+	}
+
+	return (YES);
+}
+
++ (OCHostSimulatorResponse *)_syntheticTreeResponseForURL:(NSURL *)url statusCode:(OCHTTPStatusCode)statusCode headers:(NSDictionary<NSString *,NSString *> *)headers JSON:(id)jsonObject
+{
+	return ([OCHostSimulatorResponse responseWithURL:url statusCode:statusCode headers:headers contentType:@"application/json; charset=utf-8" bodyData:[NSJSONSerialization dataWithJSONObject:jsonObject options:0 error:NULL]]);
+}
+
++ (NSDictionary<NSString *,NSString *> *)_syntheticTreeHeadersForItem:(OCHostSimulatorSyntheticTreeItem *)item
+{
+	return (@{
+		@"ETag" 	 : item.eTag,
+		@"OC-ETag" 	 : item.eTag,
+		@"OC-FileId" 	 : item.fileID,
+		@"Last-Modified" : item.lastModified.davDateString
+	});
+}
+
+#pragma mark - Server information
++ (NSDictionary<NSString *, id> *)_syntheticTreeServerStatus
+{
+	return (@{
+		@"installed" 	  : @(YES),
+		@"maintenance" 	  : @(NO),
+		@"needsDbUpgrade" : @(NO),
+		@"version" 	  : @"10.11.0.0",
+		@"versionstring"  : @"10.11.0",
+		@"edition" 	  : @"Community",
+		@"productname" 	  : @"ownCloud",
+		@"product" 	  : @"ownCloud"
+	});
+}
+
++ (NSDictionary<NSString *, id> *)_syntheticTreeOCSResponseWithData:(id)data
+{
+	return (@{
+		@"ocs" : @{
+			@"meta" : @{
+				@"status" 	: @"ok",
+				@"statuscode" 	: @(200),
+				@"message" 	: @"OK"
+			},
+			@"data" : data
+		}
+	});
+}
+
++ (NSDictionary<NSString *, id> *)_syntheticTreeCapabilities
+{
+	return ([self _syntheticTreeOCSResponseWithData:@{
+		@"version" : @{
+			@"major" 	: @(10),
+			@"minor" 	: @(11),
+			@"micro" 	: @(0),
+			@"string" 	: @"10.11.0",
+			@"edition" 	: @"Community",
+			@"product" 	: @"ownCloud"
+		},
+		@"capabilities" : @{
+			@"core" : @{
+				@"pollinterval" : @(60),
+				@"webdav-root" 	: @"remote.php/webdav",
+				@"status" 	: [self _syntheticTreeServerStatus]
+			},
+			@"dav" : @{
+				@"chunking" 	: @"1.0",
+				@"reports" 	: @[ @"search-files" ],
+				@"propfind" 	: @{
+					@"depth_infinity" : @(YES)
+				}
+			},
+			@"files" : @{
+				@"bigfilechunking" : @(YES),
+				@"privateLinks"    : @(YES),
+				@"tus_support" 	   : @{
+					@"version" 		: @"1.0.0",
+					@"resumable" 		: @"1.0.0",
+					@"extension" 		: @"creation,creation-with-upload",
+					@"max_chunk_size" 	: @(10000000),
+					@"http_method_override" : @""
+				}
+			}
+		}
+	}]);
+}
+
+#pragma mark - WebDAV
++ (NSString *)_syntheticTreePropfindXMLForItem:(OCHostSimulatorSyntheticTreeItem *)item tree:(OCHostSimulatorSyntheticTree *)tree hrefPrefix:(NSString *)hrefPrefix userName:(NSString *)userName includeChecksums:(BOOL)includeChecksums syncToken:(NSString *)syncToken
+{
+	NSMutableString *xml = [NSMutableString new];
+	NSString *href = [hrefPrefix stringByAppendingString:[item.path stringByAddingPercentEncodingWithAllowedCharacters:NSCharacterSet.URLPathAllowedCharacterSet]];
+
+	[xml appendFormat:@"<d:response><d:href>%@</d:href><d:propstat><d:prop>", [self _syntheticTreeXMLEscapedString:href]];
+
+	if (item.isFolder)
+	{
+		// Recursive folder sizes would require a walk of the (possibly huge) subtree, so folders report a size of 0
+		[xml appendString:@"<d:resourcetype><d:collection/></d:resourcetype><d:quota-available-bytes>-3</d:quota-available-bytes><d:quota-used-bytes>0</d:quota-used-bytes><oc:size>0</oc:size><oc:permissions>RDNVCK</oc:permissions>"];
+	}
+	else
+	{
+		[xml appendFormat:@"<d:resourcetype/><d:getcontentlength>%llu</d:getcontentlength><d:getcontenttype>text/plain</d:getcontenttype><oc:size>%llu</oc:size><oc:permissions>RDNVW</oc:permissions>", item.size, item.size];
+
+		if (includeChecksums)
+		{
+			[xml appendFormat:@"<oc:checksums><oc:checksum>SHA1:%@</oc:checksum></oc:checksums>", [tree sha1ChecksumOfFileAtPath:item.path]];
+		}
+	}
+
+	[xml appendFormat:@"<d:getlastmodified>%@</d:getlastmodified><d:getetag>%@</d:getetag><oc:id>%@</oc:id><oc:owner-id>%@</oc:owner-id><oc:owner-display-name>%@</oc:owner-display-name>", item.lastModified.davDateString, item.eTag, item.fileID, [self _syntheticTreeXMLEscapedString:userName], [self _syntheticTreeXMLEscapedString:userName]];
+
+	if (syncToken != nil)
+	{
+		[xml appendFormat:@"<d:sync-token>%@</d:sync-token>", [self _syntheticTreeXMLEscapedString:syncToken]];
+	}
+
+	[xml appendString:@"</d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>\n"];
+
+	return (xml);
+}
+
++ (OCHostSimulatorResponse *)_syntheticTreePropfindResponseForRequest:(OCHTTPRequest *)request url:(NSURL *)url tree:(OCHostSimulatorSyntheticTree *)tree path:(OCPath)path hrefPrefix:(NSString *)hrefPrefix userName:(NSString *)userName
+{
+	OCHostSimulatorSyntheticTreeItem *rootItem;
+	NSString *depth = request.headerFields[OCHTTPHeaderFieldNameDepth];
+	NSString *requestBody = [[NSString alloc] initWithData:[self _syntheticTreeBodyDataOfRequest:request] encoding:NSUTF8StringEncoding];
+	BOOL includeChecksums = [requestBody containsString:@"checksums"];
+	NSUInteger maximumInfinityItemCount = tree.maximumInfinityItemCount, itemCount = 0;
+	NSMutableArray<OCPath> *folderPaths = [NSMutableArray new];
+	NSURL *bodyURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+	NSOutputStream *bodyStream;
+	NSMutableString *xml;
+	OCHostSimulatorResponse *response;
+	NSMutableDictionary<NSString *,NSString *> *headers;
+	NSNumber *bodySize = nil;
+	BOOL success = YES, limitExceeded = NO;
+
+	if ((rootItem = [tree itemAtPath:path]) == nil)
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeNOT_FOUND headers:@{} contentType:@"application/xml; charset=utf-8" body:nil]);
+	}
+
+	if ([request.headerFields[OCHTTPHeaderFieldNameIfNoneMatch] isEqual:rootItem.eTag])
+	{
+		// Unchanged since the client last retrieved it
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeNOT_MODIFIED headers:@{ @"ETag" : rootItem.eTag } contentType:@"application/xml; charset=utf-8" body:nil]);
+	}
+
+	// Stream the multistatus to a file as the tree is walked, so that the size of the tree isn't limited by memory
+	bodyStream = [NSOutputStream outputStreamWithURL:bodyURL append:NO];
+	[bodyStream open];
+
+	xml = [NSMutableString stringWithString:@"<?xml version=\"1.0\"?>\n<d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">\n"];
+	[xml appendString:[self _syntheticTreePropfindXMLForItem:rootItem tree:tree hrefPrefix:hrefPrefix userName:userName includeChecksums:includeChecksums syncToken:(([requestBody containsString:@"sync-token"] && [rootItem.path isEqual:@"/"]) ? tree.syncToken : nil)]];
+	itemCount++;
+
+	if (rootItem.isFolder && ![depth isEqual:@"0"])
+	{
+		// Depth 1 - or depth infinity (also the default for a missing Depth header)
+		BOOL infinite = ![depth isEqual:@"1"];
+
+		[folderPaths addObject:rootItem.path];
+
+		while (success && (folderPaths.count > 0))
+		{
+			OCPath folderPath = folderPaths.firstObject;
+
+			[folderPaths removeObjectAtIndex:0];
+
+			@autoreleasepool
+			{
+				for (OCHostSimulatorSyntheticTreeItem *item in [tree childrenOfFolderAtPath:folderPath])
+				{
+					if (infinite && (maximumInfinityItemCount > 0) && (++itemCount > maximumInfinityItemCount))
+					{
+						limitExceeded = YES;
+						success = NO;
+						break;
+					}
+
+					if (infinite && item.isFolder)
+					{
+						[folderPaths addObject:item.path];
+					}
+
+					[xml appendString:[self _syntheticTreePropfindXMLForItem:item tree:tree hrefPrefix:hrefPrefix userName:userName includeChecksums:includeChecksums syncToken:nil]];
+
+					if (xml.length >= 65536)
+					{
+						if (!(success = [self _syntheticTreeWriteString:xml toStream:bodyStream]))
+						{
+							break;
+						}
+
+						[xml setString:@""];
+					}
+				}
+			}
+		}
+	}
+
+	[xml appendString:@"</d:multistatus>\n"];
+
+	if (success)
+	{
+		success = [self _syntheticTreeWriteString:xml toStream:bodyStream];
+	}
+
+	[bodyStream close];
+
+	if (!success)
+	{
+		[NSFileManager.defaultManager removeItemAtURL:bodyURL error:NULL];
+
+		if (limitExceeded)
+		{
+			return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeFORBIDDEN headers:@{} contentType:@"application/xml; charset=utf-8" body:@"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<d:error xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\"><d:propfind-finite-depth/><s:message>PROPFIND requests with a Depth of \"infinity\" are not allowed for this collection.</s:message></d:error>"]);
+		}
+
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeINTERNAL_SERVER_ERROR headers:@{} contentType:@"application/xml; charset=utf-8" body:nil]);
+	}
+
+	response = [OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeMULTI_STATUS headers:@{ @"ETag" : rootItem.eTag } contentType:@"application/xml; charset=utf-8" bodyData:nil];
+
+	headers = [response.httpHeaders mutableCopy];
+	[bodyURL getResourceValue:&bodySize forKey:NSURLFileSizeKey error:NULL];
+	headers[OCHTTPHeaderFieldNameContentLength] = bodySize.stringValue;
+	response.httpHeaders = headers;
+
+	if (request.downloadRequest)
+	{
+		// Downloads receive the file, which the receiver can take ownership of - or is removed after delivery
+		response.bodyURL = bodyURL;
+		response.bodyURLIsTemporary = YES;
+	}
+	else
+	{
+		response.bodyData = [NSData dataWithContentsOfURL:bodyURL options:NSDataReadingMappedIfSafe error:NULL];
+		[NSFileManager.defaultManager removeItemAtURL:bodyURL error:NULL];
+	}
+
+	return (response);
+}
+
++ (OCHostSimulatorResponse *)_syntheticTreeSyncCollectionResponseForRequest:(OCHTTPRequest *)request url:(NSURL *)url tree:(OCHostSimulatorSyntheticTree *)tree path:(OCPath)path hrefPrefix:(NSString *)hrefPrefix userName:(NSString *)userName
+{
+	NSString *requestBody = [[NSString alloc] initWithData:[self _syntheticTreeBodyDataOfRequest:request] encoding:NSUTF8StringEncoding];
+	NSRegularExpression *syncTokenExpression = [NSRegularExpression regularExpressionWithPattern:@"sync-token>([^<]*)<" options:0 error:NULL];
+	NSRegularExpression *limitExpression = [NSRegularExpression regularExpressionWithPattern:@"nresults>\\s*([0-9]+)\\s*<" options:0 error:NULL];
+	NSTextCheckingResult *match;
+	NSString *syncToken = nil, *nextSyncToken = nil;
+	NSUInteger limit = 0;
+	BOOL includeChecksums = [requestBody containsString:@"checksums"], truncated = NO;
+	NSArray<OCPath> *changedPaths = nil;
+	NSMutableString *xml;
+
+	if (![requestBody containsString:@"sync-collection"] || ![[path stringByTrimmingCharactersInSet:[NSCharacterSet characterSetWithCharactersInString:@"/"]] isEqual:@""])
+	{
+		// Other REPORTs - and sync-collection below the root folder - aren't supported
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeFORBIDDEN headers:@{} contentType:@"application/xml; charset=utf-8" body:@"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<d:error xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\"><d:supported-report/><s:exception>Sabre\\DAV\\Exception\\ReportNotSupported</s:exception><s:message>The {DAV:}sync-collection REPORT is only supported on the root folder</s:message></d:error>"]);
+	}
+
+	if ((match = [syncTokenExpression firstMatchInString:requestBody options:0 range:NSMakeRange(0, requestBody.length)]) != nil)
+	{
+		syncToken = [requestBody substringWithRange:[match rangeAtIndex:1]];
+	}
+
+	if ((match = [limitExpression firstMatchInString:requestBody options:0 range:NSMakeRange(0, requestBody.length)]) != nil)
+	{
+		limit = (NSUInteger)[requestBody substringWithRange:[match rangeAtIndex:1]].integerValue;
+	}
+
+	// Initial syncs (without token) would have to return the entire (possibly huge) tree and are rejected like unknown tokens - clients retrieve a token via PROPFIND instead
+	if ((syncToken.length == 0) || ((changedPaths = [tree changedPathsSinceSyncToken:syncToken limit:limit nextSyncToken:&nextSyncToken truncated:&truncated]) == nil))
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeFORBIDDEN headers:@{} contentType:@"application/xml; charset=utf-8" body:@"<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<d:error xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\"><d:valid-sync-token/><s:exception>Sabre\\DAV\\Exception\\InvalidSyncToken</s:exception><s:message>Invalid or unknown sync token</s:message></d:error>"]);
+	}
+
+	xml = [NSMutableString stringWithString:@"<?xml version=\"1.0\"?>\n<d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">\n"];
+
+	for (OCPath changedPath in changedPaths)
+	{
+		OCHostSimulatorSyntheticTreeItem *item;
+
+		if ((item = [tree itemAtPath:changedPath]) != nil)
+		{
+			[xml appendString:[self _syntheticTreePropfindXMLForItem:item tree:tree hrefPrefix:hrefPrefix userName:userName includeChecksums:includeChecksums syncToken:nil]];
+		}
+		else
+		{
+			// Removed
+			[xml appendFormat:@"<d:response><d:href>%@</d:href><d:status>HTTP/1.1 404 Not Found</d:status></d:response>\n", [self _syntheticTreeXMLEscapedString:[hrefPrefix stringByAppendingString:[changedPath stringByAddingPercentEncodingWithAllowedCharacters:NSCharacterSet.URLPathAllowedCharacterSet]]]];
+		}
+	}
+
+	if (truncated)
+	{
+		// More changes than requested: continue with the returned token
+		[xml appendFormat:@"<d:response><d:href>%@/</d:href><d:status>HTTP/1.1 507 Insufficient Storage</d:status></d:response>\n", [self _syntheticTreeXMLEscapedString:hrefPrefix]];
+	}
+
+	[xml appendFormat:@"<d:sync-token>%@</d:sync-token>\n</d:multistatus>\n", [self _syntheticTreeXMLEscapedString:nextSyncToken]];
+
+	return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeMULTI_STATUS headers:@{} contentType:@"application/xml; charset=utf-8" body:xml]);
+}
+
++ (OCHostSimulatorResponse *)_syntheticTreeGETResponseForRequest:(OCHTTPRequest *)request url:(NSURL *)url tree:(OCHostSimulatorSyntheticTree *)tree path:(OCPath)path
+{
+	OCHostSimulatorSyntheticTreeItem *item;
+	NSMutableDictionary<NSString *,NSString *> *headers;
+	NSString *ifMatch, *range;
+	OCHTTPStatusCode statusCode = OCHTTPStatusCodeOK;
+	NSData *contents;
+	OCHostSimulatorResponse *response;
+
+	if (((item = [tree itemAtPath:path]) == nil) || item.isFolder || ((contents = [tree contentsOfFileAtPath:item.path]) == nil))
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeNOT_FOUND headers:@{} contentType:@"text/html" body:nil]);
+	}
+
+	if (((ifMatch = request.headerFields[OCHTTPHeaderFieldNameIfMatch]) != nil) && ![ifMatch isEqual:item.eTag] && ![ifMatch isEqual:@"*"])
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodePRECONDITION_FAILED headers:@{} contentType:@"text/html" body:nil]);
+	}
+
+	headers = [[self _syntheticTreeHeadersForItem:item] mutableCopy];
+
+	if ([request.headerFields[OCHTTPHeaderFieldNameIfNoneMatch] isEqual:item.eTag])
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeNOT_MODIFIED headers:headers contentType:@"text/html" body:nil]);
+	}
+
+	headers[@"Accept-Ranges"] = @"bytes";
+
+	if (((range = request.headerFields[@"Range"]) != nil) && [range hasPrefix:@"bytes="])
+	{
+		// Single byte range ("bytes=first-last", "bytes=first-" or "bytes=-suffixLength")
+		NSArray<NSString *> *rangeParts = [[range substringFromIndex:6] componentsSeparatedByString:@"-"];
+		long long length = (long long)contents.length, first = -1, last = length - 1;
+
+		if (rangeParts.count == 2)
+		{
+			if (rangeParts[0].length > 0)
+			{
+				first = rangeParts[0].longLongValue;
+
+				if (rangeParts[1].length > 0)
+				{
+					last = MIN(rangeParts[1].longLongValue, length - 1);
+				}
+			}
+			else if (rangeParts[1].length > 0)
+			{
+				first = MAX(length - rangeParts[1].longLongValue, 0);
+			}
+		}
+
+		if ((first < 0) || (first >= length) || (last < first))
+		{
+			headers[@"Content-Range"] = [NSString stringWithFormat:@"bytes */%lld", length];
+
+			return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeRANGE_NOT_SATISFIABLE headers:headers contentType:@"text/html" body:nil]);
+		}
+
+		headers[@"Content-Range"] = [NSString stringWithFormat:@"bytes %lld-%lld/%lld", first, last, length];
+		contents = [contents subdataWithRange:NSMakeRange((NSUInteger)first, (NSUInteger)(last - first + 1))];
+		statusCode = OCHTTPStatusCodePARTIAL_CONTENT;
+	}
+
+	response = [OCHostSimulatorResponse responseWithURL:url statusCode:statusCode headers:headers contentType:@"text/plain" bodyData:contents];
+
+	if (request.downloadRequest)
+	{
+		// Downloads receive a file the receiver can take ownership of - or is removed after delivery
+		NSURL *temporaryBodyURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:NSUUID.UUID.UUIDString]];
+
+		if ([contents writeToURL:temporaryBodyURL atomically:NO])
+		{
+			response.bodyData = nil;
+			response.bodyURL = temporaryBodyURL;
+			response.bodyURLIsTemporary = YES;
+		}
+	}
+
+	return (response);
+}
+
++ (OCHostSimulatorResponse *)_syntheticTreePUTResponseForRequest:(OCHTTPRequest *)request url:(NSURL *)url tree:(OCHostSimulatorSyntheticTree *)tree path:(OCPath)path
+{
+	OCHostSimulatorSyntheticTreeItem *existingItem = [tree itemAtPath:path], *item;
+	NSString *ifMatch;
+
+	if (existingItem.isFolder)
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeCONFLICT headers:@{} contentType:@"text/html" body:nil]);
+	}
+
+	if (((ifMatch = request.headerFields[OCHTTPHeaderFieldNameIfMatch]) != nil) && ![ifMatch isEqual:existingItem.eTag])
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodePRECONDITION_FAILED headers:@{} contentType:@"text/html" body:nil]);
+	}
+
+	if ((item = [tree writeFileAtPath:path contents:[self _syntheticTreeBodyDataOfRequest:request]]) == nil)
+	{
+		// Parent folder doesn't exist
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeCONFLICT headers:@{} contentType:@"text/html" body:nil]);
+	}
+
+	return ([OCHostSimulatorResponse responseWithURL:url statusCode:((existingItem != nil) ? OCHTTPStatusCodeNO_CONTENT : OCHTTPStatusCodeCREATED) headers:[self _syntheticTreeHeadersForItem:item] contentType:@"text/html" body:nil]);
+}
+
+#pragma mark - TUS
++ (NSDictionary<NSString *,NSString *> *)_syntheticTreeTUSHeadersWithOffset:(NSUInteger)offset length:(NSUInteger)length
+{
+	return (@{
+		OCTUSHeaderNameTusResumable : @"1.0.0",
+		OCTUSHeaderNameTusVersion   : @"1.0.0",
+		OCTUSHeaderNameTusExtension : @"creation,creation-with-upload",
+		OCTUSHeaderNameUploadOffset : [NSString stringWithFormat:@"%lu", (unsigned long)offset],
+		OCTUSHeaderNameUploadLength : [NSString stringWithFormat:@"%lu", (unsigned long)length]
+	});
+}
+
++ (OCHostSimulatorResponse *)_syntheticTreeTUSAppendToUpload:(NSMutableDictionary<NSString *, id> *)upload request:(OCHTTPRequest *)request url:(NSURL *)url tree:(OCHostSimulatorSyntheticTree *)tree statusCode:(OCHTTPStatusCode)statusCode headers:(NSDictionary<NSString *,NSString *> *)additionalHeaders
+{
+	NSMutableData *uploadData = upload[@"data"];
+	NSUInteger uploadLength = ((NSNumber *)upload[@"length"]).unsignedIntegerValue;
+	NSData *bodyData = [self _syntheticTreeBodyDataOfRequest:request];
+	NSMutableDictionary<NSString *,NSString *> *headers;
+
+	if ((uploadData.length + bodyData.length) > uploadLength)
+	{
+		return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodePAYLOAD_TOO_LARGE headers:[self _syntheticTreeTUSHeadersWithOffset:uploadData.length length:uploadLength] contentType:@"text/plain" body:nil]);
+	}
+
+	[uploadData appendData:bodyData];
+
+	headers = [[self _syntheticTreeTUSHeadersWithOffset:uploadData.length length:uploadLength] mutableCopy];
+	[headers addEntriesFromDictionary:additionalHeaders];
+
+	if (uploadData.length == uploadLength)
+	{
+		// Upload complete => write file
+		OCHostSimulatorSyntheticTreeItem *item;
+
+		if ((item = [tree writeFileAtPath:upload[@"path"] contents:uploadData]) == nil)
+		{
+			return ([OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeCONFLICT headers:headers contentType:@"text/plain" body:nil]);
+		}
+
+		[headers addEntriesFromDictionary:[self _syntheticTreeHeadersForItem:item]];
+	}
+
+	return ([OCHostSimulatorResponse responseWithURL:url statusCode:statusCode headers:headers contentType:@"text/plain" body:nil]);
+}
+
+#pragma mark - Simulator
++ (instancetype)syntheticTreeSimulatorWithTree:(OCHostSimulatorSyntheticTree *)tree userName:(NSString *)userName
+{
+	OCHostSimulator *hostSimulator;
+	NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, id> *> *uploadsByID = [NSMutableDictionary new];
+	NSString *davFilesPath, *davUploadsPath;
+
+	if (userName == nil)
+	{
+		userName = @"admin";
+	}
+
+	davFilesPath = [@"/remote.php/dav/files/" stringByAppendingString:userName];
+	davUploadsPath = [@"/remote.php/dav/uploads/" stringByAppendingString:userName];
+
+	hostSimulator = [OCHostSimulator new]; // Keep default handler for unroutable requests (404)
+
+	hostSimulator.requestHandler = ^BOOL(OCConnection *connection, OCHTTPRequest *request, OCHostSimulatorResponseHandler responseHandler) {
+		NSURL *url = (request.effectiveURL != nil) ? request.effectiveURL : request.url;
+		NSString *urlPath = url.path;
+		OCHTTPMethod method = request.method;
+		OCHostSimulatorResponse *response = nil;
+		NSRange davRange;
+
+		if ([urlPath hasSuffix:@"/status.php"])
+		{
+			response = [OCHostSimulator _syntheticTreeResponseForURL:url statusCode:OCHTTPStatusCodeOK headers:@{} JSON:[OCHostSimulator _syntheticTreeServerStatus]];
+		}
+		else if ([urlPath hasSuffix:@"/ocs/v2.php/cloud/capabilities"])
+		{
+			response = [OCHostSimulator _syntheticTreeResponseForURL:url statusCode:OCHTTPStatusCodeOK headers:@{} JSON:[OCHostSimulator _syntheticTreeCapabilities]];
+		}
+		else if ([urlPath hasSuffix:@"/ocs/v2.php/cloud/user"])
+		{
+			response = [OCHostSimulator _syntheticTreeResponseForURL:url statusCode:OCHTTPStatusCodeOK headers:@{} JSON:[OCHostSimulator _syntheticTreeOCSResponseWithData:@{
+				@"id" 		: userName,
+				@"display-name" : userName,
+				@"email" 	: [userName stringByAppendingString:@"@example.org"]
+			}]]];
+		}
+		else if (((davRange = [urlPath rangeOfString:davFilesPath]).location != NSNotFound) &&
+			 ((urlPath.length == NSMaxRange(davRange)) || ([urlPath characterAtIndex:NSMaxRange(davRange)] == '/')))
+		{
+			// WebDAV
+			NSString *hrefPrefix = [urlPath substringToIndex:NSMaxRange(davRange)];
+			OCPath path = [urlPath substringFromIndex:NSMaxRange(davRange)];
+
+			if (path.length == 0)
+			{
+				path = @"/";
+			}
+
+			if ([method isEqual:OCHTTPMethodPROPFIND])
+			{
+				response = [OCHostSimulator _syntheticTreePropfindResponseForRequest:request url:url tree:tree path:path hrefPrefix:[hrefPrefix stringByAddingPercentEncodingWithAllowedCharacters:NSCharacterSet.URLPathAllowedCharacterSet] userName:userName];
+			}
+			else if ([method isEqual:OCHTTPMethodREPORT])
+			{
+				response = [OCHostSimulator _syntheticTreeSyncCollectionResponseForRequest:request url:url tree:tree path:path hrefPrefix:[hrefPrefix stringByAddingPercentEncodingWithAllowedCharacters:NSCharacterSet.URLPathAllowedCharacterSet] userName:userName];
+			}
+			else if ([method isEqual:OCHTTPMethodGET])
+			{
+				response = [OCHostSimulator _syntheticTreeGETResponseForRequest:request url:url tree:tree path:path];
+			}
+			else if ([method isEqual:OCHTTPMethodPUT])
+			{
+				response = [OCHostSimulator _syntheticTreePUTResponseForRequest:request url:url tree:tree path:path];
+			}
+			else if ([method isEqual:OCHTTPMethodMKCOL])
+			{
+				OCHostSimulatorSyntheticTreeItem *item;
+
+				if ([tree itemAtPath:path] != nil)
+				{
+					response = [OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeMETHOD_NOT_ALLOWED headers:@{} contentType:@"text/html" body:nil];
+				}
+				else if ((item = [tree createFolderAtPath:path]) != nil)
+				{
+					response = [OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeCREATED headers:[OCHostSimulator _syntheticTreeHeadersForItem:item] contentType:@"text/html" body:nil];
+				}
+				else
+				{
+					response = [OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeCONFLICT headers:@{} contentType:@"text/html" body:nil];
+				}
+			}
+			else if ([method isEqual:OCHTTPMethodDELETE])
+			{
+				response = [OCHostSimulatorResponse responseWithURL:url statusCode:([tree removeItemAtPath:path] ? OCHTTPStatusCodeNO_CONTENT : OCHTTPStatusCodeNOT_FOUND) headers:@{} contentType:@"text/html" body:nil];
+			}
+			else if ([method isEqual:OCHTTPMethodPOST] && (request.headerFields[OCTUSHeaderNameUploadLength] != nil))
+			{
+				// TUS creation (and creation-with-upload)
+				OCTUSHeader *tusHeader = [[OCTUSHeader alloc] initWithHTTPHeaderFields:request.headerFields];
+				NSString *fileName = tusHeader.uploadMetadata[OCTUSMetadataKeyFileName];
+				NSString *uploadID = NSUUID.UUID.UUIDString;
+				NSURLComponents *locationComponents = [NSURLComponents componentsWithURL:url resolvingAgainstBaseURL:NO];
+				NSMutableDictionary<NSString *, id> *upload;
+				OCHostSimulatorSyntheticTreeItem *folderItem;
+
+				if (((folderItem = [tree itemAtPath:path]) == nil) || !folderItem.isFolder || (fileName.length == 0))
+				{
+					response = [OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeCONFLICT headers:@{ OCTUSHeaderNameTusResumable : @"1.0.0" } contentType:@"text/plain" body:nil];
+				}
+				else
+				{
+					upload = [@{
+						@"path"   : [folderItem.path stringByAppendingString:fileName],
+						@"length" : @(tusHeader.uploadLength.unsignedIntegerValue),
+						@"data"   : [NSMutableData new]
+					} mutableCopy];
+
+					@synchronized(uploadsByID)
+					{
+						uploadsByID[uploadID] = upload;
+					}
+
+					locationComponents.path = [NSString stringWithFormat:@"%@%@/%@", [urlPath substringToIndex:davRange.location], davUploadsPath, uploadID];
+					locationComponents.query = nil;
+
+					response = [OCHostSimulator _syntheticTreeTUSAppendToUpload:upload request:request url:url tree:tree statusCode:OCHTTPStatusCodeCREATED headers:@{ OCHTTPHeaderFieldNameLocation : locationComponents.URL.absoluteString }];
+				}
+			}
+		}
+		else if (((davRange = [urlPath rangeOfString:[davUploadsPath stringByAppendingString:@"/"]]).location != NSNotFound) && ([method isEqual:OCHTTPMethodPATCH] || [method isEqual:OCHTTPMethodHEAD]))
+		{
+			// TUS uploads
+			NSString *uploadID = [urlPath substringFromIndex:NSMaxRange(davRange)];
+			NSMutableDictionary<NSString *, id> *upload;
+
+			@synchronized(uploadsByID)
+			{
+				upload = uploadsByID[uploadID];
+			}
+
+			if (upload != nil)
+			{
+				@synchronized(upload)
+				{
+					NSUInteger offset = ((NSMutableData *)upload[@"data"]).length;
+					NSUInteger length = ((NSNumber *)upload[@"length"]).unsignedIntegerValue;
+
+					if ([method isEqual:OCHTTPMethodHEAD])
+					{
+						response = [OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeOK headers:[OCHostSimulator _syntheticTreeTUSHeadersWithOffset:offset length:length] contentType:@"text/plain" body:nil];
+					}
+					else if (request.headerFields[OCTUSHeaderNameUploadOffset].integerValue != (NSInteger)offset)
+					{
+						response = [OCHostSimulatorResponse responseWithURL:url statusCode:OCHTTPStatusCodeCONFLICT headers:[OCHostSimulator _syntheticTreeTUSHeadersWithOffset:offset length:length] contentType:@"text/plain" body:nil];
+					}
+					else
+					{
+						response = [OCHostSimulator _syntheticTreeTUSAppendToUpload:upload request:request url:url tree:tree statusCode:OCHTTPStatusCodeNO_CONTENT headers:@{}];
+					}
+				}
+			}
+		}
+
+		if (response != nil)
+		{
+			responseHandler(nil, response);
+			return (YES);
+		}
+
+		return (NO);
+	};
+
+	return (hostSimulator);
+}
+
+@end
@@ -36,6 +36,8 @@ typedef BOOL(^OCHostSimulatorRequestHandler)(OCConnection *connection, OCHTTPReq
 @property(nullable,copy) OCHostSimulatorRequestHandler requestHandler;
 @property(nullable,copy) OCHostSimulatorRequestHandler unroutableRequestHandler;
 
+@property(assign) NSTimeInterval responseDelay; //!< Time (in seconds) by which every response is delayed, f.ex. to simulate the round trip time of a distant server. Defaults to 0.
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -56,7 +56,7 @@
 	if (request.downloadRequest)
 	{
 		httpResponse.bodyURL = simulatorResponse.bodyURL;
-		httpResponse.bodyURLIsTemporary = NO;
+		httpResponse.bodyURLIsTemporary = simulatorResponse.bodyURLIsTemporary;
 	}
 	else
 	{
@@ -74,8 +74,9 @@
 	BOOL handlesRequest = YES;
 	OCHostSimulatorResponseHandler responseHandler = ^(NSError *error, OCHostSimulatorResponse *response) {
 		OCHTTPResponse *httpResponse = [self _responseForRequest:request withResponse:response error:error];
+		NSTimeInterval responseDelay = self.responseDelay;
 
-		dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(responseDelay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
 			OCLogDebug(@"Host Simulator: sent response for %@", request.url);
 //
 //			if (response.certificate != nil)
@@ -0,0 +1,69 @@
+//
+//  OCHostSimulatorRecorder.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCHTTPPipeline.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NSString* OCHostSimulatorRecordingKey NS_TYPED_ENUM;
+typedef NSDictionary<OCHostSimulatorRecordingKey, id>* OCHostSimulatorRecordingEntry;
+
+/*
+	Records request/response pairs - including their timing - into a portable archive, which can be replayed via +[OCHostSimulator replaySimulatorForArchiveAtURL:timeScale:error:].
+
+	Archive layout:
+	- recording.json: { "version" : 1, "entries" : [ … ] } with one entry per response, in the order the requests were started
+	- bodies/: one file per response body (already decoded), referenced by the entries
+
+	Credentials and cookies are not recorded (see .redactedHeaderFields).
+*/
+
+@interface OCHostSimulatorRecorder : NSObject <OCHTTPPipelineTrafficRecorder>
+
+@property(strong,readonly) NSURL *archiveURL; //!< URL of the archive directory
+
+@property(strong) NSSet<NSString *> *redactedHeaderFields; //!< Lowercased names of header fields that are not recorded. Defaults to authorization, cookie and set-cookie.
+
+@property(readonly,nonatomic) NSUInteger entryCount; //!< Number of entries recorded so far
+
+- (instancetype)initWithArchiveURL:(NSURL *)archiveURL;
+
+- (void)recordRequest:(OCHTTPRequest *)request response:(OCHTTPResponse *)response metrics:(nullable OCHTTPPipelineTaskMetrics *)metrics; //!< Records a request/response pair. Thread-safe.
+
+- (nullable NSError *)writeArchive; //!< Writes recording.json with all entries recorded so far. Can be called repeatedly.
+
++ (nullable NSArray<OCHostSimulatorRecordingEntry> *)entriesFromArchiveAtURL:(NSURL *)archiveURL error:(NSError * _Nullable * _Nullable)outError; //!< Reads the entries of an archive
+
+@end
+
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyMethod; //!< HTTP method
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyPath; //!< Path of the request URL
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyQuery; //!< Query of the request URL (if any)
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyRequestHeaders; //!< Request headers (redacted)
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyRequestBodyHash; //!< SHA-256 hash of the request body (if it was in memory)
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyStatusCode; //!< HTTP status code of the response
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyResponseHeaders; //!< Response headers (redacted)
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyBodyFile; //!< Path of the body file, relative to the archive
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyErrorDomain; //!< Domain of the error, if the request failed without a response
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyErrorCode; //!< Code of the error, if the request failed without a response
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyStartOffset; //!< Seconds between the start of the first recorded request and the start of this one
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyDuration; //!< Seconds between the start of the request and the end of the response
+extern OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyTimeToFirstByte; //!< Seconds between the start of the request and the start of the response (if known)
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,248 @@
+//
+//  OCHostSimulatorRecorder.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCHostSimulatorRecorder.h"
+#import "OCHTTPPipelineTask.h"
+#import "OCHTTPResponse.h"
+#import "NSData+OCHash.h"
+#import "NSError+OCError.h"
+#import "OCLogger.h"
+
+@interface OCHostSimulatorRecorder ()
+{
+	NSMutableArray<OCHostSimulatorRecordingEntry> *_entries;
+	NSDate *_firstStartDate;
+
+	dispatch_queue_t _bodyQueue;
+	dispatch_group_t _bodyWriteGroup;
+}
+@end
+
+@implementation OCHostSimulatorRecorder
+
+- (instancetype)initWithArchiveURL:(NSURL *)archiveURL
+{
+	if ((self = [super init]) != nil)
+	{
+		_archiveURL = archiveURL;
+		_entries = [NSMutableArray new];
+
+		_bodyQueue = dispatch_queue_create("OCHostSimulatorRecorder body queue", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL_WITH_AUTORELEASE_POOL, QOS_CLASS_UTILITY, 0));
+		_bodyWriteGroup = dispatch_group_create();
+
+		_redactedHeaderFields = [NSSet setWithObjects:@"authorization", @"cookie", @"set-cookie", nil];
+
+		[NSFileManager.defaultManager createDirectoryAtURL:[_archiveURL URLByAppendingPathComponent:@"bodies" isDirectory:YES] withIntermediateDirectories:YES attributes:nil error:NULL];
+	}
+
+	return (self);
+}
+
+- (NSUInteger)entryCount
+{
+	@synchronized(self)
+	{
+		return (_entries.count);
+	}
+}
+
+- (NSDictionary<NSString *, NSString *> *)_redactedHeaders:(NSDictionary *)headers
+{
+	NSMutableDictionary<NSString *, NSString *> *redactedHeaders = [NSMutableDictionary new];
+	NSSet<NSString *> *redactedHeaderFields = _redactedHeaderFields;
+
+	[headers enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop) {
+		if ([key isKindOfClass:NSString.class] && [value isKindOfClass:NSString.class] && ![redactedHeaderFields containsObject:((NSString *)key).lowercaseString])
+		{
+			redactedHeaders[key] = value;
+		}
+	}];
+
+	return (redactedHeaders);
+}
+
+- (void)recordRequest:(OCHTTPRequest *)request response:(OCHTTPResponse *)response metrics:(OCHTTPPipelineTaskMetrics *)metrics
+{
+	NSMutableDictionary<OCHostSimulatorRecordingKey, id> *entry = [NSMutableDictionary new];
+	NSURL *url = (request.effectiveURL != nil) ? request.effectiveURL : request.url;
+	NSDate *startDate = (request.scheduleDate != nil) ? request.scheduleDate : ((metrics.date != nil) ? metrics.date : [NSDate new]);
+	NSTimeInterval duration = -startDate.timeIntervalSinceNow;
+	NSError *error = (response.status == nil) ? response.httpError : nil;
+
+	if ((url.path == nil) || (request.method == nil))
+	{
+		return;
+	}
+
+	// Request
+	entry[OCHostSimulatorRecordingKeyMethod] = request.method;
+	entry[OCHostSimulatorRecordingKeyPath] = url.path;
+	entry[OCHostSimulatorRecordingKeyQuery] = url.query;
+	entry[OCHostSimulatorRecordingKeyRequestHeaders] = [self _redactedHeaders:request.headerFields];
+	entry[OCHostSimulatorRecordingKeyRequestBodyHash] = [request.bodyData.sha256Hash asHexStringWithSeparator:nil lowercase:YES];
+
+	// Response
+	if (response.status != nil)
+	{
+		NSMutableDictionary<NSString *, NSString *> *responseHeaders = [[self _redactedHeaders:response.headerFields] mutableCopy];
+
+		// Bodies are recorded decoded
+		[responseHeaders removeObjectForKey:@"Content-Encoding"];
+		[responseHeaders removeObjectForKey:@"content-encoding"];
+
+		entry[OCHostSimulatorRecordingKeyStatusCode] = @(response.status.code);
+		entry[OCHostSimulatorRecordingKeyResponseHeaders] = responseHeaders;
+	}
+	else if (error != nil)
+	{
+		entry[OCHostSimulatorRecordingKeyErrorDomain] = error.domain;
+		entry[OCHostSimulatorRecordingKeyErrorCode] = @(error.code);
+	}
+	else
+	{
+		return;
+	}
+
+	// Timing
+	entry[OCHostSimulatorRecordingKeyDuration] = @(MAX(duration, 0));
+	entry[OCHostSimulatorRecordingKeyTimeToFirstByte] = metrics.timeToFirstByteInterval;
+
+	@synchronized(self)
+	{
+		NSString *bodyFile = [NSString stringWithFormat:@"bodies/%06lu", (unsigned long)_entries.count];
+		NSURL *bodyFileURL = [_archiveURL URLByAppendingPathComponent:bodyFile isDirectory:NO];
+		NSData *bodyData = nil;
+
+		if ((_firstStartDate == nil) || ([startDate compare:_firstStartDate] == NSOrderedAscending))
+		{
+			_firstStartDate = startDate;
+		}
+
+		entry[OCHostSimulatorRecordingKeyStartOffset] = @([startDate timeIntervalSinceDate:_firstStartDate]);
+
+		// Body - this is called on the pipeline's queue, so only take a cheap snapshot here (the body file may be moved or removed right after
+		// delivery) and leave the copying to the body queue
+		if (response.bodyURL != nil)
+		{
+			if ([NSFileManager.defaultManager linkItemAtURL:response.bodyURL toURL:bodyFileURL error:NULL])
+			{
+				// Hard link on the same volume => done
+				entry[OCHostSimulatorRecordingKeyBodyFile] = bodyFile;
+			}
+			else
+			{
+				// Mapped data keeps the contents available even if the file is removed
+				bodyData = [NSData dataWithContentsOfURL:response.bodyURL options:NSDataReadingMappedAlways error:NULL];
+			}
+		}
+		else if (response.bodyData.length > 0)
+		{
+			bodyData = [response.bodyData copy];
+		}
+
+		if (bodyData.length > 0)
+		{
+			entry[OCHostSimulatorRecordingKeyBodyFile] = bodyFile;
+
+			dispatch_group_async(_bodyWriteGroup, _bodyQueue, ^{
+				if (![bodyData writeToURL:bodyFileURL atomically:NO])
+				{
+					@synchronized(self)
+					{
+						[entry removeObjectForKey:OCHostSimulatorRecordingKeyBodyFile];
+					}
+				}
+			});
+		}
+
+		[_entries addObject:entry];
+	}
+}
+
+- (NSError *)writeArchive
+{
+	NSError *error = nil;
+	NSData *jsonData;
+
+	// Wait for pending body files
+	dispatch_group_wait(_bodyWriteGroup, DISPATCH_TIME_FOREVER);
+
+	@synchronized(self)
+	{
+		if ((jsonData = [NSJSONSerialization dataWithJSONObject:@{ @"version" : @(1), @"entries" : _entries } options:0 error:&error]) != nil)
+		{
+			[jsonData writeToURL:[_archiveURL URLByAppendingPathComponent:@"recording.json" isDirectory:NO] options:NSDataWritingAtomic error:&error];
+		}
+	}
+
+	if (error != nil)
+	{
+		OCLogError(@"Error writing recording archive to %@: %@", _archiveURL, error);
+	}
+
+	return (error);
+}
+
++ (NSArray<OCHostSimulatorRecordingEntry> *)entriesFromArchiveAtURL:(NSURL *)archiveURL error:(NSError * _Nullable __autoreleasing *)outError
+{
+	NSData *jsonData;
+	NSDictionary *recording;
+	NSError *error = nil;
+
+	if ((jsonData = [NSData dataWithContentsOfURL:[archiveURL URLByAppendingPathComponent:@"recording.json" isDirectory:NO] options:0 error:&error]) != nil)
+	{
+		if ((recording = [NSJSONSerialization JSONObjectWithData:jsonData options:0 error:&error]) != nil)
+		{
+			if ([recording isKindOfClass:NSDictionary.class] && [recording[@"version"] isEqual:@(1)] && [recording[@"entries"] isKindOfClass:NSArray.class])
+			{
+				return (recording[@"entries"]);
+			}
+
+			error = OCError(OCErrorResponseUnknownFormat);
+		}
+	}
+
+	if (outError != NULL)
+	{
+		*outError = error;
+	}
+
+	return (nil);
+}
+
+#pragma mark - Pipeline traffic recorder
+- (void)pipeline:(OCHTTPPipeline *)pipeline recordFinishedTask:(OCHTTPPipelineTask *)task withResponse:(OCHTTPResponse *)response
+{
+	[self recordRequest:task.request response:response metrics:task.metrics];
+}
+
+@end
+
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyMethod = @"method";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyPath = @"path";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyQuery = @"query";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyRequestHeaders = @"requestHeaders";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyRequestBodyHash = @"requestBodySHA256";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyStatusCode = @"status";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyResponseHeaders = @"responseHeaders";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyBodyFile = @"body";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyErrorDomain = @"errorDomain";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyErrorCode = @"errorCode";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyStartOffset = @"start";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyDuration = @"duration";
+OCHostSimulatorRecordingKey OCHostSimulatorRecordingKeyTimeToFirstByte = @"ttfb";
@@ -31,6 +31,7 @@
 
 @property(strong,nonatomic) NSData *bodyData; //!< Data making up the body of the HTTP response
 @property(strong,nonatomic) NSURL *bodyURL; //!< URL to the file containing the data making up the body of the HTTP response
+@property(assign) BOOL bodyURLIsTemporary; //!< If YES, the file at .bodyURL is removed after the response has been delivered
 
 + (instancetype)responseWithURL:(NSURL *)url statusCode:(OCHTTPStatusCode)statusCode headers:(NSDictionary<NSString *,NSString *> *)headers contentType:(NSString *)contentType bodyData:(NSData *)bodyData;
 + (instancetype)responseWithURL:(NSURL *)url statusCode:(OCHTTPStatusCode)statusCode headers:(NSDictionary<NSString *,NSString *> *)headers contentType:(NSString *)contentType body:(NSString *)bodyString;
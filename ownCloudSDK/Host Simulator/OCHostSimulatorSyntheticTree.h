@@ -0,0 +1,84 @@
+//
+//  OCHostSimulatorSyntheticTree.h
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+#import "OCTypes.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface OCHostSimulatorSyntheticTreeItem : NSObject
+
+@property(strong) OCPath path; //!< Path of the item (folder paths end with a "/")
+@property(strong) NSString *name; //!< Name of the item
+@property(assign) BOOL isFolder; //!< YES for folders
+
+@property(strong) OCFileID fileID; //!< Stable file ID
+@property(strong) OCFileETag eTag; //!< ETag (changes with every mutation of the item - and for folders with every mutation inside)
+@property(assign) unsigned long long size; //!< Size of the file (0 for folders)
+@property(strong) NSDate *lastModified; //!< Last modification date
+
+@end
+
+/*
+	Procedurally generated folder tree, whose items are computed from a seed and their path when needed rather than stored:
+	- every folder above .depth contains .folderFanOut subfolders ("Folder 1" … "Folder N") and every folder .filesPerFolder files ("File 1.txt" … "File N.txt")
+	- fileIDs, ETags, sizes, modification dates and file contents are derived from seed, path and the number of mutations of an item, so they're stable across instances and launches
+	- mutations (writes, new folders, removals, moves, seeded mutation scripts) are kept in an overlay, whose size depends only on the number of mutations
+	- every mutation is recorded in a change log with the paths of all items it changed or removed, from which changes since a sync token are served (RFC 6578)
+
+	=> trees with tens of millions of items cost no more memory than small ones, making them suitable for scale testing of scans, sync and prepopulation.
+*/
+
+@interface OCHostSimulatorSyntheticTree : NSObject
+
+@property(readonly) uint64_t seed; //!< Seed used to derive all item properties
+@property(readonly) NSUInteger depth; //!< Number of folder levels below the root folder
+@property(readonly) NSUInteger folderFanOut; //!< Number of subfolders per folder (above .depth)
+@property(readonly) NSUInteger filesPerFolder; //!< Number of files per folder
+
+@property(assign) unsigned long long maximumFileSize; //!< Maximum size of generated files (default: 4096 bytes)
+@property(strong) NSDate *baseDate; //!< Base for generated modification dates (default: 2020-01-01 00:00:00 UTC)
+
+@property(assign) NSUInteger maximumInfinityItemCount; //!< Depth infinity PROPFINDs exceeding this number of items are rejected by the simulator serving the tree (like servers with limited depth infinity support do). 0 for no limit (default).
+
+@property(readonly,nonatomic) unsigned long long generatedItemCount; //!< Number of items (incl. the root folder) in the generated tree - not including mutations
+
+- (instancetype)initWithSeed:(uint64_t)seed depth:(NSUInteger)depth folderFanOut:(NSUInteger)folderFanOut filesPerFolder:(NSUInteger)filesPerFolder;
+
+#pragma mark - Access
+- (nullable OCHostSimulatorSyntheticTreeItem *)itemAtPath:(OCPath)path; //!< Returns the item at path - or nil if no item exists at that path
+- (nullable NSArray<OCHostSimulatorSyntheticTreeItem *> *)childrenOfFolderAtPath:(OCPath)path; //!< Returns the items contained in the folder at path - or nil if no folder exists at that path
+- (nullable NSData *)contentsOfFileAtPath:(OCPath)path; //!< Returns the contents of the file at path
+- (nullable NSString *)sha1ChecksumOfFileAtPath:(OCPath)path; //!< Returns the lowercase hex SHA-1 checksum of the contents of the file at path
+
+#pragma mark - Mutations
+- (nullable OCHostSimulatorSyntheticTreeItem *)writeFileAtPath:(OCPath)path contents:(NSData *)contents; //!< Creates or replaces a file. Returns nil if the parent folder doesn't exist or a folder exists at path.
+- (nullable OCHostSimulatorSyntheticTreeItem *)createFolderAtPath:(OCPath)path; //!< Creates a folder. Returns nil if the parent folder doesn't exist or an item exists at path.
+- (BOOL)removeItemAtPath:(OCPath)path; //!< Removes an item (and all its contents). Returns NO if no item exists at path.
+- (nullable OCHostSimulatorSyntheticTreeItem *)moveFileAtPath:(OCPath)path toPath:(OCPath)destinationPath; //!< Moves a file, keeping its fileID and contents. Returns nil if no file exists at path, the destination's parent folder doesn't exist or an item exists at destinationPath. Folders can't be moved, as the contents of generated folders are derived from their path.
+
+- (NSArray<NSString *> *)applyMutationScriptWithSeed:(uint64_t)seed count:(NSUInteger)count; //!< Applies count mutations (modifications, new files and folders, removals) to items chosen from seed, so that the same seed and count always lead to the same tree. Returns a description of each mutation (f.ex. "modify /Folder 1/File 2.txt").
+
+#pragma mark - Changes
+@property(readonly,nonatomic) NSString *syncToken; //!< Sync token identifying the current state of the tree (f.ex. "http://sabre.io/ns/sync/12")
+
+- (nullable NSArray<OCPath> *)changedPathsSinceSyncToken:(NSString *)syncToken limit:(NSUInteger)limit nextSyncToken:(NSString * _Nullable * _Nonnull)outNextSyncToken truncated:(BOOL *)outTruncated; //!< Returns the paths of all items changed or removed since syncToken, oldest change first, and the sync token to request further changes with. If limit is greater than 0 and more than limit paths changed, only the first limit paths are returned and outTruncated is set to YES. Paths for which -itemAtPath: returns nil have been removed. Returns nil for sync tokens not issued by the tree.
+
+@end
+
+NS_ASSUME_NONNULL_END
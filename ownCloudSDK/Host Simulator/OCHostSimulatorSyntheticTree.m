@@ -0,0 +1,818 @@
+//
+//  OCHostSimulatorSyntheticTree.m
+//  ownCloudSDK
+//
+//  Created by agent on 18.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import "OCHostSimulatorSyntheticTree.h"
+#import "NSData+OCHash.h"
+
+typedef NS_ENUM(NSUInteger, OCSyntheticTreeNodeType)
+{
+	OCSyntheticTreeNodeTypeNone,
+	OCSyntheticTreeNodeTypeFile,
+	OCSyntheticTreeNodeTypeFolder
+};
+
+static uint64_t OCSyntheticTreeMix(uint64_t x)
+{
+	// splitmix64 finalizer
+	x += 0x9E3779B97F4A7C15ULL;
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+	return (x ^ (x >> 31));
+}
+
+static uint64_t OCSyntheticTreeHash(uint64_t seed, NSString *path, uint64_t salt)
+{
+	uint64_t hash = 14695981039346656037ULL ^ OCSyntheticTreeMix(seed);
+	const char *utf8Path = path.UTF8String;
+
+	// FNV-1a over the path
+	while ((utf8Path != NULL) && (*utf8Path != 0))
+	{
+		hash ^= (uint8_t)*utf8Path;
+		hash *= 1099511628211ULL;
+		utf8Path++;
+	}
+
+	return (OCSyntheticTreeMix(hash ^ OCSyntheticTreeMix(salt)));
+}
+
+@implementation OCHostSimulatorSyntheticTreeItem
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, path: %@, fileID: %@, eTag: %@, size: %llu>", NSStringFromClass(self.class), self, _path, _fileID, _eTag, _size]);
+}
+
+@end
+
+@interface OCHostSimulatorSyntheticTree ()
+{
+	uint64_t _mutationCount;
+
+	NSMutableDictionary<OCPath, NSNumber *> *_versionsByPath;
+	NSMutableDictionary<OCPath, NSNumber *> *_creationSaltsByPath;
+	NSMutableDictionary<OCPath, NSDate *> *_lastModifiedByPath;
+	NSMutableDictionary<OCPath, NSData *> *_contentsByPath;
+
+	NSMutableDictionary<OCPath, OCFileID> *_fileIDsByPath; //!< FileIDs of moved items
+
+	NSMutableSet<OCPath> *_removedPaths;
+	NSMutableDictionary<OCPath, NSMutableArray<NSString *> *> *_addedNamesByFolderPath; //!< Names of added items by path of their parent folder (folder names end with a "/")
+
+	uint64_t _changeSequence;
+	NSMutableDictionary<OCPath, NSNumber *> *_changeSequencesByPath; //!< Change log: sequence number of the latest change of an item, by path
+}
+@end
+
+@implementation OCHostSimulatorSyntheticTree
+
+- (instancetype)initWithSeed:(uint64_t)seed depth:(NSUInteger)depth folderFanOut:(NSUInteger)folderFanOut filesPerFolder:(NSUInteger)filesPerFolder
+{
+	if ((self = [super init]) != nil)
+	{
+		_seed = seed;
+		_depth = depth;
+		_folderFanOut = folderFanOut;
+		_filesPerFolder = filesPerFolder;
+
+		_maximumFileSize = 4096;
+		_baseDate = [NSDate dateWithTimeIntervalSince1970:1577836800]; // 2020-01-01 00:00:00 UTC
+
+		_versionsByPath = [NSMutableDictionary new];
+		_creationSaltsByPath = [NSMutableDictionary new];
+		_lastModifiedByPath = [NSMutableDictionary new];
+		_contentsByPath = [NSMutableDictionary new];
+		_fileIDsByPath = [NSMutableDictionary new];
+
+		_removedPaths = [NSMutableSet new];
+		_addedNamesByFolderPath = [NSMutableDictionary new];
+
+		_changeSequencesByPath = [NSMutableDictionary new];
+	}
+
+	return (self);
+}
+
+- (unsigned long long)generatedItemCount
+{
+	unsigned long long folderCount = 0, foldersAtLevel = 1;
+
+	for (NSUInteger level=0; level <= _depth; level++)
+	{
+		folderCount += foldersAtLevel;
+		foldersAtLevel *= _folderFanOut;
+	}
+
+	return (folderCount + (folderCount * _filesPerFolder));
+}
+
+#pragma mark - Paths
++ (OCPath)_parentPathOf:(OCPath)canonicalPath name:(NSString **)outName
+{
+	NSString *trimmedPath = [canonicalPath hasSuffix:@"/"] ? [canonicalPath substringToIndex:canonicalPath.length-1] : canonicalPath;
+	NSRange lastSlashRange = [trimmedPath rangeOfString:@"/" options:NSBackwardsSearch];
+
+	if (lastSlashRange.location == NSNotFound)
+	{
+		return (nil);
+	}
+
+	if (outName != NULL)
+	{
+		*outName = [canonicalPath substringFromIndex:lastSlashRange.location+1];
+	}
+
+	return ([trimmedPath substringToIndex:lastSlashRange.location+1]);
+}
+
++ (NSUInteger)_levelOfFolderPath:(OCPath)folderPath
+{
+	NSUInteger level = 0;
+
+	for (NSUInteger idx=1; idx < folderPath.length; idx++)
+	{
+		if ([folderPath characterAtIndex:idx] == '/')
+		{
+			level++;
+		}
+	}
+
+	return (level);
+}
+
++ (NSUInteger)_indexFromName:(NSString *)name prefix:(NSString *)prefix suffix:(NSString *)suffix
+{
+	if ([name hasPrefix:prefix] && [name hasSuffix:suffix] && (name.length > (prefix.length + suffix.length)))
+	{
+		NSString *numberString = [name substringWithRange:NSMakeRange(prefix.length, name.length - prefix.length - suffix.length)];
+		NSUInteger index = (NSUInteger)numberString.longLongValue;
+
+		// Only accept canonical numbers (f.ex. not "01")
+		if ([[NSString stringWithFormat:@"%lu", (unsigned long)index] isEqualToString:numberString])
+		{
+			return (index);
+		}
+	}
+
+	return (0);
+}
+
+- (OCSyntheticTreeNodeType)_generatedTypeOfName:(NSString *)name inFolderAtLevel:(NSUInteger)level
+{
+	NSUInteger index;
+
+	if ([name hasSuffix:@"/"])
+	{
+		if ((level < _depth) && ((index = [OCHostSimulatorSyntheticTree _indexFromName:name prefix:@"Folder " suffix:@"/"]) > 0) && (index <= _folderFanOut))
+		{
+			return (OCSyntheticTreeNodeTypeFolder);
+		}
+	}
+	else
+	{
+		if (((index = [OCHostSimulatorSyntheticTree _indexFromName:name prefix:@"File " suffix:@".txt"]) > 0) && (index <= _filesPerFolder))
+		{
+			return (OCSyntheticTreeNodeTypeFile);
+		}
+	}
+
+	return (OCSyntheticTreeNodeTypeNone);
+}
+
+- (OCSyntheticTreeNodeType)_resolveCanonicalPath:(OCPath)canonicalPath generated:(BOOL *)outGenerated
+{
+	OCPath parentPath;
+	NSString *name = nil;
+	BOOL parentGenerated = NO;
+	OCSyntheticTreeNodeType type = [canonicalPath hasSuffix:@"/"] ? OCSyntheticTreeNodeTypeFolder : OCSyntheticTreeNodeTypeFile;
+
+	if ([canonicalPath isEqual:@"/"])
+	{
+		*outGenerated = YES;
+		return (OCSyntheticTreeNodeTypeFolder);
+	}
+
+	if ((parentPath = [OCHostSimulatorSyntheticTree _parentPathOf:canonicalPath name:&name]) == nil)
+	{
+		return (OCSyntheticTreeNodeTypeNone);
+	}
+
+	if ([self _resolveCanonicalPath:parentPath generated:&parentGenerated] != OCSyntheticTreeNodeTypeFolder)
+	{
+		return (OCSyntheticTreeNodeTypeNone);
+	}
+
+	// Added items
+	if ([_addedNamesByFolderPath[parentPath] containsObject:name])
+	{
+		*outGenerated = NO;
+		return (type);
+	}
+
+	// Generated items (unless removed)
+	if (parentGenerated && ![_removedPaths containsObject:canonicalPath] && ([self _generatedTypeOfName:name inFolderAtLevel:[OCHostSimulatorSyntheticTree _levelOfFolderPath:parentPath]] == type))
+	{
+		*outGenerated = YES;
+		return (type);
+	}
+
+	return (OCSyntheticTreeNodeTypeNone);
+}
+
+- (OCPath)_canonicalPathForPath:(OCPath)path type:(OCSyntheticTreeNodeType *)outType generated:(BOOL *)outGenerated
+{
+	OCPath basePath = [path hasPrefix:@"/"] ? path : [@"/" stringByAppendingString:path];
+	BOOL generated = NO;
+
+	while ((basePath.length > 1) && [basePath hasSuffix:@"/"])
+	{
+		basePath = [basePath substringToIndex:basePath.length-1];
+	}
+
+	if ([basePath isEqual:@"/"])
+	{
+		*outType = OCSyntheticTreeNodeTypeFolder;
+		*outGenerated = YES;
+		return (basePath);
+	}
+
+	// Try folder first, then file
+	if ([self _resolveCanonicalPath:[basePath stringByAppendingString:@"/"] generated:&generated] == OCSyntheticTreeNodeTypeFolder)
+	{
+		*outType = OCSyntheticTreeNodeTypeFolder;
+		*outGenerated = generated;
+		return ([basePath stringByAppendingString:@"/"]);
+	}
+
+	if (![path hasSuffix:@"/"] && ([self _resolveCanonicalPath:basePath generated:&generated] == OCSyntheticTreeNodeTypeFile))
+	{
+		*outType = OCSyntheticTreeNodeTypeFile;
+		*outGenerated = generated;
+		return (basePath);
+	}
+
+	*outType = OCSyntheticTreeNodeTypeNone;
+	return (basePath);
+}
+
+#pragma mark - Items
+- (uint64_t)_saltForCanonicalPath:(OCPath)canonicalPath
+{
+	return (_creationSaltsByPath[canonicalPath].unsignedLongLongValue);
+}
+
+- (uint64_t)_contentHashForCanonicalPath:(OCPath)canonicalPath
+{
+	return (OCSyntheticTreeHash(_seed, canonicalPath, ([self _saltForCanonicalPath:canonicalPath] << 32) + _versionsByPath[canonicalPath].unsignedLongLongValue + 1));
+}
+
+- (OCHostSimulatorSyntheticTreeItem *)_itemForCanonicalPath:(OCPath)canonicalPath type:(OCSyntheticTreeNodeType)type
+{
+	OCHostSimulatorSyntheticTreeItem *item = [OCHostSimulatorSyntheticTreeItem new];
+	uint64_t contentHash = [self _contentHashForCanonicalPath:canonicalPath];
+	NSString *name = nil;
+	NSDate *lastModified;
+	NSData *contents;
+
+	[OCHostSimulatorSyntheticTree _parentPathOf:canonicalPath name:&name];
+
+	item.path = canonicalPath;
+	item.isFolder = (type == OCSyntheticTreeNodeTypeFolder);
+	item.name = (name != nil) ? (item.isFolder ? [name substringToIndex:name.length-1] : name) : @"";
+
+	if ((item.fileID = _fileIDsByPath[canonicalPath]) == nil)
+	{
+		item.fileID = [NSString stringWithFormat:@"%016llx", OCSyntheticTreeHash(_seed, canonicalPath, [self _saltForCanonicalPath:canonicalPath])];
+	}
+	item.eTag = [NSString stringWithFormat:@"\"%016llx\"", contentHash];
+
+	if (!item.isFolder)
+	{
+		if ((contents = _contentsByPath[canonicalPath]) != nil)
+		{
+			item.size = contents.length;
+		}
+		else
+		{
+			item.size = contentHash % (_maximumFileSize + 1);
+		}
+	}
+
+	if ((lastModified = _lastModifiedByPath[canonicalPath]) == nil)
+	{
+		lastModified = [_baseDate dateByAddingTimeInterval:(NSTimeInterval)(OCSyntheticTreeHash(_seed, canonicalPath, 0) % (365 * 24 * 3600))];
+	}
+
+	item.lastModified = lastModified;
+
+	return (item);
+}
+
+- (OCHostSimulatorSyntheticTreeItem *)itemAtPath:(OCPath)path
+{
+	@synchronized(self)
+	{
+		OCSyntheticTreeNodeType type = OCSyntheticTreeNodeTypeNone;
+		BOOL generated = NO;
+		OCPath canonicalPath = [self _canonicalPathForPath:path type:&type generated:&generated];
+
+		if (type == OCSyntheticTreeNodeTypeNone)
+		{
+			return (nil);
+		}
+
+		return ([self _itemForCanonicalPath:canonicalPath type:type]);
+	}
+}
+
+- (NSArray<OCHostSimulatorSyntheticTreeItem *> *)childrenOfFolderAtPath:(OCPath)path
+{
+	@synchronized(self)
+	{
+		OCSyntheticTreeNodeType type = OCSyntheticTreeNodeTypeNone;
+		BOOL generated = NO;
+		OCPath folderPath = [self _canonicalPathForPath:path type:&type generated:&generated];
+		NSMutableArray<OCHostSimulatorSyntheticTreeItem *> *children;
+
+		if (type != OCSyntheticTreeNodeTypeFolder)
+		{
+			return (nil);
+		}
+
+		children = [NSMutableArray new];
+
+		if (generated)
+		{
+			NSUInteger level = [OCHostSimulatorSyntheticTree _levelOfFolderPath:folderPath];
+
+			if (level < _depth)
+			{
+				for (NSUInteger idx=1; idx <= _folderFanOut; idx++)
+				{
+					OCPath childPath = [folderPath stringByAppendingFormat:@"Folder %lu/", (unsigned long)idx];
+
+					if (![_removedPaths containsObject:childPath])
+					{
+						[children addObject:[self _itemForCanonicalPath:childPath type:OCSyntheticTreeNodeTypeFolder]];
+					}
+				}
+			}
+
+			for (NSUInteger idx=1; idx <= _filesPerFolder; idx++)
+			{
+				OCPath childPath = [folderPath stringByAppendingFormat:@"File %lu.txt", (unsigned long)idx];
+
+				if (![_removedPaths containsObject:childPath])
+				{
+					[children addObject:[self _itemForCanonicalPath:childPath type:OCSyntheticTreeNodeTypeFile]];
+				}
+			}
+		}
+
+		for (NSString *name in _addedNamesByFolderPath[folderPath])
+		{
+			[children addObject:[self _itemForCanonicalPath:[folderPath stringByAppendingString:name] type:([name hasSuffix:@"/"] ? OCSyntheticTreeNodeTypeFolder : OCSyntheticTreeNodeTypeFile)]];
+		}
+
+		return (children);
+	}
+}
+
+- (NSData *)contentsOfFileAtPath:(OCPath)path
+{
+	@synchronized(self)
+	{
+		OCSyntheticTreeNodeType type = OCSyntheticTreeNodeTypeNone;
+		BOOL generated = NO;
+		OCPath canonicalPath = [self _canonicalPathForPath:path type:&type generated:&generated];
+		NSData *contents;
+
+		if (type != OCSyntheticTreeNodeTypeFile)
+		{
+			return (nil);
+		}
+
+		if ((contents = _contentsByPath[canonicalPath]) == nil)
+		{
+			// Generate printable contents from the content hash
+			uint64_t contentHash = [self _contentHashForCanonicalPath:canonicalPath];
+			unsigned long long size = contentHash % (_maximumFileSize + 1);
+			NSMutableData *generatedContents = [[NSMutableData alloc] initWithLength:(NSUInteger)size];
+			uint8_t *bytes = generatedContents.mutableBytes;
+			uint64_t state = contentHash | 1;
+
+			for (unsigned long long idx=0; idx < size; idx++)
+			{
+				if ((idx % 64) == 63)
+				{
+					bytes[idx] = '\n';
+				}
+				else
+				{
+					// xorshift64
+					state ^= state << 13;
+					state ^= state >> 7;
+					state ^= state << 17;
+
+					bytes[idx] = 'a' + (uint8_t)(state % 26);
+				}
+			}
+
+			contents = generatedContents;
+		}
+
+		return (contents);
+	}
+}
+
+- (NSString *)sha1ChecksumOfFileAtPath:(OCPath)path
+{
+	return ([[[self contentsOfFileAtPath:path] sha1Hash] asHexStringWithSeparator:@"" lowercase:YES]);
+}
+
+#pragma mark - Mutations
+- (void)_recordChangeOfCanonicalPath:(OCPath)canonicalPath
+{
+	// Each path gets its own sequence number, so that changes can be split into pages at any path
+	_changeSequence++;
+	_changeSequencesByPath[canonicalPath] = @(_changeSequence);
+}
+
+- (void)_touchCanonicalPath:(OCPath)canonicalPath
+{
+	NSDate *mutationDate;
+	OCPath path = canonicalPath;
+
+	_mutationCount++;
+
+	// Mutations take place after all generated modification dates
+	mutationDate = [_baseDate dateByAddingTimeInterval:(366 * 24 * 3600) + (NSTimeInterval)_mutationCount];
+
+	// Change ETag (and modification date) of the item and all its parent folders
+	while (path != nil)
+	{
+		_versionsByPath[path] = @(_versionsByPath[path].unsignedLongLongValue + 1);
+		_lastModifiedByPath[path] = mutationDate;
+
+		[self _recordChangeOfCanonicalPath:path];
+
+		path = [OCHostSimulatorSyntheticTree _parentPathOf:path name:NULL];
+	}
+}
+
+- (void)_forgetOverlayForCanonicalPath:(OCPath)canonicalPath
+{
+	// Remove overlay data of the item and its contents
+	for (NSMutableDictionary *overlayDict in @[ _versionsByPath, _creationSaltsByPath, _lastModifiedByPath, _contentsByPath, _fileIDsByPath, _addedNamesByFolderPath ])
+	{
+		for (OCPath path in [overlayDict allKeys])
+		{
+			if ([path isEqual:canonicalPath] || ([canonicalPath hasSuffix:@"/"] && [path hasPrefix:canonicalPath]))
+			{
+				[overlayDict removeObjectForKey:path];
+			}
+		}
+	}
+}
+
+- (BOOL)_addItemWithName:(NSString *)name toFolder:(OCPath)folderPath isFolder:(BOOL)isFolder
+{
+	OCSyntheticTreeNodeType folderType;
+	BOOL folderGenerated = NO;
+	NSString *itemName = isFolder ? [name stringByAppendingString:@"/"] : name;
+	OCPath itemPath = [folderPath stringByAppendingString:itemName];
+	NSMutableArray<NSString *> *addedNames;
+
+	folderType = [self _resolveCanonicalPath:folderPath generated:&folderGenerated];
+
+	if (folderType != OCSyntheticTreeNodeTypeFolder)
+	{
+		return (NO);
+	}
+
+	if ((addedNames = _addedNamesByFolderPath[folderPath]) == nil)
+	{
+		addedNames = [NSMutableArray new];
+		_addedNamesByFolderPath[folderPath] = addedNames;
+	}
+
+	[addedNames addObject:itemName];
+
+	// New fileID for items re-created at the path of a removed item
+	_creationSaltsByPath[itemPath] = @(_mutationCount + 1);
+
+	return (YES);
+}
+
+- (OCHostSimulatorSyntheticTreeItem *)writeFileAtPath:(OCPath)path contents:(NSData *)contents
+{
+	@synchronized(self)
+	{
+		OCSyntheticTreeNodeType type = OCSyntheticTreeNodeTypeNone;
+		BOOL generated = NO;
+		OCPath canonicalPath = [self _canonicalPathForPath:path type:&type generated:&generated];
+
+		if (type == OCSyntheticTreeNodeTypeFolder)
+		{
+			return (nil);
+		}
+
+		if (type == OCSyntheticTreeNodeTypeNone)
+		{
+			NSString *name = nil;
+			OCPath parentPath;
+
+			if (((parentPath = [OCHostSimulatorSyntheticTree _parentPathOf:canonicalPath name:&name]) == nil) || (name.length == 0) || ![self _addItemWithName:name toFolder:parentPath isFolder:NO])
+			{
+				return (nil);
+			}
+		}
+
+		_contentsByPath[canonicalPath] = [contents copy];
+		[self _touchCanonicalPath:canonicalPath];
+
+		return ([self _itemForCanonicalPath:canonicalPath type:OCSyntheticTreeNodeTypeFile]);
+	}
+}
+
+- (OCHostSimulatorSyntheticTreeItem *)createFolderAtPath:(OCPath)path
+{
+	@synchronized(self)
+	{
+		OCSyntheticTreeNodeType type = OCSyntheticTreeNodeTypeNone;
+		BOOL generated = NO;
+		OCPath canonicalPath = [self _canonicalPathForPath:path type:&type generated:&generated];
+		OCPath parentPath;
+		NSString *name = nil;
+
+		if (type != OCSyntheticTreeNodeTypeNone)
+		{
+			return (nil);
+		}
+
+		if (((parentPath = [OCHostSimulatorSyntheticTree _parentPathOf:canonicalPath name:&name]) == nil) || (name.length == 0) || ![self _addItemWithName:name toFolder:parentPath isFolder:YES])
+		{
+			return (nil);
+		}
+
+		canonicalPath = [canonicalPath stringByAppendingString:@"/"];
+
+		[self _touchCanonicalPath:canonicalPath];
+
+		return ([self _itemForCanonicalPath:canonicalPath type:OCSyntheticTreeNodeTypeFolder]);
+	}
+}
+
+- (BOOL)removeItemAtPath:(OCPath)path
+{
+	@synchronized(self)
+	{
+		OCSyntheticTreeNodeType type = OCSyntheticTreeNodeTypeNone;
+		BOOL generated = NO;
+		OCPath canonicalPath = [self _canonicalPathForPath:path type:&type generated:&generated];
+		OCPath parentPath;
+		NSString *name = nil;
+
+		if ((type == OCSyntheticTreeNodeTypeNone) || [canonicalPath isEqual:@"/"])
+		{
+			return (NO);
+		}
+
+		parentPath = [OCHostSimulatorSyntheticTree _parentPathOf:canonicalPath name:&name];
+
+		if (generated)
+		{
+			[_removedPaths addObject:canonicalPath];
+		}
+		else
+		{
+			[_addedNamesByFolderPath[parentPath] removeObject:name];
+		}
+
+		[self _forgetOverlayForCanonicalPath:canonicalPath];
+		[self _recordChangeOfCanonicalPath:canonicalPath];
+		[self _touchCanonicalPath:parentPath];
+
+		return (YES);
+	}
+}
+
+- (OCHostSimulatorSyntheticTreeItem *)moveFileAtPath:(OCPath)path toPath:(OCPath)destinationPath
+{
+	@synchronized(self)
+	{
+		OCSyntheticTreeNodeType type = OCSyntheticTreeNodeTypeNone, destinationType = OCSyntheticTreeNodeTypeNone;
+		BOOL generated = NO, destinationGenerated = NO;
+		OCPath canonicalPath = [self _canonicalPathForPath:path type:&type generated:&generated];
+		OCPath destinationCanonicalPath, parentPath, destinationParentPath;
+		NSString *name = nil, *destinationName = nil;
+		OCFileID fileID;
+		NSData *contents;
+
+		if ((type != OCSyntheticTreeNodeTypeFile) || [destinationPath hasSuffix:@"/"])
+		{
+			return (nil);
+		}
+
+		destinationCanonicalPath = [self _canonicalPathForPath:destinationPath type:&destinationType generated:&destinationGenerated];
+
+		if ((destinationType != OCSyntheticTreeNodeTypeNone) ||
+		    ((destinationParentPath = [OCHostSimulatorSyntheticTree _parentPathOf:destinationCanonicalPath name:&destinationName]) == nil) || (destinationName.length == 0))
+		{
+			return (nil);
+		}
+
+		fileID = [self _itemForCanonicalPath:canonicalPath type:OCSyntheticTreeNodeTypeFile].fileID;
+		contents = [self contentsOfFileAtPath:canonicalPath];
+
+		if (![self _addItemWithName:destinationName toFolder:destinationParentPath isFolder:NO])
+		{
+			return (nil);
+		}
+
+		// Remove at source
+		parentPath = [OCHostSimulatorSyntheticTree _parentPathOf:canonicalPath name:&name];
+
+		if (generated)
+		{
+			[_removedPaths addObject:canonicalPath];
+		}
+		else
+		{
+			[_addedNamesByFolderPath[parentPath] removeObject:name];
+		}
+
+		[self _forgetOverlayForCanonicalPath:canonicalPath];
+		[self _recordChangeOfCanonicalPath:canonicalPath];
+		[self _touchCanonicalPath:parentPath];
+
+		// Add at destination
+		_contentsByPath[destinationCanonicalPath] = contents;
+		_fileIDsByPath[destinationCanonicalPath] = fileID;
+
+		[self _touchCanonicalPath:destinationCanonicalPath];
+
+		return ([self _itemForCanonicalPath:destinationCanonicalPath type:OCSyntheticTreeNodeTypeFile]);
+	}
+}
+
+- (NSArray<NSString *> *)applyMutationScriptWithSeed:(uint64_t)seed count:(NSUInteger)count
+{
+	NSMutableArray<NSString *> *mutations = [NSMutableArray new];
+	__block uint64_t state = OCSyntheticTreeMix(seed);
+	uint64_t (^Random)(uint64_t) = ^(uint64_t range) {
+		state = OCSyntheticTreeMix(state);
+		return ((range > 0) ? (state % range) : 0);
+	};
+
+	@synchronized(self)
+	{
+		for (NSUInteger mutationIdx=0; mutationIdx < count; mutationIdx++)
+		{
+			OCHostSimulatorSyntheticTreeItem *item = [self itemAtPath:@"/"];
+			NSArray<OCHostSimulatorSyntheticTreeItem *> *children;
+			uint64_t operation;
+
+			// Random walk into the tree
+			while (item.isFolder && ((children = [self childrenOfFolderAtPath:item.path]).count > 0))
+			{
+				item = children[(NSUInteger)Random(children.count)];
+
+				if (!item.isFolder || (Random(10) < 3))
+				{
+					break;
+				}
+			}
+
+			operation = Random(10);
+
+			if ((operation < 5) && !item.isFolder)
+			{
+				// Modify file (new contents, ETag and size)
+				[_contentsByPath removeObjectForKey:item.path];
+				[self _touchCanonicalPath:item.path];
+
+				[mutations addObject:[@"modify " stringByAppendingString:item.path]];
+			}
+			else if ((operation < 8) || [item.path isEqual:@"/"])
+			{
+				// Create file or folder
+				OCPath folderPath = item.isFolder ? item.path : [OCHostSimulatorSyntheticTree _parentPathOf:item.path name:NULL];
+				OCPath newPath = [folderPath stringByAppendingFormat:@"Mutation %lu-%lu", (unsigned long)(seed % 100000), (unsigned long)mutationIdx];
+
+				if ((operation % 2) == 0)
+				{
+					if ([self createFolderAtPath:newPath] != nil)
+					{
+						[mutations addObject:[NSString stringWithFormat:@"mkdir %@/", newPath]];
+					}
+				}
+				else
+				{
+					newPath = [newPath stringByAppendingString:@".txt"];
+
+					if ([self writeFileAtPath:newPath contents:[[NSString stringWithFormat:@"%@\n", newPath] dataUsingEncoding:NSUTF8StringEncoding]] != nil)
+					{
+						[mutations addObject:[@"create " stringByAppendingString:newPath]];
+					}
+				}
+			}
+			else
+			{
+				// Remove item
+				if ([self removeItemAtPath:item.path])
+				{
+					[mutations addObject:[@"remove " stringByAppendingString:item.path]];
+				}
+			}
+		}
+	}
+
+	return (mutations);
+}
+
+#pragma mark - Changes
++ (NSString *)_syncTokenForSequence:(uint64_t)sequence
+{
+	return ([NSString stringWithFormat:@"http://sabre.io/ns/sync/%llu", sequence]);
+}
+
+- (NSString *)syncToken
+{
+	@synchronized(self)
+	{
+		return ([OCHostSimulatorSyntheticTree _syncTokenForSequence:_changeSequence]);
+	}
+}
+
+- (NSArray<OCPath> *)changedPathsSinceSyncToken:(NSString *)syncToken limit:(NSUInteger)limit nextSyncToken:(NSString * _Nullable * _Nonnull)outNextSyncToken truncated:(BOOL *)outTruncated
+{
+	NSString *tokenPrefix = @"http://sabre.io/ns/sync/";
+	NSString *sequenceString;
+	uint64_t sequence;
+
+	*outNextSyncToken = nil;
+	*outTruncated = NO;
+
+	if (![syncToken hasPrefix:tokenPrefix])
+	{
+		return (nil);
+	}
+
+	sequenceString = [syncToken substringFromIndex:tokenPrefix.length];
+	sequence = strtoull(sequenceString.UTF8String, NULL, 10);
+
+	@synchronized(self)
+	{
+		NSMutableArray<OCPath> *changedPaths = [NSMutableArray new];
+
+		// Only accept canonical numbers of issued tokens
+		if (![[NSString stringWithFormat:@"%llu", sequence] isEqual:sequenceString] || (sequence > _changeSequence))
+		{
+			return (nil);
+		}
+
+		[_changeSequencesByPath enumerateKeysAndObjectsUsingBlock:^(OCPath path, NSNumber *changeSequence, BOOL *stop) {
+			if (changeSequence.unsignedLongLongValue > sequence)
+			{
+				[changedPaths addObject:path];
+			}
+		}];
+
+		[changedPaths sortUsingComparator:^NSComparisonResult(OCPath path1, OCPath path2) {
+			return ([self->_changeSequencesByPath[path1] compare:self->_changeSequencesByPath[path2]]);
+		}];
+
+		if ((limit > 0) && (changedPaths.count > limit))
+		{
+			[changedPaths removeObjectsInRange:NSMakeRange(limit, changedPaths.count - limit)];
+
+			*outNextSyncToken = [OCHostSimulatorSyntheticTree _syncTokenForSequence:_changeSequencesByPath[changedPaths.lastObject].unsignedLongLongValue];
+			*outTruncated = YES;
+		}
+		else
+		{
+			*outNextSyncToken = [OCHostSimulatorSyntheticTree _syncTokenForSequence:_changeSequence];
+		}
+
+		return (changedPaths);
+	}
+}
+
+@end
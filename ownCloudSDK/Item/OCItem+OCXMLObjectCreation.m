@@ -20,6 +20,8 @@
 #import "OCItem+OCXMLObjectCreation.h"
 #import "OCHTTPStatus.h"
 #import "OCChecksum.h"
+#import "OCItemMultistatusDecoder.h"
+#import "OCStringInternPool.h"
 
 @implementation OCItem (OCXMLObjectCreation)
 
@@ -61,7 +63,7 @@
 			@"d:getcontenttype" : [^(OCItem *item, NSString *key, id value) {
 				if ([value isKindOfClass:[NSString class]])
 				{
-					item.mimeType = value;
+					item.mimeType = [OCStringInternPool.sharedPool internString:value];
 				}
 			} copy],
 
@@ -236,6 +238,11 @@
 	return (@"d:response");
 }
 
++ (id<OCXMLObjectDecoder>)xmlObjectDecoderForParser:(OCXMLParser *)xmlParser
+{
+	return ([[OCItemMultistatusDecoder alloc] initWithXMLParser:xmlParser]);
+}
+
 + (instancetype)instanceFromNode:(OCXMLParserNode *)responseNode xmlParser:(OCXMLParser *)xmlParser
 {
 	OCItem *item = nil;
@@ -22,6 +22,7 @@
 #import "OCFile.h"
 #import "OCItem+OCItemCreationDebugging.h"
 #import "OCMacros.h"
+#import "OCStringInternPool.h"
 
 @implementation OCItem
 
@@ -142,14 +143,14 @@
 
 		_type = [decoder decodeIntegerForKey:@"type"];
 
-		_mimeType = [decoder decodeObjectOfClass:[NSString class] forKey:@"mimeType"];
+		_mimeType = [OCStringInternPool.sharedPool internString:[decoder decodeObjectOfClass:[NSString class] forKey:@"mimeType"]];
 
 		_permissions = [decoder decodeIntegerForKey:@"permissions"];
 
 		_localRelativePath = [decoder decodeObjectOfClass:NSString.class forKey:@"localRelativePath"];
 		_locallyModified = [decoder decodeBoolForKey:@"locallyModified"];
 		_localCopyVersionIdentifier = [decoder decodeObjectOfClass:[OCItemVersionIdentifier class] forKey:@"localCopyVersionIdentifier"];
-		_downloadTriggerIdentifier = [decoder decodeObjectOfClass:[NSString class] forKey:@"downloadTriggerIdentifier"];
+		_downloadTriggerIdentifier = [OCStringInternPool.sharedPool internString:[decoder decodeObjectOfClass:[NSString class] forKey:@"downloadTriggerIdentifier"]];
 		_fileClaim = [decoder decodeObjectOfClass:[OCClaim class] forKey:@"fileClaim"];
 
 		_remoteItem = [decoder decodeObjectOfClass:[OCItem class] forKey:@"remoteItem"];
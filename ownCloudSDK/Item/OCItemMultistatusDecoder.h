@@ -0,0 +1,44 @@
+//
+//  OCItemMultistatusDecoder.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "OCXMLParser.h"
+#import "OCItem.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Decodes the <d:response> elements of a PROPFIND multistatus response straight into OCItems:
+	- element names are mapped to a fixed property ID via their interned OCXMLElementName (pointer lookup, no string comparisons)
+	- values are parsed from the element bytes: href percent-decoding, permissions, share types, checksums, numbers and dates run in single passes
+	- properties are collected per <d:propstat> and only applied to the item if its <d:status> indicates success
+	Used by OCXMLParser (via +[OCItem xmlObjectDecoderForParser:]) instead of building an OCXMLParserNode tree per response.
+*/
+
+@interface OCItemMultistatusDecoder : NSObject <OCXMLObjectDecoder>
+
+@property(strong,nullable) OCPath basePath; //!< Prefix to remove from the (decoded) href of each item
+@property(strong,nullable) NSMutableDictionary<NSString *, OCUser *> *usersByUserID; //!< Dictionary used to share OCUser instances between items (access is synchronized on the dictionary)
+@property(assign) BOOL syncCollection; //!< If YES, decodes responses of a sync-collection REPORT (RFC 6578): members with a 404 status are returned as items with .removed = YES, a 507 status sets the parser's userInfo[@"syncCollectionTruncated"]
+
+- (instancetype)initWithXMLParser:(nullable OCXMLParser *)xmlParser; //!< Picks up basePath, usersByUserID and syncCollection from the xmlParser's options
+
+@end
+
+NS_ASSUME_NONNULL_END
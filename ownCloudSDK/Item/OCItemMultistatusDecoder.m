@@ -0,0 +1,765 @@
+//
+//  OCItemMultistatusDecoder.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCItemMultistatusDecoder.h"
+#import "OCXMLSAXParser.h"
+#import "OCChecksum.h"
+#import "NSDate+OCDateParser.h"
+#import "OCStringInternPool.h"
+#import "OCHTTPStatus.h"
+
+typedef NS_ENUM(uint8_t, OCItemMultistatusElement)
+{
+	OCItemMultistatusElementUnknown = 0,
+
+	// Structure
+	OCItemMultistatusElementResponse,
+	OCItemMultistatusElementHref,
+	OCItemMultistatusElementPropstat,
+	OCItemMultistatusElementProp,
+	OCItemMultistatusElementStatus,
+	OCItemMultistatusElementResourceType,
+	OCItemMultistatusElementCollection,
+	OCItemMultistatusElementShareTypes,
+	OCItemMultistatusElementShareType,
+	OCItemMultistatusElementChecksums,
+	OCItemMultistatusElementChecksum,
+
+	// Properties
+	OCItemMultistatusElementContentLength,
+	OCItemMultistatusElementSize,
+	OCItemMultistatusElementLastModified,
+	OCItemMultistatusElementCreationDate,
+	OCItemMultistatusElementContentType,
+	OCItemMultistatusElementETag,
+	OCItemMultistatusElementFileID,
+	OCItemMultistatusElementPermissions,
+	OCItemMultistatusElementFavorite,
+	OCItemMultistatusElementPrivateLink,
+	OCItemMultistatusElementMetaPathForUser,
+	OCItemMultistatusElementQuotaAvailableBytes,
+	OCItemMultistatusElementQuotaUsedBytes,
+	OCItemMultistatusElementOwnerID,
+	OCItemMultistatusElementOwnerDisplayName
+};
+
+#define OCItemMultistatusMaxDepth 32
+#define OCItemMultistatusMaxAlgorithms 4
+
+static CFDictionaryRef sElementByName; //!< OCXMLElementName (by pointer) -> OCItemMultistatusElement
+
+#pragma mark - Byte parsing
+static long long OCItemMultistatusParseInteger(const char *bytes, NSUInteger length)
+{
+	// Same semantics as -[NSString longLongValue]: leading whitespace, optional sign, digits up to the first non-digit
+	NSUInteger i = 0;
+	long long value = 0;
+	BOOL negative = NO;
+
+	while ((i < length) && ((bytes[i] == ' ') || (bytes[i] == '\t') || (bytes[i] == '\n') || (bytes[i] == '\r'))) { i++; }
+
+	if ((i < length) && ((bytes[i] == '-') || (bytes[i] == '+')))
+	{
+		negative = (bytes[i] == '-');
+		i++;
+	}
+
+	while ((i < length) && (bytes[i] >= '0') && (bytes[i] <= '9'))
+	{
+		value = (value * 10) + (bytes[i] - '0');
+		i++;
+	}
+
+	return (negative ? -value : value);
+}
+
+static inline int OCItemMultistatusHexValue(char c)
+{
+	if ((c >= '0') && (c <= '9')) { return (c - '0'); }
+	if ((c >= 'a') && (c <= 'f')) { return (c - 'a' + 10); }
+	if ((c >= 'A') && (c <= 'F')) { return (c - 'A' + 10); }
+
+	return (-1);
+}
+
+static BOOL OCItemMultistatusPercentDecode(char *bytes, NSUInteger *ioLength)
+{
+	// Decodes in place (the output is never longer than the input). Returns NO for invalid escape sequences, like -stringByRemovingPercentEncoding.
+	NSUInteger length = *ioLength, out = 0;
+
+	for (NSUInteger i=0; i<length; i++)
+	{
+		if (bytes[i] == '%')
+		{
+			int high, low;
+
+			if (((i + 2) >= length) || ((high = OCItemMultistatusHexValue(bytes[i+1])) < 0) || ((low = OCItemMultistatusHexValue(bytes[i+2])) < 0))
+			{
+				return (NO);
+			}
+
+			bytes[out++] = (char)((high << 4) | low);
+			i += 2;
+		}
+		else
+		{
+			bytes[out++] = bytes[i];
+		}
+	}
+
+	*ioLength = out;
+
+	return (YES);
+}
+
+static OCItemPermissions OCItemMultistatusParsePermissions(const char *bytes, NSUInteger length)
+{
+	OCItemPermissions permissions = 0;
+
+	for (NSUInteger i=0; i<length; i++)
+	{
+		switch (bytes[i])
+		{
+			case 'S': permissions |= OCItemPermissionShared;	break;
+			case 'R': permissions |= OCItemPermissionShareable;	break;
+			case 'M': permissions |= OCItemPermissionMounted;	break;
+			case 'W': permissions |= OCItemPermissionWritable;	break;
+			case 'C': permissions |= OCItemPermissionCreateFile;	break;
+			case 'K': permissions |= OCItemPermissionCreateFolder;	break;
+			case 'D': permissions |= OCItemPermissionDelete;	break;
+			case 'N': permissions |= OCItemPermissionRename;	break;
+			case 'V': permissions |= OCItemPermissionMove;		break;
+		}
+	}
+
+	return (permissions);
+}
+
+static OCShareTypesMask OCItemMultistatusShareTypesMaskForShareType(long long shareType)
+{
+	switch (shareType)
+	{
+		case OCShareTypeUserShare:	return (OCShareTypesMaskUserShare);
+		case OCShareTypeGroupShare:	return (OCShareTypesMaskGroupShare);
+		case OCShareTypeLink:		return (OCShareTypesMaskLink);
+		case OCShareTypeGuest:		return (OCShareTypesMaskGuest);
+		case OCShareTypeRemote:		return (OCShareTypesMaskRemote);
+	}
+
+	return (OCShareTypesMaskNone);
+}
+
+static inline NSString *OCItemMultistatusString(const char *bytes, NSUInteger length)
+{
+	return ([[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding]);
+}
+
+static inline NSString *OCItemMultistatusInternedString(const char *bytes, NSUInteger length)
+{
+	// For values that repeat across many items - all items share one instance
+	return ([OCStringInternPool.sharedPool internedStringWithBytes:bytes length:length]);
+}
+
+@interface OCItemMultistatusDecoder ()
+{
+	OCItemMultistatusElement _elementStack[OCItemMultistatusMaxDepth];
+	NSUInteger _depth;
+
+	char *_text;
+	NSUInteger _textLength;
+	NSUInteger _textCapacity;
+	BOOL _captureText;
+
+	NSData *_basePathData; //!< UTF-8 bytes of .basePath
+
+	struct {
+		__unsafe_unretained OCChecksumAlgorithmIdentifier identifier; // retained by _algorithmIdentifiers
+		char bytes[16];
+		NSUInteger length;
+	} _algorithms[OCItemMultistatusMaxAlgorithms];
+	NSUInteger _algorithmCount;
+	NSMutableArray<OCChecksumAlgorithmIdentifier> *_algorithmIdentifiers;
+
+	// Response
+	OCItem *_item;
+	BOOL _hasHref;
+	OCPath _hrefPath;
+	OCPath _metaPath;
+	long long _responseStatusCode; //!< Status code of a <d:status> directly inside <d:response> (0 if none)
+
+	// Propstat (applied to _item if the status indicates success)
+	BOOL _propstatSuccess;
+	BOOL _propstatHasProp;
+	BOOL _propstatIsCollection;
+	BOOL _propstatHasSize;
+	NSInteger _propstatSize;
+	BOOL _propstatHasPermissions;
+	OCItemPermissions _propstatPermissions;
+	OCShareTypesMask _propstatShareTypesMask;
+	NSDate *_propstatLastModified;
+	NSDate *_propstatCreationDate;
+	NSString *_propstatMimeType;
+	OCFileETag _propstatETag;
+	OCFileID _propstatFileID;
+	OCItemFavorite _propstatFavorite;
+	NSURL *_propstatPrivateLink;
+	OCPath _propstatMetaPath;
+	NSNumber *_propstatQuotaBytesRemaining;
+	NSNumber *_propstatQuotaBytesUsed;
+	NSString *_propstatOwnerID;
+	NSString *_propstatOwnerDisplayName;
+	NSMutableArray<OCChecksum *> *_propstatChecksums;
+}
+@end
+
+@implementation OCItemMultistatusDecoder
+
++ (void)initialize
+{
+	static dispatch_once_t onceToken;
+
+	dispatch_once(&onceToken, ^{
+		NSString *davNS = @"DAV:", *ocNS = @"http://owncloud.org/ns";
+		NSArray *elements = @[
+			// namespace, local name, element ID
+			@[ davNS, @"response",			@(OCItemMultistatusElementResponse) ],
+			@[ davNS, @"href",			@(OCItemMultistatusElementHref) ],
+			@[ davNS, @"propstat",			@(OCItemMultistatusElementPropstat) ],
+			@[ davNS, @"prop",			@(OCItemMultistatusElementProp) ],
+			@[ davNS, @"status",			@(OCItemMultistatusElementStatus) ],
+			@[ davNS, @"resourcetype",		@(OCItemMultistatusElementResourceType) ],
+			@[ davNS, @"collection",		@(OCItemMultistatusElementCollection) ],
+			@[ ocNS,  @"share-types",		@(OCItemMultistatusElementShareTypes) ],
+			@[ ocNS,  @"share-type",		@(OCItemMultistatusElementShareType) ],
+			@[ ocNS,  @"checksums",			@(OCItemMultistatusElementChecksums) ],
+			@[ ocNS,  @"checksum",			@(OCItemMultistatusElementChecksum) ],
+
+			@[ davNS, @"getcontentlength",		@(OCItemMultistatusElementContentLength) ],
+			@[ ocNS,  @"size",			@(OCItemMultistatusElementSize) ],
+			@[ davNS, @"getlastmodified",		@(OCItemMultistatusElementLastModified) ],
+			@[ davNS, @"creationdate",		@(OCItemMultistatusElementCreationDate) ],
+			@[ davNS, @"getcontenttype",		@(OCItemMultistatusElementContentType) ],
+			@[ davNS, @"getetag",			@(OCItemMultistatusElementETag) ],
+			@[ ocNS,  @"id",			@(OCItemMultistatusElementFileID) ],
+			@[ ocNS,  @"permissions",		@(OCItemMultistatusElementPermissions) ],
+			@[ ocNS,  @"favorite",			@(OCItemMultistatusElementFavorite) ],
+			@[ ocNS,  @"privatelink",		@(OCItemMultistatusElementPrivateLink) ],
+			@[ ocNS,  @"meta-path-for-user",	@(OCItemMultistatusElementMetaPathForUser) ],
+			@[ davNS, @"quota-available-bytes",	@(OCItemMultistatusElementQuotaAvailableBytes) ],
+			@[ davNS, @"quota-used-bytes",		@(OCItemMultistatusElementQuotaUsedBytes) ],
+			@[ ocNS,  @"owner-id",			@(OCItemMultistatusElementOwnerID) ],
+			@[ ocNS,  @"owner-display-name",	@(OCItemMultistatusElementOwnerDisplayName) ],
+		];
+
+		// Interned names live for the lifetime of the process, so they can be used as pointer keys
+		CFMutableDictionaryRef elementByName = CFDictionaryCreateMutable(kCFAllocatorDefault, elements.count, NULL, NULL);
+
+		for (NSArray *element in elements)
+		{
+			OCXMLElementName elementName = [OCXMLSAXParser internedElementNameForNamespace:element[0] localName:element[1]];
+
+			CFDictionarySetValue(elementByName, (__bridge const void *)elementName, (const void *)(uintptr_t)((NSNumber *)element[2]).unsignedIntegerValue);
+		}
+
+		sElementByName = elementByName;
+	});
+}
+
+- (instancetype)initWithXMLParser:(OCXMLParser *)xmlParser
+{
+	if ((self = [super init]) != nil)
+	{
+		_basePath = xmlParser.options[@"basePath"];
+		_usersByUserID = xmlParser.options[@"usersByUserID"];
+		_syncCollection = ((NSNumber *)xmlParser.options[@"syncCollection"]).boolValue;
+
+		_algorithmIdentifiers = [NSMutableArray new];
+	}
+
+	return (self);
+}
+
+- (void)setBasePath:(OCPath)basePath
+{
+	_basePath = basePath;
+	_basePathData = nil;
+}
+
+- (void)dealloc
+{
+	if (_text != NULL)
+	{
+		free(_text);
+		_text = NULL;
+	}
+}
+
+#pragma mark - Decoding
+- (void)xmlParser:(OCXMLParser *)xmlParser didStartElement:(OCXMLElementName)elementName attributes:(NSDictionary<NSString *,NSString *> *)attributes
+{
+	OCItemMultistatusElement element = (OCItemMultistatusElement)(uintptr_t)CFDictionaryGetValue(sElementByName, (__bridge const void *)elementName);
+
+	if (_depth < OCItemMultistatusMaxDepth)
+	{
+		_elementStack[_depth] = element;
+	}
+
+	_depth++;
+
+	switch (element)
+	{
+		case OCItemMultistatusElementResponse:
+			if (_depth == 1)
+			{
+				_item = [OCItem new];
+
+				if ((_basePathData == nil) && (_basePath.length > 0))
+				{
+					_basePathData = [_basePath dataUsingEncoding:NSUTF8StringEncoding];
+				}
+			}
+		break;
+
+		case OCItemMultistatusElementPropstat:
+			[self _resetPropstat];
+		break;
+
+		default:
+		break;
+	}
+
+	_textLength = 0;
+	_captureText = (element == OCItemMultistatusElementHref) || (element == OCItemMultistatusElementStatus) || (element >= OCItemMultistatusElementShareType);
+}
+
+- (void)xmlParser:(OCXMLParser *)xmlParser foundCharacters:(const char *)bytes length:(NSUInteger)length
+{
+	if (!_captureText) { return; }
+
+	if ((_textLength + length) > _textCapacity)
+	{
+		_textCapacity = MAX(_textCapacity * 2, _textLength + length + 256);
+		_text = realloc(_text, _textCapacity);
+	}
+
+	memcpy(&_text[_textLength], bytes, length);
+	_textLength += length;
+}
+
+- (void)xmlParser:(OCXMLParser *)xmlParser didEndElement:(OCXMLElementName)elementName
+{
+	OCItemMultistatusElement element = OCItemMultistatusElementUnknown, parent = OCItemMultistatusElementUnknown, grandParent = OCItemMultistatusElementUnknown;
+	NSUInteger index = _depth - 1;
+
+	if (index < OCItemMultistatusMaxDepth)
+	{
+		element = _elementStack[index];
+
+		if (index >= 1) { parent = _elementStack[index-1]; }
+		if (index >= 2) { grandParent = _elementStack[index-2]; }
+	}
+
+	_depth--;
+
+	if (element == OCItemMultistatusElementUnknown) { return; }
+
+	if ((element == OCItemMultistatusElementPropstat) && (parent == OCItemMultistatusElementResponse))
+	{
+		[self _applyPropstat];
+	}
+	else if ((element == OCItemMultistatusElementProp) && (parent == OCItemMultistatusElementPropstat))
+	{
+		_propstatHasProp = YES;
+	}
+	else if ((element == OCItemMultistatusElementCollection) && (parent == OCItemMultistatusElementResourceType))
+	{
+		_propstatIsCollection = YES;
+	}
+	else if (_captureText && (_textLength > 0))
+	{
+		if (parent == OCItemMultistatusElementProp)
+		{
+			if (grandParent == OCItemMultistatusElementPropstat)
+			{
+				[self _decodeProperty:element];
+			}
+		}
+		else
+		{
+			switch (element)
+			{
+				case OCItemMultistatusElementHref:
+					if (parent == OCItemMultistatusElementResponse)
+					{
+						[self _decodeHref];
+					}
+				break;
+
+				case OCItemMultistatusElementStatus:
+					// "HTTP/1.1 200 OK" - same rules as the d:status value converter in OCXMLParser
+					if ((_textLength >= 12) && (strncmp(_text, "HTTP/", 5) == 0) && (memchr(_text, ' ', _textLength) != NULL))
+					{
+						long long statusCode = OCItemMultistatusParseInteger(&_text[9], 3);
+
+						if (parent == OCItemMultistatusElementPropstat)
+						{
+							_propstatSuccess = ((statusCode >= 200) && (statusCode < 300));
+						}
+						else if (parent == OCItemMultistatusElementResponse)
+						{
+							// Used by sync-collection responses for removed members (404) and truncated results (507)
+							_responseStatusCode = statusCode;
+						}
+					}
+				break;
+
+				case OCItemMultistatusElementShareType:
+					if (parent == OCItemMultistatusElementShareTypes)
+					{
+						_propstatShareTypesMask |= OCItemMultistatusShareTypesMaskForShareType(OCItemMultistatusParseInteger(_text, _textLength));
+					}
+				break;
+
+				case OCItemMultistatusElementChecksum:
+					if (parent == OCItemMultistatusElementChecksums)
+					{
+						[self _decodeChecksums];
+					}
+				break;
+
+				default:
+				break;
+			}
+		}
+	}
+
+	_textLength = 0;
+	_captureText = NO;
+}
+
+- (void)_decodeProperty:(OCItemMultistatusElement)element
+{
+	switch (element)
+	{
+		case OCItemMultistatusElementContentLength:
+		case OCItemMultistatusElementSize:
+			_propstatSize = (NSInteger)OCItemMultistatusParseInteger(_text, _textLength);
+			_propstatHasSize = YES;
+		break;
+
+		case OCItemMultistatusElementLastModified:
+			_propstatLastModified = [NSDate dateParsedFromBytes:_text length:_textLength];
+		break;
+
+		case OCItemMultistatusElementCreationDate:
+			_propstatCreationDate = [NSDate dateParsedFromBytes:_text length:_textLength];
+		break;
+
+		case OCItemMultistatusElementContentType:
+			_propstatMimeType = OCItemMultistatusInternedString(_text, _textLength);
+		break;
+
+		case OCItemMultistatusElementETag:
+			_propstatETag = OCItemMultistatusString(_text, _textLength);
+		break;
+
+		case OCItemMultistatusElementFileID:
+			_propstatFileID = OCItemMultistatusString(_text, _textLength);
+		break;
+
+		case OCItemMultistatusElementPermissions:
+			_propstatPermissions = OCItemMultistatusParsePermissions(_text, _textLength);
+			_propstatHasPermissions = YES;
+		break;
+
+		case OCItemMultistatusElementFavorite:
+			_propstatFavorite = (OCItemMultistatusParseInteger(_text, _textLength) != 0) ? (__bridge id)kCFBooleanTrue : (__bridge id)kCFBooleanFalse;
+		break;
+
+		case OCItemMultistatusElementPrivateLink:
+		{
+			NSString *privateLink;
+
+			if ((privateLink = OCItemMultistatusString(_text, _textLength)) != nil)
+			{
+				_propstatPrivateLink = [[NSURL alloc] initWithString:privateLink];
+			}
+		}
+		break;
+
+		case OCItemMultistatusElementMetaPathForUser:
+			_propstatMetaPath = OCItemMultistatusString(_text, _textLength);
+		break;
+
+		case OCItemMultistatusElementQuotaAvailableBytes:
+			_propstatQuotaBytesRemaining = [NSNumber numberWithLongLong:OCItemMultistatusParseInteger(_text, _textLength)];
+		break;
+
+		case OCItemMultistatusElementQuotaUsedBytes:
+			_propstatQuotaBytesUsed = [NSNumber numberWithLongLong:OCItemMultistatusParseInteger(_text, _textLength)];
+		break;
+
+		case OCItemMultistatusElementOwnerID:
+			_propstatOwnerID = OCItemMultistatusInternedString(_text, _textLength);
+		break;
+
+		case OCItemMultistatusElementOwnerDisplayName:
+			_propstatOwnerDisplayName = OCItemMultistatusInternedString(_text, _textLength);
+		break;
+
+		default:
+		break;
+	}
+}
+
+- (void)_decodeHref
+{
+	NSUInteger length = _textLength;
+	const char *pathBytes = _text;
+
+	_hasHref = YES;
+	_hrefPath = nil;
+
+	// d:href is URL encoded
+	if (OCItemMultistatusPercentDecode(_text, &length))
+	{
+		// Remove base path (if applicable)
+		NSUInteger basePathLength = _basePathData.length;
+
+		if ((basePathLength > 0) && (length >= basePathLength) && (memcmp(pathBytes, _basePathData.bytes, basePathLength) == 0))
+		{
+			pathBytes += basePathLength;
+			length -= basePathLength;
+		}
+
+		_hrefPath = OCItemMultistatusString(pathBytes, length);
+	}
+}
+
+- (void)_decodeChecksums
+{
+	// "SHA1:b6e74385099c208fa310ee7d0168e270e40de4c9 MD5:2dc1a2fc2aa833b00b92dc4388a86139 ADLER32:0edff753"
+	const char *bytes = _text, *end = _text + _textLength;
+
+	if (_propstatChecksums == nil)
+	{
+		_propstatChecksums = [NSMutableArray new];
+	}
+
+	while (YES)
+	{
+		const char *tokenEnd = memchr(bytes, ' ', end - bytes);
+		const char *separator;
+
+		if (tokenEnd == NULL) { tokenEnd = end; }
+
+		// Exactly one ":" per checksum
+		if (((separator = memchr(bytes, ':', tokenEnd - bytes)) != NULL) && (memchr(separator+1, ':', tokenEnd - (separator+1)) == NULL))
+		{
+			OCChecksumAlgorithmIdentifier algorithmIdentifier;
+			NSString *checksum;
+
+			if (((algorithmIdentifier = [self _algorithmIdentifierForBytes:bytes length:(separator - bytes)]) != nil) &&
+			    ((checksum = OCItemMultistatusString(separator+1, tokenEnd - (separator+1))) != nil))
+			{
+				[_propstatChecksums addObject:[[OCChecksum alloc] initWithAlgorithmIdentifier:algorithmIdentifier checksum:checksum]];
+			}
+		}
+
+		if (tokenEnd == end) { break; }
+
+		bytes = tokenEnd + 1;
+	}
+}
+
+- (OCChecksumAlgorithmIdentifier)_algorithmIdentifierForBytes:(const char *)bytes length:(NSUInteger)length
+{
+	OCChecksumAlgorithmIdentifier algorithmIdentifier;
+
+	// Typically, only a handful of algorithms are used in a response => reuse their identifiers
+	for (NSUInteger i=0; i<_algorithmCount; i++)
+	{
+		if ((_algorithms[i].length == length) && (memcmp(_algorithms[i].bytes, bytes, length) == 0))
+		{
+			return (_algorithms[i].identifier);
+		}
+	}
+
+	if ((algorithmIdentifier = OCItemMultistatusInternedString(bytes, length)) != nil)
+	{
+		if ((_algorithmCount < OCItemMultistatusMaxAlgorithms) && (length <= sizeof(_algorithms[0].bytes)))
+		{
+			[_algorithmIdentifiers addObject:algorithmIdentifier];
+
+			_algorithms[_algorithmCount].identifier = algorithmIdentifier;
+			memcpy(_algorithms[_algorithmCount].bytes, bytes, length);
+			_algorithms[_algorithmCount].length = length;
+			_algorithmCount++;
+		}
+	}
+
+	return (algorithmIdentifier);
+}
+
+#pragma mark - Propstat
+- (void)_resetPropstat
+{
+	_propstatSuccess = NO;
+	_propstatHasProp = NO;
+	_propstatIsCollection = NO;
+	_propstatHasSize = NO;
+	_propstatSize = 0;
+	_propstatHasPermissions = NO;
+	_propstatPermissions = 0;
+	_propstatShareTypesMask = OCShareTypesMaskNone;
+	_propstatLastModified = nil;
+	_propstatCreationDate = nil;
+	_propstatMimeType = nil;
+	_propstatETag = nil;
+	_propstatFileID = nil;
+	_propstatFavorite = nil;
+	_propstatPrivateLink = nil;
+	_propstatMetaPath = nil;
+	_propstatQuotaBytesRemaining = nil;
+	_propstatQuotaBytesUsed = nil;
+	_propstatOwnerID = nil;
+	_propstatOwnerDisplayName = nil;
+	_propstatChecksums = nil;
+}
+
+- (void)_applyPropstat
+{
+	OCItem *item = _item;
+
+	if (!_propstatSuccess || !_propstatHasProp || (item == nil))
+	{
+		[self _resetPropstat];
+		return;
+	}
+
+	item.type = _propstatIsCollection ? OCItemTypeCollection : OCItemTypeFile;
+	item.shareTypesMask |= _propstatShareTypesMask;
+
+	if (_propstatChecksums != nil)
+	{
+		item.checksums = (item.checksums != nil) ? [item.checksums arrayByAddingObjectsFromArray:_propstatChecksums] : _propstatChecksums;
+	}
+
+	// Share OCUser instances for owner
+	item.owner = [self _ownerWithID:_propstatOwnerID displayName:_propstatOwnerDisplayName];
+
+	if (_propstatHasSize) 			{ item.size = _propstatSize; }
+	if (_propstatHasPermissions)		{ item.permissions = _propstatPermissions; }
+	if (_propstatLastModified != nil)	{ item.lastModified = _propstatLastModified; }
+	if (_propstatCreationDate != nil)	{ item.creationDate = _propstatCreationDate; }
+	if (_propstatMimeType != nil)		{ item.mimeType = _propstatMimeType; }
+	if (_propstatETag != nil)		{ item.eTag = _propstatETag; }
+	if (_propstatFileID != nil)		{ item.fileID = _propstatFileID; }
+	if (_propstatFavorite != nil)		{ item.isFavorite = _propstatFavorite; }
+	if (_propstatPrivateLink != nil)	{ item.privateLink = _propstatPrivateLink; }
+	if (_propstatMetaPath != nil)		{ _metaPath = _propstatMetaPath; }
+	if (_propstatQuotaBytesRemaining != nil){ item.quotaBytesRemaining = _propstatQuotaBytesRemaining; }
+	if (_propstatQuotaBytesUsed != nil)	{ item.quotaBytesUsed = _propstatQuotaBytesUsed; }
+
+	[self _resetPropstat];
+}
+
+- (OCUser *)_ownerWithID:(NSString *)ownerID displayName:(NSString *)ownerDisplayName
+{
+	OCUser *owner = nil;
+
+	if (ownerID == nil) { return (nil); }
+
+	if ((ownerDisplayName != nil) && (_usersByUserID != nil))
+	{
+		@synchronized(_usersByUserID)
+		{
+			if ((owner = _usersByUserID[ownerID]) != nil)
+			{
+				if (![owner.displayName isEqualToString:ownerDisplayName])
+				{
+					owner = nil;
+				}
+			}
+			else
+			{
+				owner = [OCUser userWithUserName:ownerID displayName:ownerDisplayName];
+
+				_usersByUserID[ownerID] = owner;
+			}
+		}
+	}
+
+	if (owner == nil)
+	{
+		owner = [OCUser userWithUserName:ownerID displayName:ownerDisplayName];
+	}
+
+	return (owner);
+}
+
+#pragma mark - Object
+- (id)finishObjectForXMLParser:(OCXMLParser *)xmlParser
+{
+	OCItem *item = nil;
+
+	if (_syncCollection && (_responseStatusCode != 0))
+	{
+		if (_responseStatusCode == OCHTTPStatusCodeNOT_FOUND)
+		{
+			// Member removed since the sync token
+			if (_hasHref && (_item != nil) && (_hrefPath != nil))
+			{
+				item = _item;
+				item.path = _hrefPath;
+				item.removed = YES;
+			}
+		}
+		else if (_responseStatusCode == OCHTTPStatusCodeINSUFFICIENT_STORAGE)
+		{
+			// Number of changes exceeded the limit: request the remaining changes with the returned sync token
+			xmlParser.userInfo[@"syncCollectionTruncated"] = @(YES);
+		}
+	}
+	else if (_hasHref && (_item != nil))
+	{
+		item = _item;
+		item.path = (_metaPath != nil) ? _metaPath : _hrefPath;
+
+		// Clean up quota
+		if (item.quotaBytesRemaining.integerValue < 0)
+		{
+			// A negative number for quotaBytesRemaining indicates that no quota is in effect
+			item.quotaBytesRemaining = nil;
+		}
+	}
+
+	_item = nil;
+	_hasHref = NO;
+	_hrefPath = nil;
+	_metaPath = nil;
+	_responseStatusCode = 0;
+	_depth = 0;
+
+	[self _resetPropstat];
+
+	return (item);
+}
+
+@end
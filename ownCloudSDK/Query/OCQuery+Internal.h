@@ -30,6 +30,7 @@
 
 #pragma mark - Update processed results
 - (void)updateProcessedResultsIfNeeded:(BOOL)ifNeeded;
+- (void)updateProcessedResultsRemovingItems:(NSArray <OCItem *> *)removedItems addingItems:(NSArray <OCItem *> *)addedItems; //!< Removes/inserts the items from/into the sorted processed results in place and tracks the changes for the next changeset. Falls back to -setNeedsRecomputation where that isn't possible.
 
 #pragma mark - Needs recomputation
 - (void)setNeedsRecomputation;
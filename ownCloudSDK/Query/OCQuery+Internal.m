@@ -60,6 +60,7 @@
 	@synchronized(self)
 	{
 		OCCoreItemList *itemList = [OCCoreItemList new];
+		itemList.indexes = OCCoreItemListIndexPath;
 		NSDictionary <OCPath, OCItem *> *itemsByPath;
 
 		// Release cached item list
@@ -153,17 +154,117 @@
 
 			// We just recomputed
 			_processedQueryResults = newProcessedResults;
+			_processedQueryResultsShared = NO;
 			_needsRecomputation = NO;
+
+			// Changes can't be tracked across a recomputation
+			_changedItemsPreviousVersions = nil;
+			_changedItemsCurrentVersions = nil;
 		}
 	}
 }
 
+- (void)updateProcessedResultsRemovingItems:(NSArray <OCItem *> *)removedItems addingItems:(NSArray <OCItem *> *)addedItems
+{
+	@synchronized(self)
+	{
+		NSComparator sortComparator = _sortComparator;
+		NSUInteger changeCount = removedItems.count + addedItems.count;
+
+		if (changeCount == 0)
+		{
+			return;
+		}
+
+		// In-place updates need up-to-date, sorted results - and only pay off if the changes are small relative to the results
+		if (_needsRecomputation || (_processedQueryResults == nil) || (sortComparator == nil) || (changeCount > MAX(_processedQueryResults.count / 4, 32)))
+		{
+			[self setNeedsRecomputation];
+			return;
+		}
+
+		// Copy results that have been handed out before modifying them
+		if (_processedQueryResultsShared)
+		{
+			_processedQueryResults = [[NSMutableArray alloc] initWithArray:_processedQueryResults];
+			_processedQueryResultsShared = NO;
+		}
+
+		for (OCItem *removedItem in removedItems)
+		{
+			NSUInteger index;
+
+			if ((index = [OCQueryChangeSet indexOfItem:removedItem inSortedResults:_processedQueryResults sortComparator:sortComparator]) != NSNotFound)
+			{
+				[_processedQueryResults removeObjectAtIndex:index];
+
+				[self _trackChangedItem:removedItem previousVersion:removedItem currentVersion:NSNull.null];
+			}
+		}
+
+		for (OCItem *addedItem in addedItems)
+		{
+			BOOL includeItem = YES;
+
+			for (id<OCQueryFilter> filter in _filters)
+			{
+				if (![filter query:self shouldIncludeItem:addedItem])
+				{
+					includeItem = NO;
+					break;
+				}
+			}
+
+			if (includeItem)
+			{
+				NSUInteger index = [_processedQueryResults indexOfObject:addedItem inSortedRange:NSMakeRange(0, _processedQueryResults.count) options:NSBinarySearchingInsertionIndex|NSBinarySearchingLastEqual usingComparator:sortComparator];
+
+				[_processedQueryResults insertObject:addedItem atIndex:index];
+
+				[self _trackChangedItem:addedItem previousVersion:NSNull.null currentVersion:addedItem];
+			}
+		}
+
+		self.hasChangesAvailable = YES;
+	}
+}
+
+- (void)_trackChangedItem:(OCItem *)item previousVersion:(id)previousVersion currentVersion:(id)currentVersion
+{
+	OCLocalID localID;
+
+	if (_changedItemsPreviousVersions == nil)
+	{
+		return;
+	}
+
+	if ((localID = item.localID) == nil)
+	{
+		// Can't track items without localID => changeset needs to be computed from the full results
+		_changedItemsPreviousVersions = nil;
+		_changedItemsCurrentVersions = nil;
+		return;
+	}
+
+	if (_changedItemsPreviousVersions[localID] == nil)
+	{
+		// First change since the last changeset => previousVersion is the version in _lastQueryResults
+		_changedItemsPreviousVersions[localID] = previousVersion;
+	}
+
+	_changedItemsCurrentVersions[localID] = currentVersion;
+}
+
 #pragma mark - Needs recomputation
 - (void)setNeedsRecomputation
 {
 	@synchronized(self)
 	{
 		_needsRecomputation = YES;
+
+		_changedItemsPreviousVersions = nil;
+		_changedItemsCurrentVersions = nil;
+
 		self.hasChangesAvailable = YES;
 	}
 }
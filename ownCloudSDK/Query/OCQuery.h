@@ -73,6 +73,10 @@ typedef void(^OCQueryCustomSource)(OCCore *core, OCQuery *query, OCQueryCustomRe
 
 	NSArray <OCItem *> *_lastQueryResults;				// processedQueryResults at the time a changeset was last requested.
 
+	BOOL _processedQueryResultsShared;				// YES if _processedQueryResults has been handed out and needs to be copied before modifying it in place.
+	NSMutableDictionary <OCLocalID, id> *_changedItemsPreviousVersions; // Items changed in place since the last changeset: version in _lastQueryResults (NSNull if not contained) - nil if changes are not tracked.
+	NSMutableDictionary <OCLocalID, id> *_changedItemsCurrentVersions;  // Items changed in place since the last changeset: version in _processedQueryResults (NSNull if not contained) - nil if changes are not tracked.
+
 	NSMutableArray <id<OCQueryFilter>> *_filters;
 	NSMutableDictionary <OCQueryFilterIdentifier, id<OCQueryFilter>> *_filtersByIdentifier; // Filters to be applied on the query results, by identifier
 
@@ -179,8 +179,19 @@
 {
 	if (self.inputFilter != nil)
 	{
-		[self modifyFullQueryResults:^BOOL(NSMutableArray<OCItem *> * _Nonnull fullQueryResults, OCCoreItemList * _Nonnull (^ _Nonnull coreItemListProvider)(void)) {
-			BOOL madeChanges = NO;
+		@synchronized(self)
+		{
+			NSMutableArray <OCItem *> *fullQueryResults = _fullQueryResults;
+			NSMutableArray <OCItem *> *appendItems = [NSMutableArray new];
+			NSMapTable <OCItem *, id> *replacementsByItem = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory|NSPointerFunctionsObjectPointerPersonality) valueOptions:NSPointerFunctionsStrongMemory]; // existing item -> updated item or NSNull (remove)
+
+			NSMutableArray <OCItem *> *resultsRemovedItems = [NSMutableArray new];
+			NSMutableArray <OCItem *> *resultsAddedItems = [NSMutableArray new];
+
+			if (fullQueryResults == nil)
+			{
+				return;
+			}
 
 			if (addedItems != nil)
 			{
@@ -189,15 +200,14 @@
 					if ([self.inputFilter query:self shouldIncludeItem:addedItem])
 					{
 						// Add new items that match the filter
-						[fullQueryResults addObject:addedItem];
-						madeChanges = YES;
+						[appendItems addObject:addedItem];
 					}
 				}
 			}
 
 			if (updatedItems != nil)
 			{
-				OCCoreItemList *fullQueryResultsItemList = coreItemListProvider();
+				OCCoreItemList *fullQueryResultsItemList = [self fullQueryResultsItemList];
 
 				for (OCItem *updatedItem in updatedItems.items)
 				{
@@ -209,28 +219,20 @@
 						if (existingItem != nil)
 						{
 							// Update existing items that match the filter
-							NSUInteger indexOfExistingItem;
-
-							if ((indexOfExistingItem = [fullQueryResults indexOfObjectIdenticalTo:existingItem]) != NSNotFound)
-							{
-								[fullQueryResults replaceObjectAtIndex:indexOfExistingItem withObject:updatedItem];
-							}
+							[replacementsByItem setObject:updatedItem forKey:existingItem];
 						}
 						else
 						{
 							// Add items that match the filter after having been updated
-							[fullQueryResults addObject:updatedItem];
+							[appendItems addObject:updatedItem];
 						}
-
-						madeChanges = YES;
 					}
 					else
 					{
 						if (existingItem != nil)
 						{
 							// Remove items that no longer match the filter after having been updated
-							[fullQueryResults removeObject:existingItem];
-							madeChanges = YES;
+							[replacementsByItem setObject:NSNull.null forKey:existingItem];
 						}
 					}
 				}
@@ -238,7 +240,7 @@
 
 			if (removedItems != nil)
 			{
-				OCCoreItemList *fullQueryResultsItemList = coreItemListProvider();
+				OCCoreItemList *fullQueryResultsItemList = [self fullQueryResultsItemList];
 
 				// Remove removed items in the query result set
 				for (OCItem *removedItem in removedItems.items)
@@ -247,14 +249,59 @@
 
 					if ((removeItem = fullQueryResultsItemList.itemsByLocalID[removedItem.localID]) != nil)
 					{
-						[fullQueryResults removeObject:removeItem];
-						madeChanges = YES;
+						[replacementsByItem setObject:NSNull.null forKey:removeItem];
 					}
 				}
 			}
 
-			return (madeChanges);
-		}];
+			if ((replacementsByItem.count == 0) && (appendItems.count == 0))
+			{
+				return;
+			}
+
+			// Apply replacements and removals in a single pass
+			if (replacementsByItem.count > 0)
+			{
+				NSMutableIndexSet *removeIndexes = nil;
+				NSUInteger count = fullQueryResults.count;
+
+				for (NSUInteger idx=0; idx<count; idx++)
+				{
+					OCItem *item = fullQueryResults[idx];
+					id replacement;
+
+					if ((replacement = [replacementsByItem objectForKey:item]) != nil)
+					{
+						[resultsRemovedItems addObject:item];
+
+						if (replacement == NSNull.null)
+						{
+							if (removeIndexes == nil) { removeIndexes = [NSMutableIndexSet new]; }
+							[removeIndexes addIndex:idx];
+						}
+						else
+						{
+							fullQueryResults[idx] = replacement;
+							[resultsAddedItems addObject:replacement];
+						}
+					}
+				}
+
+				if (removeIndexes != nil)
+				{
+					[fullQueryResults removeObjectsAtIndexes:removeIndexes];
+				}
+			}
+
+			[fullQueryResults addObjectsFromArray:appendItems];
+			[resultsAddedItems addObjectsFromArray:appendItems];
+
+			// Release cached item list
+			_fullQueryResultsItemList = nil;
+
+			// Keep processed results up-to-date
+			[self updateProcessedResultsRemovingItems:resultsRemovedItems addingItems:resultsAddedItems];
+		}
 	}
 	else
 	{
@@ -347,6 +394,7 @@
 		[self updateProcessedResultsIfNeeded:YES];
 
 		queryResults = _processedQueryResults;
+		_processedQueryResultsShared = YES;
 	}
 
 	return (queryResults);
@@ -380,6 +428,8 @@
 - (void)requestChangeSetWithFlags:(OCQueryChangeSetRequestFlag)flags completionHandler:(OCQueryChangeSetRequestCompletionHandler)completionHandler
 {
 	NSArray <OCItem *> *processedResults=nil, *lastResults=nil;
+	NSDictionary <OCLocalID, id> *changedItemsPreviousVersions=nil, *changedItemsCurrentVersions=nil;
+	NSComparator sortComparator = nil;
 	OCSyncAnchor syncAnchor = nil;
 	BOOL changesAvailable = NO;
 
@@ -392,7 +442,16 @@
 
 		changesAvailable = _hasChangesAvailable;
 
+		// Changes tracked since the last changeset
+		changedItemsPreviousVersions = _changedItemsPreviousVersions;
+		changedItemsCurrentVersions = _changedItemsCurrentVersions;
+		sortComparator = _sortComparator;
+
 		_lastQueryResults = _processedQueryResults;
+		_processedQueryResultsShared = YES;
+
+		_changedItemsPreviousVersions = [NSMutableDictionary new];
+		_changedItemsCurrentVersions = [NSMutableDictionary new];
 
 		if (_hasChangesAvailable)
 		{
@@ -408,6 +467,10 @@
 			_processedQueryResults = [NSMutableArray new];
 			_lastQueryResults = [NSMutableArray new];
 
+			_processedQueryResultsShared = NO;
+			_changedItemsPreviousVersions = nil;
+			_changedItemsCurrentVersions = nil;
+
 			syncAnchor = _lastMergeSyncAnchor;
 		}
 
@@ -417,7 +480,21 @@
 
 			if (changesAvailable)
 			{
-				changeSet = [[OCQueryChangeSet alloc] initWithQueryResult:processedResults relativeTo:(((flags & OCQueryChangeSetRequestFlagOnlyResults)!=0)?lastResults:nil)];
+				if ((flags & OCQueryChangeSetRequestFlagOnlyResults) != 0)
+				{
+					// Results only
+					changeSet = [[OCQueryChangeSet alloc] initWithQueryResult:processedResults relativeTo:nil];
+				}
+				else if ((changedItemsPreviousVersions != nil) && (lastResults != nil) && (sortComparator != nil))
+				{
+					// Results were updated in place => only look at the changed items
+					changeSet = [[OCQueryChangeSet alloc] initWithQueryResult:processedResults previousQueryResult:lastResults previousVersions:changedItemsPreviousVersions currentVersions:changedItemsCurrentVersions sortComparator:sortComparator];
+				}
+				else
+				{
+					// Results were recomputed => compare with the last results
+					changeSet = [[OCQueryChangeSet alloc] initWithQueryResult:processedResults relativeTo:lastResults];
+				}
 			}
 			else
 			{
@@ -27,7 +27,9 @@ typedef NS_ENUM(NSUInteger, OCQueryChangeSetOperation)
 	OCQueryChangeSetOperationRemove,	//!< Remove item(s)
 	OCQueryChangeSetOperationUpdate,	//!< Update item(s)
 
-	OCQueryChangeSetOperationContentSwap	//!< Replace items with that from queryResult
+	OCQueryChangeSetOperationContentSwap,	//!< Replace items with that from queryResult
+
+	OCQueryChangeSetOperationMove		//!< Move item(s) from the indexes in .movedItemsPreviousIndexes to the indexes in indexSet
 };
 
 typedef void(^OCQueryChangeSetEnumerator)(OCQueryChangeSet *changeSet, OCQueryChangeSetOperation operation, NSArray <OCItem *> *items, NSIndexSet *indexSet);
@@ -39,6 +41,10 @@ typedef void(^OCQueryChangeSetEnumerator)(OCQueryChangeSet *changeSet, OCQueryCh
 
 @property(strong) NSArray <OCItem *> *queryResult;	//!< Returns an array of OCItems representing the query's latest results after sorting and filtering - at the time the change set was requested.
 
+/*
+	Indexes of removed items refer to the previous query result, indexes of inserted, updated and moved items to the new .queryResult. Removals,
+	insertions and moves can therefore be applied together as one batch update - after which updated items can be refreshed at their (new) indexes.
+*/
 @property(strong) NSIndexSet *insertedItemsIndexSet; 	//!< Indexes at which items were inserted
 @property(strong) NSArray <OCItem *> *insertedItems; 	//!< Inserted items ordered by index
 
@@ -48,10 +54,18 @@ typedef void(^OCQueryChangeSetEnumerator)(OCQueryChangeSet *changeSet, OCQueryCh
 @property(strong) NSIndexSet *updatedItemsIndexSet;  	//!< Indexes at which items were updated
 @property(strong) NSArray <OCItem *> *updatedItems;  	//!< Updated items ordered by index
 
+@property(strong) NSIndexSet *movedItemsIndexSet;	//!< Indexes to which items were moved
+@property(strong) NSArray <OCItem *> *movedItems;	//!< Moved items ordered by index
+@property(strong) NSArray <NSNumber *> *movedItemsPreviousIndexes; //!< Indexes of the moved items in the previous query result, in the order of .movedItems
+
 @property(strong) OCSyncAnchor syncAnchor;		//!< For sync anchor queries, the sync anchor at the time of the changeset
 
 #pragma mark - Init & Dealloc
-- (instancetype)initWithQueryResult:(NSArray <OCItem *> *)queryResult relativeTo:(NSArray <OCItem *> *)previousQueryResult;
+- (instancetype)initWithQueryResult:(NSArray <OCItem *> *)queryResult relativeTo:(NSArray <OCItem *> *)previousQueryResult; //!< Computes the changes between previousQueryResult and queryResult in linear time (plus O(n log n) for move detection). If previousQueryResult is nil, the change set is a content swap.
+- (instancetype)initWithQueryResult:(NSArray <OCItem *> *)queryResult previousQueryResult:(NSArray <OCItem *> *)previousQueryResult previousVersions:(NSDictionary <OCLocalID, id> *)previousVersions currentVersions:(NSDictionary <OCLocalID, id> *)currentVersions sortComparator:(NSComparator)sortComparator; //!< Computes the changes for just the items changed since previousQueryResult - both results sorted using sortComparator - in O(k log n). previousVersions and currentVersions contain the versions of the changed items in previousQueryResult and queryResult by localID - or NSNull if they're not contained in them.
+
+#pragma mark - Sorted results
++ (NSUInteger)indexOfItem:(OCItem *)item inSortedResults:(NSArray <OCItem *> *)sortedResults sortComparator:(NSComparator)sortComparator; //!< Returns the index of item (identical instance) in sortedResults using binary search - or NSNotFound.
 
 #pragma mark - Change set enumeration
 - (void)enumerateChangesUsingBlock:(OCQueryChangeSetEnumerator)enumerator; //!< Can be used to enumerate
@@ -18,6 +18,82 @@
 
 #import "OCQueryChangeSet.h"
 
+typedef struct
+{
+	__unsafe_unretained OCItem *previousItem;	// Version of the item in the previous query result (nil if not contained)
+	__unsafe_unretained OCItem *currentItem;	// Version of the item in the new query result (nil if not contained)
+
+	NSUInteger previousIndex;			// Index of previousItem in the previous query result (NSNotFound if not contained)
+	NSUInteger currentIndex;			// Index of currentItem in the new query result (NSNotFound if not contained)
+
+	BOOL moved;
+} OCQueryChangeSetRecord;
+
+static int OCQueryChangeSetCompareIndexes(const void *index1, const void *index2)
+{
+	NSUInteger idx1 = *((const NSUInteger *)index1), idx2 = *((const NSUInteger *)index2);
+
+	return ((idx1 < idx2) ? -1 : ((idx1 > idx2) ? 1 : 0));
+}
+
+static int OCQueryChangeSetCompareRecordsByPreviousIndex(const void *record1, const void *record2)
+{
+	return (OCQueryChangeSetCompareIndexes(&((const OCQueryChangeSetRecord *)record1)->previousIndex, &((const OCQueryChangeSetRecord *)record2)->previousIndex));
+}
+
+static int OCQueryChangeSetCompareRecordsByCurrentIndex(const void *record1, const void *record2)
+{
+	return (OCQueryChangeSetCompareIndexes(&((const OCQueryChangeSetRecord *)record1)->currentIndex, &((const OCQueryChangeSetRecord *)record2)->currentIndex));
+}
+
+static NSUInteger OCQueryChangeSetCountIndexesBelow(const NSUInteger *sortedIndexes, NSUInteger count, NSUInteger index)
+{
+	NSUInteger low = 0, high = count;
+
+	while (low < high)
+	{
+		NSUInteger mid = low + ((high - low) / 2);
+
+		if (sortedIndexes[mid] < index)
+		{
+			low = mid + 1;
+		}
+		else
+		{
+			high = mid;
+		}
+	}
+
+	return (low);
+}
+
+static NSUInteger OCQueryChangeSetIndexOfItem(NSArray <OCItem *> *sortedItems, OCItem *item, NSComparator sortComparator)
+{
+	NSUInteger count = sortedItems.count, index;
+
+	if ((index = [sortedItems indexOfObject:item inSortedRange:NSMakeRange(0, count) options:NSBinarySearchingFirstEqual usingComparator:sortComparator]) != NSNotFound)
+	{
+		// Find the item among those the comparator considers equal
+		for (; index < count; index++)
+		{
+			OCItem *candidateItem = sortedItems[index];
+
+			if (candidateItem == item)
+			{
+				return (index);
+			}
+
+			if (sortComparator(candidateItem, item) != NSOrderedSame)
+			{
+				break;
+			}
+		}
+	}
+
+	// Comparator isn't consistent for this item => fall back to linear search
+	return ([sortedItems indexOfObjectIdenticalTo:item]);
+}
+
 @implementation OCQueryChangeSet
 
 #pragma mark - Init & Dealloc
@@ -25,16 +101,307 @@
 {
 	if ((self = [super init]) != nil)
 	{
-		// Minimum implementation
 		self.queryResult = queryResult;
 
 		self.containsChanges = YES;
-		self.contentSwap = YES;
+
+		if (previousQueryResult == nil)
+		{
+			self.contentSwap = YES;
+		}
+		else
+		{
+			// Every item is a candidate for a change
+			NSMutableDictionary <id, NSNumber *> *previousIndexesByKey = [[NSMutableDictionary alloc] initWithCapacity:previousQueryResult.count];
+			NSUInteger maxRecordCount = previousQueryResult.count + queryResult.count, recordCount = 0;
+			OCQueryChangeSetRecord *records = calloc(MAX(maxRecordCount, 1), sizeof(OCQueryChangeSetRecord));
+			BOOL *previousItemMatched = calloc(MAX(previousQueryResult.count, 1), sizeof(BOOL));
+			__block BOOL keysComplete = YES;
+
+			[previousQueryResult enumerateObjectsUsingBlock:^(OCItem *item, NSUInteger idx, BOOL *stop) {
+				id key;
+
+				if ((key = item.localID) != nil)
+				{
+					previousIndexesByKey[key] = @(idx);
+				}
+				else
+				{
+					keysComplete = NO;
+					*stop = YES;
+				}
+			}];
+
+			if (keysComplete)
+			{
+				NSUInteger currentIndex = 0;
+
+				for (OCItem *item in queryResult)
+				{
+					OCQueryChangeSetRecord *record = &records[recordCount++];
+					NSNumber *previousIndex;
+					id key;
+
+					if ((key = item.localID) == nil)
+					{
+						keysComplete = NO;
+						break;
+					}
+
+					record->currentItem = item;
+					record->currentIndex = currentIndex++;
+					record->previousIndex = NSNotFound;
+
+					if ((previousIndex = previousIndexesByKey[key]) != nil)
+					{
+						record->previousIndex = previousIndex.unsignedIntegerValue;
+						record->previousItem = previousQueryResult[record->previousIndex];
+						previousItemMatched[record->previousIndex] = YES;
+					}
+				}
+
+				for (NSUInteger previousIndex=0; keysComplete && (previousIndex < previousQueryResult.count); previousIndex++)
+				{
+					if (!previousItemMatched[previousIndex])
+					{
+						OCQueryChangeSetRecord *record = &records[recordCount++];
+
+						record->previousItem = previousQueryResult[previousIndex];
+						record->previousIndex = previousIndex;
+						record->currentIndex = NSNotFound;
+					}
+				}
+			}
+
+			if (keysComplete)
+			{
+				[self _computeChangesFromRecords:records count:recordCount];
+			}
+			else
+			{
+				// Items without localID can't be tracked
+				self.contentSwap = YES;
+			}
+
+			free(records);
+			free(previousItemMatched);
+		}
+	}
+
+	return(self);
+}
+
+- (instancetype)initWithQueryResult:(NSArray <OCItem *> *)queryResult previousQueryResult:(NSArray <OCItem *> *)previousQueryResult previousVersions:(NSDictionary <OCLocalID, id> *)previousVersions currentVersions:(NSDictionary <OCLocalID, id> *)currentVersions sortComparator:(NSComparator)sortComparator
+{
+	if ((self = [super init]) != nil)
+	{
+		NSUInteger recordCount = 0;
+		OCQueryChangeSetRecord *records = calloc(MAX(previousVersions.count, 1), sizeof(OCQueryChangeSetRecord));
+
+		self.queryResult = queryResult;
+
+		for (OCLocalID localID in previousVersions)
+		{
+			OCItem *previousItem = previousVersions[localID], *currentItem = currentVersions[localID];
+			OCQueryChangeSetRecord *record = &records[recordCount];
+
+			record->previousItem = [previousItem isKindOfClass:[OCItem class]] ? previousItem : nil;
+			record->currentItem = [currentItem isKindOfClass:[OCItem class]] ? currentItem : nil;
+
+			record->previousIndex = (record->previousItem != nil) ? OCQueryChangeSetIndexOfItem(previousQueryResult, record->previousItem, sortComparator) : NSNotFound;
+			record->currentIndex = (record->currentItem != nil) ? OCQueryChangeSetIndexOfItem(queryResult, record->currentItem, sortComparator) : NSNotFound;
+
+			if ((record->previousIndex != NSNotFound) || (record->currentIndex != NSNotFound))
+			{
+				recordCount++;
+			}
+		}
+
+		self.containsChanges = (recordCount > 0);
+
+		[self _computeChangesFromRecords:records count:recordCount];
+
+		free(records);
 	}
 
 	return(self);
 }
 
+#pragma mark - Sorted results
++ (NSUInteger)indexOfItem:(OCItem *)item inSortedResults:(NSArray <OCItem *> *)sortedResults sortComparator:(NSComparator)sortComparator
+{
+	return (OCQueryChangeSetIndexOfItem(sortedResults, item, sortComparator));
+}
+
+#pragma mark - Change computation
+- (void)_computeChangesFromRecords:(OCQueryChangeSetRecord *)records count:(NSUInteger)recordCount
+{
+	NSUInteger *touchedPreviousIndexes = calloc(MAX(recordCount, 1), sizeof(NSUInteger)), touchedPreviousCount = 0;
+	NSUInteger *touchedCurrentIndexes = calloc(MAX(recordCount, 1), sizeof(NSUInteger)), touchedCurrentCount = 0;
+	NSUInteger *stableRecordIndexes = calloc(MAX(recordCount, 1), sizeof(NSUInteger)), stableCount = 0;
+
+	// Indexes occupied by changed items
+	for (NSUInteger idx=0; idx<recordCount; idx++)
+	{
+		if (records[idx].previousIndex != NSNotFound) { touchedPreviousIndexes[touchedPreviousCount++] = records[idx].previousIndex; }
+		if (records[idx].currentIndex != NSNotFound) { touchedCurrentIndexes[touchedCurrentCount++] = records[idx].currentIndex; }
+	}
+
+	qsort(touchedPreviousIndexes, touchedPreviousCount, sizeof(NSUInteger), OCQueryChangeSetCompareIndexes);
+	qsort(touchedCurrentIndexes, touchedCurrentCount, sizeof(NSUInteger), OCQueryChangeSetCompareIndexes);
+
+	// Sort by previous index, so stable items are collected in previous order
+	qsort(records, recordCount, sizeof(OCQueryChangeSetRecord), OCQueryChangeSetCompareRecordsByPreviousIndex);
+
+	// Items contained in both results keep their place if they remain between the same unchanged items ..
+	for (NSUInteger idx=0; idx<recordCount; idx++)
+	{
+		OCQueryChangeSetRecord *record = &records[idx];
+
+		if ((record->previousIndex != NSNotFound) && (record->currentIndex != NSNotFound))
+		{
+			NSUInteger unchangedItemsBeforePrevious = record->previousIndex - OCQueryChangeSetCountIndexesBelow(touchedPreviousIndexes, touchedPreviousCount, record->previousIndex);
+			NSUInteger unchangedItemsBeforeCurrent = record->currentIndex - OCQueryChangeSetCountIndexesBelow(touchedCurrentIndexes, touchedCurrentCount, record->currentIndex);
+
+			if (unchangedItemsBeforePrevious == unchangedItemsBeforeCurrent)
+			{
+				stableRecordIndexes[stableCount++] = idx;
+			}
+			else
+			{
+				record->moved = YES;
+			}
+		}
+	}
+
+	// .. and their order relative to each other: keep the longest subsequence in previous order that's also in current order, move the rest
+	if (stableCount > 0)
+	{
+		NSUInteger *tailRecordIndexes = calloc(stableCount, sizeof(NSUInteger)), tailCount = 0;
+		NSUInteger *predecessors = calloc(stableCount, sizeof(NSUInteger));
+		BOOL *inSubsequence = calloc(stableCount, sizeof(BOOL));
+
+		for (NSUInteger stableIdx=0; stableIdx<stableCount; stableIdx++)
+		{
+			NSUInteger currentIndex = records[stableRecordIndexes[stableIdx]].currentIndex;
+			NSUInteger low = 0, high = tailCount;
+
+			while (low < high)
+			{
+				NSUInteger mid = low + ((high - low) / 2);
+
+				if (records[stableRecordIndexes[tailRecordIndexes[mid]]].currentIndex < currentIndex)
+				{
+					low = mid + 1;
+				}
+				else
+				{
+					high = mid;
+				}
+			}
+
+			predecessors[stableIdx] = (low > 0) ? tailRecordIndexes[low-1] : NSNotFound;
+			tailRecordIndexes[low] = stableIdx;
+
+			if (low == tailCount)
+			{
+				tailCount++;
+			}
+		}
+
+		for (NSUInteger stableIdx = (tailCount > 0) ? tailRecordIndexes[tailCount-1] : NSNotFound; stableIdx != NSNotFound; stableIdx = predecessors[stableIdx])
+		{
+			inSubsequence[stableIdx] = YES;
+		}
+
+		for (NSUInteger stableIdx=0; stableIdx<stableCount; stableIdx++)
+		{
+			if (!inSubsequence[stableIdx])
+			{
+				records[stableRecordIndexes[stableIdx]].moved = YES;
+			}
+		}
+
+		free(tailRecordIndexes);
+		free(predecessors);
+		free(inSubsequence);
+	}
+
+	// Removed items (ordered by previous index)
+	{
+		NSMutableIndexSet *removedItemsIndexSet = [NSMutableIndexSet new];
+		NSMutableArray <OCItem *> *removedItems = [NSMutableArray new];
+
+		for (NSUInteger idx=0; idx<recordCount; idx++)
+		{
+			if ((records[idx].previousIndex != NSNotFound) && (records[idx].currentIndex == NSNotFound))
+			{
+				[removedItemsIndexSet addIndex:records[idx].previousIndex];
+				[removedItems addObject:records[idx].previousItem];
+			}
+		}
+
+		self.removedItemsIndexSet = removedItemsIndexSet;
+		self.removedItems = removedItems;
+	}
+
+	// Inserted, updated and moved items (ordered by current index)
+	{
+		NSMutableIndexSet *insertedItemsIndexSet = [NSMutableIndexSet new], *updatedItemsIndexSet = [NSMutableIndexSet new], *movedItemsIndexSet = [NSMutableIndexSet new];
+		NSMutableArray <OCItem *> *insertedItems = [NSMutableArray new], *updatedItems = [NSMutableArray new], *movedItems = [NSMutableArray new];
+		NSMutableArray <NSNumber *> *movedItemsPreviousIndexes = [NSMutableArray new];
+
+		qsort(records, recordCount, sizeof(OCQueryChangeSetRecord), OCQueryChangeSetCompareRecordsByCurrentIndex);
+
+		for (NSUInteger idx=0; idx<recordCount; idx++)
+		{
+			OCQueryChangeSetRecord *record = &records[idx];
+
+			if (record->currentIndex == NSNotFound)
+			{
+				continue;
+			}
+
+			if (record->previousIndex == NSNotFound)
+			{
+				[insertedItemsIndexSet addIndex:record->currentIndex];
+				[insertedItems addObject:record->currentItem];
+			}
+			else
+			{
+				if (record->previousItem != record->currentItem)
+				{
+					[updatedItemsIndexSet addIndex:record->currentIndex];
+					[updatedItems addObject:record->currentItem];
+				}
+
+				if (record->moved)
+				{
+					[movedItemsIndexSet addIndex:record->currentIndex];
+					[movedItems addObject:record->currentItem];
+					[movedItemsPreviousIndexes addObject:@(record->previousIndex)];
+				}
+			}
+		}
+
+		self.insertedItemsIndexSet = insertedItemsIndexSet;
+		self.insertedItems = insertedItems;
+
+		self.updatedItemsIndexSet = updatedItemsIndexSet;
+		self.updatedItems = updatedItems;
+
+		self.movedItemsIndexSet = movedItemsIndexSet;
+		self.movedItems = movedItems;
+		self.movedItemsPreviousIndexes = movedItemsPreviousIndexes;
+	}
+
+	self.containsChanges = (_removedItems.count + _insertedItems.count + _updatedItems.count + _movedItems.count) > 0;
+
+	free(touchedPreviousIndexes);
+	free(touchedCurrentIndexes);
+	free(stableRecordIndexes);
+}
+
 #pragma mark - Change set enumeration
 - (void)enumerateChangesUsingBlock:(OCQueryChangeSetEnumerator)enumerator
 {
@@ -60,6 +427,11 @@
 			{
 				enumerator(self, OCQueryChangeSetOperationInsert, self.insertedItems, self.insertedItemsIndexSet);
 			}
+
+			if (_movedItems.count > 0)
+			{
+				enumerator(self, OCQueryChangeSetOperationMove, self.movedItems, self.movedItemsIndexSet);
+			}
 		}
 	}
 }
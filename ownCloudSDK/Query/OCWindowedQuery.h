@@ -0,0 +1,78 @@
+//
+//  OCWindowedQuery.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCQuery.h"
+
+/*
+	Windowed folder query:
+	- the folder contents is read in name order from the database's ordered (parentPath, removed, name) index
+	- only the rows in .window plus .prefetchMargin rows on either side are materialized as OCItems, so memory use is bounded by the window size rather than the folder size
+	- changes are expressed as index shifts (OCQueryIndexShift) rather than diffs of the complete results
+	- .queryResults and regular change sets contain the materialized rows
+
+	Limitation: the memory bound only applies to the query itself. The folder is refreshed from the server through the regular item list task,
+	which retrieves the complete folder listing (depth 1 PROPFIND) and compares it against all cached items of the folder. Peak memory use
+	during a refresh therefore still grows with the folder size.
+*/
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class OCWindowedQuery;
+
+@interface OCQueryIndexShift : NSObject
+
+@property(readonly) NSUInteger index; //!< Index (in the row order before the shift) at which rows were inserted (.delta > 0) or removed (.delta < 0). Rows previously at index (insertions) or at index+|delta| (removals) and after move by .delta.
+@property(readonly) NSInteger delta; //!< Number of rows inserted (positive) or removed (negative) at .index
+
++ (instancetype)shiftAtIndex:(NSUInteger)index delta:(NSInteger)delta;
+
+@end
+
+@interface OCQueryWindowChangeSet : NSObject
+
+@property(readonly) BOOL reset; //!< YES if the materialized rows were (re)loaded from the database. .materializedItems should then be taken as a whole, .indexShifts is empty.
+@property(readonly,strong) NSArray<OCQueryIndexShift *> *indexShifts; //!< Index shifts since the last change set, in the order they need to be applied. Shifts for rows before the materialized range whose exact position isn't known are reported at the closest index with the same effect on the materialized rows. Changes after the materialized range are only reflected in .numberOfItems.
+@property(readonly,strong) NSIndexSet *updatedIndexes; //!< Indexes (after applying .indexShifts) of materialized rows whose item was updated in place
+@property(readonly) NSUInteger numberOfItems; //!< Total number of items in the folder
+@property(readonly) NSRange materializedRange; //!< Range of the rows contained in .materializedItems
+@property(readonly,strong) NSArray<OCItem *> *materializedItems; //!< The materialized rows
+
+@end
+
+typedef void(^OCQueryWindowChangeSetRequestCompletionHandler)(OCWindowedQuery *query, OCQueryWindowChangeSet *changeSet);
+
+@interface OCWindowedQuery : OCQuery
+
++ (instancetype)queryForFolderPath:(OCPath)folderPath window:(NSRange)window; //!< Windowed query for the contents of the folder at folderPath, sorted by name
+
+@property(strong,readonly) OCPath folderPath; //!< Path of the folder targeted by the query
+
+@property(assign,nonatomic) NSRange window; //!< Range of rows requested by the consumer (f.ex. the visible rows). Rows outside the materialized range are loaded from the database when the window is moved.
+@property(assign,nonatomic) NSUInteger prefetchMargin; //!< Number of rows materialized before and after .window (default: 64). Rows further than twice the margin away from .window are released.
+
+@property(readonly,nonatomic) NSUInteger numberOfItems; //!< Total number of items in the folder
+@property(readonly,nonatomic) NSRange materializedRange; //!< Range of the rows currently materialized
+
+- (nullable OCItem *)itemAtIndex:(NSUInteger)index; //!< Returns the item at index if it is materialized, nil otherwise
+
+- (void)requestWindowChangeSetWithCompletionHandler:(OCQueryWindowChangeSetRequestCompletionHandler)completionHandler; //!< Requests a change set containing all index shifts since the last request
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,777 @@
+//
+//  OCWindowedQuery.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCWindowedQuery.h"
+#import "OCQuery+Internal.h"
+#import "OCCore.h"
+#import "OCCore+Internal.h"
+#import "OCCore+ItemList.h"
+#import "OCDatabase.h"
+#import "OCSQLiteCollationLocalized.h"
+#import "NSString+OCPath.h"
+#import "OCMeasurement.h"
+#import "OCLogger.h"
+#import "NSError+OCError.h"
+
+#pragma mark - Index shift
+@implementation OCQueryIndexShift
+
++ (instancetype)shiftAtIndex:(NSUInteger)index delta:(NSInteger)delta
+{
+	OCQueryIndexShift *shift = [self new];
+
+	shift->_index = index;
+	shift->_delta = delta;
+
+	return (shift);
+}
+
+- (BOOL)_coalesceWithShift:(OCQueryIndexShift *)shift
+{
+	if ((_delta > 0) && (shift.delta > 0) && (shift.index >= _index) && (shift.index <= (_index + _delta)))
+	{
+		// Insertion adjacent to or inside the rows inserted by the receiver
+		_delta += shift.delta;
+		return (YES);
+	}
+
+	if ((_delta < 0) && (shift.delta < 0))
+	{
+		if (shift.index == _index)
+		{
+			// Removal of the rows following the rows removed by the receiver
+			_delta += shift.delta;
+			return (YES);
+		}
+
+		if ((shift.index + (NSUInteger)(-shift.delta)) == _index)
+		{
+			// Removal of the rows preceding the rows removed by the receiver
+			_index = shift.index;
+			_delta += shift.delta;
+			return (YES);
+		}
+	}
+
+	return (NO);
+}
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, index: %lu, delta: %ld>", NSStringFromClass(self.class), self, (unsigned long)_index, (long)_delta]);
+}
+
+@end
+
+#pragma mark - Window change set
+@interface OCQueryWindowChangeSet ()
+
+@property(readwrite) BOOL reset;
+@property(readwrite,strong) NSArray<OCQueryIndexShift *> *indexShifts;
+@property(readwrite,strong) NSIndexSet *updatedIndexes;
+@property(readwrite) NSUInteger numberOfItems;
+@property(readwrite) NSRange materializedRange;
+@property(readwrite,strong) NSArray<OCItem *> *materializedItems;
+
+@end
+
+@implementation OCQueryWindowChangeSet
+
+- (NSString *)description
+{
+	return ([NSString stringWithFormat:@"<%@: %p, reset: %d, indexShifts: %@, updatedIndexes: %@, numberOfItems: %lu, materializedRange: %@>", NSStringFromClass(self.class), self, _reset, _indexShifts, _updatedIndexes, (unsigned long)_numberOfItems, NSStringFromRange(_materializedRange)]);
+}
+
+@end
+
+#pragma mark - Windowed query
+typedef void(^OCWindowedQueryLoadCompletionHandler)(NSError * _Nullable error, NSArray<OCItem *> * _Nullable items);
+
+@interface OCWindowedQuery ()
+{
+	__weak OCCore *_core;
+
+	NSRange _window;
+
+	NSMutableArray<OCItem *> *_materializedItems;
+	NSRange _materializedRange;
+	NSUInteger _numberOfItems;
+	BOOL _materialized;
+
+	NSMutableArray<OCQueryIndexShift *> *_pendingIndexShifts;
+	NSMutableSet<OCLocalID> *_pendingUpdatedLocalIDs;
+	BOOL _pendingReset;
+
+	NSUInteger _generation; // Incremented whenever changes to the folder are applied, so loads that overlap with changes can be detected and repeated
+	BOOL _loading;
+	BOOL _needsLoad;
+	NSMutableArray<OCWindowedQueryLoadCompletionHandler> *_loadCompletionHandlers;
+}
+@end
+
+@implementation OCWindowedQuery
+
+#pragma mark - Initializers
++ (instancetype)queryForFolderPath:(OCPath)folderPath window:(NSRange)window
+{
+	OCWindowedQuery *query = [self new];
+
+	query->_folderPath = folderPath;
+	query->_window = window;
+
+	query.isCustom = YES;
+
+	OCMeasurement *measurement = [OCMeasurement measurementWithTitle:[NSString stringWithFormat:@"Windowed query for folder %@", folderPath]];
+	[query attachMeasurement:measurement];
+
+	return (query);
+}
+
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_prefetchMargin = 64;
+
+		_materializedItems = [NSMutableArray new];
+
+		_pendingIndexShifts = [NSMutableArray new];
+		_pendingUpdatedLocalIDs = [NSMutableSet new];
+
+		_loadCompletionHandlers = [NSMutableArray new];
+	}
+
+	return (self);
+}
+
+#pragma mark - Window
+- (NSRange)window
+{
+	@synchronized(self)
+	{
+		return (_window);
+	}
+}
+
+- (void)setWindow:(NSRange)window
+{
+	@synchronized(self)
+	{
+		_window = window;
+	}
+
+	[self _updateMaterializedRowsForWindow];
+}
+
+- (NSUInteger)numberOfItems
+{
+	@synchronized(self)
+	{
+		return (_numberOfItems);
+	}
+}
+
+- (NSRange)materializedRange
+{
+	@synchronized(self)
+	{
+		return (_materializedRange);
+	}
+}
+
+- (nullable OCItem *)itemAtIndex:(NSUInteger)index
+{
+	@synchronized(self)
+	{
+		if (NSLocationInRange(index, _materializedRange))
+		{
+			return (_materializedItems[index - _materializedRange.location]);
+		}
+	}
+
+	return (nil);
+}
+
+- (NSRange)_targetRangeForNumberOfItems:(NSUInteger)numberOfItems
+{
+	// Window plus prefetch margin on either side, clamped to the folder contents
+	NSUInteger location = (_window.location > _prefetchMargin) ? (_window.location - _prefetchMargin) : 0;
+	NSUInteger end = MIN(NSMaxRange(_window) + _prefetchMargin, numberOfItems);
+
+	if (location > end)
+	{
+		location = end;
+	}
+
+	return (NSMakeRange(location, end - location));
+}
+
+- (void)_updateMaterializedRowsForWindow
+{
+	BOOL needsLoad = NO, released = NO;
+
+	@synchronized(self)
+	{
+		if (!_materialized)
+		{
+			return;
+		}
+
+		NSUInteger requiredLocation = MIN(_window.location, _numberOfItems);
+		NSUInteger requiredEnd = MIN(NSMaxRange(_window), _numberOfItems);
+
+		if ((requiredEnd > requiredLocation) && ((requiredLocation < _materializedRange.location) || (requiredEnd > NSMaxRange(_materializedRange))))
+		{
+			// Rows of the window are not materialized
+			needsLoad = YES;
+		}
+		else
+		{
+			// Release rows further than twice the prefetch margin away from the window
+			NSUInteger keepLocation = (_window.location > (2 * _prefetchMargin)) ? (_window.location - (2 * _prefetchMargin)) : 0;
+			NSUInteger keepEnd = NSMaxRange(_window) + (2 * _prefetchMargin);
+
+			if (NSMaxRange(_materializedRange) > keepEnd)
+			{
+				NSUInteger releaseCount = MIN(NSMaxRange(_materializedRange) - keepEnd, _materializedItems.count);
+
+				[_materializedItems removeObjectsInRange:NSMakeRange(_materializedItems.count - releaseCount, releaseCount)];
+				_materializedRange.length -= releaseCount;
+
+				released = YES;
+			}
+
+			if (_materializedRange.location < keepLocation)
+			{
+				NSUInteger releaseCount = MIN(keepLocation - _materializedRange.location, _materializedItems.count);
+
+				[_materializedItems removeObjectsInRange:NSMakeRange(0, releaseCount)];
+				_materializedRange.location += releaseCount;
+				_materializedRange.length -= releaseCount;
+
+				released = YES;
+			}
+		}
+	}
+
+	if (needsLoad)
+	{
+		[self _loadRowsWithCompletionHandler:nil];
+	}
+	else if (released)
+	{
+		[self _updateFullQueryResults];
+	}
+}
+
+#pragma mark - Loading
+- (void)_loadRowsWithCompletionHandler:(nullable OCWindowedQueryLoadCompletionHandler)completionHandler
+{
+	OCCore *core;
+	OCPath folderPath = _folderPath;
+
+	@synchronized(self)
+	{
+		if ((core = _core) == nil)
+		{
+			// Not started yet
+			if (completionHandler != nil)
+			{
+				completionHandler(OCError(OCErrorInternal), nil);
+			}
+			return;
+		}
+
+		if (completionHandler != nil)
+		{
+			[_loadCompletionHandlers addObject:[completionHandler copy]];
+		}
+
+		if (_loading)
+		{
+			_needsLoad = YES;
+			return;
+		}
+
+		_loading = YES;
+	}
+
+	// Count and retrieve from the core queue, so no changes to the folder can be written to the database in between
+	[core queueBlock:^{
+		NSUInteger generation;
+
+		@synchronized(self)
+		{
+			generation = self->_generation;
+		}
+
+		[core.vault.database numberOfCacheItemsInFolder:folderPath completionHandler:^(OCDatabase *db, NSError *error, NSNumber *count) {
+			if (error != nil)
+			{
+				[core queueBlock:^{
+					[self _finishLoadForGeneration:generation error:error numberOfItems:0 range:NSMakeRange(0, 0) items:nil];
+				}];
+				return;
+			}
+
+			NSRange range;
+
+			@synchronized(self)
+			{
+				range = [self _targetRangeForNumberOfItems:count.unsignedIntegerValue];
+			}
+
+			[db retrieveCacheItemsInFolder:folderPath range:range completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				[core queueBlock:^{
+					[self _finishLoadForGeneration:generation error:error numberOfItems:count.unsignedIntegerValue range:range items:items];
+				}];
+			}];
+		}];
+	}];
+}
+
+- (void)_finishLoadForGeneration:(NSUInteger)generation error:(NSError *)error numberOfItems:(NSUInteger)numberOfItems range:(NSRange)range items:(NSArray<OCItem *> *)items
+{
+	NSArray<OCWindowedQueryLoadCompletionHandler> *completionHandlers = nil;
+	NSArray<OCItem *> *materializedItems = nil;
+	BOOL loadAgain = NO;
+
+	@synchronized(self)
+	{
+		_loading = NO;
+
+		if ((error == nil) && (generation != _generation))
+		{
+			// Changes to the folder were applied while loading => load again to get a consistent state
+			OCLogDebug(@"Folder %@ changed while loading rows %@ - loading again", OCLogPrivate(_folderPath), NSStringFromRange(range));
+			loadAgain = YES;
+		}
+		else
+		{
+			if (error == nil)
+			{
+				_materializedItems = (items != nil) ? [[NSMutableArray alloc] initWithArray:items] : [NSMutableArray new];
+				_materializedRange = NSMakeRange(range.location, _materializedItems.count);
+				_numberOfItems = numberOfItems;
+				_materialized = YES;
+
+				_pendingReset = YES;
+				[_pendingIndexShifts removeAllObjects];
+				[_pendingUpdatedLocalIDs removeAllObjects];
+
+				materializedItems = [_materializedItems copy];
+			}
+			else
+			{
+				OCLogError(@"Error loading rows %@ of folder %@: %@", NSStringFromRange(range), OCLogPrivate(_folderPath), error);
+			}
+
+			completionHandlers = [_loadCompletionHandlers copy];
+			[_loadCompletionHandlers removeAllObjects];
+
+			if (_needsLoad)
+			{
+				// The window moved while loading
+				loadAgain = (error == nil);
+			}
+		}
+
+		_needsLoad = NO;
+	}
+
+	if (materializedItems != nil)
+	{
+		[self _updateFullQueryResults];
+	}
+
+	for (OCWindowedQueryLoadCompletionHandler completionHandler in completionHandlers)
+	{
+		completionHandler(error, materializedItems);
+	}
+
+	if (loadAgain)
+	{
+		[self _loadRowsWithCompletionHandler:nil];
+	}
+}
+
+#pragma mark - Custom query
+- (void)provideFullQueryResultsForCore:(OCCore *)core resultHandler:(OCQueryCustomResultHandler)resultHandler
+{
+	@synchronized(self)
+	{
+		_core = core;
+	}
+
+	[self _loadRowsWithCompletionHandler:^(NSError * _Nullable error, NSArray<OCItem *> * _Nullable items) {
+		resultHandler(error, items);
+	}];
+
+	// Refresh the folder from the server - changes are delivered via -updateWithAddedItems:updatedItems:removedItems:
+	// (the item list task loads the complete listing and all cached items of the folder, so this isn't bounded by the window - see header)
+	[core queueBlock:^{
+		[core scheduleItemListTaskForPath:self->_folderPath forDirectoryUpdateJob:nil withMeasurement:[self extractedMeasurement]];
+	}];
+}
+
+- (void)setFullQueryResults:(NSMutableArray<OCItem *> *)fullQueryResults
+{
+	// The full query results of a windowed query are always its materialized rows
+	@synchronized(self)
+	{
+		[super setFullQueryResults:[[NSMutableArray alloc] initWithArray:_materializedItems]];
+	}
+}
+
+- (void)_updateFullQueryResults
+{
+	[self setFullQueryResults:nil];
+}
+
+#pragma mark - Index shifts
+- (void)_addIndexShift:(OCQueryIndexShift *)shift
+{
+	if (_pendingReset)
+	{
+		// Consumers will take the materialized rows as a whole
+		return;
+	}
+
+	if (![_pendingIndexShifts.lastObject _coalesceWithShift:shift])
+	{
+		[_pendingIndexShifts addObject:shift];
+	}
+}
+
+- (NSUInteger)_materializedIndexForName:(NSString *)name
+{
+	NSComparator comparator = OCSQLiteCollationLocalized.sortComparator;
+	NSUInteger lower = 0, upper = _materializedItems.count;
+
+	// Binary search for the first row not sorting before name
+	while (lower < upper)
+	{
+		NSUInteger middle = lower + ((upper - lower) / 2);
+
+		if (comparator(_materializedItems[middle].path.lastPathComponent, name) == NSOrderedAscending)
+		{
+			lower = middle + 1;
+		}
+		else
+		{
+			upper = middle;
+		}
+	}
+
+	return (lower);
+}
+
+- (NSUInteger)_materializedIndexOfLocalID:(OCLocalID)localID
+{
+	if (localID == nil)
+	{
+		return (NSNotFound);
+	}
+
+	return ([_materializedItems indexOfObjectPassingTest:^BOOL(OCItem *item, NSUInteger idx, BOOL *stop) {
+		return ([item.localID isEqual:localID]);
+	}]);
+}
+
+- (BOOL)_insertRowForItem:(OCItem *)item
+{
+	BOOL coversStart = (_materializedRange.location == 0);
+	BOOL coversEnd = (NSMaxRange(_materializedRange) >= _numberOfItems);
+	NSUInteger index;
+
+	if ((_materializedItems.count == 0) && !(coversStart && coversEnd))
+	{
+		// No materialized rows to determine the position against
+		return (NO);
+	}
+
+	index = [self _materializedIndexForName:item.path.lastPathComponent];
+
+	if ((index == 0) && !coversStart)
+	{
+		// Sorts before the materialized rows
+		[self _addIndexShift:[OCQueryIndexShift shiftAtIndex:_materializedRange.location delta:1]];
+		_materializedRange.location++;
+	}
+	else if ((index == _materializedItems.count) && !coversEnd)
+	{
+		// Sorts after the materialized rows
+	}
+	else
+	{
+		[_materializedItems insertObject:item atIndex:index];
+		[self _addIndexShift:[OCQueryIndexShift shiftAtIndex:(_materializedRange.location + index) delta:1]];
+		_materializedRange.length++;
+	}
+
+	_numberOfItems++;
+
+	return (YES);
+}
+
+- (BOOL)_removeRowForItem:(OCItem *)item name:(NSString *)name
+{
+	NSComparator comparator = OCSQLiteCollationLocalized.sortComparator;
+	NSUInteger index;
+
+	if ((index = [self _materializedIndexOfLocalID:item.localID]) != NSNotFound)
+	{
+		[_materializedItems removeObjectAtIndex:index];
+		[self _addIndexShift:[OCQueryIndexShift shiftAtIndex:(_materializedRange.location + index) delta:-1]];
+		_materializedRange.length--;
+	}
+	else
+	{
+		if (_materializedItems.count == 0)
+		{
+			// No materialized rows to determine the position against
+			return (NO);
+		}
+
+		if (comparator(name, _materializedItems.firstObject.path.lastPathComponent) == NSOrderedAscending)
+		{
+			// Sorts before the materialized rows
+			if (_materializedRange.location == 0)
+			{
+				return (NO);
+			}
+
+			[self _addIndexShift:[OCQueryIndexShift shiftAtIndex:(_materializedRange.location - 1) delta:-1]];
+			_materializedRange.location--;
+		}
+		else if (comparator(name, _materializedItems.lastObject.path.lastPathComponent) == NSOrderedDescending)
+		{
+			// Sorts after the materialized rows
+			if (NSMaxRange(_materializedRange) >= _numberOfItems)
+			{
+				return (NO);
+			}
+		}
+		else
+		{
+			// Sorts between materialized rows, but isn't one of them
+			return (NO);
+		}
+	}
+
+	if (_numberOfItems > 0)
+	{
+		_numberOfItems--;
+	}
+
+	return (YES);
+}
+
+- (void)updateWithAddedItems:(nullable OCCoreItemList *)addedItems updatedItems:(nullable OCCoreItemList *)updatedItems removedItems:(nullable OCCoreItemList *)removedItems
+{
+	OCPath folderPath = _folderPath;
+	NSMutableSet<OCLocalID> *removedLocalIDs = [NSMutableSet new];
+	BOOL consistent = YES, changed = NO;
+
+	BOOL(^IsInFolder)(OCPath path) = ^(OCPath path) {
+		return ((BOOL)((path != nil) && [path.parentPath isEqual:folderPath]));
+	};
+
+	OCPath(^PreviousPathOf)(OCItem *item) = ^(OCItem *item) {
+		return (((item.previousPath != nil) && ![item.previousPath isEqual:item.path]) ? item.previousPath : nil);
+	};
+
+	@synchronized(self)
+	{
+		// Removed items
+		for (OCItem *item in removedItems.items)
+		{
+			if (IsInFolder(item.path))
+			{
+				_generation++;
+				changed = YES;
+
+				if (item.localID != nil)
+				{
+					[removedLocalIDs addObject:item.localID];
+				}
+
+				if (_materialized)
+				{
+					consistent = [self _removeRowForItem:item name:item.path.lastPathComponent] && consistent;
+				}
+			}
+		}
+
+		// Updated items
+		for (OCItem *item in updatedItems.items)
+		{
+			OCPath previousPath = PreviousPathOf(item);
+			BOOL isInFolder = IsInFolder(item.path);
+			BOOL alreadyRemoved = ((item.localID != nil) && [removedLocalIDs containsObject:item.localID]);
+			NSUInteger index;
+
+			if (!isInFolder && !IsInFolder(previousPath))
+			{
+				continue;
+			}
+
+			if (!isInFolder && alreadyRemoved)
+			{
+				// Moved out of the folder - its row was already removed via the relocated copy in removedItems
+				continue;
+			}
+
+			if (!_materialized)
+			{
+				_generation++;
+				continue;
+			}
+
+			if ((index = [self _materializedIndexOfLocalID:item.localID]) != NSNotFound)
+			{
+				if (isInFolder && [_materializedItems[index].path isEqual:item.path])
+				{
+					// Update in place
+					_materializedItems[index] = item;
+					[_pendingUpdatedLocalIDs addObject:item.localID];
+				}
+				else
+				{
+					// Renamed or moved out of the folder
+					_generation++;
+
+					consistent = [self _removeRowForItem:item name:_materializedItems[index].path.lastPathComponent] && consistent;
+
+					if (isInFolder)
+					{
+						consistent = [self _insertRowForItem:item] && consistent;
+					}
+				}
+
+				changed = YES;
+			}
+			else if (previousPath != nil)
+			{
+				// Renamed or moved outside the materialized rows
+				_generation++;
+
+				if (IsInFolder(previousPath) && !alreadyRemoved)
+				{
+					consistent = [self _removeRowForItem:item name:previousPath.lastPathComponent] && consistent;
+				}
+
+				if (isInFolder)
+				{
+					consistent = [self _insertRowForItem:item] && consistent;
+				}
+
+				changed = YES;
+			}
+		}
+
+		// Added items
+		for (OCItem *item in addedItems.items)
+		{
+			NSUInteger index;
+
+			if (!IsInFolder(item.path))
+			{
+				continue;
+			}
+
+			_generation++;
+			changed = YES;
+
+			if (!_materialized)
+			{
+				continue;
+			}
+
+			if ((index = [self _materializedIndexOfLocalID:item.localID]) != NSNotFound)
+			{
+				// Already contained
+				_materializedItems[index] = item;
+				[_pendingUpdatedLocalIDs addObject:item.localID];
+			}
+			else
+			{
+				consistent = [self _insertRowForItem:item] && consistent;
+			}
+		}
+
+		if (!_materialized)
+		{
+			// Changes will be picked up by the load in progress
+			return;
+		}
+	}
+
+	if (!consistent)
+	{
+		// Positions could not be determined from the materialized rows => reload them
+		OCLogDebug(@"Reloading rows of windowed query for %@", OCLogPrivate(folderPath));
+		[self _loadRowsWithCompletionHandler:nil];
+	}
+	else if (changed)
+	{
+		[self _updateFullQueryResults];
+		[self _updateMaterializedRowsForWindow];
+	}
+}
+
+#pragma mark - Change sets
+- (void)requestWindowChangeSetWithCompletionHandler:(OCQueryWindowChangeSetRequestCompletionHandler)completionHandler
+{
+	OCQueryWindowChangeSet *changeSet = [OCQueryWindowChangeSet new];
+
+	@synchronized(self)
+	{
+		NSMutableIndexSet *updatedIndexes = [NSMutableIndexSet new];
+		NSUInteger location = _materializedRange.location;
+
+		if (!_pendingReset && (_pendingUpdatedLocalIDs.count > 0))
+		{
+			[_materializedItems enumerateObjectsUsingBlock:^(OCItem *item, NSUInteger idx, BOOL *stop) {
+				if ((item.localID != nil) && [self->_pendingUpdatedLocalIDs containsObject:item.localID])
+				{
+					[updatedIndexes addIndex:(location + idx)];
+				}
+			}];
+		}
+
+		changeSet.reset = _pendingReset;
+		changeSet.indexShifts = _pendingReset ? @[] : [_pendingIndexShifts copy];
+		changeSet.updatedIndexes = updatedIndexes;
+		changeSet.numberOfItems = _numberOfItems;
+		changeSet.materializedRange = _materializedRange;
+		changeSet.materializedItems = [_materializedItems copy];
+
+		_pendingReset = NO;
+		[_pendingIndexShifts removeAllObjects];
+		[_pendingUpdatedLocalIDs removeAllObjects];
+	}
+
+	// Return on the query's queue, in order of requests
+	[self queueBlock:^{
+		completionHandler(self, changeSet);
+	}];
+}
+
+@end
@@ -18,6 +18,7 @@
 
 #import "OCUser.h"
 #import "OCMacros.h"
+#import "OCStringInternPool.h"
 
 @implementation OCUser
 
@@ -155,8 +156,8 @@
 {
 	if ((self = [super init]) != nil)
 	{
-		self.userName = [decoder decodeObjectOfClass:[NSString class] forKey:@"userName"];
-		self.displayName = [decoder decodeObjectOfClass:[NSString class] forKey:@"displayName"];
+		self.userName = [OCStringInternPool.sharedPool internString:[decoder decodeObjectOfClass:[NSString class] forKey:@"userName"]];
+		self.displayName = [OCStringInternPool.sharedPool internString:[decoder decodeObjectOfClass:[NSString class] forKey:@"displayName"]];
 		self.emailAddress = [decoder decodeObjectOfClass:[NSString class] forKey:@"emailAddress"];
 		self.avatarData = [decoder decodeObjectOfClass:[NSData class] forKey:@"avatarData"];
 		_forceIsRemote = [decoder decodeObjectOfClass:[NSNumber class] forKey:@"forceIsRemote"];
@@ -27,6 +27,8 @@ typedef void(^OCAsyncSequentialQueueExecutor)(OCAsyncSequentialQueueJob job, dis
 
 @property(copy) OCAsyncSequentialQueueExecutor executor;
 
+@property(assign,nonatomic) NSUInteger maximumConcurrentJobs; //!< Maximum number of jobs running at the same time. Jobs are still started in the order they were added. Defaults to 1 (sequential execution).
+
 - (void)async:(OCAsyncSequentialQueueJob)job;
 
 @end
@@ -23,7 +23,8 @@
 {
 	OCAsyncSequentialQueueExecutor _executor;
 
-	BOOL _busy;
+	NSUInteger _maximumConcurrentJobs;
+	NSUInteger _runningJobs;
 	NSMutableArray<OCAsyncSequentialQueueJob> *_queuedJobs;
 }
 
@@ -45,11 +46,46 @@
 		};
 
 		_queuedJobs = [NSMutableArray new];
+
+		_maximumConcurrentJobs = 1;
 	}
 
 	return(self);
 }
 
+#pragma mark - Concurrency
+- (NSUInteger)maximumConcurrentJobs
+{
+	@synchronized (self)
+	{
+		return (_maximumConcurrentJobs);
+	}
+}
+
+- (void)setMaximumConcurrentJobs:(NSUInteger)maximumConcurrentJobs
+{
+	NSUInteger startJobs = 0;
+
+	@synchronized (self)
+	{
+		_maximumConcurrentJobs = MAX(maximumConcurrentJobs, 1);
+
+		// Fill up newly available capacity right away
+		while (((_runningJobs + startJobs) < _maximumConcurrentJobs) && (startJobs < _queuedJobs.count))
+		{
+			startJobs++;
+		}
+
+		_runningJobs += startJobs;
+	}
+
+	while (startJobs > 0)
+	{
+		[self runNextJob];
+		startJobs--;
+	}
+}
+
 #pragma mark - Job execution
 - (void)async:(OCAsyncSequentialQueueJob)job
 {
@@ -59,10 +95,10 @@
 	{
 		[_queuedJobs addObject:[job copy]];
 
-		if (!_busy)
+		if (_runningJobs < _maximumConcurrentJobs)
 		{
 			runNextJob = YES;
-			_busy = YES;
+			_runningJobs++;
 		}
 	}
 
@@ -87,7 +123,7 @@
 		}
 		else
 		{
-			_busy = NO;
+			_runningJobs--;
 		}
 	}
 
@@ -98,8 +134,24 @@
 		self.executor(nextJob, ^{
 			if (!didRunNext)
 			{
+				BOOL runNextJob = YES;
+
 				didRunNext = YES;
-				[self runNextJob];
+
+				@synchronized (self)
+				{
+					if (self->_runningJobs > self->_maximumConcurrentJobs)
+					{
+						// Concurrency was lowered while the job was running => don't start another job in its place
+						self->_runningJobs--;
+						runNextJob = NO;
+					}
+				}
+
+				if (runNextJob)
+				{
+					[self runNextJob];
+				}
 			}
 			else
 			{
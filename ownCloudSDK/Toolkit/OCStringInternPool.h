@@ -0,0 +1,47 @@
+//
+//  OCStringInternPool.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Bounded pool of unique, immutable strings. Values that repeat across many items (MIME types, user names,
+	checksum algorithm identifiers, ..) can be replaced by the pooled instance, so that all items share
+	one string instead of holding a copy each.
+*/
+
+@interface OCStringInternPool : NSObject
+
+@property(class,readonly,strong,nonatomic) OCStringInternPool *sharedPool; //!< Pool shared by item decoders for low-cardinality item metadata
+
+@property(readonly) NSUInteger maximumCount; //!< Maximum number of strings in the pool. Once reached, new strings are no longer added, but returned as-is.
+@property(readonly) NSUInteger maximumLength; //!< Maximum length of strings added to the pool. Longer strings are returned as-is.
+
+@property(readonly,nonatomic) NSUInteger count; //!< Number of strings in the pool
+
+- (instancetype)initWithMaximumCount:(NSUInteger)maximumCount maximumLength:(NSUInteger)maximumLength;
+
+- (nullable NSString *)internString:(nullable NSString *)string; //!< Returns the pooled string equal to string - adding it to the pool, if it's not yet in there
+- (nullable NSString *)internedStringWithBytes:(const char *)bytes length:(NSUInteger)length; //!< Returns the pooled string for the UTF-8 bytes - only allocating a new string if it's not yet in the pool
+
+- (void)removeAllStrings; //!< Empties the pool
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,142 @@
+//
+//  OCStringInternPool.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <os/lock.h>
+#import "OCStringInternPool.h"
+
+@interface OCStringInternPool ()
+{
+	os_unfair_lock _lock;
+	NSMutableSet<NSString *> *_strings;
+}
+@end
+
+@implementation OCStringInternPool
+
++ (OCStringInternPool *)sharedPool
+{
+	static dispatch_once_t onceToken;
+	static OCStringInternPool *sharedPool;
+
+	dispatch_once(&onceToken, ^{
+		sharedPool = [[OCStringInternPool alloc] initWithMaximumCount:8192 maximumLength:256];
+	});
+
+	return (sharedPool);
+}
+
+- (instancetype)initWithMaximumCount:(NSUInteger)maximumCount maximumLength:(NSUInteger)maximumLength
+{
+	if ((self = [super init]) != nil)
+	{
+		_lock = OS_UNFAIR_LOCK_INIT;
+		_strings = [NSMutableSet new];
+
+		_maximumCount = maximumCount;
+		_maximumLength = maximumLength;
+	}
+
+	return (self);
+}
+
+- (NSUInteger)count
+{
+	NSUInteger count;
+
+	os_unfair_lock_lock(&_lock);
+	count = _strings.count;
+	os_unfair_lock_unlock(&_lock);
+
+	return (count);
+}
+
+- (NSString *)_pooledStringEqualTo:(NSString *)string addIfMissing:(NSString *(^)(void))provider
+{
+	NSString *pooledString;
+
+	os_unfair_lock_lock(&_lock);
+
+	if (((pooledString = [_strings member:string]) == nil) && (_strings.count < _maximumCount) && (provider != nil))
+	{
+		if ((pooledString = provider()) != nil)
+		{
+			[_strings addObject:pooledString];
+		}
+	}
+
+	os_unfair_lock_unlock(&_lock);
+
+	return (pooledString);
+}
+
+- (NSString *)internString:(NSString *)string
+{
+	NSString *pooledString;
+
+	if (string == nil) { return (nil); }
+
+	if (string.length > _maximumLength)
+	{
+		return (string);
+	}
+
+	if ((pooledString = [self _pooledStringEqualTo:string addIfMissing:^{ return ([string copy]); }]) != nil)
+	{
+		return (pooledString);
+	}
+
+	return (string);
+}
+
+- (NSString *)internedStringWithBytes:(const char *)bytes length:(NSUInteger)length
+{
+	NSString *pooledString = nil;
+
+	if (bytes == NULL) { return (nil); }
+
+	if (length <= _maximumLength)
+	{
+		// Wrap the bytes without copying them for the lookup - and only create a real copy if the string needs to be added to the pool
+		CFStringRef lookupString;
+
+		if ((lookupString = CFStringCreateWithBytesNoCopy(kCFAllocatorDefault, (const UInt8 *)bytes, (CFIndex)length, kCFStringEncodingUTF8, false, kCFAllocatorNull)) != NULL)
+		{
+			pooledString = [self _pooledStringEqualTo:(__bridge NSString *)lookupString addIfMissing:^NSString *{
+				return ([[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding]);
+			}];
+
+			CFRelease(lookupString);
+		}
+	}
+
+	if (pooledString == nil)
+	{
+		pooledString = [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+	}
+
+	return (pooledString);
+}
+
+- (void)removeAllStrings
+{
+	os_unfair_lock_lock(&_lock);
+	[_strings removeAllObjects];
+	os_unfair_lock_unlock(&_lock);
+}
+
+@end
@@ -0,0 +1,54 @@
+//
+//  OCTimerWheel.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+	Hierarchical timer wheel tracking one deadline per key:
+	- deadlines are rounded up to multiples of .resolution, so that coinciding deadlines expire together
+	- adding, moving and removing a deadline is O(1)
+	- level 0 covers the next 64 ticks with one slot per tick, each higher level covers 64 times the range of the level below
+	  with one slot per period of the level below. Slots are moved down a level when the wheel reaches their period.
+	- deadlines beyond the range of the highest level are kept in an overflow set until they come into range
+*/
+
+@interface OCTimerWheel<K> : NSObject
+
+@property(readonly) NSTimeInterval resolution; //!< Duration of a tick (in seconds)
+@property(readonly,nonatomic) NSUInteger count; //!< Number of keys with a deadline
+
+- (instancetype)initWithResolution:(NSTimeInterval)resolution startDate:(NSDate *)startDate NS_DESIGNATED_INITIALIZER; //!< Creates a timer wheel whose current time is startDate
+- (instancetype)initWithResolution:(NSTimeInterval)resolution; //!< Creates a timer wheel whose current time is now
+
+#pragma mark - Deadlines
+- (void)setDeadline:(nullable NSDate *)deadline forKey:(K)key; //!< Sets the deadline for key, replacing any previous deadline. Passing nil removes the deadline. Deadlines that have already passed expire with the next call to -advanceToDate:.
+- (nullable NSDate *)deadlineForKey:(K)key; //!< Returns the (rounded) deadline of key
+- (void)removeKey:(K)key;
+- (void)removeAllKeys;
+
+@property(readonly,nonatomic,nullable) NSDate *nextDeadline; //!< The earliest (rounded) deadline - or nil if there are no deadlines
+
+#pragma mark - Expiration
+- (NSArray<K> *)advanceToDate:(NSDate *)date; //!< Advances the current time of the wheel to date (if later than the current time), removes the keys whose deadlines are on or before it and returns them
+
+@end
+
+NS_ASSUME_NONNULL_END
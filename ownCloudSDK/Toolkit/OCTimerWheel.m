@@ -0,0 +1,348 @@
+//
+//  OCTimerWheel.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCTimerWheel.h"
+
+#define OCTimerWheelLevels	4
+#define OCTimerWheelSlotBits	6
+#define OCTimerWheelSlots	(1 << OCTimerWheelSlotBits)
+#define OCTimerWheelSlotMask	(OCTimerWheelSlots - 1)
+#define OCTimerWheelOverflow	NSIntegerMax
+
+typedef uint64_t OCTimerWheelTick;
+
+@interface OCTimerWheel ()
+{
+	OCTimerWheelTick _currentTick; //!< Ticks up to and including _currentTick have been expired
+
+	NSMutableArray<NSMutableSet *> *_slots; //!< Slots of all levels, at index (level * OCTimerWheelSlots) + slot
+	NSUInteger _countByLevel[OCTimerWheelLevels];
+
+	NSMutableSet *_overflowKeys;
+	NSMutableSet *_dueKeys; //!< Keys whose deadline had already passed when it was set
+
+	NSMutableDictionary<id, NSNumber *> *_ticksByKey;
+	NSMutableDictionary<id, NSNumber *> *_slotIndexesByKey;
+}
+@end
+
+@implementation OCTimerWheel
+
+- (instancetype)init
+{
+	return ([self initWithResolution:1.0]);
+}
+
+- (instancetype)initWithResolution:(NSTimeInterval)resolution
+{
+	return ([self initWithResolution:resolution startDate:[NSDate new]]);
+}
+
+- (instancetype)initWithResolution:(NSTimeInterval)resolution startDate:(NSDate *)startDate
+{
+	if ((self = [super init]) != nil)
+	{
+		_resolution = (resolution > 0) ? resolution : 1.0;
+		_currentTick = [self _tickForDate:startDate roundUp:NO];
+
+		_slots = [NSMutableArray new];
+
+		for (NSUInteger idx=0; idx < (OCTimerWheelLevels * OCTimerWheelSlots); idx++)
+		{
+			[_slots addObject:[NSMutableSet new]];
+		}
+
+		_overflowKeys = [NSMutableSet new];
+		_dueKeys = [NSMutableSet new];
+
+		_ticksByKey = [NSMutableDictionary new];
+		_slotIndexesByKey = [NSMutableDictionary new];
+	}
+
+	return (self);
+}
+
+#pragma mark - Ticks
+- (OCTimerWheelTick)_tickForDate:(NSDate *)date roundUp:(BOOL)roundUp
+{
+	NSTimeInterval ticks = date.timeIntervalSinceReferenceDate / _resolution;
+
+	ticks = roundUp ? ceil(ticks) : floor(ticks);
+
+	return ((ticks > 0) ? (OCTimerWheelTick)ticks : 0);
+}
+
+- (NSDate *)_dateForTick:(OCTimerWheelTick)tick
+{
+	return ([NSDate dateWithTimeIntervalSinceReferenceDate:((NSTimeInterval)tick * _resolution)]);
+}
+
+#pragma mark - Slots
+- (void)_insertKey:(id)key tick:(OCTimerWheelTick)tick cascading:(BOOL)cascading
+{
+	_ticksByKey[key] = @(tick);
+
+	// Deadlines at the current tick have passed - unless they are moved down at the start of the current tick, which expires right after
+	if ((tick < _currentTick) || ((tick == _currentTick) && !cascading))
+	{
+		[_dueKeys addObject:key];
+		return;
+	}
+
+	OCTimerWheelTick delta = tick - _currentTick;
+
+	for (NSUInteger level=0; level < OCTimerWheelLevels; level++)
+	{
+		if (delta < (1ull << (OCTimerWheelSlotBits * (level + 1))))
+		{
+			NSUInteger slotIndex = (level * OCTimerWheelSlots) + ((tick >> (OCTimerWheelSlotBits * level)) & OCTimerWheelSlotMask);
+
+			[_slots[slotIndex] addObject:key];
+			_slotIndexesByKey[key] = @(slotIndex);
+			_countByLevel[level]++;
+
+			return;
+		}
+	}
+
+	[_overflowKeys addObject:key];
+	_slotIndexesByKey[key] = @(OCTimerWheelOverflow);
+}
+
+- (void)_removeKey:(id)key
+{
+	NSNumber *slotIndexNumber;
+
+	if ((slotIndexNumber = _slotIndexesByKey[key]) != nil)
+	{
+		NSInteger slotIndex = slotIndexNumber.integerValue;
+
+		if (slotIndex == OCTimerWheelOverflow)
+		{
+			[_overflowKeys removeObject:key];
+		}
+		else
+		{
+			[_slots[slotIndex] removeObject:key];
+			_countByLevel[slotIndex / OCTimerWheelSlots]--;
+		}
+
+		[_slotIndexesByKey removeObjectForKey:key];
+	}
+	else
+	{
+		[_dueKeys removeObject:key];
+	}
+
+	[_ticksByKey removeObjectForKey:key];
+}
+
+- (void)_cascadeSlotAtIndex:(NSUInteger)slotIndex
+{
+	NSMutableSet *slot = _slots[slotIndex];
+
+	if (slot.count > 0)
+	{
+		NSArray *keys = slot.allObjects;
+
+		[slot removeAllObjects];
+		_countByLevel[slotIndex / OCTimerWheelSlots] -= keys.count;
+
+		for (id key in keys)
+		{
+			[self _insertKey:key tick:_ticksByKey[key].unsignedLongLongValue cascading:YES];
+		}
+	}
+}
+
+#pragma mark - Deadlines
+- (NSUInteger)count
+{
+	return (_ticksByKey.count);
+}
+
+- (void)setDeadline:(NSDate *)deadline forKey:(id)key
+{
+	[self _removeKey:key];
+
+	if (deadline != nil)
+	{
+		[self _insertKey:key tick:[self _tickForDate:deadline roundUp:YES] cascading:NO];
+	}
+}
+
+- (NSDate *)deadlineForKey:(id)key
+{
+	NSNumber *tick;
+
+	if ((tick = _ticksByKey[key]) != nil)
+	{
+		return ([self _dateForTick:tick.unsignedLongLongValue]);
+	}
+
+	return (nil);
+}
+
+- (void)removeKey:(id)key
+{
+	[self _removeKey:key];
+}
+
+- (void)removeAllKeys
+{
+	for (NSMutableSet *slot in _slots)
+	{
+		[slot removeAllObjects];
+	}
+
+	memset(_countByLevel, 0, sizeof(_countByLevel));
+
+	[_overflowKeys removeAllObjects];
+	[_dueKeys removeAllObjects];
+
+	[_ticksByKey removeAllObjects];
+	[_slotIndexesByKey removeAllObjects];
+}
+
+- (NSDate *)nextDeadline
+{
+	OCTimerWheelTick nextTick = UINT64_MAX;
+
+	if (_dueKeys.count > 0)
+	{
+		return ([self _dateForTick:_currentTick]);
+	}
+
+	for (NSUInteger level=0; level < OCTimerWheelLevels; level++)
+	{
+		if (_countByLevel[level] > 0)
+		{
+			// The first non-empty slot following the current position holds the earliest deadlines of the level
+			OCTimerWheelTick currentPeriod = _currentTick >> (OCTimerWheelSlotBits * level);
+
+			for (OCTimerWheelTick period = currentPeriod + 1; period <= (currentPeriod + OCTimerWheelSlots); period++)
+			{
+				NSMutableSet *slot = _slots[(level * OCTimerWheelSlots) + (period & OCTimerWheelSlotMask)];
+
+				if (slot.count > 0)
+				{
+					for (id key in slot)
+					{
+						nextTick = MIN(nextTick, _ticksByKey[key].unsignedLongLongValue);
+					}
+
+					break;
+				}
+			}
+		}
+	}
+
+	for (id key in _overflowKeys)
+	{
+		nextTick = MIN(nextTick, _ticksByKey[key].unsignedLongLongValue);
+	}
+
+	return ((nextTick != UINT64_MAX) ? [self _dateForTick:nextTick] : nil);
+}
+
+#pragma mark - Expiration
+- (NSArray *)advanceToDate:(NSDate *)date
+{
+	OCTimerWheelTick targetTick = [self _tickForDate:date roundUp:NO];
+	NSMutableArray *expiredKeys = [NSMutableArray new];
+
+	// Deadlines that had already passed when they were set
+	for (id key in _dueKeys)
+	{
+		[expiredKeys addObject:key];
+		[_ticksByKey removeObjectForKey:key];
+	}
+
+	[_dueKeys removeAllObjects];
+
+	while (_currentTick < targetTick)
+	{
+		OCTimerWheelTick tick;
+		NSUInteger lowestLevel = OCTimerWheelLevels;
+
+		if (_ticksByKey.count == 0)
+		{
+			// Nothing left to expire
+			_currentTick = targetTick;
+			break;
+		}
+
+		// Skip ahead to the next tick at which anything can happen: the next tick if level 0 has entries - otherwise the start of the next period of the lowest level with entries
+		for (NSUInteger level=0; level < OCTimerWheelLevels; level++)
+		{
+			if (_countByLevel[level] > 0)
+			{
+				lowestLevel = level;
+				break;
+			}
+		}
+
+		tick = (((_currentTick >> (OCTimerWheelSlotBits * lowestLevel)) + 1) << (OCTimerWheelSlotBits * lowestLevel));
+		tick = MIN(tick, targetTick);
+
+		_currentTick = tick;
+
+		// Move entries of the period starting now down - starting with the highest level, so entries moved to lower levels are moved further down as needed
+		if ((tick & ((1ull << (OCTimerWheelSlotBits * OCTimerWheelLevels)) - 1)) == 0)
+		{
+			NSArray *overflowKeys = _overflowKeys.allObjects;
+
+			[_overflowKeys removeAllObjects];
+
+			for (id key in overflowKeys)
+			{
+				[_slotIndexesByKey removeObjectForKey:key];
+				[self _insertKey:key tick:_ticksByKey[key].unsignedLongLongValue cascading:YES];
+			}
+		}
+
+		for (NSUInteger level=OCTimerWheelLevels-1; level > 0; level--)
+		{
+			if ((tick & ((1ull << (OCTimerWheelSlotBits * level)) - 1)) == 0)
+			{
+				[self _cascadeSlotAtIndex:(level * OCTimerWheelSlots) + ((tick >> (OCTimerWheelSlotBits * level)) & OCTimerWheelSlotMask)];
+			}
+		}
+
+		// Expire entries of the current tick
+		NSMutableSet *slot = _slots[tick & OCTimerWheelSlotMask];
+
+		if (slot.count > 0)
+		{
+			for (id key in slot)
+			{
+				[expiredKeys addObject:key];
+				[_ticksByKey removeObjectForKey:key];
+				[_slotIndexesByKey removeObjectForKey:key];
+			}
+
+			_countByLevel[0] -= slot.count;
+			[slot removeAllObjects];
+		}
+	}
+
+	return (expiredKeys);
+}
+
+@end
@@ -23,6 +23,10 @@
 #pragma mark - Schemas
 - (void)addSchemas;
 
+#pragma mark - Indexes
+@property(class,readonly,nonatomic) NSArray<NSString *> *metaDataSecondaryIndexNames; //!< Names of the secondary indexes of the metaData table
+@property(class,readonly,nonatomic) NSArray<NSString *> *metaDataSecondaryIndexCreationQueries; //!< Queries (re)creating the secondary indexes of the metaData table, if they don't exist
+
 @end
 
 extern OCDatabaseTableName OCDatabaseTableNameMetaData;
@@ -31,5 +35,6 @@ extern OCDatabaseTableName OCDatabaseTableNameSyncLanes;
 extern OCDatabaseTableName OCDatabaseTableNameUpdateJobs;
 extern OCDatabaseTableName OCDatabaseTableNameThumbnails;
 extern OCDatabaseTableName OCDatabaseTableNameCounters;
+extern OCDatabaseTableName OCDatabaseTableNameCollations;
 extern OCDatabaseTableName OCDatabaseTableNameEvents;
 extern OCDatabaseTableName OCDatabaseTableNameItemPolicies;
@@ -38,6 +38,7 @@
 - (void)addSchemas
 {
 	[self addOrUpdateCountersSchema];
+	[self addOrUpdateCollationsSchema];
 
 	[self addOrUpdateMetaDataSchema];
 	[self addOrUpdateThumbnailsSchema];
@@ -51,6 +52,34 @@
 	[self addOrUpdateUpdateScanPaths];
 }
 
+#pragma mark - Indexes
++ (NSArray<NSString *> *)metaDataSecondaryIndexNames
+{
+	return (@[
+		@"idx_metaData_path",
+		@"idx_metaData_parentPath",
+		@"idx_metaData_synchAnchor",
+		@"idx_metaData_localID",
+		@"idx_metaData_fileID",
+		@"idx_metaData_removed",
+		@"idx_metaData_parentPath_removed_name"
+	]);
+}
+
++ (NSArray<NSString *> *)metaDataSecondaryIndexCreationQueries
+{
+	// Must match the indexes created by the latest metaData schema version
+	return (@[
+		@"CREATE INDEX IF NOT EXISTS idx_metaData_path ON metaData (path)",
+		@"CREATE INDEX IF NOT EXISTS idx_metaData_parentPath ON metaData (parentPath)",
+		@"CREATE INDEX IF NOT EXISTS idx_metaData_synchAnchor ON metaData (syncAnchor)",
+		@"CREATE INDEX IF NOT EXISTS idx_metaData_localID ON metaData (localID)",
+		@"CREATE INDEX IF NOT EXISTS idx_metaData_fileID ON metaData (fileID)",
+		@"CREATE INDEX IF NOT EXISTS idx_metaData_removed ON metaData (removed)",
+		@"CREATE INDEX IF NOT EXISTS idx_metaData_parentPath_removed_name ON metaData (parentPath, removed, name)"
+	]);
+}
+
 - (void)addOrUpdateMetaDataSchema
 {
 	/*** MetaData ***/
@@ -864,10 +893,10 @@
 			@"CREATE INDEX idx_metaData_fileID ON metaData (fileID)",
 			@"CREATE INDEX idx_metaData_removed ON metaData (removed)",
 		]
-		openStatements:@[
+		openStatements:[@[
 			// Create trigger to delete thumbnails alongside metadata entries
 			@"CREATE TEMPORARY TRIGGER temp_delete_associated_thumbnails AFTER DELETE ON metaData BEGIN DELETE FROM thumb.thumbnails WHERE fileID = OLD.fileID; END" // relatedTo:OCDatabaseTableNameThumbnails
-		]
+		] arrayByAddingObjectsFromArray:OCDatabase.metaDataSecondaryIndexCreationQueries] // Restore indexes in case a bulk load was interrupted before it could recreate them
 		upgradeMigrator:^(OCSQLiteDB *db, OCSQLiteTableSchema *schema, void (^completionHandler)(NSError *error)) {
 			// Migrate to version 14
 			[db executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError *(OCSQLiteDB *db, OCSQLiteTransaction *transaction) {
@@ -896,6 +925,72 @@
 			}]];
 		}]
 	];
+
+	// Version 15
+	/*
+		Add ordered index over (parentPath, removed, name)
+	*/
+	[self.sqlDB addTableSchema:[OCSQLiteTableSchema
+		schemaWithTableName:OCDatabaseTableNameMetaData
+		version:15
+		creationQueries:@[
+			/*
+				mdID : INTEGER	  		- unique ID used to uniquely identify and efficiently update a row
+				type : INTEGER    		- OCItemType value to indicate if this is a file or a collection/folder
+				syncAnchor: INTEGER		- sync anchor, a number that increases its value with every change to an entry. For files, higher sync anchor values indicate the file changed (incl. creation, content or meta data changes). For collections/folders, higher sync anchor values indicate the list of items in the collection/folder changed in a way not covered by file entries (i.e. rename, deletion, but not creation of files).
+				removed : INTEGER		- value indicating if this file or folder has been removed: 1 if it was, 0 if not (default). Removed entries are kept around until their delta to the latest syncAnchor value exceeds -[OCDatabase removedItemRetentionLength].
+				mdTimestamp: INTEGER		- NSDate.timeIntervalSinceReferenceDate value of creation or last update of this record
+				locallyModified: INTEGER	- value indicating if this is a file that's been created or modified locally
+				localRelativePath: TEXT		- path of the local copy of the item, relative to the rootURL of the vault that stores it
+				path : TEXT	  		- full path of the item (e.g. "/example/file.txt")
+				parentPath : TEXT 		- parent path of the item. (e.g. "/example" for an item at "/example/file.txt")
+				name : TEXT 	  		- name of the item (e.g. "file.txt" for an item at "/example/file.txt")
+				mimeType : TEXT			- MIME type of the item
+				size : INTEGER			- size of the item
+				favorite : INTEGER		- BOOL indicating if the item is favorite (OCItem.isFavorite)
+				cloudStatus : INTEGER 		- Cloud status of the item (OCItem.cloudStatus)
+				downloadTrigger : TEXT		- What triggered the download of the item (OCItemDownloadTriggerID)
+				hasLocalAttributes : INTEGER 	- BOOL indicating an item with local attributes (OCItem.hasLocalAttributes)
+				lastUsedDate : REAL 		- NSDate.timeIntervalSince1970 value of OCItem.lastUsed
+				lastModifiedDate : REAL		- NSDate.timeIntervalSince1970 value of OCItem.lastModified
+				syncActivity : INTEGER 		- OCSyncActivity mask indicating which sync activity the item has (0 for none) (OCItem.syncActivity)
+				ownerUserName : TEXT		- User name of the owner of this item (OCItem.user.userName)
+				fileID : TEXT			- OCFileID identifying the item
+				localID : TEXT			- OCLocalID identifying the item
+				itemData : BLOB	  		- data of the serialized OCItem
+			*/
+			@"CREATE TABLE metaData (mdID INTEGER PRIMARY KEY AUTOINCREMENT, type INTEGER NOT NULL, syncAnchor INTEGER NOT NULL, removed INTEGER NOT NULL, mdTimestamp INTEGER NOT NULL, locallyModified INTEGER NOT NULL, localRelativePath TEXT NULL, path TEXT NOT NULL, parentPath TEXT NOT NULL, name TEXT NOT NULL COLLATE OCLOCALIZED, mimeType TEXT NULL, size INTEGER NOT NULL, favorite INTEGER NOT NULL, cloudStatus INTEGER NOT NULL, downloadTrigger TEXT NULL, hasLocalAttributes INTEGER NOT NULL, lastUsedDate REAL NULL, lastModifiedDate REAL NULL, syncActivity INTEGER NULL, ownerUserName TEXT, fileID TEXT, localID TEXT, itemData BLOB NOT NULL)",
+
+			// Create indexes over path and parentPath
+			@"CREATE INDEX idx_metaData_path ON metaData (path)",
+			@"CREATE INDEX idx_metaData_parentPath ON metaData (parentPath)",
+			@"CREATE INDEX idx_metaData_synchAnchor ON metaData (syncAnchor)",
+			@"CREATE INDEX idx_metaData_localID ON metaData (localID)",
+			@"CREATE INDEX idx_metaData_fileID ON metaData (fileID)",
+			@"CREATE INDEX idx_metaData_removed ON metaData (removed)",
+
+			// Create ordered index over folder contents, used to retrieve windows of a folder's items sorted by name
+			@"CREATE INDEX idx_metaData_parentPath_removed_name ON metaData (parentPath, removed, name)",
+		]
+		openStatements:[@[
+			// Create trigger to delete thumbnails alongside metadata entries
+			@"CREATE TEMPORARY TRIGGER temp_delete_associated_thumbnails AFTER DELETE ON metaData BEGIN DELETE FROM thumb.thumbnails WHERE fileID = OLD.fileID; END" // relatedTo:OCDatabaseTableNameThumbnails
+		] arrayByAddingObjectsFromArray:OCDatabase.metaDataSecondaryIndexCreationQueries] // Restore indexes in case a bulk load was interrupted before it could recreate them
+		upgradeMigrator:^(OCSQLiteDB *db, OCSQLiteTableSchema *schema, void (^completionHandler)(NSError *error)) {
+			// Migrate to version 15
+			[db executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError *(OCSQLiteDB *db, OCSQLiteTransaction *transaction) {
+				INSTALL_TRANSACTION_ERROR_COLLECTION_RESULT_HANDLER
+
+				// Create ordered index
+				[db executeQuery:[OCSQLiteQuery query:@"CREATE INDEX IF NOT EXISTS idx_metaData_parentPath_removed_name ON metaData (parentPath, removed, name)" resultHandler:resultHandler]];
+				if (transactionError != nil) { return(transactionError); }
+
+				return (transactionError);
+			} type:OCSQLiteTransactionTypeDeferred completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+				completionHandler(error);
+			}]];
+		}]
+	];
 }
 
 - (void)addOrUpdateSyncLanesSchema
@@ -1410,6 +1505,26 @@
 	];
 }
 
+- (void)addOrUpdateCollationsSchema
+{
+	/*** Collations ***/
+
+	// Version 1
+	[self.sqlDB addTableSchema:[OCSQLiteTableSchema
+		schemaWithTableName:OCDatabaseTableNameCollations
+		version:1
+		creationQueries:@[
+			/*
+				name : TEXT		- OCSQLiteCollationName of the collation
+				localeIdentifier : TEXT	- identifier of the locale the indexes using the collation were last built with
+			*/
+			@"CREATE TABLE collations (name TEXT PRIMARY KEY, localeIdentifier TEXT NOT NULL)" // relatedTo:OCDatabaseTableNameCollations
+		]
+		openStatements:nil
+		upgradeMigrator:nil]
+	];
+}
+
 @end
 
 OCDatabaseTableName OCDatabaseTableNameMetaData = @"metaData";
@@ -1419,4 +1534,5 @@ OCDatabaseTableName OCDatabaseTableNameUpdateJobs = @"updateJobs";
 OCDatabaseTableName OCDatabaseTableNameThumbnails = @"thumb.thumbnails"; // Places that need to be changed as well if this is changed are annotated with relatedTo:OCDatabaseTableNameThumbnails
 OCDatabaseTableName OCDatabaseTableNameEvents = @"events";
 OCDatabaseTableName OCDatabaseTableNameCounters = @"counters";
+OCDatabaseTableName OCDatabaseTableNameCollations = @"collations";
 OCDatabaseTableName OCDatabaseTableNameItemPolicies = @"itemPolicies";
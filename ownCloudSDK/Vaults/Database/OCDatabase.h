@@ -42,6 +42,7 @@
 typedef void(^OCDatabaseCompletionHandler)(OCDatabase *db, NSError *error);
 typedef void(^OCDatabaseRetrieveCompletionHandler)(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray <OCItem *> *items);
 typedef void(^OCDatabaseRetrieveItemCompletionHandler)(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, OCItem *item);
+typedef void(^OCDatabaseRetrieveCacheItemCountCompletionHandler)(OCDatabase *db, NSError *error, NSNumber *count);
 typedef void(^OCDatabaseRetrieveThumbnailCompletionHandler)(OCDatabase *db, NSError *error, CGSize maximumSizeInPixels, NSString *mimeType, NSData *thumbnailData);
 typedef void(^OCDatabaseRetrieveSyncRecordCompletionHandler)(OCDatabase *db, NSError *error, OCSyncRecord *syncRecord);
 typedef void(^OCDatabaseRetrieveSyncRecordsCompletionHandler)(OCDatabase *db, NSError *error, NSArray <OCSyncRecord *> *syncRecords);
@@ -107,6 +108,10 @@ typedef NSString* OCDatabaseCounterIdentifier;
 - (void)removeCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler;
 - (void)purgeCacheItemsWithDatabaseIDs:(NSArray <OCDatabaseID> *)databaseIDs completionHandler:(OCDatabaseCompletionHandler)completionHandler;
 
+- (void)beginBulkLoadWithCompletionHandler:(OCDatabaseCompletionHandler)completionHandler; //!< Prepares the database for adding a large number of items (f.ex. during prepopulation): drops the secondary indexes of the metaData table and turns off synchronous writes until -endBulkLoadWithCompletionHandler: is called.
+- (void)bulkLoadCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler; //!< Adds items like -addCacheItems:syncAnchor:completionHandler:, but binds the values of all items directly to a single, reused prepared statement in one transaction. Use between -beginBulkLoadWithCompletionHandler: and -endBulkLoadWithCompletionHandler:.
+- (void)endBulkLoadWithCompletionHandler:(OCDatabaseCompletionHandler)completionHandler; //!< Recreates the secondary indexes of the metaData table, runs ANALYZE and restores synchronous writes.
+
 - (void)retrieveCacheItemForLocalID:(OCLocalID)localID completionHandler:(OCDatabaseRetrieveItemCompletionHandler)completionHandler;
 
 - (void)retrieveCacheItemForFileID:(OCFileID)fileID completionHandler:(OCDatabaseRetrieveItemCompletionHandler)completionHandler;
@@ -118,6 +123,10 @@ typedef NSString* OCDatabaseCounterIdentifier;
 - (NSArray <OCItem *> *)retrieveCacheItemsSyncAtPath:(OCPath)path itemOnly:(BOOL)itemOnly error:(NSError * __autoreleasing *)outError syncAnchor:(OCSyncAnchor __autoreleasing *)outSyncAnchor;
 
 - (void)retrieveCacheItemsRecursivelyBelowPath:(OCPath)path includingPathItself:(BOOL)includingPathItself includingRemoved:(BOOL)includingRemoved completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler;
+- (void)numberOfCacheItemsBelowPath:(OCPath)path upToLimit:(NSUInteger)limit completionHandler:(OCDatabaseRetrieveCacheItemCountCompletionHandler)completionHandler; //!< Counts the (not removed) cache items below path, stopping at limit - so the cost stays bounded for large subtrees.
+
+- (void)numberOfCacheItemsInFolder:(OCPath)folderPath completionHandler:(OCDatabaseRetrieveCacheItemCountCompletionHandler)completionHandler; //!< Counts the (not removed) items directly inside the folder at folderPath, using the ordered (parentPath, removed, name) index.
+- (void)retrieveCacheItemsInFolder:(OCPath)folderPath range:(NSRange)range completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler; //!< Retrieves the (not removed) items directly inside the folder at folderPath, sorted by name (OCLOCALIZED collation), limited to the rows in range. Only the rows in range are materialized - skipped rows are stepped over in the index.
 
 - (void)retrieveCacheItemsUpdatedSinceSyncAnchor:(OCSyncAnchor)synchAnchor foldersOnly:(BOOL)foldersOnly completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler;
 
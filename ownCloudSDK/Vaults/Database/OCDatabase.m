@@ -37,6 +37,9 @@
 #import "OCCoreManager.h"
 #import "NSArray+OCSegmentedProcessing.h"
 #import "OCSQLiteDB+Internal.h"
+#import "OCSQLiteStatement.h"
+#import "OCStringInternPool.h"
+#import "OCSQLiteCollationLocalized.h"
 
 #import <objc/runtime.h>
 
@@ -50,6 +53,10 @@
 	OCAsyncSequentialQueue *_openQueue;
 	NSInteger _openCount;
 	OCCoreMemoryConfiguration _memoryConfiguration;
+
+	OCSQLiteStatement *_bulkLoadStatement;
+
+	id _localeChangeObserver;
 }
 
 @end
@@ -99,11 +106,30 @@
 		self.sqlDB = [[OCSQLiteDB alloc] initWithURL:databaseURL];
 		self.sqlDB.journalMode = OCSQLiteJournalModeWAL;
 		[self addSchemas];
+
+		__weak OCDatabase *weakSelf = self;
+
+		_localeChangeObserver = [NSNotificationCenter.defaultCenter addObserverForName:NSCurrentLocaleDidChangeNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull notification) {
+			OCDatabase *strongSelf;
+
+			if (((strongSelf = weakSelf) != nil) && strongSelf.isOpened)
+			{
+				[strongSelf _rebuildLocalizedCollationIndexesIfNeeded];
+			}
+		}];
 	}
 
 	return (self);
 }
 
+- (void)dealloc
+{
+	if (_localeChangeObserver != nil)
+	{
+		[NSNotificationCenter.defaultCenter removeObserver:_localeChangeObserver];
+	}
+}
+
 #pragma mark - Open / Close
 - (void)openWithCompletionHandler:(OCDatabaseCompletionHandler)completionHandler
 {
@@ -139,6 +165,9 @@
 							{
 								[self.sqlDB executeQueryString:@"PRAGMA journal_mode"];
 
+								// Queued ahead of all queries issued after opening
+								[self _rebuildLocalizedCollationIndexesIfNeeded];
+
 								if (completionHandler!=nil)
 								{
 									completionHandler(self, error);
@@ -223,6 +252,63 @@
 	return (_openCount > 0);
 }
 
+#pragma mark - Collation locale
+- (void)_rebuildLocalizedCollationIndexesIfNeeded
+{
+	/*
+		The OCLOCALIZED collation compares by the rules of the current locale. Indexes covering columns using it (f.ex.
+		idx_metaData_parentPath_removed_name) are therefore ordered by the locale that was current when their rows were
+		inserted. After a locale change, that order no longer matches the collation: range queries can skip or repeat
+		rows and SQLite considers the index corrupt. The locale the indexes were built with is therefore recorded in the
+		collations table - and the indexes rebuilt whenever it differs from the current locale.
+	*/
+	NSString *localeIdentifier = NSLocale.currentLocale.localeIdentifier;
+
+	[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError *(OCSQLiteDB *db, OCSQLiteTransaction *transaction) {
+		__block NSError *transactionError = nil;
+		__block NSString *indexedLocaleIdentifier = nil;
+
+		[db executeQuery:[OCSQLiteQuery query:@"SELECT localeIdentifier FROM collations WHERE name = ?" withParameters:@[ OCSQLiteCollationNameLocalized ] resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) { // relatedTo:OCDatabaseTableNameCollations
+			NSError *iterationError = error;
+
+			if (error == nil)
+			{
+				[resultSet iterateUsing:^(OCSQLiteResultSet *resultSet, NSUInteger line, NSDictionary<NSString *,id> *rowDictionary, BOOL *stop) {
+					indexedLocaleIdentifier = rowDictionary[@"localeIdentifier"];
+				} error:&iterationError];
+			}
+
+			if (iterationError != nil) { transactionError = iterationError; }
+		}]];
+
+		if ((transactionError != nil) || [indexedLocaleIdentifier isEqual:localeIdentifier])
+		{
+			return (transactionError);
+		}
+
+		// Rebuild the indexes with the current locale (also if no locale was recorded yet, as the indexes may predate recording it)
+		OCLogDebug(@"Locale changed from %@ to %@: rebuilding indexes using collation %@", indexedLocaleIdentifier, localeIdentifier, OCSQLiteCollationNameLocalized);
+
+		[db executeQuery:[OCSQLiteQuery query:[@"REINDEX " stringByAppendingString:OCSQLiteCollationNameLocalized] resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+			if (error != nil) { transactionError = error; }
+		}]];
+
+		if (transactionError == nil)
+		{
+			[db executeQuery:[OCSQLiteQuery query:@"INSERT OR REPLACE INTO collations (name, localeIdentifier) VALUES (?, ?)" withParameters:@[ OCSQLiteCollationNameLocalized, localeIdentifier ] resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) { // relatedTo:OCDatabaseTableNameCollations
+				if (error != nil) { transactionError = error; }
+			}]];
+		}
+
+		return (transactionError);
+	} type:OCSQLiteTransactionTypeExclusive completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+		if (error != nil)
+		{
+			OCLogError(@"Error rebuilding indexes for locale %@: %@", localeIdentifier, error);
+		}
+	}]];
+}
+
 #pragma mark - Transactions
 - (void)performBatchUpdates:(NSError *(^)(OCDatabase *database))updates completionHandler:(OCDatabaseCompletionHandler)completionHandler
 {
@@ -331,6 +417,171 @@
 	} segmentSize:((_memoryConfiguration == OCCoreMemoryConfigurationMinimum) ? 20 : 200)];
 }
 
+#pragma mark - Bulk load
+- (void)beginBulkLoadWithCompletionHandler:(OCDatabaseCompletionHandler)completionHandler
+{
+	// Durability of individual transactions is not needed while loading: an interrupted load is started over anyway
+	[self.sqlDB executeQuery:[OCSQLiteQuery query:@"PRAGMA synchronous=OFF" resultHandler:nil]];
+
+	// Drop secondary indexes, so they don't need to be updated for every single inserted row, but can be built in one go after the load
+	[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError *(OCSQLiteDB *db, OCSQLiteTransaction *transaction) {
+		__block NSError *transactionError = nil;
+
+		for (NSString *indexName in OCDatabase.metaDataSecondaryIndexNames)
+		{
+			[db executeQuery:[OCSQLiteQuery query:[@"DROP INDEX IF EXISTS " stringByAppendingString:indexName] resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+				if (error != nil)
+				{
+					transactionError = error;
+				}
+			}]];
+
+			if (transactionError != nil) { break; }
+		}
+
+		return (transactionError);
+	} type:OCSQLiteTransactionTypeExclusive completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+		completionHandler(self, error);
+	}]];
+}
+
+static inline void OCDatabaseBulkLoadBindText(sqlite3_stmt *sqlStatement, int paramIdx, NSString *text)
+{
+	if (text != nil)
+	{
+		// SQLITE_TRANSIENT, so SQLite copies the text: callers pass temporaries (f.ex. path.parentPath), whose UTF8String buffers can be released before the row is stepped
+		sqlite3_bind_text(sqlStatement, paramIdx, text.UTF8String, -1, SQLITE_TRANSIENT);
+	}
+	else
+	{
+		sqlite3_bind_null(sqlStatement, paramIdx);
+	}
+}
+
+static inline void OCDatabaseBulkLoadBindDate(sqlite3_stmt *sqlStatement, int paramIdx, NSDate *date)
+{
+	if (date != nil)
+	{
+		sqlite3_bind_double(sqlStatement, paramIdx, date.timeIntervalSince1970);
+	}
+	else
+	{
+		sqlite3_bind_null(sqlStatement, paramIdx);
+	}
+}
+
+- (void)bulkLoadCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler
+{
+	OCDatabaseTimestamp mdTimestamp = [self _timestampForSyncAnchor:syncAnchor];
+
+	if (_itemFilter != nil)
+	{
+		items = _itemFilter(items);
+	}
+
+	[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError *(OCSQLiteDB *db, OCSQLiteTransaction *transaction) {
+		NSError *error = nil;
+		sqlite3_stmt *sqlStatement;
+		sqlite3_int64 syncAnchorValue = syncAnchor.longLongValue, mdTimestampValue = mdTimestamp.longLongValue;
+
+		if (self->_bulkLoadStatement == nil)
+		{
+			// Prepare once, reuse for all rows of the bulk load
+			if ((self->_bulkLoadStatement = [OCSQLiteStatement statementFromQuery:@"INSERT INTO metaData (type, syncAnchor, removed, mdTimestamp, locallyModified, localRelativePath, downloadTrigger, path, parentPath, name, mimeType, size, favorite, cloudStatus, hasLocalAttributes, syncActivity, lastUsedDate, lastModifiedDate, fileID, localID, ownerUserName, itemData) VALUES (?, ?, 0, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)" database:db error:&error]) == nil)
+			{
+				return (error);
+			}
+		}
+
+		sqlStatement = self->_bulkLoadStatement.sqlStatement;
+
+		for (OCItem *item in items)
+		{
+			@autoreleasepool {
+				OCPath path = item.path;
+				NSData *itemData = [item serializedData];
+				int sqErr;
+
+				sqlite3_reset(sqlStatement);
+
+				sqlite3_bind_int64(sqlStatement,  1, (sqlite3_int64)item.type);
+				sqlite3_bind_int64(sqlStatement,  2, syncAnchorValue);
+				sqlite3_bind_int64(sqlStatement,  3, mdTimestampValue);
+				sqlite3_bind_int(sqlStatement,    4, (int)item.locallyModified);
+				OCDatabaseBulkLoadBindText(sqlStatement, 5, item.localRelativePath);
+				OCDatabaseBulkLoadBindText(sqlStatement, 6, item.downloadTriggerIdentifier);
+				OCDatabaseBulkLoadBindText(sqlStatement, 7, path);
+				OCDatabaseBulkLoadBindText(sqlStatement, 8, path.parentPath);
+				OCDatabaseBulkLoadBindText(sqlStatement, 9, path.lastPathComponent);
+				OCDatabaseBulkLoadBindText(sqlStatement, 10, item.mimeType);
+				sqlite3_bind_int64(sqlStatement, 11, (sqlite3_int64)item.size);
+				sqlite3_bind_int(sqlStatement,   12, (int)item.isFavorite.boolValue);
+				sqlite3_bind_int64(sqlStatement, 13, (sqlite3_int64)item.cloudStatus);
+				sqlite3_bind_int(sqlStatement,   14, (int)item.hasLocalAttributes);
+				sqlite3_bind_int64(sqlStatement, 15, (sqlite3_int64)item.syncActivity);
+				OCDatabaseBulkLoadBindDate(sqlStatement, 16, item.lastUsed);
+				OCDatabaseBulkLoadBindDate(sqlStatement, 17, item.lastModified);
+				OCDatabaseBulkLoadBindText(sqlStatement, 18, item.fileID);
+				OCDatabaseBulkLoadBindText(sqlStatement, 19, item.localID);
+				OCDatabaseBulkLoadBindText(sqlStatement, 20, item.ownerUserName);
+				sqlite3_bind_blob64(sqlStatement, 21, ((itemData.length > 0) ? itemData.bytes : ""), itemData.length, SQLITE_STATIC);
+
+				if ((sqErr = sqlite3_step(sqlStatement)) != SQLITE_DONE)
+				{
+					error = OCSQLiteLastDBError(db.sqlite3DB);
+				}
+
+				sqlite3_reset(sqlStatement);
+				sqlite3_clear_bindings(sqlStatement);
+
+				if (error != nil)
+				{
+					break;
+				}
+
+				item.databaseID = @(sqlite3_last_insert_rowid(db.sqlite3DB));
+				item.databaseTimestamp = mdTimestamp;
+			}
+		}
+
+		return (error);
+	} type:OCSQLiteTransactionTypeExclusive completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+		completionHandler(self, error);
+	}]];
+}
+
+- (void)endBulkLoadWithCompletionHandler:(OCDatabaseCompletionHandler)completionHandler
+{
+	[self.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError *(OCSQLiteDB *db, OCSQLiteTransaction *transaction) {
+		__block NSError *transactionError = nil;
+
+		// Release prepared insertion statement
+		[self->_bulkLoadStatement releaseSQLObjects];
+		self->_bulkLoadStatement = nil;
+
+		// Build secondary indexes over the loaded rows in one go
+		for (NSString *indexCreationQuery in OCDatabase.metaDataSecondaryIndexCreationQueries)
+		{
+			[db executeQuery:[OCSQLiteQuery query:indexCreationQuery resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+				if (error != nil)
+				{
+					transactionError = error;
+				}
+			}]];
+
+			if (transactionError != nil) { break; }
+		}
+
+		return (transactionError);
+	} type:OCSQLiteTransactionTypeExclusive completionHandler:^(OCSQLiteDB *db, OCSQLiteTransaction *transaction, NSError *error) {
+		// Update statistics for the query planner once, then restore durability
+		[db executeQuery:[OCSQLiteQuery query:@"ANALYZE" resultHandler:nil]];
+		[db executeQuery:[OCSQLiteQuery query:@"PRAGMA synchronous=FULL" resultHandler:nil]];
+
+		completionHandler(self, error);
+	}]];
+}
+
 - (void)updateCacheItems:(NSArray <OCItem *> *)items syncAnchor:(OCSyncAnchor)syncAnchor completionHandler:(OCDatabaseCompletionHandler)completionHandler
 {
 	OCDatabaseTimestamp mdTimestamp = [self _timestampForSyncAnchor:syncAnchor];
@@ -479,7 +730,7 @@
 
 			if ((downloadTrigger = (NSString *)resultDict[@"downloadTrigger"]) != nil)
 			{
-				item.downloadTriggerIdentifier = downloadTrigger;
+				item.downloadTriggerIdentifier = [OCStringInternPool.sharedPool internString:downloadTrigger];
 			}
 
 			item.databaseID = resultDict[@"mdID"];
@@ -492,7 +743,7 @@
 - (void)_completeRetrievalWithResultSet:(OCSQLiteResultSet *)resultSet completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler
 {
 	NSMutableArray <OCItem *> *items = [NSMutableArray new];
-	NSMutableArray <OCUser *> *cachedUsers = [NSMutableArray new];
+	NSMutableSet <OCUser *> *cachedUsers = [NSMutableSet new];
 	NSError *returnError = nil;
 	__block OCSyncAnchor syncAnchor = nil;
 
@@ -506,11 +757,11 @@
 
 			if (item.owner != nil)
 			{
-				NSUInteger cachedUserIndex;
+				OCUser *cachedUser;
 
-				if ((cachedUserIndex = [cachedUsers indexOfObject:item.owner]) != NSNotFound)
+				if ((cachedUser = [cachedUsers member:item.owner]) != nil)
 				{
-					item.owner = [cachedUsers objectAtIndex:cachedUserIndex];
+					item.owner = cachedUser;
 				}
 				else
 				{
@@ -678,6 +929,63 @@
 	[self _retrieveCacheItemsForSQLQuery:sqlStatement parameters:parameters cancelAction:nil completionHandler:completionHandler];
 }
 
+- (void)numberOfCacheItemsBelowPath:(OCPath)path upToLimit:(NSUInteger)limit completionHandler:(OCDatabaseRetrieveCacheItemCountCompletionHandler)completionHandler
+{
+	if (path.length == 0)
+	{
+		completionHandler(self, OCError(OCErrorInsufficientParameters), nil);
+		return;
+	}
+
+	[self.sqlDB executeQuery:[OCSQLiteQuery query:@"SELECT COUNT(*) AS cnt FROM (SELECT 1 FROM metaData WHERE path LIKE :pathPattern AND path!=:path AND removed=0 LIMIT :limit)" withNamedParameters:@{
+		@"pathPattern" : [[path stringBySQLLikeEscaping] stringByAppendingString:@"%"],
+		@"path" : path,
+		@"limit" : @(limit)
+	} resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+		NSNumber *numberOfItems = nil;
+
+		if (error == nil)
+		{
+			numberOfItems = (NSNumber *)[resultSet nextRowDictionaryWithError:&error][@"cnt"];
+		}
+
+		completionHandler(self, error, numberOfItems);
+	}]];
+}
+
+- (void)numberOfCacheItemsInFolder:(OCPath)folderPath completionHandler:(OCDatabaseRetrieveCacheItemCountCompletionHandler)completionHandler
+{
+	if (folderPath == nil)
+	{
+		completionHandler(self, OCError(OCErrorInsufficientParameters), nil);
+		return;
+	}
+
+	[self.sqlDB executeQuery:[OCSQLiteQuery query:@"SELECT COUNT(*) AS cnt FROM metaData WHERE parentPath=? AND removed=0" withParameters:@[ folderPath ] resultHandler:^(OCSQLiteDB * _Nonnull db, NSError * _Nullable error, OCSQLiteTransaction * _Nullable transaction, OCSQLiteResultSet * _Nullable resultSet) {
+		NSNumber *numberOfItems = nil;
+
+		if (error == nil)
+		{
+			numberOfItems = (NSNumber *)[resultSet nextRowDictionaryWithError:&error][@"cnt"];
+		}
+
+		completionHandler(self, error, numberOfItems);
+	}]];
+}
+
+- (void)retrieveCacheItemsInFolder:(OCPath)folderPath range:(NSRange)range completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler
+{
+	if (folderPath == nil)
+	{
+		completionHandler(self, OCError(OCErrorInsufficientParameters), nil, nil);
+		return;
+	}
+
+	// ORDER BY name uses the OCLOCALIZED collation of the name column, so that rows can be read in order from idx_metaData_parentPath_removed_name
+	// (the index is rebuilt when the locale changes, see -_rebuildLocalizedCollationIndexesIfNeeded)
+	[self _retrieveCacheItemsForSQLQuery:[_selectItemRowsSQLQueryPrefix stringByAppendingString:@" FROM metaData WHERE parentPath=? AND removed=0 ORDER BY name LIMIT ? OFFSET ?"] parameters:@[ folderPath, @(range.length), @(range.location) ] cancelAction:nil completionHandler:completionHandler];
+}
+
 - (void)retrieveCacheItemsAtPath:(OCPath)path itemOnly:(BOOL)itemOnly completionHandler:(OCDatabaseRetrieveCompletionHandler)completionHandler
 {
 	NSString *sqlQueryString = nil;
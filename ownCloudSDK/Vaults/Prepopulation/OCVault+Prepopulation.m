@@ -24,6 +24,8 @@
 #import "OCDatabase.h"
 #import "NSError+OCError.h"
 #import "OCCoreDirectoryUpdateJob.h"
+#import "OCXMLParallelParser.h"
+#import "OCCoreManager.h"
 
 @implementation OCVault (Prepopulation)
 
@@ -50,8 +52,8 @@
 
 - (nullable NSProgress *)prepopulateDatabaseWithRawResponse:(OCDAVRawResponse *)davRawResponse progressHandler:(nullable void(^)(NSUInteger folderCount, NSUInteger fileCount))progressHandler completionHandler:(void (^)(NSError *_Nullable error))completionHandler
 {
-	return ([self _prepopulateDatabaseWithXMLParserProvider:^OCXMLParser *{
-		OCXMLParser *parser = nil;
+	return ([self _prepopulateDatabaseWithXMLParserProvider:^OCXMLParallelParser *{
+		OCXMLParallelParser *parser = nil;
 		NSMutableDictionary<NSString *,OCUser *> *usersByUserID = [NSMutableDictionary new];
 
 		// -- TEST CODE: cut off XML at half
@@ -64,7 +66,7 @@
 		// fileHandle = nil;
 		// -- END TEST CODE
 
-		if ((parser = [[OCXMLParser alloc] initWithURL:davRawResponse.responseDataURL]) != nil)
+		if ((parser = [[OCXMLParallelParser alloc] initWithURL:davRawResponse.responseDataURL]) != nil)
 		{
 			parser.options = [NSMutableDictionary dictionaryWithObjectsAndKeys:
 				davRawResponse.basePath, 	@"basePath",
@@ -78,11 +80,11 @@
 
 - (nullable NSProgress *)prepopulateDatabaseWithInputStream:(NSInputStream *)davInputStream basePath:(NSString *)basePath progressHandler:(nullable void(^)(NSUInteger folderCount, NSUInteger fileCount))progressHandler completionHandler:(void (^)(NSError *_Nullable error))completionHandler
 {
-	return ([self _prepopulateDatabaseWithXMLParserProvider:^OCXMLParser * _Nullable {
-		OCXMLParser *parser = nil;
+	return ([self _prepopulateDatabaseWithXMLParserProvider:^OCXMLParallelParser * _Nullable {
+		OCXMLParallelParser *parser = nil;
 		NSMutableDictionary<NSString *,OCUser *> *usersByUserID = [NSMutableDictionary new];
 
-		if ((parser = [[OCXMLParser alloc] initWithParser:[[NSXMLParser alloc] initWithStream:davInputStream]]) != nil)
+		if ((parser = [[OCXMLParallelParser alloc] initWithStream:davInputStream]) != nil)
 		{
 			parser.options = [NSMutableDictionary dictionaryWithObjectsAndKeys:
 				basePath, 	@"basePath",
@@ -94,7 +96,7 @@
 	} progressHandler:progressHandler completionHandler:completionHandler]);
 }
 
-- (nullable NSProgress *)_prepopulateDatabaseWithXMLParserProvider:(OCXMLParser * __nullable(^)(void))xmlParserProvider progressHandler:(nullable void(^)(NSUInteger folderCount, NSUInteger fileCount))progressHandler completionHandler:(void (^)(NSError *_Nullable error))completionHandler
+- (nullable NSProgress *)_prepopulateDatabaseWithXMLParserProvider:(OCXMLParallelParser * __nullable(^)(void))xmlParserProvider progressHandler:(nullable void(^)(NSUInteger folderCount, NSUInteger fileCount))progressHandler completionHandler:(void (^)(NSError *_Nullable error))completionHandler
 {
 	NSProgress *parseProgress = [NSProgress indeterminateProgress];
 	OCDatabase *db = self.database;
@@ -105,11 +107,11 @@
 	};
 
 	[self.database.sqlDB queueBlock:^{
-		OCXMLParser *parser;
+		OCXMLParallelParser *parser;
 		NSMutableArray<OCItem *> *queuedItems = [NSMutableArray new];
 		__block NSUInteger itemCount = 0, folderCount = 0, errorCount = 0;
 		__block NSError *completionError = nil;
-		NSUInteger commitSize = 200;
+		NSUInteger commitSize = (OCCoreManager.sharedCoreManager.memoryConfiguration == OCCoreMemoryConfigurationMinimum) ? 200 : 5000;
 
 		void (^StoreItem)(OCItem *item, BOOL flush) = ^(OCItem *item, BOOL flush) {
 			if (item != nil)
@@ -117,9 +119,9 @@
 				[queuedItems addObject:item];
 			}
 
-			if ((queuedItems.count >= commitSize) || flush)
+			if (((queuedItems.count >= commitSize) || flush) && (queuedItems.count > 0))
 			{
-				[db addCacheItems:queuedItems syncAnchor:@(0) completionHandler:^(OCDatabase *db, NSError *error) {
+				[db bulkLoadCacheItems:queuedItems syncAnchor:@(0) completionHandler:^(OCDatabase *db, NSError *error) {
 					if (error != nil)
 					{
 						completionError = error;
@@ -134,10 +136,20 @@
 
 		if ((parser = xmlParserProvider()) != nil)
 		{
+			// Load items in large transactions with secondary indexes dropped and synchronous writes turned off - and build the indexes once at the end
+			[db beginBulkLoadWithCompletionHandler:^(OCDatabase *db, NSError *error) {
+				if (error != nil)
+				{
+					completionError = error;
+				}
+			}];
+
 			NSMutableDictionary<OCPath, OCItem *> *openItemByPath = [NSMutableDictionary new];
 			NSMutableArray<OCPath> *openPaths = [NSMutableArray new];
 
-			parser.parsedObjectStreamConsumer = ^(OCXMLParser *parser, NSError *error, id parsedObject) {
+			// Shards of the response are parsed on multiple cores and arrive here in document order, so items can be
+			// processed and inserted into the database on this thread while the following shards are being parsed
+			BOOL (^ConsumeParsedObject)(NSError *error, id parsedObject) = ^(NSError *error, id parsedObject) {
 				if (completionError == nil)
 				{
 					if (error != nil)
@@ -154,8 +166,7 @@
 				{
 					errorCount++;
 
-					[parser abort];
-					return;
+					return (NO);
 				}
 
 				if (parsedObject != nil)
@@ -181,9 +192,8 @@
 							OCLogError(@"Unexpectedly missing: parent folder item for %@", item);
 
 							completionError = OCErrorWithInfo(OCErrorInternal, ([NSString stringWithFormat:@"Unexpectedly missing parent item for %@.", item.path]));
-							[parser abort];
 
-							return;
+							return (NO);
 						}
 
 						__block NSMutableArray<OCPath> *closedPaths = nil;
@@ -236,18 +246,44 @@
 
 					StoreItem(item, NO);
 				}
+
+				return (YES);
 			};
 
 			[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
 
-			if ([parser parse])
+			if ([parser parseWithShardConsumer:^BOOL(NSArray *parsedObjects, NSArray<NSError *> *errors) {
+				for (id parsedObject in parsedObjects)
+				{
+					if (!ConsumeParsedObject(nil, parsedObject)) { return (NO); }
+				}
+
+				for (NSError *error in errors)
+				{
+					if (!ConsumeParsedObject(error, nil)) { return (NO); }
+				}
+
+				return (YES);
+			}])
+			{
+				OCLogDebug(@"Success! (%lu shards)", (unsigned long)parser.shardCount);
+			}
+			else if ((completionError == nil) && (parser.error != nil))
 			{
-				OCLogDebug(@"Success!");
+				completionError = parser.error;
 			}
 
 			// Flush the rest of the items to the database
 			StoreItem(nil, YES);
 
+			// Build indexes and restore synchronous writes (also if an error occured, so the database stays usable)
+			[db endBulkLoadWithCompletionHandler:^(OCDatabase *db, NSError *error) {
+				if ((error != nil) && (completionError == nil))
+				{
+					completionError = error;
+				}
+			}];
+
 			// Add open paths as directory update jobs
 			if (openPaths.count == 1)
 			{
@@ -0,0 +1,61 @@
+//
+//  OCXMLParallelParser.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import <Foundation/Foundation.h>
+#import "OCXMLParser.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef BOOL(^OCXMLParallelParserShardConsumer)(NSArray *parsedObjects, NSArray<NSError *> *errors); //!< Return NO to stop parsing
+
+/*
+	Parses large documents consisting of a long list of sibling elements (like the d:response elements of a depth infinity PROPFIND multistatus) on multiple cores:
+	- the document is cut into shards at the start of .shardElementLocalName elements, without parsing it
+	- each shard is wrapped into the document's root start tag (so namespace declarations remain intact) and - except for the last shard, which ends with the document's own - closing tag, then parsed by its own OCXMLParser on a concurrent queue
+	- the parsed objects of each shard are handed to the consumer in document order, on the thread calling -parseWithShardConsumer:
+	The number of shards parsed ahead of the consumer is limited by .maximumConcurrentShards, so memory use stays bounded if the consumer is slower than parsing.
+*/
+
+@interface OCXMLParallelParser : NSObject
+
+@property(strong,nullable) NSMutableDictionary<NSString *, id> *options; //!< Options passed to the OCXMLParser of every shard. Values are shared between shards and need to be safe to use from multiple threads.
+
+@property(strong) NSString *shardElementNamespace; //!< Namespace of the elements the document is cut at (default: DAV:)
+@property(strong) NSString *shardElementLocalName; //!< Local name of the elements the document is cut at (default: response)
+
+@property(assign) NSUInteger shardSize; //!< Minimum size of a shard in bytes (default: 1 MB)
+@property(assign) NSUInteger maximumConcurrentShards; //!< Maximum number of shards being parsed or waiting to be consumed (default: 2 x number of active processors)
+
+@property(readonly,strong,nullable) NSError *error; //!< Error reading the input (if any) - or OCErrorResponseUnknownFormat if the closing tag of the root element is missing
+@property(readonly) NSUInteger shardCount; //!< Number of shards the document was cut into
+
+#pragma mark - Init
+- (instancetype)initWithData:(NSData *)data;
+- (instancetype)initWithURL:(NSURL *)url; //!< Maps the file into memory where possible
+- (instancetype)initWithStream:(NSInputStream *)stream; //!< Cuts shards as data arrives from the stream, so that parsing overlaps with receiving
+
+#pragma mark - Specify classes
+- (void)addObjectCreationClasses:(NSArray <Class> *)classes;
+
+#pragma mark - Parse
+- (BOOL)parseWithShardConsumer:(OCXMLParallelParserShardConsumer)shardConsumer; //!< Parses the document and calls shardConsumer for each shard in document order. Returns NO if reading failed or the consumer stopped parsing.
+
+@end
+
+NS_ASSUME_NONNULL_END
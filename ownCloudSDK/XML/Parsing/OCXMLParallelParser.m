@@ -0,0 +1,597 @@
+//
+//  OCXMLParallelParser.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+
+#import "OCXMLParallelParser.h"
+#import "OCLogger.h"
+#import "NSError+OCError.h"
+
+#define OCXMLParallelParserStreamBufferSize (64 * 1024)
+
+@interface OCXMLParallelParserShard : NSObject
+
+@property(strong,nullable) NSData *data;
+
+@property(assign) BOOL parsed;
+@property(strong,nullable) NSArray *parsedObjects;
+@property(strong,nullable) NSArray<NSError *> *errors;
+
+@end
+
+@implementation OCXMLParallelParserShard
+@end
+
+@interface OCXMLParallelParser ()
+{
+	NSData *_data;
+	NSInputStream *_stream;
+
+	NSMutableArray<Class> *_objectCreationClasses;
+
+	// Document framing
+	NSData *_rootStartTag; //!< Document up to and including the start tag of the root element
+	NSData *_rootEndTag; //!< Closing tag of the root element, appended to all but the last shard
+	NSData *_shardStartPattern; //!< "<" + prefix + ":" + shardElementLocalName (nil if the document can't be cut)
+
+	// Shards (protected by _shardCondition)
+	NSCondition *_shardCondition;
+	NSMutableArray<OCXMLParallelParserShard *> *_shards; //!< Shards not yet consumed, in document order
+	BOOL _producerFinished;
+	BOOL _cancelled;
+
+	dispatch_group_t _parseGroup;
+}
+@end
+
+static inline BOOL OCXMLParallelParserIsSpace(char c)
+{
+	return ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r'));
+}
+
+static NSUInteger OCXMLParallelParserFind(const char *bytes, NSUInteger length, NSUInteger from, const char *needle, NSUInteger needleLength)
+{
+	const char *match;
+
+	if ((from >= length) || ((match = memmem(bytes + from, length - from, needle, needleLength)) == NULL))
+	{
+		return (NSNotFound);
+	}
+
+	return (match - bytes);
+}
+
+@implementation OCXMLParallelParser
+
+@synthesize error = _error;
+@synthesize shardCount = _shardCount;
+
+#pragma mark - Init
+- (instancetype)init
+{
+	if ((self = [super init]) != nil)
+	{
+		_shardElementNamespace = @"DAV:";
+		_shardElementLocalName = @"response";
+
+		_shardSize = 1024 * 1024;
+		_maximumConcurrentShards = NSProcessInfo.processInfo.activeProcessorCount * 2;
+
+		_objectCreationClasses = [NSMutableArray new];
+
+		_shardCondition = [NSCondition new];
+		_shards = [NSMutableArray new];
+	}
+
+	return (self);
+}
+
+- (instancetype)initWithData:(NSData *)data
+{
+	if ((self = [self init]) != nil)
+	{
+		_data = data;
+	}
+
+	return (self);
+}
+
+- (instancetype)initWithURL:(NSURL *)url
+{
+	if ((self = [self init]) != nil)
+	{
+		NSError *error = nil;
+
+		if ((_data = [NSData dataWithContentsOfURL:url options:NSDataReadingMappedIfSafe error:&error]) == nil)
+		{
+			_error = error;
+		}
+	}
+
+	return (self);
+}
+
+- (instancetype)initWithStream:(NSInputStream *)stream
+{
+	if ((self = [self init]) != nil)
+	{
+		_stream = stream;
+	}
+
+	return (self);
+}
+
+#pragma mark - Specify classes
+- (void)addObjectCreationClasses:(NSArray <Class> *)classes
+{
+	if (classes != nil)
+	{
+		[_objectCreationClasses addObjectsFromArray:classes];
+	}
+}
+
+#pragma mark - Framing
+- (NSUInteger)_resolveFramingWithBytes:(const char *)bytes length:(NSUInteger)length final:(BOOL)final
+{
+	// Returns the offset at which the body of the root element starts, 0 if more data is needed and NSNotFound if the document can't be cut into shards
+	NSUInteger offset = 0, incomplete = final ? NSNotFound : 0;
+
+	while ((offset = OCXMLParallelParserFind(bytes, length, offset, "<", 1)) != NSNotFound)
+	{
+		if ((offset + 1) >= length) { return (incomplete); }
+
+		if (bytes[offset+1] == '?')
+		{
+			// Processing instruction / XML declaration
+			if ((offset = OCXMLParallelParserFind(bytes, length, offset, "?>", 2)) == NSNotFound) { return (incomplete); }
+			offset += 2;
+		}
+		else if (bytes[offset+1] == '!')
+		{
+			if (((offset + 4) <= length) && (memcmp(&bytes[offset], "<!--", 4) == 0))
+			{
+				// Comment
+				if ((offset = OCXMLParallelParserFind(bytes, length, offset, "-->", 3)) == NSNotFound) { return (incomplete); }
+				offset += 3;
+			}
+			else
+			{
+				// DOCTYPE (internal subsets aren't supported)
+				NSUInteger doctypeEnd;
+
+				if ((doctypeEnd = OCXMLParallelParserFind(bytes, length, offset, ">", 1)) == NSNotFound) { return (incomplete); }
+				if (memchr(&bytes[offset], '[', doctypeEnd - offset) != NULL) { return (NSNotFound); }
+
+				offset = doctypeEnd + 1;
+			}
+		}
+		else
+		{
+			// Root element start tag
+			NSUInteger nameStart = offset + 1, nameEnd = nameStart, tagEnd = NSNotFound, p;
+			char quote = 0;
+
+			while ((nameEnd < length) && !OCXMLParallelParserIsSpace(bytes[nameEnd]) && (bytes[nameEnd] != '>') && (bytes[nameEnd] != '/')) { nameEnd++; }
+
+			for (p = nameEnd; p < length; p++)
+			{
+				if (quote != 0)
+				{
+					if (bytes[p] == quote) { quote = 0; }
+				}
+				else if ((bytes[p] == '"') || (bytes[p] == '\''))
+				{
+					quote = bytes[p];
+				}
+				else if (bytes[p] == '>')
+				{
+					tagEnd = p;
+					break;
+				}
+			}
+
+			if (tagEnd == NSNotFound) { return (incomplete); }
+			if (bytes[tagEnd-1] == '/') { return (NSNotFound); } // Empty root element
+
+			_rootStartTag = [[NSData alloc] initWithBytes:bytes length:tagEnd + 1];
+
+			NSMutableData *rootEndTag = [[NSMutableData alloc] initWithBytes:"</" length:2];
+			[rootEndTag appendBytes:&bytes[nameStart] length:(nameEnd - nameStart)];
+			[rootEndTag appendBytes:">" length:1];
+			_rootEndTag = rootEndTag;
+
+			_shardStartPattern = [self _shardStartPatternFromAttributeBytes:&bytes[nameEnd] length:(tagEnd - nameEnd)];
+
+			return (tagEnd + 1);
+		}
+	}
+
+	return (incomplete);
+}
+
+- (NSData *)_shardStartPatternFromAttributeBytes:(const char *)bytes length:(NSUInteger)length
+{
+	// Find the prefix declared for .shardElementNamespace
+	const char *namespaceBytes = _shardElementNamespace.UTF8String;
+	NSUInteger namespaceLength = strlen(namespaceBytes), p = 0;
+
+	while (p < length)
+	{
+		NSUInteger attributeNameStart, attributeNameEnd, valueStart;
+		char quote;
+
+		while ((p < length) && OCXMLParallelParserIsSpace(bytes[p])) { p++; }
+		attributeNameStart = p;
+
+		while ((p < length) && (bytes[p] != '=') && !OCXMLParallelParserIsSpace(bytes[p])) { p++; }
+		attributeNameEnd = p;
+
+		while ((p < length) && OCXMLParallelParserIsSpace(bytes[p])) { p++; }
+		if ((p >= length) || (bytes[p] != '=')) { break; }
+		p++;
+
+		while ((p < length) && OCXMLParallelParserIsSpace(bytes[p])) { p++; }
+		if ((p >= length) || ((bytes[p] != '"') && (bytes[p] != '\''))) { break; }
+		quote = bytes[p++];
+
+		valueStart = p;
+		while ((p < length) && (bytes[p] != quote)) { p++; }
+
+		if (((p - valueStart) == namespaceLength) && (memcmp(&bytes[valueStart], namespaceBytes, namespaceLength) == 0))
+		{
+			NSUInteger attributeNameLength = attributeNameEnd - attributeNameStart;
+			NSMutableData *pattern = nil;
+
+			if ((attributeNameLength == 5) && (memcmp(&bytes[attributeNameStart], "xmlns", 5) == 0))
+			{
+				// Default namespace
+				pattern = [[NSMutableData alloc] initWithBytes:"<" length:1];
+			}
+			else if ((attributeNameLength > 6) && (memcmp(&bytes[attributeNameStart], "xmlns:", 6) == 0))
+			{
+				pattern = [[NSMutableData alloc] initWithBytes:"<" length:1];
+				[pattern appendBytes:&bytes[attributeNameStart+6] length:attributeNameLength-6];
+				[pattern appendBytes:":" length:1];
+			}
+
+			if (pattern != nil)
+			{
+				[pattern appendData:[_shardElementLocalName dataUsingEncoding:NSUTF8StringEncoding]];
+				return (pattern);
+			}
+		}
+
+		p++;
+	}
+
+	return (nil);
+}
+
+#pragma mark - Cutting
+- (NSUInteger)_nextShardStartInBytes:(const char *)bytes length:(NSUInteger)length from:(NSUInteger)from
+{
+	const char *pattern = _shardStartPattern.bytes;
+	NSUInteger patternLength = _shardStartPattern.length, match;
+
+	while ((match = OCXMLParallelParserFind(bytes, length, from, pattern, patternLength)) != NSNotFound)
+	{
+		char next;
+
+		if ((match + patternLength) >= length) { break; } // Character following the name not yet available
+
+		next = bytes[match + patternLength];
+
+		if (OCXMLParallelParserIsSpace(next) || (next == '>') || (next == '/'))
+		{
+			return (match);
+		}
+
+		from = match + 1;
+	}
+
+	return (NSNotFound);
+}
+
+- (NSUInteger)_cutShardsFromBytes:(const char *)bytes length:(NSUInteger)length final:(BOOL)final
+{
+	// Enqueues shards from the body bytes and returns the number of bytes consumed (NSNotFound if parsing was cancelled)
+	NSUInteger offset = 0, cut;
+
+	while (((length - offset) > _shardSize) && ((cut = [self _nextShardStartInBytes:bytes length:length from:(offset + _shardSize)]) != NSNotFound))
+	{
+		if (![self _enqueueShardWithBodyBytes:&bytes[offset] length:(cut - offset) closeRoot:YES])
+		{
+			return (NSNotFound);
+		}
+
+		offset = cut;
+	}
+
+	if (final)
+	{
+		// Last shard: the rest of the document, including the root element's own closing tag
+		NSUInteger end = length, endTagLength = _rootEndTag.length - 1; // without ">", to allow for whitespace in the closing tag
+		BOOL foundEndTag = NO;
+
+		while ((end > offset) && !foundEndTag)
+		{
+			end--;
+			foundEndTag = (bytes[end] == '<') && ((length - end) >= endTagLength) && (memcmp(&bytes[end], _rootEndTag.bytes, endTagLength) == 0);
+		}
+
+		if (!foundEndTag)
+		{
+			// No closing tag found (f.ex. document truncated between two responses, which would otherwise parse as complete)
+			OCLogError(@"Closing tag of root element missing - document truncated?");
+			_error = OCErrorWithDescription(OCErrorResponseUnknownFormat, @"Closing tag of root element missing.");
+		}
+
+		if (![self _enqueueShardWithBodyBytes:&bytes[offset] length:(length - offset) closeRoot:NO])
+		{
+			return (NSNotFound);
+		}
+
+		offset = length;
+	}
+
+	return (offset);
+}
+
+#pragma mark - Shards
+- (BOOL)_enqueueShardWithBodyBytes:(const char *)bytes length:(NSUInteger)length closeRoot:(BOOL)closeRoot
+{
+	NSMutableData *shardData = [[NSMutableData alloc] initWithCapacity:(_rootStartTag.length + length + _rootEndTag.length)];
+
+	[shardData appendData:_rootStartTag];
+	[shardData appendBytes:bytes length:length];
+
+	if (closeRoot)
+	{
+		[shardData appendData:_rootEndTag];
+	}
+
+	return ([self _enqueueShardWithData:shardData]);
+}
+
+- (BOOL)_enqueueShardWithData:(NSData *)data
+{
+	OCXMLParallelParserShard *shard = [OCXMLParallelParserShard new];
+	NSDictionary<NSString *, id> *options = _options;
+	NSArray<Class> *objectCreationClasses = _objectCreationClasses;
+
+	shard.data = data;
+
+	[_shardCondition lock];
+
+	while ((_shards.count >= MAX(_maximumConcurrentShards, 1)) && !_cancelled)
+	{
+		[_shardCondition wait];
+	}
+
+	if (_cancelled)
+	{
+		[_shardCondition unlock];
+		return (NO);
+	}
+
+	[_shards addObject:shard];
+	_shardCount++;
+
+	[_shardCondition unlock];
+
+	dispatch_group_async(_parseGroup, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		@autoreleasepool
+		{
+			OCXMLParser *parser;
+			NSArray *parsedObjects = nil;
+			NSArray<NSError *> *errors = nil;
+
+			if ((parser = [[OCXMLParser alloc] initWithData:shard.data]) != nil)
+			{
+				parser.options = [options mutableCopy];
+				[parser addObjectCreationClasses:objectCreationClasses];
+
+				[parser parse];
+
+				parsedObjects = parser.parsedObjects;
+				errors = parser.errors;
+			}
+
+			[self->_shardCondition lock];
+
+			shard.data = nil;
+			shard.parsedObjects = parsedObjects;
+			shard.errors = errors;
+			shard.parsed = YES;
+
+			[self->_shardCondition broadcast];
+			[self->_shardCondition unlock];
+		}
+	});
+
+	return (YES);
+}
+
+- (void)_produceShards
+{
+	if (_data != nil)
+	{
+		const char *bytes = _data.bytes;
+		NSUInteger length = _data.length, bodyOffset;
+
+		if (((bodyOffset = [self _resolveFramingWithBytes:bytes length:length final:YES]) == NSNotFound) || (_shardStartPattern == nil))
+		{
+			// Parse as a single shard
+			[self _enqueueShardWithData:_data];
+		}
+		else
+		{
+			[self _cutShardsFromBytes:&bytes[bodyOffset] length:(length - bodyOffset) final:YES];
+		}
+	}
+	else if (_stream != nil)
+	{
+		NSMutableData *pendingData = [NSMutableData new];
+		uint8_t *buffer = malloc(OCXMLParallelParserStreamBufferSize);
+		BOOL framingResolved = NO, cut = YES;
+
+		[_stream open];
+
+		while (YES)
+		{
+			NSInteger readBytes = [_stream read:buffer maxLength:OCXMLParallelParserStreamBufferSize];
+			BOOL final = (readBytes <= 0);
+
+			if (readBytes < 0)
+			{
+				_error = (_stream.streamError != nil) ? _stream.streamError : [NSError errorWithDomain:NSPOSIXErrorDomain code:EIO userInfo:nil];
+				break;
+			}
+
+			[pendingData appendBytes:buffer length:readBytes];
+
+			if (!framingResolved)
+			{
+				NSUInteger bodyOffset;
+
+				if ((bodyOffset = [self _resolveFramingWithBytes:pendingData.bytes length:pendingData.length final:final]) == 0)
+				{
+					continue;
+				}
+
+				framingResolved = YES;
+
+				if ((bodyOffset == NSNotFound) || (_shardStartPattern == nil))
+				{
+					cut = NO;
+				}
+				else
+				{
+					[pendingData replaceBytesInRange:NSMakeRange(0, bodyOffset) withBytes:NULL length:0];
+				}
+			}
+
+			if (cut)
+			{
+				NSUInteger consumedBytes;
+
+				if ((consumedBytes = [self _cutShardsFromBytes:pendingData.bytes length:pendingData.length final:final]) == NSNotFound)
+				{
+					// Cancelled
+					break;
+				}
+
+				if (consumedBytes > 0)
+				{
+					[pendingData replaceBytesInRange:NSMakeRange(0, consumedBytes) withBytes:NULL length:0];
+				}
+			}
+			else if (final)
+			{
+				[self _enqueueShardWithData:pendingData];
+			}
+
+			if (final)
+			{
+				break;
+			}
+		}
+
+		[_stream close];
+
+		free(buffer);
+	}
+}
+
+#pragma mark - Parse
+- (BOOL)parseWithShardConsumer:(OCXMLParallelParserShardConsumer)shardConsumer
+{
+	BOOL success = YES;
+
+	if ((_data == nil) && (_stream == nil))
+	{
+		return (NO);
+	}
+
+	_parseGroup = dispatch_group_create();
+
+	// Cut the document into shards on a separate thread, so cutting overlaps with parsing and consuming
+	dispatch_group_async(_parseGroup, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+		@autoreleasepool
+		{
+			[self _produceShards];
+		}
+
+		[self->_shardCondition lock];
+		self->_producerFinished = YES;
+		[self->_shardCondition broadcast];
+		[self->_shardCondition unlock];
+	});
+
+	// Consume shards in document order
+	while (YES)
+	{
+		OCXMLParallelParserShard *shard = nil;
+
+		[_shardCondition lock];
+
+		while (!(_shards.firstObject.parsed || (_producerFinished && (_shards.count == 0))))
+		{
+			[_shardCondition wait];
+		}
+
+		if ((shard = _shards.firstObject) != nil)
+		{
+			[_shards removeObjectAtIndex:0];
+			[_shardCondition broadcast];
+		}
+
+		[_shardCondition unlock];
+
+		if (shard == nil)
+		{
+			break;
+		}
+
+		@autoreleasepool
+		{
+			if (!shardConsumer(((shard.parsedObjects != nil) ? shard.parsedObjects : @[]), ((shard.errors != nil) ? shard.errors : @[])))
+			{
+				[_shardCondition lock];
+				_cancelled = YES;
+				[_shardCondition broadcast];
+				[_shardCondition unlock];
+
+				success = NO;
+				break;
+			}
+		}
+	}
+
+	// Wait for in-flight shards to finish
+	dispatch_group_wait(_parseGroup, DISPATCH_TIME_FOREVER);
+
+	if (_error != nil)
+	{
+		OCLogError(@"Error reading document: %@", _error);
+		success = NO;
+	}
+
+	return (success);
+}
+
+@end
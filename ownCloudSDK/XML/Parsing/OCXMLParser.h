@@ -17,37 +17,56 @@
  */
 
 #import <Foundation/Foundation.h>
+#import "OCXMLSAXParser.h"
 
 @class OCXMLParser;
 @class OCXMLParserNode;
 
+@protocol OCXMLObjectDecoder <NSObject>
+
+- (void)xmlParser:(OCXMLParser *)xmlParser didStartElement:(OCXMLElementName)elementName attributes:(NSDictionary<NSString *,NSString *> *)attributes; //!< Called for the object's element and all elements it contains
+- (void)xmlParser:(OCXMLParser *)xmlParser foundCharacters:(const char *)bytes length:(NSUInteger)length; //!< bytes are only valid for the duration of the call
+- (void)xmlParser:(OCXMLParser *)xmlParser didEndElement:(OCXMLElementName)elementName;
+
+- (id)finishObjectForXMLParser:(OCXMLParser *)xmlParser; //!< Called after the object's element ended. Returns the decoded object (or nil) and resets the decoder for the next object.
+
+@end
+
 @protocol OCXMLObjectCreation <NSObject>
 
 + (NSString *)xmlElementNameForObjectCreation;
 + (instancetype)instanceFromNode:(OCXMLParserNode *)node xmlParser:(OCXMLParser *)xmlParser;
 
+@optional
++ (id<OCXMLObjectDecoder>)xmlObjectDecoderForParser:(OCXMLParser *)xmlParser; //!< Returns a decoder that creates objects directly from the parser events, without building OCXMLParserNodes. Only used with the OCXMLSAXParser backend - +instanceFromNode:xmlParser: is used otherwise.
+
 @end
 
 typedef NSError *(^OCXMLParserElementValueConverter)(NSString *elementName, NSString *value, NSString *namespaceURI, NSDictionary <NSString*,NSString*> *attributes, id *convertedValue);
 
 typedef void(^OCXMLParsedObjectStreamConsumer)(OCXMLParser *parser, NSError *error, id parsedObject);
 
-@interface OCXMLParser : NSObject <NSXMLParserDelegate>
+@interface OCXMLParser : NSObject <NSXMLParserDelegate, OCXMLSAXParserDelegate>
 {
 	NSXMLParser *_xmlParser;
+	OCXMLSAXParser *_saxParser;
 
 	NSMutableDictionary<NSString *, Class> *_objectCreationClassByElementName;
 	NSMutableDictionary<NSString *, OCXMLParserElementValueConverter> *_valueConverterByElementName;
+	NSMutableDictionary<NSString *, id<OCXMLObjectDecoder>> *_objectDecoderByElementName;
+	id<OCXMLObjectDecoder> _activeObjectDecoder; //!< Decoder that currently receives all events
+	NSUInteger _activeObjectDecoderDepth;
+
+	NSSet<NSString *> *_dateElementNames; //!< Names of elements whose contents are parsed into NSDates straight from the bytes
 
-	NSMutableArray<OCXMLParserNode *> *_stack;
+	NSMutableArray *_stack; //!< OCXMLParserNode for elements whose node was needed, NSNull for (so far) childless elements
 
 	NSMutableArray<NSString *> *_elementPath;
 	NSMutableArray<NSDictionary<NSString *,NSString *> *> *_elementAttributes;
 
-	NSMutableArray<NSMutableString *> *_elementContents;
-	NSMutableIndexSet *_elementContentsEmptyIndexes;
-	NSMutableIndexSet *_elementObjectifiedIndexes;
-	NSInteger _elementContentsLastIndex;
+	NSMutableData *_elementContents; //!< Text of all open elements, back to back
+	NSUInteger *_elementContentsOffsets; //!< Offset of each open element's text in _elementContents
+	NSUInteger _elementContentsOffsetsCapacity;
 
 	NSInteger _objectCreationRetainDepth;
 }
@@ -62,14 +81,17 @@ typedef void(^OCXMLParsedObjectStreamConsumer)(OCXMLParser *parser, NSError *err
 
 #pragma mark - Init & Dealloc
 - (instancetype)initWithParser:(NSXMLParser *)xmlParser;
+- (instancetype)initWithSAXParser:(OCXMLSAXParser *)saxParser;
 - (instancetype)initWithData:(NSData *)xmlData;
 - (instancetype)initWithURL:(NSURL *)url;
+- (instancetype)initWithStream:(NSInputStream *)stream;
 
 #pragma mark - Specify classes
 - (void)addObjectCreationClasses:(NSArray <Class> *)classes;
+- (void)setValueConverter:(OCXMLParserElementValueConverter)valueConverter forElementName:(NSString *)elementName; //!< Sets (or removes, if nil) the converter for the text contents of elements named elementName. Not called for elements inside objects created by an OCXMLObjectDecoder.
 
 #pragma mark - Parse
 - (BOOL)parse;
-- (void)abort; //!< must be called from the NSXMLParser delegate - that includes .parsedObjectStreamConsumer
+- (void)abort; //!< must be called from the parser delegate - that includes .parsedObjectStreamConsumer
 
 @end
@@ -32,16 +32,13 @@
 	{
 		_valueConverterByElementName = [NSMutableDictionary new];
 		_objectCreationClassByElementName = [NSMutableDictionary new];
+		_objectDecoderByElementName = [NSMutableDictionary new];
 
 		_stack = [NSMutableArray new];
 		_elementPath = [NSMutableArray new];
 
-		_elementContents = [NSMutableArray new];
+		_elementContents = [NSMutableData new];
 		_elementAttributes = [NSMutableArray new];
-		_elementContentsEmptyIndexes = [NSMutableIndexSet new];
-		_elementContentsLastIndex = -1;
-
-		_elementObjectifiedIndexes = [NSMutableIndexSet new];
 
 		_errors = [NSMutableArray new];
 		_parsedObjects = [NSMutableArray new];
@@ -78,6 +75,7 @@
 			/*
 				Examples:
 				"Fri, 23 Feb 2018 11:52:05 GMT"
+				"2018-02-23T11:52:05Z"
 			*/
 			NSDate *date = nil;
 
@@ -93,6 +91,8 @@
 		};
 		[_valueConverterByElementName setObject:dateConverter forKey:@"d:getlastmodified"];
 		[_valueConverterByElementName setObject:dateConverter forKey:@"d:creationdate"];
+
+		_dateElementNames = [NSSet setWithObjects:@"d:getlastmodified", @"d:creationdate", nil];
 	}
 	
 	return(self);
@@ -109,16 +109,34 @@
 	return(self);
 }
 
+- (instancetype)initWithSAXParser:(OCXMLSAXParser *)saxParser
+{
+	if ((self = [self init]) != nil)
+	{
+		_saxParser = saxParser;
+		_saxParser.delegate = self;
+	}
+
+	return(self);
+}
+
 - (instancetype)initWithData:(NSData *)xmlData
 {
-	self = [self initWithParser:[[NSXMLParser alloc] initWithData:xmlData]];
+	self = [self initWithSAXParser:[[OCXMLSAXParser alloc] initWithData:xmlData]];
 
 	return(self);
 }
 
 - (instancetype)initWithURL:(NSURL *)url
 {
-	self = [self initWithParser:[[NSXMLParser alloc] initWithContentsOfURL:url]];
+	self = [self initWithSAXParser:[[OCXMLSAXParser alloc] initWithURL:url]];
+
+	return(self);
+}
+
+- (instancetype)initWithStream:(NSInputStream *)stream
+{
+	self = [self initWithSAXParser:[[OCXMLSAXParser alloc] initWithStream:stream]];
 
 	return(self);
 }
@@ -126,6 +144,13 @@
 - (void)dealloc
 {
 	_xmlParser.delegate = nil;
+	_saxParser.delegate = nil;
+
+	if (_elementContentsOffsets != NULL)
+	{
+		free(_elementContentsOffsets);
+		_elementContentsOffsets = NULL;
+	}
 }
 
 #pragma mark - Specify classes
@@ -145,6 +170,18 @@
 	}
 }
 
+- (void)setValueConverter:(OCXMLParserElementValueConverter)valueConverter forElementName:(NSString *)elementName
+{
+	if (valueConverter != nil)
+	{
+		_valueConverterByElementName[elementName] = [valueConverter copy];
+	}
+	else
+	{
+		[_valueConverterByElementName removeObjectForKey:elementName];
+	}
+}
+
 #pragma mark - Properties
 - (NSMutableDictionary<NSString *,id> *)userInfo
 {
@@ -169,83 +206,134 @@
 #pragma mark - Parse
 - (BOOL)parse
 {
+	if (_saxParser != nil)
+	{
+		return ([_saxParser parse]);
+	}
+
 	return ([_xmlParser parse]);
 }
 
 - (void)abort
 {
-	[_xmlParser abortParsing];
+	if (_saxParser != nil)
+	{
+		[_saxParser abortParsing];
+	}
+	else
+	{
+		[_xmlParser abortParsing];
+	}
 }
 
-#pragma mark - Parser delegate
-- (void)parserDidEndDocument:(NSXMLParser *)parser
+#pragma mark - Element handling
+- (OCXMLParserNode *)_nodeAtStackIndex:(NSUInteger)index
 {
-	if (_stack.count > 0)
+	id node = _stack[index];
+
+	// Nodes are only created once they are needed: when an element has children, is empty or an object is created from it
+	if (node == NSNull.null)
 	{
-		OCLogWarning(@"Stack not empty: %@", _stack);
+		NSError *error = nil;
+
+		if ((node = [[OCXMLParserNode alloc] initWithXMLParser:self elementName:_elementPath[index] namespaceURI:nil attributes:_elementAttributes[index] error:&error]) != nil)
+		{
+			((OCXMLParserNode *)node).retainChildren = (_objectCreationRetainDepth > 0) || _forceRetain;
+
+			_stack[index] = node;
+		}
+		else
+		{
+			if (error != nil)
+			{
+				[self emitError:error];
+			}
+
+			return (nil);
+		}
 	}
-}
 
-- (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)parseError
-{
-	[self emitError:parseError];
+	return (node);
 }
 
-- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName attributes:(NSDictionary<NSString *,NSString *> *)attributeDict
+- (void)_startElement:(NSString *)elementName attributes:(NSDictionary<NSString *,NSString *> *)attributeDict
 {
-	OCXMLParserNode *elementNode = nil;
-	NSError *error = nil;
+	NSUInteger depth = _stack.count;
 
-	if ([_objectCreationClassByElementName valueForKey:elementName] != nil)
+	// The parent now has a child => create its node
+	if (depth > 0)
 	{
-		_objectCreationRetainDepth++;
+		[self _nodeAtStackIndex:depth-1];
 	}
 
-	if ((elementNode = [[OCXMLParserNode alloc] initWithXMLParser:self elementName:elementName namespaceURI:namespaceURI attributes:attributeDict error:&error]) != nil)
-	{
-		[_stack addObject:elementNode];
-	}
-	else if (error != nil)
+	if ([_objectCreationClassByElementName objectForKey:elementName] != nil)
 	{
-		[self emitError:error];
+		_objectCreationRetainDepth++;
 	}
 
-	elementNode.retainChildren = (_objectCreationRetainDepth > 0) || _forceRetain;
-	
+	[_stack addObject:NSNull.null];
+
 	[_elementPath addObject:elementName];
 
 	[_elementAttributes addObject:((attributeDict!=nil) ? attributeDict : @{})];
-	
-	[_elementContents addObject:[NSMutableString new]];
-	_elementContentsLastIndex++;
-	[_elementContentsEmptyIndexes addIndex:_elementContentsLastIndex];
+
+	if (depth >= _elementContentsOffsetsCapacity)
+	{
+		_elementContentsOffsetsCapacity = (_elementContentsOffsetsCapacity == 0) ? 32 : (_elementContentsOffsetsCapacity * 2);
+		_elementContentsOffsets = realloc(_elementContentsOffsets, sizeof(NSUInteger) * _elementContentsOffsetsCapacity);
+	}
+
+	_elementContentsOffsets[depth] = _elementContents.length;
 }
 
-- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string
+- (void)_appendCharacters:(const char *)bytes length:(NSUInteger)length
 {
-	[[_elementContents lastObject] appendString:string];
-	[_elementContentsEmptyIndexes removeIndex:_elementContentsLastIndex];
+	if (_stack.count > 0)
+	{
+		[_elementContents appendBytes:bytes length:length];
+	}
 }
 
-- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName
+- (void)_endElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI
 {
-	id elementContents = nil;
-	OCXMLParserNode *lastParserElementOnStack = _stack.lastObject;
+	if (_stack.count == 0) { return; }
 
-	if (![_elementContentsEmptyIndexes containsIndex:_elementContentsLastIndex])
+	NSUInteger index = _stack.count - 1;
+	NSUInteger contentsOffset = _elementContentsOffsets[index];
+	OCXMLParserNode *elementNode = nil;
+	Class objectCreationClass = [_objectCreationClassByElementName objectForKey:elementName];
+
+	if (_elementContents.length > contentsOffset)
 	{
-		elementContents = [_elementContents lastObject];
-	
-		if (_stack.count > 1)
+		if (index > 0)
 		{
+			const char *contentsBytes = ((const char *)_elementContents.bytes) + contentsOffset;
+			NSUInteger contentsLength = _elementContents.length - contentsOffset;
+			id elementContents = nil;
 			OCXMLParserElementValueConverter valueConverter;
 
-			if ((valueConverter = _valueConverterByElementName[_elementPath.lastObject]) != nil)
+			// Parse dates directly from the bytes, skipping the intermediate string
+			if ([_dateElementNames containsObject:elementName])
+			{
+				elementContents = [NSDate dateParsedFromBytes:contentsBytes length:contentsLength];
+			}
+
+			if (elementContents != nil)
+			{
+				valueConverter = nil;
+			}
+			else
+			{
+				elementContents = [[NSString alloc] initWithBytes:contentsBytes length:contentsLength encoding:NSUTF8StringEncoding];
+				valueConverter = _valueConverterByElementName[elementName];
+			}
+
+			if (valueConverter != nil)
 			{
 				@autoreleasepool {
 					id convertedValue = nil;
 					NSError *error;
-					
+
 					if ((error = valueConverter(elementName, elementContents, namespaceURI, _elementAttributes.lastObject, &convertedValue)) != nil)
 					{
 						[self emitError:error];
@@ -256,37 +344,39 @@
 					}
 				}
 			}
-		
-			[[_stack objectAtIndex:_stack.count-2] xmlParser:self parseKey:_elementPath.lastObject value:elementContents attributes:_elementAttributes.lastObject];
+
+			[[self _nodeAtStackIndex:index-1] xmlParser:self parseKey:elementName value:elementContents attributes:_elementAttributes.lastObject];
 		}
 	}
 	else
 	{
-	
-		// Tell parser that its parsing has completed
-		[lastParserElementOnStack xmlParser:self completedParsingForChild:nil];
-		
-		// Tell parent that parsing of this child has completed
-		if (_stack.count > 1)
-		{
-			[_stack[_stack.count-2] xmlParser:self completedParsingForChild:lastParserElementOnStack];
-		}
-		else
+		OCXMLParserNode *parentNode = (index > 0) ? [self _nodeAtStackIndex:index-1] : nil;
+
+		// Only create a node for an empty element if it's kept by its parent or an object is created from it
+		if (parentNode.retainChildren || (objectCreationClass != nil) || (index == 0))
 		{
-			//OCLogDebug(@"%@", lastParserElementOnStack);
-			//OCLogDebug(@"%@", [(OCXMLParserNode *)lastParserElementOnStack nodesForXPath:@"d:response/d:propstat"]);
+			elementNode = [self _nodeAtStackIndex:index];
+
+			// Tell parser that its parsing has completed
+			[elementNode xmlParser:self completedParsingForChild:nil];
+
+			// Tell parent that parsing of this child has completed
+			[parentNode xmlParser:self completedParsingForChild:elementNode];
 		}
 	}
 
 	// Create object if applicable
-	Class objectCreationClass;
-
-	if ((objectCreationClass = [_objectCreationClassByElementName valueForKey:elementName]) != nil)
+	if (objectCreationClass != nil)
 	{
 		// Try object creation
 		id parsedObject;
 
-		if ((parsedObject = [objectCreationClass instanceFromNode:lastParserElementOnStack xmlParser:self]) != nil)
+		if (elementNode == nil)
+		{
+			elementNode = [self _nodeAtStackIndex:index];
+		}
+
+		if ((parsedObject = [objectCreationClass instanceFromNode:elementNode xmlParser:self]) != nil)
 		{
 			if ([parsedObject isKindOfClass:[NSError class]])
 			{
@@ -305,12 +395,128 @@
 
 	[_elementPath removeLastObject];
 
-	if (_elementContentsLastIndex < -1) { _elementContentsLastIndex = -1; }
 	[_elementAttributes removeLastObject];
 
-	[_elementContents removeLastObject];
-	[_elementContentsEmptyIndexes removeIndex:_elementContentsLastIndex];
-	_elementContentsLastIndex--;
+	_elementContents.length = contentsOffset;
+}
+
+#pragma mark - Object decoders
+- (id<OCXMLObjectDecoder>)_objectDecoderForElementName:(OCXMLElementName)elementName
+{
+	id<OCXMLObjectDecoder> objectDecoder;
+	Class objectCreationClass;
+
+	if ((objectDecoder = _objectDecoderByElementName[elementName]) == nil)
+	{
+		if (((objectCreationClass = _objectCreationClassByElementName[elementName]) != nil) && [objectCreationClass respondsToSelector:@selector(xmlObjectDecoderForParser:)])
+		{
+			if ((objectDecoder = [objectCreationClass xmlObjectDecoderForParser:self]) != nil)
+			{
+				_objectDecoderByElementName[elementName] = objectDecoder;
+			}
+		}
+	}
+
+	return (objectDecoder);
+}
+
+#pragma mark - SAX parser delegate
+- (void)saxParser:(OCXMLSAXParser *)parser didStartElement:(OCXMLElementName)elementName attributes:(NSDictionary<NSString *,NSString *> *)attributes
+{
+	if ((_activeObjectDecoder == nil) && (_objectCreationClassByElementName[elementName] != nil))
+	{
+		_activeObjectDecoder = [self _objectDecoderForElementName:elementName];
+	}
+
+	if (_activeObjectDecoder != nil)
+	{
+		_activeObjectDecoderDepth++;
+		[_activeObjectDecoder xmlParser:self didStartElement:elementName attributes:attributes];
+		return;
+	}
+
+	[self _startElement:elementName attributes:attributes];
+}
+
+- (void)saxParser:(OCXMLSAXParser *)parser foundCharacters:(const char *)bytes length:(NSUInteger)length
+{
+	if (_activeObjectDecoder != nil)
+	{
+		[_activeObjectDecoder xmlParser:self foundCharacters:bytes length:length];
+		return;
+	}
+
+	[self _appendCharacters:bytes length:length];
+}
+
+- (void)saxParser:(OCXMLSAXParser *)parser didEndElement:(OCXMLElementName)elementName
+{
+	if (_activeObjectDecoder != nil)
+	{
+		[_activeObjectDecoder xmlParser:self didEndElement:elementName];
+
+		if ((--_activeObjectDecoderDepth) == 0)
+		{
+			id<OCXMLObjectDecoder> objectDecoder = _activeObjectDecoder;
+			id parsedObject;
+
+			_activeObjectDecoder = nil;
+
+			if ((parsedObject = [objectDecoder finishObjectForXMLParser:self]) != nil)
+			{
+				if ([parsedObject isKindOfClass:[NSError class]])
+				{
+					[self emitError:parsedObject];
+				}
+				else
+				{
+					[self emitParsedObject:parsedObject];
+				}
+			}
+		}
+		return;
+	}
+
+	[self _endElement:elementName namespaceURI:nil];
+}
+
+- (void)saxParser:(OCXMLSAXParser *)parser parseErrorOccurred:(NSError *)parseError
+{
+	[self emitError:parseError];
+}
+
+#pragma mark - NSXMLParser delegate
+- (void)parserDidEndDocument:(NSXMLParser *)parser
+{
+	if (_stack.count > 0)
+	{
+		OCLogWarning(@"Stack not empty: %@", _stack);
+	}
+}
+
+- (void)parser:(NSXMLParser *)parser parseErrorOccurred:(NSError *)parseError
+{
+	[self emitError:parseError];
+}
+
+- (void)parser:(NSXMLParser *)parser didStartElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName attributes:(NSDictionary<NSString *,NSString *> *)attributeDict
+{
+	[self _startElement:elementName attributes:attributeDict];
+}
+
+- (void)parser:(NSXMLParser *)parser foundCharacters:(NSString *)string
+{
+	const char *utf8String;
+
+	if ((utf8String = string.UTF8String) != NULL)
+	{
+		[self _appendCharacters:utf8String length:strlen(utf8String)];
+	}
+}
+
+- (void)parser:(NSXMLParser *)parser didEndElement:(NSString *)elementName namespaceURI:(NSString *)namespaceURI qualifiedName:(NSString *)qName
+{
+	[self _endElement:elementName namespaceURI:namespaceURI];
 }
 
 - (void)emitError:(NSError *)error
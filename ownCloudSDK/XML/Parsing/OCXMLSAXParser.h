@@ -0,0 +1,67 @@
+//
+//  OCXMLSAXParser.h
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class OCXMLSAXParser;
+
+typedef NSString* OCXMLElementName; //!< Interned, namespace-resolved element name (f.ex. "d:response" for <D:response xmlns:D="DAV:">). Identical names are represented by the identical NSString instance.
+
+@protocol OCXMLSAXParserDelegate <NSObject>
+
+- (void)saxParser:(OCXMLSAXParser *)parser didStartElement:(OCXMLElementName)elementName attributes:(nullable NSDictionary<NSString *,NSString *> *)attributes; //!< attributes is nil for elements without attributes
+- (void)saxParser:(OCXMLSAXParser *)parser foundCharacters:(const char *)bytes length:(NSUInteger)length; //!< UTF-8 text with entities resolved. The bytes are borrowed from the parser's buffer and only valid for the duration of the call.
+- (void)saxParser:(OCXMLSAXParser *)parser didEndElement:(OCXMLElementName)elementName;
+
+@optional
+- (void)saxParser:(OCXMLSAXParser *)parser parseErrorOccurred:(NSError *)parseError;
+
+@end
+
+/*
+	Non-validating, streaming SAX parser for the XML dialect used by WebDAV and OCS responses:
+	- element names are resolved against the namespace declarations in the document and interned, so that "d:getetag" is the same object regardless of the prefix a server uses for the DAV: namespace
+	- text is delivered as byte ranges of the input (or the stream buffer), and only copied where entities need to be resolved
+	- DTDs are skipped, external entities are never loaded
+	Errors are reported in NSXMLParserErrorDomain, using the same codes as NSXMLParser.
+*/
+
+@interface OCXMLSAXParser : NSObject
+
+@property(weak,nullable) id<OCXMLSAXParserDelegate> delegate;
+
+@property(readonly,strong,nullable) NSError *parserError; //!< The error that stopped parsing (if any)
+@property(readonly) NSUInteger bytesParsed; //!< Number of bytes consumed so far
+
+#pragma mark - Init
+- (instancetype)initWithData:(NSData *)data;
+- (instancetype)initWithURL:(NSURL *)url; //!< Maps the file into memory where possible
+- (instancetype)initWithStream:(NSInputStream *)stream;
+
+#pragma mark - Parse
+- (BOOL)parse;
+- (void)abortParsing; //!< Must be called from one of the delegate methods
+
+#pragma mark - Element names
++ (OCXMLElementName)internedElementNameForNamespace:(nullable NSString *)namespaceURI localName:(NSString *)localName; //!< Returns the interned name the parser delivers for an element in namespaceURI
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,983 @@
+//
+//  OCXMLSAXParser.m
+//  ownCloudSDK
+//
+//  Created by agent on 19.10.26.
+//  Copyright © 2026 ownCloud GmbH. All rights reserved.
+//
+
+/*
+ * Copyright (C) 2026, ownCloud GmbH.
+ *
+ * This code is covered by the GNU Public License Version 3.
+ *
+ * For distribution utilizing Apple mechanisms please see https://owncloud.org/contribute/iOS-license-exception/
+ * You should have received a copy of this license along with this program. If not, see <http://www.gnu.org/licenses/gpl-3.0.en.html>.
+ *
+ */
+
+#import <os/lock.h>
+#import "OCXMLSAXParser.h"
+
+typedef struct
+{
+	NSUInteger rawNameOffset; // offset of the element's name - as found in the document - in _rawNames
+	NSUInteger rawNameLength;
+
+	__unsafe_unretained OCXMLElementName name; // interned names are kept alive by the intern table
+
+	NSUInteger namespaceDeclarationCount;
+} OCXMLSAXElementFrame;
+
+typedef struct
+{
+	uint32_t hash;
+	uint32_t length;
+	char *bytes;
+
+	__unsafe_unretained OCXMLElementName name;
+} OCXMLSAXNameCacheEntry;
+
+typedef void(*OCXMLSAXStartElementIMP)(id, SEL, OCXMLSAXParser *, OCXMLElementName, NSDictionary<NSString *,NSString *> *);
+typedef void(*OCXMLSAXCharactersIMP)(id, SEL, OCXMLSAXParser *, const char *, NSUInteger);
+typedef void(*OCXMLSAXEndElementIMP)(id, SEL, OCXMLSAXParser *, OCXMLElementName);
+
+#define OCXMLSAXStreamChunkSize (64 * 1024)
+
+static os_unfair_lock sInternLock = OS_UNFAIR_LOCK_INIT;
+static NSMutableDictionary<NSString *, OCXMLElementName> *sInternedNames;
+static NSDictionary<NSString *, NSString *> *sCanonicalPrefixByNamespace;
+
+static inline BOOL OCXMLIsWhitespace(uint8_t c)
+{
+	return ((c == ' ') || (c == '\n') || (c == '\r') || (c == '\t'));
+}
+
+static inline uint32_t OCXMLHashBytes(const uint8_t *bytes, NSUInteger length)
+{
+	uint32_t hash = 2166136261u; // FNV-1a
+
+	for (NSUInteger i=0; i<length; i++)
+	{
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+
+	return (hash);
+}
+
+static const uint8_t *OCXMLFindBytes(const uint8_t *bytes, const uint8_t *end, const char *needle, NSUInteger needleLength)
+{
+	while ((bytes = memchr(bytes, needle[0], end - bytes)) != NULL)
+	{
+		if ((NSUInteger)(end - bytes) < needleLength) { return (NULL); }
+
+		if (memcmp(bytes, needle, needleLength) == 0) { return (bytes); }
+
+		bytes++;
+	}
+
+	return (NULL);
+}
+
+static void OCXMLAppendUTF8(NSMutableData *data, uint32_t codePoint)
+{
+	uint8_t utf8[4];
+	NSUInteger length;
+
+	if (codePoint < 0x80)
+	{
+		utf8[0] = (uint8_t)codePoint;
+		length = 1;
+	}
+	else if (codePoint < 0x800)
+	{
+		utf8[0] = (uint8_t)(0xC0 | (codePoint >> 6));
+		utf8[1] = (uint8_t)(0x80 | (codePoint & 0x3F));
+		length = 2;
+	}
+	else if (codePoint < 0x10000)
+	{
+		utf8[0] = (uint8_t)(0xE0 | (codePoint >> 12));
+		utf8[1] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+		utf8[2] = (uint8_t)(0x80 | (codePoint & 0x3F));
+		length = 3;
+	}
+	else
+	{
+		utf8[0] = (uint8_t)(0xF0 | (codePoint >> 18));
+		utf8[1] = (uint8_t)(0x80 | ((codePoint >> 12) & 0x3F));
+		utf8[2] = (uint8_t)(0x80 | ((codePoint >> 6) & 0x3F));
+		utf8[3] = (uint8_t)(0x80 | (codePoint & 0x3F));
+		length = 4;
+	}
+
+	[data appendBytes:utf8 length:length];
+}
+
+// Resolves entity and character references in bytes into decoded. Returns NO for unknown or malformed references.
+static BOOL OCXMLDecodeEntities(const uint8_t *bytes, NSUInteger length, NSMutableData *decoded)
+{
+	const uint8_t *p = bytes, *end = bytes + length;
+
+	decoded.length = 0;
+
+	while (p < end)
+	{
+		const uint8_t *ampersand, *semicolon;
+
+		if ((ampersand = memchr(p, '&', end - p)) == NULL)
+		{
+			[decoded appendBytes:p length:(end - p)];
+			break;
+		}
+
+		[decoded appendBytes:p length:(ampersand - p)];
+
+		if ((semicolon = memchr(ampersand, ';', end - ampersand)) == NULL)
+		{
+			return (NO);
+		}
+
+		const uint8_t *entity = ampersand + 1;
+		NSUInteger entityLength = semicolon - entity;
+
+		if ((entityLength > 1) && (entity[0] == '#'))
+		{
+			uint32_t codePoint = 0;
+			BOOL hex = (entity[1] == 'x');
+
+			for (NSUInteger i=(hex ? 2 : 1); i<entityLength; i++)
+			{
+				uint8_t c = entity[i];
+
+				if ((c >= '0') && (c <= '9'))			{ codePoint = codePoint * (hex ? 16 : 10) + (c - '0'); }
+				else if (hex && (c >= 'a') && (c <= 'f'))	{ codePoint = codePoint * 16 + (c - 'a' + 10); }
+				else if (hex && (c >= 'A') && (c <= 'F'))	{ codePoint = codePoint * 16 + (c - 'A' + 10); }
+				else { return (NO); }
+
+				if (codePoint > 0x10FFFF) { return (NO); }
+			}
+
+			OCXMLAppendUTF8(decoded, codePoint);
+		}
+		else if ((entityLength == 2) && (memcmp(entity, "lt", 2) == 0))   { [decoded appendBytes:"<" length:1]; }
+		else if ((entityLength == 2) && (memcmp(entity, "gt", 2) == 0))   { [decoded appendBytes:">" length:1]; }
+		else if ((entityLength == 3) && (memcmp(entity, "amp", 3) == 0))  { [decoded appendBytes:"&" length:1]; }
+		else if ((entityLength == 4) && (memcmp(entity, "quot", 4) == 0)) { [decoded appendBytes:"\"" length:1]; }
+		else if ((entityLength == 4) && (memcmp(entity, "apos", 4) == 0)) { [decoded appendBytes:"'" length:1]; }
+		else
+		{
+			return (NO);
+		}
+
+		p = semicolon + 1;
+	}
+
+	return (YES);
+}
+
+@interface OCXMLSAXParser ()
+{
+	NSData *_data;
+	NSURL *_url;
+	NSInputStream *_stream;
+
+	__weak id<OCXMLSAXParserDelegate> _delegate;
+	id<OCXMLSAXParserDelegate> _strongDelegate; // retained for the duration of -parse
+
+	OCXMLSAXStartElementIMP _startElementIMP;
+	OCXMLSAXCharactersIMP _charactersIMP;
+	OCXMLSAXEndElementIMP _endElementIMP;
+
+	OCXMLSAXElementFrame *_frames;
+	NSUInteger _depth;
+	NSUInteger _framesCapacity;
+
+	NSMutableData *_rawNames;
+	NSMutableData *_decodeBuffer;
+
+	NSMutableArray<NSString *> *_namespacePrefixes;
+	NSMutableArray<NSString *> *_namespaceURIs;
+
+	OCXMLSAXNameCacheEntry *_nameCache;
+	NSUInteger _nameCacheCapacity;
+	NSUInteger _nameCacheCount;
+
+	BOOL _sawRootElement;
+	BOOL _aborted;
+}
+@end
+
+@implementation OCXMLSAXParser
+
+@synthesize delegate = _delegate;
+
++ (void)initialize
+{
+	if (self == [OCXMLSAXParser class])
+	{
+		sInternedNames = [NSMutableDictionary new];
+
+		// Prefixes used by element names. Responses using other prefixes for these namespaces yield the same names.
+		sCanonicalPrefixByNamespace = @{
+			@"DAV:" 					: @"d",
+			@"http://owncloud.org/ns" 			: @"oc",
+			@"http://nextcloud.org/ns" 			: @"nc",
+			@"http://sabredav.org/ns" 			: @"s",
+			@"http://open-collaboration-services.org/ns"	: @"ocs",
+			@"urn:ietf:params:xml:ns:caldav"		: @"cal",
+			@"urn:ietf:params:xml:ns:carddav"		: @"card",
+			@"http://calendarserver.org/ns/"		: @"cs"
+		};
+	}
+}
+
+#pragma mark - Init & Dealloc
+- (instancetype)initWithData:(NSData *)data
+{
+	if ((self = [super init]) != nil)
+	{
+		_data = data;
+	}
+
+	return (self);
+}
+
+- (instancetype)initWithURL:(NSURL *)url
+{
+	if ((self = [super init]) != nil)
+	{
+		_url = url;
+	}
+
+	return (self);
+}
+
+- (instancetype)initWithStream:(NSInputStream *)stream
+{
+	if ((self = [super init]) != nil)
+	{
+		_stream = stream;
+	}
+
+	return (self);
+}
+
+- (void)dealloc
+{
+	[self _clearNameCache];
+
+	if (_nameCache != NULL)
+	{
+		free(_nameCache);
+		_nameCache = NULL;
+	}
+
+	if (_frames != NULL)
+	{
+		free(_frames);
+		_frames = NULL;
+	}
+}
+
+#pragma mark - Element names
++ (OCXMLElementName)_internedName:(NSString *)name
+{
+	OCXMLElementName internedName;
+
+	os_unfair_lock_lock(&sInternLock);
+
+	if ((internedName = sInternedNames[name]) == nil)
+	{
+		internedName = [name copy];
+		sInternedNames[internedName] = internedName;
+	}
+
+	os_unfair_lock_unlock(&sInternLock);
+
+	return (internedName);
+}
+
++ (OCXMLElementName)_internedElementNameForNamespace:(nullable NSString *)namespaceURI documentPrefix:(nullable NSString *)documentPrefix localName:(NSString *)localName
+{
+	NSString *prefix = nil;
+
+	if (namespaceURI != nil)
+	{
+		if ((prefix = sCanonicalPrefixByNamespace[namespaceURI]) == nil)
+		{
+			prefix = documentPrefix;
+		}
+	}
+	else
+	{
+		// Undeclared prefix: use the name as found in the document
+		prefix = documentPrefix;
+	}
+
+	return ([self _internedName:((prefix.length > 0) ? [[prefix stringByAppendingString:@":"] stringByAppendingString:localName] : localName)]);
+}
+
++ (OCXMLElementName)internedElementNameForNamespace:(nullable NSString *)namespaceURI localName:(NSString *)localName
+{
+	return ([self _internedElementNameForNamespace:namespaceURI documentPrefix:nil localName:localName]);
+}
+
+- (void)_clearNameCache
+{
+	if (_nameCacheCount > 0)
+	{
+		for (NSUInteger i=0; i<_nameCacheCapacity; i++)
+		{
+			if (_nameCache[i].bytes != NULL)
+			{
+				free(_nameCache[i].bytes);
+			}
+		}
+
+		memset(_nameCache, 0, sizeof(OCXMLSAXNameCacheEntry) * _nameCacheCapacity);
+		_nameCacheCount = 0;
+	}
+}
+
+- (void)_insertIntoNameCache:(OCXMLSAXNameCacheEntry)entry
+{
+	NSUInteger mask = _nameCacheCapacity - 1;
+	NSUInteger index = entry.hash & mask;
+
+	while (_nameCache[index].bytes != NULL)
+	{
+		index = (index + 1) & mask;
+	}
+
+	_nameCache[index] = entry;
+	_nameCacheCount++;
+}
+
+- (NSString *)_namespaceURIForPrefix:(NSString *)prefix
+{
+	for (NSInteger i=((NSInteger)_namespacePrefixes.count)-1; i>=0; i--)
+	{
+		if ([_namespacePrefixes[i] isEqualToString:prefix])
+		{
+			return (_namespaceURIs[i]);
+		}
+	}
+
+	if ([prefix isEqualToString:@"xml"])
+	{
+		return (@"http://www.w3.org/XML/1998/namespace");
+	}
+
+	return (nil);
+}
+
+- (OCXMLElementName)_elementNameForRawName:(const uint8_t *)rawName length:(NSUInteger)length
+{
+	uint32_t hash = OCXMLHashBytes(rawName, length);
+	NSUInteger mask, index;
+
+	// Look up in cache (valid as long as no namespace declarations change)
+	if (_nameCache != NULL)
+	{
+		mask = _nameCacheCapacity - 1;
+		index = hash & mask;
+
+		while (_nameCache[index].bytes != NULL)
+		{
+			if ((_nameCache[index].hash == hash) && (_nameCache[index].length == length) && (memcmp(_nameCache[index].bytes, rawName, length) == 0))
+			{
+				return (_nameCache[index].name);
+			}
+
+			index = (index + 1) & mask;
+		}
+	}
+
+	// Resolve
+	const uint8_t *colon = memchr(rawName, ':', length);
+	NSString *documentPrefix = nil, *localName;
+
+	if (colon != NULL)
+	{
+		documentPrefix = [[NSString alloc] initWithBytes:rawName length:(colon - rawName) encoding:NSUTF8StringEncoding];
+		localName = [[NSString alloc] initWithBytes:(colon + 1) length:(length - (colon - rawName) - 1) encoding:NSUTF8StringEncoding];
+	}
+	else
+	{
+		localName = [[NSString alloc] initWithBytes:rawName length:length encoding:NSUTF8StringEncoding];
+	}
+
+	if (localName == nil) { return (nil); }
+
+	OCXMLElementName name = [OCXMLSAXParser _internedElementNameForNamespace:[self _namespaceURIForPrefix:((documentPrefix != nil) ? documentPrefix : @"")] documentPrefix:documentPrefix localName:localName];
+
+	// Add to cache (grow at 50% load)
+	if ((_nameCacheCount + 1) * 2 > _nameCacheCapacity)
+	{
+		OCXMLSAXNameCacheEntry *oldCache = _nameCache;
+		NSUInteger oldCapacity = _nameCacheCapacity;
+
+		_nameCacheCapacity = (oldCapacity == 0) ? 64 : (oldCapacity * 2);
+		_nameCache = calloc(_nameCacheCapacity, sizeof(OCXMLSAXNameCacheEntry));
+		_nameCacheCount = 0;
+
+		for (NSUInteger i=0; i<oldCapacity; i++)
+		{
+			if (oldCache[i].bytes != NULL)
+			{
+				[self _insertIntoNameCache:oldCache[i]];
+			}
+		}
+
+		if (oldCache != NULL)
+		{
+			free(oldCache);
+		}
+	}
+
+	OCXMLSAXNameCacheEntry entry = { .hash = hash, .length = (uint32_t)length, .bytes = malloc(length), .name = name };
+	memcpy(entry.bytes, rawName, length);
+
+	[self _insertIntoNameCache:entry];
+
+	return (name);
+}
+
+#pragma mark - Errors
+- (void)_failWithCode:(NSXMLParserError)code description:(NSString *)description
+{
+	if (_parserError == nil)
+	{
+		_parserError = [NSError errorWithDomain:NSXMLParserErrorDomain code:code userInfo:@{
+			NSLocalizedDescriptionKey : [NSString stringWithFormat:@"%@ (at byte %lu)", description, (unsigned long)_bytesParsed]
+		}];
+	}
+}
+
+#pragma mark - Events
+- (void)_pushElementWithRawName:(const uint8_t *)rawName length:(NSUInteger)rawNameLength attributes:(const uint8_t *)attributesBytes length:(NSUInteger)attributesLength
+{
+	NSMutableDictionary<NSString *,NSString *> *attributes = nil;
+	NSUInteger namespaceDeclarationCount = 0;
+
+	// Parse attributes
+	const uint8_t *p = attributesBytes, *end = attributesBytes + attributesLength;
+
+	while (p < end)
+	{
+		const uint8_t *attrName, *attrNameEnd, *value, *valueEnd;
+		uint8_t quote;
+
+		while ((p < end) && OCXMLIsWhitespace(*p)) { p++; }
+		if (p >= end) { break; }
+
+		attrName = p;
+		while ((p < end) && (*p != '=') && !OCXMLIsWhitespace(*p)) { p++; }
+		attrNameEnd = p;
+
+		while ((p < end) && OCXMLIsWhitespace(*p)) { p++; }
+		if ((p >= end) || (*p != '='))
+		{
+			[self _failWithCode:NSXMLParserAttributeHasNoValueError description:@"Attribute without value"];
+			return;
+		}
+		p++;
+
+		while ((p < end) && OCXMLIsWhitespace(*p)) { p++; }
+		if ((p >= end) || ((*p != '"') && (*p != '\'')))
+		{
+			[self _failWithCode:NSXMLParserAttributeNotStartedError description:@"Attribute value not quoted"];
+			return;
+		}
+		quote = *p;
+		value = ++p;
+
+		if ((valueEnd = memchr(p, quote, end - p)) == NULL)
+		{
+			[self _failWithCode:NSXMLParserAttributeNotFinishedError description:@"Attribute value not terminated"];
+			return;
+		}
+		p = valueEnd + 1;
+
+		NSString *attributeName = [[NSString alloc] initWithBytes:attrName length:(attrNameEnd - attrName) encoding:NSUTF8StringEncoding];
+		NSString *attributeValue;
+
+		if (memchr(value, '&', valueEnd - value) != NULL)
+		{
+			if (!OCXMLDecodeEntities(value, valueEnd - value, _decodeBuffer))
+			{
+				[self _failWithCode:NSXMLParserUndeclaredEntityError description:@"Unknown entity in attribute value"];
+				return;
+			}
+
+			attributeValue = [[NSString alloc] initWithData:_decodeBuffer encoding:NSUTF8StringEncoding];
+		}
+		else
+		{
+			attributeValue = [[NSString alloc] initWithBytes:value length:(valueEnd - value) encoding:NSUTF8StringEncoding];
+		}
+
+		if ((attributeName == nil) || (attributeValue == nil))
+		{
+			[self _failWithCode:NSXMLParserInvalidCharacterError description:@"Attribute is not valid UTF-8"];
+			return;
+		}
+
+		// Namespace declarations
+		if ([attributeName hasPrefix:@"xmlns"])
+		{
+			NSString *prefix = nil;
+
+			if (attributeName.length == 5)
+			{
+				prefix = @"";
+			}
+			else if ([attributeName characterAtIndex:5] == ':')
+			{
+				prefix = [attributeName substringFromIndex:6];
+			}
+
+			if (prefix != nil)
+			{
+				if (_namespacePrefixes == nil)
+				{
+					_namespacePrefixes = [NSMutableArray new];
+					_namespaceURIs = [NSMutableArray new];
+				}
+
+				[_namespacePrefixes addObject:prefix];
+				[_namespaceURIs addObject:attributeValue];
+				namespaceDeclarationCount++;
+			}
+		}
+
+		if (attributes == nil)
+		{
+			attributes = [NSMutableDictionary new];
+		}
+
+		attributes[attributeName] = attributeValue;
+	}
+
+	if (namespaceDeclarationCount > 0)
+	{
+		// Cached names may have been resolved against different declarations
+		[self _clearNameCache];
+	}
+
+	// Resolve name
+	OCXMLElementName elementName;
+
+	if ((elementName = [self _elementNameForRawName:rawName length:rawNameLength]) == nil)
+	{
+		[self _failWithCode:NSXMLParserInvalidCharacterError description:@"Element name is not valid UTF-8"];
+		return;
+	}
+
+	// Push frame
+	if (_depth == _framesCapacity)
+	{
+		_framesCapacity = (_framesCapacity == 0) ? 32 : (_framesCapacity * 2);
+		_frames = realloc(_frames, sizeof(OCXMLSAXElementFrame) * _framesCapacity);
+	}
+
+	_frames[_depth] = (OCXMLSAXElementFrame){
+		.rawNameOffset = _rawNames.length,
+		.rawNameLength = rawNameLength,
+		.name = elementName,
+		.namespaceDeclarationCount = namespaceDeclarationCount
+	};
+	_depth++;
+
+	[_rawNames appendBytes:rawName length:rawNameLength];
+
+	_sawRootElement = YES;
+
+	if (_startElementIMP != NULL)
+	{
+		_startElementIMP(_strongDelegate, @selector(saxParser:didStartElement:attributes:), self, elementName, attributes);
+	}
+}
+
+- (void)_popElementWithRawName:(const uint8_t *)rawName length:(NSUInteger)rawNameLength
+{
+	if (_depth == 0)
+	{
+		[self _failWithCode:NSXMLParserNotWellBalancedError description:@"End tag without start tag"];
+		return;
+	}
+
+	OCXMLSAXElementFrame frame = _frames[_depth-1];
+
+	if (rawName != NULL)
+	{
+		if ((frame.rawNameLength != rawNameLength) || (memcmp(((const uint8_t *)_rawNames.bytes) + frame.rawNameOffset, rawName, rawNameLength) != 0))
+		{
+			[self _failWithCode:NSXMLParserTagNameMismatchError description:@"End tag does not match start tag"];
+			return;
+		}
+	}
+
+	if (_endElementIMP != NULL)
+	{
+		_endElementIMP(_strongDelegate, @selector(saxParser:didEndElement:), self, frame.name);
+	}
+
+	_depth--;
+	_rawNames.length = frame.rawNameOffset;
+
+	if (frame.namespaceDeclarationCount > 0)
+	{
+		NSRange removeRange = NSMakeRange(_namespacePrefixes.count - frame.namespaceDeclarationCount, frame.namespaceDeclarationCount);
+
+		[_namespacePrefixes removeObjectsInRange:removeRange];
+		[_namespaceURIs removeObjectsInRange:removeRange];
+
+		[self _clearNameCache];
+	}
+}
+
+- (void)_deliverText:(const uint8_t *)bytes length:(NSUInteger)length
+{
+	if (length == 0) { return; }
+
+	if (_depth == 0)
+	{
+		// Only whitespace is allowed outside of the root element
+		for (NSUInteger i=0; i<length; i++)
+		{
+			if (!OCXMLIsWhitespace(bytes[i]))
+			{
+				[self _failWithCode:(_sawRootElement ? NSXMLParserGTRequiredError : NSXMLParserDocumentStartError) description:@"Text outside of root element"];
+				return;
+			}
+		}
+
+		return;
+	}
+
+	if (_charactersIMP == NULL) { return; }
+
+	if (memchr(bytes, '&', length) != NULL)
+	{
+		if (!OCXMLDecodeEntities(bytes, length, _decodeBuffer))
+		{
+			[self _failWithCode:NSXMLParserUndeclaredEntityError description:@"Unknown entity"];
+			return;
+		}
+
+		_charactersIMP(_strongDelegate, @selector(saxParser:foundCharacters:length:), self, _decodeBuffer.bytes, _decodeBuffer.length);
+	}
+	else
+	{
+		// Zero-copy: pass the range of the input buffer
+		_charactersIMP(_strongDelegate, @selector(saxParser:foundCharacters:length:), self, (const char *)bytes, length);
+	}
+}
+
+#pragma mark - Tokenizer
+- (NSUInteger)_parseBytes:(const uint8_t *)bytes length:(NSUInteger)length final:(BOOL)final
+{
+	const uint8_t *p = bytes, *end = bytes + length;
+
+	// Skip UTF-8 BOM
+	if ((_bytesParsed == 0) && (length >= 3) && (bytes[0] == 0xEF) && (bytes[1] == 0xBB) && (bytes[2] == 0xBF))
+	{
+		p += 3;
+		_bytesParsed += 3;
+	}
+
+	while ((p < end) && (_parserError == nil) && !_aborted)
+	{
+		const uint8_t *tokenStart = p;
+
+		if (*p != '<')
+		{
+			// Text
+			const uint8_t *textEnd;
+
+			if ((textEnd = memchr(p, '<', end - p)) == NULL)
+			{
+				if (!final) { break; } // text might continue in the next chunk
+
+				textEnd = end;
+			}
+
+			[self _deliverText:p length:(textEnd - p)];
+			p = textEnd;
+		}
+		else
+		{
+			if ((end - p) < 2) { break; }
+
+			if (p[1] == '/')
+			{
+				// End tag
+				const uint8_t *tagEnd, *nameEnd;
+
+				if ((tagEnd = memchr(p, '>', end - p)) == NULL) { break; }
+
+				nameEnd = tagEnd;
+				while ((nameEnd > (p+2)) && OCXMLIsWhitespace(nameEnd[-1])) { nameEnd--; }
+
+				[self _popElementWithRawName:(p+2) length:(nameEnd - (p+2))];
+				p = tagEnd + 1;
+			}
+			else if (p[1] == '?')
+			{
+				// Processing instruction / XML declaration
+				const uint8_t *piEnd;
+
+				if ((piEnd = OCXMLFindBytes(p+2, end, "?>", 2)) == NULL) { break; }
+
+				p = piEnd + 2;
+			}
+			else if (p[1] == '!')
+			{
+				if ((end - p) < 4) { break; }
+
+				if (memcmp(p, "<!--", 4) == 0)
+				{
+					// Comment
+					const uint8_t *commentEnd;
+
+					if ((commentEnd = OCXMLFindBytes(p+4, end, "-->", 3)) == NULL) { break; }
+
+					p = commentEnd + 3;
+				}
+				else if (p[2] == '[')
+				{
+					// CDATA section: delivered as-is
+					const uint8_t *cdataEnd;
+
+					if ((end - p) < 9) { break; }
+
+					if (memcmp(p, "<![CDATA[", 9) != 0)
+					{
+						[self _failWithCode:NSXMLParserCDATANotFinishedError description:@"Invalid CDATA section"];
+						break;
+					}
+
+					if ((cdataEnd = OCXMLFindBytes(p+9, end, "]]>", 3)) == NULL) { break; }
+
+					if ((_depth > 0) && (_charactersIMP != NULL) && (cdataEnd > (p+9)))
+					{
+						_charactersIMP(_strongDelegate, @selector(saxParser:foundCharacters:length:), self, (const char *)(p+9), cdataEnd - (p+9));
+					}
+
+					p = cdataEnd + 3;
+				}
+				else
+				{
+					// DOCTYPE: skip (incl. internal subset) - entities declared there are not supported
+					const uint8_t *q = p+2;
+					NSInteger bracketDepth = 0;
+
+					while (q < end)
+					{
+						if (*q == '[') { bracketDepth++; }
+						else if (*q == ']') { bracketDepth--; }
+						else if ((*q == '>') && (bracketDepth <= 0)) { break; }
+						q++;
+					}
+
+					if (q >= end) { break; }
+
+					p = q + 1;
+				}
+			}
+			else
+			{
+				// Start tag - find the closing '>', skipping quoted attribute values
+				const uint8_t *q = p+1, *nameEnd;
+				uint8_t quote = 0;
+				BOOL selfClosing;
+
+				while (q < end)
+				{
+					uint8_t c = *q;
+
+					if (quote != 0)
+					{
+						if (c == quote) { quote = 0; }
+					}
+					else if ((c == '"') || (c == '\''))
+					{
+						quote = c;
+					}
+					else if (c == '>')
+					{
+						break;
+					}
+
+					q++;
+				}
+
+				if (q >= end) { break; }
+
+				selfClosing = (q[-1] == '/');
+
+				nameEnd = p+1;
+				while ((nameEnd < q) && !OCXMLIsWhitespace(*nameEnd) && (*nameEnd != '/')) { nameEnd++; }
+
+				if (nameEnd == p+1)
+				{
+					[self _failWithCode:NSXMLParserNAMERequiredError description:@"Element without name"];
+					break;
+				}
+
+				if ((_depth == 0) && _sawRootElement)
+				{
+					[self _failWithCode:NSXMLParserGTRequiredError description:@"Extra content at the end of the document"];
+					break;
+				}
+
+				[self _pushElementWithRawName:(p+1) length:(nameEnd - (p+1)) attributes:nameEnd length:((selfClosing ? (q-1) : q) - nameEnd)];
+
+				if (selfClosing && (_parserError == nil) && !_aborted)
+				{
+					[self _popElementWithRawName:NULL length:0];
+				}
+
+				p = q + 1;
+			}
+		}
+
+		_bytesParsed += (p - tokenStart);
+	}
+
+	if (final && (_parserError == nil) && !_aborted)
+	{
+		if (p < end)
+		{
+			[self _failWithCode:NSXMLParserPrematureDocumentEndError description:@"Incomplete markup at the end of the document"];
+		}
+		else if (!_sawRootElement)
+		{
+			[self _failWithCode:NSXMLParserEmptyDocumentError description:@"Document is empty"];
+		}
+		else if (_depth > 0)
+		{
+			[self _failWithCode:NSXMLParserPrematureDocumentEndError description:@"Premature end of the document"];
+		}
+	}
+
+	return (p - bytes);
+}
+
+#pragma mark - Parse
+- (BOOL)parse
+{
+	_strongDelegate = _delegate;
+
+	_startElementIMP = [_strongDelegate respondsToSelector:@selector(saxParser:didStartElement:attributes:)] ? (OCXMLSAXStartElementIMP)[(NSObject *)_strongDelegate methodForSelector:@selector(saxParser:didStartElement:attributes:)] : NULL;
+	_charactersIMP = [_strongDelegate respondsToSelector:@selector(saxParser:foundCharacters:length:)] ? (OCXMLSAXCharactersIMP)[(NSObject *)_strongDelegate methodForSelector:@selector(saxParser:foundCharacters:length:)] : NULL;
+	_endElementIMP = [_strongDelegate respondsToSelector:@selector(saxParser:didEndElement:)] ? (OCXMLSAXEndElementIMP)[(NSObject *)_strongDelegate methodForSelector:@selector(saxParser:didEndElement:)] : NULL;
+
+	_rawNames = [NSMutableData new];
+	_decodeBuffer = [NSMutableData new];
+
+	_depth = 0;
+	_bytesParsed = 0;
+	_sawRootElement = NO;
+	_aborted = NO;
+	_parserError = nil;
+
+	if ((_data == nil) && (_url != nil))
+	{
+		NSError *readError = nil;
+
+		if ((_data = [NSData dataWithContentsOfURL:_url options:NSDataReadingMappedIfSafe error:&readError]) == nil)
+		{
+			_parserError = readError;
+		}
+	}
+
+	if (_data != nil)
+	{
+		@autoreleasepool {
+			[self _parseBytes:_data.bytes length:_data.length final:YES];
+		}
+	}
+	else if (_stream != nil)
+	{
+		NSMutableData *buffer = [[NSMutableData alloc] initWithCapacity:OCXMLSAXStreamChunkSize * 2];
+		BOOL openedStream = NO;
+
+		if (_stream.streamStatus == NSStreamStatusNotOpen)
+		{
+			[_stream open];
+			openedStream = YES;
+		}
+
+		while ((_parserError == nil) && !_aborted)
+		{
+			NSUInteger bufferedLength = buffer.length;
+			NSInteger readLength;
+
+			buffer.length = bufferedLength + OCXMLSAXStreamChunkSize;
+
+			readLength = [_stream read:(((uint8_t *)buffer.mutableBytes) + bufferedLength) maxLength:OCXMLSAXStreamChunkSize];
+
+			if (readLength < 0)
+			{
+				_parserError = (_stream.streamError != nil) ? _stream.streamError : [NSError errorWithDomain:NSXMLParserErrorDomain code:NSXMLParserInternalError userInfo:nil];
+				break;
+			}
+
+			buffer.length = bufferedLength + readLength;
+
+			@autoreleasepool {
+				// Parse all complete tokens, keep the rest for the next round
+				NSUInteger consumedLength = [self _parseBytes:buffer.bytes length:buffer.length final:(readLength == 0)];
+
+				if (consumedLength > 0)
+				{
+					[buffer replaceBytesInRange:NSMakeRange(0, consumedLength) withBytes:NULL length:0];
+				}
+			}
+
+			if (readLength == 0)
+			{
+				break;
+			}
+		}
+
+		if (openedStream)
+		{
+			[_stream close];
+		}
+	}
+	else
+	{
+		[self _failWithCode:NSXMLParserEmptyDocumentError description:@"No document"];
+	}
+
+	if (_aborted && (_parserError == nil))
+	{
+		_parserError = [NSError errorWithDomain:NSXMLParserErrorDomain code:NSXMLParserDelegateAbortedParseError userInfo:nil];
+	}
+
+	if ((_parserError != nil) && [_strongDelegate respondsToSelector:@selector(saxParser:parseErrorOccurred:)])
+	{
+		[_strongDelegate saxParser:self parseErrorOccurred:_parserError];
+	}
+
+	_strongDelegate = nil;
+
+	if (_url != nil)
+	{
+		// Don't keep the mapping around
+		_data = nil;
+	}
+
+	return (_parserError == nil);
+}
+
+- (void)abortParsing
+{
+	_aborted = YES;
+}
+
+@end
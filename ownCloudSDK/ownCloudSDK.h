@@ -65,6 +65,7 @@ FOUNDATION_EXPORT const unsigned char ownCloudSDKVersionString[];
 #import <ownCloudSDK/OCCoreItemList.h>
 #import <ownCloudSDK/OCCore+ItemList.h>
 #import <ownCloudSDK/OCCore+ItemUpdates.h>
+#import <ownCloudSDK/OCCore+SyncCollection.h>
 #import <ownCloudSDK/OCCore+DirectURL.h>
 #import <ownCloudSDK/OCCore+NameConflicts.h>
 #import <ownCloudSDK/OCScanJobActivity.h>
@@ -107,6 +108,7 @@ FOUNDATION_EXPORT const unsigned char ownCloudSDKVersionString[];
 #import <ownCloudSDK/OCHTTPRequest.h>
 #import <ownCloudSDK/OCHTTPRequest+JSON.h>
 #import <ownCloudSDK/OCHTTPResponse.h>
+#import <ownCloudSDK/OCHTTPResponseBodyDecoder.h>
 #import <ownCloudSDK/OCHTTPDAVRequest.h>
 
 #import <ownCloudSDK/OCHTTPCookieStorage.h>
@@ -116,6 +118,10 @@ FOUNDATION_EXPORT const unsigned char ownCloudSDKVersionString[];
 #import <ownCloudSDK/OCHTTPPipeline.h>
 #import <ownCloudSDK/OCHTTPPipelineTask.h>
 #import <ownCloudSDK/OCHTTPPipelineTaskMetrics.h>
+#import <ownCloudSDK/OCHTTPPipelineConcurrencyController.h>
+#import <ownCloudSDK/OCHTTPPipelineLatencyHistogram.h>
+#import <ownCloudSDK/OCHTTPPipelineLatencyStatistics.h>
+#import <ownCloudSDK/OCHTTPPipelineValidatorCache.h>
 #import <ownCloudSDK/OCHTTPPipelineBackend.h>
 #import <ownCloudSDK/OCHTTPPipelineTaskCache.h>
 
@@ -128,6 +134,10 @@ FOUNDATION_EXPORT const unsigned char ownCloudSDKVersionString[];
 #import <ownCloudSDK/OCHostSimulatorResponse.h>
 #import <ownCloudSDK/OCHostSimulatorManager.h>
 #import <ownCloudSDK/OCHostSimulator+BuiltIn.h>
+#import <ownCloudSDK/OCHostSimulator+Replay.h>
+#import <ownCloudSDK/OCHostSimulatorRecorder.h>
+#import <ownCloudSDK/OCHostSimulatorSyntheticTree.h>
+#import <ownCloudSDK/OCHostSimulator+SyntheticTree.h>
 #import <ownCloudSDK/OCExtension+HostSimulation.h>
 
 #import <ownCloudSDK/OCWaitCondition.h>
@@ -156,6 +166,7 @@ FOUNDATION_EXPORT const unsigned char ownCloudSDKVersionString[];
 #import <ownCloudSDK/OCQueryCondition.h>
 #import <ownCloudSDK/OCQueryCondition+Item.h>
 #import <ownCloudSDK/OCQueryChangeSet.h>
+#import <ownCloudSDK/OCWindowedQuery.h>
 
 #import <ownCloudSDK/OCItem.h>
 #import <ownCloudSDK/OCItemVersionIdentifier.h>
@@ -201,6 +212,8 @@ FOUNDATION_EXPORT const unsigned char ownCloudSDKVersionString[];
 #import <ownCloudSDK/OCXMLNode.h>
 #import <ownCloudSDK/OCXMLParser.h>
 #import <ownCloudSDK/OCXMLParserNode.h>
+#import <ownCloudSDK/OCXMLSAXParser.h>
+#import <ownCloudSDK/OCXMLParallelParser.h>
 
 #import <ownCloudSDK/OCCache.h>
 
@@ -253,6 +266,8 @@ FOUNDATION_EXPORT const unsigned char ownCloudSDKVersionString[];
 
 #import <ownCloudSDK/OCAsyncSequentialQueue.h>
 #import <ownCloudSDK/OCRateLimiter.h>
+#import <ownCloudSDK/OCTimerWheel.h>
+#import <ownCloudSDK/OCStringInternPool.h>
 #import <ownCloudSDK/OCDeallocAction.h>
 #import <ownCloudSDK/OCCancelAction.h>
 #import <ownCloudSDK/OCMeasurement.h>
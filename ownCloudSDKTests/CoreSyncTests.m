@@ -165,6 +165,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -481,6 +485,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -645,6 +653,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -791,6 +803,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -854,6 +870,10 @@
 												case OCQueryChangeSetOperationContentSwap:
 													OCLog(@"[%@] Content Swap", query.queryPath);
 												break;
+
+												case OCQueryChangeSetOperationMove:
+													OCLog(@"[%@] Moves: %@", query.queryPath, items);
+												break;
 											}
 										}];
 									}
@@ -1081,6 +1101,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -1145,6 +1169,10 @@
 												case OCQueryChangeSetOperationContentSwap:
 													OCLog(@"[%@] Content Swap", query.queryPath);
 												break;
+
+												case OCQueryChangeSetOperationMove:
+													OCLog(@"[%@] Moves: %@", query.queryPath, items);
+												break;
 											}
 										}];
 									}
@@ -1434,6 +1462,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -1596,6 +1628,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -1758,6 +1794,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -134,6 +134,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 
@@ -200,6 +204,10 @@
 											case OCQueryChangeSetOperationContentSwap:
 												OCLog(@"[%@] Content Swap", query.queryPath);
 											break;
+
+											case OCQueryChangeSetOperationMove:
+												OCLog(@"[%@] Moves: %@", query.queryPath, items);
+											break;
 										}
 									}];
 								}
@@ -325,6 +333,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -371,6 +383,10 @@
 											case OCQueryChangeSetOperationContentSwap:
 												OCLog(@"[%@] Content Swap", query.queryPath);
 											break;
+
+											case OCQueryChangeSetOperationMove:
+												OCLog(@"[%@] Moves: %@", query.queryPath, items);
+											break;
 										}
 									}];
 								}
@@ -474,6 +490,10 @@
 							case OCQueryChangeSetOperationContentSwap:
 								OCLog(@"[%@] Content Swap", query.queryPath);
 							break;
+
+							case OCQueryChangeSetOperationMove:
+								OCLog(@"[%@] Moves: %@", query.queryPath, items);
+							break;
 						}
 					}];
 				}
@@ -520,6 +540,10 @@
 											case OCQueryChangeSetOperationContentSwap:
 												OCLog(@"[%@] Content Swap", query.queryPath);
 											break;
+
+											case OCQueryChangeSetOperationMove:
+												OCLog(@"[%@] Moves: %@", query.queryPath, items);
+											break;
 										}
 									}];
 								}
@@ -45,4 +45,155 @@
 //	[self waitForExpectationsWithTimeout:90.0 handler:nil];
 }
 
+#pragma mark - Parallel parsing
+- (NSData *)_multistatusDataWithResponseCount:(NSUInteger)responseCount
+{
+	NSString *responseTemplate = @"<d:response><d:href>/remote.php/dav/files/admin/Folder/file%%20%lu.txt</d:href><d:propstat><d:prop><d:resourcetype/><d:getlastmodified>Fri, 23 Feb 2018 11:52:05 GMT</d:getlastmodified><d:getcontentlength>%lu</d:getcontentlength><d:getcontenttype>text/plain</d:getcontenttype><d:getetag>&quot;c43d4f3af69fb2d8ad1e873dadf9d973&quot;</d:getetag><oc:id>%08luocnq90xhpk22</oc:id><oc:permissions>RDNVW</oc:permissions></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>\n";
+	NSMutableData *xmlData = [NSMutableData new];
+
+	// Use a non-standard prefix for the DAV: namespace and an XML comment to exercise the framing code
+	[xmlData appendData:[@"<?xml version=\"1.0\"?>\n<!-- generated -->\n<D:multistatus xmlns:D=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">\n" dataUsingEncoding:NSUTF8StringEncoding]];
+
+	[xmlData appendData:[@"<D:response><D:href>/remote.php/dav/files/admin/Folder/</D:href><D:propstat><D:prop><D:resourcetype><D:collection/></D:resourcetype></D:prop><D:status>HTTP/1.1 200 OK</D:status></D:propstat></D:response>" dataUsingEncoding:NSUTF8StringEncoding]];
+
+	for (NSUInteger idx=0; idx<responseCount; idx++)
+	{
+		@autoreleasepool {
+			[xmlData appendData:[[[NSString stringWithFormat:responseTemplate, (unsigned long)idx, (unsigned long)idx, (unsigned long)idx] stringByReplacingOccurrencesOfString:@"d:" withString:@"D:"] dataUsingEncoding:NSUTF8StringEncoding]];
+		}
+	}
+
+	[xmlData appendData:[@"</D:multistatus>\n" dataUsingEncoding:NSUTF8StringEncoding]];
+
+	return (xmlData);
+}
+
+- (NSArray<OCItem *> *)_itemsFromParallelParser:(OCXMLParallelParser *)parser shardCount:(NSUInteger *)outShardCount
+{
+	NSMutableArray<OCItem *> *items = [NSMutableArray new];
+
+	parser.options = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+		@"/remote.php/dav/files/admin", @"basePath",
+	nil];
+
+	[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+	XCTAssert([parser parseWithShardConsumer:^BOOL(NSArray *parsedObjects, NSArray<NSError *> *errors) {
+		XCTAssert(errors.count == 0, @"Errors: %@", errors);
+		[items addObjectsFromArray:parsedObjects];
+		return (YES);
+	}]);
+
+	if (outShardCount != NULL)
+	{
+		*outShardCount = parser.shardCount;
+	}
+
+	return (items);
+}
+
+- (void)testParallelParsingOrderAndFraming
+{
+	NSUInteger responseCount = 20000, shardCount = 0;
+	NSData *xmlData = [self _multistatusDataWithResponseCount:responseCount];
+	OCXMLParallelParser *parser;
+	NSArray<OCItem *> *items;
+
+	void (^VerifyItems)(NSArray<OCItem *> *items) = ^(NSArray<OCItem *> *items) {
+		XCTAssert(items.count == responseCount + 1, @"%lu items", (unsigned long)items.count);
+		XCTAssertEqualObjects(items.firstObject.path, @"/Folder/");
+
+		for (NSUInteger idx=0; idx<responseCount; idx++)
+		{
+			if (items[idx+1].size != (NSInteger)idx)
+			{
+				XCTFail(@"Item %lu out of order: %@", (unsigned long)idx, items[idx+1].path);
+				break;
+			}
+		}
+	};
+
+	// Data, small shards
+	parser = [[OCXMLParallelParser alloc] initWithData:xmlData];
+	parser.shardSize = 64 * 1024;
+
+	items = [self _itemsFromParallelParser:parser shardCount:&shardCount];
+	XCTAssert(shardCount > 10, @"%lu shards", (unsigned long)shardCount);
+	VerifyItems(items);
+
+	// Stream, small shards, limited concurrency
+	parser = [[OCXMLParallelParser alloc] initWithStream:[NSInputStream inputStreamWithData:xmlData]];
+	parser.shardSize = 32 * 1024;
+	parser.maximumConcurrentShards = 2;
+
+	items = [self _itemsFromParallelParser:parser shardCount:&shardCount];
+	XCTAssert(shardCount > 20, @"%lu shards", (unsigned long)shardCount);
+	VerifyItems(items);
+
+	// Document without the DAV: namespace => parsed as a single shard
+	parser = [[OCXMLParallelParser alloc] initWithData:[@"<?xml version=\"1.0\"?><x:multistatus xmlns:x=\"urn:other\"><x:response/></x:multistatus>" dataUsingEncoding:NSUTF8StringEncoding]];
+	parser.shardSize = 1;
+
+	items = [self _itemsFromParallelParser:parser shardCount:&shardCount];
+	XCTAssert(shardCount == 1);
+	XCTAssert(items.count == 0);
+
+	// Truncated document => parse error surfaces
+	__block NSUInteger errorCount = 0;
+
+	parser = [[OCXMLParallelParser alloc] initWithData:[xmlData subdataWithRange:NSMakeRange(0, xmlData.length / 2)]];
+	parser.shardSize = 64 * 1024;
+	[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+	[parser parseWithShardConsumer:^BOOL(NSArray *parsedObjects, NSArray<NSError *> *errors) {
+		errorCount += errors.count;
+		return (YES);
+	}];
+
+	XCTAssert(errorCount > 0);
+
+	// Document truncated between two responses => no closing tag is made up for the last shard, error is reported
+	NSData *closingTagData = [@"</D:multistatus>\n" dataUsingEncoding:NSUTF8StringEncoding];
+
+	errorCount = 0;
+
+	parser = [[OCXMLParallelParser alloc] initWithData:[xmlData subdataWithRange:NSMakeRange(0, xmlData.length - closingTagData.length)]];
+	parser.shardSize = 64 * 1024;
+	[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+	XCTAssert(![parser parseWithShardConsumer:^BOOL(NSArray *parsedObjects, NSArray<NSError *> *errors) {
+		errorCount += errors.count;
+		return (YES);
+	}]);
+
+	XCTAssert([parser.error isOCErrorWithCode:OCErrorResponseUnknownFormat], @"error=%@", parser.error);
+	XCTAssert(errorCount > 0);
+}
+
+- (void)testParallelParsingScaling
+{
+	NSUInteger responseCount = 400000;
+	NSData *xmlData = [self _multistatusDataWithResponseCount:responseCount];
+	NSTimeInterval singleCoreDuration, multiCoreDuration, startTime;
+	OCXMLParallelParser *parser;
+	NSUInteger processorCount = NSProcessInfo.processInfo.activeProcessorCount;
+
+	// One shard at a time
+	parser = [[OCXMLParallelParser alloc] initWithData:xmlData];
+	parser.maximumConcurrentShards = 1;
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	XCTAssert([self _itemsFromParallelParser:parser shardCount:NULL].count == responseCount + 1);
+	singleCoreDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	// All cores
+	parser = [[OCXMLParallelParser alloc] initWithData:xmlData];
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	XCTAssert([self _itemsFromParallelParser:parser shardCount:NULL].count == responseCount + 1);
+	multiCoreDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	OCLog(@"Parsed %lu responses (%.1f MB): 1 shard at a time: %.0f items/s, %lu cores: %.0f items/s (speedup: %.2fx)", (unsigned long)responseCount, ((double)xmlData.length) / (1024.0 * 1024.0), responseCount / singleCoreDuration, (unsigned long)processorCount, responseCount / multiCoreDuration, singleCoreDuration / multiCoreDuration);
+}
+
 @end
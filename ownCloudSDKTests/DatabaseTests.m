@@ -405,4 +405,253 @@
 	XCTAssert((preparationCalls==2));
 }
 
+- (NSArray<OCItem *> *)_bulkLoadTestItemsWithFolderCount:(NSUInteger)folderCount filesPerFolder:(NSUInteger)filesPerFolder
+{
+	NSMutableArray<OCItem *> *items = [NSMutableArray new];
+	OCItem *rootItem = [OCItem placeholderItemOfType:OCItemTypeCollection];
+
+	rootItem.path = @"/";
+	[items addObject:rootItem];
+
+	for (NSUInteger folderIdx=0; folderIdx < folderCount; folderIdx++)
+	{
+		OCItem *folderItem = [OCItem placeholderItemOfType:OCItemTypeCollection];
+
+		folderItem.path = [NSString stringWithFormat:@"/folder%lu/", (unsigned long)folderIdx];
+		folderItem.parentLocalID = rootItem.localID;
+		[items addObject:folderItem];
+
+		for (NSUInteger fileIdx=0; fileIdx < filesPerFolder; fileIdx++)
+		{
+			OCItem *fileItem = [OCItem placeholderItemOfType:OCItemTypeFile];
+
+			fileItem.path = [folderItem.path stringByAppendingFormat:@"file%lu.txt", (unsigned long)fileIdx];
+			fileItem.parentLocalID = folderItem.localID;
+			fileItem.mimeType = @"text/plain";
+			fileItem.size = (NSInteger)fileIdx;
+			fileItem.lastModified = [NSDate dateWithTimeIntervalSince1970:1000000000 + fileIdx];
+			[items addObject:fileItem];
+		}
+	}
+
+	return (items);
+}
+
+- (void)testMetaDataBulkLoad
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	NSArray<OCItem *> *bulkItems = [self _bulkLoadTestItemsWithFolderCount:100 filesPerFolder:200];
+	NSArray<OCItem *> *regularItems = [self _bulkLoadTestItemsWithFolderCount:100 filesPerFolder:200];
+	__block NSTimeInterval bulkLoadStartTime = 0, bulkLoadDuration = 0, regularAddStartTime = 0, regularAddDuration = 0;
+
+	XCTestExpectation *bulkLoadExpectation = [self expectationWithDescription:@"Bulk load done"];
+	XCTestExpectation *indexesExpectation = [self expectationWithDescription:@"Indexes verified"];
+	XCTestExpectation *retrievalExpectation = [self expectationWithDescription:@"Items retrieved"];
+	XCTestExpectation *regularAddExpectation = [self expectationWithDescription:@"Regular add done"];
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert(error == nil);
+
+		bulkLoadStartTime = NSDate.timeIntervalSinceReferenceDate;
+
+		[database beginBulkLoadWithCompletionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssert(error == nil);
+		}];
+
+		for (NSUInteger offset=0; offset < bulkItems.count; offset += 5000)
+		{
+			[database bulkLoadCacheItems:[bulkItems subarrayWithRange:NSMakeRange(offset, MIN(5000, bulkItems.count - offset))] syncAnchor:@(0) completionHandler:^(OCDatabase *db, NSError *error) {
+				XCTAssert(error == nil);
+			}];
+		}
+
+		[database endBulkLoadWithCompletionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssert(error == nil);
+
+			bulkLoadDuration = NSDate.timeIntervalSinceReferenceDate - bulkLoadStartTime;
+
+			XCTAssert(bulkItems.firstObject.databaseID != nil);
+			XCTAssert(bulkItems.lastObject.databaseID != nil);
+
+			[bulkLoadExpectation fulfill];
+		}];
+
+		// Secondary indexes must have been rebuilt
+		[database.sqlDB executeQuery:[OCSQLiteQuery query:@"SELECT name FROM sqlite_master WHERE type='index' AND tbl_name='metaData'" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+			NSMutableSet<NSString *> *indexNames = [NSMutableSet new];
+
+			[resultSet iterateUsing:^(OCSQLiteResultSet *resultSet, NSUInteger line, OCSQLiteRowDictionary rowDictionary, BOOL *stop) {
+				[indexNames addObject:rowDictionary[@"name"]];
+			} error:NULL];
+
+			XCTAssert([indexNames isSupersetOfSet:[NSSet setWithArray:OCDatabase.metaDataSecondaryIndexNames]], @"Missing indexes: %@", indexNames);
+
+			[indexesExpectation fulfill];
+		}]];
+
+		[database retrieveCacheItemsAtPath:@"/folder42/" itemOnly:NO completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+			XCTAssert(error == nil);
+			XCTAssert(items.count == 201, @"Retrieved %lu items", (unsigned long)items.count);
+
+			for (OCItem *item in items)
+			{
+				if (item.type == OCItemTypeFile)
+				{
+					XCTAssert([item.path hasPrefix:@"/folder42/file"]);
+					XCTAssert([item.mimeType isEqual:@"text/plain"]);
+					XCTAssert(item.lastModified != nil);
+				}
+			}
+
+			[retrievalExpectation fulfill];
+
+			// Compare with regular insertion (different paths are not needed, as no uniqueness is enforced)
+			regularAddStartTime = NSDate.timeIntervalSinceReferenceDate;
+
+			[database addCacheItems:regularItems syncAnchor:@(0) completionHandler:^(OCDatabase *db, NSError *error) {
+				XCTAssert(error == nil);
+
+				regularAddDuration = NSDate.timeIntervalSinceReferenceDate - regularAddStartTime;
+
+				[regularAddExpectation fulfill];
+
+				[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+					[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+						[vaultEraseExpectation fulfill];
+					}];
+				}];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:120 handler:nil];
+
+	OCLog(@"Bulk load of %lu items: %.3f sec, regular add: %.3f sec (%.1fx)", (unsigned long)bulkItems.count, bulkLoadDuration, regularAddDuration, (regularAddDuration / MAX(bulkLoadDuration, 0.001)));
+}
+
+- (void)testFolderWindowRetrieval
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	NSArray<OCItem *> *items = [self _bulkLoadTestItemsWithFolderCount:2 filesPerFolder:1000];
+
+	XCTestExpectation *countExpectation = [self expectationWithDescription:@"Items counted"];
+	XCTestExpectation *windowExpectation = [self expectationWithDescription:@"Window retrieved"];
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert(error == nil);
+
+		[database addCacheItems:items syncAnchor:@(0) completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssert(error == nil);
+		}];
+
+		[database numberOfCacheItemsInFolder:@"/folder1/" completionHandler:^(OCDatabase *db, NSError *error, NSNumber *count) {
+			XCTAssert(error == nil);
+			XCTAssert(count.integerValue == 1000, @"Counted %@ items", count);
+
+			[countExpectation fulfill];
+		}];
+
+		// Rows are sorted by name using the localized collation (f.ex. file2.txt < file10.txt)
+		[database retrieveCacheItemsInFolder:@"/folder1/" range:NSMakeRange(100, 50) completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+			XCTAssert(error == nil);
+			XCTAssert(items.count == 50, @"Retrieved %lu items", (unsigned long)items.count);
+			XCTAssert([items.firstObject.path isEqual:@"/folder1/file100.txt"], @"First item: %@", items.firstObject.path);
+			XCTAssert([items.lastObject.path isEqual:@"/folder1/file149.txt"], @"Last item: %@", items.lastObject.path);
+
+			[windowExpectation fulfill];
+
+			[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+				[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+					[vaultEraseExpectation fulfill];
+				}];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
+
+- (void)testLocalizedCollationIndexRebuildOnLocaleChange
+{
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"test://test"]];
+	OCVault *vault = [[OCVault alloc] initWithBookmark:bookmark];
+	OCDatabase *database = vault.database;
+	NSArray<OCItem *> *items = [self _bulkLoadTestItemsWithFolderCount:1 filesPerFolder:200];
+	NSString *currentLocaleIdentifier = NSLocale.currentLocale.localeIdentifier;
+
+	XCTestExpectation *localeRecordedExpectation = [self expectationWithDescription:@"Locale recorded"];
+	XCTestExpectation *localeUpdatedExpectation = [self expectationWithDescription:@"Locale updated"];
+	XCTestExpectation *integrityExpectation = [self expectationWithDescription:@"Integrity checked"];
+	XCTestExpectation *vaultEraseExpectation = [self expectationWithDescription:@"Vault erased"];
+
+	NSString *(^RecordedLocaleIdentifier)(OCSQLiteResultSet *resultSet) = ^(OCSQLiteResultSet *resultSet) {
+		__block NSString *localeIdentifier = nil;
+
+		[resultSet iterateUsing:^(OCSQLiteResultSet *resultSet, NSUInteger line, NSDictionary<NSString *,id> *rowDictionary, BOOL *stop) {
+			localeIdentifier = rowDictionary[@"localeIdentifier"];
+		} error:NULL];
+
+		return (localeIdentifier);
+	};
+
+	[vault openWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert(error == nil);
+
+		[database addCacheItems:items syncAnchor:@(0) completionHandler:^(OCDatabase *db, NSError *error) {
+			XCTAssert(error == nil);
+		}];
+
+		// The locale the indexes were built with is recorded when opening the database
+		[database.sqlDB executeQuery:[OCSQLiteQuery query:@"SELECT localeIdentifier FROM collations WHERE name='OCLOCALIZED'" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+			XCTAssert(error == nil);
+			XCTAssert([RecordedLocaleIdentifier(resultSet) isEqual:currentLocaleIdentifier]);
+
+			[localeRecordedExpectation fulfill];
+		}]];
+
+		// Pretend the indexes were built with a different locale
+		[database.sqlDB executeQuery:[OCSQLiteQuery query:@"UPDATE collations SET localeIdentifier='xx_XX' WHERE name='OCLOCALIZED'" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+			XCTAssert(error == nil);
+
+			[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+				// Reopening must rebuild the indexes and record the current locale
+				[vault openWithCompletionHandler:^(id sender, NSError *error) {
+					XCTAssert(error == nil);
+
+					[database.sqlDB executeQuery:[OCSQLiteQuery query:@"SELECT localeIdentifier FROM collations WHERE name='OCLOCALIZED'" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+						XCTAssert(error == nil);
+						XCTAssert([RecordedLocaleIdentifier(resultSet) isEqual:currentLocaleIdentifier]);
+
+						[localeUpdatedExpectation fulfill];
+					}]];
+
+					[database.sqlDB executeQuery:[OCSQLiteQuery query:@"PRAGMA integrity_check" resultHandler:^(OCSQLiteDB *db, NSError *error, OCSQLiteTransaction *transaction, OCSQLiteResultSet *resultSet) {
+						NSDictionary<NSString *, id> *rowDictionary = [resultSet nextRowDictionaryWithError:NULL];
+
+						XCTAssert(error == nil);
+						XCTAssert([rowDictionary[@"integrity_check"] isEqual:@"ok"], @"Integrity check: %@", rowDictionary);
+
+						[integrityExpectation fulfill];
+
+						[vault closeWithCompletionHandler:^(id sender, NSError *error) {
+							[vault eraseWithCompletionHandler:^(id sender, NSError *error) {
+								[vaultEraseExpectation fulfill];
+							}];
+						}];
+					}]];
+				}];
+			}];
+		}]];
+	}];
+
+	[self waitForExpectationsWithTimeout:60 handler:nil];
+}
+
 @end
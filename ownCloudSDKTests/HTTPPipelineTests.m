@@ -607,6 +607,76 @@ typedef void(^PartitionSimulatorHandleResult)(OCHTTPRequest *request, OCHTTPResp
 	_forceDownloads = NO;
 }
 
+// - queue many non-final requests in two groups while detached
+// - cancel all requests of one group, then of the whole partition, before execution
+// - verify the cancellations were stored in bulk and quickly, then attach and verify all requests are delivered as cancelled
+- (void)testDetachedBulkCancellation
+{
+	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
+	XCTestExpectation *pipelineStoppedExpectation = [self expectationWithDescription:@"pipeline stopped"];
+	XCTestExpectation *attachCompletedExpectation = [self expectationWithDescription:@"attach completed"];
+	XCTestExpectation *requestsCompletedExpectation = [self expectationWithDescription:@"requests completed"];
+
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:[NSURLSessionConfiguration backgroundSessionConfigurationWithIdentifier:@"bgQueue"]];
+
+	PartitionSimulator *partitionHandler = [PartitionSimulator new];
+	partitionHandler.partitionID = @"partition-1";
+
+	NSUInteger groupRequestCount = 2000;
+	__block NSUInteger outstandingRequests = groupRequestCount * 2;
+
+	[pipeline startWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert(error==nil);
+
+		[pipelineStartedExpectation fulfill];
+
+		for (NSUInteger i=0; i<(groupRequestCount * 2); i++)
+		{
+			OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:@"https://demo.owncloud.org/status.php"]];
+
+			request.groupID = ((i % 2) == 0) ? @"group-a" : @"group-b";
+			request.ephermalResultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+				XCTAssert([error isOCErrorWithCode:OCErrorRequestCancelled]);
+
+				if (--outstandingRequests == 0)
+				{
+					[requestsCompletedExpectation fulfill];
+
+					[pipeline.backend queueBlock:^{
+						XCTAssert([pipeline tasksPendingDeliveryForPartitionID:partitionHandler.partitionID]==0);
+
+						[pipeline stopWithCompletionHandler:^(id sender, NSError *error) {
+							[pipelineStoppedExpectation fulfill];
+						} graceful:YES];
+					}];
+				}
+			};
+
+			[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID isFinal:NO];
+		}
+
+		[pipeline.backend queueBlock:^{
+			NSTimeInterval startTime = NSDate.timeIntervalSinceReferenceDate;
+
+			// Cancel one group
+			[pipeline cancelRequestsForPartitionID:partitionHandler.partitionID groupID:@"group-a" queuedOnly:YES];
+			XCTAssert([pipeline tasksPendingDeliveryForPartitionID:partitionHandler.partitionID]==groupRequestCount);
+
+			// Cancel the rest of the partition
+			[pipeline cancelRequestsForPartitionID:partitionHandler.partitionID queuedOnly:NO];
+			XCTAssert([pipeline tasksPendingDeliveryForPartitionID:partitionHandler.partitionID]==(groupRequestCount * 2));
+
+			OCLogDebug(@"Cancelled %lu requests in %.3f sec", (unsigned long)(groupRequestCount * 2), NSDate.timeIntervalSinceReferenceDate - startTime);
+
+			[pipeline attachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+				[attachCompletedExpectation fulfill];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:120 handler:nil];
+}
+
 // - create two partitions
 // - queue one final request for each of partitions while detached
 // - attach first partition, verify that it gets the right response and that the second request's response is not yet delivered
@@ -2375,6 +2445,806 @@ typedef void(^PartitionSimulatorHandleResult)(OCHTTPRequest *request, OCHTTPResp
 	[self waitForExpectationsWithTimeout:120 handler:nil];
 }
 
+// - enqueues five identical coalescable requests and one identical, but non-coalescable request
+// - host simulator counts round trips and responds with a delay
+// - assert checks that the coalescable requests shared a single round trip and all received the response
+- (void)testRequestCoalescing
+{
+	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
+	XCTestExpectation *pipelineStoppedExpectation = [self expectationWithDescription:@"pipeline stopped"];
+	XCTestExpectation *attachCompletedExpectation = [self expectationWithDescription:@"attach completed started"];
+	XCTestExpectation *detachCompletedExpectation = [self expectationWithDescription:@"detach completed started"];
+	XCTestExpectation *requestCompletedExpectation = [self expectationWithDescription:@"request completed started"];
+	NSUInteger coalescableRequestCount = 5;
+	NSData *simulatedBodyData = [@"coalesced" dataUsingEncoding:NSUTF8StringEncoding];
+	__block NSUInteger simulatedRoundTrips = 0;
+	__block NSUInteger completedRequests = 0;
+
+	requestCompletedExpectation.expectedFulfillmentCount = coalescableRequestCount + 1;
+
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:[NSURLSessionConfiguration backgroundSessionConfigurationWithIdentifier:@"bgQueue"]];
+
+	PartitionSimulator *partitionHandler = [PartitionSimulator new];
+	partitionHandler.partitionID = @"partition-1";
+	partitionHandler.simulateRequestHandling = ^BOOL(OCHTTPPipeline *pipeline, OCHTTPPipelinePartitionID partitionID, OCHTTPRequest *request, void (^completionHandler)(OCHTTPResponse *response)) {
+		@synchronized(simulatedBodyData)
+		{
+			simulatedRoundTrips++;
+		}
+
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.5 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+
+			response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK];
+			[response appendDataToResponseBody:simulatedBodyData];
+
+			completionHandler(response);
+		});
+
+		return (NO);
+	};
+
+	[pipeline startWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert(error==nil);
+		XCTAssert(sender==pipeline);
+
+		[pipelineStartedExpectation fulfill];
+
+		NSMutableArray<OCHTTPRequest *> *requests = [NSMutableArray new];
+		OCHTTPRequestEphermalResultHandler resultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+			OCLogDebug(@"request=%@, response=%@, error=%@", request, response, error);
+
+			XCTAssert(error==nil);
+			XCTAssert(response.status.code == OCHTTPStatusCodeOK);
+			XCTAssert([response.bodyData isEqual:simulatedBodyData]);
+			XCTAssert([response.requestID isEqual:request.identifier]);
+
+			[requestCompletedExpectation fulfill];
+
+			@synchronized(simulatedBodyData)
+			{
+				completedRequests++;
+
+				if (completedRequests == coalescableRequestCount + 1)
+				{
+					// One round trip for the coalescable requests, one for the non-coalescable request
+					XCTAssert(simulatedRoundTrips == 2, @"simulatedRoundTrips=%lu", (unsigned long)simulatedRoundTrips);
+
+					[pipeline detachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+						[detachCompletedExpectation fulfill];
+
+						[pipeline stopWithCompletionHandler:^(id sender, NSError *error) {
+							[pipelineStoppedExpectation fulfill];
+						} graceful:YES];
+					}];
+				}
+			}
+		};
+
+		for (NSUInteger i=0; i<(coalescableRequestCount + 1); i++)
+		{
+			OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:@"https://demo.owncloud.org/status.php"]];
+
+			request.coalescable = (i < coalescableRequestCount);
+			request.ephermalResultHandler = resultHandler;
+
+			[requests addObject:request];
+		}
+
+		[pipeline attachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+			for (OCHTTPRequest *request in requests)
+			{
+				[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+			}
+
+			[attachCompletedExpectation fulfill];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:120 handler:nil];
+}
+
+- (void)testAdaptiveConcurrencyController
+{
+	OCHTTPPipelineConcurrencyController *controller = [[OCHTTPPipelineConcurrencyController alloc] initWithHostname:@"demo.owncloud.org" initialLimit:4 minimumLimit:1 maximumLimit:16];
+	NSUInteger limit;
+
+	XCTAssert(controller.limit == 4);
+
+	// Flat latency, limit fully used => limit grows
+	for (NSUInteger i=0; i<100; i++)
+	{
+		[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK] error:nil latency:@(0.05) inFlight:controller.limit];
+	}
+
+	XCTAssert(controller.limit > 4, @"limit=%lu", (unsigned long)controller.limit);
+	XCTAssert(controller.limit <= 16, @"limit=%lu", (unsigned long)controller.limit);
+
+	// Flat latency, limit not used => limit stays
+	limit = controller.limit;
+
+	for (NSUInteger i=0; i<100; i++)
+	{
+		[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK] error:nil latency:@(0.05) inFlight:1];
+	}
+
+	XCTAssert(controller.limit == limit, @"limit=%lu", (unsigned long)controller.limit);
+
+	// 503 => limit backs off
+	[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeSERVICE_UNAVAILABLE] error:nil latency:@(0.05) inFlight:limit];
+
+	XCTAssert(controller.limit < limit, @"limit=%lu", (unsigned long)controller.limit);
+
+	// Repeated backoff signals within the same round trip only decrease once
+	limit = controller.limit;
+
+	[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeTOO_MANY_REQUESTS] error:nil latency:nil inFlight:limit];
+
+	XCTAssert(controller.limit == limit, @"limit=%lu", (unsigned long)controller.limit);
+
+	// Rising latency => limit backs off
+	[NSThread sleepForTimeInterval:0.2];
+
+	for (NSUInteger i=0; i<20; i++)
+	{
+		[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK] error:nil latency:@(0.5) inFlight:controller.limit];
+	}
+
+	XCTAssert(controller.limit < limit, @"limit=%lu", (unsigned long)controller.limit);
+	XCTAssert(controller.limit >= 1);
+}
+
+- (void)testAdaptiveConcurrencyControllerCategories
+{
+	OCHTTPPipelineConcurrencyController *controller = [[OCHTTPPipelineConcurrencyController alloc] initWithHostname:@"demo.owncloud.org" initialLimit:4 minimumLimit:1 maximumLimit:16];
+	NSUInteger limit;
+
+	// Fast PROPFINDs interleaved with slow thumbnail GETs - each at flat latency => limit grows rather than being pinned by the fast category
+	for (NSUInteger i=0; i<200; i++)
+	{
+		[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeMULTI_STATUS] error:nil latency:@(0.02) inFlight:controller.limit category:@"PROPFIND"];
+		[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK] error:nil latency:@(0.4) inFlight:controller.limit category:@"GET"];
+	}
+
+	XCTAssert(controller.limit > 4, @"limit=%lu", (unsigned long)controller.limit);
+	XCTAssert([[controller baselineLatencyForCategory:@"PROPFIND"] doubleValue] < 0.03);
+	XCTAssert([[controller baselineLatencyForCategory:@"GET"] doubleValue] > 0.3);
+
+	// A lasting latency increase backs off first - and then becomes the new baseline, letting the limit grow again
+	limit = controller.limit;
+
+	for (NSUInteger i=0; i<300; i++)
+	{
+		[controller recordResponseWithStatus:[OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeMULTI_STATUS] error:nil latency:@(0.2) inFlight:controller.limit category:@"PROPFIND"];
+
+		if (i == 20)
+		{
+			XCTAssert(controller.limit < limit, @"limit=%lu", (unsigned long)controller.limit);
+			limit = controller.limit;
+		}
+	}
+
+	XCTAssert([[controller baselineLatencyForCategory:@"PROPFIND"] doubleValue] > 0.1);
+	XCTAssert(controller.limit > limit, @"limit=%lu", (unsigned long)controller.limit);
+}
+
+// - simulated server with a capacity of 4 concurrent requests and 50 ms latency - additional requests queue up on the server
+// - enqueues 60 requests into a foreground pipeline with adaptive concurrency enabled
+// - logs throughput and tail latency, checks that all requests completed and the limit stayed within bounds
+- (void)testAdaptiveConcurrencyWithSimulatedServer
+{
+	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
+	XCTestExpectation *pipelineStoppedExpectation = [self expectationWithDescription:@"pipeline stopped"];
+	XCTestExpectation *requestCompletedExpectation = [self expectationWithDescription:@"request completed"];
+	NSUInteger requestCount = 60, serverCapacity = 4;
+	NSTimeInterval serverLatency = 0.05;
+	NSMutableArray<NSNumber *> *latencies = [NSMutableArray new];
+	__block NSUInteger serverInFlight = 0;
+	NSDate *startDate = [NSDate new];
+
+	requestCompletedExpectation.expectedFulfillmentCount = requestCount;
+
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:NSURLSessionConfiguration.ephemeralSessionConfiguration];
+	pipeline.adaptiveConcurrency = YES;
+
+	PartitionSimulator *partitionHandler = [PartitionSimulator new];
+	partitionHandler.partitionID = @"partition-1";
+	partitionHandler.simulateRequestHandling = ^BOOL(OCHTTPPipeline *pipeline, OCHTTPPipelinePartitionID partitionID, OCHTTPRequest *request, void (^completionHandler)(OCHTTPResponse *response)) {
+		NSTimeInterval delay;
+
+		@synchronized(latencies)
+		{
+			serverInFlight++;
+
+			// Requests exceeding the capacity have to wait for earlier requests to finish
+			delay = serverLatency * (NSTimeInterval)((serverInFlight + serverCapacity - 1) / serverCapacity);
+		}
+
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+
+			response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK];
+
+			@synchronized(latencies)
+			{
+				serverInFlight--;
+			}
+
+			completionHandler(response);
+		});
+
+		return (NO);
+	};
+
+	[pipeline startWithCompletionHandler:^(id sender, NSError *error) {
+		[pipelineStartedExpectation fulfill];
+
+		[pipeline attachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+			for (NSUInteger i=0; i<requestCount; i++)
+			{
+				OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://demo.owncloud.org/status.php?%lu", (unsigned long)i]]];
+				NSDate *enqueueDate = [NSDate new];
+
+				request.ephermalResultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+					XCTAssert(error==nil);
+
+					@synchronized(latencies)
+					{
+						[latencies addObject:@(-enqueueDate.timeIntervalSinceNow)];
+					}
+
+					[requestCompletedExpectation fulfill];
+				};
+
+				[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+			}
+		}];
+	}];
+
+	[self waitForExpectations:@[ pipelineStartedExpectation, requestCompletedExpectation ] timeout:60];
+
+	NSUInteger limit = [pipeline concurrencyControllerForHostname:@"demo.owncloud.org"].limit;
+	NSArray<NSNumber *> *sortedLatencies = [latencies sortedArrayUsingSelector:@selector(compare:)];
+	NSTimeInterval duration = -startDate.timeIntervalSinceNow;
+
+	OCLog(@"Adaptive concurrency: %lu requests in %.02f sec (%.01f req/s), p50=%.03f, p95=%.03f, final limit=%lu, controller=%@", (unsigned long)requestCount, duration, ((double)requestCount / duration), sortedLatencies[sortedLatencies.count / 2].doubleValue, sortedLatencies[(sortedLatencies.count * 95) / 100].doubleValue, (unsigned long)limit, [pipeline concurrencyControllerForHostname:@"demo.owncloud.org"]);
+
+	XCTAssert(latencies.count == requestCount);
+	XCTAssert((limit >= 1) && (limit <= 32), @"limit=%lu", (unsigned long)limit);
+
+	[pipeline detachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+		[pipeline stopWithCompletionHandler:^(id sender, NSError *error) {
+			[pipelineStoppedExpectation fulfill];
+		} graceful:YES];
+	}];
+
+	[self waitForExpectations:@[ pipelineStoppedExpectation ] timeout:60];
+}
+
+- (void)testPriorityClasses
+{
+	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
+	XCTestExpectation *pipelineStoppedExpectation = [self expectationWithDescription:@"pipeline stopped"];
+	XCTestExpectation *requestCompletedExpectation = [self expectationWithDescription:@"request completed"];
+	NSUInteger backgroundRequestCount = 30, interactiveRequestCount = 3;
+	NSMutableArray<NSNumber *> *scheduledClasses = [NSMutableArray new];
+	NSMutableArray<NSNumber *> *interactiveLatencies = [NSMutableArray new];
+
+	requestCompletedExpectation.expectedFulfillmentCount = backgroundRequestCount + interactiveRequestCount;
+
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:NSURLSessionConfiguration.ephemeralSessionConfiguration];
+	pipeline.adaptiveConcurrency = NO;
+	pipeline.maximumConcurrentRequests = 1;
+
+	PartitionSimulator *partitionHandler = [PartitionSimulator new];
+	partitionHandler.partitionID = @"partition-1";
+	partitionHandler.simulateRequestHandling = ^BOOL(OCHTTPPipeline *pipeline, OCHTTPPipelinePartitionID partitionID, OCHTTPRequest *request, void (^completionHandler)(OCHTTPResponse *response)) {
+		@synchronized(scheduledClasses)
+		{
+			[scheduledClasses addObject:@(request.priorityClass)];
+		}
+
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.02 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+
+			response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK];
+
+			completionHandler(response);
+		});
+
+		return (NO);
+	};
+
+	[pipeline startWithCompletionHandler:^(id sender, NSError *error) {
+		[pipelineStartedExpectation fulfill];
+
+		[pipeline attachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+			// Saturate the pipeline with background requests (f.ex. available offline downloads) ..
+			for (NSUInteger i=0; i<backgroundRequestCount; i++)
+			{
+				OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://demo.owncloud.org/background.php?%lu", (unsigned long)i]]];
+
+				request.priorityClass = OCHTTPRequestPriorityClassBackground;
+				request.ephermalResultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+					[requestCompletedExpectation fulfill];
+				};
+
+				[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+			}
+
+			// .. then add interactive requests (f.ex. the folder listing the user navigated to)
+			for (NSUInteger i=0; i<interactiveRequestCount; i++)
+			{
+				OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://demo.owncloud.org/interactive.php?%lu", (unsigned long)i]]];
+				NSDate *enqueueDate = [NSDate new];
+
+				request.priorityClass = OCHTTPRequestPriorityClassInteractive;
+				request.ephermalResultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+					@synchronized(scheduledClasses)
+					{
+						[interactiveLatencies addObject:@(-enqueueDate.timeIntervalSinceNow)];
+					}
+
+					[requestCompletedExpectation fulfill];
+				};
+
+				[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+			}
+		}];
+	}];
+
+	[self waitForExpectations:@[ pipelineStartedExpectation, requestCompletedExpectation ] timeout:60];
+
+	// Interactive requests must not queue up behind the background requests - only background requests already running at the time may precede them
+	NSUInteger lastInteractiveIndex = [scheduledClasses indexOfObjectWithOptions:NSEnumerationReverse passingTest:^BOOL(NSNumber *priorityClass, NSUInteger idx, BOOL *stop) {
+		return (priorityClass.integerValue == OCHTTPRequestPriorityClassInteractive);
+	}];
+
+	OCLog(@"Priority classes: scheduled=%@, last interactive request at position %lu, interactive latencies=%@", scheduledClasses, (unsigned long)lastInteractiveIndex, interactiveLatencies);
+
+	XCTAssert(scheduledClasses.count == (backgroundRequestCount + interactiveRequestCount));
+	XCTAssert(lastInteractiveIndex < (interactiveRequestCount + 5), @"lastInteractiveIndex=%lu", (unsigned long)lastInteractiveIndex);
+
+	[pipeline detachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+		[pipeline stopWithCompletionHandler:^(id sender, NSError *error) {
+			[pipelineStoppedExpectation fulfill];
+		} graceful:YES];
+	}];
+
+	[self waitForExpectations:@[ pipelineStoppedExpectation ] timeout:60];
+}
+
+- (void)testPriorityClassServiceRatio
+{
+	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
+	XCTestExpectation *pipelineStoppedExpectation = [self expectationWithDescription:@"pipeline stopped"];
+	XCTestExpectation *requestCompletedExpectation = [self expectationWithDescription:@"request completed"];
+	NSUInteger requestCountPerClass = 40, skipCount = 7, windowSize = 28;
+	NSArray<NSNumber *> *priorityClasses = @[ @(OCHTTPRequestPriorityClassUserInitiated), @(OCHTTPRequestPriorityClassUtility), @(OCHTTPRequestPriorityClassBackground) ];
+	NSMutableArray<NSNumber *> *scheduledClasses = [NSMutableArray new];
+	__block BOOL backlogComplete = NO;
+
+	requestCompletedExpectation.expectedFulfillmentCount = requestCountPerClass * priorityClasses.count;
+
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:NSURLSessionConfiguration.ephemeralSessionConfiguration];
+	pipeline.adaptiveConcurrency = NO;
+	pipeline.maximumConcurrentRequests = 1;
+	pipeline.priorityAgingInterval = 0; // Measure the plain weights, without aging
+
+	PartitionSimulator *partitionHandler = [PartitionSimulator new];
+	partitionHandler.partitionID = @"partition-1";
+	partitionHandler.simulateRequestHandling = ^BOOL(OCHTTPPipeline *pipeline, OCHTTPPipelinePartitionID partitionID, OCHTTPRequest *request, void (^completionHandler)(OCHTTPResponse *response)) {
+		@synchronized(scheduledClasses)
+		{
+			[scheduledClasses addObject:@(request.priorityClass)];
+		}
+
+		// Only complete requests once the entire backlog has been enqueued, so that every slot is filled from the mixed backlog
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.01 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+
+			response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK];
+
+			while (!backlogComplete)
+			{
+				usleep(1000);
+			}
+
+			completionHandler(response);
+		});
+
+		return (NO);
+	};
+
+	[pipeline startWithCompletionHandler:^(id sender, NSError *error) {
+		[pipelineStartedExpectation fulfill];
+
+		[pipeline attachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+			for (NSUInteger i=0; i<requestCountPerClass; i++)
+			{
+				for (NSNumber *priorityClass in priorityClasses)
+				{
+					OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://demo.owncloud.org/class-%@.php?%lu", priorityClass, (unsigned long)i]]];
+
+					request.priorityClass = priorityClass.integerValue;
+					request.ephermalResultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+						[requestCompletedExpectation fulfill];
+					};
+
+					[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+				}
+			}
+
+			backlogComplete = YES;
+		}];
+	}];
+
+	[self waitForExpectations:@[ pipelineStartedExpectation, requestCompletedExpectation ] timeout:60];
+
+	// While all classes have requests waiting, a single slot must be shared 4:2:1 between user-initiated, utility and background requests
+	NSCountedSet<NSNumber *> *windowClasses = [[NSCountedSet alloc] initWithArray:[scheduledClasses subarrayWithRange:NSMakeRange(skipCount, windowSize)]];
+	NSUInteger userInitiatedCount = [windowClasses countForObject:@(OCHTTPRequestPriorityClassUserInitiated)];
+	NSUInteger utilityCount = [windowClasses countForObject:@(OCHTTPRequestPriorityClassUtility)];
+	NSUInteger backgroundCount = [windowClasses countForObject:@(OCHTTPRequestPriorityClassBackground)];
+
+	OCLog(@"Priority class service ratio: scheduled=%@, window: userInitiated=%lu, utility=%lu, background=%lu", scheduledClasses, (unsigned long)userInitiatedCount, (unsigned long)utilityCount, (unsigned long)backgroundCount);
+
+	XCTAssert(scheduledClasses.count == (requestCountPerClass * priorityClasses.count));
+	XCTAssert((userInitiatedCount >= 14) && (userInitiatedCount <= 18), @"userInitiatedCount=%lu", (unsigned long)userInitiatedCount);
+	XCTAssert((utilityCount >= 6) && (utilityCount <= 10), @"utilityCount=%lu", (unsigned long)utilityCount);
+	XCTAssert((backgroundCount >= 2) && (backgroundCount <= 6), @"backgroundCount=%lu", (unsigned long)backgroundCount);
+
+	[pipeline detachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+		[pipeline stopWithCompletionHandler:^(id sender, NSError *error) {
+			[pipelineStoppedExpectation fulfill];
+		} graceful:YES];
+	}];
+
+	[self waitForExpectations:@[ pipelineStoppedExpectation ] timeout:60];
+}
+
+// - a single slot, occupied by a request that only completes once the backlog is enqueued
+// - backlog: a coalescable background request, ten utility requests and an identical, interactive request (which attaches to the background one)
+// - assert checks that the background request inherits the interactive class and is scheduled ahead of the utility requests
+- (void)testRequestCoalescingPriorityInheritance
+{
+	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
+	XCTestExpectation *pipelineStoppedExpectation = [self expectationWithDescription:@"pipeline stopped"];
+	XCTestExpectation *requestCompletedExpectation = [self expectationWithDescription:@"request completed"];
+	NSUInteger utilityRequestCount = 10;
+	NSURL *coalescedURL = [NSURL URLWithString:@"https://demo.owncloud.org/coalesced.php"];
+	NSMutableArray<NSURL *> *scheduledURLs = [NSMutableArray new];
+	__block NSUInteger roundTrips = 0;
+	__block BOOL backlogComplete = NO;
+
+	requestCompletedExpectation.expectedFulfillmentCount = 1 + 1 + utilityRequestCount + 1;
+
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:NSURLSessionConfiguration.ephemeralSessionConfiguration];
+	pipeline.adaptiveConcurrency = NO;
+	pipeline.maximumConcurrentRequests = 1;
+
+	PartitionSimulator *partitionHandler = [PartitionSimulator new];
+	partitionHandler.partitionID = @"partition-1";
+	partitionHandler.simulateRequestHandling = ^BOOL(OCHTTPPipeline *pipeline, OCHTTPPipelinePartitionID partitionID, OCHTTPRequest *request, void (^completionHandler)(OCHTTPResponse *response)) {
+		@synchronized(scheduledURLs)
+		{
+			[scheduledURLs addObject:request.url];
+			roundTrips++;
+		}
+
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.01 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+
+			response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK];
+
+			while (!backlogComplete)
+			{
+				usleep(1000);
+			}
+
+			completionHandler(response);
+		});
+
+		return (NO);
+	};
+
+	[pipeline startWithCompletionHandler:^(id sender, NSError *error) {
+		[pipelineStartedExpectation fulfill];
+
+		[pipeline attachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+			OCHTTPRequestEphermalResultHandler resultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+				XCTAssert(error == nil);
+				[requestCompletedExpectation fulfill];
+			};
+			OCHTTPRequest *request;
+
+			// Occupy the only slot
+			request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:@"https://demo.owncloud.org/blocker.php"]];
+			request.ephermalResultHandler = resultHandler;
+			[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+
+			// Background leader
+			request = [OCHTTPRequest requestWithURL:coalescedURL];
+			request.priorityClass = OCHTTPRequestPriorityClassBackground;
+			request.coalescable = YES;
+			request.ephermalResultHandler = resultHandler;
+			[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+
+			// Utility requests
+			for (NSUInteger i=0; i<utilityRequestCount; i++)
+			{
+				request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://demo.owncloud.org/utility.php?%lu", (unsigned long)i]]];
+				request.priorityClass = OCHTTPRequestPriorityClassUtility;
+				request.ephermalResultHandler = resultHandler;
+				[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+			}
+
+			// Interactive follower
+			request = [OCHTTPRequest requestWithURL:coalescedURL];
+			request.priorityClass = OCHTTPRequestPriorityClassInteractive;
+			request.coalescable = YES;
+			request.ephermalResultHandler = resultHandler;
+			[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+
+			backlogComplete = YES;
+		}];
+	}];
+
+	[self waitForExpectations:@[ pipelineStartedExpectation, requestCompletedExpectation ] timeout:60];
+
+	OCLog(@"Scheduled URLs: %@", scheduledURLs);
+
+	XCTAssert(roundTrips == 1 + 1 + utilityRequestCount, @"roundTrips=%lu", (unsigned long)roundTrips);
+	XCTAssert((scheduledURLs.count > 1) && [scheduledURLs[1] isEqual:coalescedURL], @"scheduledURLs=%@", scheduledURLs);
+
+	[pipeline detachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+		[pipeline stopWithCompletionHandler:^(id sender, NSError *error) {
+			[pipelineStoppedExpectation fulfill];
+		} graceful:YES];
+	}];
+
+	[self waitForExpectations:@[ pipelineStoppedExpectation ] timeout:60];
+}
+
+- (void)testLatencyHistogram
+{
+	OCHTTPPipelineLatencyHistogram *histogram = [OCHTTPPipelineLatencyHistogram new];
+
+	XCTAssert(histogram.count == 0);
+	XCTAssert([histogram valueAtPercentile:50] == 0);
+
+	// 1ms .. 1000ms
+	for (NSUInteger ms=1; ms<=1000; ms++)
+	{
+		[histogram addValue:((NSTimeInterval)ms / 1000.0)];
+	}
+
+	[histogram addValue:-1]; // Ignored
+
+	OCLog(@"Histogram: %@, JSON: %@", histogram, [histogram jsonObject]);
+
+	XCTAssert(histogram.count == 1000);
+	XCTAssert(histogram.minimum == 0.001);
+	XCTAssert(histogram.maximum == 1.0);
+	XCTAssert(fabs(histogram.mean - 0.5005) < 0.0001);
+
+	// Relative error of log-linear buckets is bounded by 1/8
+	XCTAssert(fabs([histogram valueAtPercentile:50] - 0.5) < (0.5 / 8.0), @"p50=%f", [histogram valueAtPercentile:50]);
+	XCTAssert(fabs([histogram valueAtPercentile:90] - 0.9) < (0.9 / 8.0), @"p90=%f", [histogram valueAtPercentile:90]);
+	XCTAssert(fabs([histogram valueAtPercentile:99] - 0.99) < (0.99 / 8.0), @"p99=%f", [histogram valueAtPercentile:99]);
+	XCTAssert([histogram valueAtPercentile:100] <= histogram.maximum);
+
+	// Merging
+	OCHTTPPipelineLatencyHistogram *mergedHistogram = [histogram copy];
+
+	[mergedHistogram addHistogram:histogram];
+
+	XCTAssert(mergedHistogram.count == 2000);
+	XCTAssert([mergedHistogram valueAtPercentile:50] == [histogram valueAtPercentile:50]);
+
+	// JSON
+	XCTAssert([NSJSONSerialization isValidJSONObject:[histogram jsonObject]]);
+	XCTAssert([[histogram jsonObject][@"count"] isEqual:@(1000)]);
+
+	[histogram reset];
+	XCTAssert(histogram.count == 0);
+}
+
+- (void)testLatencyStatistics
+{
+	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
+	XCTestExpectation *pipelineStoppedExpectation = [self expectationWithDescription:@"pipeline stopped"];
+	XCTestExpectation *requestCompletedExpectation = [self expectationWithDescription:@"request completed"];
+	NSUInteger requestCount = 20;
+
+	requestCompletedExpectation.expectedFulfillmentCount = requestCount;
+
+	OCHTTPPipeline *pipeline = [[OCHTTPPipeline alloc] initWithIdentifier:@"testPipeline" backend:nil configuration:NSURLSessionConfiguration.ephemeralSessionConfiguration];
+	pipeline.maximumConcurrentRequests = 2;
+
+	PartitionSimulator *partitionHandler = [PartitionSimulator new];
+	partitionHandler.partitionID = @"partition-1";
+	partitionHandler.simulateRequestHandling = ^BOOL(OCHTTPPipeline *pipeline, OCHTTPPipelinePartitionID partitionID, OCHTTPRequest *request, void (^completionHandler)(OCHTTPResponse *response)) {
+		dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.01 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+			OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+
+			response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK];
+
+			completionHandler(response);
+		});
+
+		return (NO);
+	};
+
+	[pipeline startWithCompletionHandler:^(id sender, NSError *error) {
+		[pipelineStartedExpectation fulfill];
+
+		[pipeline attachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+			for (NSUInteger i=0; i<requestCount; i++)
+			{
+				OCHTTPRequest *request;
+
+				if ((i % 2) == 0)
+				{
+					request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://demo.owncloud.org/remote.php/dav/files/admin/%lu", (unsigned long)i]]];
+				}
+				else
+				{
+					request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:[NSString stringWithFormat:@"https://demo.owncloud.org/ocs/v2.php/apps/files_sharing/api/v1/shares?%lu", (unsigned long)i]]];
+				}
+
+				request.ephermalResultHandler = ^(OCHTTPRequest *request, OCHTTPResponse *response, NSError *error) {
+					[requestCompletedExpectation fulfill];
+				};
+
+				[pipeline enqueueRequest:request forPartitionID:partitionHandler.partitionID];
+			}
+		}];
+	}];
+
+	[self waitForExpectations:@[ pipelineStartedExpectation, requestCompletedExpectation ] timeout:60];
+
+	OCHTTPPipelineLatencyStatistics *statistics = pipeline.latencyStatistics;
+
+	OCLog(@"Latency statistics: %@", [[NSString alloc] initWithData:statistics.JSONData encoding:NSUTF8StringEncoding]);
+
+	XCTAssert([statistics.categories isEqual:(@[ OCHTTPRequestCategoryGET, OCHTTPRequestCategoryOCS ])], @"categories=%@", statistics.categories);
+
+	for (OCHTTPRequestCategory category in statistics.categories)
+	{
+		XCTAssert([statistics histogramForCategory:category phase:OCHTTPRequestPhaseQueueWait].count == requestCount/2);
+		XCTAssert([statistics histogramForCategory:category phase:OCHTTPRequestPhasePostProcessing].count == requestCount/2);
+		XCTAssert([statistics histogramForCategory:category phase:OCHTTPRequestPhaseTotal].count == requestCount/2);
+
+		// Simulated requests have no URL session metrics
+		XCTAssert([statistics histogramForCategory:category phase:OCHTTPRequestPhaseTimeToFirstByte] == nil);
+
+		// With only two requests running at a time, later requests have to wait in the queue
+		XCTAssert([statistics histogramForCategory:category phase:OCHTTPRequestPhaseQueueWait].maximum > 0.01);
+	}
+
+	XCTAssert([NSJSONSerialization isValidJSONObject:statistics.jsonObject]);
+	XCTAssert(statistics.JSONData != nil);
+
+	[pipeline detachPartitionHandler:partitionHandler completionHandler:^(id sender, NSError *error) {
+		[pipeline stopWithCompletionHandler:^(id sender, NSError *error) {
+			[pipelineStoppedExpectation fulfill];
+		} graceful:YES];
+	}];
+
+	[self waitForExpectations:@[ pipelineStoppedExpectation ] timeout:60];
+}
+
+- (void)testValidatorCache
+{
+	OCHTTPPipelineValidatorCache *validatorCache = [OCHTTPPipelineValidatorCache new];
+	OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[NSURL URLWithString:@"https://demo.owncloud.org/index.php/apps/files/api/v1/thumbnail/64/64/test.jpg"]];
+	NSData *bodyData = [@"thumbnail" dataUsingEncoding:NSUTF8StringEncoding];
+	OCHTTPResponse *response;
+	NSString *key;
+
+	request.conditional = YES;
+
+	// Requests differing only in conditional header fields share a key
+	key = [OCHTTPPipelineValidatorCache keyForRequest:request partitionID:@"partition-1"];
+
+	XCTAssert(key != nil);
+	XCTAssert(![key isEqual:[OCHTTPPipelineValidatorCache keyForRequest:request partitionID:@"partition-2"]]);
+
+	// No stored response => no validators
+	[validatorCache addValidatorsToRequest:request forKey:key];
+	XCTAssert(request.headerFields[OCHTTPHeaderFieldNameIfNoneMatch] == nil);
+
+	// Successful response with validators => stored
+	response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+	response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeOK];
+	response.headerFields = @{ @"Etag" : @"\"abc\"", @"Last-Modified" : @"Sun, 18 Oct 2026 10:00:00 GMT", @"Content-Type" : @"image/jpeg" };
+	[response appendDataToResponseBody:bodyData];
+
+	[validatorCache updateWithResponse:response forKey:key];
+
+	[validatorCache addValidatorsToRequest:request forKey:key];
+	XCTAssert([request.headerFields[OCHTTPHeaderFieldNameIfNoneMatch] isEqual:@"\"abc\""]);
+	XCTAssert([request.headerFields[OCHTTPHeaderFieldNameIfModifiedSince] isEqual:@"Sun, 18 Oct 2026 10:00:00 GMT"]);
+	XCTAssert([key isEqual:[OCHTTPPipelineValidatorCache keyForRequest:request partitionID:@"partition-1"]]);
+
+	// 304 response => stored body and header fields filled in
+	response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+	response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeNOT_MODIFIED];
+	response.headerFields = @{ @"Etag" : @"\"abc\"" };
+
+	[validatorCache updateWithResponse:response forKey:key];
+
+	XCTAssert(response.notModified);
+	XCTAssert([response.bodyData isEqual:bodyData]);
+	XCTAssert([response.headerFields[@"Content-Type"] isEqual:@"image/jpeg"]);
+
+	// Error response => entry removed
+	response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+	response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeNOT_FOUND];
+
+	[validatorCache updateWithResponse:response forKey:key];
+
+	response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+	response.status = [OCHTTPStatus HTTPStatusWithCode:OCHTTPStatusCodeNOT_MODIFIED];
+
+	[validatorCache updateWithResponse:response forKey:key];
+
+	XCTAssert(!response.notModified);
+	XCTAssert(response.bodyData.length == 0);
+}
+
+- (void)testResponseBodyDecoder
+{
+	NSMutableString *expectedString = [NSMutableString stringWithString:@"<?xml version=\"1.0\"?>\n<d:multistatus xmlns:d=\"DAV:\">"];
+	NSData *gzipData = [[NSData alloc] initWithBase64EncodedString:@"H4sIAAAAAAACA+3WOwrDMBAE0N6nMDqAN2mFLBPIGdILtMYCfYxWNj5+bEiR3CDFdAM78+o105Fiv3OVUPKo7sNNTbYzXqcttiDNtU36s5JF+1E9Hy+t7HmtLGvJwldeKs+WKqfSeFiXlbzbaQ6RhZxPIZOhT+kK30soUKBAgQIFChQoUP5RoZ932HZvF2Fb/DULAAA=" options:0];
+	NSData *deflateData = [[NSData alloc] initWithBase64EncodedString:@"eJzt1jsKwzAQBNDepzA6gDdphSwTyBnSC7TGAn2MVjY+fmxIkdwgxXQDO/PqNdORYr9zlVDyqO7DTU22M16nLbYgzbVN+rOSRftRPR8vrex5rSxrycJXXirPliqn0nhYl5W822kOkYWcTyGToU/pCt9LKFCgQIECBQoUKFD+UaGfd9h2bzqVBeM=" options:0];
+	NSData *expectedData;
+	NSError *error = nil;
+
+	for (NSUInteger i=0; i<40; i++)
+	{
+		[expectedString appendString:@"<d:response><d:href>/remote.php/dav/files/admin/</d:href></d:response>"];
+	}
+	[expectedString appendString:@"</d:multistatus>\n"];
+
+	expectedData = [expectedString dataUsingEncoding:NSUTF8StringEncoding];
+
+	XCTAssert([OCHTTPResponseBodyDecoder.supportedContentEncodings containsObject:@"gzip"]);
+	XCTAssert([OCHTTPResponseBodyDecoder decoderForContentEncoding:@"identity"] == nil);
+	XCTAssert([OCHTTPResponseBodyDecoder decoderForContentEncoding:@"compress"] == nil);
+
+	// Complete bodies
+	XCTAssert([[OCHTTPResponseBodyDecoder decodeData:gzipData withContentEncoding:@"gzip" error:&error] isEqual:expectedData], @"error=%@", error);
+	XCTAssert([[OCHTTPResponseBodyDecoder decodeData:deflateData withContentEncoding:@"deflate" error:&error] isEqual:expectedData], @"error=%@", error);
+
+	// Streaming in small chunks (also splitting the gzip header)
+	OCHTTPResponseBodyDecoder *decoder = [OCHTTPResponseBodyDecoder decoderForContentEncoding:@"GZIP"];
+	NSMutableData *decodedData = [NSMutableData new];
+
+	for (NSUInteger offset=0; offset < gzipData.length; offset += 7)
+	{
+		NSData *decodedChunk = [decoder decodeData:[gzipData subdataWithRange:NSMakeRange(offset, MIN(7, gzipData.length - offset))] error:&error];
+
+		XCTAssert(decodedChunk != nil, @"error=%@", error);
+		[decodedData appendData:decodedChunk];
+	}
+
+	[decodedData appendData:[decoder finishWithError:&error]];
+
+	XCTAssert([decodedData isEqual:expectedData]);
+	XCTAssert(decoder.encodedByteCount == gzipData.length);
+	XCTAssert(decoder.decodedByteCount == expectedData.length);
+
+	// Truncated and invalid bodies
+	XCTAssert([OCHTTPResponseBodyDecoder decodeData:[gzipData subdataWithRange:NSMakeRange(0, gzipData.length / 2)] withContentEncoding:@"gzip" error:&error] == nil);
+	XCTAssert(error != nil);
+
+	error = nil;
+	XCTAssert([OCHTTPResponseBodyDecoder decodeData:expectedData withContentEncoding:@"gzip" error:&error] == nil);
+	XCTAssert(error != nil);
+}
+
 - (void)testProgress
 {
 	XCTestExpectation *pipelineStartedExpectation = [self expectationWithDescription:@"pipeline started"];
@@ -12,7 +12,7 @@
 #import <ownCloudMocking/ownCloudMocking.h>
 #import "OCTestTarget.h"
 
-@interface HostSimulatorTests : XCTestCase
+@interface HostSimulatorTests : XCTestCase <OCClassSettingsSource>
 {
 	OCHostSimulator *hostSimulator;
 }
@@ -35,6 +35,23 @@
 	[super tearDown];
 }
 
+- (OCClassSettingsSourceIdentifier)settingsSourceIdentifier
+{
+	return (@"host-simulator-tests");
+}
+
+- (NSDictionary<OCClassSettingsKey, id> *)settingsForIdentifier:(OCClassSettingsIdentifier)identifier
+{
+	if ([identifier isEqual:[OCCore classSettingsIdentifier]])
+	{
+		return (@{
+			OCCoreSyncCollectionEnabled : @(YES)
+		});
+	}
+
+	return (nil);
+}
+
 - (void)_runPreparationTestsForURL:(NSURL *)url completionHandler:(void(^)(NSURL *url, OCBookmark *bookmark, OCIssue *issue, NSArray <OCAuthenticationMethodIdentifier> *supportedMethods, NSArray <OCAuthenticationMethodIdentifier> *preferredAuthenticationMethods))completionHandler
 {
 	XCTestExpectation *expectAnswer = [self expectationWithDescription:@"Received reply"];
@@ -134,5 +151,558 @@
 	}];
 }
 
-@end
 
+- (void)testRecordingAndReplay
+{
+	NSURL *archiveURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:NSUUID.UUID.UUIDString isDirectory:YES];
+	NSURL *baseURL = [NSURL URLWithString:@"https://demo.owncloud.org/remote.php/dav/files/admin/"];
+	OCHostSimulatorRecorder *recorder = [[OCHostSimulatorRecorder alloc] initWithArchiveURL:archiveURL];
+	OCHTTPResponse *(^MakeResponse)(OCHTTPRequest *request, OCHTTPStatusCode statusCode, NSString *body) = ^(OCHTTPRequest *request, OCHTTPStatusCode statusCode, NSString *body) {
+		OCHTTPResponse *response = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+
+		response.httpURLResponse = [[NSHTTPURLResponse alloc] initWithURL:request.url statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:@{
+			@"Content-Type" : @"text/plain",
+			@"Set-Cookie" : @"session=secret"
+		}];
+		response.bodyData = [body dataUsingEncoding:NSUTF8StringEncoding];
+
+		return (response);
+	};
+
+	// Record: the same GET twice (with different responses), a PROPFIND and a failed request
+	for (NSUInteger i=1; i<=2; i++)
+	{
+		OCHTTPRequest *request = [OCHTTPRequest requestWithURL:[baseURL URLByAppendingPathComponent:@"file.txt"]];
+
+		[request setValue:@"Basic secret" forHeaderField:OCHTTPHeaderFieldNameAuthorization];
+		request.scheduleDate = [NSDate dateWithTimeIntervalSinceNow:-0.2];
+
+		[recorder recordRequest:request response:MakeResponse(request, OCHTTPStatusCodeOK, [NSString stringWithFormat:@"version %lu", (unsigned long)i]) metrics:nil];
+	}
+
+	OCHTTPRequest *propfindRequest = [OCHTTPRequest requestWithURL:baseURL];
+	propfindRequest.method = OCHTTPMethodPROPFIND;
+	[propfindRequest setValue:@"1" forHeaderField:OCHTTPHeaderFieldNameDepth];
+	[recorder recordRequest:propfindRequest response:MakeResponse(propfindRequest, OCHTTPStatusCodeMULTI_STATUS, @"<d:multistatus xmlns:d=\"DAV:\"/>") metrics:nil];
+
+	OCHTTPRequest *failedRequest = [OCHTTPRequest requestWithURL:[baseURL URLByAppendingPathComponent:@"timeout.txt"]];
+	[recorder recordRequest:failedRequest response:[OCHTTPResponse responseWithRequest:failedRequest HTTPError:[NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorTimedOut userInfo:nil]] metrics:nil];
+
+	XCTAssert(recorder.entryCount == 4);
+	XCTAssert([recorder writeArchive] == nil);
+
+	// Archive
+	NSError *error = nil;
+	NSArray<OCHostSimulatorRecordingEntry> *entries = [OCHostSimulatorRecorder entriesFromArchiveAtURL:archiveURL error:&error];
+
+	XCTAssert(error == nil);
+	XCTAssert(entries.count == 4);
+	XCTAssert(entries[0][OCHostSimulatorRecordingKeyRequestHeaders][OCHTTPHeaderFieldNameAuthorization] == nil, @"Credentials must not be recorded");
+	XCTAssert(entries[0][OCHostSimulatorRecordingKeyResponseHeaders][@"Set-Cookie"] == nil, @"Cookies must not be recorded");
+	XCTAssert([entries[0][OCHostSimulatorRecordingKeyDuration] doubleValue] >= 0.2);
+
+	// Replay
+	OCHostSimulator *replaySimulator = [OCHostSimulator replaySimulatorForArchiveAtURL:archiveURL timeScale:0.5 error:&error];
+	OCConnection *connection = [[OCConnection alloc] initWithBookmark:[OCBookmark bookmarkForURL:OCTestTarget.secureTargetURL]];
+	OCHostSimulatorResponse *(^Replay)(OCHTTPRequest *request, NSError **outError) = ^(OCHTTPRequest *request, NSError **outError) {
+		XCTestExpectation *responseExpectation = [self expectationWithDescription:@"response"];
+		__block OCHostSimulatorResponse *replayedResponse = nil;
+		__block NSError *replayedError = nil;
+
+		BOOL handled = replaySimulator.requestHandler(connection, request, ^(NSError *error, OCHostSimulatorResponse *response) {
+			replayedResponse = response;
+			replayedError = error;
+			[responseExpectation fulfill];
+		});
+
+		if (handled)
+		{
+			[self waitForExpectations:@[ responseExpectation ] timeout:10];
+		}
+		else
+		{
+			[responseExpectation fulfill];
+		}
+
+		if (outError != NULL) { *outError = replayedError; }
+
+		return (replayedResponse);
+	};
+
+	XCTAssert(replaySimulator != nil);
+	XCTAssert(error == nil);
+
+	// Identical requests receive the recorded responses in order, the last one repeated - with the recorded duration scaled by 0.5
+	NSDate *replayStartDate = [NSDate new];
+	OCHTTPRequest *getRequest = [OCHTTPRequest requestWithURL:[baseURL URLByAppendingPathComponent:@"file.txt"]];
+
+	XCTAssert([[[NSString alloc] initWithData:Replay(getRequest, NULL).bodyData encoding:NSUTF8StringEncoding] isEqual:@"version 1"]);
+	XCTAssert(-replayStartDate.timeIntervalSinceNow >= 0.09);
+
+	XCTAssert([[[NSString alloc] initWithData:Replay(getRequest, NULL).bodyData encoding:NSUTF8StringEncoding] isEqual:@"version 2"]);
+	XCTAssert([[[NSString alloc] initWithData:Replay(getRequest, NULL).bodyData encoding:NSUTF8StringEncoding] isEqual:@"version 2"]);
+
+	// Requests are matched incl. Depth
+	OCHTTPRequest *replayPropfindRequest = [OCHTTPRequest requestWithURL:baseURL];
+	replayPropfindRequest.method = OCHTTPMethodPROPFIND;
+	[replayPropfindRequest setValue:@"1" forHeaderField:OCHTTPHeaderFieldNameDepth];
+
+	XCTAssert(Replay(replayPropfindRequest, NULL).statusCode == OCHTTPStatusCodeMULTI_STATUS);
+
+	[replayPropfindRequest setValue:@"0" forHeaderField:OCHTTPHeaderFieldNameDepth];
+	XCTAssert(Replay(replayPropfindRequest, NULL) == nil);
+
+	// Errors are replayed
+	NSError *replayedError = nil;
+
+	XCTAssert(Replay([OCHTTPRequest requestWithURL:[baseURL URLByAppendingPathComponent:@"timeout.txt"]], &replayedError) == nil);
+	XCTAssert([replayedError.domain isEqual:NSURLErrorDomain] && (replayedError.code == NSURLErrorTimedOut));
+
+	[NSFileManager.defaultManager removeItemAtURL:archiveURL error:NULL];
+}
+
+- (void)testSyntheticTree
+{
+	// 11.1 million items, generated on demand
+	OCHostSimulatorSyntheticTree *tree = [[OCHostSimulatorSyntheticTree alloc] initWithSeed:42 depth:5 folderFanOut:10 filesPerFolder:100];
+	OCHostSimulatorSyntheticTree *sameSeedTree = [[OCHostSimulatorSyntheticTree alloc] initWithSeed:42 depth:5 folderFanOut:10 filesPerFolder:100];
+
+	XCTAssert(tree.generatedItemCount == 111111 * 101);
+
+	OCHostSimulatorSyntheticTreeItem *deepItem = [tree itemAtPath:@"/Folder 3/Folder 10/Folder 1/Folder 7/Folder 2/File 99.txt"];
+
+	XCTAssert(deepItem != nil);
+	XCTAssert(!deepItem.isFolder);
+	XCTAssert(deepItem.size <= tree.maximumFileSize);
+	XCTAssert([tree contentsOfFileAtPath:deepItem.path].length == deepItem.size);
+	XCTAssert([tree itemAtPath:@"/Folder 3/Folder 10/Folder 1/Folder 7/Folder 2/Folder 1/"] == nil, @"No folders beyond depth");
+	XCTAssert([tree itemAtPath:@"/Folder 11/"] == nil);
+	XCTAssert([tree itemAtPath:@"/File 01.txt"] == nil);
+	XCTAssert([tree childrenOfFolderAtPath:@"/Folder 1"].count == 110);
+
+	// Stable across instances
+	XCTAssert([[sameSeedTree itemAtPath:deepItem.path].eTag isEqual:deepItem.eTag]);
+	XCTAssert([[sameSeedTree itemAtPath:deepItem.path].fileID isEqual:deepItem.fileID]);
+	XCTAssert([[sameSeedTree sha1ChecksumOfFileAtPath:deepItem.path] isEqual:[tree sha1ChecksumOfFileAtPath:deepItem.path]]);
+
+	// Mutations change the ETags of the item and its parents, but not of siblings
+	OCFileETag rootETag = [tree itemAtPath:@"/"].eTag;
+	OCFileETag siblingETag = [tree itemAtPath:@"/Folder 2/"].eTag;
+
+	XCTAssert([tree writeFileAtPath:@"/Folder 1/File 1.txt" contents:[@"Hello" dataUsingEncoding:NSUTF8StringEncoding]] != nil);
+	XCTAssert([tree itemAtPath:@"/Folder 1/File 1.txt"].size == 5);
+	XCTAssert(![[tree itemAtPath:@"/"].eTag isEqual:rootETag]);
+	XCTAssert([[tree itemAtPath:@"/Folder 2/"].eTag isEqual:siblingETag]);
+
+	XCTAssert([tree removeItemAtPath:@"/Folder 2/"]);
+	XCTAssert([tree itemAtPath:@"/Folder 2/File 1.txt"] == nil);
+	XCTAssert([tree createFolderAtPath:@"/Folder 2"] != nil);
+	XCTAssert([tree childrenOfFolderAtPath:@"/Folder 2/"].count == 0, @"Re-created folder must be empty");
+
+	// Mutation scripts are deterministic
+	NSArray<NSString *> *mutations = [sameSeedTree applyMutationScriptWithSeed:7 count:20];
+	OCHostSimulatorSyntheticTree *thirdTree = [[OCHostSimulatorSyntheticTree alloc] initWithSeed:42 depth:5 folderFanOut:10 filesPerFolder:100];
+
+	XCTAssert(mutations.count > 0);
+	XCTAssert([[thirdTree applyMutationScriptWithSeed:7 count:20] isEqual:mutations]);
+	XCTAssert([[thirdTree itemAtPath:@"/"].eTag isEqual:[sameSeedTree itemAtPath:@"/"].eTag]);
+
+	// HTTP
+	OCHostSimulator *simulator = [OCHostSimulator syntheticTreeSimulatorWithTree:tree userName:nil];
+	OCConnection *connection = [[OCConnection alloc] initWithBookmark:[OCBookmark bookmarkForURL:OCTestTarget.secureTargetURL]];
+	NSURL *davURL = [NSURL URLWithString:@"https://demo.owncloud.org/remote.php/dav/files/admin/"];
+	OCHostSimulatorResponse *(^Send)(OCHTTPRequest *request) = ^(OCHTTPRequest *request) {
+		__block OCHostSimulatorResponse *simulatorResponse = nil;
+
+		simulator.requestHandler(connection, request, ^(NSError *error, OCHostSimulatorResponse *response) {
+			simulatorResponse = response;
+		});
+
+		return (simulatorResponse);
+	};
+
+	// PROPFIND
+	OCHTTPRequest *propfindRequest = [OCHTTPRequest requestWithURL:[davURL URLByAppendingPathComponent:@"Folder 3/"]];
+	propfindRequest.method = OCHTTPMethodPROPFIND;
+	[propfindRequest setValue:@"1" forHeaderField:OCHTTPHeaderFieldNameDepth];
+
+	OCHostSimulatorResponse *propfindResponse = Send(propfindRequest);
+	NSString *propfindXML = [[NSString alloc] initWithData:propfindResponse.bodyData encoding:NSUTF8StringEncoding];
+
+	XCTAssert(propfindResponse.statusCode == OCHTTPStatusCodeMULTI_STATUS);
+	XCTAssert([propfindXML componentsSeparatedByString:@"<d:response>"].count == 112);
+	XCTAssert([propfindXML containsString:@"<d:href>/remote.php/dav/files/admin/Folder%203/File%201.txt</d:href>"]);
+
+	// PROPFIND Depth: infinity (unlimited by default, rejected above .maximumInfinityItemCount)
+	OCHTTPRequest *infinityRequest = [OCHTTPRequest requestWithURL:[davURL URLByAppendingPathComponent:@"Folder 3/Folder 10/Folder 1/Folder 7/"]];
+	infinityRequest.method = OCHTTPMethodPROPFIND;
+	infinityRequest.downloadRequest = YES;
+	[infinityRequest setValue:@"infinity" forHeaderField:OCHTTPHeaderFieldNameDepth];
+
+	OCHostSimulatorResponse *infinityResponse = Send(infinityRequest);
+	NSString *infinityXML = [[NSString alloc] initWithData:infinityResponse.bodyData encoding:NSUTF8StringEncoding];
+
+	XCTAssert(infinityResponse.statusCode == OCHTTPStatusCodeMULTI_STATUS);
+	XCTAssert(infinityResponse.bodyURL != nil, @"Body streamed to a file");
+	XCTAssert([infinityResponse.httpHeaders[OCHTTPHeaderFieldNameContentLength] integerValue] == (NSInteger)infinityResponse.bodyData.length);
+	XCTAssert([infinityXML componentsSeparatedByString:@"<d:response>"].count == 1112);
+	XCTAssert([infinityXML hasSuffix:@"</d:multistatus>\n"]);
+	[NSFileManager.defaultManager removeItemAtURL:infinityResponse.bodyURL error:NULL];
+
+	tree.maximumInfinityItemCount = 1000;
+	XCTAssert(Send(infinityRequest).statusCode == OCHTTPStatusCodeFORBIDDEN);
+
+	[propfindRequest setValue:@"infinity" forHeaderField:OCHTTPHeaderFieldNameDepth];
+	XCTAssert(Send(propfindRequest).statusCode == OCHTTPStatusCodeFORBIDDEN);
+	tree.maximumInfinityItemCount = 0;
+
+	// GET with Range
+	OCHTTPRequest *getRequest = [OCHTTPRequest requestWithURL:[davURL URLByAppendingPathComponent:@"Folder 1/File 1.txt"]];
+	[getRequest setValue:@"bytes=1-3" forHeaderField:@"Range"];
+
+	OCHostSimulatorResponse *getResponse = Send(getRequest);
+	XCTAssert(getResponse.statusCode == OCHTTPStatusCodePARTIAL_CONTENT);
+	XCTAssert([[[NSString alloc] initWithData:getResponse.bodyData encoding:NSUTF8StringEncoding] isEqual:@"ell"]);
+
+	[getRequest setValue:@"bytes=10-" forHeaderField:@"Range"];
+	XCTAssert(Send(getRequest).statusCode == OCHTTPStatusCodeRANGE_NOT_SATISFIABLE);
+
+	// PUT
+	OCHTTPRequest *putRequest = [OCHTTPRequest requestWithURL:[davURL URLByAppendingPathComponent:@"Folder 1/New.txt"]];
+	putRequest.method = OCHTTPMethodPUT;
+	putRequest.bodyData = [@"New" dataUsingEncoding:NSUTF8StringEncoding];
+
+	XCTAssert(Send(putRequest).statusCode == OCHTTPStatusCodeCREATED);
+	XCTAssert([tree itemAtPath:@"/Folder 1/New.txt"].size == 3);
+
+	[putRequest setValue:@"\"mismatch\"" forHeaderField:OCHTTPHeaderFieldNameIfMatch];
+	XCTAssert(Send(putRequest).statusCode == OCHTTPStatusCodePRECONDITION_FAILED);
+
+	// TUS: creation with partial upload, then PATCH
+	OCTUSHeader *tusHeader = [OCTUSHeader new];
+	tusHeader.version = @"1.0.0";
+	tusHeader.uploadLength = @(6);
+	tusHeader.uploadMetadata = @{ OCTUSMetadataKeyFileName : @"TUS.txt" };
+
+	OCHTTPRequest *creationRequest = [OCHTTPRequest requestWithURL:[davURL URLByAppendingPathComponent:@"Folder 4/"]];
+	creationRequest.method = OCHTTPMethodPOST;
+	[creationRequest addHeaderFields:tusHeader.httpHeaderFields];
+	creationRequest.bodyData = [@"abc" dataUsingEncoding:NSUTF8StringEncoding];
+
+	OCHostSimulatorResponse *creationResponse = Send(creationRequest);
+	NSString *location = creationResponse.httpHeaders[OCHTTPHeaderFieldNameLocation];
+
+	XCTAssert(creationResponse.statusCode == OCHTTPStatusCodeCREATED);
+	XCTAssert([creationResponse.httpHeaders[OCTUSHeaderNameUploadOffset] isEqual:@"3"]);
+	XCTAssert(location != nil);
+
+	OCHTTPRequest *patchRequest = [OCHTTPRequest requestWithURL:[NSURL URLWithString:location]];
+	patchRequest.method = OCHTTPMethodPATCH;
+	[patchRequest setValue:@"3" forHeaderField:OCTUSHeaderNameUploadOffset];
+	patchRequest.bodyData = [@"def" dataUsingEncoding:NSUTF8StringEncoding];
+
+	XCTAssert(Send(patchRequest).statusCode == OCHTTPStatusCodeNO_CONTENT);
+	XCTAssert([[tree contentsOfFileAtPath:@"/Folder 4/TUS.txt"] isEqual:[@"abcdef" dataUsingEncoding:NSUTF8StringEncoding]]);
+	XCTAssert(Send(patchRequest).statusCode == OCHTTPStatusCodeCONFLICT, @"Offset mismatch");
+
+	// Change log
+	NSString *syncToken = tree.syncToken, *nextSyncToken = nil;
+	OCFileID movedFileID = [tree itemAtPath:@"/Folder 1/New.txt"].fileID;
+	BOOL truncated = NO;
+
+	XCTAssert([[tree moveFileAtPath:@"/Folder 1/New.txt" toPath:@"/Folder 5/Moved.txt"].fileID isEqual:movedFileID]);
+	XCTAssert([tree itemAtPath:@"/Folder 1/New.txt"] == nil);
+	XCTAssert([[tree contentsOfFileAtPath:@"/Folder 5/Moved.txt"] isEqual:[@"New" dataUsingEncoding:NSUTF8StringEncoding]]);
+	XCTAssert([tree moveFileAtPath:@"/Folder 5/" toPath:@"/Folder 6/Folder 5/"] == nil, @"Folders can't be moved");
+
+	NSArray<OCPath> *changedPaths = [tree changedPathsSinceSyncToken:syncToken limit:0 nextSyncToken:&nextSyncToken truncated:&truncated];
+
+	XCTAssert([changedPaths isEqual:(@[ @"/Folder 1/New.txt", @"/Folder 1/", @"/Folder 5/Moved.txt", @"/Folder 5/", @"/" ])], @"changedPaths: %@", changedPaths);
+	XCTAssert([nextSyncToken isEqual:tree.syncToken]);
+	XCTAssert(!truncated);
+	XCTAssert([tree changedPathsSinceSyncToken:tree.syncToken limit:0 nextSyncToken:&nextSyncToken truncated:&truncated].count == 0);
+	XCTAssert([tree changedPathsSinceSyncToken:@"http://sabre.io/ns/sync/999999999" limit:0 nextSyncToken:&nextSyncToken truncated:&truncated] == nil);
+
+	// PROPFIND of DAV:sync-token
+	OCHTTPDAVRequest *syncTokenRequest = [OCHTTPDAVRequest propfindRequestWithURL:davURL depth:0];
+	[syncTokenRequest.xmlRequestPropAttribute addChildren:@[ [OCXMLNode elementWithName:@"D:sync-token"] ]];
+
+	NSString *syncTokenXML = [[NSString alloc] initWithData:Send(syncTokenRequest).bodyData encoding:NSUTF8StringEncoding];
+	XCTAssert([syncTokenXML containsString:[NSString stringWithFormat:@"<d:sync-token>%@</d:sync-token>", tree.syncToken]]);
+
+	// sync-collection REPORT, paged
+	OCHTTPDAVRequest *(^SyncCollection)(NSString *syncToken) = ^(NSString *syncToken) {
+		OCHTTPDAVRequest *reportRequest = [OCHTTPDAVRequest syncCollectionRequestWithURL:davURL syncToken:syncToken limit:2 properties:@[ [OCXMLNode elementWithName:@"D:getetag"] ]];
+		OCHostSimulatorResponse *reportResponse = Send(reportRequest);
+
+		reportRequest.httpResponse = [OCHTTPResponse responseWithRequest:reportRequest HTTPError:nil];
+		reportRequest.httpResponse.status = [OCHTTPStatus HTTPStatusWithCode:reportResponse.statusCode];
+		reportRequest.httpResponse.bodyData = reportResponse.bodyData;
+
+		return (reportRequest);
+	};
+
+	OCHTTPDAVRequest *reportRequest = SyncCollection(syncToken);
+	NSArray<OCItem *> *reportItems = [reportRequest syncCollectionResponseItemsForBasePath:@"/remote.php/dav/files/admin" reuseUsersByID:[NSMutableDictionary new] syncToken:&nextSyncToken truncated:&truncated withErrors:NULL];
+
+	XCTAssert(reportRequest.httpResponse.status.code == OCHTTPStatusCodeMULTI_STATUS);
+	XCTAssert(reportItems.count == 2);
+	XCTAssert([reportItems[0].path isEqual:@"/Folder 1/New.txt"] && reportItems[0].removed);
+	XCTAssert([reportItems[1].path isEqual:@"/Folder 1/"] && !reportItems[1].removed);
+	XCTAssert(truncated);
+
+	reportRequest = SyncCollection(nextSyncToken);
+	reportItems = [reportRequest syncCollectionResponseItemsForBasePath:@"/remote.php/dav/files/admin" reuseUsersByID:[NSMutableDictionary new] syncToken:&nextSyncToken truncated:&truncated withErrors:NULL];
+
+	XCTAssert(reportItems.count == 2);
+	XCTAssert([reportItems[0].path isEqual:@"/Folder 5/Moved.txt"] && [reportItems[0].fileID isEqual:movedFileID]);
+	XCTAssert(truncated);
+
+	reportRequest = SyncCollection(nextSyncToken);
+	reportItems = [reportRequest syncCollectionResponseItemsForBasePath:@"/remote.php/dav/files/admin" reuseUsersByID:[NSMutableDictionary new] syncToken:&nextSyncToken truncated:&truncated withErrors:NULL];
+
+	XCTAssert(reportItems.count == 1);
+	XCTAssert([reportItems[0].path isEqual:@"/"]);
+	XCTAssert(!truncated);
+	XCTAssert([nextSyncToken isEqual:tree.syncToken]);
+
+	// Unknown tokens are rejected via the DAV:valid-sync-token precondition
+	reportRequest = SyncCollection(@"http://sabre.io/ns/sync/999999999");
+	XCTAssert(reportRequest.httpResponse.status.code == OCHTTPStatusCodeFORBIDDEN);
+	XCTAssert([[[NSString alloc] initWithData:reportRequest.httpResponse.bodyData encoding:NSUTF8StringEncoding] containsString:@"<d:valid-sync-token/>"]);
+}
+
+- (void)testSyntheticTreeFullScanWithLatency
+{
+	// Full tree refresh against a synthetic server answering with a round trip time of 100 ms. The duration is logged, so it can be compared across changes to the scan scheduler.
+	OCHostSimulatorSyntheticTree *tree = [[OCHostSimulatorSyntheticTree alloc] initWithSeed:42 depth:3 folderFanOut:4 filesPerFolder:10];
+	OCHostSimulator *simulator = [OCHostSimulator syntheticTreeSimulatorWithTree:tree userName:nil];
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"http://synthetic.owncloud.test/"]];
+	XCTestExpectation *coreStoppedExpectation = [self expectationWithDescription:@"Core stopped"];
+	__block NSTimeInterval scanStartTime = 0;
+	OCCore *core;
+
+	simulator.responseDelay = 0.1;
+
+	bookmark.authenticationData = [OCAuthenticationMethodBasicAuth authenticationDataForUsername:@"admin" passphrase:@"admin" authenticationHeaderValue:NULL error:NULL];
+	bookmark.authenticationMethodIdentifier = OCAuthenticationMethodIdentifierBasicAuth;
+
+	core = [[OCCore alloc] initWithBookmark:bookmark];
+	core.automaticItemListUpdatesEnabled = NO;
+	core.connection.hostSimulator = simulator;
+
+	[core startWithCompletionHandler:^(OCCore *core, NSError *error) {
+		XCTAssert(error == nil, @"Started with error: %@", error);
+
+		scanStartTime = NSDate.timeIntervalSinceReferenceDate;
+
+		[core fetchUpdatesWithCompletionHandler:^(NSError * _Nullable error, BOOL didFindChanges) {
+			OCLog(@"Full scan of %llu items at %.0f ms RTT took %.2f sec", tree.generatedItemCount, simulator.responseDelay * 1000.0, NSDate.timeIntervalSinceReferenceDate - scanStartTime);
+
+			XCTAssert(error == nil);
+			XCTAssert(didFindChanges);
+
+			[core.vault.database retrieveCacheItemsRecursivelyBelowPath:@"/" includingPathItself:YES includingRemoved:NO completionHandler:^(OCDatabase *db, NSError *error, OCSyncAnchor syncAnchor, NSArray<OCItem *> *items) {
+				XCTAssert(items.count == tree.generatedItemCount, @"%lu items in cache, %llu items on server", (unsigned long)items.count, tree.generatedItemCount);
+
+				[core stopWithCompletionHandler:^(id sender, NSError *error) {
+					[coreStoppedExpectation fulfill];
+				}];
+			}];
+		}];
+	}];
+
+	[self waitForExpectationsWithTimeout:120 handler:nil];
+
+	// Erase vault
+	[core.vault eraseSyncWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert((error==nil), @"Erased with error: %@", error);
+	}];
+}
+
+- (void)testSyntheticTreeSyncCollection
+{
+	// Changes deep in the tree, retrieved via sync-collection REPORT - and the same kind of changes retrieved via ETag walk, for comparison of the number of requests
+	OCHostSimulatorSyntheticTree *tree = [[OCHostSimulatorSyntheticTree alloc] initWithSeed:42 depth:3 folderFanOut:4 filesPerFolder:10];
+	OCHostSimulator *simulator = [OCHostSimulator syntheticTreeSimulatorWithTree:tree userName:nil];
+	OCHostSimulatorRequestHandler treeRequestHandler = simulator.requestHandler;
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"http://synthetic.owncloud.test/"]];
+	NSMutableDictionary<OCHTTPMethod, NSNumber *> *requestCountsByMethod = [NSMutableDictionary new];
+	NSUInteger syncCollectionRequestCount, eTagWalkRequestCount;
+	OCFileID movedFileID;
+	OCItem *item;
+	OCCore *core;
+
+	simulator.requestHandler = ^BOOL(OCConnection *connection, OCHTTPRequest *request, OCHostSimulatorResponseHandler responseHandler) {
+		@synchronized(requestCountsByMethod)
+		{
+			requestCountsByMethod[request.method] = @(requestCountsByMethod[request.method].unsignedIntegerValue + 1);
+		}
+
+		return (treeRequestHandler(connection, request, responseHandler));
+	};
+
+	NSUInteger(^TakeDAVRequestCount)(void) = ^{
+		NSUInteger count;
+
+		@synchronized(requestCountsByMethod)
+		{
+			count = requestCountsByMethod[OCHTTPMethodPROPFIND].unsignedIntegerValue + requestCountsByMethod[OCHTTPMethodREPORT].unsignedIntegerValue;
+			[requestCountsByMethod removeAllObjects];
+		}
+
+		return (count);
+	};
+
+	void(^FetchUpdates)(OCCore *core) = ^(OCCore *core) {
+		XCTestExpectation *fetchedExpectation = [self expectationWithDescription:@"Fetched updates"];
+
+		[core fetchUpdatesWithCompletionHandler:^(NSError * _Nullable error, BOOL didFindChanges) {
+			XCTAssert(error == nil, @"Fetched updates with error: %@", error);
+			[fetchedExpectation fulfill];
+		}];
+
+		[self waitForExpectations:@[ fetchedExpectation ] timeout:60];
+	};
+
+	OCItem *(^CacheItemAtPath)(OCCore *core, OCPath path) = ^(OCCore *core, OCPath path) {
+		return ([core.vault.database retrieveCacheItemsSyncAtPath:path itemOnly:YES error:NULL syncAnchor:NULL].firstObject);
+	};
+
+	[[OCClassSettings sharedSettings] addSource:self];
+
+	bookmark.authenticationData = [OCAuthenticationMethodBasicAuth authenticationDataForUsername:@"admin" passphrase:@"admin" authenticationHeaderValue:NULL error:NULL];
+	bookmark.authenticationMethodIdentifier = OCAuthenticationMethodIdentifierBasicAuth;
+
+	core = [[OCCore alloc] initWithBookmark:bookmark];
+	core.automaticItemListUpdatesEnabled = NO;
+	core.connection.hostSimulator = simulator;
+
+	XCTestExpectation *coreStartedExpectation = [self expectationWithDescription:@"Core started"];
+
+	[core startWithCompletionHandler:^(OCCore *core, NSError *error) {
+		XCTAssert(error == nil, @"Started with error: %@", error);
+		[coreStartedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ coreStartedExpectation ] timeout:60];
+
+	// Initial scan: retrieves the sync token, walks the tree and stores the token once done
+	XCTAssert(core.usesSyncCollection);
+	FetchUpdates(core);
+
+	XCTAssert([[core.vault.keyValueStore readObjectForKey:OCKeyValueStoreKeyCoreSyncCollectionToken] isEqual:tree.syncToken]);
+
+	// Local modifications are preserved
+	item = CacheItemAtPath(core, @"/Folder 1/Folder 2/File 3.txt");
+	item.locallyModified = YES;
+	item.localRelativePath = @"File 3.txt";
+
+	XCTestExpectation *updatedExpectation = [self expectationWithDescription:@"Cache item updated"];
+
+	[core.vault.database updateCacheItems:@[ item ] syncAnchor:core.latestSyncAnchor completionHandler:^(OCDatabase *db, NSError *error) {
+		XCTAssert(error == nil);
+		[updatedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ updatedExpectation ] timeout:60];
+
+	// Changes in three branches of the tree
+	movedFileID = [tree itemAtPath:@"/Folder 1/Folder 1/Folder 1/File 1.txt"].fileID;
+
+	XCTAssert([tree writeFileAtPath:@"/Folder 2/Folder 3/Folder 4/File 5.txt" contents:[@"Modified" dataUsingEncoding:NSUTF8StringEncoding]] != nil);
+	XCTAssert([tree writeFileAtPath:@"/Folder 3/Folder 1/Folder 2/New.txt" contents:[@"New" dataUsingEncoding:NSUTF8StringEncoding]] != nil);
+	XCTAssert([tree createFolderAtPath:@"/Folder 3/Folder 4/New Folder"] != nil);
+	XCTAssert([tree writeFileAtPath:@"/Folder 3/Folder 4/New Folder/Inside.txt" contents:[@"Inside" dataUsingEncoding:NSUTF8StringEncoding]] != nil);
+	XCTAssert([tree moveFileAtPath:@"/Folder 1/Folder 1/Folder 1/File 1.txt" toPath:@"/Folder 3/Folder 4/Folder 4/Moved.txt"] != nil);
+	XCTAssert([tree removeItemAtPath:@"/Folder 2/Folder 2/Folder 2/File 10.txt"]);
+	XCTAssert([tree writeFileAtPath:@"/Folder 1/Folder 2/File 3.txt" contents:[@"Remote" dataUsingEncoding:NSUTF8StringEncoding]] != nil);
+
+	TakeDAVRequestCount();
+	FetchUpdates(core);
+	syncCollectionRequestCount = TakeDAVRequestCount();
+
+	// - modification
+	XCTAssert([CacheItemAtPath(core, @"/Folder 2/Folder 3/Folder 4/File 5.txt").eTag isEqual:[tree itemAtPath:@"/Folder 2/Folder 3/Folder 4/File 5.txt"].eTag]);
+
+	// - additions (incl. a new folder and its contents)
+	XCTAssert([CacheItemAtPath(core, @"/Folder 3/Folder 1/Folder 2/New.txt").parentFileID isEqual:[tree itemAtPath:@"/Folder 3/Folder 1/Folder 2/"].fileID]);
+	XCTAssert(CacheItemAtPath(core, @"/Folder 3/Folder 4/New Folder/") != nil);
+	XCTAssert([CacheItemAtPath(core, @"/Folder 3/Folder 4/New Folder/Inside.txt").parentFileID isEqual:[tree itemAtPath:@"/Folder 3/Folder 4/New Folder/"].fileID]);
+
+	// - move
+	XCTAssert(CacheItemAtPath(core, @"/Folder 1/Folder 1/Folder 1/File 1.txt") == nil);
+	XCTAssert([CacheItemAtPath(core, @"/Folder 3/Folder 4/Folder 4/Moved.txt").fileID isEqual:movedFileID]);
+	XCTAssert([CacheItemAtPath(core, @"/Folder 3/Folder 4/Folder 4/Moved.txt").parentFileID isEqual:[tree itemAtPath:@"/Folder 3/Folder 4/Folder 4/"].fileID]);
+
+	// - removal
+	XCTAssert(CacheItemAtPath(core, @"/Folder 2/Folder 2/Folder 2/File 10.txt") == nil);
+
+	// - locally modified item: kept, with the new server version attached
+	item = CacheItemAtPath(core, @"/Folder 1/Folder 2/File 3.txt");
+	XCTAssert(item.locallyModified);
+	XCTAssert([item.remoteItem.eTag isEqual:[tree itemAtPath:@"/Folder 1/Folder 2/File 3.txt"].eTag]);
+
+	XCTAssert([[core.vault.keyValueStore readObjectForKey:OCKeyValueStoreKeyCoreSyncCollectionToken] isEqual:tree.syncToken]);
+
+	// Missing parent: skipped, and the folder that should contain the parent is rescanned
+	OCItem *orphanItem = [OCItem new], *unplaceableItem = [OCItem new];
+	XCTestExpectation *appliedExpectation = [self expectationWithDescription:@"Changes applied"];
+
+	orphanItem.type = OCItemTypeFile;
+	orphanItem.path = @"/Folder 4/Unknown/Orphan.txt";
+	orphanItem.fileID = @"orphan";
+	orphanItem.eTag = @"\"orphan\"";
+
+	unplaceableItem.type = OCItemTypeFile;
+	unplaceableItem.path = @"/Unknown/Unknown/Unplaceable.txt";
+	unplaceableItem.fileID = @"unplaceable";
+	unplaceableItem.eTag = @"\"unplaceable\"";
+
+	[core applySyncCollectionChangedItems:@[ orphanItem, unplaceableItem ] removedItems:@[] completionHandler:^(NSError * _Nullable error, BOOL foundChanges, BOOL skippedItems) {
+		XCTAssert(error == nil);
+		XCTAssert(skippedItems);
+		[appliedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ appliedExpectation ] timeout:60];
+
+	XCTAssert(CacheItemAtPath(core, orphanItem.path) == nil);
+	XCTAssert(CacheItemAtPath(core, unplaceableItem.path) == nil);
+
+	// Same kind of changes, retrieved via ETag walk
+	[[OCClassSettings sharedSettings] removeSource:self];
+	XCTAssert(!core.usesSyncCollection);
+
+	XCTAssert([tree writeFileAtPath:@"/Folder 4/Folder 3/Folder 2/File 5.txt" contents:[@"Modified" dataUsingEncoding:NSUTF8StringEncoding]] != nil);
+	XCTAssert([tree writeFileAtPath:@"/Folder 2/Folder 1/Folder 2/New.txt" contents:[@"New" dataUsingEncoding:NSUTF8StringEncoding]] != nil);
+	XCTAssert([tree moveFileAtPath:@"/Folder 2/Folder 1/Folder 3/File 1.txt" toPath:@"/Folder 4/Folder 4/Folder 4/Moved.txt"] != nil);
+	XCTAssert([tree removeItemAtPath:@"/Folder 1/Folder 3/Folder 2/File 10.txt"]);
+
+	TakeDAVRequestCount();
+	FetchUpdates(core);
+	eTagWalkRequestCount = TakeDAVRequestCount();
+
+	XCTAssert(CacheItemAtPath(core, @"/Folder 4/Folder 4/Folder 4/Moved.txt") != nil);
+
+	OCLog(@"Requests to retrieve changes in %llu items: %lu via sync-collection REPORT, %lu via ETag walk", tree.generatedItemCount, (unsigned long)syncCollectionRequestCount, (unsigned long)eTagWalkRequestCount);
+
+	// One REPORT (plus a PROPFIND of the root for quota) vs. one PROPFIND per changed folder
+	XCTAssert(syncCollectionRequestCount <= 2, @"%lu requests via sync-collection REPORT", (unsigned long)syncCollectionRequestCount);
+	XCTAssert(eTagWalkRequestCount >= 10, @"%lu requests via ETag walk", (unsigned long)eTagWalkRequestCount);
+
+	// Stop core and erase vault
+	XCTestExpectation *coreStoppedExpectation = [self expectationWithDescription:@"Core stopped"];
+
+	[core stopWithCompletionHandler:^(id sender, NSError *error) {
+		[coreStoppedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ coreStoppedExpectation ] timeout:60];
+
+	[core.vault eraseSyncWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert((error==nil), @"Erased with error: %@", error);
+	}];
+}
+
+@end
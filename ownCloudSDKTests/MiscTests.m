@@ -8,11 +8,54 @@
 
 #import <XCTest/XCTest.h>
 #import <ownCloudSDK/ownCloudSDK.h>
+#import "NSDate+OCDateParser.h"
+#import "OCQuery+Internal.h"
+#import "OCSyncReadyQueue.h"
+#import "OCSyncAction.h"
+#import "OCSyncActionLocalCopyDelete.h"
+#import "OCSyncTransferScheduler.h"
+#import "OCCore+Internal.h"
+
+@interface OCWindowedQuery (Testing)
+- (void)_finishLoadForGeneration:(NSUInteger)generation error:(NSError *)error numberOfItems:(NSUInteger)numberOfItems range:(NSRange)range items:(NSArray<OCItem *> *)items;
+@end
+
+@interface OCCore (SyncEngineTesting)
+- (void)processSyncRecords;
+@end
 
 @interface MiscTests : XCTestCase
 
 @end
 
+@interface XMLSAXEventRecorder : NSObject <OCXMLSAXParserDelegate>
+@property(strong) NSMutableArray<NSString *> *events;
+@property(assign) NSUInteger elementCount;
+@end
+
+@implementation XMLSAXEventRecorder
+
+- (void)saxParser:(OCXMLSAXParser *)parser didStartElement:(OCXMLElementName)elementName attributes:(NSDictionary<NSString *,NSString *> *)attributes
+{
+	[_events addObject:[@"<" stringByAppendingString:elementName]];
+	_elementCount++;
+}
+
+- (void)saxParser:(OCXMLSAXParser *)parser foundCharacters:(const char *)bytes length:(NSUInteger)length
+{
+	if (_events != nil)
+	{
+		[_events addObject:[[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding]];
+	}
+}
+
+- (void)saxParser:(OCXMLSAXParser *)parser didEndElement:(OCXMLElementName)elementName
+{
+	[_events addObject:[@">" stringByAppendingString:elementName]];
+}
+
+@end
+
 @implementation MiscTests
 
 #pragma mark - NSURL+OCURLNormalization
@@ -121,6 +164,61 @@
 
 }
 
+- (void)testPropfindRequestBodyPrecomputation
+{
+	NSURL *url = [NSURL URLWithString:@"https://demo.owncloud.org/remote.php/dav/files/admin/"];
+	NSArray<OCXMLNode *> *(^Properties)(void) = ^{
+		return (@[
+			[OCXMLNode elementWithName:@"D:resourcetype"],
+			[OCXMLNode elementWithName:@"D:getetag"],
+			[OCXMLNode elementWithName:@"oc:id"],
+			[OCXMLNode elementWithName:@"oc:permissions"]
+		]);
+	};
+	OCHTTPDAVRequest *composedRequest = [OCHTTPDAVRequest propfindRequestWithURL:url depth:1];
+	OCHTTPDAVRequest *precomputedRequest;
+	NSData *precomputedBody = [OCHTTPDAVRequest propfindRequestBodyWithProperties:Properties()];
+
+	[composedRequest.xmlRequestPropAttribute addChildren:Properties()];
+
+	precomputedRequest = [OCHTTPDAVRequest propfindRequestWithURL:url depth:1 bodyData:precomputedBody];
+
+	// Request with precomputed body must be identical to a request composed from OCXMLNodes
+	XCTAssert([precomputedRequest.bodyData isEqual:composedRequest.bodyData]);
+	XCTAssert(precomputedRequest.bodyData == precomputedBody); // shared, not copied
+	XCTAssert([precomputedRequest.method isEqual:composedRequest.method]);
+	XCTAssert([[precomputedRequest valueForHeaderField:OCHTTPHeaderFieldNameDepth] isEqual:@"1"]);
+	XCTAssert([[precomputedRequest valueForHeaderField:OCHTTPHeaderFieldNameContentType] isEqual:@"application/xml"]);
+	XCTAssert([[[OCHTTPDAVRequest propfindRequestWithURL:url depth:OCPropfindDepthInfinity bodyData:precomputedBody] valueForHeaderField:OCHTTPHeaderFieldNameDepth] isEqual:@"infinity"]);
+
+	// Throughput comparison
+	NSUInteger iterations = 10000;
+	NSTimeInterval startTime, composedDuration, precomputedDuration;
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	for (NSUInteger i=0; i<iterations; i++)
+	{
+		@autoreleasepool {
+			OCHTTPDAVRequest *request = [OCHTTPDAVRequest propfindRequestWithURL:url depth:1];
+			[request.xmlRequestPropAttribute addChildren:Properties()];
+			XCTAssert(request.bodyData != nil);
+		}
+	}
+	composedDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	for (NSUInteger i=0; i<iterations; i++)
+	{
+		@autoreleasepool {
+			OCHTTPDAVRequest *request = [OCHTTPDAVRequest propfindRequestWithURL:url depth:1 bodyData:precomputedBody];
+			XCTAssert(request.bodyData != nil);
+		}
+	}
+	precomputedDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	OCLog(@"%lu PROPFIND requests: composed %.3f sec, precomputed body %.3f sec", (unsigned long)iterations, composedDuration, precomputedDuration);
+}
+
 - (void)testXMLDecoding
 {
 	// Just a playground right now.. proper tests coming.
@@ -157,6 +255,176 @@
 	XCTAssert((items[3].type == OCItemTypeFile), 	   @"Type match: %ld", (long)items[3].type);
 }
 
+- (NSArray<OCItem *> *)_itemsFromMultistatusData:(NSData *)xmlData basePath:(NSString *)basePath useSAXParser:(BOOL)useSAXParser
+{
+	OCXMLParser *parser = useSAXParser ? [[OCXMLParser alloc] initWithData:xmlData] : [[OCXMLParser alloc] initWithParser:[[NSXMLParser alloc] initWithData:xmlData]];
+
+	parser.options = [NSMutableDictionary dictionaryWithObjectsAndKeys:
+		basePath, 			@"basePath",
+		[NSMutableDictionary new], 	@"usersByUserID",
+	nil];
+
+	[parser addObjectCreationClasses:@[ [OCItem class], [NSError class] ]];
+
+	XCTAssert([parser parse]);
+
+	return (parser.parsedObjects);
+}
+
+- (void)testXMLMultistatusItemDecoding
+{
+	NSString *xmlString = @"<?xml version=\"1.0\"?><d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">"
+		"<d:response><d:href>/remote.php/dav/files/admin/</d:href><d:propstat><d:prop><d:resourcetype><d:collection/></d:resourcetype><d:getlastmodified>Tue, 06 Mar 2018 22:10:00 GMT</d:getlastmodified><d:getetag>&quot;5a9f11b8b440c&quot;</d:getetag><d:quota-available-bytes>-3</d:quota-available-bytes><d:quota-used-bytes>5809166</d:quota-used-bytes><oc:size>5809166</oc:size><oc:id>00000015ocnq90xhpk22</oc:id><oc:permissions>RDNVCK</oc:permissions></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>"
+		"<d:response><d:href>/remote.php/dav/files/admin/Shared%20Folder/</d:href><d:propstat><d:prop><d:resourcetype><d:collection/></d:resourcetype><d:getlastmodified>Tue, 06 Mar 2018 22:10:00 GMT</d:getlastmodified><d:getetag>&quot;5a9f11b8b440d&quot;</d:getetag><d:quota-available-bytes>1000</d:quota-available-bytes><oc:size>36227</oc:size><oc:id>00000021ocnq90xhpk22</oc:id><oc:permissions>SRDNVCK</oc:permissions><oc:share-types><oc:share-type>0</oc:share-type><oc:share-type>3</oc:share-type></oc:share-types><oc:owner-id>bob</oc:owner-id><oc:owner-display-name>Bob</oc:owner-display-name><oc:favorite>1</oc:favorite></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat>"
+			"<d:propstat><d:prop><d:getcontenttype>text/invalid</d:getcontenttype><oc:permissions>W</oc:permissions></d:prop><d:status>HTTP/1.1 404 Not Found</d:status></d:propstat></d:response>"
+		"<d:response><d:href>/remote.php/dav/files/admin/Shared%20Folder/M%C3%BCnchen%20%26%20mehr.pdf</d:href><d:propstat><d:prop><d:resourcetype/><d:getlastmodified>Fri, 23 Feb 2018 11:52:05 GMT</d:getlastmodified><d:creationdate>2018-02-23T11:52:05Z</d:creationdate><d:getcontentlength>5094383</d:getcontentlength><d:getcontenttype>application/pdf</d:getcontenttype><d:getetag>&quot;c43d4f3af69fb2d8ad1e873dadf9d973&quot;</d:getetag><oc:id>00000020ocnq90xhpk22</oc:id><oc:permissions>RDNVW</oc:permissions><oc:owner-id>bob</oc:owner-id><oc:owner-display-name>Bob</oc:owner-display-name><oc:privatelink>https://demo.owncloud.org/f/20</oc:privatelink>"
+			"<oc:checksums><oc:checksum>SHA1:b6e74385099c208fa310ee7d0168e270e40de4c9 MD5:2dc1a2fc2aa833b00b92dc4388a86139 ADLER32:0edff753</oc:checksum></oc:checksums></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>"
+		"</d:multistatus>";
+	NSData *xmlData = [xmlString dataUsingEncoding:NSUTF8StringEncoding];
+	NSArray<OCItem *> *decodedItems = [self _itemsFromMultistatusData:xmlData basePath:@"/remote.php/dav/files/admin" useSAXParser:YES];
+	NSArray<OCItem *> *nodeItems = [self _itemsFromMultistatusData:xmlData basePath:@"/remote.php/dav/files/admin" useSAXParser:NO];
+
+	XCTAssert(decodedItems.count == 3);
+	XCTAssert(nodeItems.count == 3);
+
+	// Decoder results
+	XCTAssertEqualObjects(decodedItems[0].path, @"/");
+	XCTAssertNil(decodedItems[0].quotaBytesRemaining);
+
+	XCTAssertEqualObjects(decodedItems[1].path, @"/Shared Folder/");
+	XCTAssert(decodedItems[1].type == OCItemTypeCollection);
+	XCTAssert(decodedItems[1].permissions == (OCItemPermissionShared|OCItemPermissionShareable|OCItemPermissionDelete|OCItemPermissionRename|OCItemPermissionMove|OCItemPermissionCreateFile|OCItemPermissionCreateFolder));
+	XCTAssert(decodedItems[1].shareTypesMask == (OCShareTypesMaskUserShare|OCShareTypesMaskLink));
+	XCTAssertNil(decodedItems[1].mimeType); // from 404 propstat => ignored
+	XCTAssertEqualObjects(decodedItems[1].isFavorite, @(1));
+	XCTAssertEqualObjects(decodedItems[1].quotaBytesRemaining, @(1000));
+	XCTAssertEqualObjects(decodedItems[1].owner.displayName, @"Bob");
+	XCTAssert(decodedItems[1].owner == decodedItems[2].owner); // shared via usersByUserID
+
+	XCTAssertEqualObjects(decodedItems[2].path, @"/Shared Folder/München & mehr.pdf");
+	XCTAssert(decodedItems[2].type == OCItemTypeFile);
+	XCTAssert(decodedItems[2].size == 5094383);
+	XCTAssertEqualObjects(decodedItems[2].eTag, @"\"c43d4f3af69fb2d8ad1e873dadf9d973\"");
+	XCTAssertEqualObjects(decodedItems[2].privateLink, [NSURL URLWithString:@"https://demo.owncloud.org/f/20"]);
+	XCTAssertEqualObjects(decodedItems[2].creationDate, decodedItems[2].lastModified);
+	XCTAssert(decodedItems[2].checksums.count == 3);
+	XCTAssertEqualObjects(decodedItems[2].checksums[1].algorithmIdentifier, @"MD5");
+	XCTAssertEqualObjects(decodedItems[2].checksums[2].headerString, @"ADLER32:0edff753");
+
+	// Decoder and node-based object creation must produce the same items
+	for (NSUInteger idx=0; idx<3; idx++)
+	{
+		OCItem *decodedItem = decodedItems[idx], *nodeItem = nodeItems[idx];
+
+		XCTAssertEqualObjects(decodedItem.path, nodeItem.path);
+		XCTAssert(decodedItem.type == nodeItem.type);
+		XCTAssert(decodedItem.size == nodeItem.size);
+		XCTAssert(decodedItem.permissions == nodeItem.permissions);
+		XCTAssert(decodedItem.shareTypesMask == nodeItem.shareTypesMask);
+		XCTAssertEqualObjects(decodedItem.mimeType, nodeItem.mimeType);
+		XCTAssertEqualObjects(decodedItem.eTag, nodeItem.eTag);
+		XCTAssertEqualObjects(decodedItem.fileID, nodeItem.fileID);
+		XCTAssertEqualObjects(decodedItem.lastModified, nodeItem.lastModified);
+		XCTAssertEqualObjects(decodedItem.creationDate, nodeItem.creationDate);
+		XCTAssertEqualObjects(decodedItem.isFavorite, nodeItem.isFavorite);
+		XCTAssertEqualObjects(decodedItem.privateLink, nodeItem.privateLink);
+		XCTAssertEqualObjects(decodedItem.quotaBytesRemaining, nodeItem.quotaBytesRemaining);
+		XCTAssertEqualObjects(decodedItem.quotaBytesUsed, nodeItem.quotaBytesUsed);
+		XCTAssertEqualObjects(decodedItem.owner.userName, nodeItem.owner.userName);
+		XCTAssertEqualObjects([decodedItem.checksums valueForKey:@"headerString"], [nodeItem.checksums valueForKey:@"headerString"]);
+	}
+}
+
+- (void)testSyncCollectionResponseDecoding
+{
+	OCHTTPDAVRequest *request = [OCHTTPDAVRequest syncCollectionRequestWithURL:[NSURL URLWithString:@"https://demo.owncloud.org/remote.php/dav/files/admin/"] syncToken:@"http://sabre.io/ns/sync/41" limit:500 properties:@[ [OCXMLNode elementWithName:@"D:getetag"] ]];
+	NSString *requestBody = [[NSString alloc] initWithData:request.bodyData encoding:NSUTF8StringEncoding];
+	OCDAVSyncToken syncToken = nil;
+	BOOL truncated = NO;
+
+	XCTAssert([requestBody containsString:@"sync-collection"]);
+	XCTAssert([requestBody containsString:@"http://sabre.io/ns/sync/41"]);
+	XCTAssert([requestBody containsString:@"infinite"]);
+	XCTAssert([requestBody containsString:@"500"]);
+
+	request.httpResponse = [OCHTTPResponse responseWithRequest:request HTTPError:nil];
+	request.httpResponse.bodyData = [@"<?xml version=\"1.0\"?><d:multistatus xmlns:d=\"DAV:\" xmlns:oc=\"http://owncloud.org/ns\">"
+		"<d:response><d:href>/remote.php/dav/files/admin/Documents/Example.odt</d:href><d:propstat><d:prop><d:resourcetype/><d:getcontentlength>36227</d:getcontentlength><d:getetag>&quot;9b5e8a1f3c&quot;</d:getetag><oc:id>00000042ocnq90xhpk22</oc:id><oc:permissions>RDNVW</oc:permissions></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat></d:response>"
+		"<d:response><d:href>/remote.php/dav/files/admin/Photos/Old%20Photo.jpg</d:href><d:status>HTTP/1.1 404 Not Found</d:status></d:response>"
+		"<d:response><d:href>/remote.php/dav/files/admin/</d:href><d:status>HTTP/1.1 507 Insufficient Storage</d:status></d:response>"
+		"<d:sync-token>http://sabre.io/ns/sync/42</d:sync-token>"
+		"</d:multistatus>" dataUsingEncoding:NSUTF8StringEncoding];
+
+	NSArray<OCItem *> *items = [request syncCollectionResponseItemsForBasePath:@"/remote.php/dav/files/admin" reuseUsersByID:[NSMutableDictionary new] syncToken:&syncToken truncated:&truncated withErrors:NULL];
+
+	XCTAssert(items.count == 2);
+
+	XCTAssertEqualObjects(items[0].path, @"/Documents/Example.odt");
+	XCTAssertEqualObjects(items[0].fileID, @"00000042ocnq90xhpk22");
+	XCTAssertFalse(items[0].removed);
+
+	XCTAssertEqualObjects(items[1].path, @"/Photos/Old Photo.jpg");
+	XCTAssertTrue(items[1].removed);
+
+	XCTAssertTrue(truncated);
+	XCTAssertEqualObjects(syncToken, @"http://sabre.io/ns/sync/42");
+
+	// Token is picked from the top level of the multistatus only - regardless of namespace prefix and surrounding whitespace
+	syncToken = nil;
+	request.httpResponse.bodyData = [@"<?xml version=\"1.0\"?>\n<D:multistatus xmlns:D=\"DAV:\">\n"
+		"  <D:response><D:href>/remote.php/dav/files/admin/Notes.txt</D:href><D:propstat><D:prop><D:getetag>&quot;1a2b3c&quot;</D:getetag><D:sync-token>http://sabre.io/ns/sync/99</D:sync-token></D:prop><D:status>HTTP/1.1 200 OK</D:status></D:propstat></D:response>\n"
+		"  <D:sync-token>\n    http://sabre.io/ns/sync/43?a=1&amp;b=2\n  </D:sync-token>\n"
+		"</D:multistatus>\n" dataUsingEncoding:NSUTF8StringEncoding];
+
+	items = [request syncCollectionResponseItemsForBasePath:@"/remote.php/dav/files/admin" reuseUsersByID:[NSMutableDictionary new] syncToken:&syncToken truncated:&truncated withErrors:NULL];
+
+	XCTAssert(items.count == 1);
+	XCTAssertEqualObjects(items[0].path, @"/Notes.txt");
+	XCTAssertEqualObjects(syncToken, @"http://sabre.io/ns/sync/43?a=1&b=2");
+}
+
+- (void)testXMLMultistatusItemDecodingThroughput
+{
+	NSString *responseTemplate = @"<d:response><d:href>/remote.php/dav/files/admin/Folder/file%%20%lu.txt</d:href><d:propstat><d:prop><d:resourcetype/><d:getlastmodified>Fri, 23 Feb 2018 11:52:05 GMT</d:getlastmodified><d:getcontentlength>5094383</d:getcontentlength><d:getcontenttype>text/plain</d:getcontenttype><d:getetag>&quot;c43d4f3af69fb2d8ad1e873dadf9d973&quot;</d:getetag><oc:size>5094383</oc:size><oc:id>%08luocnq90xhpk22</oc:id><oc:permissions>RDNVW</oc:permissions><oc:checksums><oc:checksum>SHA1:b6e74385099c208fa310ee7d0168e270e40de4c9</oc:checksum></oc:checksums></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat><d:propstat><d:prop><d:quota-available-bytes/><d:quota-used-bytes/></d:prop><d:status>HTTP/1.1 404 Not Found</d:status></d:propstat></d:response>";
+	NSMutableData *xmlData = [NSMutableData new];
+	NSUInteger responseCount = 50000;
+	NSTimeInterval startTime, decoderDuration, nodeDuration;
+	NSArray<OCItem *> *items;
+
+	[xmlData appendData:[@"<?xml version=\"1.0\"?><d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">" dataUsingEncoding:NSUTF8StringEncoding]];
+
+	for (NSUInteger idx=0; idx<responseCount; idx++)
+	{
+		@autoreleasepool {
+			[xmlData appendData:[[NSString stringWithFormat:responseTemplate, (unsigned long)idx, (unsigned long)idx] dataUsingEncoding:NSUTF8StringEncoding]];
+		}
+	}
+
+	[xmlData appendData:[@"</d:multistatus>" dataUsingEncoding:NSUTF8StringEncoding]];
+
+	// OCXMLSAXParser + OCItemMultistatusDecoder
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	@autoreleasepool {
+		items = [self _itemsFromMultistatusData:xmlData basePath:@"/remote.php/dav/files/admin" useSAXParser:YES];
+	}
+	decoderDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	XCTAssert(items.count == responseCount);
+	XCTAssertEqualObjects(items.lastObject.path, ([NSString stringWithFormat:@"/Folder/file %lu.txt", (unsigned long)(responseCount-1)]));
+	XCTAssert(items.lastObject.checksums.count == 1);
+
+	// NSXMLParser + OCXMLParserNode based object creation
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	@autoreleasepool {
+		items = [self _itemsFromMultistatusData:xmlData basePath:@"/remote.php/dav/files/admin" useSAXParser:NO];
+	}
+	nodeDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	XCTAssert(items.count == responseCount);
+
+	OCLog(@"Decoded %lu items from PROPFIND response: OCItemMultistatusDecoder %.0f items/s, OCXMLParserNode %.0f items/s", (unsigned long)responseCount, responseCount / decoderDuration, responseCount / nodeDuration);
+}
+
 - (void)testXMLDAVExceptionDecoding
 {
 	NSString *xmlString=@"<?xml version='1.0' encoding='utf-8'?><d:error xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\">  <s:exception>Sabre\\DAV\\Exception\\ServiceUnavailable</s:exception>  <s:message>System in maintenance mode.</s:message></d:error>";
@@ -182,6 +450,123 @@
 	XCTAssert([error.localizedDescription isEqual:@"Server down for maintenance."]);
 }
 
+- (void)testXMLDAVPreconditionDecoding
+{
+	NSError *(^ParseDAVError)(NSString *xmlString) = ^(NSString *xmlString) {
+		OCXMLParser *parser = [[OCXMLParser alloc] initWithData:[xmlString dataUsingEncoding:NSUTF8StringEncoding]];
+
+		[parser addObjectCreationClasses:@[ [NSError class] ]];
+		[parser parse];
+
+		return (parser.errors.firstObject);
+	};
+
+	// Sabre: invalid sync token (403)
+	XCTAssert(ParseDAVError(@"<?xml version=\"1.0\" encoding=\"utf-8\"?><d:error xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\"><s:exception>Sabre\\DAV\\Exception\\InvalidSyncToken</s:exception><s:message>Invalid or unknown sync token</s:message><d:valid-sync-token/></d:error>").davError == OCDAVErrorInvalidSyncToken);
+
+	// Sabre: REPORT not supported (also 403)
+	XCTAssert(ParseDAVError(@"<?xml version=\"1.0\" encoding=\"utf-8\"?><d:error xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\"><s:exception>Sabre\\DAV\\Exception\\ReportNotSupported</s:exception><s:message>The {DAV:}sync-collection REPORT is not supported on this url.</s:message><d:supported-report/></d:error>").davError == OCDAVErrorReportNotSupported);
+
+	// Precondition element only, other namespace prefix
+	XCTAssert(ParseDAVError(@"<?xml version=\"1.0\" encoding=\"utf-8\"?><D:error xmlns:D=\"DAV:\"><D:valid-sync-token/></D:error>").davError == OCDAVErrorInvalidSyncToken);
+
+	// Other 403
+	XCTAssert(ParseDAVError(@"<?xml version=\"1.0\" encoding=\"utf-8\"?><d:error xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\"><s:exception>Sabre\\DAV\\Exception\\Forbidden</s:exception><s:message>Access denied</s:message></d:error>").davError == OCDAVErrorUnknown);
+}
+
+- (void)testXMLSAXParserNamespacesEntitiesAndStreaming
+{
+	NSString *xmlString = @"<?xml version=\"1.0\"?><!-- comment --><D:multistatus xmlns:D=\"DAV:\" xmlns:O=\"http://owncloud.org/ns\"><D:response><D:href>/a&amp;b/&#x41;&#66;</D:href><D:prop xmlns=\"http://owncloud.org/ns\"><size>12</size><O:id><![CDATA[<raw>]]></O:id><D:resourcetype><D:collection/></D:resourcetype></D:prop></D:response></D:multistatus>";
+	NSArray<NSString *> *expectedEvents = @[
+		@"<d:multistatus", @"<d:response", @"<d:href", @"/a&b/AB", @">d:href", @"<d:prop", @"<oc:size", @"12", @">oc:size", @"<oc:id", @"<raw>", @">oc:id", @"<d:resourcetype", @"<d:collection", @">d:collection", @">d:resourcetype", @">d:prop", @">d:response", @">d:multistatus"
+	];
+	NSData *xmlData = [xmlString dataUsingEncoding:NSUTF8StringEncoding];
+
+	// Data
+	XMLSAXEventRecorder *recorder = [XMLSAXEventRecorder new];
+	OCXMLSAXParser *saxParser = [[OCXMLSAXParser alloc] initWithData:xmlData];
+
+	recorder.events = [NSMutableArray new];
+	saxParser.delegate = recorder;
+
+	XCTAssert([saxParser parse]);
+	XCTAssert([recorder.events isEqual:expectedEvents], @"%@", recorder.events);
+
+	// Interned, namespace-resolved names
+	XCTAssert([OCXMLSAXParser internedElementNameForNamespace:@"DAV:" localName:@"href"] == [OCXMLSAXParser internedElementNameForNamespace:@"DAV:" localName:[@"hr" stringByAppendingString:@"ef"]]);
+	XCTAssert([[OCXMLSAXParser internedElementNameForNamespace:@"http://owncloud.org/ns" localName:@"size"] isEqual:@"oc:size"]);
+
+	// Stream
+	recorder.events = [NSMutableArray new];
+	saxParser = [[OCXMLSAXParser alloc] initWithStream:[NSInputStream inputStreamWithData:xmlData]];
+	saxParser.delegate = recorder;
+
+	XCTAssert([saxParser parse]);
+	XCTAssert([recorder.events isEqual:expectedEvents], @"%@", recorder.events);
+
+	// Errors
+	saxParser = [[OCXMLSAXParser alloc] initWithData:[@"<d:a xmlns:d=\"DAV:\"><d:b></d:a>" dataUsingEncoding:NSUTF8StringEncoding]];
+	XCTAssert(![saxParser parse]);
+	XCTAssert(saxParser.parserError.code == NSXMLParserTagNameMismatchError);
+
+	saxParser = [[OCXMLSAXParser alloc] initWithData:[@"<d:a xmlns:d=\"DAV:\"><d:b>" dataUsingEncoding:NSUTF8StringEncoding]];
+	XCTAssert(![saxParser parse]);
+	XCTAssert(saxParser.parserError.code == NSXMLParserPrematureDocumentEndError);
+
+	saxParser = [[OCXMLSAXParser alloc] initWithData:[@"<a>&unknown;</a>" dataUsingEncoding:NSUTF8StringEncoding]];
+	XCTAssert(![saxParser parse]);
+	XCTAssert(saxParser.parserError.code == NSXMLParserUndeclaredEntityError);
+}
+
+- (void)testXMLSAXParserThroughput
+{
+	NSString *responseTemplate = @"<d:response><d:href>/remote.php/dav/files/admin/Folder/file-%lu.txt</d:href><d:propstat><d:prop><d:resourcetype/><d:getlastmodified>Fri, 23 Feb 2018 11:52:05 GMT</d:getlastmodified><d:getcontentlength>5094383</d:getcontentlength><d:getcontenttype>text/plain</d:getcontenttype><d:getetag>&quot;c43d4f3af69fb2d8ad1e873dadf9d973&quot;</d:getetag><oc:size>5094383</oc:size><oc:id>%08luocnq90xhpk22</oc:id><oc:permissions>RDNVW</oc:permissions></d:prop><d:status>HTTP/1.1 200 OK</d:status></d:propstat><d:propstat><d:prop><d:quota-available-bytes/><d:quota-used-bytes/></d:prop><d:status>HTTP/1.1 404 Not Found</d:status></d:propstat></d:response>";
+	NSMutableData *xmlData = [NSMutableData new];
+	NSUInteger targetSize = 100 * 1024 * 1024, responseCount = 0;
+
+	[xmlData appendData:[@"<?xml version=\"1.0\"?><d:multistatus xmlns:d=\"DAV:\" xmlns:s=\"http://sabredav.org/ns\" xmlns:oc=\"http://owncloud.org/ns\">" dataUsingEncoding:NSUTF8StringEncoding]];
+
+	while (xmlData.length < targetSize)
+	{
+		@autoreleasepool {
+			[xmlData appendData:[[NSString stringWithFormat:responseTemplate, (unsigned long)responseCount, (unsigned long)responseCount] dataUsingEncoding:NSUTF8StringEncoding]];
+			responseCount++;
+		}
+	}
+
+	[xmlData appendData:[@"</d:multistatus>" dataUsingEncoding:NSUTF8StringEncoding]];
+
+	double megabytes = ((double)xmlData.length) / (1024.0 * 1024.0);
+	NSTimeInterval startTime, saxDuration, saxXMLParserDuration, foundationXMLParserDuration;
+
+	// OCXMLSAXParser
+	XMLSAXEventRecorder *recorder = [XMLSAXEventRecorder new];
+	OCXMLSAXParser *saxParser = [[OCXMLSAXParser alloc] initWithData:xmlData];
+
+	saxParser.delegate = recorder; // .events == nil => only count elements
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	XCTAssert([saxParser parse]);
+	saxDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	XCTAssert(recorder.elementCount == (responseCount * 18) + 1, @"elementCount=%lu", (unsigned long)recorder.elementCount);
+
+	// OCXMLParser on top of OCXMLSAXParser vs. NSXMLParser (without object creation)
+	OCXMLParser *xmlParser = [[OCXMLParser alloc] initWithData:xmlData];
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	XCTAssert([xmlParser parse]);
+	saxXMLParserDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	xmlParser = [[OCXMLParser alloc] initWithParser:[[NSXMLParser alloc] initWithData:xmlData]];
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	XCTAssert([xmlParser parse]);
+	foundationXMLParserDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	OCLog(@"Parsed %.1f MB with %lu responses: OCXMLSAXParser %.1f MB/s, OCXMLParser+OCXMLSAXParser %.1f MB/s, OCXMLParser+NSXMLParser %.1f MB/s", megabytes, (unsigned long)responseCount, megabytes / saxDuration, megabytes / saxXMLParserDuration, megabytes / foundationXMLParserDuration);
+}
+
 #pragma mark - OCCache
 - (void)testCacheCountLimit
 {
@@ -470,6 +855,56 @@
 	XCTAssert(executedJobCount==executedCompletionHandlerCount);
 }
 
+- (void)testAsyncSequentialQueueConcurrency
+{
+	OCAsyncSequentialQueue *queue = [OCAsyncSequentialQueue new];
+	XCTestExpectation *allJobsDoneExpectation = [self expectationWithDescription:@"All jobs done"];
+	__block NSUInteger runningJobs = 0, maximumRunningJobs = 0, finishedJobs = 0;
+	__block NSMutableArray<NSNumber *> *startOrder = [NSMutableArray new];
+
+	queue.executor = ^(OCAsyncSequentialQueueJob  _Nonnull job, dispatch_block_t  _Nonnull completionHandler) {
+		dispatch_async(dispatch_get_main_queue(), ^{
+			job(completionHandler);
+		});
+	};
+	queue.maximumConcurrentJobs = 3;
+
+	for (NSUInteger jobIdx=0; jobIdx<10; jobIdx++)
+	{
+		[queue async:^(dispatch_block_t  _Nonnull completionHandler) {
+			// Executed on the main thread
+			[startOrder addObject:@(jobIdx)];
+
+			runningJobs++;
+			maximumRunningJobs = MAX(maximumRunningJobs, runningJobs);
+
+			dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.05 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+				runningJobs--;
+				finishedJobs++;
+
+				if (finishedJobs == 5)
+				{
+					// Lowering the limit only takes effect as running jobs finish
+					queue.maximumConcurrentJobs = 1;
+				}
+
+				completionHandler();
+
+				if (finishedJobs == 10)
+				{
+					[allJobsDoneExpectation fulfill];
+				}
+			});
+		}];
+	}
+
+	[self waitForExpectationsWithTimeout:5 handler:nil];
+
+	XCTAssert(maximumRunningJobs == 3);
+	XCTAssert(runningJobs == 0);
+	XCTAssertEqualObjects(startOrder, (@[ @0, @1, @2, @3, @4, @5, @6, @7, @8, @9 ]));
+}
+
 #pragma mark - Rate limiter
 - (void)testRateLimiter
 {
@@ -762,6 +1197,985 @@
 
 }
 
+- (void)testParentPathSharing
+{
+	OCPath parentPath = @"/documents/";
+
+	XCTAssert([@"/documents/file.txt" parentPathSharedWith:parentPath] == parentPath);
+	XCTAssert([@"/documents/folder/" parentPathSharedWith:parentPath] == parentPath);
+
+	XCTAssert([[@"/documents/folder/file.txt" parentPathSharedWith:parentPath] isEqual:@"/documents/folder/"]);
+	XCTAssert([[@"/other/file.txt" parentPathSharedWith:parentPath] isEqual:@"/other/"]);
+	XCTAssert([[@"/documents/" parentPathSharedWith:parentPath] isEqual:@"/"]);
+	XCTAssert([[@"/documents-2/file.txt" parentPathSharedWith:@"/documents"] isEqual:@"/documents-2/"]);
+	XCTAssert([[@"/file.txt" parentPathSharedWith:nil] isEqual:@"/"]);
+	XCTAssert([@"/file.txt" parentPathSharedWith:@"/"] != nil);
+}
+
+- (void)testStringInternPool
+{
+	OCStringInternPool *pool = [[OCStringInternPool alloc] initWithMaximumCount:3 maximumLength:16];
+	NSString *mimeType1 = [@"text/" stringByAppendingString:@"plain"];
+	NSString *mimeType2 = [@"text/" stringByAppendingString:@"plain"];
+	NSString *pooledMimeType;
+	const char *mimeTypeBytes = "text/plain";
+
+	XCTAssert(mimeType1 != mimeType2);
+
+	// Equal strings are replaced by the same instance
+	pooledMimeType = [pool internString:mimeType1];
+	XCTAssert([pooledMimeType isEqual:mimeType1]);
+	XCTAssert([pool internString:mimeType2] == pooledMimeType);
+	XCTAssert([pool internedStringWithBytes:mimeTypeBytes length:strlen(mimeTypeBytes)] == pooledMimeType);
+	XCTAssert(pool.count == 1);
+
+	// Strings exceeding the maximum length are not added
+	NSString *longString = @"application/vnd.openxmlformats-officedocument.wordprocessingml.document";
+	XCTAssert([pool internString:longString] == longString);
+	XCTAssert(pool.count == 1);
+
+	// Pool is bounded
+	XCTAssert([[pool internedStringWithBytes:"image/png" length:9] isEqual:@"image/png"]);
+	XCTAssert([[pool internString:@"image/jpeg"] isEqual:@"image/jpeg"]);
+	XCTAssert(pool.count == 3);
+
+	NSString *overflowString = [@"video/" stringByAppendingString:@"mp4"];
+	XCTAssert([pool internString:overflowString] == overflowString);
+	XCTAssert([[pool internedStringWithBytes:"video/mp4" length:9] isEqual:@"video/mp4"]);
+	XCTAssert(pool.count == 3);
+
+	XCTAssert([pool internString:nil] == nil);
+
+	[pool removeAllStrings];
+	XCTAssert(pool.count == 0);
+}
+
+- (void)testItemListMergeThroughput
+{
+	NSUInteger itemCount = 100000, changeStride = 100; // 1% changes
+	NSMutableArray<OCItem *> *cacheItems = [NSMutableArray new], *retrievedItems = [NSMutableArray new];
+	__block NSUInteger pairedCount = 0, newCount = 0, goneCount = 0, replacedCount = 0, movedCount = 0;
+	NSTimeInterval startTime, dictionaryDuration, mergeDuration;
+
+	for (NSUInteger idx=0; idx<itemCount; idx++)
+	{
+		@autoreleasepool {
+			OCItem *cacheItem = [OCItem new], *retrievedItem = [OCItem new];
+
+			cacheItem.path = [NSString stringWithFormat:@"/Folder/file %lu.txt", (unsigned long)idx];
+			cacheItem.fileID = [NSString stringWithFormat:@"%08luocnq90xhpk22", (unsigned long)idx];
+			cacheItem.eTag = @"\"e1\"";
+			[cacheItems addObject:cacheItem];
+
+			retrievedItem.path = cacheItem.path;
+			retrievedItem.fileID = cacheItem.fileID;
+			retrievedItem.eTag = cacheItem.eTag;
+
+			switch ((idx % changeStride == 0) ? ((idx / changeStride) % 4) : 4)
+			{
+				case 0: // Removed on server
+					retrievedItem = nil;
+				break;
+
+				case 1: // Replaced on server (same path, different fileID)
+					retrievedItem.fileID = [retrievedItem.fileID stringByAppendingString:@"-new"];
+				break;
+
+				case 2: // Moved on server
+					retrievedItem.path = [retrievedItem.path stringByAppendingString:@".moved"];
+				break;
+
+				case 3: // Modified on server
+					retrievedItem.eTag = @"\"e2\"";
+				break;
+			}
+
+			if (retrievedItem != nil)
+			{
+				[retrievedItems addObject:retrievedItem];
+			}
+		}
+	}
+
+	// Previous approach: lookup tables for both sets
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	@autoreleasepool {
+		OCCoreItemList *cacheSet = [OCCoreItemList itemListWithItems:cacheItems], *retrievedSet = [OCCoreItemList itemListWithItems:retrievedItems];
+		NSDictionary<OCFileID, OCItem *> *cacheItemsByFileID = cacheSet.itemsByFileID, *retrievedItemsByFileID = retrievedSet.itemsByFileID;
+		NSDictionary<OCPath, OCItem *> *cacheItemsByPath = cacheSet.itemsByPath, *retrievedItemsByPath = retrievedSet.itemsByPath;
+		__block NSUInteger pairCount = 0;
+
+		[retrievedItemsByFileID enumerateKeysAndObjectsUsingBlock:^(OCFileID fileID, OCItem *retrievedItem, BOOL *stop) {
+			if ((cacheItemsByFileID[fileID] != nil) || (cacheItemsByPath[retrievedItem.path] != nil)) { pairCount++; }
+		}];
+
+		[cacheItemsByFileID enumerateKeysAndObjectsUsingBlock:^(OCFileID fileID, OCItem *cacheItem, BOOL *stop) {
+			if ((retrievedItemsByFileID[fileID] == nil) && (retrievedItemsByPath[cacheItem.path] == nil)) { pairCount++; }
+		}];
+
+		XCTAssert(pairCount > 0);
+	}
+	dictionaryDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	// Single pass merge
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+	@autoreleasepool {
+		[[OCCoreItemList itemListWithItems:cacheItems] mergeWithRetrievedItemList:[OCCoreItemList itemListWithItems:retrievedItems] usingHandler:^(OCItem *cacheItem, OCItem *retrievedItem) {
+			if (cacheItem == nil) { newCount++; return; }
+			if (retrievedItem == nil) { goneCount++; return; }
+
+			pairedCount++;
+
+			if (![cacheItem.fileID isEqual:retrievedItem.fileID]) { replacedCount++; }
+			if (![cacheItem.path isEqual:retrievedItem.path]) { movedCount++; }
+		}];
+	}
+	mergeDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+	XCTAssert(pairedCount == (itemCount - (itemCount / changeStride / 4)), @"pairedCount=%lu", (unsigned long)pairedCount);
+	XCTAssert(goneCount == (itemCount / changeStride / 4));
+	XCTAssert(newCount == 0);
+	XCTAssert(replacedCount == (itemCount / changeStride / 4));
+	XCTAssert(movedCount == (itemCount / changeStride / 4));
+
+	// Items new on the server are reported in server order
+	{
+		NSMutableArray<OCItem *> *newItems = [NSMutableArray new];
+		OCItem *newItem1 = [OCItem new], *newItem2 = [OCItem new];
+
+		newItem1.path = @"/Folder/b.txt"; newItem1.fileID = @"b";
+		newItem2.path = @"/Folder/a.txt"; newItem2.fileID = @"a";
+
+		[[OCCoreItemList itemListWithItems:@[]] mergeWithRetrievedItemList:[OCCoreItemList itemListWithItems:@[ newItem1, newItem2 ]] usingHandler:^(OCItem *cacheItem, OCItem *retrievedItem) {
+			XCTAssert(cacheItem == nil);
+			[newItems addObject:retrievedItem];
+		}];
+
+		XCTAssert([newItems isEqual:(@[ newItem1, newItem2 ])]);
+	}
+
+	OCLog(@"Merge of %lu items with 1%% changes: lookup tables %.3f sec, single pass %.3f sec", (unsigned long)itemCount, dictionaryDuration, mergeDuration);
+}
+
+- (void)testItemListIndexes
+{
+	NSMutableArray<OCItem *> *items = [NSMutableArray new];
+	NSUInteger itemCount = 1000;
+
+	for (NSUInteger idx=0; idx<itemCount; idx++)
+	{
+		OCItem *item = [OCItem new];
+
+		item.path = [NSString stringWithFormat:@"/Folder %lu/file %lu.txt", (unsigned long)(idx % 10), (unsigned long)idx];
+		item.fileID = [NSString stringWithFormat:@"fileID-%lu", (unsigned long)idx];
+		item.localID = [NSString stringWithFormat:@"localID-%lu", (unsigned long)idx];
+
+		[items addObject:item];
+	}
+
+	// All indexes
+	OCCoreItemList *itemList = [OCCoreItemList itemListWithItems:items];
+
+	XCTAssert(itemList.itemsByPath.count == itemCount);
+	XCTAssert(itemList.itemsByFileID.count == itemCount);
+	XCTAssert(itemList.itemsByLocalID.count == itemCount);
+	XCTAssert(itemList.itemsByParentPaths.count == 10);
+	XCTAssert(itemList.itemParentPaths.count == 10);
+	XCTAssert(itemList.itemFileIDsSet.count == itemCount);
+
+	for (OCItem *item in items)
+	{
+		XCTAssert(itemList.itemsByPath[item.path] == item);
+		XCTAssert(itemList.itemsByPath[[item.path mutableCopy]] == item); // non-identical, equal key
+		XCTAssert(itemList.itemsByFileID[item.fileID] == item);
+		XCTAssert(itemList.itemsByLocalID[item.localID] == item);
+		XCTAssert([itemList.itemsByParentPaths[item.path.parentPath] containsObject:item]);
+	}
+
+	XCTAssert(itemList.itemsByPath[@"/Folder 0/missing.txt"] == nil);
+	XCTAssert(itemList.itemsByParentPaths[@"/Folder 0/"].count == (itemCount / 10));
+
+	NSUInteger enumeratedCount = 0;
+	for (OCPath path in itemList.itemsByPath)
+	{
+		XCTAssert(itemList.itemsByPath[path] != nil);
+		enumeratedCount++;
+	}
+	XCTAssert(enumeratedCount == itemCount);
+	XCTAssert([itemList.itemPathsSet isEqual:[NSSet setWithArray:[items valueForKey:@"path"]]]);
+
+	// Declared indexes only
+	itemList = [OCCoreItemList itemListWithItems:items indexes:OCCoreItemListIndexFileID];
+
+	XCTAssert(itemList.itemsByFileID.count == itemCount);
+	XCTAssert([itemList valueForKey:@"_itemsByPath"] == nil);
+	XCTAssert([itemList valueForKey:@"_itemsByLocalID"] == nil);
+
+	XCTAssert(itemList.itemsByLocalID[@"localID-1"] == items[1]); // Undeclared indexes are still built on access
+	XCTAssert([itemList valueForKey:@"_itemsByPath"] == nil);
+
+	// Replacing items drops the indexes
+	itemList.items = @[ items[0] ];
+	XCTAssert(itemList.itemsByFileID.count == 1);
+	XCTAssert(itemList.itemsByLocalID.count == 1);
+}
+
+#pragma mark - Query change sets
+- (NSArray<OCItem *> *)_applyChangeSet:(OCQueryChangeSet *)changeSet toResults:(NSArray<OCItem *> *)previousResults
+{
+	// Apply removals, insertions and moves as one batch update, then updates
+	NSMutableArray *results = [NSMutableArray new];
+	NSMutableIndexSet *movedFromIndexes = [NSMutableIndexSet new];
+	NSMutableArray<OCItem *> *remainingItems = [NSMutableArray new];
+	NSUInteger count = changeSet.queryResult.count, remainingIdx = 0;
+
+	for (NSNumber *previousIndex in changeSet.movedItemsPreviousIndexes) { [movedFromIndexes addIndex:previousIndex.unsignedIntegerValue]; }
+
+	[previousResults enumerateObjectsUsingBlock:^(OCItem *item, NSUInteger idx, BOOL *stop) {
+		if (![changeSet.removedItemsIndexSet containsIndex:idx] && ![movedFromIndexes containsIndex:idx])
+		{
+			[remainingItems addObject:item];
+		}
+	}];
+
+	for (NSUInteger idx=0; idx<count; idx++)
+	{
+		NSUInteger changeIndex;
+
+		if ([changeSet.insertedItemsIndexSet containsIndex:idx])
+		{
+			changeIndex = [changeSet.insertedItemsIndexSet countOfIndexesInRange:NSMakeRange(0, idx)];
+			[results addObject:changeSet.insertedItems[changeIndex]];
+		}
+		else if ([changeSet.movedItemsIndexSet containsIndex:idx])
+		{
+			changeIndex = [changeSet.movedItemsIndexSet countOfIndexesInRange:NSMakeRange(0, idx)];
+			[results addObject:changeSet.movedItems[changeIndex]];
+		}
+		else if (remainingIdx < remainingItems.count)
+		{
+			[results addObject:remainingItems[remainingIdx++]];
+		}
+	}
+
+	XCTAssert(remainingIdx == remainingItems.count);
+
+	[changeSet.updatedItemsIndexSet enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+		results[idx] = changeSet.updatedItems[[changeSet.updatedItemsIndexSet countOfIndexesInRange:NSMakeRange(0, idx)]];
+	}];
+
+	return (results);
+}
+
+- (OCItem *)_itemWithLocalID:(NSString *)localID name:(NSString *)name
+{
+	OCItem *item = [OCItem new];
+
+	item.localID = localID;
+	item.path = [@"/" stringByAppendingString:name];
+
+	return (item);
+}
+
+- (void)testQueryChangeSetComputation
+{
+	OCItem *a = [self _itemWithLocalID:@"a" name:@"a"], *b = [self _itemWithLocalID:@"b" name:@"b"], *c = [self _itemWithLocalID:@"c" name:@"c"], *d = [self _itemWithLocalID:@"d" name:@"d"], *e = [self _itemWithLocalID:@"e" name:@"e"];
+	OCItem *updatedC = [self _itemWithLocalID:@"c" name:@"c"], *f = [self _itemWithLocalID:@"f" name:@"f"];
+	NSArray<OCItem *> *previousResults = @[ a, b, c, d, e ], *results = @[ a, updatedC, f, b, e ];
+	OCQueryChangeSet *changeSet;
+
+	changeSet = [[OCQueryChangeSet alloc] initWithQueryResult:results relativeTo:previousResults];
+
+	XCTAssert(!changeSet.contentSwap);
+	XCTAssert(changeSet.containsChanges);
+	XCTAssert([changeSet.removedItemsIndexSet isEqual:[NSIndexSet indexSetWithIndex:3]]);
+	XCTAssert([changeSet.removedItems isEqual:@[ d ]]);
+	XCTAssert([changeSet.insertedItemsIndexSet isEqual:[NSIndexSet indexSetWithIndex:2]]);
+	XCTAssert([changeSet.insertedItems isEqual:@[ f ]]);
+	XCTAssert([changeSet.updatedItemsIndexSet isEqual:[NSIndexSet indexSetWithIndex:1]]);
+	XCTAssert([changeSet.movedItemsIndexSet isEqual:[NSIndexSet indexSetWithIndex:3]]);
+	XCTAssert([changeSet.movedItemsPreviousIndexes isEqual:@[ @(1) ]]);
+
+	XCTAssert([[self _applyChangeSet:changeSet toResults:previousResults] isEqual:results]);
+
+	// No previous results => content swap
+	changeSet = [[OCQueryChangeSet alloc] initWithQueryResult:results relativeTo:nil];
+	XCTAssert(changeSet.contentSwap);
+
+	// No changes
+	changeSet = [[OCQueryChangeSet alloc] initWithQueryResult:results relativeTo:results];
+	XCTAssert(!changeSet.containsChanges);
+}
+
+- (void)testQueryIncrementalChangeSets
+{
+	NSUInteger itemCount = 100000, changeCount = 100;
+	OCQuery *query = [OCQuery queryWithCustomSource:^(OCCore *core, OCQuery *query, OCQueryCustomResultHandler resultHandler) {
+		resultHandler(nil, nil);
+	} inputFilter:[OCQueryFilter filterWithHandler:^BOOL(OCQuery *query, OCQueryFilter *filter, OCItem *item) {
+		return (YES);
+	}]];
+	NSMutableArray<OCItem *> *items = [NSMutableArray new];
+	NSMutableArray<OCItem *> *addedItems = [NSMutableArray new], *updatedItems = [NSMutableArray new], *removedItems = [NSMutableArray new];
+	__block NSArray<OCItem *> *previousResults = nil;
+	__block OCQueryChangeSet *changeSet = nil;
+	XCTestExpectation *initialChangeSetExpectation = [self expectationWithDescription:@"Initial change set"];
+	XCTestExpectation *changeSetExpectation = [self expectationWithDescription:@"Change set"];
+	NSTimeInterval startTime;
+
+	query.sortComparator = ^NSComparisonResult(OCItem *item1, OCItem *item2) {
+		return ([item1.name compare:item2.name]);
+	};
+
+	for (NSUInteger idx=0; idx<itemCount; idx++)
+	{
+		[items addObject:[self _itemWithLocalID:[NSString stringWithFormat:@"%lu", (unsigned long)idx] name:[NSString stringWithFormat:@"%08lu", (unsigned long)(idx * 2)]]];
+	}
+
+	[query setFullQueryResults:[items mutableCopy]];
+
+	[query requestChangeSetWithFlags:OCQueryChangeSetRequestFlagDefault completionHandler:^(OCQuery *query, OCQueryChangeSet *initialChangeSet) {
+		XCTAssert(initialChangeSet.contentSwap);
+		previousResults = initialChangeSet.queryResult;
+		[initialChangeSetExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ initialChangeSetExpectation ] timeout:10];
+
+	// Changes: new items, renamed items (moving to a different position), removed items
+	for (NSUInteger idx=0; idx<changeCount; idx++)
+	{
+		NSUInteger itemIndex = (idx * 997) % itemCount;
+
+		switch (idx % 3)
+		{
+			case 0:
+				[addedItems addObject:[self _itemWithLocalID:[NSString stringWithFormat:@"new-%lu", (unsigned long)idx] name:[NSString stringWithFormat:@"%08lu", (unsigned long)(itemIndex * 2) + 1]]];
+			break;
+
+			case 1:
+				[updatedItems addObject:[self _itemWithLocalID:items[itemIndex].localID name:[NSString stringWithFormat:@"%08lu", (unsigned long)(((itemIndex + 5000) % itemCount) * 2) + 1]]];
+			break;
+
+			case 2:
+				[removedItems addObject:items[itemIndex]];
+			break;
+		}
+	}
+
+	startTime = NSDate.timeIntervalSinceReferenceDate;
+
+	[query updateWithAddedItems:[OCCoreItemList itemListWithItems:addedItems] updatedItems:[OCCoreItemList itemListWithItems:updatedItems] removedItems:[OCCoreItemList itemListWithItems:removedItems]];
+
+	[query requestChangeSetWithFlags:OCQueryChangeSetRequestFlagDefault completionHandler:^(OCQuery *query, OCQueryChangeSet *incrementalChangeSet) {
+		changeSet = incrementalChangeSet;
+		[changeSetExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ changeSetExpectation ] timeout:10];
+
+	OCLog(@"Applying %lu changes to %lu items and computing the change set took %.3f sec", (unsigned long)changeCount, (unsigned long)itemCount, NSDate.timeIntervalSinceReferenceDate - startTime);
+
+	XCTAssert(!changeSet.contentSwap);
+	XCTAssert(changeSet.insertedItems.count == addedItems.count);
+	XCTAssert(changeSet.removedItems.count == removedItems.count);
+	XCTAssert(changeSet.updatedItems.count == updatedItems.count);
+	XCTAssert(changeSet.movedItems.count == updatedItems.count);
+	XCTAssert(changeSet.queryResult.count == (itemCount + addedItems.count - removedItems.count));
+
+	// Results are still sorted ..
+	XCTAssert([changeSet.queryResult isEqual:[changeSet.queryResult sortedArrayUsingComparator:query.sortComparator]]);
+
+	// .. and the change set transforms the previous results into them
+	XCTAssert([[self _applyChangeSet:changeSet toResults:previousResults] isEqual:changeSet.queryResult]);
+
+	// Previously handed out results are unaffected
+	XCTAssert(previousResults.count == itemCount);
+}
+
+- (void)testWindowedQueryIndexShifts
+{
+	OCWindowedQuery *query = [OCWindowedQuery queryForFolderPath:@"/" window:NSMakeRange(100, 10)];
+	NSMutableArray<OCItem *> *materializedItems = [NSMutableArray new];
+	XCTestExpectation *changeSetExpectation = [self expectationWithDescription:@"Change set received"];
+
+	query.prefetchMargin = 5;
+
+	// Rows 95..114 of 1000 rows named item0000..item0999 are materialized
+	for (NSUInteger idx=95; idx < 115; idx++)
+	{
+		[materializedItems addObject:[self _itemWithLocalID:[NSString stringWithFormat:@"%lu", (unsigned long)idx] name:[NSString stringWithFormat:@"item%04lu", (unsigned long)idx]]];
+	}
+
+	[query _finishLoadForGeneration:0 error:nil numberOfItems:1000 range:NSMakeRange(95, 20) items:materializedItems];
+	[query requestWindowChangeSetWithCompletionHandler:^(OCWindowedQuery *query, OCQueryWindowChangeSet *changeSet) {
+		XCTAssert(changeSet.reset);
+	}];
+
+	XCTAssert(query.numberOfItems == 1000);
+	XCTAssert(NSEqualRanges(query.materializedRange, NSMakeRange(95, 20)));
+	XCTAssert([[query itemAtIndex:100].localID isEqual:@"100"]);
+	XCTAssert([query itemAtIndex:94] == nil);
+
+	// Two insertions before the materialized rows, one inside, one after, one removal inside
+	[query updateWithAddedItems:[OCCoreItemList itemListWithItems:@[
+		[self _itemWithLocalID:@"new1" name:@"item0010a"],
+		[self _itemWithLocalID:@"new2" name:@"item0020a"],
+		[self _itemWithLocalID:@"new3" name:@"item0102a"],
+		[self _itemWithLocalID:@"new4" name:@"item0500a"]
+	]] updatedItems:[OCCoreItemList itemListWithItems:@[
+		[self _itemWithLocalID:@"105" name:@"item0105"]
+	]] removedItems:[OCCoreItemList itemListWithItems:@[
+		[self _itemWithLocalID:@"110" name:@"item0110"]
+	]]];
+
+	XCTAssert(query.numberOfItems == 1003);
+	XCTAssert(NSEqualRanges(query.materializedRange, NSMakeRange(97, 20)), @"materializedRange: %@", NSStringFromRange(query.materializedRange));
+	XCTAssert([[query itemAtIndex:102].localID isEqual:@"100"]);
+	XCTAssert([[query itemAtIndex:105].localID isEqual:@"new3"]);
+
+	[query requestWindowChangeSetWithCompletionHandler:^(OCWindowedQuery *query, OCQueryWindowChangeSet *changeSet) {
+		NSArray<OCQueryIndexShift *> *shifts = changeSet.indexShifts;
+
+		XCTAssert(!changeSet.reset);
+		XCTAssert(changeSet.numberOfItems == 1003);
+
+		// Removal of row 110, insertions before the materialized rows (coalesced), insertion of row 105 (after shifting by 2)
+		XCTAssert(shifts.count == 3, @"shifts: %@", shifts);
+		XCTAssert((shifts[0].index == 110) && (shifts[0].delta == -1), @"shifts: %@", shifts);
+		XCTAssert((shifts[1].index == 95) && (shifts[1].delta == 2), @"shifts: %@", shifts);
+		XCTAssert((shifts[2].index == 105) && (shifts[2].delta == 1), @"shifts: %@", shifts);
+
+		XCTAssert([changeSet.updatedIndexes isEqual:[NSIndexSet indexSetWithIndex:108]], @"updatedIndexes: %@", changeSet.updatedIndexes);
+
+		[changeSetExpectation fulfill];
+	}];
+
+	[self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+- (OCItem *)_itemWithLocalID:(NSString *)localID name:(NSString *)name movedTo:(OCPath)folderPath
+{
+	OCItem *item = [self _itemWithLocalID:localID name:name];
+
+	item.previousPath = item.path;
+	item.path = [folderPath stringByAppendingString:name];
+
+	return (item);
+}
+
+- (void)testWindowedQueryMoveOutOfFolder
+{
+	OCWindowedQuery *query = [OCWindowedQuery queryForFolderPath:@"/" window:NSMakeRange(100, 10)];
+	NSMutableArray<OCItem *> *materializedItems = [NSMutableArray new];
+	XCTestExpectation *changeSetExpectation = [self expectationWithDescription:@"Change set received"];
+	OCItem *removedFirstRow, *removedBeforeRows;
+
+	query.prefetchMargin = 5;
+
+	// Rows 95..114 of 1000 rows named item0000..item0999 are materialized
+	for (NSUInteger idx=95; idx < 115; idx++)
+	{
+		[materializedItems addObject:[self _itemWithLocalID:[NSString stringWithFormat:@"%lu", (unsigned long)idx] name:[NSString stringWithFormat:@"item%04lu", (unsigned long)idx]]];
+	}
+
+	[query _finishLoadForGeneration:0 error:nil numberOfItems:1000 range:NSMakeRange(95, 20) items:materializedItems];
+	[query requestWindowChangeSetWithCompletionHandler:^(OCWindowedQuery *query, OCQueryWindowChangeSet *changeSet) {
+		XCTAssert(changeSet.reset);
+	}];
+
+	// Items moved to another folder arrive twice, like from OCCore: as updated item with a previousPath and as relocated, removed copy at the previous path
+	removedFirstRow = [self _itemWithLocalID:@"95" name:@"item0095"];
+	removedFirstRow.removed = YES;
+
+	removedBeforeRows = [self _itemWithLocalID:@"50" name:@"item0050"];
+	removedBeforeRows.removed = YES;
+
+	[query updateWithAddedItems:nil updatedItems:[OCCoreItemList itemListWithItems:@[
+		[self _itemWithLocalID:@"95" name:@"item0095" movedTo:@"/Other/"],
+		[self _itemWithLocalID:@"50" name:@"item0050" movedTo:@"/Other/"]
+	]] removedItems:[OCCoreItemList itemListWithItems:@[
+		removedFirstRow,
+		removedBeforeRows
+	]]];
+
+	// Each moved item is only removed once
+	XCTAssert(query.numberOfItems == 998, @"numberOfItems: %lu", (unsigned long)query.numberOfItems);
+	XCTAssert(NSEqualRanges(query.materializedRange, NSMakeRange(94, 19)), @"materializedRange: %@", NSStringFromRange(query.materializedRange));
+	XCTAssert([[query itemAtIndex:94].localID isEqual:@"96"]);
+	XCTAssert([query itemAtIndex:93] == nil);
+
+	[query requestWindowChangeSetWithCompletionHandler:^(OCWindowedQuery *query, OCQueryWindowChangeSet *changeSet) {
+		NSInteger totalDelta = 0;
+
+		XCTAssert(!changeSet.reset);
+		XCTAssert(changeSet.numberOfItems == 998);
+
+		for (OCQueryIndexShift *shift in changeSet.indexShifts)
+		{
+			totalDelta += shift.delta;
+		}
+
+		XCTAssert(totalDelta == -2, @"shifts: %@", changeSet.indexShifts);
+
+		[changeSetExpectation fulfill];
+	}];
+
+	[self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+#pragma mark - Sync ready queue
+- (OCSyncLane *)_laneWithID:(NSUInteger)laneID after:(NSArray<OCSyncLaneID> *)afterLaneIDs
+{
+	OCSyncLane *lane = [OCSyncLane new];
+
+	lane.identifier = @(laneID);
+	lane.afterLanes = (afterLaneIDs != nil) ? [NSSet setWithArray:afterLaneIDs] : nil;
+
+	return (lane);
+}
+
+- (void)testSyncReadyQueue
+{
+	OCSyncReadyQueue *queue = [OCSyncReadyQueue new];
+
+	XCTAssert(queue.needsFullScan);
+
+	[queue resetWithLanes:@[
+		[self _laneWithID:1 after:nil],
+		[self _laneWithID:2 after:nil],
+		[self _laneWithID:3 after:@[ @(1) ]]
+	]];
+
+	XCTAssert(!queue.needsFullScan);
+	XCTAssert(!queue.hasReadyLanes);
+	XCTAssert(queue.numberOfLanes == 3);
+
+	// Triggers
+	[queue setLaneID:@(2) forRecordID:@(20)];
+	[queue markRecordIDReady:@(20)];
+	[queue markRecordIDReady:@(99)];
+
+	XCTAssert([[queue dequeueReadyLaneIDs] isEqual:@[ @(2) ]]);
+	XCTAssert([[queue dequeueUnresolvedRecordIDs] isEqual:@[ @(99) ]]);
+	XCTAssert(!queue.hasReadyLanes);
+
+	// Dependencies: removal of lane 1 releases lane 3
+	XCTAssert([queue isLaneWaitingForPredecessors:[queue laneForID:@(3)]]);
+
+	[queue removeLaneID:@(1)];
+
+	XCTAssert(![queue isLaneWaitingForPredecessors:[queue laneForID:@(3)]]);
+	XCTAssert([[queue dequeueReadyLaneIDs] isEqual:@[ @(3) ]]);
+
+	// Budget: lane 3 is blocked until lane 2 releases budget
+	[queue beginProcessingLaneID:@(2)];
+	[queue updateBudgetUsageOfLaneID:@(2) categories:@[ OCSyncActionCategoryTransfer ] change:1];
+	[queue endProcessingLaneID:@(2) active:YES];
+
+	XCTAssert([queue numberOfRunningActionsInCategory:OCSyncActionCategoryTransfer] == 1);
+
+	[queue markLaneIDBudgetBlocked:@(3)];
+
+	[queue beginProcessingLaneID:@(2)];
+	XCTAssert([queue numberOfRunningActionsInCategory:OCSyncActionCategoryTransfer] == 0);
+	[queue updateBudgetUsageOfLaneID:@(2) categories:@[ OCSyncActionCategoryTransfer ] change:1];
+	[queue endProcessingLaneID:@(2) active:YES];
+
+	XCTAssert(!queue.hasReadyLanes); // same budget usage as before => lane 3 stays blocked
+
+	[queue beginProcessingLaneID:@(2)];
+	[queue endProcessingLaneID:@(2) active:YES];
+
+	XCTAssert([[queue dequeueReadyLaneIDs] isEqual:@[ @(3) ]]);
+
+	// Lane limit: lane 3 can't start while lane 2 occupies the only slot
+	XCTAssert([queue canProcessLaneID:@(2) maximumActiveLanes:1]);
+	XCTAssert(![queue canProcessLaneID:@(3) maximumActiveLanes:1]);
+	XCTAssert([queue canProcessLaneID:@(3) maximumActiveLanes:0]);
+
+	[queue beginProcessingLaneID:@(2)];
+	[queue endProcessingLaneID:@(2) active:NO];
+
+	XCTAssert([[queue dequeueReadyLaneIDs] isEqual:@[ @(3) ]]);
+
+	// Wait condition deadlines (tracked with a resolution of one second)
+	NSDate *now = [NSDate dateWithTimeIntervalSinceReferenceDate:ceil(NSDate.timeIntervalSinceReferenceDate)];
+
+	[queue setLaneID:@(3) forRecordID:@(30)];
+	[queue setWaitConditionDeadline:[now dateByAddingTimeInterval:10] forRecordID:@(20)];
+	[queue setWaitConditionDeadline:[now dateByAddingTimeInterval:5] forRecordID:@(30)];
+
+	XCTAssert([queue.nextWaitConditionDeadline isEqual:[now dateByAddingTimeInterval:5]]);
+	XCTAssert([queue markRecordsReadyWithWaitConditionDeadlinesUpTo:[now dateByAddingTimeInterval:6]] == 1);
+	XCTAssert([[queue dequeueReadyLaneIDs] isEqual:@[ @(3) ]]);
+	XCTAssert([queue.nextWaitConditionDeadline isEqual:[now dateByAddingTimeInterval:10]]);
+
+	// Record removal marks its lane ready
+	[queue removeRecordID:@(20)];
+
+	XCTAssert([[queue dequeueReadyLaneIDs] isEqual:@[ @(2) ]]);
+	XCTAssert(queue.nextWaitConditionDeadline == nil);
+
+	// Full scan request
+	[queue setNeedsFullScan];
+	XCTAssert(queue.needsFullScan);
+}
+
+- (void)testSyncReadyQueueThroughput
+{
+	OCSyncReadyQueue *queue = [OCSyncReadyQueue new];
+	NSMutableArray<OCSyncLane *> *lanes = [NSMutableArray new];
+	NSUInteger laneCount = 10000;
+
+	for (NSUInteger laneID=1; laneID <= laneCount; laneID++)
+	{
+		[lanes addObject:[self _laneWithID:laneID after:nil]];
+	}
+
+	[queue resetWithLanes:lanes];
+
+	for (NSUInteger laneID=1; laneID <= laneCount; laneID++)
+	{
+		[queue setLaneID:@(laneID) forRecordID:@(laneID * 10)];
+	}
+
+	// A single event must only make its own lane ready, regardless of the number of lanes
+	[self measureBlock:^{
+		for (NSUInteger i=0; i<1000; i++)
+		{
+			[queue markRecordIDReady:@(((i * 7919) % laneCount + 1) * 10)];
+
+			XCTAssert([queue dequeueReadyLaneIDs].count == 1);
+		}
+	}];
+}
+
+- (void)testSyncEngineTargetedProcessing
+{
+	// processSyncRecords with 10000 records on 10000 lanes in the database: a full scan vs. a targeted run after a trigger for a single record. All records are
+	// in processing, so every processed lane is read from the database and its first record processed - but no action is started.
+	OCHostSimulatorSyntheticTree *tree = [[OCHostSimulatorSyntheticTree alloc] initWithSeed:42 depth:1 folderFanOut:1 filesPerFolder:1];
+	OCHostSimulator *simulator = [OCHostSimulator syntheticTreeSimulatorWithTree:tree userName:nil];
+	OCBookmark *bookmark = [OCBookmark bookmarkForURL:[NSURL URLWithString:@"http://synthetic.owncloud.test/"]];
+	XCTestExpectation *coreStartedExpectation = [self expectationWithDescription:@"Core started"];
+	XCTestExpectation *recordsAddedExpectation = [self expectationWithDescription:@"Records added"];
+	XCTestExpectation *processedExpectation = [self expectationWithDescription:@"Sync records processed"];
+	XCTestExpectation *coreStoppedExpectation = [self expectationWithDescription:@"Core stopped"];
+	NSMutableArray<OCSyncRecord *> *syncRecords = [NSMutableArray new];
+	NSUInteger recordCount = 10000;
+	__block NSTimeInterval fullScanDuration = 0, targetedDuration = 0;
+	OCSyncReadyQueue *readyQueue;
+	OCCore *core;
+
+	bookmark.authenticationData = [OCAuthenticationMethodBasicAuth authenticationDataForUsername:@"admin" passphrase:@"admin" authenticationHeaderValue:NULL error:NULL];
+	bookmark.authenticationMethodIdentifier = OCAuthenticationMethodIdentifierBasicAuth;
+
+	core = [[OCCore alloc] initWithBookmark:bookmark];
+	core.automaticItemListUpdatesEnabled = NO;
+	core.connection.hostSimulator = simulator;
+
+	[core startWithCompletionHandler:^(OCCore *core, NSError *error) {
+		XCTAssert(error == nil, @"Started with error: %@", error);
+		[coreStartedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ coreStartedExpectation ] timeout:30];
+
+	readyQueue = [core valueForKey:@"syncReadyQueue"];
+
+	// Add one lane per record, bypassing the sync engine
+	for (NSUInteger i=0; i<recordCount; i++)
+	{
+		OCSyncRecord *syncRecord = [[OCSyncRecord alloc] initWithAction:[[OCSyncActionLocalCopyDelete alloc] initWithItem:[self _itemWithLocalID:[NSString stringWithFormat:@"localID-%lu", (unsigned long)i] name:[NSString stringWithFormat:@"file-%lu", (unsigned long)i]]] resultHandler:nil];
+
+		[syncRecord transitionToState:OCSyncRecordStateProcessing withWaitConditions:nil];
+
+		[syncRecords addObject:syncRecord];
+	}
+
+	[core.vault.database.sqlDB executeTransaction:[OCSQLiteTransaction transactionWithBlock:^NSError * _Nullable(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction) {
+		__block NSError *error = nil;
+
+		for (OCSyncRecord *syncRecord in syncRecords)
+		{
+			OCSyncLane *lane = [OCSyncLane new];
+
+			[core.vault.database addSyncLane:lane completionHandler:^(OCDatabase *db, NSError *laneError) {
+				if (laneError != nil) { error = laneError; }
+			}];
+
+			syncRecord.laneID = lane.identifier;
+		}
+
+		[core.vault.database addSyncRecords:syncRecords completionHandler:^(OCDatabase *db, NSError *recordsError) {
+			if (recordsError != nil) { error = recordsError; }
+		}];
+
+		return (error);
+	} type:OCSQLiteTransactionTypeExclusive completionHandler:^(OCSQLiteDB * _Nonnull db, OCSQLiteTransaction * _Nonnull transaction, NSError * _Nullable error) {
+		XCTAssert(error == nil, @"Adding sync records failed with error: %@", error);
+		[recordsAddedExpectation fulfill];
+	}]];
+
+	[self waitForExpectations:@[ recordsAddedExpectation ] timeout:120];
+
+	XCTAssert(syncRecords.lastObject.recordID != nil);
+
+	[core queueBlock:^{
+		NSTimeInterval startTime;
+
+		// Full scan
+		[readyQueue setNeedsFullScan];
+
+		startTime = NSDate.timeIntervalSinceReferenceDate;
+		[core processSyncRecords];
+		fullScanDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+		XCTAssert(!readyQueue.needsFullScan);
+		XCTAssert(readyQueue.numberOfLanes >= recordCount, @"%lu lanes known after full scan", (unsigned long)readyQueue.numberOfLanes);
+
+		// Targeted run, triggered by an event for a single record
+		[readyQueue markRecordIDReady:syncRecords[recordCount / 2].recordID];
+
+		startTime = NSDate.timeIntervalSinceReferenceDate;
+		[core processSyncRecords];
+		targetedDuration = NSDate.timeIntervalSinceReferenceDate - startTime;
+
+		XCTAssert(!readyQueue.hasReadyLanes);
+
+		[processedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ processedExpectation ] timeout:300];
+
+	OCLog(@"processSyncRecords with %lu queued records: full scan took %.3f sec, targeted run took %.3f sec", (unsigned long)recordCount, fullScanDuration, targetedDuration);
+
+	XCTAssert(targetedDuration < (fullScanDuration / 10), @"Targeted run (%.3f sec) not significantly faster than full scan (%.3f sec)", targetedDuration, fullScanDuration);
+
+	[core stopWithCompletionHandler:^(id sender, NSError *error) {
+		[coreStoppedExpectation fulfill];
+	}];
+
+	[self waitForExpectations:@[ coreStoppedExpectation ] timeout:30];
+
+	// Erase vault
+	[core.vault eraseSyncWithCompletionHandler:^(id sender, NSError *error) {
+		XCTAssert((error==nil), @"Erased with error: %@", error);
+	}];
+}
+
+#pragma mark - Transfer scheduling
+- (void)testTransferSchedulerOrdering
+{
+	OCSyncTransferScheduler *scheduler = [OCSyncTransferScheduler new];
+	NSDate *now = [NSDate new];
+	NSArray<OCSyncTransferCandidate *> *candidates = @[
+		[scheduler candidateForLaneID:@(1) recordID:@(10) size:2000000000 date:now],
+		[scheduler candidateForLaneID:@(2) recordID:@(20) size:5000 date:now],
+		[scheduler candidateForLaneID:@(3) recordID:@(30) size:500000000 date:now],
+		[scheduler candidateForLaneID:@(4) recordID:@(40) size:1000 date:now]
+	];
+	NSArray<OCSyncLaneID> *(^LaneIDs)(NSArray<OCSyncTransferCandidate *> *) = ^(NSArray<OCSyncTransferCandidate *> *orderedCandidates) {
+		return ([orderedCandidates valueForKey:@"laneID"]);
+	};
+
+	scheduler.largeTransferThreshold = 100000000;
+	scheduler.agingInterval = 60;
+
+	// Shortest first - with the smallest large transfer moved to the front while no large transfer is running
+	XCTAssert([LaneIDs([scheduler orderCandidates:candidates runningLargeTransfers:0 date:now]) isEqual:(@[ @(3), @(4), @(2), @(1) ])]);
+	XCTAssert([LaneIDs([scheduler orderCandidates:candidates runningLargeTransfers:1 date:now]) isEqual:(@[ @(4), @(2), @(3), @(1) ])]);
+
+	// Aging: a 2 GB transfer that has been waiting for 20 minutes goes before a 5 KB transfer that just started waiting
+	[scheduler removeRecordID:@(10)];
+	[scheduler removeRecordID:@(20)];
+
+	candidates = @[
+		[scheduler candidateForLaneID:@(1) recordID:@(10) size:2000000000 date:[now dateByAddingTimeInterval:-20 * 60]],
+		[scheduler candidateForLaneID:@(2) recordID:@(20) size:5000 date:now]
+	];
+
+	XCTAssert([[scheduler candidateForLaneID:@(1) recordID:@(10) size:2000000000 date:now].waitingSince isEqual:[now dateByAddingTimeInterval:-20 * 60]]);
+
+	XCTAssert([LaneIDs([scheduler orderCandidates:candidates runningLargeTransfers:1 date:now]) isEqual:(@[ @(1), @(2) ])]);
+	XCTAssert([LaneIDs([scheduler orderCandidates:candidates runningLargeTransfers:1 date:[now dateByAddingTimeInterval:-19 * 60]]) isEqual:(@[ @(2), @(1) ])]);
+
+	// Lane order
+	scheduler.policy = OCSyncTransferSchedulingPolicyLaneOrder;
+	XCTAssert(!scheduler.defersTransfers);
+	XCTAssert([LaneIDs([scheduler orderCandidates:candidates.reverseObjectEnumerator.allObjects runningLargeTransfers:0 date:now]) isEqual:(@[ @(1), @(2) ])]);
+}
+
+- (NSArray<NSNumber *> *)_simulateTransfersOfSizes:(NSArray<NSNumber *> *)sizes withPolicy:(OCSyncTransferSchedulingPolicy)policy slots:(NSUInteger)slots bytesPerSecond:(double)bytesPerSecond
+{
+	OCSyncTransferScheduler *scheduler = [OCSyncTransferScheduler new];
+	NSMutableArray<OCSyncTransferCandidate *> *waitingCandidates = [NSMutableArray new];
+	NSMutableDictionary<OCSyncLaneID, NSNumber *> *finishTimesByLaneID = [NSMutableDictionary new];
+	NSMutableArray<NSNumber *> *completionTimes = [NSMutableArray arrayWithCapacity:sizes.count];
+	NSDate *startDate = [NSDate new];
+	NSTimeInterval time = 0;
+
+	scheduler.policy = policy;
+
+	[sizes enumerateObjectsUsingBlock:^(NSNumber *size, NSUInteger idx, BOOL *stop) {
+		[waitingCandidates addObject:[scheduler candidateForLaneID:@(idx) recordID:@(idx) size:size.unsignedLongLongValue date:startDate]];
+		[completionTimes addObject:@(0)];
+	}];
+
+	while ((waitingCandidates.count > 0) || (finishTimesByLaneID.count > 0))
+	{
+		// Start transfers while slots are available
+		while ((finishTimesByLaneID.count < slots) && (waitingCandidates.count > 0))
+		{
+			__block NSUInteger runningLargeTransfers = 0;
+
+			[finishTimesByLaneID enumerateKeysAndObjectsUsingBlock:^(OCSyncLaneID laneID, NSNumber *finishTime, BOOL *stop) {
+				if ([scheduler isLargeTransferSize:sizes[laneID.unsignedIntegerValue].unsignedLongLongValue])
+				{
+					runningLargeTransfers++;
+				}
+			}];
+
+			OCSyncTransferCandidate *candidate = [scheduler orderCandidates:waitingCandidates runningLargeTransfers:runningLargeTransfers date:[startDate dateByAddingTimeInterval:time]].firstObject;
+
+			[waitingCandidates removeObject:candidate];
+			finishTimesByLaneID[candidate.laneID] = @(time + ((double)candidate.size / bytesPerSecond));
+		}
+
+		// Complete the transfer finishing next
+		OCSyncLaneID nextLaneID = [finishTimesByLaneID keysSortedByValueUsingSelector:@selector(compare:)].firstObject;
+
+		time = finishTimesByLaneID[nextLaneID].doubleValue;
+		[finishTimesByLaneID removeObjectForKey:nextLaneID];
+
+		completionTimes[nextLaneID.unsignedIntegerValue] = @(time);
+	}
+
+	return (completionTimes); // in the order of sizes
+}
+
+- (void)testTransferSchedulingCompletionTimes
+{
+	NSMutableArray<NSNumber *> *sizes = [NSMutableArray new];
+	unsigned long long largeSize = 2000000000;
+
+	// 3 multi-gigabyte uploads scheduled ahead of 1000 small ones
+	for (NSUInteger i=0; i<3; i++)
+	{
+		[sizes addObject:@(largeSize)];
+	}
+
+	for (NSUInteger i=0; i<1000; i++)
+	{
+		[sizes addObject:@(50000 + ((i * 7919) % 450000))];
+	}
+
+	NSArray<NSNumber *> *laneOrderTimes = [self _simulateTransfersOfSizes:sizes withPolicy:OCSyncTransferSchedulingPolicyLaneOrder slots:3 bytesPerSecond:10000000];
+	NSArray<NSNumber *> *shortestFirstTimes = [self _simulateTransfersOfSizes:sizes withPolicy:OCSyncTransferSchedulingPolicyShortestFirst slots:3 bytesPerSecond:10000000];
+	NSArray<NSNumber *> *laneOrderLargeTimes = [[laneOrderTimes subarrayWithRange:NSMakeRange(0, 3)] sortedArrayUsingSelector:@selector(compare:)];
+	NSArray<NSNumber *> *shortestFirstLargeTimes = [[shortestFirstTimes subarrayWithRange:NSMakeRange(0, 3)] sortedArrayUsingSelector:@selector(compare:)];
+
+	laneOrderTimes = [laneOrderTimes sortedArrayUsingSelector:@selector(compare:)];
+	shortestFirstTimes = [shortestFirstTimes sortedArrayUsingSelector:@selector(compare:)];
+
+	double laneOrderMedian = laneOrderTimes[laneOrderTimes.count / 2].doubleValue, laneOrderP95 = laneOrderTimes[(laneOrderTimes.count * 95) / 100].doubleValue;
+	double shortestFirstMedian = shortestFirstTimes[shortestFirstTimes.count / 2].doubleValue, shortestFirstP95 = shortestFirstTimes[(shortestFirstTimes.count * 95) / 100].doubleValue;
+
+	XCTAssert(shortestFirstMedian < (laneOrderMedian / 10), @"Median time to completion: shortest first=%.1fs, lane order=%.1fs", shortestFirstMedian, laneOrderMedian);
+	XCTAssert(shortestFirstP95 < (laneOrderP95 / 10), @"p95 time to completion: shortest first=%.1fs, lane order=%.1fs", shortestFirstP95, laneOrderP95);
+
+	// The reserved slot keeps a large transfer running from the start, so the first large transfer completes as early as with lane order
+	XCTAssert(shortestFirstLargeTimes.firstObject.doubleValue <= (laneOrderLargeTimes.firstObject.doubleValue + 0.001), @"First large transfer completed: shortest first=%.1fs, lane order=%.1fs", shortestFirstLargeTimes.firstObject.doubleValue, laneOrderLargeTimes.firstObject.doubleValue);
+	XCTAssert(shortestFirstTimes.lastObject.doubleValue < (laneOrderTimes.lastObject.doubleValue * 1.2), @"All transfers completed: shortest first=%.1fs, lane order=%.1fs", shortestFirstTimes.lastObject.doubleValue, laneOrderTimes.lastObject.doubleValue);
+}
+
+#pragma mark - Timer wheel
+- (void)testTimerWheel
+{
+	OCTimerWheel<NSString *> *wheel = [[OCTimerWheel alloc] initWithResolution:1.0 startDate:[NSDate dateWithTimeIntervalSinceReferenceDate:1000]];
+	NSDate *(^Date)(NSTimeInterval) = ^(NSTimeInterval timeInterval) {
+		return ([NSDate dateWithTimeIntervalSinceReferenceDate:timeInterval]);
+	};
+
+	[wheel setDeadline:Date(1000.5) forKey:@"a"];
+	[wheel setDeadline:Date(1001) forKey:@"b"];
+	[wheel setDeadline:Date(1100) forKey:@"c"];
+	[wheel setDeadline:Date(101000) forKey:@"d"];
+	[wheel setDeadline:Date(1000 + 20000000) forKey:@"e"];
+	[wheel setDeadline:Date(999) forKey:@"f"];
+
+	XCTAssert(wheel.count == 6);
+
+	// Deadlines that already passed expire right away
+	XCTAssert([wheel.nextDeadline isEqual:Date(1000)]);
+	XCTAssert([[wheel advanceToDate:Date(1000)] isEqual:@[ @"f" ]]);
+
+	// Coinciding deadlines (within the same tick) expire together
+	XCTAssert([wheel.nextDeadline isEqual:Date(1001)]);
+	XCTAssert([[NSSet setWithArray:[wheel advanceToDate:Date(1001.9)]] isEqual:([NSSet setWithObjects:@"a", @"b", nil])]);
+
+	// Moving a deadline
+	[wheel setDeadline:Date(1050) forKey:@"c"];
+	XCTAssert([wheel.nextDeadline isEqual:Date(1050)]);
+	XCTAssert([wheel advanceToDate:Date(1049)].count == 0);
+	XCTAssert([[wheel advanceToDate:Date(1050)] isEqual:@[ @"c" ]]);
+
+	// Deadlines in higher levels and beyond the range of the wheel
+	XCTAssert([wheel.nextDeadline isEqual:Date(101000)]);
+	XCTAssert([wheel advanceToDate:Date(100999)].count == 0);
+	XCTAssert([[wheel advanceToDate:Date(101000)] isEqual:@[ @"d" ]]);
+
+	XCTAssert([wheel.nextDeadline isEqual:Date(1000 + 20000000)]);
+	XCTAssert([[wheel advanceToDate:Date(1000 + 30000000)] isEqual:@[ @"e" ]]);
+
+	XCTAssert(wheel.count == 0);
+	XCTAssert(wheel.nextDeadline == nil);
+
+	// Removal
+	[wheel setDeadline:Date(1000 + 30000010) forKey:@"g"];
+	[wheel removeKey:@"g"];
+	XCTAssert(wheel.count == 0);
+	XCTAssert([wheel advanceToDate:Date(1000 + 30000020)].count == 0);
+}
+
+- (void)testTimerWheelExpirationOrder
+{
+	OCTimerWheel<NSNumber *> *wheel = [[OCTimerWheel alloc] initWithResolution:1.0 startDate:[NSDate dateWithTimeIntervalSinceReferenceDate:0]];
+	NSMutableDictionary<NSNumber *, NSNumber *> *deadlinesByKey = [NSMutableDictionary new];
+	NSUInteger expiredCount = 0, wakeups = 0;
+	NSDate *nextDeadline;
+
+	srand(4711);
+
+	for (NSUInteger key=0; key < 10000; key++)
+	{
+		NSTimeInterval deadline = (NSTimeInterval)(1 + (rand() % 500000));
+
+		deadlinesByKey[@(key)] = @(deadline);
+		[wheel setDeadline:[NSDate dateWithTimeIntervalSinceReferenceDate:deadline] forKey:@(key)];
+	}
+
+	// Only wake up for deadlines - and expire each key exactly at its deadline
+	while ((nextDeadline = wheel.nextDeadline) != nil)
+	{
+		NSArray<NSNumber *> *expiredKeys = [wheel advanceToDate:nextDeadline];
+
+		XCTAssert(expiredKeys.count > 0);
+
+		for (NSNumber *key in expiredKeys)
+		{
+			XCTAssert(deadlinesByKey[key].doubleValue == nextDeadline.timeIntervalSinceReferenceDate);
+		}
+
+		expiredCount += expiredKeys.count;
+		wakeups++;
+	}
+
+	XCTAssert(expiredCount == 10000);
+	XCTAssert(wakeups <= [NSSet setWithArray:deadlinesByKey.allValues].count);
+}
+
 #pragma mark - NSDictionary+OCExpand
 - (void)testDictionaryExpansion
 {
@@ -818,4 +2232,52 @@
 
 }
 
+- (void)testDateParsing
+{
+	NSDateFormatter *httpDateFormatter = [NSDateFormatter new];
+	NSDateFormatter *compactDateFormatter = [NSDateFormatter new];
+	NSDate *referenceDate;
+
+	httpDateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+	httpDateFormatter.dateFormat = @"EEE, dd MMM y HH:mm:ss zzz";
+	httpDateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"GMT"];
+
+	compactDateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+	compactDateFormatter.dateFormat = @"yyyy-MM-dd HH:mm:ss";
+	compactDateFormatter.timeZone = [NSTimeZone timeZoneWithName:@"UTC"];
+
+	referenceDate = [httpDateFormatter dateFromString:@"Fri, 23 Feb 2018 11:52:05 GMT"];
+
+	// HTTP-date
+	XCTAssertEqualObjects([NSDate dateParsedFromString:@"Fri, 23 Feb 2018 11:52:05 GMT" error:NULL], referenceDate);
+	XCTAssertEqualObjects([NSDate dateParsedFromString:@"23 Feb 2018 11:52:05 GMT" error:NULL], referenceDate);
+	XCTAssertEqualObjects([NSDate dateParsedFromString:@"Fri, 23 Feb 2018 12:52:05 +0100" error:NULL], referenceDate);
+
+	// ISO 8601
+	XCTAssertEqualObjects([NSDate dateParsedFromString:@"2018-02-23T11:52:05Z" error:NULL], referenceDate);
+	XCTAssertEqualObjects([NSDate dateParsedFromString:@"2018-02-23T13:52:05+02:00" error:NULL], referenceDate);
+	XCTAssertEqualWithAccuracy([NSDate dateParsedFromString:@"2018-02-23T11:52:05.250Z" error:NULL].timeIntervalSince1970, referenceDate.timeIntervalSince1970 + 0.25, 0.0001);
+
+	// OCS
+	XCTAssertEqualObjects([NSDate dateParsedFromCompactUTCString:@"2018-02-23 11:52:05" error:NULL], referenceDate);
+	XCTAssertEqualObjects([NSDate dateParsedFromCompactUTCString:@"2018-04-11 00:00:00" error:NULL], [compactDateFormatter dateFromString:@"2018-04-11 00:00:00"]);
+
+	// Bytes
+	XCTAssertEqualObjects([NSDate dateParsedFromBytes:"Fri, 23 Feb 2018 11:52:05 GMT" length:29], referenceDate);
+
+	// Compare against NSDateFormatter across a range of dates (including leap years and dates before 1970)
+	for (NSTimeInterval timeInterval = -2208988800; timeInterval < 4102444800; timeInterval += 86400 * 17 + 3607)
+	{
+		NSDate *date = [NSDate dateWithTimeIntervalSince1970:timeInterval];
+
+		XCTAssertEqualObjects([NSDate dateParsedFromString:[httpDateFormatter stringFromDate:date] error:NULL], date);
+		XCTAssertEqualObjects([NSDate dateParsedFromCompactUTCString:[compactDateFormatter stringFromDate:date] error:NULL], date);
+	}
+
+	// Invalid input
+	XCTAssertNil([NSDate dateParsedFromString:@"Fri, 30 Feb 2018 11:52:05 GMT" error:NULL]);
+	XCTAssertNil([NSDate dateParsedFromString:@"2018-02-23T25:52:05Z" error:NULL]);
+	XCTAssertNil([NSDate dateParsedFromString:@"not a date" error:NULL]);
+}
+
 @end